@@ -1,11 +1,16 @@
 #include "AHX.h"
 #if defined(__AVX__)
+#	include "ArraySpan.h"
+#	include "CpuDetect.h"
 #	include "DigestFromName.h"
 #	include "HKDF.h"
 #	include "IntUtils.h"
 #	include "MemUtils.h"
 #	include "UInt128.h"
 #endif
+#if defined(CEX_HAS_VAES)
+#	include <immintrin.h>
+#endif
 
 NAMESPACE_BLOCK
 
@@ -23,6 +28,8 @@ AHX::AHX(Digests DigestType, size_t Rounds)
 	m_cprKeySize(0),
 	m_destroyEngine(true),
 	m_expKey(0),
+	m_hasVAES256(false),
+	m_hasVAES512(false),
 	m_kdfEngine(DigestType == Digests::None ? nullptr : Helper::DigestFromName::GetInstance(DigestType)),
 	m_kdfEngineType(DigestType),
 	m_kdfInfo(DEF_DSTINFO.begin(), DEF_DSTINFO.end()),
@@ -36,6 +43,7 @@ AHX::AHX(Digests DigestType, size_t Rounds)
 	m_rndCount(((Rounds <= MAX_ROUNDS) && (Rounds >= MIN_ROUNDS) && (Rounds % 2 == 0)) ? Rounds :
 		throw CryptoSymmetricCipherException("AHX:CTor", "Invalid rounds size! Sizes supported are even numbers between 10 and 38."))
 {
+	Detect();
 	LoadState(m_kdfEngineType);
 }
 
@@ -45,6 +53,8 @@ AHX::AHX(IDigest* Digest, size_t Rounds)
 	m_cprKeySize(0),
 	m_destroyEngine(false),
 	m_expKey(0),
+	m_hasVAES256(false),
+	m_hasVAES512(false),
 	m_kdfEngine(Digest),
 	m_kdfEngineType(Digest == nullptr ? Digests::None : Digest->Enumeral()),
 	m_kdfInfo(DEF_DSTINFO.begin(), DEF_DSTINFO.end()),
@@ -58,6 +68,7 @@ AHX::AHX(IDigest* Digest, size_t Rounds)
 	m_rndCount(((Rounds <= MAX_ROUNDS) && (Rounds >= MIN_ROUNDS) && (Rounds % 2 == 0)) ? Rounds :
 		throw CryptoSymmetricCipherException("AHX:CTor", "Invalid rounds size! Sizes supported are even numbers between 10 and 38."))
 {
+	Detect();
 	LoadState(m_kdfEngineType);
 }
 
@@ -68,6 +79,8 @@ AHX::~AHX()
 		m_isDestroyed = true;
 		m_blockSize = 0;
 		m_cprKeySize = 0;
+		m_hasVAES256 = false;
+		m_hasVAES512 = false;
 		m_kdfEngineType = Digests::None;
 		m_kdfInfoMax = 0;
 		m_kdfKeySize = 0;
@@ -136,6 +149,32 @@ const Digests AHX::KdfEngine()
 	return m_kdfEngineType;
 }
 
+const size_t AHX::KernelWidth()
+{
+#if defined(CEX_HAS_VAES512)
+	if (m_hasVAES512)
+	{
+		return 512;
+	}
+#endif
+#if defined(CEX_HAS_VAES)
+	if (m_hasVAES256)
+	{
+		return 256;
+	}
+#endif
+
+	return 128;
+}
+
+void AHX::KernelWidth(size_t Width)
+{
+	// a width can only be lowered from what the processor supports
+	Detect();
+	m_hasVAES512 = m_hasVAES512 && (Width >= 512);
+	m_hasVAES256 = m_hasVAES256 && (Width >= 256);
+}
+
 const std::vector<SymmetricKeySize> &AHX::LegalKeySizes()
 {
 	return m_legalKeySizes;
@@ -162,6 +201,11 @@ const std::string AHX::Name()
 	return txtName;
 }
 
+const std::vector<__m128i> &AHX::RoundKeys()
+{
+	return m_expKey;
+}
+
 const size_t AHX::Rounds()
 {
 	return m_rndCount;
@@ -278,6 +322,66 @@ void AHX::Transform2048(const std::vector<byte> &Input, const size_t InOffset, s
 	}
 }
 
+void AHX::Transform(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt128(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt128(inp, 0, otp, 0);
+	}
+}
+
+void AHX::Transform512(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 4 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 4 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt512(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt512(inp, 0, otp, 0);
+	}
+}
+
+void AHX::Transform1024(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 8 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 8 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt1024(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt1024(inp, 0, otp, 0);
+	}
+}
+
+void AHX::Transform2048(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 16 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 16 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt2048(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt2048(inp, 0, otp, 0);
+	}
+}
+
 //~~~Key Schedule~~~//
 
 void AHX::ExpandKey(bool Encryption, const std::vector<byte> &Key)
@@ -535,7 +639,8 @@ void AHX::ExpandSubBlock(std::vector<__m128i> &Key, const size_t Index, const si
 
 //~~~Rounds Processing~~~//
 
-void AHX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void AHX::Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = m_expKey.size() - 2;
 	size_t keyCtr = 0;
@@ -553,7 +658,8 @@ void AHX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output[OutOffset]), _mm_aesdeclast_si128(X, m_expKey[keyCtr]));
 }
 
-void AHX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void AHX::Decrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = m_expKey.size() - 2;
 	size_t keyCtr = 0;
@@ -589,20 +695,113 @@ void AHX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 	X3.Store(Output, OutOffset + 48);
 }
 
-void AHX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void AHX::Decrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
-	// no aes-ni 256 api.. yet
+#if defined(CEX_HAS_VAES)
+	if (m_hasVAES256)
+	{
+		DecryptV256(Input, InOffset, Output, OutOffset);
+		return;
+	}
+#endif
+
 	Decrypt512(Input, InOffset, Output, OutOffset);
 	Decrypt512(Input, InOffset + 64, Output, OutOffset + 64);
 }
 
-void AHX::Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void AHX::Decrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
+#if defined(CEX_HAS_VAES512)
+	if (m_hasVAES512)
+	{
+		DecryptV512(Input, InOffset, Output, OutOffset);
+		return;
+	}
+#endif
+
 	Decrypt1024(Input, InOffset, Output, OutOffset);
 	Decrypt1024(Input, InOffset + 128, Output, OutOffset + 128);
 }
 
-void AHX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void AHX::DecryptV256(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
+{
+#if defined(CEX_HAS_VAES)
+	// 8 blocks, two blocks per 256 bit register
+	const size_t RNDCNT = m_expKey.size() - 2;
+	size_t keyCtr = 0;
+
+	__m256i K = _mm256_broadcastsi128_si256(m_expKey[keyCtr]);
+	__m256i X0 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset])), K);
+	__m256i X1 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + 32])), K);
+	__m256i X2 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + 64])), K);
+	__m256i X3 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + 96])), K);
+
+	while (keyCtr != RNDCNT)
+	{
+		++keyCtr;
+		K = _mm256_broadcastsi128_si256(m_expKey[keyCtr]);
+		X0 = _mm256_aesdec_epi128(X0, K);
+		X1 = _mm256_aesdec_epi128(X1, K);
+		X2 = _mm256_aesdec_epi128(X2, K);
+		X3 = _mm256_aesdec_epi128(X3, K);
+	}
+
+	++keyCtr;
+	K = _mm256_broadcastsi128_si256(m_expKey[keyCtr]);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[OutOffset]), _mm256_aesdeclast_epi128(X0, K));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[OutOffset + 32]), _mm256_aesdeclast_epi128(X1, K));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[OutOffset + 64]), _mm256_aesdeclast_epi128(X2, K));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[OutOffset + 96]), _mm256_aesdeclast_epi128(X3, K));
+#endif
+}
+
+template <typename ArrayA, typename ArrayB>
+void AHX::DecryptV512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
+{
+#if defined(CEX_HAS_VAES512)
+	// 16 blocks, four blocks per 512 bit register
+	const size_t RNDCNT = m_expKey.size() - 2;
+	size_t keyCtr = 0;
+
+	__m512i K = _mm512_broadcast_i32x4(m_expKey[keyCtr]);
+	__m512i X0 = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[InOffset])), K);
+	__m512i X1 = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[InOffset + 64])), K);
+	__m512i X2 = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[InOffset + 128])), K);
+	__m512i X3 = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[InOffset + 192])), K);
+
+	while (keyCtr != RNDCNT)
+	{
+		++keyCtr;
+		K = _mm512_broadcast_i32x4(m_expKey[keyCtr]);
+		X0 = _mm512_aesdec_epi128(X0, K);
+		X1 = _mm512_aesdec_epi128(X1, K);
+		X2 = _mm512_aesdec_epi128(X2, K);
+		X3 = _mm512_aesdec_epi128(X3, K);
+	}
+
+	++keyCtr;
+	K = _mm512_broadcast_i32x4(m_expKey[keyCtr]);
+	_mm512_storeu_si512(reinterpret_cast<void*>(&Output[OutOffset]), _mm512_aesdeclast_epi128(X0, K));
+	_mm512_storeu_si512(reinterpret_cast<void*>(&Output[OutOffset + 64]), _mm512_aesdeclast_epi128(X1, K));
+	_mm512_storeu_si512(reinterpret_cast<void*>(&Output[OutOffset + 128]), _mm512_aesdeclast_epi128(X2, K));
+	_mm512_storeu_si512(reinterpret_cast<void*>(&Output[OutOffset + 192]), _mm512_aesdeclast_epi128(X3, K));
+#endif
+}
+
+void AHX::Detect()
+{
+	Common::CpuDetect detect;
+
+	m_hasVAES256 = detect.VAES() && detect.AVX2();
+	// the 512 bit kernels also require the os to save the opmask and zmm register state
+	m_hasVAES512 = detect.VAES() && detect.AVX512F() && detect.OSAVX512();
+}
+
+template <typename ArrayA, typename ArrayB>
+void AHX::Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = m_expKey.size() - 2;
 	size_t keyCtr = 0;
@@ -620,7 +819,8 @@ void AHX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output[OutOffset]), _mm_aesenclast_si128(X, m_expKey[keyCtr]));
 }
 
-void AHX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void AHX::Encrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = m_expKey.size() - 2;
 	size_t keyCtr = 0;
@@ -656,18 +856,102 @@ void AHX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 	X3.Store(Output, OutOffset + 48);
 }
 
-void AHX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void AHX::Encrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
+#if defined(CEX_HAS_VAES)
+	if (m_hasVAES256)
+	{
+		EncryptV256(Input, InOffset, Output, OutOffset);
+		return;
+	}
+#endif
+
 	Encrypt512(Input, InOffset, Output, OutOffset);
 	Encrypt512(Input, InOffset + 64, Output, OutOffset + 64);
 }
 
-void AHX::Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void AHX::Encrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
+#if defined(CEX_HAS_VAES512)
+	if (m_hasVAES512)
+	{
+		EncryptV512(Input, InOffset, Output, OutOffset);
+		return;
+	}
+#endif
+
 	Encrypt1024(Input, InOffset, Output, OutOffset);
 	Encrypt1024(Input, InOffset + 128, Output, OutOffset + 128);
 }
 
+template <typename ArrayA, typename ArrayB>
+void AHX::EncryptV256(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
+{
+#if defined(CEX_HAS_VAES)
+	// 8 blocks, two blocks per 256 bit register
+	const size_t RNDCNT = m_expKey.size() - 2;
+	size_t keyCtr = 0;
+
+	__m256i K = _mm256_broadcastsi128_si256(m_expKey[keyCtr]);
+	__m256i X0 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset])), K);
+	__m256i X1 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + 32])), K);
+	__m256i X2 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + 64])), K);
+	__m256i X3 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + 96])), K);
+
+	while (keyCtr != RNDCNT)
+	{
+		++keyCtr;
+		K = _mm256_broadcastsi128_si256(m_expKey[keyCtr]);
+		X0 = _mm256_aesenc_epi128(X0, K);
+		X1 = _mm256_aesenc_epi128(X1, K);
+		X2 = _mm256_aesenc_epi128(X2, K);
+		X3 = _mm256_aesenc_epi128(X3, K);
+	}
+
+	++keyCtr;
+	K = _mm256_broadcastsi128_si256(m_expKey[keyCtr]);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[OutOffset]), _mm256_aesenclast_epi128(X0, K));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[OutOffset + 32]), _mm256_aesenclast_epi128(X1, K));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[OutOffset + 64]), _mm256_aesenclast_epi128(X2, K));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[OutOffset + 96]), _mm256_aesenclast_epi128(X3, K));
+#endif
+}
+
+template <typename ArrayA, typename ArrayB>
+void AHX::EncryptV512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
+{
+#if defined(CEX_HAS_VAES512)
+	// 16 blocks, four blocks per 512 bit register
+	const size_t RNDCNT = m_expKey.size() - 2;
+	size_t keyCtr = 0;
+
+	__m512i K = _mm512_broadcast_i32x4(m_expKey[keyCtr]);
+	__m512i X0 = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[InOffset])), K);
+	__m512i X1 = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[InOffset + 64])), K);
+	__m512i X2 = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[InOffset + 128])), K);
+	__m512i X3 = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[InOffset + 192])), K);
+
+	while (keyCtr != RNDCNT)
+	{
+		++keyCtr;
+		K = _mm512_broadcast_i32x4(m_expKey[keyCtr]);
+		X0 = _mm512_aesenc_epi128(X0, K);
+		X1 = _mm512_aesenc_epi128(X1, K);
+		X2 = _mm512_aesenc_epi128(X2, K);
+		X3 = _mm512_aesenc_epi128(X3, K);
+	}
+
+	++keyCtr;
+	K = _mm512_broadcast_i32x4(m_expKey[keyCtr]);
+	_mm512_storeu_si512(reinterpret_cast<void*>(&Output[OutOffset]), _mm512_aesenclast_epi128(X0, K));
+	_mm512_storeu_si512(reinterpret_cast<void*>(&Output[OutOffset + 64]), _mm512_aesenclast_epi128(X1, K));
+	_mm512_storeu_si512(reinterpret_cast<void*>(&Output[OutOffset + 128]), _mm512_aesenclast_epi128(X2, K));
+	_mm512_storeu_si512(reinterpret_cast<void*>(&Output[OutOffset + 192]), _mm512_aesenclast_epi128(X3, K));
+#endif
+}
+
 //~~~Helpers~~~//
 
 void AHX::LoadState(Digests DigestType)
@@ -97,6 +97,7 @@ NAMESPACE_BLOCK
 /// <item><description>The recommended size for maximum security is 2* the digests block size; this calls HKDF Extract using full blocks of key and salt.</description></item>
 /// <item><description>Valid key sizes can be determined at run time using the <see cref="LegalKeySizes"/> property.</description></item>
 /// <item><description>The internal block size is 16 bytes wide.</description></item>
+/// <item><description>On processors with the vector AES instructions (VAES), Transform1024 processes 8 blocks in four 256 bit registers, and Transform2048 processes 16 blocks in four 512 bit registers (AVX-512), or 256 bit registers when AVX-512 is not available; the instruction set is selected at runtime.</description></item>
 /// <item><description>Diffusion rounds assignments are 10 to 38, the default is 22 (128-256 bit key), a 512 bit key is automatically assigned 22 rounds.</description></item>
 /// <item><description>Valid rounds assignments can be found in the <see cref="LegalRounds"/> property.</description></item>
 /// </list>
@@ -132,6 +133,8 @@ private:
 	size_t m_cprKeySize;
 	bool m_destroyEngine;
 	std::vector<__m128i> m_expKey;
+	bool m_hasVAES256;
+	bool m_hasVAES512;
 	std::unique_ptr<IDigest> m_kdfEngine;
 	Digests m_kdfEngineType;
 	std::vector<byte> m_kdfInfo;
@@ -236,6 +239,20 @@ public:
 	/// </summary>
 	const Digests KdfEngine() override;
 
+	/// <summary>
+	/// Read/Write: The register width in bits of the widest AES kernel used by the wide transforms; 128 (AES-NI), 256 (VAES), or 512 (VAES with AVX-512).
+	/// <para>Set to a lower width to restrict the kernels, the width is limited to what the processor supports. 
+	/// Used to test each kernel against the reference implementation.</para>
+	/// </summary>
+	const size_t KernelWidth();
+
+	/// <summary>
+	/// Read/Write: Set the maximum register width in bits of the AES kernels used by the wide transforms
+	/// </summary>
+	///
+	/// <param name="Width">The maximum register width in bits; 128, 256, or 512</param>
+	void KernelWidth(size_t Width);
+
 	/// <summary>
 	/// Read Only: Available Encryption Key Sizes in bytes
 	/// </summary>
@@ -251,6 +268,12 @@ public:
 	/// </summary>
 	const std::string Name() override;
 
+	/// <summary>
+	/// Read Only: The expanded round keys, one register per round.
+	/// <para>Used by the cipher modes that interleave the AES rounds with their own processing; CTR message batches, the EAX CMAC chain, and the GCM stitched GHASH.</para>
+	/// </summary>
+	const std::vector<__m128i> &RoundKeys();
+
 	/// <summary>
 	/// Read Only: The number of transformation rounds processed by the transform
 	/// </summary>
@@ -378,16 +401,73 @@ public:
 	/// <param name="OutOffset">Starting offset in the output array</param>
 	void Transform2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Transform a block of bytes using caller owned memory.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least <see cref="BlockSize"/> bytes; they may point to the same address for an in-place transform.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	void Transform(const byte* Input, byte* Output) override;
+
+	/// <summary>
+	/// Transform 4 blocks of bytes using caller owned memory.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 4 * <see cref="BlockSize"/> bytes; they may point to the same address for an in-place transform.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	void Transform512(const byte* Input, byte* Output) override;
+
+	/// <summary>
+	/// Transform 8 blocks of bytes using caller owned memory.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 8 * <see cref="BlockSize"/> bytes; they may point to the same address for an in-place transform.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	void Transform1024(const byte* Input, byte* Output) override;
+
+	/// <summary>
+	/// Transform 16 blocks of bytes using caller owned memory.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 16 * <see cref="BlockSize"/> bytes; they may point to the same address for an in-place transform.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	void Transform2048(const byte* Input, byte* Output) override;
+
 private:
 
-	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void DecryptV256(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void DecryptV512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	void Detect();
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void EncryptV256(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void EncryptV512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
 	void ExpandKey(bool Encryption, const std::vector<byte> &Key);
 	void ExpandRotBlock(std::vector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset);
 	void ExpandRotBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset);
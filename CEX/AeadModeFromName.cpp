@@ -1,5 +1,6 @@
 #include "AeadModeFromName.h"
 #include "BlockCipherFromName.h"
+#include "ChaCha20Poly1305.h"
 #include "EAX.h"
 #include "GCM.h"
 #include "OCB.h"
@@ -29,6 +30,12 @@ IAeadMode* AeadModeFromName::GetInstance(AeadModes CipherType, IBlockCipher* Eng
 				aeadPtr = new Cipher::Symmetric::Block::Mode::OCB(Engine);
 				break;
 			}
+			case Enumeration::AeadModes::ChaCha20Poly1305:
+			{
+				// the stream cipher based mode does not use the block cipher instance
+				aeadPtr = new Cipher::Symmetric::Block::Mode::ChaCha20Poly1305();
+				break;
+			}
 			default:
 			{
 				throw CryptoException("AeadModeFromName:GetInstance", "The AEAD cipher mode is not supported!");
@@ -45,6 +52,12 @@ IAeadMode* AeadModeFromName::GetInstance(AeadModes CipherType, IBlockCipher* Eng
 
 IAeadMode* AeadModeFromName::GetInstance(AeadModes CipherType, BlockCiphers EngineType)
 {
+	if (CipherType == Enumeration::AeadModes::ChaCha20Poly1305)
+	{
+		// the engine type is ignored, a block cipher is not created
+		return GetInstance(CipherType, static_cast<IBlockCipher*>(nullptr));
+	}
+
 	IAeadMode* aeadPtr;
 	IBlockCipher* cprPtr = BlockCipherFromName::GetInstance(EngineType);
 
@@ -25,7 +25,11 @@ enum class AeadModes : byte
 	/// <summary>
 	/// Offset CodeBook AEAD Mode
 	/// </summary>
-	OCB = 8
+	OCB = 8,
+	/// <summary>
+	/// ChaCha20 and Poly1305 AEAD Mode (RFC 8439)
+	/// </summary>
+	ChaCha20Poly1305 = 10
 };
 
 NAMESPACE_ENUMERATIONEND
@@ -0,0 +1,486 @@
+#include "AeadStream.h"
+#include "ChaCha20Poly1305.h"
+#include "CSP.h"
+#include "EAX.h"
+#include "GCM.h"
+#include "IntUtils.h"
+#include "OCB.h"
+#include "ParallelUtils.h"
+#include "SymmetricKey.h"
+
+NAMESPACE_PROCESSING
+
+using Utility::IntUtils;
+using Utility::ParallelUtils;
+
+//~~~Constructor~~~//
+
+AeadStream::AeadStream(CipherDescription* Header, size_t ChunkSize)
+	:
+	m_aeadEngines(0),
+	m_aeadMode(Header != nullptr ? static_cast<AeadModes>(Header->CipherType()) :
+		throw CryptoProcessingException("AeadStream:CTor", "The cipher description can not be null!")),
+	m_chunkSize(ChunkSize >= MIN_CHUNKSIZE && ChunkSize <= MAX_CHUNKSIZE ? ChunkSize :
+		throw CryptoProcessingException("AeadStream:CTor", "The chunk size is out of range!")),
+	m_cipherKey(0),
+	m_description(Header->ToBytes()),
+	m_engineType(Header->EngineType()),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isInitialized(false),
+	m_isParallel(ParallelUtils::ProcessorCount() > 1),
+	m_legalKeySizes(0),
+	m_nonceSize(0),
+	m_parallelDegree(ParallelUtils::ProcessorCount()),
+	m_progressCounter()
+{
+	switch (m_aeadMode)
+	{
+		case AeadModes::ChaCha20Poly1305:
+		case AeadModes::GCM:
+		case AeadModes::OCB:
+		{
+			m_nonceSize = 12;
+			break;
+		}
+		case AeadModes::EAX:
+		{
+			m_nonceSize = 16;
+			break;
+		}
+		default:
+		{
+			throw CryptoProcessingException("AeadStream:CTor", "The cipher mode must be an AEAD mode!");
+		}
+	}
+
+	if (m_aeadMode != AeadModes::ChaCha20Poly1305 && m_engineType == BlockCiphers::None)
+	{
+		throw CryptoProcessingException("AeadStream:CTor", "The block cipher type is invalid!");
+	}
+
+	m_aeadEngines.push_back(std::unique_ptr<IAeadMode>(CreateEngine()));
+	m_legalKeySizes = m_aeadEngines[0]->LegalKeySizes();
+}
+
+AeadStream::~AeadStream()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_chunkSize = 0;
+		m_isEncryption = false;
+		m_isInitialized = false;
+		m_isParallel = false;
+		m_nonceSize = 0;
+		m_parallelDegree = 0;
+
+		for (size_t i = 0; i < m_aeadEngines.size(); ++i)
+		{
+			m_aeadEngines[i].reset(nullptr);
+		}
+
+		m_aeadEngines.clear();
+		IntUtils::ClearVector(m_cipherKey);
+		IntUtils::ClearVector(m_description);
+		m_legalKeySizes.clear();
+	}
+}
+
+//~~~Accessors~~~//
+
+const size_t AeadStream::ChunkSize()
+{
+	return m_chunkSize;
+}
+
+const size_t AeadStream::HeaderSize()
+{
+	return m_description.size() + sizeof(uint) + sizeof(ulong) + (m_nonceSize - NONCE_SUFFIX);
+}
+
+bool &AeadStream::IsParallel()
+{
+	return m_isParallel;
+}
+
+const std::vector<SymmetricKeySize> AeadStream::LegalKeySizes()
+{
+	return m_legalKeySizes;
+}
+
+ProgressCounter &AeadStream::Progress()
+{
+	return m_progressCounter;
+}
+
+const size_t AeadStream::TagSize()
+{
+	return TAG_SIZE;
+}
+
+//~~~Public Functions~~~//
+
+const ulong AeadStream::CipherLength(ulong PlainLength)
+{
+	if (ChunkCount(PlainLength, m_chunkSize) > MAX_CHUNKS)
+	{
+		throw CryptoProcessingException("AeadStream:CipherLength", "The plaintext exceeds the maximum container length!");
+	}
+
+	return HeaderSize() + PlainLength + (ChunkCount(PlainLength, m_chunkSize) * TAG_SIZE);
+}
+
+void AeadStream::Initialize(bool Encryption, ISymmetricKey &KeyParams)
+{
+	bool legalKey = false;
+
+	for (size_t i = 0; i < m_legalKeySizes.size(); ++i)
+	{
+		if (KeyParams.Key().size() == m_legalKeySizes[i].KeySize())
+		{
+			legalKey = true;
+			break;
+		}
+	}
+
+	if (!legalKey)
+	{
+		throw CryptoProcessingException("AeadStream:Initialize", "Invalid key size; key must be one of the LegalKeySizes in length!");
+	}
+
+	const size_t THDCNT = m_isParallel ? (m_parallelDegree != 0 ? m_parallelDegree : 1) : 1;
+
+	while (m_aeadEngines.size() < THDCNT)
+	{
+		m_aeadEngines.push_back(std::unique_ptr<IAeadMode>(CreateEngine()));
+	}
+
+	if (m_aeadEngines.size() > THDCNT)
+	{
+		m_aeadEngines.resize(THDCNT);
+	}
+
+	// chunks are distributed across threads, so each engine runs sequentially
+	for (size_t i = 0; i < m_aeadEngines.size(); ++i)
+	{
+		m_aeadEngines[i]->ParallelProfile().IsParallel() = (THDCNT == 1 && m_aeadEngines[i]->ParallelProfile().IsParallel());
+	}
+
+	m_cipherKey = KeyParams.Key();
+	m_isEncryption = Encryption;
+	m_isInitialized = true;
+}
+
+void AeadStream::ParallelMaxDegree(size_t Degree)
+{
+	if (Degree == 0)
+	{
+		Degree = ParallelUtils::ProcessorCount();
+	}
+
+	m_parallelDegree = Degree;
+	m_isParallel = (Degree > 1);
+}
+
+ulong AeadStream::PlainLength(IByteStream* InStream)
+{
+	CexAssert(InStream != nullptr, "the input stream can not be null");
+
+	const ulong STMPOS = InStream->Position();
+	ulong plnLen = 0;
+	size_t cnkLen = 0;
+
+	ReadHeader(InStream, plnLen, cnkLen);
+	InStream->Seek(STMPOS, IO::SeekOrigin::Begin);
+
+	return plnLen;
+}
+
+size_t AeadStream::Read(IByteStream* InStream, ulong Offset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	CexAssert(InStream != nullptr, "the input stream can not be null");
+	CexAssert(Output.size() - OutOffset >= Length, "the output array is too small");
+
+	if (!m_isInitialized || m_isEncryption)
+	{
+		throw CryptoProcessingException("AeadStream:Read", "The container must be initialized for decryption!");
+	}
+
+	if (Length == 0)
+	{
+		return 0;
+	}
+
+	InStream->Seek(0, IO::SeekOrigin::Begin);
+	ulong plnLen = 0;
+	size_t cnkLen = 0;
+	const std::vector<byte> HDR = ReadHeader(InStream, plnLen, cnkLen);
+
+	if (Offset > plnLen || plnLen - Offset < Length)
+	{
+		throw CryptoProcessingException("AeadStream:Read", "The range exceeds the plaintext length!");
+	}
+
+	const ulong RNGEND = Offset + Length;
+	const ulong FSTCNK = Offset / cnkLen;
+	const ulong LSTCNK = (RNGEND - 1) / cnkLen;
+	const size_t BATCNT = m_aeadEngines.size() * THREAD_CHUNKS;
+	const size_t RECLEN = cnkLen + TAG_SIZE;
+	std::vector<byte> inpBuffer(BATCNT * RECLEN);
+	std::vector<byte> outBuffer(BATCNT * cnkLen);
+
+	for (ulong i = FSTCNK; i <= LSTCNK; i += BATCNT)
+	{
+		const size_t CNKCNT = static_cast<size_t>(((LSTCNK - i + 1) < BATCNT) ? LSTCNK - i + 1 : BATCNT);
+		const ulong PLNOFT = i * cnkLen;
+		const size_t PLNLEN = static_cast<size_t>((plnLen - PLNOFT < CNKCNT * cnkLen) ? plnLen - PLNOFT : CNKCNT * cnkLen);
+
+		InStream->Seek(HDR.size() + (i * RECLEN), IO::SeekOrigin::Begin);
+
+		if (InStream->Read(inpBuffer, 0, PLNLEN + (CNKCNT * TAG_SIZE)) != PLNLEN + (CNKCNT * TAG_SIZE))
+		{
+			throw CryptoAuthenticationFailure("AeadStream:Read", "The container has been truncated!");
+		}
+
+		if (!TransformBatch(HDR, i, CNKCNT, plnLen, cnkLen, inpBuffer, outBuffer))
+		{
+			throw CryptoAuthenticationFailure("AeadStream:Read", "The chunk failed authentication!");
+		}
+
+		// copy the intersection of the batch and the requested range
+		const ulong CPYSTR = (Offset > PLNOFT) ? Offset : PLNOFT;
+		const ulong CPYEND = (RNGEND < PLNOFT + PLNLEN) ? RNGEND : PLNOFT + PLNLEN;
+		std::memcpy(&Output[OutOffset + static_cast<size_t>(CPYSTR - Offset)], &outBuffer[static_cast<size_t>(CPYSTR - PLNOFT)], static_cast<size_t>(CPYEND - CPYSTR));
+	}
+
+	IntUtils::ClearVector(outBuffer);
+
+	return Length;
+}
+
+void AeadStream::Write(IByteStream* InStream, IByteStream* OutStream)
+{
+	CexAssert(InStream != nullptr, "the input stream can not be null");
+	CexAssert(OutStream != nullptr, "the output stream can not be null");
+
+	if (!m_isInitialized)
+	{
+		throw CryptoProcessingException("AeadStream:Write", "The container has not been initialized!");
+	}
+
+	const size_t BATCNT = m_aeadEngines.size() * THREAD_CHUNKS;
+	std::vector<byte> hdr(0);
+	ulong plnLen = 0;
+	size_t cnkLen = 0;
+
+	if (m_isEncryption)
+	{
+		plnLen = InStream->Length() - InStream->Position();
+		cnkLen = m_chunkSize;
+		hdr = CreateHeader(plnLen);
+		OutStream->Write(hdr, 0, hdr.size());
+	}
+	else
+	{
+		hdr = ReadHeader(InStream, plnLen, cnkLen);
+
+		if (InStream->Length() - InStream->Position() != plnLen + (ChunkCount(plnLen, cnkLen) * TAG_SIZE))
+		{
+			throw CryptoAuthenticationFailure("AeadStream:Write", "The container length is invalid!");
+		}
+	}
+
+	const ulong CNKCNT = ChunkCount(plnLen, cnkLen);
+	const size_t RECLEN = cnkLen + TAG_SIZE;
+	m_progressCounter.Reset(plnLen);
+	std::vector<byte> inpBuffer(BATCNT * (m_isEncryption ? cnkLen : RECLEN));
+	std::vector<byte> outBuffer(BATCNT * (m_isEncryption ? RECLEN : cnkLen));
+
+	for (ulong i = 0; i < CNKCNT; i += BATCNT)
+	{
+		const size_t BCHCNT = static_cast<size_t>((CNKCNT - i < BATCNT) ? CNKCNT - i : BATCNT);
+		const ulong PLNOFT = i * cnkLen;
+		const size_t PLNLEN = static_cast<size_t>((plnLen - PLNOFT < BCHCNT * cnkLen) ? plnLen - PLNOFT : BCHCNT * cnkLen);
+		const size_t INPLEN = m_isEncryption ? PLNLEN : PLNLEN + (BCHCNT * TAG_SIZE);
+		const size_t OUTLEN = m_isEncryption ? PLNLEN + (BCHCNT * TAG_SIZE) : PLNLEN;
+
+		if (InStream->Read(inpBuffer, 0, INPLEN) != INPLEN)
+		{
+			throw CryptoProcessingException("AeadStream:Write", "The input stream ended unexpectedly!");
+		}
+
+		// a batch is verified in full before any of its plaintext is released
+		if (!TransformBatch(hdr, i, BCHCNT, plnLen, cnkLen, inpBuffer, outBuffer))
+		{
+			if (m_isEncryption)
+			{
+				throw CryptoProcessingException("AeadStream:Write", "The chunk could not be encrypted!");
+			}
+
+			throw CryptoAuthenticationFailure("AeadStream:Write", "The chunk failed authentication!");
+		}
+
+		OutStream->Write(outBuffer, 0, OUTLEN);
+		m_progressCounter.Add(PLNLEN);
+	}
+
+	IntUtils::ClearVector(inpBuffer);
+	IntUtils::ClearVector(outBuffer);
+}
+
+//~~~Private Functions~~~//
+
+ulong AeadStream::ChunkCount(ulong PlainLength, size_t ChunkSize)
+{
+	// an empty plaintext is encoded as a single final chunk, so truncation to zero chunks is detectable
+	return (PlainLength == 0) ? 1 : (PlainLength + ChunkSize - 1) / ChunkSize;
+}
+
+IAeadMode* AeadStream::CreateEngine()
+{
+	switch (m_aeadMode)
+	{
+		case AeadModes::ChaCha20Poly1305:
+			return new Cipher::Symmetric::Block::Mode::ChaCha20Poly1305();
+		case AeadModes::EAX:
+			return new Cipher::Symmetric::Block::Mode::EAX(m_engineType);
+		case AeadModes::GCM:
+			return new Cipher::Symmetric::Block::Mode::GCM(m_engineType);
+		default:
+			return new Cipher::Symmetric::Block::Mode::OCB(m_engineType);
+	}
+}
+
+std::vector<byte> AeadStream::CreateHeader(ulong PlainLength)
+{
+	const size_t DSCLEN = m_description.size();
+	std::vector<byte> hdr(HeaderSize());
+
+	if (ChunkCount(PlainLength, m_chunkSize) > MAX_CHUNKS)
+	{
+		throw CryptoProcessingException("AeadStream:CreateHeader", "The plaintext exceeds the maximum container length!");
+	}
+
+	std::memcpy(&hdr[0], &m_description[0], DSCLEN);
+	IntUtils::Le32ToBytes(static_cast<uint>(m_chunkSize), hdr, DSCLEN);
+	IntUtils::Le64ToBytes(PlainLength, hdr, DSCLEN + sizeof(uint));
+
+	// a new random nonce prefix for each container
+	Provider::CSP rnd;
+	rnd.GetBytes(hdr, DSCLEN + sizeof(uint) + sizeof(ulong), m_nonceSize - NONCE_SUFFIX);
+
+	return hdr;
+}
+
+std::vector<byte> AeadStream::ReadHeader(IByteStream* InStream, ulong &PlainLength, size_t &ChunkSize)
+{
+	const size_t DSCLEN = m_description.size();
+	std::vector<byte> hdr(HeaderSize());
+
+	if (InStream->Read(hdr, 0, hdr.size()) != hdr.size())
+	{
+		throw CryptoProcessingException("AeadStream:ReadHeader", "The container header is truncated!");
+	}
+
+	if (!IntUtils::Compare(hdr, 0, m_description, 0, DSCLEN))
+	{
+		throw CryptoProcessingException("AeadStream:ReadHeader", "The container was created with a different cipher description!");
+	}
+
+	ChunkSize = IntUtils::LeBytesTo32(hdr, DSCLEN);
+	PlainLength = IntUtils::LeBytesTo64(hdr, DSCLEN + sizeof(uint));
+
+	if (ChunkSize < MIN_CHUNKSIZE || ChunkSize > MAX_CHUNKSIZE)
+	{
+		throw CryptoProcessingException("AeadStream:ReadHeader", "The container chunk size is invalid!");
+	}
+
+	if (ChunkCount(PlainLength, ChunkSize) > MAX_CHUNKS)
+	{
+		throw CryptoProcessingException("AeadStream:ReadHeader", "The container length exceeds the maximum number of chunks!");
+	}
+
+	return hdr;
+}
+
+bool AeadStream::TransformBatch(const std::vector<byte> &Header, ulong FirstChunk, size_t Count, ulong PlainLength, size_t ChunkSize, const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	const ulong CNKCNT = ChunkCount(PlainLength, ChunkSize);
+	const size_t THDCNT = (m_aeadEngines.size() < Count) ? m_aeadEngines.size() : Count;
+	const size_t PFXLEN = m_nonceSize - NONCE_SUFFIX;
+	const size_t RECLEN = ChunkSize + TAG_SIZE;
+	std::vector<byte> authCodes(Count, 0);
+
+	auto process = [this, &Header, FirstChunk, Count, PlainLength, ChunkSize, CNKCNT, THDCNT, PFXLEN, RECLEN, &Input, &Output, &authCodes](size_t Index)
+	{
+		IAeadMode* engine = m_aeadEngines[Index].get();
+		std::vector<byte> nonce(m_nonceSize);
+		std::memcpy(&nonce[0], &Header[Header.size() - PFXLEN], PFXLEN);
+
+		for (size_t i = Index; i < Count; i += THDCNT)
+		{
+			const ulong CNKIDX = FirstChunk + i;
+			const size_t PLNLEN = static_cast<size_t>((CNKIDX == CNKCNT - 1) ? PlainLength - (CNKIDX * ChunkSize) : ChunkSize);
+			const size_t INPOFT = i * (m_isEncryption ? ChunkSize : RECLEN);
+			const size_t OUTOFT = i * (m_isEncryption ? RECLEN : ChunkSize);
+
+			IntUtils::Be32ToBytes(static_cast<uint>(CNKIDX), nonce, PFXLEN);
+			nonce[m_nonceSize - 1] = (CNKIDX == CNKCNT - 1) ? 1 : 0;
+
+			try
+			{
+				Key::Symmetric::SymmetricKey kp(m_cipherKey, nonce);
+				engine->Initialize(m_isEncryption, kp);
+				engine->SetAssociatedData(Header, 0, Header.size());
+
+				if (PLNLEN != 0)
+				{
+					engine->Transform(Input, INPOFT, Output, OUTOFT, PLNLEN);
+				}
+
+				if (m_isEncryption)
+				{
+					engine->Finalize(Output, OUTOFT + PLNLEN, TAG_SIZE);
+					authCodes[i] = 1;
+				}
+				else
+				{
+					authCodes[i] = engine->Verify(Input, INPOFT + PLNLEN, TAG_SIZE) ? 1 : 0;
+				}
+			}
+			catch (std::exception&)
+			{
+				authCodes[i] = 0;
+			}
+		}
+
+		IntUtils::ClearVector(nonce);
+	};
+
+	if (THDCNT > 1)
+	{
+		ParallelUtils::ParallelFor(0, THDCNT, process);
+	}
+	else
+	{
+		process(0);
+	}
+
+	bool status = true;
+
+	for (size_t i = 0; i < Count; ++i)
+	{
+		status &= (authCodes[i] == 1);
+	}
+
+	if (!status)
+	{
+		// no plaintext from a batch that failed authentication is released
+		std::memset(Output.data(), 0, Output.size());
+	}
+
+	return status;
+}
+
+NAMESPACE_PROCESSINGEND
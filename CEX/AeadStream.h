@@ -0,0 +1,268 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A chunked authenticated encryption container, using the STREAM construction of Hoang, Reyhanitabar, Rogaway, and Vizar.
+// Online Authenticated-Encryption and its Nonce-Reuse Misuse-Resistance: <a href="https://eprint.iacr.org/2015/189.pdf">OAE2</a>.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_AEADSTREAM_H
+#define CEX_AEADSTREAM_H
+
+#include "CexDomain.h"
+#include "AeadModes.h"
+#include "CipherDescription.h"
+#include "CryptoAuthenticationFailure.h"
+#include "CryptoProcessingException.h"
+#include "IAeadMode.h"
+#include "IByteStream.h"
+#include "ISymmetricKey.h"
+#include "ProgressCounter.h"
+#include "SymmetricKeySize.h"
+
+NAMESPACE_PROCESSING
+
+using Enumeration::AeadModes;
+using Enumeration::BlockCiphers;
+using Exception::CryptoAuthenticationFailure;
+using Exception::CryptoProcessingException;
+using Routing::ProgressCounter;
+using Cipher::Symmetric::Block::Mode::IAeadMode;
+using IO::IByteStream;
+using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeySize;
+
+/// <summary>
+/// A chunked, random-access authenticated encryption container.
+/// <para>Encrypts a stream as a sequence of independently authenticated chunks, so chunks can be processed in parallel, and any byte range can be decrypted by reading only the chunks that cover it.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting a file, and decrypting a byte range:</description>
+/// <code>
+/// CipherDescription cd(BlockCiphers::AHX, 32, IVSizes::V128, CipherModes::GCM, PaddingModes::None, BlockSizes::B128, RoundCounts::R14, Digests::None);
+/// SymmetricKey kp(key);
+///
+/// AeadStream as(&cd);
+/// as.Initialize(true, kp);
+/// as.Write(fIn, fOut);
+///
+/// // decrypt 100 bytes at plaintext offset 1000000, only the covering chunk is read
+/// std::vector&lt;byte&gt; data(100);
+/// as.Initialize(false, kp);
+/// as.Read(fOut, 1000000, data, 0, 100);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Container Format:</B></description>
+/// <para>The container begins with a header; the serialized CipherDescription, the chunk size (4 bytes), the plaintext length (8 bytes), and a random nonce prefix.
+/// The header is followed by one record per chunk, each holding the chunk cipher-text and a 16 byte authentication tag.
+/// Every chunk is encrypted with the nonce <c>prefix || chunk index (4 bytes) || final flag (1 byte)</c>, and authenticates the entire header as associated data,
+/// so chunks can not be reordered, truncated, extended, or moved between containers without failing authentication.</para>
+///
+/// <description><B>Implementation Notes:</B></description>
+/// <list type="bullet">
+/// <item><description>The CipherDescription CipherType() selects the AEAD mode, and must be EAX, GCM, OCB, or ChaCha20Poly1305; the EngineType() selects the block cipher.</description></item>
+/// <item><description>Only the key of the ISymmetricKey is used; each container uses a new random nonce prefix, stored in the header.</description></item>
+/// <item><description>When IsParallel() is true, batches of chunks are encrypted or decrypted concurrently, each thread using its own instance of the AEAD mode.</description></item>
+/// <item><description>Decryption verifies each batch of chunks before it is written to the output stream; if a chunk fails authentication a CryptoAuthenticationFailure is thrown, and the chunks preceding the batch have already been written.</description></item>
+/// <item><description>The Read function decrypts a plaintext byte range, reading and authenticating only the chunks that cover it; the container must begin at the start of the input stream.</description></item>
+/// <item><description>The chunk size is read from the header on decryption; the constructors ChunkSize parameter applies to encryption.</description></item>
+/// <item><description>A container holds at most 2^32 chunks, the range of the chunk index; the plaintext is limited to ChunkSize * 2^32 bytes.</description></item>
+/// </list>
+/// </remarks>
+class AeadStream
+{
+private:
+
+	static const size_t DEF_CHUNKSIZE = 64 * 1024;
+	// the chunk index is a 4 byte nonce field, more chunks would repeat a nonce under the same key
+	static const ulong MAX_CHUNKS = 4294967296ULL;
+	static const size_t MAX_CHUNKSIZE = 16 * 1024 * 1024;
+	static const size_t MIN_CHUNKSIZE = 64;
+	// the chunk index and the final chunk flag
+	static const size_t NONCE_SUFFIX = 5;
+	static const size_t TAG_SIZE = 16;
+	// the number of chunks a thread processes in each batch
+	static const size_t THREAD_CHUNKS = 2;
+
+	std::vector<std::unique_ptr<IAeadMode>> m_aeadEngines;
+	AeadModes m_aeadMode;
+	size_t m_chunkSize;
+	std::vector<byte> m_cipherKey;
+	std::vector<byte> m_description;
+	BlockCiphers m_engineType;
+	bool m_isDestroyed;
+	bool m_isEncryption;
+	bool m_isInitialized;
+	bool m_isParallel;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	size_t m_nonceSize;
+	size_t m_parallelDegree;
+	ProgressCounter m_progressCounter;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	AeadStream(const AeadStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	AeadStream& operator=(const AeadStream&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	AeadStream() = delete;
+
+	/// <summary>
+	/// Initialize the class with a CipherDescription Structure, and the chunk size.
+	/// </summary>
+	///
+	/// <param name="Header">A CipherDescription structure; the cipher type must be one of the AEAD modes</param>
+	/// <param name="ChunkSize">The plaintext size of each chunk in bytes; the default is 64 KB</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the cipher mode is not an AEAD mode, or the chunk size is out of range</exception>
+	explicit AeadStream(CipherDescription* Header, size_t ChunkSize = DEF_CHUNKSIZE);
+
+	/// <summary>
+	/// Destroy this class
+	/// </summary>
+	~AeadStream();
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The plaintext size of each chunk in bytes used for encryption
+	/// </summary>
+	const size_t ChunkSize();
+
+	/// <summary>
+	/// Read Only: The size of the container header in bytes
+	/// </summary>
+	const size_t HeaderSize();
+
+	/// <summary>
+	/// Read/Write: Process batches of chunks on multiple threads.
+	/// <para>Must be set before the Initialize function is called.</para>
+	/// </summary>
+	bool &IsParallel();
+
+	/// <summary>
+	/// Read Only: The supported key sizes for the selected cipher configuration
+	/// </summary>
+	const std::vector<SymmetricKeySize> LegalKeySizes();
+
+	/// <summary>
+	/// Read Only: The plaintext bytes processed by the current Write call; updated with one relaxed atomic add per batch of chunks
+	/// </summary>
+	ProgressCounter &Progress();
+
+	/// <summary>
+	/// Read Only: The size of the authentication tag appended to each chunk
+	/// </summary>
+	const size_t TagSize();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Calculate the size of a container holding a length of plaintext
+	/// </summary>
+	///
+	/// <param name="PlainLength">The plaintext length in bytes</param>
+	///
+	/// <returns>The container size in bytes</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the plaintext exceeds the maximum container length</exception>
+	const ulong CipherLength(ulong PlainLength);
+
+	/// <summary>
+	/// Initialize the container with a key.
+	/// </summary>
+	///
+	/// <param name="Encryption">The container is initialized for encryption</param>
+	/// <param name="KeyParams">The ISymmetricKey containing the cipher key; the nonce is not used</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if an invalid key size is used</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams);
+
+	/// <summary>
+	/// Set the maximum number of threads used to process chunks in parallel.
+	/// <para>Must be called before the Initialize function. Changing this value does not change the container format.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree);
+
+	/// <summary>
+	/// Read the plaintext length from the header of a container
+	/// </summary>
+	///
+	/// <param name="InStream">The container stream; the stream position is not changed</param>
+	///
+	/// <returns>The plaintext length in bytes</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the header does not match the cipher description</exception>
+	ulong PlainLength(IByteStream* InStream);
+
+	/// <summary>
+	/// Decrypt a range of plaintext bytes from a container.
+	/// <para>Only the chunks that cover the range are read and authenticated. The container must be initialized for decryption.</para>
+	/// </summary>
+	///
+	/// <param name="InStream">The container stream</param>
+	/// <param name="Offset">The starting offset within the plaintext</param>
+	/// <param name="Output">The array receiving the plaintext</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	/// <param name="Length">The number of plaintext bytes to decrypt</param>
+	///
+	/// <returns>The number of bytes decrypted</returns>
+	///
+	/// <exception cref="Exception::CryptoAuthenticationFailure">Thrown if a chunk fails authentication</exception>
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the range exceeds the plaintext length, or the header is invalid</exception>
+	size_t Read(IByteStream* InStream, ulong Offset, std::vector<byte> &Output, size_t OutOffset, size_t Length);
+
+	/// <summary>
+	/// Encrypt a stream to a container, or decrypt a container to a stream.
+	/// </summary>
+	///
+	/// <param name="InStream">The input stream; plaintext for encryption, or the container for decryption</param>
+	/// <param name="OutStream">The output stream</param>
+	///
+	/// <exception cref="Exception::CryptoAuthenticationFailure">Thrown if a chunk fails authentication, or the container has been truncated</exception>
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if Write is called before Initialize, the header is invalid, or the plaintext exceeds the maximum container length</exception>
+	void Write(IByteStream* InStream, IByteStream* OutStream);
+
+private:
+
+	ulong ChunkCount(ulong PlainLength, size_t ChunkSize);
+	IAeadMode* CreateEngine();
+	std::vector<byte> CreateHeader(ulong PlainLength);
+	std::vector<byte> ReadHeader(IByteStream* InStream, ulong &PlainLength, size_t &ChunkSize);
+	bool TransformBatch(const std::vector<byte> &Header, ulong FirstChunk, size_t Count, ulong PlainLength, size_t ChunkSize, const std::vector<byte> &Input, std::vector<byte> &Output);
+};
+
+NAMESPACE_PROCESSINGEND
+#endif
@@ -0,0 +1,140 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_ARRAYSPAN_H
+#define CEX_ARRAYSPAN_H
+
+#include "CexDomain.h"
+#include <type_traits>
+
+NAMESPACE_UTILITY
+
+/// <summary>
+/// A non-owning view over a contiguous block of memory.
+/// <para>Exposes the subset of the std::vector interface (value_type, size, data, and the subscript operator) used by the templated
+/// MemUtils, IntUtils, and SIMD wrapper functions, so that caller owned memory (pooled buffers, memory mapped regions)
+/// can be passed through the same kernels as a vector, without an intermediate copy.
+/// The span does not own or free the memory it references; the caller must keep the memory valid for the lifetime of the span.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Wrap a raw buffer and pass it to a templated function:</description>
+/// <code>
+/// ArraySpan&lt;const byte&gt; inp(Input, Length);
+/// ArraySpan&lt;byte&gt; otp(Output, Length);
+/// MemUtils::Copy(inp, 0, otp, 0, Length);
+/// </code>
+/// </example>
+template <typename T>
+class ArraySpan
+{
+public:
+
+	/// <summary>
+	/// The element type, stripped of const and volatile qualifiers
+	/// </summary>
+	typedef typename std::remove_cv<T>::type value_type;
+
+	/// <summary>
+	/// The qualified element type
+	/// </summary>
+	typedef T element_type;
+
+private:
+
+	T* m_spanData;
+	size_t m_spanSize;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Constructor: instantiate an empty span
+	/// </summary>
+	ArraySpan()
+		:
+		m_spanData(nullptr),
+		m_spanSize(0)
+	{
+	}
+
+	/// <summary>
+	/// Constructor: instantiate this class with a pointer and element count
+	/// </summary>
+	///
+	/// <param name="Data">A pointer to the first element</param>
+	/// <param name="Size">The number of elements in the span</param>
+	ArraySpan(T* Data, size_t Size)
+		:
+		m_spanData(Data),
+		m_spanSize(Size)
+	{
+	}
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: A pointer to the first element
+	/// </summary>
+	T* data() const
+	{
+		return m_spanData;
+	}
+
+	/// <summary>
+	/// Read Only: The number of elements in the span
+	/// </summary>
+	size_t size() const
+	{
+		return m_spanSize;
+	}
+
+	/// <summary>
+	/// Read Only: An iterator to the first element
+	/// </summary>
+	T* begin() const
+	{
+		return m_spanData;
+	}
+
+	/// <summary>
+	/// Read Only: An iterator to the element following the last element
+	/// </summary>
+	T* end() const
+	{
+		return m_spanData + m_spanSize;
+	}
+
+	//~~~Operators~~~//
+
+	/// <summary>
+	/// Access an element of the span
+	/// </summary>
+	///
+	/// <param name="Index">The element index</param>
+	///
+	/// <returns>A reference to the element</returns>
+	T &operator[](size_t Index) const
+	{
+		return m_spanData[Index];
+	}
+};
+
+NAMESPACE_UTILITYEND
+#endif
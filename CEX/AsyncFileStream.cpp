@@ -0,0 +1,1106 @@
+#include "AsyncFileStream.h"
+#include "IntUtils.h"
+#include <cstring>
+
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#else
+#	include <errno.h>
+#	include <fcntl.h>
+#	include <sys/stat.h>
+#	include <sys/types.h>
+#	include <unistd.h>
+#	if defined(CEX_HAS_IOURING)
+#		include <linux/io_uring.h>
+#		include <sys/mman.h>
+#		include <sys/syscall.h>
+#		include <sys/uio.h>
+#	endif
+#endif
+
+NAMESPACE_IO
+
+const std::string AsyncFileStream::CLASS_NAME("AsyncFileStream");
+
+#if defined(CEX_HAS_IOURING)
+// the submission and completion rings shared with the kernel; liburing is not a dependency, so the rings are driven with the raw system calls
+struct AsyncFileStream::UringState
+{
+	std::vector<size_t> FreeSlots;
+	std::vector<iovec> IoSlots;
+	int RingHandle;
+	void* CqMap;
+	size_t CqSize;
+	uint* CqHead;
+	uint* CqTail;
+	uint CqMask;
+	io_uring_cqe* Cqes;
+	void* SqMap;
+	size_t SqSize;
+	uint* SqArray;
+	uint* SqHead;
+	uint* SqTail;
+	uint SqMask;
+	io_uring_sqe* Sqes;
+	size_t SqesSize;
+
+	UringState()
+		:
+		FreeSlots(0),
+		IoSlots(0),
+		RingHandle(-1),
+		CqMap(MAP_FAILED),
+		CqSize(0),
+		CqHead(nullptr),
+		CqTail(nullptr),
+		CqMask(0),
+		Cqes(nullptr),
+		SqMap(MAP_FAILED),
+		SqSize(0),
+		SqArray(nullptr),
+		SqHead(nullptr),
+		SqTail(nullptr),
+		SqMask(0),
+		Sqes(static_cast<io_uring_sqe*>(MAP_FAILED)),
+		SqesSize(0)
+	{
+	}
+
+	int Enter(uint Submit, uint Complete, uint Flags)
+	{
+		return static_cast<int>(syscall(__NR_io_uring_enter, RingHandle, Submit, Complete, Flags, nullptr, 0));
+	}
+};
+#else
+struct AsyncFileStream::UringState
+{
+};
+#endif
+
+//~~~Constructor~~~//
+
+AsyncFileStream::AsyncFileStream(const std::string &FileName, FileAccess Access, bool Direct, size_t QueueDepth)
+	:
+	m_activeRequests(),
+	m_chunkIndex(0),
+	m_completedRequests(),
+	m_fileAccess(Access),
+#if defined(CEX_OS_WINDOWS)
+	m_fileHandle(INVALID_HANDLE_VALUE),
+#else
+	m_fileHandle(-1),
+#endif
+	m_fileName(FileName),
+	m_filePosition(0),
+	m_fileSize(0),
+	m_isDestroyed(false),
+	m_isDirect(Direct && Access != FileAccess::ReadWrite),
+	m_nextTicket(1),
+	m_queueDepth(QueueDepth != 0 && QueueDepth <= MAX_QUEUEDEPTH ? QueueDepth :
+		throw CryptoProcessingException("AsyncFileStream:CTor", "The queue depth must be between 1 and 4096!")),
+	m_queuedRequests(),
+	m_readBase(0),
+	m_streamChunks(0),
+	m_uringState(nullptr)
+{
+#if defined(CEX_OS_WINDOWS)
+	const DWORD ACCESS = (Access == FileAccess::Read) ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+	const DWORD CREATE = (Access == FileAccess::Read) ? OPEN_EXISTING : (Access == FileAccess::Write) ? CREATE_ALWAYS : OPEN_ALWAYS;
+	const DWORD FLAGS = FILE_FLAG_SEQUENTIAL_SCAN | (m_isDirect ? FILE_FLAG_NO_BUFFERING : 0);
+	LARGE_INTEGER size;
+
+	m_fileHandle = CreateFileA(m_fileName.c_str(), ACCESS, FILE_SHARE_READ, nullptr, CREATE, FLAGS, nullptr);
+
+	if (m_fileHandle == INVALID_HANDLE_VALUE)
+	{
+		throw CryptoProcessingException("AsyncFileStream:CTor", "The file could not be opened!");
+	}
+
+	if (!GetFileSizeEx(m_fileHandle, &size))
+	{
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+		throw CryptoProcessingException("AsyncFileStream:CTor", "The file size could not be read!");
+	}
+
+	m_fileSize = static_cast<ulong>(size.QuadPart);
+#else
+	const int FLAGS = (Access == FileAccess::Read) ? O_RDONLY : (Access == FileAccess::Write) ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR | O_CREAT;
+	struct stat fst;
+
+#	if defined(O_DIRECT)
+	if (m_isDirect)
+	{
+		m_fileHandle = open(m_fileName.c_str(), FLAGS | O_DIRECT, 0644);
+
+		// the file system does not support direct i/o
+		if (m_fileHandle == -1 && errno == EINVAL)
+		{
+			m_isDirect = false;
+		}
+	}
+#	else
+	m_isDirect = false;
+#	endif
+
+	if (!m_isDirect)
+	{
+		m_fileHandle = open(m_fileName.c_str(), FLAGS, 0644);
+	}
+
+	if (m_fileHandle == -1)
+	{
+		throw CryptoProcessingException("AsyncFileStream:CTor", "The file could not be opened!");
+	}
+
+	if (fstat(m_fileHandle, &fst) != 0)
+	{
+		close(m_fileHandle);
+		m_fileHandle = -1;
+		throw CryptoProcessingException("AsyncFileStream:CTor", "The file size could not be read!");
+	}
+
+	m_fileSize = static_cast<ulong>(fst.st_size);
+#endif
+
+	// a single request in flight gains nothing from the ring
+	if (m_queueDepth > 1 && !UringCreate())
+	{
+		UringDestroy();
+	}
+
+	m_streamChunks.resize(Utility::IntUtils::Min(m_queueDepth, MAX_CHUNKCOUNT));
+
+	for (size_t i = 0; i < m_streamChunks.size(); ++i)
+	{
+		StreamChunk &chk = m_streamChunks[i];
+		chk.Data = AlignBuffer(chk.Storage, DEF_CHUNKSIZE);
+		chk.Position = 0;
+		chk.Length = 0;
+		chk.DirtyLow = DEF_CHUNKSIZE;
+		chk.DirtyHigh = 0;
+		chk.Ticket = 0;
+		chk.IsActive = false;
+	}
+}
+
+AsyncFileStream::~AsyncFileStream()
+{
+	Destroy();
+}
+
+//~~~Accessors~~~//
+
+const AsyncFileStream::FileAccess AsyncFileStream::Access()
+{
+	return m_fileAccess;
+}
+
+const size_t AsyncFileStream::Alignment()
+{
+	return DEF_ALIGNMENT;
+}
+
+const bool AsyncFileStream::CanRead()
+{
+	return m_fileAccess != FileAccess::Write;
+}
+
+const bool AsyncFileStream::CanSeek()
+{
+	return true;
+}
+
+const bool AsyncFileStream::CanWrite()
+{
+	return m_fileAccess != FileAccess::Read;
+}
+
+const size_t AsyncFileStream::ChunkSize()
+{
+	return DEF_CHUNKSIZE;
+}
+
+const StreamModes AsyncFileStream::Enumeral()
+{
+	return StreamModes::AsyncFileStream;
+}
+
+std::string AsyncFileStream::FileName()
+{
+	return m_fileName;
+}
+
+const bool AsyncFileStream::IsDirect()
+{
+	return m_isDirect;
+}
+
+const bool AsyncFileStream::IsUring()
+{
+	return m_uringState != nullptr;
+}
+
+const ulong AsyncFileStream::Length()
+{
+	return m_fileSize;
+}
+
+const std::string AsyncFileStream::Name()
+{
+	return CLASS_NAME;
+}
+
+const ulong AsyncFileStream::Position()
+{
+	return m_filePosition;
+}
+
+const size_t AsyncFileStream::QueueDepth()
+{
+	return m_queueDepth;
+}
+
+//~~~Public Functions~~~//
+
+byte* AsyncFileStream::AlignBuffer(std::vector<byte> &Storage, size_t Length)
+{
+	const size_t BUFLEN = (Length + DEF_ALIGNMENT - 1) - ((Length + DEF_ALIGNMENT - 1) % DEF_ALIGNMENT);
+
+	Storage.resize(BUFLEN + DEF_ALIGNMENT);
+	const size_t ADDOFT = (DEF_ALIGNMENT - (reinterpret_cast<size_t>(Storage.data()) % DEF_ALIGNMENT)) % DEF_ALIGNMENT;
+
+	return Storage.data() + ADDOFT;
+}
+
+void AsyncFileStream::Close()
+{
+	bool failed = false;
+
+#if defined(CEX_OS_WINDOWS)
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+#else
+	if (m_fileHandle != -1)
+#endif
+	{
+		if (m_fileAccess != FileAccess::Read)
+		{
+			try
+			{
+				Flush();
+			}
+			catch (CryptoProcessingException&)
+			{
+				failed = true;
+			}
+		}
+
+		// the kernel may still be using the buffers of a failed or abandoned request
+		WaitAll();
+		UringDestroy();
+
+#if defined(CEX_OS_WINDOWS)
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+#else
+		close(m_fileHandle);
+		m_fileHandle = -1;
+#endif
+	}
+
+	for (size_t i = 0; i < m_streamChunks.size(); ++i)
+	{
+		m_streamChunks[i].Ticket = 0;
+		m_streamChunks[i].IsActive = false;
+	}
+
+	m_activeRequests.clear();
+	m_completedRequests.clear();
+	m_queuedRequests.clear();
+	m_chunkIndex = 0;
+	m_filePosition = 0;
+	m_fileSize = 0;
+	m_readBase = 0;
+
+	if (failed)
+	{
+		throw CryptoProcessingException("AsyncFileStream:Close", "The buffered data could not be written!");
+	}
+}
+
+void AsyncFileStream::CopyTo(IByteStream* Destination)
+{
+	CexAssert(m_fileSize != 0, "stream is too short");
+
+	std::vector<byte> buffer(DEF_CHUNKSIZE);
+	size_t prcLen;
+
+	Seek(0, SeekOrigin::Begin);
+	Destination->Seek(0, IO::SeekOrigin::Begin);
+
+	while ((prcLen = Read(buffer, 0, buffer.size())) != 0)
+	{
+		Destination->Write(buffer, 0, prcLen);
+	}
+}
+
+void AsyncFileStream::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+
+		try
+		{
+			Close();
+		}
+		catch (CryptoProcessingException&)
+		{
+			// called by the destructor; a failed write cannot be reported
+		}
+
+		for (size_t i = 0; i < m_streamChunks.size(); ++i)
+		{
+			Utility::IntUtils::ClearVector(m_streamChunks[i].Storage);
+		}
+
+		m_streamChunks.clear();
+		m_fileName.clear();
+	}
+}
+
+void AsyncFileStream::Flush()
+{
+	if (m_fileAccess != FileAccess::Read)
+	{
+		if (m_streamChunks.size() != 0 && m_streamChunks[m_chunkIndex].IsActive)
+		{
+			Release(m_streamChunks[m_chunkIndex]);
+		}
+
+		for (size_t i = 0; i < m_streamChunks.size(); ++i)
+		{
+			if (m_streamChunks[i].Ticket != 0)
+			{
+				const size_t TICKET = m_streamChunks[i].Ticket;
+				m_streamChunks[i].Ticket = 0;
+				Wait(TICKET);
+			}
+		}
+	}
+
+	WaitAll();
+
+	// direct writes are padded to the alignment
+	if (m_isDirect && m_fileAccess != FileAccess::Read)
+	{
+		Truncate(m_fileSize);
+	}
+}
+
+size_t AsyncFileStream::QueueRead(byte* Output, size_t Length, ulong Position)
+{
+	CexAssert(m_fileAccess != FileAccess::Write, "File is write only");
+	CexAssert(!m_isDirect || (reinterpret_cast<size_t>(Output) % DEF_ALIGNMENT == 0 && Position % DEF_ALIGNMENT == 0), "Direct i/o requires an aligned buffer and position");
+
+	const size_t REQLEN = m_isDirect ? (Length + DEF_ALIGNMENT - 1) - ((Length + DEF_ALIGNMENT - 1) % DEF_ALIGNMENT) : Length;
+
+	return Queue(Output, REQLEN, Position, false);
+}
+
+size_t AsyncFileStream::QueueWrite(const byte* Input, size_t Length, ulong Position)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+	CexAssert(!m_isDirect || (reinterpret_cast<size_t>(Input) % DEF_ALIGNMENT == 0 && Position % DEF_ALIGNMENT == 0), "Direct i/o requires an aligned buffer and position");
+
+	const size_t REQLEN = m_isDirect ? (Length + DEF_ALIGNMENT - 1) - ((Length + DEF_ALIGNMENT - 1) % DEF_ALIGNMENT) : Length;
+
+	if (Position + Length > m_fileSize)
+	{
+		m_fileSize = Position + Length;
+	}
+
+	// the request only reads from the buffer
+	return Queue(const_cast<byte*>(Input), REQLEN, Position, true);
+}
+
+size_t AsyncFileStream::Read(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess != FileAccess::Write, "File is write only");
+	CexAssert(Output.size() >= Offset + Length, "Output array is too small");
+
+	if (m_filePosition >= m_fileSize)
+	{
+		return 0;
+	}
+
+	if (Length > m_fileSize - m_filePosition)
+	{
+		Length = static_cast<size_t>(m_fileSize - m_filePosition);
+	}
+
+	if (m_fileAccess == FileAccess::ReadWrite)
+	{
+		// a read-write stream reads the file after the buffered writes have completed
+		Flush();
+
+		const AsyncRequest REQ = { Output.data() + Offset, Length, m_filePosition, false };
+		const long long RES = Execute(REQ);
+
+		if (RES < 0)
+		{
+			throw CryptoProcessingException("AsyncFileStream:Read", "The file could not be read!");
+		}
+
+		m_filePosition += static_cast<ulong>(RES);
+
+		return static_cast<size_t>(RES);
+	}
+
+	const size_t CHKCNT = m_streamChunks.size();
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		const ulong WNDEND = m_readBase + (static_cast<ulong>(CHKCNT) * DEF_CHUNKSIZE);
+
+		if (!m_streamChunks[m_chunkIndex].IsActive || m_filePosition < m_readBase || m_filePosition >= WNDEND)
+		{
+			Restart(m_filePosition - (m_filePosition % DEF_CHUNKSIZE));
+		}
+
+		// recycle the chunks behind the position to read ahead of the window
+		while (m_filePosition >= m_readBase + DEF_CHUNKSIZE)
+		{
+			StreamChunk &chk = m_streamChunks[m_chunkIndex];
+			const ulong NXTPOS = m_readBase + (static_cast<ulong>(CHKCNT) * DEF_CHUNKSIZE);
+
+			if (chk.Ticket != 0)
+			{
+				const size_t TICKET = chk.Ticket;
+				chk.Ticket = 0;
+				Wait(TICKET);
+			}
+
+			chk.Position = NXTPOS;
+			chk.IsActive = NXTPOS < m_fileSize;
+
+			if (chk.IsActive)
+			{
+				chk.Ticket = Queue(chk.Data, DEF_CHUNKSIZE, NXTPOS, false);
+			}
+
+			m_chunkIndex = (m_chunkIndex + 1) % CHKCNT;
+			m_readBase += DEF_CHUNKSIZE;
+		}
+
+		Submit();
+
+		StreamChunk &chk = m_streamChunks[m_chunkIndex];
+
+		if (chk.Ticket != 0)
+		{
+			const size_t TICKET = chk.Ticket;
+			chk.Ticket = 0;
+			chk.Length = Wait(TICKET);
+		}
+
+		const size_t CHKOFT = static_cast<size_t>(m_filePosition - chk.Position);
+
+		if (CHKOFT >= chk.Length)
+		{
+			throw CryptoProcessingException("AsyncFileStream:Read", "The file is shorter than the stream length!");
+		}
+
+		const size_t CPYLEN = Utility::IntUtils::Min(chk.Length - CHKOFT, Length - prcLen);
+		std::memcpy(Output.data() + Offset + prcLen, chk.Data + CHKOFT, CPYLEN);
+		m_filePosition += CPYLEN;
+		prcLen += CPYLEN;
+	}
+
+	return Length;
+}
+
+byte AsyncFileStream::ReadByte()
+{
+	CexAssert(m_fileSize - m_filePosition >= 1, "Reached end of file");
+	CexAssert(m_fileAccess != FileAccess::Write, "File is write only");
+
+	std::vector<byte> data(1);
+	Read(data, 0, 1);
+
+	return data[0];
+}
+
+void AsyncFileStream::Reset()
+{
+	m_filePosition = 0;
+}
+
+void AsyncFileStream::Seek(ulong Offset, SeekOrigin Origin)
+{
+	if (Origin == SeekOrigin::Begin)
+	{
+		m_filePosition = Offset;
+	}
+	else if (Origin == SeekOrigin::End)
+	{
+		m_filePosition = m_fileSize - Offset;
+	}
+	else
+	{
+		m_filePosition += Offset;
+	}
+
+	CexAssert(m_filePosition <= m_fileSize, "Seek position exceeds the file length");
+}
+
+void AsyncFileStream::SetLength(ulong Length)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+
+	Flush();
+	Truncate(Length);
+	m_fileSize = Length;
+
+	if (m_filePosition > m_fileSize)
+	{
+		m_filePosition = m_fileSize;
+	}
+}
+
+void AsyncFileStream::Submit()
+{
+	if (m_queuedRequests.size() == 0)
+	{
+		return;
+	}
+
+#if defined(CEX_HAS_IOURING)
+	if (m_uringState != nullptr)
+	{
+		UringState &ring = *m_uringState;
+		uint tail = *ring.SqTail;
+		uint subCnt = 0;
+
+		for (std::map<size_t, AsyncRequest>::iterator it = m_queuedRequests.begin(); it != m_queuedRequests.end(); ++it)
+		{
+			const size_t SLTIDX = ring.FreeSlots.back();
+			const uint SQEIDX = tail & ring.SqMask;
+			io_uring_sqe* sqe = &ring.Sqes[SQEIDX];
+
+			ring.FreeSlots.pop_back();
+			ring.IoSlots[SLTIDX].iov_base = it->second.Buffer;
+			ring.IoSlots[SLTIDX].iov_len = it->second.Length;
+
+			std::memset(sqe, 0, sizeof(io_uring_sqe));
+			sqe->opcode = it->second.IsWrite ? IORING_OP_WRITEV : IORING_OP_READV;
+			sqe->fd = m_fileHandle;
+			sqe->addr = reinterpret_cast<ulong>(&ring.IoSlots[SLTIDX]);
+			sqe->len = 1;
+			sqe->off = it->second.Position;
+			// the slot index is carried in the low bits, so the vector is returned on completion
+			sqe->user_data = (static_cast<ulong>(it->first) << 16) | SLTIDX;
+			ring.SqArray[SQEIDX] = SQEIDX;
+
+			m_activeRequests.insert(*it);
+			++tail;
+			++subCnt;
+		}
+
+		m_queuedRequests.clear();
+		__atomic_store_n(ring.SqTail, tail, __ATOMIC_RELEASE);
+
+		while (subCnt != 0)
+		{
+			const int RES = ring.Enter(subCnt, 0, 0);
+
+			if (RES < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				throw CryptoProcessingException("AsyncFileStream:Submit", "The requests could not be submitted!");
+			}
+
+			subCnt -= static_cast<uint>(RES);
+		}
+
+		return;
+	}
+#endif
+
+	// without the ring, requests complete when they are submitted
+	for (std::map<size_t, AsyncRequest>::iterator it = m_queuedRequests.begin(); it != m_queuedRequests.end(); ++it)
+	{
+		m_completedRequests[it->first] = Execute(it->second);
+	}
+
+	m_queuedRequests.clear();
+}
+
+size_t AsyncFileStream::Wait(size_t Request)
+{
+	if (m_queuedRequests.find(Request) != m_queuedRequests.end())
+	{
+		Submit();
+	}
+
+	std::map<size_t, long long>::iterator it = m_completedRequests.find(Request);
+
+	while (it == m_completedRequests.end())
+	{
+		if (m_activeRequests.find(Request) == m_activeRequests.end())
+		{
+			throw CryptoProcessingException("AsyncFileStream:Wait", "The request is unknown!");
+		}
+
+		Reap(1);
+		it = m_completedRequests.find(Request);
+	}
+
+	const long long RES = it->second;
+	m_completedRequests.erase(it);
+
+	if (RES < 0)
+	{
+		throw CryptoProcessingException("AsyncFileStream:Wait", "The request failed!");
+	}
+
+	return static_cast<size_t>(RES);
+}
+
+void AsyncFileStream::Write(const std::vector<byte> &Input, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+	CexAssert(Input.size() >= Offset + Length, "Input array is too small");
+
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		Activate(m_filePosition);
+
+		StreamChunk &chk = m_streamChunks[m_chunkIndex];
+		const size_t CHKOFT = static_cast<size_t>(m_filePosition - chk.Position);
+		const size_t CPYLEN = Utility::IntUtils::Min(DEF_CHUNKSIZE - CHKOFT, Length - prcLen);
+
+		std::memcpy(chk.Data + CHKOFT, Input.data() + Offset + prcLen, CPYLEN);
+		chk.DirtyLow = Utility::IntUtils::Min(chk.DirtyLow, CHKOFT);
+		chk.DirtyHigh = Utility::IntUtils::Max(chk.DirtyHigh, CHKOFT + CPYLEN);
+		m_filePosition += CPYLEN;
+		prcLen += CPYLEN;
+	}
+
+	if (m_filePosition > m_fileSize)
+	{
+		m_fileSize = m_filePosition;
+	}
+}
+
+void AsyncFileStream::WriteByte(byte Value)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+
+	std::vector<byte> data(1, Value);
+	Write(data, 0, 1);
+}
+
+//~~~Private Functions~~~//
+
+void AsyncFileStream::Activate(ulong Position)
+{
+	const ulong CHKPOS = Position - (Position % DEF_CHUNKSIZE);
+
+	if (m_streamChunks[m_chunkIndex].IsActive && m_streamChunks[m_chunkIndex].Position == CHKPOS)
+	{
+		return;
+	}
+
+	if (m_streamChunks[m_chunkIndex].IsActive)
+	{
+		// write the filled chunk behind the position
+		Release(m_streamChunks[m_chunkIndex]);
+		m_chunkIndex = (m_chunkIndex + 1) % m_streamChunks.size();
+	}
+
+	// the kernel does not order requests, so a pending write to the same range completes first
+	for (size_t i = 0; i < m_streamChunks.size(); ++i)
+	{
+		StreamChunk &chk = m_streamChunks[i];
+
+		if (chk.Ticket != 0 && (i == m_chunkIndex || chk.Position == CHKPOS))
+		{
+			const size_t TICKET = chk.Ticket;
+			chk.Ticket = 0;
+			Wait(TICKET);
+		}
+	}
+
+	StreamChunk &chk = m_streamChunks[m_chunkIndex];
+
+	if (m_isDirect)
+	{
+		// direct writes cover whole aligned blocks, so the chunk holds the current file contents
+		size_t prcLen = 0;
+
+		if (CHKPOS < m_fileSize)
+		{
+			const AsyncRequest REQ = { chk.Data, DEF_CHUNKSIZE, CHKPOS, false };
+			const long long RES = Execute(REQ);
+
+			if (RES < 0)
+			{
+				throw CryptoProcessingException("AsyncFileStream:Activate", "The file could not be read!");
+			}
+
+			prcLen = static_cast<size_t>(Utility::IntUtils::Min(static_cast<ulong>(RES), m_fileSize - CHKPOS));
+		}
+
+		std::memset(chk.Data + prcLen, 0, DEF_CHUNKSIZE - prcLen);
+	}
+
+	chk.Position = CHKPOS;
+	chk.Length = DEF_CHUNKSIZE;
+	chk.DirtyLow = DEF_CHUNKSIZE;
+	chk.DirtyHigh = 0;
+	chk.IsActive = true;
+}
+
+long long AsyncFileStream::Execute(const AsyncRequest &Request)
+{
+	size_t prcLen = 0;
+
+	while (prcLen != Request.Length)
+	{
+#if defined(CEX_OS_WINDOWS)
+		const ulong REQPOS = Request.Position + prcLen;
+		OVERLAPPED ovl;
+		DWORD reqLen = 0;
+
+		std::memset(&ovl, 0, sizeof(OVERLAPPED));
+		ovl.Offset = static_cast<DWORD>(REQPOS);
+		ovl.OffsetHigh = static_cast<DWORD>(REQPOS >> 32);
+
+		const BOOL SUCCESS = Request.IsWrite ?
+			WriteFile(m_fileHandle, Request.Buffer + prcLen, static_cast<DWORD>(Request.Length - prcLen), &reqLen, &ovl) :
+			ReadFile(m_fileHandle, Request.Buffer + prcLen, static_cast<DWORD>(Request.Length - prcLen), &reqLen, &ovl);
+
+		if (!SUCCESS)
+		{
+			const DWORD ERRCDE = GetLastError();
+
+			if (ERRCDE == ERROR_HANDLE_EOF)
+			{
+				break;
+			}
+
+			return -static_cast<long long>(ERRCDE);
+		}
+
+		const long long RES = static_cast<long long>(reqLen);
+#else
+		const long long RES = Request.IsWrite ?
+			static_cast<long long>(pwrite(m_fileHandle, Request.Buffer + prcLen, Request.Length - prcLen, static_cast<off_t>(Request.Position + prcLen))) :
+			static_cast<long long>(pread(m_fileHandle, Request.Buffer + prcLen, Request.Length - prcLen, static_cast<off_t>(Request.Position + prcLen)));
+
+		if (RES < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			return -static_cast<long long>(errno);
+		}
+#endif
+
+		if (RES == 0)
+		{
+			break;
+		}
+
+		prcLen += static_cast<size_t>(RES);
+
+		// a short direct read is the end of the file, and the remainder is not aligned
+		if (m_isDirect && !Request.IsWrite)
+		{
+			break;
+		}
+	}
+
+	return static_cast<long long>(prcLen);
+}
+
+size_t AsyncFileStream::Queue(byte* Buffer, size_t Length, ulong Position, bool IsWrite)
+{
+	if (m_queuedRequests.size() + m_activeRequests.size() >= m_queueDepth)
+	{
+		Submit();
+		Reap(1);
+	}
+
+	const size_t TICKET = m_nextTicket;
+	const AsyncRequest REQ = { Buffer, Length, Position, IsWrite };
+
+	++m_nextTicket;
+	m_queuedRequests[TICKET] = REQ;
+
+	return TICKET;
+}
+
+void AsyncFileStream::Reap(size_t Count)
+{
+	Count = Utility::IntUtils::Min(Count, m_activeRequests.size());
+
+#if defined(CEX_HAS_IOURING)
+	if (m_uringState != nullptr)
+	{
+		UringState &ring = *m_uringState;
+		size_t rcpCnt = 0;
+
+		while (rcpCnt < Count)
+		{
+			uint head = *ring.CqHead;
+			const uint TAIL = __atomic_load_n(ring.CqTail, __ATOMIC_ACQUIRE);
+
+			while (head != TAIL)
+			{
+				const io_uring_cqe* CQE = &ring.Cqes[head & ring.CqMask];
+				const size_t TICKET = static_cast<size_t>(CQE->user_data >> 16);
+				const size_t SLTIDX = static_cast<size_t>(CQE->user_data & 0xFFFF);
+				std::map<size_t, AsyncRequest>::iterator it = m_activeRequests.find(TICKET);
+				long long res = static_cast<long long>(CQE->res);
+
+				ring.FreeSlots.push_back(SLTIDX);
+
+				if (res > 0 && static_cast<size_t>(res) < it->second.Length && (it->second.IsWrite || !m_isDirect))
+				{
+					// complete a short transfer in place
+					const AsyncRequest REQ = { it->second.Buffer + res, it->second.Length - static_cast<size_t>(res), it->second.Position + static_cast<ulong>(res), it->second.IsWrite };
+					const long long EXTLEN = Execute(REQ);
+					res = (EXTLEN < 0) ? EXTLEN : res + EXTLEN;
+				}
+
+				m_completedRequests[TICKET] = res;
+				m_activeRequests.erase(it);
+				++head;
+				++rcpCnt;
+			}
+
+			__atomic_store_n(ring.CqHead, head, __ATOMIC_RELEASE);
+
+			if (rcpCnt < Count)
+			{
+				const int RES = ring.Enter(0, static_cast<uint>(Count - rcpCnt), IORING_ENTER_GETEVENTS);
+
+				if (RES < 0 && errno != EINTR)
+				{
+					throw CryptoProcessingException("AsyncFileStream:Reap", "The request completions could not be read!");
+				}
+			}
+		}
+	}
+#endif
+}
+
+void AsyncFileStream::Release(StreamChunk &Chunk)
+{
+	if (Chunk.DirtyHigh > Chunk.DirtyLow)
+	{
+		size_t lowPos = Chunk.DirtyLow;
+		size_t highPos = Chunk.DirtyHigh;
+
+		if (m_isDirect)
+		{
+			// the chunk holds the file contents around the written range
+			lowPos -= lowPos % DEF_ALIGNMENT;
+			highPos = (highPos + DEF_ALIGNMENT - 1) - ((highPos + DEF_ALIGNMENT - 1) % DEF_ALIGNMENT);
+		}
+
+		Chunk.Ticket = Queue(Chunk.Data + lowPos, highPos - lowPos, Chunk.Position + lowPos, true);
+		Submit();
+	}
+
+	Chunk.IsActive = false;
+}
+
+void AsyncFileStream::Restart(ulong Position)
+{
+	const size_t CHKCNT = m_streamChunks.size();
+
+	for (size_t i = 0; i < CHKCNT; ++i)
+	{
+		if (m_streamChunks[i].Ticket != 0)
+		{
+			const size_t TICKET = m_streamChunks[i].Ticket;
+			m_streamChunks[i].Ticket = 0;
+			Wait(TICKET);
+		}
+	}
+
+	m_chunkIndex = 0;
+	m_readBase = Position;
+
+	// fill the window ahead of the position
+	for (size_t i = 0; i < CHKCNT; ++i)
+	{
+		StreamChunk &chk = m_streamChunks[i];
+
+		chk.Position = Position + (static_cast<ulong>(i) * DEF_CHUNKSIZE);
+		chk.Length = 0;
+		chk.IsActive = chk.Position < m_fileSize;
+
+		if (chk.IsActive)
+		{
+			chk.Ticket = Queue(chk.Data, DEF_CHUNKSIZE, chk.Position, false);
+		}
+	}
+
+	Submit();
+}
+
+void AsyncFileStream::Truncate(ulong Length)
+{
+#if defined(CEX_OS_WINDOWS)
+	LARGE_INTEGER size;
+	size.QuadPart = static_cast<LONGLONG>(Length);
+
+	if (!SetFilePointerEx(m_fileHandle, size, nullptr, FILE_BEGIN) || !SetEndOfFile(m_fileHandle))
+	{
+		throw CryptoProcessingException("AsyncFileStream:Truncate", "The file length could not be set!");
+	}
+#else
+	if (ftruncate(m_fileHandle, static_cast<off_t>(Length)) != 0)
+	{
+		throw CryptoProcessingException("AsyncFileStream:Truncate", "The file length could not be set!");
+	}
+#endif
+}
+
+bool AsyncFileStream::UringCreate()
+{
+#if defined(CEX_HAS_IOURING)
+	io_uring_params prm;
+
+	std::memset(&prm, 0, sizeof(io_uring_params));
+	m_uringState.reset(new UringState());
+	UringState &ring = *m_uringState;
+
+	ring.RingHandle = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<uint>(m_queueDepth), &prm));
+
+	// io_uring is not supported by the kernel, or has been disabled
+	if (ring.RingHandle < 0)
+	{
+		return false;
+	}
+
+	ring.SqSize = prm.sq_off.array + (prm.sq_entries * sizeof(uint));
+	ring.CqSize = prm.cq_off.cqes + (prm.cq_entries * sizeof(io_uring_cqe));
+
+	if ((prm.features & IORING_FEAT_SINGLE_MMAP) != 0)
+	{
+		ring.SqSize = Utility::IntUtils::Max(ring.SqSize, ring.CqSize);
+		ring.CqSize = ring.SqSize;
+	}
+
+	ring.SqMap = mmap(nullptr, ring.SqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.RingHandle, IORING_OFF_SQ_RING);
+
+	if (ring.SqMap == MAP_FAILED)
+	{
+		return false;
+	}
+
+	if ((prm.features & IORING_FEAT_SINGLE_MMAP) != 0)
+	{
+		ring.CqMap = ring.SqMap;
+	}
+	else
+	{
+		ring.CqMap = mmap(nullptr, ring.CqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.RingHandle, IORING_OFF_CQ_RING);
+
+		if (ring.CqMap == MAP_FAILED)
+		{
+			return false;
+		}
+	}
+
+	ring.SqesSize = prm.sq_entries * sizeof(io_uring_sqe);
+	ring.Sqes = static_cast<io_uring_sqe*>(mmap(nullptr, ring.SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.RingHandle, IORING_OFF_SQES));
+
+	if (ring.Sqes == MAP_FAILED)
+	{
+		return false;
+	}
+
+	byte* sqPtr = static_cast<byte*>(ring.SqMap);
+	byte* cqPtr = static_cast<byte*>(ring.CqMap);
+
+	ring.SqHead = reinterpret_cast<uint*>(sqPtr + prm.sq_off.head);
+	ring.SqTail = reinterpret_cast<uint*>(sqPtr + prm.sq_off.tail);
+	ring.SqMask = *reinterpret_cast<uint*>(sqPtr + prm.sq_off.ring_mask);
+	ring.SqArray = reinterpret_cast<uint*>(sqPtr + prm.sq_off.array);
+	ring.CqHead = reinterpret_cast<uint*>(cqPtr + prm.cq_off.head);
+	ring.CqTail = reinterpret_cast<uint*>(cqPtr + prm.cq_off.tail);
+	ring.CqMask = *reinterpret_cast<uint*>(cqPtr + prm.cq_off.ring_mask);
+	ring.Cqes = reinterpret_cast<io_uring_cqe*>(cqPtr + prm.cq_off.cqes);
+
+	ring.IoSlots.resize(m_queueDepth);
+	ring.FreeSlots.resize(m_queueDepth);
+
+	for (size_t i = 0; i < m_queueDepth; ++i)
+	{
+		ring.FreeSlots[i] = m_queueDepth - 1 - i;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void AsyncFileStream::UringDestroy()
+{
+#if defined(CEX_HAS_IOURING)
+	if (m_uringState != nullptr)
+	{
+		UringState &ring = *m_uringState;
+
+		if (ring.Sqes != MAP_FAILED)
+		{
+			munmap(ring.Sqes, ring.SqesSize);
+		}
+
+		if (ring.CqMap != MAP_FAILED && ring.CqMap != ring.SqMap)
+		{
+			munmap(ring.CqMap, ring.CqSize);
+		}
+
+		if (ring.SqMap != MAP_FAILED)
+		{
+			munmap(ring.SqMap, ring.SqSize);
+		}
+
+		if (ring.RingHandle >= 0)
+		{
+			close(ring.RingHandle);
+		}
+	}
+#endif
+
+	m_uringState.reset();
+}
+
+void AsyncFileStream::WaitAll()
+{
+	Submit();
+
+	while (m_activeRequests.size() != 0)
+	{
+		Reap(m_activeRequests.size());
+	}
+}
+
+NAMESPACE_IOEND
@@ -0,0 +1,363 @@
+#ifndef CEX_ASYNCFILESTREAM_H
+#define CEX_ASYNCFILESTREAM_H
+
+#include "IByteStream.h"
+#include <map>
+
+NAMESPACE_IO
+
+/// <summary>
+/// An asynchronous file streaming container.
+/// <para>Keeps many reads and writes in flight at once; on Linux the requests are submitted in batches through io_uring, elsewhere, or if io_uring is unavailable, they are executed with positional reads and writes.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting a file with asynchronous input and output streams:</description>
+/// <code>
+/// AsyncFileStream* fIn = new AsyncFileStream("/data/test.bin", AsyncFileStream::FileAccess::Read, true);
+/// AsyncFileStream* fOut = new AsyncFileStream("/data/testenc.bin", AsyncFileStream::FileAccess::Write, true);
+///
+/// Processing::CipherStream cs(Enumeration::BlockCiphers::AHX, Enumeration::Digests::None, 14, Enumeration::CipherModes::CTR);
+/// cs.Initialize(true, kp);
+/// // the cipher keeps QueueDepth() chunks of the input and output in flight
+/// cs.Write(fIn, fOut);
+///
+/// fIn->Close();
+/// fOut->Close();
+/// delete fIn;
+/// delete fOut;
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>Read opens an existing file read-only, ReadWrite opens or creates a file and retains its contents, and Write creates or truncates the file.</description></item>
+/// <item><description>The stream functions are buffered in up to 16 chunks of ChunkSize() bytes, bounded by QueueDepth(); a Read stream reads ahead of the position, and a Write stream writes each chunk behind the position as it is filled, so sequential access keeps the device queue full.</description></item>
+/// <item><description>The request functions QueueRead, QueueWrite, Submit, and Wait expose the queue directly; queued requests are submitted together, and a request is identified by the number returned when it is queued.</description></item>
+/// <item><description>The Direct flag opens the file with O_DIRECT (FILE_FLAG_NO_BUFFERING on Windows), bypassing the page cache for one-pass bulk transforms; it applies to the Read and Write access modes, and IsDirect() is false if the file system does not support it.</description></item>
+/// <item><description>With Direct i/o, request buffers and positions must be aligned to Alignment(), and a buffer must have room for its length rounded up to Alignment(); AlignBuffer(std::vector&lt;byte&gt;, size_t) allocates such a buffer. The file is trimmed to Length() when the stream is flushed or closed.</description></item>
+/// <item><description>A queue depth of one executes each request with positional reads and writes, without io_uring.</description></item>
+/// <item><description>If both streams passed to CipherStream are AsyncFileStream instances on different files, the cipher pipelines the transform through the request queues.</description></item>
+/// </list>
+/// </remarks>
+class AsyncFileStream final : public IByteStream
+{
+public:
+
+	//~~~Enums~~~//
+
+	/// <summary>
+	/// File access type flags
+	/// </summary>
+	enum class FileAccess : int
+	{
+		Read = 1,
+		ReadWrite = 3,
+		Write = 2
+	};
+
+private:
+
+	struct UringState;
+
+	struct AsyncRequest
+	{
+		byte* Buffer;
+		size_t Length;
+		ulong Position;
+		bool IsWrite;
+	};
+
+	struct StreamChunk
+	{
+		std::vector<byte> Storage;
+		byte* Data;
+		ulong Position;
+		size_t Length;
+		size_t DirtyLow;
+		size_t DirtyHigh;
+		size_t Ticket;
+		bool IsActive;
+	};
+
+	static const std::string CLASS_NAME;
+	static const size_t DEF_ALIGNMENT = 4096;
+	static const size_t DEF_CHUNKSIZE = 128 * 1024;
+	static const size_t DEF_QUEUEDEPTH = 16;
+	static const size_t MAX_CHUNKCOUNT = 16;
+	static const size_t MAX_QUEUEDEPTH = 4096;
+
+	std::map<size_t, AsyncRequest> m_activeRequests;
+	size_t m_chunkIndex;
+	std::map<size_t, long long> m_completedRequests;
+	FileAccess m_fileAccess;
+#if defined(CEX_OS_WINDOWS)
+	void* m_fileHandle;
+#else
+	int m_fileHandle;
+#endif
+	std::string m_fileName;
+	ulong m_filePosition;
+	ulong m_fileSize;
+	bool m_isDestroyed;
+	bool m_isDirect;
+	size_t m_nextTicket;
+	size_t m_queueDepth;
+	std::map<size_t, AsyncRequest> m_queuedRequests;
+	ulong m_readBase;
+	std::vector<StreamChunk> m_streamChunks;
+	std::unique_ptr<UringState> m_uringState;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	AsyncFileStream(const AsyncFileStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	AsyncFileStream& operator=(const AsyncFileStream&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	AsyncFileStream() = delete;
+
+	/// <summary>
+	/// Constructor: instantiate this class with a file name and options
+	/// </summary>
+	///
+	/// <param name="FileName">The full path and name of the file</param>
+	/// <param name="Access">The level of access requested</param>
+	/// <param name="Direct">Bypass the operating system page cache; ignored with the ReadWrite access mode</param>
+	/// <param name="QueueDepth">The maximum number of requests in flight, between 1 and 4096; the default is 16</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the queue depth is invalid, or the file could not be opened</exception>
+	explicit AsyncFileStream(const std::string &FileName, FileAccess Access = FileAccess::Read, bool Direct = false, size_t QueueDepth = DEF_QUEUEDEPTH);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~AsyncFileStream() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The file read and write file access flags
+	/// </summary>
+	const FileAccess Access();
+
+	/// <summary>
+	/// Read Only: The buffer and position alignment required by Direct i/o requests
+	/// </summary>
+	const size_t Alignment();
+
+	/// <summary>
+	/// Read Only: The stream can be read
+	/// </summary>
+	const bool CanRead() override;
+
+	/// <summary>
+	/// Read Only: The stream is seekable
+	/// </summary>
+	const bool CanSeek() override;
+
+	/// <summary>
+	/// Read Only: The stream can be written to
+	/// </summary>
+	const bool CanWrite() override;
+
+	/// <summary>
+	/// Read Only: The size of the stream buffers, and of each request issued by the stream functions
+	/// </summary>
+	const size_t ChunkSize();
+
+	/// <summary>
+	/// Read Only: The stream container type
+	/// </summary>
+	const StreamModes Enumeral() override;
+
+	/// <summary>
+	/// Read Only: The file name and path
+	/// </summary>
+	std::string FileName();
+
+	/// <summary>
+	/// Read Only: The file was opened for Direct i/o
+	/// </summary>
+	const bool IsDirect();
+
+	/// <summary>
+	/// Read Only: Requests are submitted through io_uring
+	/// </summary>
+	const bool IsUring();
+
+	/// <summary>
+	/// Read Only: The stream length
+	/// </summary>
+	const ulong Length() override;
+
+	/// <summary>
+	/// Read Only: The streams class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: The streams current position
+	/// </summary>
+	const ulong Position() override;
+
+	/// <summary>
+	/// Read Only: The maximum number of requests in flight
+	/// </summary>
+	const size_t QueueDepth();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Size a byte vector to hold an aligned buffer, and get a pointer to the aligned buffer
+	/// </summary>
+	///
+	/// <param name="Storage">The vector holding the buffer; it is resized, and must not be resized while the buffer is in use</param>
+	/// <param name="Length">The length of the buffer, rounded up to Alignment()</param>
+	///
+	/// <returns>A pointer to the aligned buffer</returns>
+	static byte* AlignBuffer(std::vector<byte> &Storage, size_t Length);
+
+	/// <summary>
+	/// Complete the pending requests, write the buffered data, and close the stream
+	/// </summary>
+	void Close() override;
+
+	/// <summary>
+	/// Copy this stream to another stream
+	/// </summary>
+	///
+	/// <param name="Destination">The destination stream</param>
+	void CopyTo(IByteStream* Destination) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Write the buffered data, and wait until every request has completed
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// Queue an asynchronous read.
+	/// <para>If the queue is full, the queued requests are submitted, and the call waits for a request to complete.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The buffer receiving the bytes; it must remain valid until the request has been waited on</param>
+	/// <param name="Length">The number of bytes to read</param>
+	/// <param name="Position">The file position to read from</param>
+	///
+	/// <returns>The request number</returns>
+	size_t QueueRead(byte* Output, size_t Length, ulong Position);
+
+	/// <summary>
+	/// Queue an asynchronous write; the stream length is extended to cover the write.
+	/// <para>If the queue is full, the queued requests are submitted, and the call waits for a request to complete.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The buffer containing the bytes; it must remain valid and unchanged until the request has been waited on</param>
+	/// <param name="Length">The number of bytes to write</param>
+	/// <param name="Position">The file position to write to</param>
+	///
+	/// <returns>The request number</returns>
+	size_t QueueWrite(const byte* Input, size_t Length, ulong Position);
+
+	/// <summary>
+	/// Copies a portion of the stream into an output buffer
+	/// </summary>
+	///
+	/// <param name="Output">The output array receiving the bytes</param>
+	/// <param name="Offset">Offset within the output array at which to begin</param>
+	/// <param name="Length">The number of bytes to read</param>
+	///
+	/// <returns>The number of bytes read</returns>
+	size_t Read(std::vector<byte> &Output, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Read a single byte from the stream
+	/// </summary>
+	///
+	/// <returns>The read byte value</returns>
+	byte ReadByte() override;
+
+	/// <summary>
+	/// Reset the position to the beginning of the stream
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Seek to a position within the stream
+	/// </summary>
+	///
+	/// <param name="Offset">The offset position</param>
+	/// <param name="Origin">The starting point</param>
+	void Seek(ulong Offset, SeekOrigin Origin) override;
+
+	/// <summary>
+	/// Set the length of the stream
+	/// </summary>
+	///
+	/// <param name="Length">The desired length</param>
+	void SetLength(ulong Length) override;
+
+	/// <summary>
+	/// Submit the queued requests in a single batch
+	/// </summary>
+	void Submit();
+
+	/// <summary>
+	/// Wait for a request to complete; a request that is still queued is submitted first
+	/// </summary>
+	///
+	/// <param name="Request">The request number returned by QueueRead or QueueWrite</param>
+	///
+	/// <returns>The number of bytes transferred; a read returns fewer bytes than requested at the end of the file</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the request failed</exception>
+	size_t Wait(size_t Request);
+
+	/// <summary>
+	/// Writes an input buffer to the stream
+	/// </summary>
+	///
+	/// <param name="Input">The input array to write to the stream</param>
+	/// <param name="Offset">Offset within the input array at which to begin</param>
+	/// <param name="Length">The number of bytes to write</param>
+	void Write(const std::vector<byte> &Input, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Write a single byte from the stream
+	/// </summary>
+	///
+	/// <param name="Value">The byte value to write</param>
+	void WriteByte(byte Value) override;
+
+private:
+
+	void Activate(ulong Position);
+	long long Execute(const AsyncRequest &Request);
+	size_t Queue(byte* Buffer, size_t Length, ulong Position, bool IsWrite);
+	void Reap(size_t Count);
+	void Release(StreamChunk &Chunk);
+	void Restart(ulong Position);
+	void Truncate(ulong Length);
+	bool UringCreate();
+	void UringDestroy();
+	void WaitAll();
+};
+
+NAMESPACE_IOEND
+#endif
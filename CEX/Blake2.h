@@ -90,8 +90,8 @@ public:
 
 #if defined(__AVX__)
 
-	template <typename State>
-	inline static void Compress512(const std::vector<byte> &Input, size_t InOffset, State &Output, const std::vector<uint> &IV)
+	template <typename Array, typename State>
+	inline static void Compress512(const Array &Input, size_t InOffset, State &Output, const std::vector<uint> &IV)
 	{
 		__m128i R1, R2, R3, R4;
 		__m128i B1, B2, B3, B4;
@@ -644,8 +644,8 @@ public:
 		_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output.H[4]), _mm_xor_si128(FF1, _mm_xor_si128(R2, R4)));
 	}
 
-	template <typename State>
-	inline static void Compress1024(const std::vector<byte> &Input, size_t InOffset, State &Output, const std::vector<ulong> &IV)
+	template <typename Array, typename State>
+	inline static void Compress1024(const Array &Input, size_t InOffset, State &Output, const std::vector<ulong> &IV)
 	{
 		const __m128i M0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Input[InOffset]));
 		const __m128i M1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Input[InOffset + 16]));
@@ -1468,8 +1468,8 @@ public:
 
 #else
 
-	template <typename State>
-	inline static void Compress512(const std::vector<byte> &Input, size_t InOffset, State &Output, const std::vector<uint> &IV)
+	template <typename Array, typename State>
+	inline static void Compress512(const Array &Input, size_t InOffset, State &Output, const std::vector<uint> &IV)
 	{
 		std::array<uint, 16> M;
 		Utility::IntUtils::LeBytesToUL512(Input, InOffset, M, 0);
@@ -2551,8 +2551,8 @@ public:
 		Output.H[7] ^= R7 ^ R15;
 	}
 
-	template <typename State>
-	inline static void Compress1024(const std::vector<byte> &Input, size_t InOffset, State &Output, const std::vector<ulong> &IV)
+	template <typename Array, typename State>
+	inline static void Compress1024(const Array &Input, size_t InOffset, State &Output, const std::vector<ulong> &IV)
 	{
 		std::array<ulong, 16> M;
 		Utility::IntUtils::LeBytesToULL1024(Input, InOffset, M, 0);
@@ -1,4 +1,5 @@
 #include "Blake256.h"
+#include "ArraySpan.h"
 #include "Blake2.h"
 #include "CpuDetect.h"
 #include "ParallelUtils.h"
@@ -411,6 +412,39 @@ void Blake256::Update(byte Input)
 }
 
 void Blake256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	Process(Input, InOffset, Length);
+}
+
+void Blake256::Update(const byte* Input, size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+template <typename Array>
+void Blake256::Compress(const Array &Input, size_t InOffset, Blake2sState &State, size_t Length)
+{
+	IntUtils::LeIncreaseW(State.T, State.T, Length);
+	Blake2::Compress512(Input, InOffset, State, m_cIV);
+}
+
+void Blake256::LoadState(Blake2sState &State)
+{
+	Utility::MemUtils::Clear(State.T, 0, COUNTER_SIZE * sizeof(uint));
+	Utility::MemUtils::Clear(State.F, 0, FLAG_SIZE * sizeof(uint));
+	Utility::MemUtils::Clear(State.F, 0, FLAG_SIZE * sizeof(uint));
+	Utility::MemUtils::Copy(m_cIV, 0, State.H, 0, CHAIN_SIZE * sizeof(uint));
+
+	m_treeParams.GetConfig<uint>(m_treeConfig);
+	Utility::MemUtils::XOR256(m_treeConfig, 0, State.H, 0);
+}
+
+template <typename Array>
+void Blake256::Process(const Array &Input, size_t InOffset, size_t Length)
 {
 	if (Length != 0)
 	{
@@ -523,26 +557,8 @@ void Blake256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 	}
 }
 
-//~~~Private Functions~~~//
-
-void Blake256::Compress(const std::vector<byte> &Input, size_t InOffset, Blake2sState &State, size_t Length)
-{
-	IntUtils::LeIncreaseW(State.T, State.T, Length);
-	Blake2::Compress512(Input, InOffset, State, m_cIV);
-}
-
-void Blake256::LoadState(Blake2sState &State)
-{
-	Utility::MemUtils::Clear(State.T, 0, COUNTER_SIZE * sizeof(uint));
-	Utility::MemUtils::Clear(State.F, 0, FLAG_SIZE * sizeof(uint));
-	Utility::MemUtils::Clear(State.F, 0, FLAG_SIZE * sizeof(uint));
-	Utility::MemUtils::Copy(m_cIV, 0, State.H, 0, CHAIN_SIZE * sizeof(uint));
-
-	m_treeParams.GetConfig<uint>(m_treeConfig);
-	Utility::MemUtils::XOR256(m_treeConfig, 0, State.H, 0);
-}
-
-void Blake256::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blake2sState &State, ulong Length)
+template <typename Array>
+void Blake256::ProcessLeaf(const Array &Input, size_t InOffset, Blake2sState &State, ulong Length)
 {
 	do
 	{
@@ -308,11 +308,23 @@ public:
 	/// <param name="Length">The amount of data to process in bytes</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the digest with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
-	void Compress(const std::vector<byte> &Input, size_t InOffset, Blake2sState &State, size_t Length);
+	template <typename Array>
+	void Compress(const Array &Input, size_t InOffset, Blake2sState &State, size_t Length);
 	void LoadState(Blake2sState &State);
-	void ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blake2sState &State, ulong Length);
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
+	template <typename Array>
+	void ProcessLeaf(const Array &Input, size_t InOffset, Blake2sState &State, ulong Length);
 };
 
 NAMESPACE_DIGESTEND
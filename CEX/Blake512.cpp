@@ -1,4 +1,5 @@
 #include "Blake512.h"
+#include "ArraySpan.h"
 #include "Blake2.h"
 #include "CpuDetect.h"
 #include "ParallelUtils.h"
@@ -408,6 +409,37 @@ void Blake512::Update(byte Input)
 }
 
 void Blake512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	Process(Input, InOffset, Length);
+}
+
+void Blake512::Update(const byte* Input, size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+template <typename Array>
+void Blake512::Compress(const Array &Input, size_t InOffset, Blake2bState &State, size_t Length)
+{
+	IntUtils::LeIncreaseW(State.T, State.T, Length);
+	Blake2::Compress1024(Input, InOffset, State, m_cIV);
+}
+
+void Blake512::LoadState(Blake2bState &State)
+{
+	Utility::MemUtils::Clear(State.T, 0, COUNTER_SIZE * sizeof(ulong));
+	Utility::MemUtils::Clear(State.F, 0, FLAG_SIZE * sizeof(ulong));
+	Utility::MemUtils::Copy(m_cIV, 0, State.H, 0, CHAIN_SIZE * sizeof(ulong));
+	m_treeParams.GetConfig<ulong>(m_treeConfig);
+	Utility::MemUtils::XOR512(m_treeConfig, 0, State.H, 0);
+}
+
+template <typename Array>
+void Blake512::Process(const Array &Input, size_t InOffset, size_t Length)
 {
 	if (Length != 0)
 	{
@@ -520,24 +552,8 @@ void Blake512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 	}
 }
 
-//~~~Private Functions~~~//
-
-void Blake512::Compress(const std::vector<byte> &Input, size_t InOffset, Blake2bState &State, size_t Length)
-{
-	IntUtils::LeIncreaseW(State.T, State.T, Length);
-	Blake2::Compress1024(Input, InOffset, State, m_cIV);
-}
-
-void Blake512::LoadState(Blake2bState &State)
-{
-	Utility::MemUtils::Clear(State.T, 0, COUNTER_SIZE * sizeof(ulong));
-	Utility::MemUtils::Clear(State.F, 0, FLAG_SIZE * sizeof(ulong));
-	Utility::MemUtils::Copy(m_cIV, 0, State.H, 0, CHAIN_SIZE * sizeof(ulong));
-	m_treeParams.GetConfig<ulong>(m_treeConfig);
-	Utility::MemUtils::XOR512(m_treeConfig, 0, State.H, 0);
-}
-
-void Blake512::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blake2bState &State, ulong Length)
+template <typename Array>
+void Blake512::ProcessLeaf(const Array &Input, size_t InOffset, Blake2bState &State, ulong Length)
 {
 	do
 	{
@@ -0,0 +1,237 @@
+#ifndef CEX_BLOCKSCHEDULER_H
+#define CEX_BLOCKSCHEDULER_H
+
+#include "CexDomain.h"
+#include "IBlockCipher.h"
+#include "MemUtils.h"
+#include "ParallelOptions.h"
+#include "ParallelUtils.h"
+#include <array>
+#include <vector>
+
+NAMESPACE_MODE
+
+using Block::IBlockCipher;
+using Common::ParallelOptions;
+
+/// <summary>
+/// The wide kernel block scheduler shared by the block cipher modes.
+/// <para>Splits an input into per-thread segments, and drives each segment through the widest transform of the block cipher in runs of 16 blocks.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Generating a counter mode key stream in a segment:</description>
+/// <code>
+/// BlockScheduler::Schedule(m_parallelProfile, BLKCNT, [this, &amp;Input, &amp;Output](size_t Index, size_t BlockOffset, size_t BlockCount)
+/// {
+///     std::vector&lt;byte&gt; thdCtr(BLOCK_SIZE);
+///     Utility::IntUtils::BeIncrease8(m_ctrVector, thdCtr, BlockOffset);
+///
+///     BlockScheduler::Process(m_blockCipher.get(), Input.data() + (BlockOffset * BLOCK_SIZE), BlockCount,
+///         [&amp;thdCtr](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &amp;State) { /* stagger the counters */ },
+///         [&amp;](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &amp;State) { /* xor the key stream with the input */ });
+/// });
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>Schedule divides the blocks into rounds of ParallelBlockSize(), and each round into ParallelMaxDegree() segments run on the thread pool; the remainder, or the whole input when parallel processing is disabled, is processed as one segment on the calling thread.</description></item>
+/// <item><description>A mode derives the state of a segment (a counter, or the preceding cipher-text block) from the segment offset, and updates its own state after the call returns; Segments returns the same layout, so boundary blocks can be stored before an in place transform.</description></item>
+/// <item><description>Process fills a run state with the Load delegate, transforms the state in place, and passes it to the Store delegate; the state is separate from the input and output, so a mode can transform in place.</description></item>
+/// <item><description>Full runs use Transform2048, and the tail of a segment steps down through Transform1024, Transform512 and Transform; the ciphers select their own SIMD implementation of each width.</description></item>
+/// <item><description>The input of the next run is prefetched before the current run is transformed.</description></item>
+/// </list>
+/// </remarks>
+class BlockScheduler
+{
+public:
+
+	/// <summary>
+	/// The block cipher block size in bytes
+	/// </summary>
+	static const size_t BLOCK_SIZE = 16;
+
+	/// <summary>
+	/// The number of blocks in a run
+	/// </summary>
+	static const size_t RUN_BLOCKS = 16;
+
+	/// <summary>
+	/// The size of a run in bytes
+	/// </summary>
+	static const size_t RUN_SIZE = RUN_BLOCKS * BLOCK_SIZE;
+
+	/// <summary>
+	/// The state of a run, transformed in place
+	/// </summary>
+	typedef std::array<byte, RUN_SIZE> RunState;
+
+	/// <summary>
+	/// Transform a segment in runs of up to 16 blocks.
+	/// <para>Load and Store are called with the block offset of the run within the segment, the number of blocks in the run, and the run state.</para>
+	/// </summary>
+	///
+	/// <param name="Cipher">The block cipher instance</param>
+	/// <param name="Input">The input of the segment, prefetched ahead of each run; can be null</param>
+	/// <param name="BlockCount">The number of blocks in the segment</param>
+	/// <param name="Load">The delegate filling the run state with the blocks to transform</param>
+	/// <param name="Store">The delegate consuming the transformed run state</param>
+	template <typename LoadFn, typename StoreFn>
+	static void Process(IBlockCipher* Cipher, const byte* Input, size_t BlockCount, LoadFn &&Load, StoreFn &&Store)
+	{
+		RunState runState;
+		size_t blkOff = 0;
+
+		while (blkOff != BlockCount)
+		{
+			const size_t RUNBLK = (BlockCount - blkOff < RUN_BLOCKS) ? BlockCount - blkOff : RUN_BLOCKS;
+
+			if (Input != nullptr)
+			{
+				Prefetch(Input + ((blkOff + RUNBLK) * BLOCK_SIZE), (BlockCount - (blkOff + RUNBLK)) * BLOCK_SIZE);
+			}
+
+			Load(blkOff, RUNBLK, runState);
+			Transform(Cipher, runState.data(), runState.data(), RUNBLK);
+			Store(blkOff, RUNBLK, runState);
+			blkOff += RUNBLK;
+		}
+
+		Utility::MemUtils::Clear(runState, 0, RUN_SIZE);
+	}
+
+	/// <summary>
+	/// Split a number of blocks into segments, processed in parallel rounds when the parallel profile allows it.
+	/// <para>The Segment delegate is called with the segment index, block offset and block count of each segment, and may be called concurrently.</para>
+	/// </summary>
+	///
+	/// <param name="Profile">The parallel options of the cipher mode</param>
+	/// <param name="BlockCount">The number of blocks to process</param>
+	/// <param name="Segment">The delegate processing a segment</param>
+	template <typename SegmentFn>
+	static void Schedule(ParallelOptions &Profile, size_t BlockCount, SegmentFn &&Segment)
+	{
+		std::vector<size_t> segOffsets;
+		const size_t RNDCNT = Segments(Profile, BlockCount, segOffsets);
+		const size_t PRLDGR = Profile.ParallelMaxDegree();
+		size_t segIdx = 0;
+
+		for (size_t i = 0; i < RNDCNT; ++i)
+		{
+			Utility::ParallelUtils::ParallelFor(0, PRLDGR, [&Segment, &segOffsets, segIdx](size_t j)
+			{
+				Segment(segIdx + j, segOffsets[segIdx + j], segOffsets[segIdx + j + 1] - segOffsets[segIdx + j]);
+			});
+
+			segIdx += PRLDGR;
+		}
+
+		if (segIdx + 1 < segOffsets.size())
+		{
+			Segment(segIdx, segOffsets[segIdx], segOffsets[segIdx + 1] - segOffsets[segIdx]);
+		}
+	}
+
+	/// <summary>
+	/// Get the block offsets of the segments created by Schedule.
+	/// <para>A mode that chains blocks across segment boundaries uses the offsets to store the boundary blocks before an in place transform.</para>
+	/// </summary>
+	///
+	/// <param name="Profile">The parallel options of the cipher mode</param>
+	/// <param name="BlockCount">The number of blocks to process</param>
+	/// <param name="Offsets">Receives the offset of each segment, followed by the block count</param>
+	///
+	/// <returns>The number of parallel rounds</returns>
+	static size_t Segments(ParallelOptions &Profile, size_t BlockCount, std::vector<size_t> &Offsets)
+	{
+		size_t blkOff = 0;
+		size_t rndCnt = 0;
+
+		Offsets.clear();
+
+		if (Profile.IsParallel() && BlockCount * BLOCK_SIZE >= Profile.ParallelBlockSize())
+		{
+			const size_t PRLBLK = Profile.ParallelBlockSize() / BLOCK_SIZE;
+			const size_t PRLDGR = Profile.ParallelMaxDegree();
+			const size_t SEGBLK = PRLBLK / PRLDGR;
+
+			rndCnt = BlockCount / PRLBLK;
+
+			for (size_t i = 0; i < rndCnt; ++i)
+			{
+				for (size_t j = 0; j < PRLDGR; ++j)
+				{
+					Offsets.push_back(blkOff + (j * SEGBLK));
+				}
+
+				blkOff += PRLBLK;
+			}
+		}
+
+		if (blkOff != BlockCount)
+		{
+			Offsets.push_back(blkOff);
+		}
+
+		Offsets.push_back(BlockCount);
+
+		return rndCnt;
+	}
+
+	/// <summary>
+	/// Transform a number of blocks with the widest transforms of the block cipher; Input and Output may be the same address
+	/// </summary>
+	///
+	/// <param name="Cipher">The block cipher instance</param>
+	/// <param name="Input">The input blocks</param>
+	/// <param name="Output">The output blocks</param>
+	/// <param name="BlockCount">The number of blocks to transform</param>
+	static void Transform(IBlockCipher* Cipher, const byte* Input, byte* Output, size_t BlockCount)
+	{
+		size_t blkOff = 0;
+
+		while (BlockCount - blkOff >= 16)
+		{
+			Prefetch(Input + ((blkOff + 16) * BLOCK_SIZE), (BlockCount - (blkOff + 16)) * BLOCK_SIZE);
+			Cipher->Transform2048(Input + (blkOff * BLOCK_SIZE), Output + (blkOff * BLOCK_SIZE));
+			blkOff += 16;
+		}
+
+		if (BlockCount - blkOff >= 8)
+		{
+			Cipher->Transform1024(Input + (blkOff * BLOCK_SIZE), Output + (blkOff * BLOCK_SIZE));
+			blkOff += 8;
+		}
+
+		if (BlockCount - blkOff >= 4)
+		{
+			Cipher->Transform512(Input + (blkOff * BLOCK_SIZE), Output + (blkOff * BLOCK_SIZE));
+			blkOff += 4;
+		}
+
+		while (blkOff != BlockCount)
+		{
+			Cipher->Transform(Input + (blkOff * BLOCK_SIZE), Output + (blkOff * BLOCK_SIZE));
+			++blkOff;
+		}
+	}
+
+private:
+
+	static void Prefetch(const byte* Input, size_t Length)
+	{
+#if defined(__AVX__)
+		const size_t PFTLEN = (Length < RUN_SIZE) ? Length : RUN_SIZE;
+
+		for (size_t i = 0; i < PFTLEN; i += CEX_CACHE_SEGMENT)
+		{
+			PREFETCHT0(Input, i);
+		}
+#endif
+	}
+};
+
+NAMESPACE_MODEEND
+#endif
@@ -1,7 +1,9 @@
 #include "CBC.h"
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
+#include "BlockScheduler.h"
 #include "IntUtils.h"
-#include "ParallelUtils.h"
+#include <array>
 
 NAMESPACE_MODE
 
@@ -145,6 +147,118 @@ void CBC::DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 	Decrypt128(Input, InOffset, Output, OutOffset);
 }
 
+void CBC::EncryptBatch(std::vector<BatchPacket> &Packets)
+{
+	if (!m_isInitialized || !m_isEncryption)
+	{
+		throw CryptoCipherModeException("CBC:EncryptBatch", "The cipher mode has not been initialized for encryption!");
+	}
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		if (Packets[i].Length % BLOCK_SIZE != 0)
+		{
+			throw CryptoCipherModeException("CBC:EncryptBatch", "The packet length must be evenly divisible by the block size!");
+		}
+	}
+
+	// each slot of the state holds the chaining block of one message
+	std::array<byte, BATCH_LANES * BLOCK_SIZE> blkState;
+	size_t lnsIndex[BATCH_LANES];
+	size_t lnsPosition[BATCH_LANES];
+	size_t actCnt = 0;
+	size_t nxtPkt = 0;
+
+	auto loadLane = [&Packets, &blkState, &lnsIndex, &lnsPosition, &nxtPkt](size_t Slot)
+	{
+		while (Packets[nxtPkt].Length == 0)
+		{
+			++nxtPkt;
+		}
+
+		std::memcpy(blkState.data() + (Slot * BLOCK_SIZE), Packets[nxtPkt].Nonce, BLOCK_SIZE);
+		lnsIndex[Slot] = nxtPkt;
+		lnsPosition[Slot] = 0;
+		++nxtPkt;
+	};
+
+	size_t pktCnt = 0;
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		pktCnt += (Packets[i].Length != 0) ? 1 : 0;
+	}
+
+	while (actCnt != BATCH_LANES && actCnt != pktCnt)
+	{
+		loadLane(actCnt);
+		++actCnt;
+	}
+
+	pktCnt -= actCnt;
+
+	while (actCnt != 0)
+	{
+		for (size_t i = 0; i < actCnt; ++i)
+		{
+			const Utility::ArraySpan<const byte> inp(Packets[lnsIndex[i]].Input + lnsPosition[i], BLOCK_SIZE);
+			Utility::MemUtils::XOR128(inp, 0, blkState, i * BLOCK_SIZE);
+		}
+
+		// the narrowest transform that covers the active chains
+		if (actCnt > 8)
+		{
+			m_blockCipher->Transform2048(blkState.data(), blkState.data());
+		}
+		else if (actCnt > 4)
+		{
+			m_blockCipher->Transform1024(blkState.data(), blkState.data());
+		}
+		else if (actCnt > 1)
+		{
+			m_blockCipher->Transform512(blkState.data(), blkState.data());
+		}
+		else
+		{
+			m_blockCipher->Transform(blkState.data(), blkState.data());
+		}
+
+		for (size_t i = 0; i < actCnt; ++i)
+		{
+			std::memcpy(Packets[lnsIndex[i]].Output + lnsPosition[i], blkState.data() + (i * BLOCK_SIZE), BLOCK_SIZE);
+			lnsPosition[i] += BLOCK_SIZE;
+		}
+
+		// a completed message is replaced by the next, or by the last slot when the set is exhausted
+		size_t slot = 0;
+
+		while (slot != actCnt)
+		{
+			if (lnsPosition[slot] != Packets[lnsIndex[slot]].Length)
+			{
+				++slot;
+				continue;
+			}
+
+			if (pktCnt != 0)
+			{
+				loadLane(slot);
+				--pktCnt;
+				++slot;
+			}
+			else
+			{
+				--actCnt;
+				std::memcpy(blkState.data() + (slot * BLOCK_SIZE), blkState.data() + (actCnt * BLOCK_SIZE), BLOCK_SIZE);
+				lnsIndex[slot] = lnsIndex[actCnt];
+				lnsPosition[slot] = lnsPosition[actCnt];
+			}
+		}
+	}
+
+	Utility::MemUtils::Clear(blkState, 0, blkState.size());
+}
+
 void CBC::EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
 {
 	Encrypt128(Input, 0, Output, 0);
@@ -195,180 +309,66 @@ void CBC::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	Process(Input, InOffset, Output, OutOffset, Length);
 }
 
+void CBC::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
+
+	Process(inp, 0, otp, 0, Length);
+}
+
 //~~~Private Functions~~~//
 
-void CBC::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void CBC::Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
 
 	std::vector<byte> nxtIv(BLOCK_SIZE);
 	Utility::MemUtils::COPY128(Input, InOffset, nxtIv, 0);
-	m_blockCipher->DecryptBlock(Input, InOffset, Output, OutOffset);
+	m_blockCipher->Transform(Input.data() + InOffset, Output.data() + OutOffset);
 	Utility::MemUtils::XOR128(m_cbcVector, 0, Output, OutOffset);
 	Utility::MemUtils::COPY128(nxtIv, 0, m_cbcVector, 0);
 }
 
-void CBC::DecryptParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void CBC::DecryptSegment(const ArrayA &Input, size_t InOffset, ArrayB &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount)
 {
-	const size_t SEGLEN = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
-	const size_t BLKCNT = (SEGLEN / BLOCK_SIZE);
-	std::vector<byte> tmpIv(BLOCK_SIZE);
+	// the chain holds the iv followed by the cipher-text of the run, so the xor survives an in place transform
+	std::array<byte, BlockScheduler::RUN_SIZE + BLOCK_SIZE> blkChain;
+	Utility::MemUtils::COPY128(Iv, 0, blkChain, 0);
 
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpIv, SEGLEN, BLKCNT](size_t i)
+	BlockScheduler::Process(m_blockCipher.get(), Input.data() + InOffset, BlockCount,
+		[&Input, InOffset, &blkChain](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &State)
 	{
-		std::vector<byte> thdIv(BLOCK_SIZE);
-
-		if (i != 0)
-		{
-			Utility::MemUtils::COPY128(Input, (InOffset + (i * SEGLEN)) - BLOCK_SIZE, thdIv, 0);
-		}
-		else
-		{
-			Utility::MemUtils::COPY128(m_cbcVector, 0, thdIv, 0);
-		}
-
-		this->DecryptSegment(Input, InOffset + i * SEGLEN, Output, OutOffset + i * SEGLEN, thdIv, BLKCNT);
-
-		if (i == m_parallelProfile.ParallelMaxDegree() - 1)
-		{
-			Utility::MemUtils::COPY128(thdIv, 0, tmpIv, 0);
-		}
-	});
-
-	Utility::MemUtils::COPY128(tmpIv, 0, m_cbcVector, 0);
-}
-
-void CBC::DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount)
-{
-	size_t blkCtr = BlockCount;
-
-#if defined(__AVX512__)
-	if (blkCtr > 15)
+		Utility::MemUtils::Copy(Input, InOffset + (RunOffset * BLOCK_SIZE), State, 0, RunCount * BLOCK_SIZE);
+		Utility::MemUtils::Copy(State, 0, blkChain, BLOCK_SIZE, RunCount * BLOCK_SIZE);
+	},
+		[&Output, OutOffset, &blkChain](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &State)
 	{
-		// 512bit avx
-		const size_t AVX512BLK = 256;
-		size_t rndCtr = (blkCtr / 16);
-		std::vector<byte> blkIv(AVX512BLK);
-		std::vector<byte> blkNxt(AVX512BLK);
-		const size_t BLKOFT = AVX512BLK - Iv.size();
-
-		// build wide iv
-		Utility::MemUtils::COPY128(Iv, 0, blkIv, 0);
-		Utility::MemUtils::Copy(Input, InOffset, blkIv, BLOCK_SIZE, BLKOFT);
-
-		while (rndCtr != 0)
-		{
-			const size_t INPOFT = InOffset + BLKOFT;
-			// store next iv
-			Utility::MemUtils::Copy(Input, INPOFT, blkNxt, 0, (Input.size() - INPOFT >= AVX512BLK) ? AVX512BLK : Input.size() - INPOFT);
-			// transform 8 blocks
-			m_blockCipher->Transform2048(Input, InOffset, Output, OutOffset);
-			// xor the set
-			Utility::MemUtils::XOR1024(blkIv, 0, Output, OutOffset);
-			Utility::MemUtils::XOR1024(blkIv + 128, 0, Output, OutOffset + 128);
-			// swap iv
-			Utility::MemUtils::Copy(blkNxt, 0, blkIv, 0, AVX512BLK);
-			InOffset += AVX512BLK;
-			OutOffset += AVX512BLK;
-			blkCtr -= 16;
-			--rndCtr;
-		}
-
-		Utility::MemUtils::COPY128(blkNxt, 0, Iv, 0);
-	}
-#elif defined(__AVX2__)
-	if (blkCtr > 7)
-	{
-		// 256bit avx
-		const size_t AVX2BLK = 128;
-		size_t rndCtr = (blkCtr / 8);
-		std::vector<byte> blkIv(AVX2BLK);
-		std::vector<byte> blkNxt(AVX2BLK);
-		const size_t BLKOFT = AVX2BLK - Iv.size();
-
-		// build wide iv
-		Utility::MemUtils::COPY128(Iv, 0, blkIv, 0);
-		Utility::MemUtils::Copy(Input, InOffset, blkIv, BLOCK_SIZE, BLKOFT);
-
-		while (rndCtr != 0)
-		{
-			const size_t INPOFT = InOffset + BLKOFT;
-			// store next iv
-			Utility::MemUtils::Copy(Input, INPOFT, blkNxt, 0, (Input.size() - INPOFT >= AVX2BLK) ? AVX2BLK: Input.size() - INPOFT);
-			// transform 8 blocks
-			m_blockCipher->Transform1024(Input, InOffset, Output, OutOffset);
-			// xor the set
-			Utility::MemUtils::XOR1024(blkIv, 0, Output, OutOffset);
-			// swap iv
-			Utility::MemUtils::Copy(blkNxt, 0, blkIv, 0, AVX2BLK);
-			InOffset += AVX2BLK;
-			OutOffset += AVX2BLK;
-			blkCtr -= 8;
-			--rndCtr;
-		}
-
-		Utility::MemUtils::COPY128(blkNxt, 0, Iv, 0);
-	}
-#elif defined(__AVX__)
-	if (blkCtr > 3)
-	{
-		// 128bit sse3
-		const size_t AVXBLK = 64;
-		size_t rndCtr = (blkCtr / 4);
-		std::vector<byte> blkIv(AVXBLK);
-		std::vector<byte> blkNxt(AVXBLK);
-		const size_t BLKOFT = AVXBLK - Iv.size();
-
-		Utility::MemUtils::COPY128(Iv, 0, blkIv, 0);
-		Utility::MemUtils::Copy(Input, InOffset, blkIv, BLOCK_SIZE, BLKOFT);
-
-		while (rndCtr != 0)
-		{
-			const size_t INPOFT = InOffset + BLKOFT;
-			Utility::MemUtils::Copy(Input, INPOFT, blkNxt, 0, (Input.size() - INPOFT >= AVXBLK) ? AVXBLK : Input.size() - INPOFT);
-			m_blockCipher->Transform512(Input, InOffset, Output, OutOffset);
-			Utility::MemUtils::XOR512(blkIv, 0, Output, OutOffset);
-			Utility::MemUtils::Copy(blkNxt, 0, blkIv, 0, AVXBLK);
-			InOffset += AVXBLK;
-			OutOffset += AVXBLK;
-			blkCtr -= 4;
-			--rndCtr;
-		}
-
-		Utility::MemUtils::COPY128(blkNxt, 0, Iv, 0);
-	}
-#endif
-
-	if (blkCtr != 0)
-	{
-		// Note: if it's hitting this, your parallel block size is misaligned
-		std::vector<byte> nxtIv(BLOCK_SIZE);
+		Utility::MemUtils::XorBlock(blkChain, 0, State, 0, RunCount * BLOCK_SIZE);
+		Utility::MemUtils::Copy(State, 0, Output, OutOffset + (RunOffset * BLOCK_SIZE), RunCount * BLOCK_SIZE);
+		Utility::MemUtils::COPY128(blkChain, RunCount * BLOCK_SIZE, blkChain, 0);
+	});
 
-		while (blkCtr != 0)
-		{
-			Utility::MemUtils::COPY128(Input, InOffset, nxtIv, 0);
-			m_blockCipher->DecryptBlock(Input, InOffset, Output, OutOffset);
-			Utility::MemUtils::XOR128(Iv, 0, Output, OutOffset);
-			Utility::MemUtils::COPY128(nxtIv, 0, Iv, 0);
-			InOffset += BLOCK_SIZE;
-			OutOffset += BLOCK_SIZE;
-			--blkCtr;
-		}
-	}
+	Utility::MemUtils::COPY128(blkChain, 0, Iv, 0);
+	Utility::MemUtils::Clear(blkChain, 0, blkChain.size());
 }
 
-void CBC::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void CBC::Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
 
 	Utility::MemUtils::XOR128(Input, InOffset, m_cbcVector, 0);
-	m_blockCipher->EncryptBlock(m_cbcVector, 0, Output, OutOffset);
+	m_blockCipher->Transform(m_cbcVector.data(), Output.data() + OutOffset);
 	Utility::MemUtils::COPY128(Output, OutOffset, m_cbcVector, 0);
 }
 
-void CBC::Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+template <typename ArrayA, typename ArrayB>
+void CBC::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
@@ -385,30 +385,32 @@ void CBC::Process(const std::vector<byte> &Input, const size_t InOffset, std::ve
 	}
 	else
 	{
-		if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
-		{
-			const size_t PRBCNT = Length / m_parallelProfile.ParallelBlockSize();
+		// the cipher-text block preceding each segment is stored before an in place transform overwrites it
+		std::vector<size_t> segOffsets;
+		BlockScheduler::Segments(m_parallelProfile, blkCtr, segOffsets);
+		std::vector<byte> segIv(segOffsets.size() * BLOCK_SIZE);
 
-			for (size_t i = 0; i < PRBCNT; ++i)
+		for (size_t i = 0; i < segOffsets.size(); ++i)
+		{
+			if (segOffsets[i] == 0)
 			{
-				DecryptParallel(Input, (i * m_parallelProfile.ParallelBlockSize()) + InOffset, Output, (i * m_parallelProfile.ParallelBlockSize()) + OutOffset);
+				Utility::MemUtils::COPY128(m_cbcVector, 0, segIv, i * BLOCK_SIZE);
 			}
-
-			const size_t PRCBLK = (m_parallelProfile.ParallelBlockSize() / BLOCK_SIZE) * PRBCNT;
-			blkCtr -= PRCBLK;
-
-			for (size_t i = 0; i < blkCtr; ++i)
+			else
 			{
-				Decrypt128(Input, ((i + PRCBLK) * BLOCK_SIZE) + InOffset, Output, ((i + PRCBLK) * BLOCK_SIZE) + OutOffset);
+				Utility::MemUtils::COPY128(Input, InOffset + ((segOffsets[i] - 1) * BLOCK_SIZE), segIv, i * BLOCK_SIZE);
 			}
 		}
-		else
+
+		BlockScheduler::Schedule(m_parallelProfile, blkCtr, [this, &Input, InOffset, &Output, OutOffset, &segIv](size_t Index, size_t BlockOffset, size_t BlockCount)
 		{
-			for (size_t i = 0; i < blkCtr; ++i)
-			{
-				Decrypt128(Input, (i * BLOCK_SIZE) + InOffset, Output, (i * BLOCK_SIZE) + OutOffset);
-			}
-		}
+			std::vector<byte> thdIv(BLOCK_SIZE);
+			Utility::MemUtils::COPY128(segIv, Index * BLOCK_SIZE, thdIv, 0);
+			this->DecryptSegment(Input, InOffset + (BlockOffset * BLOCK_SIZE), Output, OutOffset + (BlockOffset * BLOCK_SIZE), thdIv, BlockCount);
+		});
+
+		// the last offset is the block count, its preceding block is the next iv
+		Utility::MemUtils::COPY128(segIv, (segOffsets.size() - 1) * BLOCK_SIZE, m_cbcVector, 0);
 	}
 }
 
@@ -67,7 +67,7 @@ NAMESPACE_MODE
 /// The decryption function however, is not limited by this dependency chain and can be parallelized via the use of simultaneous processing by multiple processor cores. \n
 /// This is achieved by storing the starting vector, (the encrypted bytes), from offsets within the ciphertext stream, and then processing multiple blocks of cipher-text independently across threads. \n 
 /// The CBC parallel decryption mode also leverages SIMD instructions to 'double parallelize' those segments. A block of cipher-text assigned to a thread
-/// uses SIMD instructions to decrypt 4 or 8 blocks in parallel per cycle, depending on which framework is runtime available, 128 or 256 SIMD instructions.</para>
+/// is decrypted by the BlockScheduler in runs of 16 blocks, through the widest transform of the block cipher; sequential decryption uses the same wide transforms.</para>
 ///
 /// <description><B>Implementation Notes:</B></description>
 /// <list type="bullet">
@@ -77,6 +77,7 @@ NAMESPACE_MODE
 /// <item><description>The DecryptBlock, Decrypt512, Decrypt1024  EncryptBlock, Encrypt512, Encrypt1024 functions can be accessed through the class instance.</description></item>
 /// <item><description>The transformation methods can not be called until the Initialize(bool, ISymmetricKey) function has been called.</description></item>
 /// <item><description>In CBC mode, only the decryption function can be processed in parallel.</description></item>
+/// <item><description>EncryptBatch(std::vector&lt;BatchPacket&gt;) encrypts many independent messages with the instance key; the chains of 4, 8, or 16 messages advance together through the ciphers Transform512, Transform1024, or Transform2048 functions.</description></item>
 /// <item><description>The ParallelThreadsMax() property is used as the thread count in the parallel loop; this must be an even number no greater than the number of processer cores on the system.</description></item>
 /// <item><description>Parallel processing is enabled on decryption by setting IsParallel() to true, and passing an input block of ParallelBlockSize() to the transform.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
@@ -91,8 +92,45 @@ NAMESPACE_MODE
 /// </remarks>
 class CBC final : public ICipherMode
 {
+public:
+
+	//~~~Structs~~~//
+
+	/// <summary>
+	/// A message encrypted by the EncryptBatch function
+	/// </summary>
+	struct BatchPacket
+	{
+		/// <summary>
+		/// A pointer to the 16 byte initialization vector of the message
+		/// </summary>
+		const byte* Nonce;
+
+		/// <summary>
+		/// A pointer to the input bytes
+		/// </summary>
+		const byte* Input;
+
+		/// <summary>
+		/// A pointer to the output bytes; can be the same address as the input
+		/// </summary>
+		byte* Output;
+
+		/// <summary>
+		/// The number of bytes to encrypt; must be evenly divisible by the block size
+		/// </summary>
+		size_t Length;
+	};
+
 private:
 
+#if defined(__AVX512__)
+	static const size_t BATCH_LANES = 16;
+#elif defined(__AVX2__)
+	static const size_t BATCH_LANES = 8;
+#else
+	static const size_t BATCH_LANES = 4;
+#endif
 	static const size_t BLOCK_SIZE = 16;
 	static const std::string CLASS_NAME;
 
@@ -237,6 +275,18 @@ public:
 	/// <param name="OutOffset">Starting offset within the Output array</param>
 	void DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Encrypt a set of independent messages with the key of this instance.
+	/// <para>The chains of several messages are advanced together, one block of each message per wide transform, and a completed message is replaced by the next in the set.
+	/// The initialization vector of the instance is not used or changed.
+	/// Initialize(bool, ISymmetricKey) must be called for encryption before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Packets">The messages to encrypt</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the mode is not initialized for encryption, or a message length is not aligned to the block size</exception>
+	void EncryptBatch(std::vector<BatchPacket> &Packets);
+
 	/// <summary>
 	/// Encrypt a single block of bytes. 
 	/// <para>Encrypts one block of bytes beginning at a zero index.
@@ -294,13 +344,28 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
 private:
 
-	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void DecryptParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount);
-	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void DecryptSegment(const ArrayA &Input, size_t InOffset, ArrayB &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
 	void Scope();
 };
 
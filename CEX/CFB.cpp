@@ -1,7 +1,9 @@
 #include "CFB.h"
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
+#include "BlockScheduler.h"
 #include "IntUtils.h"
-#include "ParallelUtils.h"
+#include <array>
 
 NAMESPACE_MODE
 
@@ -198,14 +200,23 @@ void CFB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	Process(Input, InOffset, Output, OutOffset, Length);
 }
 
+void CFB::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
+
+	Process(inp, 0, otp, 0, Length);
+}
+
 //~~~Private Functions~~~//
 
-void CFB::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void CFB::Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= m_blockCipher->BlockSize(), "The data arrays are smaller than the the block-size!");
 
-	m_blockCipher->Transform(m_cfbVector, 0, Output, OutOffset);
+	m_blockCipher->Transform(m_cfbVector.data(), Output.data() + OutOffset);
 
 	// left shift the register
 	if (m_cfbVector.size() - m_blockSize > 0)
@@ -223,74 +234,44 @@ void CFB::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	}
 }
 
-void CFB::DecryptParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void CFB::DecryptSegment(const ArrayA &Input, size_t InOffset, ArrayB &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount)
 {
-	const size_t SEGLEN = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
-	const size_t BLKCNT = (SEGLEN / m_blockSize);
-	std::vector<byte> tmpIv(m_blockSize);
+	// the chain holds the register followed by the cipher-text of the run, so the xor survives an in place transform
+	std::array<byte, BlockScheduler::RUN_SIZE + BLOCK_SIZE> blkChain;
+	Utility::MemUtils::COPY128(Iv, 0, blkChain, 0);
 
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpIv, SEGLEN, BLKCNT](size_t i)
+	BlockScheduler::Process(m_blockCipher.get(), Input.data() + InOffset, BlockCount,
+		[&Input, InOffset, &blkChain](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &State)
 	{
-		std::vector<byte> thdIv(m_blockSize);
-
-		if (i != 0)
-		{
-			Utility::MemUtils::Copy(Input, (InOffset + (i * SEGLEN)) - m_blockSize, thdIv, 0, m_blockSize);
-		}
-		else
-		{
-			Utility::MemUtils::Copy(m_cfbVector, 0, thdIv, 0, m_blockSize);
-		}
-
-		this->DecryptSegment(Input, InOffset + i * SEGLEN, Output, OutOffset + i * SEGLEN, thdIv, BLKCNT);
-
-		if (i == m_parallelProfile.ParallelMaxDegree() - 1)
-		{
-			Utility::MemUtils::Copy(thdIv, 0, tmpIv, 0, m_blockSize);
-		}
+		Utility::MemUtils::Copy(Input, InOffset + (RunOffset * BLOCK_SIZE), blkChain, BLOCK_SIZE, RunCount * BLOCK_SIZE);
+		Utility::MemUtils::Copy(blkChain, 0, State, 0, RunCount * BLOCK_SIZE);
+	},
+		[&Output, OutOffset, &blkChain](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &State)
+	{
+		Utility::MemUtils::XorBlock(blkChain, BLOCK_SIZE, State, 0, RunCount * BLOCK_SIZE);
+		Utility::MemUtils::Copy(State, 0, Output, OutOffset + (RunOffset * BLOCK_SIZE), RunCount * BLOCK_SIZE);
+		Utility::MemUtils::COPY128(blkChain, RunCount * BLOCK_SIZE, blkChain, 0);
 	});
 
-	Utility::MemUtils::Copy(tmpIv, 0, m_cfbVector, 0, m_blockSize);
+	Utility::MemUtils::COPY128(blkChain, 0, Iv, 0);
+	Utility::MemUtils::Clear(blkChain, 0, blkChain.size());
 }
 
-void CFB::DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount)
-{
-	for (size_t i = 0; i < BlockCount; i++)
-	{ 
-		m_blockCipher->Transform(Iv, 0, Output, OutOffset);
-
-		// left shift the register
-		if (Iv.size() - m_blockSize > 0)
-		{
-			Utility::MemUtils::Copy(Iv, m_blockSize, Iv, 0, Iv.size() - m_blockSize);
-		}
-
-		// copy ciphertext to register
-		Utility::MemUtils::Copy(Input, InOffset, Iv, Iv.size() - m_blockSize, m_blockSize);
-
-		// xor the iv with the ciphertext producing the plaintext
-		for (size_t i = 0; i < m_blockSize; i++)
-		{
-			Output[OutOffset + i] ^= Input[InOffset + i];
-		}
-
-		InOffset += Iv.size();
-		OutOffset += Iv.size();
-	}
-}
-
-void CFB::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void CFB::Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= m_blockCipher->BlockSize(), "The data arrays are smaller than the the block-size!");
 
-	// encrypt the register
-	m_blockCipher->Transform(m_cfbVector, 0, Output, OutOffset);
+	// encrypt the register, the output may alias the input
+	byte tmp[BLOCK_SIZE];
+	m_blockCipher->Transform(m_cfbVector.data(), tmp);
 
 	// xor the ciphertext with the plaintext by block size bytes
 	for (size_t i = 0; i < m_blockSize; i++)
 	{
-		Output[OutOffset + i] ^= Input[InOffset + i];
+		Output[OutOffset + i] = tmp[i] ^ Input[InOffset + i];
 	}
 
 	// left shift the register
@@ -303,7 +284,8 @@ void CFB::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::MemUtils::Copy(Output, OutOffset, m_cfbVector, m_cfbVector.size() - m_blockSize, m_blockSize);
 }
 
-void CFB::Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+template <typename ArrayA, typename ArrayB>
+void CFB::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
@@ -318,32 +300,42 @@ void CFB::Process(const std::vector<byte> &Input, const size_t InOffset, std::ve
 			Encrypt128(Input, (i * m_blockSize) + InOffset, Output, (i * m_blockSize) + OutOffset);
 		}
 	}
-	else
+	else if (m_blockSize != BLOCK_SIZE)
 	{
-		if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
+		// a partial register is shifted a segment at a time, and can not be pipelined
+		for (size_t i = 0; i < blkCtr; ++i)
 		{
-			const size_t PRBCNT = Length / m_parallelProfile.ParallelBlockSize();
+			Decrypt128(Input, (i * m_blockSize) + InOffset, Output, (i * m_blockSize) + OutOffset);
+		}
+	}
+	else
+	{
+		// the cipher-text block preceding each segment is stored before an in place transform overwrites it
+		std::vector<size_t> segOffsets;
+		BlockScheduler::Segments(m_parallelProfile, blkCtr, segOffsets);
+		std::vector<byte> segIv(segOffsets.size() * BLOCK_SIZE);
 
-			for (size_t i = 0; i < PRBCNT; ++i)
+		for (size_t i = 0; i < segOffsets.size(); ++i)
+		{
+			if (segOffsets[i] == 0)
 			{
-				DecryptParallel(Input, (i * m_parallelProfile.ParallelBlockSize()) + InOffset, Output, (i * m_parallelProfile.ParallelBlockSize()) + OutOffset);
+				Utility::MemUtils::COPY128(m_cfbVector, 0, segIv, i * BLOCK_SIZE);
 			}
-
-			const size_t PRCBLK = (m_parallelProfile.ParallelBlockSize() / m_blockSize) * PRBCNT;
-			blkCtr -= PRCBLK;
-
-			for (size_t i = 0; i < blkCtr; ++i)
+			else
 			{
-				Decrypt128(Input, ((i + PRCBLK) * m_blockSize) + InOffset, Output, ((i + PRCBLK) * m_blockSize) + OutOffset);
+				Utility::MemUtils::COPY128(Input, InOffset + ((segOffsets[i] - 1) * BLOCK_SIZE), segIv, i * BLOCK_SIZE);
 			}
 		}
-		else
+
+		BlockScheduler::Schedule(m_parallelProfile, blkCtr, [this, &Input, InOffset, &Output, OutOffset, &segIv](size_t Index, size_t BlockOffset, size_t BlockCount)
 		{
-			for (size_t i = 0; i < blkCtr; ++i)
-			{
-				Decrypt128(Input, (i * m_blockSize) + InOffset, Output, (i * m_blockSize) + OutOffset);
-			}
-		}
+			std::vector<byte> thdIv(BLOCK_SIZE);
+			Utility::MemUtils::COPY128(segIv, Index * BLOCK_SIZE, thdIv, 0);
+			this->DecryptSegment(Input, InOffset + (BlockOffset * BLOCK_SIZE), Output, OutOffset + (BlockOffset * BLOCK_SIZE), thdIv, BlockCount);
+		});
+
+		// the last offset is the block count, its preceding block is the next register
+		Utility::MemUtils::COPY128(segIv, (segOffsets.size() - 1) * BLOCK_SIZE, m_cfbVector, 0);
 	}
 }
 
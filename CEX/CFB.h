@@ -312,13 +312,28 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
 private:
 
-	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void DecryptParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount);
-	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void DecryptSegment(const ArrayA &Input, size_t InOffset, ArrayB &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
 	void Scope();
 };
 
@@ -1,8 +1,10 @@
 #include "CMAC.h"
+#include "ArraySpan.h"
 #include "CBC.h"
 #include "IntUtils.h"
 #include "ISO7816.h"
 #include "SymmetricKey.h"
+#include <array>
 
 NAMESPACE_MAC
 
@@ -125,6 +127,26 @@ const std::string CMAC::Name()
 
 //~~~Public Functions~~~//
 
+std::vector<byte> &CMAC::ChainState()
+{
+	if (!m_isInitialized)
+	{
+		throw CryptoMacException("CMAC:ChainState", "The Mac has not been initialized!");
+	}
+	if (m_msgLength != 0 && m_msgLength != BLOCK_SIZE)
+	{
+		throw CryptoMacException("CMAC:ChainState", "A partial message block is pending!");
+	}
+
+	if (m_msgLength == BLOCK_SIZE)
+	{
+		m_cipherMode->EncryptBlock(m_msgBuffer, 0, m_msgCode, 0);
+		m_msgLength = 0;
+	}
+
+	return static_cast<Cipher::Symmetric::Block::Mode::CBC*>(m_cipherMode.get())->IV();
+}
+
 void CMAC::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
 {
 	CexAssert(m_isInitialized, "The Mac is not initialized");
@@ -138,6 +160,131 @@ void CMAC::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
 	Finalize(Output, 0);
 }
 
+void CMAC::ComputeBatch(std::vector<BatchPacket> &Packets)
+{
+	if (!m_isInitialized)
+	{
+		throw CryptoMacException("CMAC:ComputeBatch", "The Mac has not been initialized!");
+	}
+
+	IBlockCipher* eng = m_cipherMode->Engine();
+	// each slot of the state holds the chaining block of one message
+	std::array<byte, BATCH_LANES * BLOCK_SIZE> blkState;
+	std::array<byte, BLOCK_SIZE> blkFinal;
+	size_t lnsBlock[BATCH_LANES];
+	size_t lnsCount[BATCH_LANES];
+	size_t lnsIndex[BATCH_LANES];
+	size_t actCnt = 0;
+	size_t nxtPkt = 0;
+
+	auto loadLane = [&Packets, &blkState, &lnsBlock, &lnsCount, &lnsIndex, &nxtPkt](size_t Slot)
+	{
+		std::memset(blkState.data() + (Slot * BLOCK_SIZE), 0, BLOCK_SIZE);
+		lnsBlock[Slot] = 0;
+		// an empty message is a single padded block
+		lnsCount[Slot] = (Packets[nxtPkt].Length != 0) ? (Packets[nxtPkt].Length + BLOCK_SIZE - 1) / BLOCK_SIZE : 1;
+		lnsIndex[Slot] = nxtPkt;
+		++nxtPkt;
+	};
+
+	while (actCnt != BATCH_LANES && nxtPkt != Packets.size())
+	{
+		loadLane(actCnt);
+		++actCnt;
+	}
+
+	while (actCnt != 0)
+	{
+		for (size_t i = 0; i < actCnt; ++i)
+		{
+			const BatchPacket &pkt = Packets[lnsIndex[i]];
+			const size_t BLKOFT = lnsBlock[i] * BLOCK_SIZE;
+
+			if (lnsBlock[i] != lnsCount[i] - 1)
+			{
+				const Utility::ArraySpan<const byte> inp(pkt.Input + BLKOFT, BLOCK_SIZE);
+				Utility::MemUtils::XOR128(inp, 0, blkState, i * BLOCK_SIZE);
+			}
+			else
+			{
+				// the last block is masked with K1, or padded and masked with K2
+				const size_t BLKLEN = pkt.Length - BLKOFT;
+
+				if (BLKLEN == BLOCK_SIZE)
+				{
+					std::memcpy(blkFinal.data(), pkt.Input + BLKOFT, BLOCK_SIZE);
+					Utility::MemUtils::XOR128(m_K1, 0, blkFinal, 0);
+				}
+				else
+				{
+					std::memset(blkFinal.data(), 0, BLOCK_SIZE);
+
+					if (BLKLEN != 0)
+					{
+						std::memcpy(blkFinal.data(), pkt.Input + BLKOFT, BLKLEN);
+					}
+
+					blkFinal[BLKLEN] = 0x80;
+					Utility::MemUtils::XOR128(m_K2, 0, blkFinal, 0);
+				}
+
+				Utility::MemUtils::XOR128(blkFinal, 0, blkState, i * BLOCK_SIZE);
+			}
+
+			++lnsBlock[i];
+		}
+
+		// the narrowest transform that covers the active chains
+		if (actCnt > 8)
+		{
+			eng->Transform2048(blkState.data(), blkState.data());
+		}
+		else if (actCnt > 4)
+		{
+			eng->Transform1024(blkState.data(), blkState.data());
+		}
+		else if (actCnt > 1)
+		{
+			eng->Transform512(blkState.data(), blkState.data());
+		}
+		else
+		{
+			eng->Transform(blkState.data(), blkState.data());
+		}
+
+		// a completed message is replaced by the next, or by the last slot when the set is exhausted
+		size_t slot = 0;
+
+		while (slot != actCnt)
+		{
+			if (lnsBlock[slot] != lnsCount[slot])
+			{
+				++slot;
+				continue;
+			}
+
+			std::memcpy(Packets[lnsIndex[slot]].Output, blkState.data() + (slot * BLOCK_SIZE), m_macSize);
+
+			if (nxtPkt != Packets.size())
+			{
+				loadLane(slot);
+				++slot;
+			}
+			else
+			{
+				--actCnt;
+				std::memcpy(blkState.data() + (slot * BLOCK_SIZE), blkState.data() + (actCnt * BLOCK_SIZE), BLOCK_SIZE);
+				lnsBlock[slot] = lnsBlock[actCnt];
+				lnsCount[slot] = lnsCount[actCnt];
+				lnsIndex[slot] = lnsIndex[actCnt];
+			}
+		}
+	}
+
+	Utility::MemUtils::Clear(blkFinal, 0, blkFinal.size());
+	Utility::MemUtils::Clear(blkState, 0, blkState.size());
+}
+
 size_t CMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The Mac is not initialized");
@@ -234,6 +381,43 @@ void CMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 	CexAssert(m_isInitialized, "The Mac is not initialized");
 	CexAssert((InOffset + Length) <= Input.size(), "The Mac is not initialized");
 
+	Process(Input, InOffset, Length);
+}
+
+void CMAC::Update(const byte* Input, size_t Length)
+{
+	CexAssert(m_isInitialized, "The Mac is not initialized");
+
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+std::vector<byte> CMAC::GenerateSubkey(std::vector<byte> &Input)
+{
+	int fbit = (Input[0] & 0xFF) >> 7;
+	std::vector<byte> tmpKey(Input.size());
+
+	for (size_t i = 0; i < Input.size() - 1; i++)
+	{
+		tmpKey[i] = static_cast<byte>((Input[i] << 1) + ((Input[i + 1] & 0xFF) >> 7));
+	}
+
+	tmpKey[Input.size() - 1] = static_cast<byte>(Input[Input.size() - 1] << 1);
+
+	if (fbit == 1)
+	{
+		tmpKey[Input.size() - 1] ^= (Input.size() == m_cipherMode->BlockSize()) ? CT87 : CT1B;
+	}
+
+	return tmpKey;
+}
+
+template <typename Array>
+void CMAC::Process(const Array &Input, size_t InOffset, size_t Length)
+{
 	if (Length != 0)
 	{
 		if (m_msgLength == m_cipherMode->BlockSize())
@@ -253,7 +437,7 @@ void CMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 
 			while (Length > m_cipherMode->BlockSize())
 			{
-				m_cipherMode->EncryptBlock(Input, InOffset, m_msgCode, 0);
+				m_cipherMode->Transform(Input.data() + InOffset, m_msgCode.data(), m_cipherMode->BlockSize());
 				Length -= m_cipherMode->BlockSize();
 				InOffset += m_cipherMode->BlockSize();
 			}
@@ -267,28 +451,6 @@ void CMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 	}
 }
 
-//~~~Private Functions~~~//
-
-std::vector<byte> CMAC::GenerateSubkey(std::vector<byte> &Input)
-{
-	int fbit = (Input[0] & 0xFF) >> 7;
-	std::vector<byte> tmpKey(Input.size());
-
-	for (size_t i = 0; i < Input.size() - 1; i++)
-	{
-		tmpKey[i] = static_cast<byte>((Input[i] << 1) + ((Input[i + 1] & 0xFF) >> 7));
-	}
-
-	tmpKey[Input.size() - 1] = static_cast<byte>(Input[Input.size() - 1] << 1);
-
-	if (fbit == 1)
-	{
-		tmpKey[Input.size() - 1] ^= (Input.size() == m_cipherMode->BlockSize()) ? CT87 : CT1B;
-	}
-
-	return tmpKey;
-}
-
 void CMAC::Scope()
 {
 	m_legalKeySizes.resize(m_cipherMode->LegalKeySizes().size());
@@ -84,6 +84,7 @@ using Cipher::Symmetric::Block::Mode::ICipherMode;
 /// <item><description>The Initialize(Key, Salt), and Initialize(Key, Salt, Info) methods, use the Key parameter as the cipher key, and the Salt as the initialization vector.</description></item>
 /// <item><description>The Initialize(Key, Salt, Info) method assigns the Info array to an HX extended ciphers DistributionCode property; used by the secure key schedule.</description></item>
 /// <item><description>After a finalizer call (Finalize or Compute), the Mac functions state is reset and must be re-initialized with a new key.</description></item>
+/// <item><description>ComputeBatch(std::vector&lt;BatchPacket&gt;) authenticates many independent messages with the loaded key; the chains of 4, 8, or 16 messages advance together through the ciphers wide transforms.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -95,8 +96,40 @@ using Cipher::Symmetric::Block::Mode::ICipherMode;
 /// </remarks>
 class CMAC final : public IMac
 {
+public:
+
+	//~~~Structs~~~//
+
+	/// <summary>
+	/// A message authenticated by the ComputeBatch function
+	/// </summary>
+	struct BatchPacket
+	{
+		/// <summary>
+		/// A pointer to the message bytes
+		/// </summary>
+		const byte* Input;
+
+		/// <summary>
+		/// A pointer to the output receiving MacSize() bytes of the Mac code
+		/// </summary>
+		byte* Output;
+
+		/// <summary>
+		/// The message length in bytes
+		/// </summary>
+		size_t Length;
+	};
+
 private:
 
+#if defined(__AVX512__)
+	static const size_t BATCH_LANES = 16;
+#elif defined(__AVX2__)
+	static const size_t BATCH_LANES = 8;
+#else
+	static const size_t BATCH_LANES = 4;
+#endif
 	static const size_t BLOCK_SIZE = 16;
 	static const std::string CLASS_NAME;
 	static const byte CT87 = 0x87;
@@ -196,6 +229,17 @@ public:
 
 	//~~~Public Functions~~~//
 
+	/// <summary>
+	/// Absorb a pending message block into the chain, and return the chaining vector.
+	/// <para>Used by the fused AEAD kernels, which advance the returned chain directly with whole message blocks.
+	/// The caller must pass the last of those blocks to Update rather than the chain, so that the final block is still processed by Finalize.</para>
+	/// </summary>
+	///
+	/// <returns>A reference to the chaining vector</returns>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if the Mac is not initialized, or a partial block is pending</exception>
+	std::vector<byte> &ChainState();
+
 	/// <summary>
 	/// Process an input array and return the Mac code in the output array.
 	/// <para>After calling this function the Mac code and buffer are zeroised, but key is still loaded.</para>
@@ -205,6 +249,17 @@ public:
 	/// <param name="Output">The output Mac code array</param>
 	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
 
+	/// <summary>
+	/// Compute the Mac codes of a set of independent messages with the loaded key.
+	/// <para>The chains of several messages are advanced together, one block of each message per wide transform, and a completed message is replaced by the next in the set.
+	/// The message state of the Update and Finalize functions is not used or changed.</para>
+	/// </summary>
+	///
+	/// <param name="Packets">The messages to authenticate</param>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if the Mac has not been initialized</exception>
+	void ComputeBatch(std::vector<BatchPacket> &Packets);
+
 	/// <summary>
 	/// Process the data and return a Mac code
 	/// <para>After calling this function the Mac code and buffer are zeroised, but key is still loaded.</para>
@@ -249,9 +304,19 @@ public:
 	/// <param name="Length">The length of data to process in bytes</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the Mac with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
 	std::vector<byte> GenerateSubkey(std::vector<byte> &Input);
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
 	void Scope();
 };
 
@@ -541,6 +541,11 @@ void CSG::PermuteW(std::vector<std::array<ulong, STATE_SIZE>> &State)
 		Digest::Keccak::PermuteR48P6400(State);
 #endif
 	}
+
+#if defined(__AVX2__)
+	// the generator output was defined when the wide permutation returned the states in reverse lane order; that order is kept
+	std::reverse(State.begin(), State.end());
+#endif
 }
 
 void CSG::Reset()
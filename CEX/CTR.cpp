@@ -1,7 +1,12 @@
 #include "CTR.h"
+#if defined(__AVX__)
+#	include "AHX.h"
+#endif
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
+#include "BlockScheduler.h"
 #include "IntUtils.h"
-#include "ParallelUtils.h"
+#include <algorithm>
 
 NAMESPACE_MODE
 
@@ -14,6 +19,9 @@ CTR::CTR(BlockCiphers CipherType)
 	m_blockCipher(CipherType != BlockCiphers::None ? Helper::BlockCipherFromName::GetInstance(CipherType) :
 		throw CryptoCipherModeException("CTR:CTor", "The Cipher type can not be none!")),
 	m_cipherType(CipherType),
+	m_ctrBuffer(BLOCK_SIZE),
+	m_ctrNonce(BLOCK_SIZE),
+	m_ctrOffset(0),
 	m_ctrVector(BLOCK_SIZE),
 	m_destroyEngine(true),
 	m_isDestroyed(false),
@@ -29,6 +37,9 @@ CTR::CTR(IBlockCipher* Cipher)
 	m_blockCipher(Cipher != nullptr ? Cipher : 
 		throw CryptoCipherModeException("CTR:CTor", "The Cipher can not be null!")),
 	m_cipherType(m_blockCipher->Enumeral()),
+	m_ctrBuffer(BLOCK_SIZE),
+	m_ctrNonce(BLOCK_SIZE),
+	m_ctrOffset(0),
 	m_ctrVector(BLOCK_SIZE),
 	m_destroyEngine(false),
 	m_isDestroyed(false),
@@ -50,6 +61,10 @@ CTR::~CTR()
 		m_isLoaded = false;
 		m_parallelProfile.Reset();
 
+		m_ctrOffset = 0;
+
+		Utility::IntUtils::ClearVector(m_ctrBuffer);
+		Utility::IntUtils::ClearVector(m_ctrNonce);
 		Utility::IntUtils::ClearVector(m_ctrVector);
 
 		if (m_destroyEngine)
@@ -83,6 +98,11 @@ const BlockCiphers CTR::CipherType()
 	return m_cipherType;
 }
 
+std::vector<byte> &CTR::Counter()
+{
+	return m_ctrVector;
+}
+
 IBlockCipher* CTR::Engine()
 {
 	return m_blockCipher.get();
@@ -108,6 +128,11 @@ const bool CTR::IsParallel()
 	return m_parallelProfile.IsParallel();
 }
 
+const size_t CTR::KeyStreamOffset()
+{
+	return m_ctrOffset;
+}
+
 const std::vector<SymmetricKeySize> &CTR::LegalKeySizes()
 {
 	return m_blockCipher->LegalKeySizes();
@@ -168,6 +193,8 @@ void CTR::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	Scope();
 	m_blockCipher->Initialize(true, KeyParams);
 	m_ctrVector = KeyParams.Nonce();
+	m_ctrNonce = m_ctrVector;
+	m_ctrOffset = 0;
 	m_isEncryption = Encryption;
 	m_isInitialized = true;
 }
@@ -181,34 +208,68 @@ void CTR::ParallelMaxDegree(size_t Degree)
 	m_parallelProfile.SetMaxDegree(Degree);
 }
 
+void CTR::Seek(ulong ByteOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+
+	// the counter is the initial nonce plus the number of whole blocks preceding the offset
+	Utility::IntUtils::BeIncrease8(m_ctrNonce, m_ctrVector, ByteOffset / BLOCK_SIZE);
+	m_ctrOffset = static_cast<size_t>(ByteOffset % BLOCK_SIZE);
+
+	if (m_ctrOffset != 0)
+	{
+		// generate the key stream block containing the offset, the next transform starts within it
+		Generate(m_ctrBuffer, 0, BLOCK_SIZE, m_ctrVector);
+	}
+}
+
 void CTR::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
 
-	const size_t PRLBLK = m_parallelProfile.ParallelBlockSize();
+	const size_t PRTLEN = ProcessPartial(Input, InOffset, Output, OutOffset, Length);
 
-	if (m_parallelProfile.IsParallel() && Length >= PRLBLK)
+	if (PRTLEN != Length)
 	{
-		const size_t BLKCNT = Length / PRLBLK;
+		Process(Input, InOffset + PRTLEN, Output, OutOffset + PRTLEN, Length - PRTLEN);
+	}
+}
 
-		for (size_t i = 0; i < BLKCNT; ++i)
-		{
-			ProcessParallel(Input, InOffset + (i * PRLBLK), Output, OutOffset + (i * PRLBLK), PRLBLK);
-		}
+void CTR::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 
-		const size_t RMDLEN = Length - (PRLBLK * BLKCNT);
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
 
-		if (RMDLEN != 0)
-		{
-			const size_t BLKOFT = (PRLBLK * BLKCNT);
-			ProcessSequential(Input, InOffset + BLKOFT, Output, OutOffset + BLKOFT, RMDLEN);
-		}
+	const size_t PRTLEN = ProcessPartial(inp, 0, otp, 0, Length);
+
+	if (PRTLEN != Length)
+	{
+		Process(inp, PRTLEN, otp, PRTLEN, Length - PRTLEN);
 	}
-	else
+}
+
+void CTR::TransformBatch(std::vector<BatchPacket> &Packets)
+{
+	std::vector<CtrLane> ctrLanes(Packets.size());
+
+	for (size_t i = 0; i < Packets.size(); ++i)
 	{
-		ProcessSequential(Input, InOffset, Output, OutOffset, Length);
+		if (Packets[i].Session == nullptr || !Packets[i].Session->m_isInitialized)
+		{
+			throw CryptoCipherModeException("CTR:TransformBatch", "The packet session has not been initialized!");
+		}
+
+		ctrLanes[i].Session = Packets[i].Session;
+		std::memcpy(ctrLanes[i].Counter.data(), Packets[i].Nonce, BLOCK_SIZE);
+		ctrLanes[i].Input = Packets[i].Input;
+		ctrLanes[i].Output = Packets[i].Output;
+		ctrLanes[i].Length = Packets[i].Length;
 	}
+
+	ProcessLanes(ctrLanes);
 }
 
 //~~~Private Functions~~~//
@@ -223,119 +284,27 @@ void CTR::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::MemUtils::XOR128(Input, InOffset, Output, OutOffset);
 }
 
-void CTR::Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter)
+template <typename Array>
+void CTR::Generate(Array &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter)
 {
-	size_t blkCtr = 0;
+	const size_t BLKCNT = Length / BLOCK_SIZE;
 
-#if defined(__AVX512__)
-	const size_t AVX512BLK = 16 * BLOCK_SIZE;
-	if (Length >= AVX512BLK)
+	// stagger the counters of each run, and encrypt them at the output offset
+	BlockScheduler::Process(m_blockCipher.get(), nullptr, BLKCNT,
+		[&Counter](size_t, size_t RunCount, BlockScheduler::RunState &State)
 	{
-		const size_t PBKALN = Length - (Length % AVX512BLK);
-		std::vector<byte> ctrBlk(AVX512BLK);
-
-		// stagger counters and process 8 blocks with avx512
-		while (blkCtr != PBKALN)
-		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 64);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 80);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 96);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 112);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 128);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 144);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 160);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 176);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 192);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 208);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 224);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 240);
-			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform2048(ctrBlk, 0, Output, OutOffset + blkCtr);
-			blkCtr += AVX512BLK;
-		}
-	}
-#elif defined(__AVX2__)
-	const size_t AVX2BLK = 8 * BLOCK_SIZE;
-	if (Length >= AVX2BLK)
-	{
-		const size_t PBKALN = Length - (Length % AVX2BLK);
-		std::vector<byte> ctrBlk(AVX2BLK);
-		
-		// stagger counters and process 8 blocks with avx2
-		while (blkCtr != PBKALN)
-		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 64);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 80);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 96);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 112);
-			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform1024(ctrBlk, 0, Output, OutOffset + blkCtr);
-			blkCtr += AVX2BLK;
-		}
-	}
-#elif defined(__AVX__)
-	const size_t AVXBLK = 4 * BLOCK_SIZE;
-	if (Length >= AVXBLK)
-	{
-		const size_t PBKALN = Length - (Length % AVXBLK);
-		std::vector<byte> ctrBlk(AVXBLK);
-
-		// 4 blocks with avx
-		while (blkCtr != PBKALN)
+		for (size_t i = 0; i < RunCount; ++i)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
+			Utility::MemUtils::COPY128(Counter, 0, State, i * BLOCK_SIZE);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
-			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
-			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform512(ctrBlk, 0, Output, OutOffset + blkCtr);
-			blkCtr += AVXBLK;
 		}
-	}
-#endif
-
-	const size_t BLKALN = Length - (Length % BLOCK_SIZE);
-	while (blkCtr != BLKALN)
+	},
+		[&Output, OutOffset](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &State)
 	{
-		m_blockCipher->EncryptBlock(Counter, 0, Output, OutOffset + blkCtr);
-		Utility::IntUtils::BeIncrement8(Counter);
-		blkCtr += BLOCK_SIZE;
-	}
+		Utility::MemUtils::Copy(State, 0, Output, OutOffset + (RunOffset * BLOCK_SIZE), RunCount * BLOCK_SIZE);
+	});
 
-	if (blkCtr != Length)
+	if (BLKCNT * BLOCK_SIZE != Length)
 	{
 		std::vector<byte> outputBlock(BLOCK_SIZE);
 		m_blockCipher->EncryptBlock(Counter, outputBlock);
@@ -345,68 +314,317 @@ void CTR::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	}
 }
 
-void CTR::ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+template <typename ArrayA, typename ArrayB>
+void CTR::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
 {
-	const size_t OUTLEN = Output.size() - OutOffset < Length ? Output.size() - OutOffset : Length;
-	const size_t CNKLEN = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
-	const size_t CTRLEN = (CNKLEN / BLOCK_SIZE);
-	std::vector<byte> tmpCtr(m_ctrVector.size());
+	const size_t BLKCNT = Length / BLOCK_SIZE;
 
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpCtr, CNKLEN, CTRLEN](size_t i)
+	// each segment offsets the counter by its block offset, the key stream is xored from the run state so the input can be overwritten
+	BlockScheduler::Schedule(m_parallelProfile, BLKCNT, [this, &Input, InOffset, &Output, OutOffset](size_t, size_t BlockOffset, size_t BlockCount)
 	{
-		// thread level counter
-		std::vector<byte> thdCtr(m_ctrVector.size());
-		// offset counter by chunk size / block size  
-		Utility::IntUtils::BeIncrease8(m_ctrVector, thdCtr, CTRLEN * i);
-		// generate random at output offset
-		this->Generate(Output, OutOffset + (i * CNKLEN), CNKLEN, thdCtr);
-		// xor with input at offsets
-		Utility::MemUtils::XorBlock(Input, InOffset + (i * CNKLEN), Output, OutOffset + (i * CNKLEN), CNKLEN);
-
-		// store last counter
-		if (i == m_parallelProfile.ParallelMaxDegree() - 1)
+		std::vector<byte> thdCtr(BLOCK_SIZE);
+		Utility::IntUtils::BeIncrease8(m_ctrVector, thdCtr, BlockOffset);
+		const size_t INPOFT = InOffset + (BlockOffset * BLOCK_SIZE);
+		const size_t OUTOFT = OutOffset + (BlockOffset * BLOCK_SIZE);
+
+		BlockScheduler::Process(m_blockCipher.get(), Input.data() + INPOFT, BlockCount,
+			[&thdCtr](size_t, size_t RunCount, BlockScheduler::RunState &State)
 		{
-			Utility::MemUtils::COPY128(thdCtr, 0, tmpCtr, 0);
-		}
+			for (size_t i = 0; i < RunCount; ++i)
+			{
+				Utility::MemUtils::COPY128(thdCtr, 0, State, i * BLOCK_SIZE);
+				Utility::IntUtils::BeIncrement8(thdCtr);
+			}
+		},
+			[&Input, INPOFT, &Output, OUTOFT](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &State)
+		{
+			Utility::MemUtils::XorBlock(Input, INPOFT + (RunOffset * BLOCK_SIZE), State, 0, RunCount * BLOCK_SIZE);
+			Utility::MemUtils::Copy(State, 0, Output, OUTOFT + (RunOffset * BLOCK_SIZE), RunCount * BLOCK_SIZE);
+		});
 	});
 
-	// copy last counter to class variable
-	Utility::MemUtils::COPY128(tmpCtr, 0, m_ctrVector, 0);
+	Utility::IntUtils::BeIncrease8(m_ctrVector, BLKCNT);
+
+	// the remaining bytes are xored with the next key stream block, the unused remainder is kept for the next transform
+	if (BLKCNT * BLOCK_SIZE != Length)
+	{
+		const size_t FNLLEN = Length % BLOCK_SIZE;
+		Generate(m_ctrBuffer, 0, BLOCK_SIZE, m_ctrVector);
+
+		for (size_t i = 0; i < FNLLEN; ++i)
+		{
+			Output[OutOffset + (Length - FNLLEN) + i] = Input[InOffset + (Length - FNLLEN) + i] ^ m_ctrBuffer[i];
+		}
 
-	// last block processing
-	const size_t ALNLEN = CNKLEN * m_parallelProfile.ParallelMaxDegree();
-	if (ALNLEN < OUTLEN)
+		m_ctrOffset = FNLLEN;
+	}
+}
+
+template <typename ArrayA, typename ArrayB>
+size_t CTR::ProcessPartial(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
+{
+	size_t prcLen = 0;
+
+	// use the remainder of the key stream block generated by Seek
+	if (m_ctrOffset != 0)
 	{
-		const size_t FNLLEN = (Output.size() - OutOffset) % ALNLEN;
-		Generate(Output, ALNLEN, FNLLEN, m_ctrVector);
+		prcLen = Utility::IntUtils::Min(BLOCK_SIZE - m_ctrOffset, Length);
 
-		for (size_t i = ALNLEN; i < OUTLEN; i++)
+		for (size_t i = 0; i < prcLen; ++i)
 		{
-			Output[i] ^= Input[i];
+			Output[OutOffset + i] = static_cast<byte>(Input[InOffset + i] ^ m_ctrBuffer[m_ctrOffset + i]);
 		}
+
+		m_ctrOffset = (m_ctrOffset + prcLen) % BLOCK_SIZE;
 	}
+
+	return prcLen;
 }
 
-void CTR::ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+void CTR::ProcessLanes(std::vector<CtrLane> &Lanes)
 {
-	// generate random
-	Generate(Output, OutOffset, Length, m_ctrVector);
-	// get block aligned
-	size_t ALNLEN = Length - (Length % BLOCK_SIZE);
+	std::vector<size_t> wdeLanes;
+
+	for (size_t i = 0; i < Lanes.size(); ++i)
+	{
+		CtrLane &lane = Lanes[i];
+
+		if (lane.Length == 0)
+		{
+			continue;
+		}
+
+#if defined(__AVX__)
+		if (dynamic_cast<Cipher::Symmetric::Block::AHX*>(lane.Session->m_blockCipher.get()) != nullptr)
+		{
+			wdeLanes.push_back(i);
+			continue;
+		}
+#endif
+
+		// other engines generate the key stream of the whole message
+		std::vector<byte> tmpC(lane.Counter.begin(), lane.Counter.end());
+		std::vector<byte> tmpK(lane.Length);
+		lane.Session->Generate(tmpK, 0, lane.Length, tmpC);
 
-	if (ALNLEN != 0)
+		for (size_t j = 0; j < lane.Length; ++j)
+		{
+			lane.Output[j] = static_cast<byte>(lane.Input[j] ^ tmpK[j]);
+		}
+
+		Utility::MemUtils::Copy(tmpC, 0, lane.Counter, 0, BLOCK_SIZE);
+		Utility::MemUtils::Clear(tmpK, 0, tmpK.size());
+	}
+
+#if defined(__AVX__)
+	if (wdeLanes.size() == 0)
 	{
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, ALNLEN);
+		return;
 	}
 
-	// get the remaining bytes
-	if (ALNLEN != Length)
+	const __m128i MASK = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i ONE = _mm_set_epi64x(0, 1);
+	const __m128i CARRY = _mm_set_epi64x(1, 0);
+	const __m128i* rndKeys[BATCH_LANES];
+	// the counters are held byte reversed, as 64 bit integers
+	__m128i ctrV[BATCH_LANES];
+	__m128i X[BATCH_LANES];
+	size_t lnsIndex[BATCH_LANES];
+	size_t lnsPosition[BATCH_LANES];
+	byte tmpK[BLOCK_SIZE];
+
+	auto keyRounds = [&Lanes](size_t Index)
 	{
-		for (size_t i = ALNLEN; i < Length; ++i)
+		return static_cast<Cipher::Symmetric::Block::AHX*>(Lanes[Index].Session->m_blockCipher.get())->RoundKeys().size() - 1;
+	};
+
+	auto loadLane = [&Lanes, &rndKeys, &ctrV, &lnsIndex, &lnsPosition, &MASK](size_t Slot, size_t Index)
+	{
+		rndKeys[Slot] = static_cast<Cipher::Symmetric::Block::AHX*>(Lanes[Index].Session->m_blockCipher.get())->RoundKeys().data();
+		ctrV[Slot] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Lanes[Index].Counter.data())), MASK);
+		lnsIndex[Slot] = Index;
+		lnsPosition[Slot] = 0;
+	};
+
+	// the blocks in flight together must share a round count
+	std::stable_sort(wdeLanes.begin(), wdeLanes.end(), [&keyRounds](size_t A, size_t B) { return keyRounds(A) < keyRounds(B); });
+	size_t grpOft = 0;
+
+	while (grpOft != wdeLanes.size())
+	{
+		const size_t RNDCNT = keyRounds(wdeLanes[grpOft]);
+		size_t grpEnd = grpOft;
+		size_t actCnt = 0;
+
+		while (grpEnd != wdeLanes.size() && keyRounds(wdeLanes[grpEnd]) == RNDCNT)
+		{
+			++grpEnd;
+		}
+
+		while (actCnt != BATCH_LANES && grpOft != grpEnd)
 		{
-			Output[i + OutOffset] ^= Input[i + InOffset];
+			loadLane(actCnt, wdeLanes[grpOft]);
+			++actCnt;
+			++grpOft;
+		}
+
+		while (actCnt != 0)
+		{
+			size_t blkCnt = 0;
+
+			if (actCnt == BATCH_LANES)
+			{
+				// the whole blocks every lane can process before a lane completes, or a counter carries into its high word
+				blkCnt = ~static_cast<size_t>(0);
+
+				for (size_t i = 0; i < BATCH_LANES; ++i)
+				{
+					const ulong CTRLOW = static_cast<ulong>(_mm_cvtsi128_si64(ctrV[i]));
+					blkCnt = Utility::IntUtils::Min(blkCnt, (Lanes[lnsIndex[i]].Length - lnsPosition[i]) / BLOCK_SIZE);
+					blkCnt = static_cast<size_t>(Utility::IntUtils::Min(static_cast<ulong>(blkCnt), ~CTRLOW));
+				}
+			}
+
+			if (blkCnt != 0)
+			{
+				// one block of each of the 8 messages in flight, without branches or carries
+				const __m128i* K0 = rndKeys[0];
+				const __m128i* K1 = rndKeys[1];
+				const __m128i* K2 = rndKeys[2];
+				const __m128i* K3 = rndKeys[3];
+				const __m128i* K4 = rndKeys[4];
+				const __m128i* K5 = rndKeys[5];
+				const __m128i* K6 = rndKeys[6];
+				const __m128i* K7 = rndKeys[7];
+				__m128i X0, X1, X2, X3, X4, X5, X6, X7;
+
+				for (size_t b = 0; b < blkCnt; ++b)
+				{
+					X0 = _mm_xor_si128(_mm_shuffle_epi8(ctrV[0], MASK), K0[0]);
+					X1 = _mm_xor_si128(_mm_shuffle_epi8(ctrV[1], MASK), K1[0]);
+					X2 = _mm_xor_si128(_mm_shuffle_epi8(ctrV[2], MASK), K2[0]);
+					X3 = _mm_xor_si128(_mm_shuffle_epi8(ctrV[3], MASK), K3[0]);
+					X4 = _mm_xor_si128(_mm_shuffle_epi8(ctrV[4], MASK), K4[0]);
+					X5 = _mm_xor_si128(_mm_shuffle_epi8(ctrV[5], MASK), K5[0]);
+					X6 = _mm_xor_si128(_mm_shuffle_epi8(ctrV[6], MASK), K6[0]);
+					X7 = _mm_xor_si128(_mm_shuffle_epi8(ctrV[7], MASK), K7[0]);
+
+					for (size_t i = 0; i < BATCH_LANES; ++i)
+					{
+						ctrV[i] = _mm_add_epi64(ctrV[i], ONE);
+					}
+
+					for (size_t r = 1; r != RNDCNT; ++r)
+					{
+						X0 = _mm_aesenc_si128(X0, K0[r]);
+						X1 = _mm_aesenc_si128(X1, K1[r]);
+						X2 = _mm_aesenc_si128(X2, K2[r]);
+						X3 = _mm_aesenc_si128(X3, K3[r]);
+						X4 = _mm_aesenc_si128(X4, K4[r]);
+						X5 = _mm_aesenc_si128(X5, K5[r]);
+						X6 = _mm_aesenc_si128(X6, K6[r]);
+						X7 = _mm_aesenc_si128(X7, K7[r]);
+					}
+
+					X[0] = _mm_aesenclast_si128(X0, K0[RNDCNT]);
+					X[1] = _mm_aesenclast_si128(X1, K1[RNDCNT]);
+					X[2] = _mm_aesenclast_si128(X2, K2[RNDCNT]);
+					X[3] = _mm_aesenclast_si128(X3, K3[RNDCNT]);
+					X[4] = _mm_aesenclast_si128(X4, K4[RNDCNT]);
+					X[5] = _mm_aesenclast_si128(X5, K5[RNDCNT]);
+					X[6] = _mm_aesenclast_si128(X6, K6[RNDCNT]);
+					X[7] = _mm_aesenclast_si128(X7, K7[RNDCNT]);
+
+					for (size_t i = 0; i < BATCH_LANES; ++i)
+					{
+						CtrLane &lane = Lanes[lnsIndex[i]];
+						const __m128i C = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane.Input + lnsPosition[i]));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(lane.Output + lnsPosition[i]), _mm_xor_si128(X[i], C));
+						lnsPosition[i] += BLOCK_SIZE;
+					}
+				}
+			}
+			else
+			{
+				// a single step; partial blocks, counter carries, and the lanes at the end of the batch
+				for (size_t i = 0; i < actCnt; ++i)
+				{
+					X[i] = _mm_xor_si128(_mm_shuffle_epi8(ctrV[i], MASK), rndKeys[i][0]);
+					ctrV[i] = _mm_add_epi64(ctrV[i], ONE);
+
+					if (_mm_cvtsi128_si64(ctrV[i]) == 0)
+					{
+						ctrV[i] = _mm_add_epi64(ctrV[i], CARRY);
+					}
+				}
+
+				for (size_t r = 1; r != RNDCNT; ++r)
+				{
+					for (size_t i = 0; i < actCnt; ++i)
+					{
+						X[i] = _mm_aesenc_si128(X[i], rndKeys[i][r]);
+					}
+				}
+
+				for (size_t i = 0; i < actCnt; ++i)
+				{
+					CtrLane &lane = Lanes[lnsIndex[i]];
+					const size_t RMDLEN = lane.Length - lnsPosition[i];
+					X[i] = _mm_aesenclast_si128(X[i], rndKeys[i][RNDCNT]);
+
+					if (RMDLEN >= BLOCK_SIZE)
+					{
+						const __m128i C = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane.Input + lnsPosition[i]));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(lane.Output + lnsPosition[i]), _mm_xor_si128(X[i], C));
+						lnsPosition[i] += BLOCK_SIZE;
+					}
+					else
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(tmpK), X[i]);
+
+						for (size_t j = 0; j < RMDLEN; ++j)
+						{
+							lane.Output[lnsPosition[i] + j] = static_cast<byte>(lane.Input[lnsPosition[i] + j] ^ tmpK[j]);
+						}
+
+						lnsPosition[i] = lane.Length;
+					}
+				}
+			}
+
+			// a completed message is replaced by the next, or by the last slot when the group is exhausted
+			size_t slot = 0;
+
+			while (slot != actCnt)
+			{
+				if (lnsPosition[slot] != Lanes[lnsIndex[slot]].Length)
+				{
+					++slot;
+					continue;
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes[lnsIndex[slot]].Counter.data()), _mm_shuffle_epi8(ctrV[slot], MASK));
+
+				if (grpOft != grpEnd)
+				{
+					loadLane(slot, wdeLanes[grpOft]);
+					++grpOft;
+					++slot;
+				}
+				else
+				{
+					--actCnt;
+					rndKeys[slot] = rndKeys[actCnt];
+					ctrV[slot] = ctrV[actCnt];
+					lnsIndex[slot] = lnsIndex[actCnt];
+					lnsPosition[slot] = lnsPosition[actCnt];
+				}
+			}
 		}
 	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(tmpK), _mm_setzero_si128());
+#endif
 }
 
 void CTR::Scope()
@@ -29,6 +29,7 @@
 #define CEX_CTR_H
 
 #include "ICipherMode.h"
+#include <array>
 
 NAMESPACE_MODE
 
@@ -83,7 +84,7 @@ NAMESPACE_MODE
 ///
 /// <description>Implementation Notes:</description>
 /// <list type="bullet">
-/// <item><description>In CTR mode, Encryption/Decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded.</description></item>
+/// <item><description>In CTR mode, Encryption/Decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded; the key stream of a segment is generated in runs of 16 counter blocks by the BlockScheduler.</description></item>
 /// <item><description>A cipher mode constructor can either be initialized with a block cipher instance, or using the block ciphers enumeration name.</description></item>
 /// <item><description>A block cipher instance created using the enumeration constructor, is automatically deleted when the class is destroyed.</description></item>
 /// <item><description>The Transform functions are virtual, and can be accessed from an ICipherMode instance.</description></item>
@@ -94,6 +95,7 @@ NAMESPACE_MODE
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
 /// <item><description>Parallel block calculation ex. <c>ParallelBlockSize = N - (N % .ParallelMinimumSize);</c></description></item>
+/// <item><description>TransformBatch(std::vector&lt;BatchPacket&gt;) processes many short messages with independent keys and counters; with the AHX engine the blocks of 8 messages are interleaved through the AES rounds.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -105,13 +107,61 @@ NAMESPACE_MODE
 /// </remarks>
 class CTR final : public ICipherMode
 {
+public:
+
+	//~~~Structs~~~//
+
+	/// <summary>
+	/// A message transformed by the TransformBatch function
+	/// </summary>
+	struct BatchPacket
+	{
+		/// <summary>
+		/// An initialized CTR instance holding the key of the message; the counter state of the instance is not used or changed
+		/// </summary>
+		CTR* Session;
+
+		/// <summary>
+		/// A pointer to the 16 byte initial counter of the message
+		/// </summary>
+		const byte* Nonce;
+
+		/// <summary>
+		/// A pointer to the input bytes
+		/// </summary>
+		const byte* Input;
+
+		/// <summary>
+		/// A pointer to the output bytes; can be the same address as the input
+		/// </summary>
+		byte* Output;
+
+		/// <summary>
+		/// The number of bytes to transform
+		/// </summary>
+		size_t Length;
+	};
+
 private:
 
+	static const size_t BATCH_LANES = 8;
 	static const size_t BLOCK_SIZE = 16;
 	static const std::string CLASS_NAME;
 
+	struct CtrLane
+	{
+		CTR* Session;
+		std::array<byte, BLOCK_SIZE> Counter;
+		const byte* Input;
+		byte* Output;
+		size_t Length;
+	};
+
 	std::unique_ptr<IBlockCipher> m_blockCipher;
 	BlockCiphers m_cipherType;
+	std::vector<byte> m_ctrBuffer;
+	std::vector<byte> m_ctrNonce;
+	size_t m_ctrOffset;
 	std::vector<byte> m_ctrVector;
 	bool m_destroyEngine;
 	bool m_isDestroyed;
@@ -174,6 +224,12 @@ public:
 	/// </summary>
 	const BlockCiphers CipherType() override;
 
+	/// <summary>
+	/// Read/Write: The current counter block.
+	/// <para>The fused AEAD kernels that generate the key stream themselves advance the counter through this reference.</para>
+	/// </summary>
+	std::vector<byte> &Counter();
+
 	/// <summary>
 	/// Read Only: The underlying Block Cipher instance
 	/// </summary>
@@ -201,6 +257,11 @@ public:
 	/// </summary>
 	const bool IsParallel() override;
 
+	/// <summary>
+	/// Read Only: The number of bytes used from the last key stream block; zero when the counter is block aligned
+	/// </summary>
+	const size_t KeyStreamOffset();
+
 	/// <summary>
 	/// Read Only: Array of allowed cipher input key byte-sizes
 	/// </summary>
@@ -292,6 +353,16 @@ public:
 	/// <param name="Degree">The desired number of threads</param>
 	void ParallelMaxDegree(size_t Degree) override;
 
+	/// <summary>
+	/// Position the key stream at a byte offset.
+	/// <para>The counter is calculated directly from the initial nonce and the offset, so seeking costs the same as a sequential transform.
+	/// If the offset is not aligned to the block size, the key stream block containing the offset is generated, and its remaining bytes are used by the next call to Transform.
+	/// The sequential and parallel transforms continue from the new position. Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="ByteOffset">The offset in bytes from the start of the key stream</param>
+	void Seek(ulong ByteOffset);
+
 	/// <summary>
 	/// Transform a length of bytes with offset parameters. 
 	/// <para>This method processes a specified length of bytes, utilizing offsets incremented by the caller.
@@ -307,13 +378,40 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
+	/// <summary>
+	/// Transform a batch of independent messages, each with its own key and initial counter.
+	/// <para>With the AES-NI engine (AHX), one block from each of up to 8 messages is processed per round, so many short messages keep the pipeline as full as a single long message.
+	/// Messages using other engines are transformed one at a time.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The messages to transform</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a session is null or has not been initialized</exception>
+	static void TransformBatch(std::vector<BatchPacket> &Packets);
+
 private:
 
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter);
+	template <typename Array>
+	void Generate(Array &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter);
+	static void ProcessLanes(std::vector<CtrLane> &Lanes);
 	void Scope();
-	void ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
-	void ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	size_t ProcessPartial(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
 };
 
 NAMESPACE_MODEEND
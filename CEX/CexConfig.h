@@ -159,6 +159,13 @@
 #	define CEX_SUPPORTED_OS 0
 #endif
 
+// linux io_uring asynchronous file i/o, used by AsyncFileStream; define CEX_NO_IOURING to use positional reads and writes
+#if defined(CEX_OS_LINUX) && defined(__has_include) && !defined(CEX_NO_IOURING)
+#	if __has_include(<linux/io_uring.h>)
+#		define CEX_HAS_IOURING
+#	endif
+#endif
+
 // msc specific
 #if defined(_MSC_VER)
 #	define CEX_MSC_VERSION (_MSC_VER)
@@ -419,6 +426,25 @@ inline static void CexAssert(bool Condition, const T Message)
 #	endif
 #endif
 
+// vector AES instructions (VAES); the wide kernels are compiled when the compiler targets them, and selected at runtime through CpuDetect
+#if defined(CEX_HAS_AVX2) && (defined(__VAES__) || defined(CEX_COMPILER_MSC))
+#	define CEX_HAS_VAES
+#endif
+// the 512 bit kernels use only AVX512F and VAES, so they follow the compiler target rather than the untested CEX_AVX512_SUPPORTED profile
+#if defined(CEX_HAS_VAES) && defined(__AVX512F__)
+#	define CEX_HAS_VAES512
+#endif
+
+// 64 bit multiplication with a 128 bit product; the unsigned __int128 type with gcc and clang, or the _umul128 intrinsic with msvc on x64
+#if defined(__SIZEOF_INT128__)
+#	define CEX_HAS_UINT128
+#elif defined(CEX_COMPILER_MSC) && defined(CEX_ARCH_X64)
+#	define CEX_HAS_UMUL128
+#endif
+#if defined(CEX_HAS_UINT128) || defined(CEX_HAS_UMUL128)
+#	define CEX_HAS_MUL128
+#endif
+
 // avx minimum verification
 #if defined(CEX_HAS_AVX) || defined(CEX_HAS_AVX2) || defined(CEX_HAS_AVX512)
 #	define CEX_AVX_SUPPORTED
@@ -33,8 +33,8 @@ public:
 
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
-	template<class Vector>
-	static void TransformW(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, std::vector<uint> &State, size_t Rounds)
+	template<class Vector, typename Array>
+	static void TransformW(Array &Output, size_t OutOffset, std::vector<uint> &Counter, std::vector<uint> &State, size_t Rounds)
 	{
 		Vector X0(State[0]);
 		Vector X1(State[1]);
@@ -158,7 +158,8 @@ public:
 
 #endif
 
-	static void Transform(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, std::vector<uint> &State, size_t Rounds)
+	template<typename Array>
+	static void Transform(Array &Output, size_t OutOffset, std::vector<uint> &Counter, std::vector<uint> &State, size_t Rounds)
 	{
 		uint X0 = State[0];
 		uint X1 = State[1];
@@ -1,4 +1,5 @@
 #include "ChaCha20.h"
+#include "ArraySpan.h"
 #include "ChaCha.h"
 #if defined(__AVX2__)
 #	include "UInt256.h"
@@ -16,6 +17,8 @@ const std::string ChaCha20::TAU_INFO("expand 16-byte k");
 
 ChaCha20::ChaCha20(size_t Rounds)
 	:
+	m_ctrBuffer(BLOCK_SIZE),
+	m_ctrOffset(0),
 	m_ctrVector(2, 0),
 	m_dstCode(16),
 	m_isDestroyed(false),
@@ -38,6 +41,8 @@ ChaCha20::~ChaCha20()
 		m_isInitialized = false;
 		m_parallelProfile.Reset();
 		m_rndCount = 0;
+		m_ctrOffset = 0;
+		IntUtils::ClearVector(m_ctrBuffer);
 		IntUtils::ClearVector(m_ctrVector);
 		IntUtils::ClearVector(m_wrkState);
 		IntUtils::ClearVector(m_dstCode);
@@ -53,6 +58,11 @@ const size_t ChaCha20::BlockSize()
 	return BLOCK_SIZE; 
 }
 
+std::vector<uint> &ChaCha20::Counter()
+{
+	return m_ctrVector;
+}
+
 const std::vector<byte> &ChaCha20::DistributionCode()
 { 
 	return m_dstCode; 
@@ -160,10 +170,29 @@ void ChaCha20::ParallelMaxDegree(size_t Degree)
 
 void ChaCha20::Reset()
 {
+	m_ctrOffset = 0;
 	m_ctrVector[0] = 0;
 	m_ctrVector[1] = 0;
 }
 
+void ChaCha20::Seek(ulong ByteOffset)
+{
+	CexAssert(m_isInitialized, "The cipher has not been initialized!");
+
+	const ulong BLKCNT = ByteOffset / BLOCK_SIZE;
+
+	// the 64 bit block counter of the block containing the offset
+	m_ctrVector[0] = static_cast<uint>(BLKCNT);
+	m_ctrVector[1] = static_cast<uint>(BLKCNT >> 32);
+	m_ctrOffset = static_cast<size_t>(ByteOffset % BLOCK_SIZE);
+
+	if (m_ctrOffset != 0)
+	{
+		// generate the key stream block containing the offset, the next transform starts within it
+		Generate(m_ctrBuffer, 0, m_ctrVector, BLOCK_SIZE);
+	}
+}
+
 void ChaCha20::TransformBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
 {
 	Process(Input, 0, Output, 0, BLOCK_SIZE);
@@ -176,7 +205,25 @@ void ChaCha20::TransformBlock(const std::vector<byte> &Input, const size_t InOff
 
 void ChaCha20::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
-	Process(Input, InOffset, Output, OutOffset, Length);
+	const size_t PRTLEN = ProcessPartial(Input, InOffset, Output, OutOffset, Length);
+
+	if (PRTLEN != Length)
+	{
+		Process(Input, InOffset + PRTLEN, Output, OutOffset + PRTLEN, Length - PRTLEN);
+	}
+}
+
+void ChaCha20::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
+
+	const size_t PRTLEN = ProcessPartial(inp, 0, otp, 0, Length);
+
+	if (PRTLEN != Length)
+	{
+		Process(inp, PRTLEN, otp, PRTLEN, Length - PRTLEN);
+	}
 }
 
 //~~~Private Functions~~~//
@@ -220,7 +267,8 @@ void ChaCha20::Expand(const std::vector<byte> &Key, const std::vector<byte> &Iv)
 	}
 }
 
-void ChaCha20::Generate(std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Counter, const size_t Length)
+template <typename Array>
+void ChaCha20::Generate(Array &Output, const size_t OutOffset, std::vector<uint> &Counter, const size_t Length)
 {
 	size_t ctr = 0;
 
@@ -373,11 +421,27 @@ void ChaCha20::Generate(std::vector<byte> &Output, const size_t OutOffset, std::
 	}
 }
 
-void ChaCha20::Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+template <typename ArrayA, typename ArrayB>
+void ChaCha20::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
 {
 	const size_t PRCLEN = (Length >= Input.size() - InOffset) && Length >= Output.size() - OutOffset ? IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) : Length;
 
-	if (!m_parallelProfile.IsParallel() || PRCLEN < m_parallelProfile.ParallelMinimumSize())
+	if (PRCLEN != 0 && &Input[InOffset] == &Output[OutOffset])
+	{
+		// the key stream is generated in the output, so an in-place transform is processed through a temporary block
+		const size_t TMPLEN = IntUtils::Min(IntUtils::Max(m_parallelProfile.ParallelBlockSize(), BLOCK_SIZE), PRCLEN);
+		std::vector<byte> tmp(TMPLEN);
+		size_t prcLen = 0;
+
+		while (prcLen != PRCLEN)
+		{
+			const size_t CPYLEN = IntUtils::Min(TMPLEN, PRCLEN - prcLen);
+			Process(Input, InOffset + prcLen, tmp, 0, CPYLEN);
+			Utility::MemUtils::Copy(tmp, 0, Output, OutOffset + prcLen, CPYLEN);
+			prcLen += CPYLEN;
+		}
+	}
+	else if (!m_parallelProfile.IsParallel() || PRCLEN < m_parallelProfile.ParallelMinimumSize())
 	{
 		// generate random
 		Generate(Output, OutOffset, m_ctrVector, PRCLEN);
@@ -430,7 +494,7 @@ void ChaCha20::Process(const std::vector<byte> &Input, const size_t InOffset, st
 		if (RNDLEN < PRCLEN)
 		{
 			const size_t FNLLEN = PRCLEN % RNDLEN;
-			Generate(Output, RNDLEN, m_ctrVector, FNLLEN);
+			Generate(Output, OutOffset + RNDLEN, m_ctrVector, FNLLEN);
 
 			for (size_t i = 0; i < FNLLEN; ++i)
 			{
@@ -440,6 +504,27 @@ void ChaCha20::Process(const std::vector<byte> &Input, const size_t InOffset, st
 	}
 }
 
+template <typename ArrayA, typename ArrayB>
+size_t ChaCha20::ProcessPartial(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
+{
+	size_t prcLen = 0;
+
+	// use the remainder of the key stream block generated by Seek
+	if (m_ctrOffset != 0)
+	{
+		prcLen = IntUtils::Min(BLOCK_SIZE - m_ctrOffset, Length);
+
+		for (size_t i = 0; i < prcLen; ++i)
+		{
+			Output[OutOffset + i] = static_cast<byte>(Input[InOffset + i] ^ m_ctrBuffer[m_ctrOffset + i]);
+		}
+
+		m_ctrOffset = (m_ctrOffset + prcLen) % BLOCK_SIZE;
+	}
+
+	return prcLen;
+}
+
 void ChaCha20::Scope()
 {
 	m_legalKeySizes.resize(2);
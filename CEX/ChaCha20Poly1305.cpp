@@ -0,0 +1,440 @@
+#include "ChaCha20Poly1305.h"
+#include "IntUtils.h"
+#include "SymmetricKey.h"
+
+NAMESPACE_MODE
+
+const std::string ChaCha20Poly1305::CLASS_NAME("ChaCha20Poly1305");
+
+//~~~Constructor~~~//
+
+ChaCha20Poly1305::ChaCha20Poly1305()
+	:
+	m_aadData(0),
+	m_aadLoaded(false),
+	m_aadPreserve(false),
+	m_aadSize(0),
+	m_autoIncrement(false),
+	m_cipherKey(0),
+	m_cipherNonce(0),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isFinalized(false),
+	m_isInitialized(false),
+	m_keyOffset(STREAM_BLOCK),
+	m_keyStream(STREAM_BLOCK),
+	m_legalKeySizes{ SymmetricKeySize(KEY_SIZE, NONCE_SIZE, 0) },
+	m_macGenerator(new Mac::Poly1305(BlockCiphers::None)),
+	m_msgSize(0),
+	m_msgTag(BLOCK_SIZE),
+	m_streamCipher(new Stream::ChaCha20(20))
+{
+}
+
+ChaCha20Poly1305::~ChaCha20Poly1305()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_aadLoaded = false;
+		m_aadPreserve = false;
+		m_aadSize = 0;
+		m_autoIncrement = false;
+		m_isEncryption = false;
+		m_isFinalized = false;
+		m_isInitialized = false;
+		m_keyOffset = 0;
+		m_msgSize = 0;
+
+		Utility::IntUtils::ClearVector(m_aadData);
+		Utility::IntUtils::ClearVector(m_cipherKey);
+		Utility::IntUtils::ClearVector(m_cipherNonce);
+		Utility::IntUtils::ClearVector(m_keyStream);
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_msgTag);
+
+		if (m_macGenerator != nullptr)
+		{
+			m_macGenerator.reset(nullptr);
+		}
+
+		if (m_streamCipher != nullptr)
+		{
+			m_streamCipher.reset(nullptr);
+		}
+	}
+}
+
+//~~~Accessors~~~//
+
+bool &ChaCha20Poly1305::AutoIncrement()
+{
+	return m_autoIncrement;
+}
+
+const size_t ChaCha20Poly1305::BlockSize()
+{
+	return BLOCK_SIZE;
+}
+
+const BlockCiphers ChaCha20Poly1305::CipherType()
+{
+	return BlockCiphers::None;
+}
+
+IBlockCipher* ChaCha20Poly1305::Engine()
+{
+	return nullptr;
+}
+
+const CipherModes ChaCha20Poly1305::Enumeral()
+{
+	return CipherModes::ChaCha20Poly1305;
+}
+
+const bool ChaCha20Poly1305::IsEncryption()
+{
+	return m_isEncryption;
+}
+
+const bool ChaCha20Poly1305::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+const bool ChaCha20Poly1305::IsParallel()
+{
+	return m_streamCipher->IsParallel();
+}
+
+const std::vector<SymmetricKeySize> &ChaCha20Poly1305::LegalKeySizes()
+{
+	return m_legalKeySizes;
+}
+
+const size_t ChaCha20Poly1305::MaxTagSize()
+{
+	return BLOCK_SIZE;
+}
+
+const size_t ChaCha20Poly1305::MinTagSize()
+{
+	return MIN_TAGSIZE;
+}
+
+const std::string ChaCha20Poly1305::Name()
+{
+	return CLASS_NAME;
+}
+
+const size_t ChaCha20Poly1305::ParallelBlockSize()
+{
+	return m_streamCipher->ParallelBlockSize();
+}
+
+ParallelOptions &ChaCha20Poly1305::ParallelProfile()
+{
+	return m_streamCipher->ParallelProfile();
+}
+
+bool &ChaCha20Poly1305::PreserveAD()
+{
+	return m_aadPreserve;
+}
+
+const std::vector<byte> ChaCha20Poly1305::Tag()
+{
+	CexAssert(m_isFinalized, "The cipher mode has not been finalized");
+
+	return m_msgTag;
+}
+
+//~~~Public Functions~~~//
+
+void ChaCha20Poly1305::DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	DecryptBlock(Input, 0, Output, 0);
+}
+
+void ChaCha20Poly1305::DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(!m_isEncryption, "The cipher mode has been initialized for encryption!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+	Process(Input.data() + InOffset, Output.data() + OutOffset, BLOCK_SIZE);
+}
+
+void ChaCha20Poly1305::EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	EncryptBlock(Input, 0, Output, 0);
+}
+
+void ChaCha20Poly1305::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(m_isEncryption, "The cipher mode has been initialized for decryption!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+	Process(Input.data() + InOffset, Output.data() + OutOffset, BLOCK_SIZE);
+}
+
+void ChaCha20Poly1305::Finalize(std::vector<byte> &Output, const size_t Offset, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized");
+	CexAssert(Length >= MIN_TAGSIZE && Length <= BLOCK_SIZE, "The length must be minimum of 12 and maximum of MAC code size");
+
+	CalculateMac();
+	Utility::MemUtils::Copy(m_msgTag, 0, Output, Offset, Length);
+}
+
+void ChaCha20Poly1305::Initialize(bool Encryption, ISymmetricKey &KeyParams)
+{
+	if (KeyParams.Nonce().size() != NONCE_SIZE)
+	{
+		throw CryptoSymmetricCipherException("ChaCha20Poly1305:Initialize", "Requires exactly 12 bytes of Nonce!");
+	}
+
+	if (KeyParams.Key().size() == 0)
+	{
+		if (KeyParams.Nonce() == m_cipherNonce)
+		{
+			throw CryptoSymmetricCipherException("ChaCha20Poly1305:Initialize", "The nonce can not be zeroised or repeating!");
+		}
+		if (!m_streamCipher->IsInitialized())
+		{
+			throw CryptoSymmetricCipherException("ChaCha20Poly1305:Initialize", "First initialization requires a key and nonce!");
+		}
+	}
+	else
+	{
+		if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+		{
+			throw CryptoSymmetricCipherException("ChaCha20Poly1305:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
+		}
+
+		m_cipherKey = KeyParams.Key();
+	}
+
+	m_isEncryption = Encryption;
+	m_cipherNonce = KeyParams.Nonce();
+
+	// the trailing 8 nonce bytes are the chacha nonce, the leading 4 bytes are the high word of the block counter
+	std::vector<byte> tmpN(m_cipherNonce.begin() + 4, m_cipherNonce.end());
+	m_streamCipher->Initialize(Key::Symmetric::SymmetricKey(m_cipherKey, tmpN));
+	m_streamCipher->Counter()[0] = 0;
+	m_streamCipher->Counter()[1] = Utility::IntUtils::LeBytesTo32(m_cipherNonce, 0);
+
+	// key-stream block 0 is the one-time poly1305 key, the message is encrypted from block 1
+	const std::vector<byte> ZEROES(STREAM_BLOCK);
+	std::vector<byte> tmpK(STREAM_BLOCK);
+	m_streamCipher->Transform(ZEROES, 0, tmpK, 0, STREAM_BLOCK);
+	tmpK.resize(KEY_SIZE);
+	m_macGenerator->Initialize(Key::Symmetric::SymmetricKey(tmpK));
+	Utility::MemUtils::Clear(tmpK, 0, tmpK.size());
+
+	m_keyOffset = STREAM_BLOCK;
+	m_msgSize = 0;
+
+	if (m_isFinalized)
+	{
+		Utility::MemUtils::Clear(m_msgTag, 0, m_msgTag.size());
+		m_isFinalized = false;
+	}
+
+	m_isInitialized = true;
+}
+
+void ChaCha20Poly1305::ParallelMaxDegree(size_t Degree)
+{
+	m_streamCipher->ParallelMaxDegree(Degree);
+}
+
+void ChaCha20Poly1305::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(!m_aadLoaded, "The associated data has already been set");
+	CexAssert(m_msgSize == 0, "The associated data must be set before the message is processed");
+
+	m_aadData.resize(Length);
+	Utility::MemUtils::Copy(Input, Offset, m_aadData, 0, Length);
+	m_macGenerator->Update(Input, Offset, Length);
+	PadMac(Length);
+
+	m_aadSize = Length;
+	m_aadLoaded = true;
+}
+
+void ChaCha20Poly1305::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
+
+	Process(Input.data() + InOffset, Output.data() + OutOffset, Length);
+}
+
+void ChaCha20Poly1305::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+
+	Process(Input, Output, Length);
+}
+
+bool ChaCha20Poly1305::Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
+{
+	CexAssert(!m_isEncryption, "the cipher mode has not been initialized for decryption");
+	CexAssert(Length >= MIN_TAGSIZE && Length <= BLOCK_SIZE, "the length must be minimum of 12 and maximum of MAC code size");
+	CexAssert(!(!m_isInitialized && !m_isFinalized), "the cipher mode has not been initialized for decryption");
+
+	if (!m_isFinalized)
+	{
+		CalculateMac();
+	}
+
+	return Utility::IntUtils::Compare(m_msgTag, 0, Input, Offset, Length);
+}
+
+//~~~Private Functions~~~//
+
+void ChaCha20Poly1305::CalculateMac()
+{
+	std::vector<byte> mlen(BLOCK_SIZE);
+
+	PadMac(static_cast<size_t>(m_msgSize % BLOCK_SIZE));
+	Utility::IntUtils::Le64ToBytes(static_cast<ulong>(m_aadSize), mlen, 0);
+	Utility::IntUtils::Le64ToBytes(m_msgSize, mlen, 8);
+	m_macGenerator->Update(mlen, 0, mlen.size());
+	m_macGenerator->Finalize(m_msgTag, 0);
+	Reset();
+
+	if (m_autoIncrement)
+	{
+		std::vector<byte> tmpN = m_cipherNonce;
+		Utility::IntUtils::BeIncrement8(tmpN);
+		std::vector<byte> zero(0);
+		Initialize(m_isEncryption, Key::Symmetric::SymmetricKey(zero, tmpN));
+
+		if (m_aadPreserve)
+		{
+			m_macGenerator->Update(m_aadData, 0, m_aadData.size());
+			PadMac(m_aadData.size());
+		}
+	}
+
+	m_isFinalized = true;
+}
+
+void ChaCha20Poly1305::PadMac(size_t Length)
+{
+	const size_t PADLEN = (BLOCK_SIZE - (Length % BLOCK_SIZE)) % BLOCK_SIZE;
+
+	if (PADLEN != 0)
+	{
+		const std::vector<byte> ZEROES(BLOCK_SIZE);
+		m_macGenerator->Update(ZEROES, 0, PADLEN);
+	}
+}
+
+void ChaCha20Poly1305::Process(const byte* Input, byte* Output, size_t Length)
+{
+	if (m_msgSize + Length > MAX_MSGSIZE)
+	{
+		throw CryptoCipherModeException("ChaCha20Poly1305:Transform", "The message exceeds the 2^32 block limit of a single nonce!");
+	}
+
+	size_t prcLen = 0;
+
+	if (m_keyOffset != STREAM_BLOCK && Length != 0)
+	{
+		// use the key-stream remaining from the last partial block
+		const size_t RMDLEN = Utility::IntUtils::Min(STREAM_BLOCK - m_keyOffset, Length);
+
+		if (!m_isEncryption)
+		{
+			m_macGenerator->Update(Input, RMDLEN);
+		}
+
+		for (size_t i = 0; i < RMDLEN; ++i)
+		{
+			Output[i] = Input[i] ^ m_keyStream[m_keyOffset + i];
+		}
+
+		if (m_isEncryption)
+		{
+			m_macGenerator->Update(Output, RMDLEN);
+		}
+
+		m_keyOffset += RMDLEN;
+		prcLen = RMDLEN;
+	}
+
+	const size_t ALNLEN = prcLen + (((Length - prcLen) / STREAM_BLOCK) * STREAM_BLOCK);
+	// a segment is authenticated directly after it is transformed, while it is still in cache; parallel sized input is left to the multi-threaded cipher
+	const size_t SEGLEN = (m_streamCipher->IsParallel() && ALNLEN - prcLen >= m_streamCipher->ParallelBlockSize()) ? m_streamCipher->ParallelBlockSize() : SEGMENT_SIZE;
+
+	while (prcLen != ALNLEN)
+	{
+		const size_t BLKLEN = Utility::IntUtils::Min(SEGLEN, ALNLEN - prcLen);
+
+		if (m_isEncryption)
+		{
+			m_streamCipher->Transform(Input + prcLen, Output + prcLen, BLKLEN);
+			m_macGenerator->Update(Output + prcLen, BLKLEN);
+		}
+		else
+		{
+			m_macGenerator->Update(Input + prcLen, BLKLEN);
+			m_streamCipher->Transform(Input + prcLen, Output + prcLen, BLKLEN);
+		}
+
+		prcLen += BLKLEN;
+	}
+
+	if (prcLen != Length)
+	{
+		// generate a block of key-stream, the unused bytes are carried to the next call
+		const size_t RMDLEN = Length - prcLen;
+		const std::vector<byte> ZEROES(STREAM_BLOCK);
+		m_streamCipher->Transform(ZEROES, 0, m_keyStream, 0, STREAM_BLOCK);
+
+		if (!m_isEncryption)
+		{
+			m_macGenerator->Update(Input + prcLen, RMDLEN);
+		}
+
+		for (size_t i = 0; i < RMDLEN; ++i)
+		{
+			Output[prcLen + i] = Input[prcLen + i] ^ m_keyStream[i];
+		}
+
+		if (m_isEncryption)
+		{
+			m_macGenerator->Update(Output + prcLen, RMDLEN);
+		}
+
+		m_keyOffset = RMDLEN;
+	}
+
+	m_msgSize += Length;
+}
+
+void ChaCha20Poly1305::Reset()
+{
+	if (!m_aadPreserve)
+	{
+		if (m_aadSize != 0)
+		{
+			Utility::MemUtils::Clear(m_aadData, 0, m_aadData.size());
+		}
+
+		m_aadLoaded = false;
+		m_aadSize = 0;
+	}
+
+	m_isInitialized = false;
+	m_keyOffset = STREAM_BLOCK;
+	Utility::MemUtils::Clear(m_keyStream, 0, m_keyStream.size());
+	m_msgSize = 0;
+}
+
+NAMESPACE_MODEEND
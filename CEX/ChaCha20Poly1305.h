@@ -0,0 +1,417 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// An implementation of the ChaCha20 and Poly1305 authenticated encryption mode (ChaCha20Poly1305).
+// Contact: develop@vtdev.com
+
+#ifndef CEX_CHACHA20POLY1305_H
+#define CEX_CHACHA20POLY1305_H
+
+#include "IAeadMode.h"
+#include "ChaCha20.h"
+#include "Poly1305.h"
+
+NAMESPACE_MODE
+
+/// <summary>
+/// The ChaCha20 and Poly1305 Authenticated Encryption Mode (RFC 8439)
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting a message:</description>
+/// <code>
+/// ChaCha20Poly1305 cipher;
+/// // initialize for encryption with a 32 byte key and 12 byte nonce
+/// cipher.Initialize(true, SymmetricKey(Key, Nonce));
+/// // add the associated data
+/// cipher.SetAssociatedData(Data, 0, Data.size());
+/// // encrypt the message
+/// cipher.Transform(Input, 0, Output, 0, Input.size());
+/// // append the mac code to the output
+/// cipher.Finalize(Output, Input.size(), cipher.MaxTagSize());
+/// </code>
+/// </example>
+///
+/// <example>
+/// <description>Decrypting a message:</description>
+/// <code>
+/// ChaCha20Poly1305 cipher;
+/// // initialize for decryption
+/// cipher.Initialize(false, SymmetricKey(Key, Nonce));
+/// cipher.SetAssociatedData(Data, 0, Data.size());
+/// // the mac code is the last 16 bytes of the cipher-text
+/// size_t decLen = Input.size() - cipher.MaxTagSize();
+/// cipher.Transform(Input, 0, Output, 0, decLen);
+/// // generate the internal mac code and compare it
+/// if (!cipher.Verify(Input, decLen, cipher.MaxTagSize()))
+///		throw;
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>
+/// ChaCha20Poly1305 is an Authenticate Encrypt and Additional Data (AEAD) authenticated mode, combining the ChaCha20 stream cipher with the Poly1305 one-time authenticator. \n
+/// The mode is an online mode, messages of any size can be streamed without knowing the message size in advance. \n
+/// The first block of key-stream generated with the key and nonce is used as the one-time Poly1305 key, the message is encrypted with the key-stream beginning at block counter 1. \n
+/// The Verify(Input, Offset, Length) function can be used to compare the MAC code embedded in the cipher-text with the code generated during the decryption process. \n
+/// The Finalize(Output, Offset, Length) function writes the MAC code to an output stream in either encryption or decryption operation modes.
+/// </para>
+///
+/// <description><B>Description:</B></description>
+/// <para><EM>Legend:</EM> \n
+/// <B>K</B>=key, <B>N</B>=nonce, <B>A</B>=associated data, <B>P</B>=plain-text, <B>C</B>=cipher-text, <B>E</B>=ChaCha20, <B>M</B>=Poly1305, <B>||</B>=concatenate, <B>T</B>=mac code</para>
+/// <para><EM>Encryption</EM> \n
+/// 1) Kp = E(K, N, 0)[0...31]. \n
+/// 2) C = P ^ E(K, N, 1...n). \n
+/// 3) T = M(Kp, A || pad16(A) || C || pad16(C) || len(A) || len(C)). CT = C||T. \n
+/// <EM>Decryption</EM> \n
+/// Generates T over the cipher-text then decrypts, P = C ^ E(K, N, 1...n).</para>
+///
+/// <description><B>Multi-Threading:</B></description>
+/// <para>The key-stream is generated by the ChaCha20 wide (SIMD) kernels, and when IsParallel() is true, input of at least ParallelBlockSize() bytes is encrypted across multiple threads. \n
+/// The input is processed in segments; each segment is encrypted and then authenticated while it is still resident in the data cache, so the message is passed over once, rather than once by the cipher and again by the authenticator. \n
+/// The parallel profile is shared with the ChaCha20 instance, and changes must be made before the Initialize(bool, ISymmetricKey) function is called.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The key must be 32 bytes, and the nonce 12 bytes in length.</description></item>
+/// <item><description>The nonce is loaded as the three final state words, with a 32 bit block counter; a transform that would take a single message past 2^38 - 64 bytes throws.</description></item>
+/// <item><description>Additional data can be added using the SetAssociatedData(Input, Offset, Length) call, before any message input is processed.</description></item>
+/// <item><description>Transform calls need not be aligned to the ChaCha20 block size; unused key-stream is carried over to the next call.</description></item>
+/// <item><description>The input and output of a transform can not overlap.</description></item>
+/// <item><description>Calling the Finalize(Output, Offset, Length) function writes the MAC code to the output array in either encryption or decryption operation mode.</description></item>
+/// <item><description>The Verify(Input, Offset, Length) function can be used to compare the MAC code embedded with the cipher-text to the internal MAC code generated after a Decryption cycle.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>RFC 8439: <a href="https://tools.ietf.org/html/rfc8439">ChaCha20 and Poly1305 for IETF Protocols</a>.</description></item>
+/// <item><description>ChaCha20 <a href="http://cr.yp.to/chacha/chacha-20080128.pdf">Specification</a>.</description></item>
+/// <item><description>The Poly1305-AES <a href="http://cr.yp.to/mac/poly1305-20050329.pdf">Message Authentication Code</a>.</description></item>
+/// </list>
+/// </remarks>
+class ChaCha20Poly1305 final : public IAeadMode
+{
+private:
+
+	static const size_t BLOCK_SIZE = 16;
+	static const std::string CLASS_NAME;
+	static const size_t KEY_SIZE = 32;
+	// 2^32 key-stream blocks per nonce, less the block used as the poly1305 key
+	static const ulong MAX_MSGSIZE = 274877906880;
+	static const size_t MIN_TAGSIZE = 12;
+	static const size_t NONCE_SIZE = 12;
+	static const size_t SEGMENT_SIZE = 4096;
+	static const size_t STREAM_BLOCK = 64;
+
+	std::vector<byte> m_aadData;
+	bool m_aadLoaded;
+	bool m_aadPreserve;
+	size_t m_aadSize;
+	bool m_autoIncrement;
+	std::vector<byte> m_cipherKey;
+	std::vector<byte> m_cipherNonce;
+	bool m_isDestroyed;
+	bool m_isEncryption;
+	bool m_isFinalized;
+	bool m_isInitialized;
+	size_t m_keyOffset;
+	std::vector<byte> m_keyStream;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	std::unique_ptr<Mac::Poly1305> m_macGenerator;
+	ulong m_msgSize;
+	std::vector<byte> m_msgTag;
+	std::unique_ptr<Stream::ChaCha20> m_streamCipher;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	ChaCha20Poly1305(const ChaCha20Poly1305&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	ChaCha20Poly1305& operator=(const ChaCha20Poly1305&) = delete;
+
+	/// <summary>
+	/// Initialize the Cipher Mode.
+	/// <para>The ChaCha20 and Poly1305 instances are created and destroyed automatically.</para>
+	/// </summary>
+	ChaCha20Poly1305();
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~ChaCha20Poly1305() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read/Write: Enable auto-incrementing of the input nonce, each time the Finalize method is called.
+	/// <para>Treats the Nonce value loaded during Initialize as a monotonic counter;
+	/// incrementing the value by 1 and re-calculating the working set each time the cipher is finalized.
+	/// If set to false, requires a re-key after each finalizer cycle.</para>
+	/// </summary>
+	bool &AutoIncrement() override;
+
+	/// <summary>
+	/// Read Only: The Poly1305 block size in bytes
+	/// </summary>
+	const size_t BlockSize() override;
+
+	/// <summary>
+	/// Read Only: The block ciphers formal type name; this mode does not use a block cipher and returns None
+	/// </summary>
+	const BlockCiphers CipherType() override;
+
+	/// <summary>
+	/// Read Only: The underlying Block Cipher instance; this mode does not use a block cipher and returns a null pointer
+	/// </summary>
+	IBlockCipher* Engine() override;
+
+	/// <summary>
+	/// Read Only: The Cipher Modes enumeration type name
+	/// </summary>
+	const CipherModes Enumeral() override;
+
+	/// <summary>
+	/// Read Only: True if initialized for encryption, False for decryption
+	/// </summary>
+	const bool IsEncryption() override;
+
+	/// <summary>
+	/// Read Only: The cipher is ready to transform data
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available with this mode.
+	/// If parallel capable, input/output data arrays passed to the transform must be ParallelBlockSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Read Only: Array of allowed cipher input key byte-sizes
+	/// </summary>
+	const std::vector<SymmetricKeySize> &LegalKeySizes() override;
+
+	/// <summary>
+	/// Read Only: The maximum legal tag length in bytes
+	/// </summary>
+	const size_t MaxTagSize() override;
+
+	/// <summary>
+	/// Read Only: The minimum legal tag length in bytes
+	/// </summary>
+	const size_t MinTagSize() override;
+
+	/// <summary>
+	/// Read Only: The cipher mode name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input/output data arrays passed to a transform that trigger parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.</para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Read/Write: Parallel and SIMD capability flags and sizes
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree() property.
+	/// The ParallelBlockSize() property is auto-calculated, but can be changed; the value must be evenly divisible by ParallelMinimumSize().
+	/// Changes to these values must be made before the <see cref="Initialize(SymmetricKey)"/> function is called.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	/// <summary>
+	/// Read/Write: Persist a one-time associated data for the entire session.
+	/// <para>Allows the use of a single SetAssociatedData() call to apply the MAC data to all segments.
+	/// Finalize and Verify can be called multiple times, applying the initial associated data to each finalize cycle.</para>
+	/// </summary>
+	bool &PreserveAD() override;
+
+	/// <summary>
+	/// Read Only: Returns the full finalized MAC code value array
+	/// </summary>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher has not been finalized</exception>
+	const std::vector<byte> Tag() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Decrypt a single block of bytes.
+	/// <para>Decrypts one block of bytes beginning at a zero index.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	void DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Decrypt a block of bytes with offset parameters.
+	/// <para>Decrypts one block of bytes using the designated offsets.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Encrypt a single block of bytes.
+	/// <para>Encrypts one block of bytes beginning at a zero index.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	void EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Encrypt a block of bytes using offset parameters.
+	/// <para>Encrypts one block of bytes using the designated offsets.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Calculate the MAC code (Tag) and copy it to the Output array.
+	/// <para>The output array must be of sufficient length to receive the MAC code.
+	/// This function finalizes the Encryption/Decryption cycle, all data must be processed before this function is called.
+	/// Initialize(bool, ISymmetricKey) must be called before the cipher can be re-used.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The output array that receives the authentication code</param>
+	/// <param name="Offset">Starting offset within the output array</param>
+	/// <param name="Length">The number of MAC code bytes to write to the output array.
+	/// <para>Must be no greater then the MAC functions output size, and no less than the minimum Tag size of 12 bytes.</para></param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized, or output array is too small</exception>
+	void Finalize(std::vector<byte> &Output, const size_t Offset, const size_t Length) override;
+
+	/// <summary>
+	/// Initialize the Cipher instance.
+	/// <para>The key must be 32 bytes and the nonce 12 bytes in length.
+	/// After the first initialization, the cipher can be re-initialized with a new nonce and an empty key, re-using the existing key.</para>
+	/// </summary>
+	///
+	/// <param name="Encryption">True if cipher is used for encryption, false to decrypt</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce</param>
+	///
+	/// <exception cref="CryptoSymmetricCipherException">Thrown if a null or invalid Key/Nonce is used</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams) override;
+
+	/// <summary>
+	/// Set the maximum number of threads allocated when using multi-threaded processing.
+	/// <para>When set to zero, thread count is set automatically. If set to 1, sets IsParallel() to false and runs in sequential mode.
+	/// Thread count must be an even number, and not exceed the number of processor cores.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Add additional data to the authentication generator.
+	/// <para>Must be called after Initialize(bool, ISymmetricKey), and before any processing of plaintext or ciphertext input.
+	/// This function can only be called once per each initialization/finalization cycle.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes to process</param>
+	/// <param name="Offset">Starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to process</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized</exception>
+	void SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length) override;
+
+	/// <summary>
+	/// Transform a length of bytes with offset parameters.
+	/// <para>This method processes a specified length of bytes, utilizing offsets incremented by the caller.
+	/// If IsParallel() is set to true, and the length is at least ParallelBlockSize(), the transform is run in parallel processing mode.
+	/// To disable parallel processing, set the ParallelOptions().IsParallel() property to false.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes to transform</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of transformed bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the message exceeds the maximum length of a single nonce</exception>
+	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
+
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and can not overlap.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the message exceeds the maximum length of a single nonce</exception>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
+	/// <summary>
+	/// Generate the internal MAC code and compare it with the tag contained in the Input array.
+	/// <para>This function finalizes the Decryption cycle and generates the MAC tag.
+	/// The cipher must be set for Decryption and the cipher-text bytes fully processed before calling this function.
+	/// Verify can be called in place of a Finalize(Output, Offset, Length) call, or after finalization.
+	/// Initialize(bool, ISymmetricKey) must be called before the cipher can be re-used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array containing the expected authentication code</param>
+	/// <param name="Offset">Starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to compare.
+	/// <para>Must be no greater then the MAC functions output size, and no less than the MinTagSize() size.</para></param>
+	///
+	/// <returns>Returns false if the MAC code does not match</returns>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized for decryption</exception>
+	bool Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length) override;
+
+private:
+
+	void CalculateMac();
+	void PadMac(size_t Length);
+	void Process(const byte* Input, byte* Output, size_t Length);
+	void Reset();
+};
+
+NAMESPACE_MODEEND
+#endif
@@ -5,6 +5,7 @@
 #include "CFB.h"
 #include "ICM.h"
 #include "OFB.h"
+#include "XTS.h"
 
 NAMESPACE_HELPER
 
@@ -43,6 +44,11 @@ ICipherMode* CipherModeFromName::GetInstance(CipherModes CipherType, IBlockCiphe
 				mdePtr = new OFB(Engine);
 				break;
 			}
+			case Enumeration::CipherModes::XTS:
+			{
+				mdePtr = new XTS(Engine);
+				break;
+			}
 			default:
 			{
 				throw CryptoException("CipherModeFromName:GetInstance", "The cipher mode is not supported!");
@@ -93,6 +99,11 @@ ICipherMode* CipherModeFromName::GetInstance(CipherModes CipherType, BlockCipher
 				mdePtr = new OFB(cprPtr);
 				break;
 			}
+			case Enumeration::CipherModes::XTS:
+			{
+				mdePtr = new XTS(cprPtr);
+				break;
+			}
 			default:
 			{
 				if (cprPtr != nullptr)
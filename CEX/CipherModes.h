@@ -49,7 +49,15 @@ enum class CipherModes : byte
 	/// <summary>
 	/// Output FeedBack Mode
 	/// </summary>
-	OFB = 9
+	OFB = 9,
+	/// <summary>
+	/// ChaCha20 and Poly1305 AEAD Mode (RFC 8439)
+	/// </summary>
+	ChaCha20Poly1305 = 10,
+	/// <summary>
+	/// XEX-based Tweaked-codebook mode with ciphertext Stealing (IEEE 1619)
+	/// </summary>
+	XTS = 11
 };
 
 NAMESPACE_ENUMERATIONEND
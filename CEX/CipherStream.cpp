@@ -3,6 +3,10 @@
 #include "CipherModeFromName.h"
 #include "PaddingFromName.h"
 #include "StreamCipherFromName.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 NAMESPACE_PROCESSING
 
@@ -22,6 +26,8 @@ CipherStream::CipherStream(BlockCiphers CipherType, Digests KdfEngine, int Round
 	m_isParallel(false),
 	m_isStreamCipher(false),
 	m_legalKeySizes(0),
+	m_pipelineDepth(0),
+	m_progressCounter(),
 	m_streamCipher(nullptr)
 {
 	Scope();
@@ -39,6 +45,8 @@ CipherStream::CipherStream(StreamCiphers CipherType, size_t RoundCount)
 	m_isParallel(false),
 	m_isStreamCipher(true),
 	m_legalKeySizes(0),
+	m_pipelineDepth(0),
+	m_progressCounter(),
 	m_streamCipher(CipherType != StreamCiphers::None ? GetStreamCipher(CipherType, RoundCount) :
 		throw CryptoProcessingException("CipherStream:CTor", "The stream cipher is not recognized!"))
 {
@@ -62,6 +70,8 @@ CipherStream::CipherStream(CipherDescription* Header)
 	m_isInitialized(false),
 	m_isParallel(false),
 	m_legalKeySizes(0),
+	m_pipelineDepth(0),
+	m_progressCounter(),
 	m_streamCipher(nullptr)
 {
 	m_isStreamCipher = false;
@@ -82,6 +92,8 @@ CipherStream::CipherStream(ICipherMode* Cipher, IPadding* Padding)
 	m_isStreamCipher(false),
 	m_isParallel(false),
 	m_legalKeySizes(0),
+	m_pipelineDepth(0),
+	m_progressCounter(),
 	m_streamCipher(nullptr)
 {
 	Scope();
@@ -100,6 +112,8 @@ CipherStream::CipherStream(IStreamCipher* Cipher)
 	m_isParallel(false),
 	m_isStreamCipher(true),
 	m_legalKeySizes(0),
+	m_pipelineDepth(0),
+	m_progressCounter(),
 	m_streamCipher(Cipher != nullptr ? Cipher : 
 		throw CryptoProcessingException("CipherStream:CTor", "The Cipher can not be null!"))
 {
@@ -116,6 +130,7 @@ CipherStream::~CipherStream()
 		m_isInitialized = false;
 		m_isParallel = false;
 		m_isStreamCipher = false;
+		m_pipelineDepth = 0;
 		Utility::IntUtils::ClearVector(m_legalKeySizes);
 
 		if (m_destroyEngine)
@@ -196,6 +211,16 @@ ParallelOptions &CipherStream::ParallelProfile()
 	}
 }
 
+size_t &CipherStream::PipelineDepth()
+{
+	return m_pipelineDepth;
+}
+
+ProgressCounter &CipherStream::Progress()
+{
+	return m_progressCounter;
+}
+
 //~~~Public Functions~~~//
 
 void CipherStream::Initialize(bool Encryption, ISymmetricKey &KeyParams)
@@ -250,7 +275,26 @@ void CipherStream::Write(IByteStream* InStream, IByteStream* OutStream)
 	CexAssert(InStream->CanRead(), "the Input stream is set to write only!");
 	CexAssert(OutStream->CanRead() || OutStream->CanWrite(), "the Output stream is to read only!");
 
-	if (!m_isStreamCipher)
+	m_progressCounter.Reset(InStream->Length() - InStream->Position());
+
+	if (InStream->Enumeral() == Enumeration::StreamModes::MappedFileStream && OutStream->Enumeral() == Enumeration::StreamModes::MappedFileStream &&
+		static_cast<MappedFileStream*>(InStream)->FileName() != static_cast<MappedFileStream*>(OutStream)->FileName())
+	{
+		MappedTransform(static_cast<MappedFileStream*>(InStream), static_cast<MappedFileStream*>(OutStream));
+	}
+	else if (InStream->Enumeral() == Enumeration::StreamModes::AsyncFileStream && OutStream->Enumeral() == Enumeration::StreamModes::AsyncFileStream &&
+		static_cast<AsyncFileStream*>(InStream)->FileName() != static_cast<AsyncFileStream*>(OutStream)->FileName() &&
+		(!static_cast<AsyncFileStream*>(InStream)->IsDirect() || InStream->Position() % static_cast<AsyncFileStream*>(InStream)->Alignment() == 0) &&
+		(!static_cast<AsyncFileStream*>(OutStream)->IsDirect() || OutStream->Position() % static_cast<AsyncFileStream*>(OutStream)->Alignment() == 0))
+	{
+		AsyncTransform(static_cast<AsyncFileStream*>(InStream), static_cast<AsyncFileStream*>(OutStream));
+	}
+	else if (InStream->Enumeral() == Enumeration::StreamModes::SegmentedStream && InStream != OutStream && InStream->Position() % SEGALN == 0 &&
+		(OutStream->Enumeral() != Enumeration::StreamModes::SegmentedStream || OutStream->Position() % SEGALN == 0))
+	{
+		SegmentedTransform(static_cast<SegmentedStream*>(InStream), OutStream);
+	}
+	else if (!m_isStreamCipher)
 	{
 		BlockTransform(InStream, OutStream);
 	}
@@ -271,6 +315,8 @@ void CipherStream::Write(const std::vector<byte> &Input, size_t InOffset, std::v
 	CexAssert(Input.size() - InOffset > 0, "the input array is too short");
 	CexAssert(Input.size() - InOffset <= Output.size() - OutOffset, "the output array is too short!");
 
+	m_progressCounter.Reset(Input.size() - InOffset);
+
 	if (!m_isStreamCipher)
 	{
 		BlockTransform(Input, InOffset, Output, OutOffset);
@@ -283,6 +329,148 @@ void CipherStream::Write(const std::vector<byte> &Input, size_t InOffset, std::v
 
 //~~~Private Functions~~~//
 
+void CipherStream::AsyncTransform(AsyncFileStream* InStream, AsyncFileStream* OutStream)
+{
+	const size_t INPLEN = static_cast<size_t>(InStream->Length() - InStream->Position());
+	const size_t BLKLEN = m_isStreamCipher ? m_streamCipher->BlockSize() : m_cipherEngine->BlockSize();
+	// whole blocks are transformed through the request queues, the tail and padding take the stream path
+	const size_t PRCLEN = (m_isStreamCipher || m_isCounterMode || m_isEncryption) ? (INPLEN / BLKLEN) * BLKLEN : (INPLEN < BLKLEN) ? 0 : ((INPLEN / BLKLEN) * BLKLEN) - BLKLEN;
+	const size_t CHKLEN = InStream->ChunkSize();
+	const size_t CHKCNT = (PRCLEN + CHKLEN - 1) / CHKLEN;
+	const size_t RNGLEN = Utility::IntUtils::Min(Utility::IntUtils::Min(InStream->QueueDepth(), OutStream->QueueDepth()), CHKCNT);
+	const ulong INPPOS = InStream->Position();
+	const ulong OUTPOS = OutStream->Position();
+
+	if (PRCLEN != 0)
+	{
+		std::vector<std::vector<byte>> inpStore(RNGLEN);
+		std::vector<std::vector<byte>> outStore(RNGLEN);
+		std::vector<byte*> inpRing(RNGLEN);
+		std::vector<byte*> outRing(RNGLEN);
+		std::vector<size_t> rdTicket(RNGLEN, 0);
+		std::vector<size_t> wrTicket(RNGLEN, 0);
+		size_t rdCtr = 0;
+
+		// the requests bypass the stream buffers, so buffered data is written first
+		InStream->Flush();
+		OutStream->Flush();
+
+		for (size_t i = 0; i < RNGLEN; ++i)
+		{
+			inpRing[i] = AsyncFileStream::AlignBuffer(inpStore[i], CHKLEN);
+			outRing[i] = AsyncFileStream::AlignBuffer(outStore[i], CHKLEN);
+		}
+
+		try
+		{
+			// fill the ring with reads, then refill each slot as its chunk is transformed
+			for (; rdCtr < RNGLEN; ++rdCtr)
+			{
+				rdTicket[rdCtr] = InStream->QueueRead(inpRing[rdCtr], Utility::IntUtils::Min(CHKLEN, PRCLEN - (rdCtr * CHKLEN)), INPPOS + (rdCtr * CHKLEN));
+			}
+
+			InStream->Submit();
+
+			for (size_t i = 0; i < CHKCNT; ++i)
+			{
+				const size_t RNGIDX = i % RNGLEN;
+				const size_t CPYLEN = Utility::IntUtils::Min(CHKLEN, PRCLEN - (i * CHKLEN));
+				const size_t RDLEN = InStream->Wait(rdTicket[RNGIDX]);
+
+				rdTicket[RNGIDX] = 0;
+
+				if (RDLEN < CPYLEN)
+				{
+					throw CryptoProcessingException("CipherStream:AsyncTransform", "The input file is shorter than the stream length!");
+				}
+
+				if (wrTicket[RNGIDX] != 0)
+				{
+					OutStream->Wait(wrTicket[RNGIDX]);
+					wrTicket[RNGIDX] = 0;
+				}
+
+				if (m_isStreamCipher)
+				{
+					m_streamCipher->Transform(inpRing[RNGIDX], outRing[RNGIDX], CPYLEN);
+				}
+				else
+				{
+					m_cipherEngine->Transform(inpRing[RNGIDX], outRing[RNGIDX], CPYLEN);
+				}
+
+				wrTicket[RNGIDX] = OutStream->QueueWrite(outRing[RNGIDX], CPYLEN, OUTPOS + (i * CHKLEN));
+				OutStream->Submit();
+
+				if (rdCtr != CHKCNT)
+				{
+					rdTicket[RNGIDX] = InStream->QueueRead(inpRing[RNGIDX], Utility::IntUtils::Min(CHKLEN, PRCLEN - (rdCtr * CHKLEN)), INPPOS + (rdCtr * CHKLEN));
+					InStream->Submit();
+					++rdCtr;
+				}
+
+				m_progressCounter.Add(CPYLEN);
+			}
+
+			for (size_t i = 0; i < RNGLEN; ++i)
+			{
+				if (wrTicket[i] != 0)
+				{
+					OutStream->Wait(wrTicket[i]);
+					wrTicket[i] = 0;
+				}
+			}
+		}
+		catch (...)
+		{
+			// the kernel still holds the ring buffers, every outstanding request completes before they are released
+			for (size_t i = 0; i < RNGLEN; ++i)
+			{
+				try
+				{
+					if (rdTicket[i] != 0)
+					{
+						InStream->Wait(rdTicket[i]);
+					}
+				}
+				catch (...)
+				{
+					// a failed request has completed, the original exception is the one reported
+				}
+
+				try
+				{
+					if (wrTicket[i] != 0)
+					{
+						OutStream->Wait(wrTicket[i]);
+					}
+				}
+				catch (...)
+				{
+					// a failed request has completed, the original exception is the one reported
+				}
+			}
+
+			throw;
+		}
+
+		InStream->Seek(INPPOS + PRCLEN, IO::SeekOrigin::Begin);
+		OutStream->Seek(OUTPOS + PRCLEN, IO::SeekOrigin::Begin);
+	}
+
+	if (INPLEN != PRCLEN)
+	{
+		if (m_isStreamCipher)
+		{
+			StreamTransform(InStream, OutStream);
+		}
+		else
+		{
+			BlockTransform(InStream, OutStream);
+		}
+	}
+}
+
 void CipherStream::BlockTransform(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset)
 {
 	const size_t INPLEN = Input.size() - InOffset;
@@ -301,7 +489,7 @@ void CipherStream::BlockTransform(const std::vector<byte> &Input, size_t InOffse
 				InOffset += PRLBLK;
 				OutOffset += PRLBLK;
 				prcLen += PRLBLK;
-				CalculateProgress(INPLEN, InOffset);
+				m_progressCounter.Add(PRLBLK);
 			}
 		}
 	}
@@ -309,7 +497,7 @@ void CipherStream::BlockTransform(const std::vector<byte> &Input, size_t InOffse
 	const size_t BLKLEN = m_cipherEngine->BlockSize();
 	const size_t ALNLEN = (m_isCounterMode || m_isEncryption) ? (INPLEN / BLKLEN) * BLKLEN : (INPLEN < BLKLEN) ? 0 : ((INPLEN / BLKLEN) * BLKLEN) - BLKLEN;
 
-	if (INPLEN > BLKLEN)
+	if (INPLEN >= BLKLEN)
 	{
 		while (prcLen != ALNLEN)
 		{
@@ -317,7 +505,7 @@ void CipherStream::BlockTransform(const std::vector<byte> &Input, size_t InOffse
 			InOffset += BLKLEN;
 			OutOffset += BLKLEN;
 			prcLen += BLKLEN;
-			CalculateProgress(INPLEN, InOffset);
+			m_progressCounter.Add(BLKLEN);
 		}
 	}
 
@@ -368,7 +556,7 @@ void CipherStream::BlockTransform(const std::vector<byte> &Input, size_t InOffse
 		}
 	}
 
-	CalculateProgress(INPLEN, InOffset);
+	m_progressCounter.Add(INPLEN - ALNLEN);
 }
 
 void CipherStream::BlockTransform(IByteStream* InStream, IByteStream* OutStream)
@@ -379,7 +567,17 @@ void CipherStream::BlockTransform(IByteStream* InStream, IByteStream* OutStream)
 	std::vector<byte> inpBuffer(0);
 	std::vector<byte> outBuffer(0);
 
-	if (m_isParallel)
+	if (m_pipelineDepth > 1 && InStream != OutStream)
+	{
+		const size_t PRLBLK = m_cipherEngine->ParallelBlockSize();
+		if (INPLEN > PRLBLK)
+		{
+			const size_t PRCLEN = (INPLEN % PRLBLK != 0 || m_isCounterMode || m_isEncryption) ? (INPLEN / PRLBLK) * PRLBLK : ((INPLEN / PRLBLK) * PRLBLK) - PRLBLK;
+			PipelineTransform(m_cipherEngine.get(), InStream, OutStream, PRCLEN, PRLBLK);
+			prcLen = PRCLEN;
+		}
+	}
+	else if (m_isParallel)
 	{
 		const size_t PRLBLK = m_cipherEngine->ParallelBlockSize();
 		if (INPLEN > PRLBLK)
@@ -394,7 +592,7 @@ void CipherStream::BlockTransform(IByteStream* InStream, IByteStream* OutStream)
 				m_cipherEngine->Transform(inpBuffer, 0, outBuffer, 0, prcRead);
 				OutStream->Write(outBuffer, 0, prcRead);
 				prcLen += prcRead;
-				CalculateProgress(INPLEN, OutStream->Position());
+				m_progressCounter.Add(prcRead);
 			}
 		}
 	}
@@ -404,7 +602,7 @@ void CipherStream::BlockTransform(IByteStream* InStream, IByteStream* OutStream)
 	inpBuffer.resize(BLKLEN);
 	outBuffer.resize(BLKLEN);
 
-	if (INPLEN > BLKLEN)
+	if (INPLEN >= BLKLEN)
 	{
 		while (prcLen != ALNLEN)
 		{
@@ -412,7 +610,7 @@ void CipherStream::BlockTransform(IByteStream* InStream, IByteStream* OutStream)
 			m_cipherEngine->Transform(inpBuffer, 0, outBuffer, 0, prcRead);
 			OutStream->Write(outBuffer, 0, prcRead);
 			prcLen += prcRead;
-			CalculateProgress(INPLEN, OutStream->Position());
+			m_progressCounter.Add(prcRead);
 		}
 	}
 
@@ -449,7 +647,7 @@ void CipherStream::BlockTransform(IByteStream* InStream, IByteStream* OutStream)
 		}
 	}
 
-	CalculateProgress(INPLEN, OutStream->Position());
+	m_progressCounter.Add(INPLEN - ALNLEN);
 }
 
 void CipherStream::StreamTransform(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset)
@@ -470,7 +668,7 @@ void CipherStream::StreamTransform(const std::vector<byte> &Input, size_t InOffs
 				InOffset += PRLBLK;
 				OutOffset += PRLBLK;
 				prcLen += PRLBLK;
-				CalculateProgress(INPLEN, InOffset);
+				m_progressCounter.Add(PRLBLK);
 			}
 		}
 	}
@@ -478,7 +676,7 @@ void CipherStream::StreamTransform(const std::vector<byte> &Input, size_t InOffs
 	const size_t BLKLEN = m_streamCipher->BlockSize();
 	const size_t ALNLEN = (INPLEN / BLKLEN) * BLKLEN;
 
-	if (INPLEN > BLKLEN)
+	if (INPLEN >= BLKLEN)
 	{
 		while (prcLen != ALNLEN)
 		{
@@ -486,7 +684,7 @@ void CipherStream::StreamTransform(const std::vector<byte> &Input, size_t InOffs
 			InOffset += BLKLEN;
 			OutOffset += BLKLEN;
 			prcLen += BLKLEN;
-			CalculateProgress(INPLEN, InOffset);
+			m_progressCounter.Add(BLKLEN);
 		}
 	}
 
@@ -498,7 +696,7 @@ void CipherStream::StreamTransform(const std::vector<byte> &Input, size_t InOffs
 		prcLen += FNLLEN;
 	}
 
-	CalculateProgress(INPLEN, prcLen);
+	m_progressCounter.Add(INPLEN - ALNLEN);
 }
 
 void CipherStream::StreamTransform(IByteStream* InStream, IByteStream* OutStream)
@@ -509,7 +707,17 @@ void CipherStream::StreamTransform(IByteStream* InStream, IByteStream* OutStream
 	std::vector<byte> inpBuffer(0);
 	std::vector<byte> outBuffer(0);
 
-	if (m_isParallel)
+	if (m_pipelineDepth > 1 && InStream != OutStream)
+	{
+		const size_t PRLBLK = m_streamCipher->ParallelBlockSize();
+		if (INPLEN > PRLBLK)
+		{
+			const size_t PRCLEN = (INPLEN / PRLBLK) * PRLBLK;
+			PipelineTransform(m_streamCipher.get(), InStream, OutStream, PRCLEN, PRLBLK);
+			prcLen = PRCLEN;
+		}
+	}
+	else if (m_isParallel)
 	{
 		const size_t PRLBLK = m_streamCipher->ParallelBlockSize();
 		if (INPLEN > PRLBLK)
@@ -524,7 +732,7 @@ void CipherStream::StreamTransform(IByteStream* InStream, IByteStream* OutStream
 				m_streamCipher->Transform(inpBuffer, 0, outBuffer, 0, prcRead);
 				OutStream->Write(outBuffer, 0, prcRead);
 				prcLen += prcRead;
-				CalculateProgress(INPLEN, OutStream->Position());
+				m_progressCounter.Add(prcRead);
 			}
 		}
 	}
@@ -534,7 +742,7 @@ void CipherStream::StreamTransform(IByteStream* InStream, IByteStream* OutStream
 	inpBuffer.resize(BLKLEN);
 	outBuffer.resize(BLKLEN);
 
-	if (INPLEN > BLKLEN)
+	if (INPLEN >= BLKLEN)
 	{
 		while (prcLen != ALNLEN)
 		{
@@ -542,7 +750,7 @@ void CipherStream::StreamTransform(IByteStream* InStream, IByteStream* OutStream
 			m_streamCipher->Transform(inpBuffer, 0, outBuffer, 0, prcRead);
 			OutStream->Write(outBuffer, 0, prcRead);
 			prcLen += prcRead;
-			CalculateProgress(INPLEN, OutStream->Position());
+			m_progressCounter.Add(prcRead);
 		}
 	}
 
@@ -556,36 +764,7 @@ void CipherStream::StreamTransform(IByteStream* InStream, IByteStream* OutStream
 		OutStream->Write(outBuffer, 0, prcRead);
 	}
 
-	CalculateProgress(INPLEN, OutStream->Position());
-}
-
-void CipherStream::CalculateProgress(size_t Length, size_t Processed)
-{
-	if (Length >= Processed)
-	{
-		double progress = 100.0 * (static_cast<double>(Processed) / Length);
-		if (progress > 100.0)
-		{
-			progress = 100.0;
-		}
-
-		if (m_isParallel)
-		{
-			ProgressPercent(static_cast<int>(progress));
-		}
-		else
-		{
-			size_t block = Length / 100;
-			if (block == 0)
-			{
-				ProgressPercent(static_cast<int>(progress));
-			}
-			else if (Processed % block == 0)
-			{
-				ProgressPercent(static_cast<int>(progress));
-			}
-		}
-	}
+	m_progressCounter.Add(INPLEN - ALNLEN);
 }
 
 ICipherMode* CipherStream::GetCipherMode(CipherModes ModeType, BlockCiphers CipherType, int BlockSize, int RoundCount, Digests KdfEngine)
@@ -624,6 +803,279 @@ IStreamCipher* CipherStream::GetStreamCipher(StreamCiphers CipherType, size_t Ro
 	}
 }
 
+void CipherStream::MappedTransform(MappedFileStream* InStream, MappedFileStream* OutStream)
+{
+	const size_t INPLEN = static_cast<size_t>(InStream->Length() - InStream->Position());
+	const size_t PRLBLK = m_isStreamCipher ? m_streamCipher->ParallelBlockSize() : m_cipherEngine->ParallelBlockSize();
+	const size_t BLKLEN = m_isStreamCipher ? m_streamCipher->BlockSize() : m_cipherEngine->BlockSize();
+	const ulong OUTPOS = OutStream->Position();
+	// the bulk of the stream is transformed between the mappings, the tail and padding take the stream path
+	const size_t PRCLEN = (m_isStreamCipher || INPLEN % PRLBLK != 0 || m_isCounterMode || m_isEncryption) ? (INPLEN / PRLBLK) * PRLBLK : (INPLEN < PRLBLK) ? 0 : ((INPLEN / PRLBLK) * PRLBLK) - PRLBLK;
+
+	if (PRCLEN != 0)
+	{
+		// padding can add one block, reserving it up front avoids remapping the output during the transform
+		OutStream->Reserve(OUTPOS + INPLEN + BLKLEN);
+
+		const byte* inpPtr = InStream->Pointer() + InStream->Position();
+		byte* outPtr = OutStream->Pointer() + OUTPOS;
+		size_t prcLen = 0;
+
+		while (prcLen != PRCLEN)
+		{
+			if (m_isStreamCipher)
+			{
+				m_streamCipher->Transform(inpPtr + prcLen, outPtr + prcLen, PRLBLK);
+			}
+			else
+			{
+				m_cipherEngine->Transform(inpPtr + prcLen, outPtr + prcLen, PRLBLK);
+			}
+
+			prcLen += PRLBLK;
+			m_progressCounter.Add(PRLBLK);
+		}
+
+		InStream->Seek(PRCLEN, IO::SeekOrigin::Current);
+
+		if (OutStream->Length() < OUTPOS + PRCLEN)
+		{
+			OutStream->SetLength(OUTPOS + PRCLEN);
+		}
+
+		OutStream->Seek(OUTPOS + PRCLEN, IO::SeekOrigin::Begin);
+	}
+
+	if (INPLEN != PRCLEN)
+	{
+		if (m_isStreamCipher)
+		{
+			StreamTransform(InStream, OutStream);
+		}
+		else
+		{
+			BlockTransform(InStream, OutStream);
+		}
+	}
+}
+
+void CipherStream::SegmentedTransform(SegmentedStream* InStream, IByteStream* OutStream)
+{
+	const size_t INPLEN = static_cast<size_t>(InStream->Length() - InStream->Position());
+	const size_t BLKLEN = m_isStreamCipher ? m_streamCipher->BlockSize() : m_cipherEngine->BlockSize();
+	// whole blocks are transformed in place from the segments, the tail and padding take the stream path
+	const size_t PRCLEN = (m_isStreamCipher || m_isCounterMode || m_isEncryption) ? (INPLEN / BLKLEN) * BLKLEN : (INPLEN < BLKLEN) ? 0 : ((INPLEN / BLKLEN) * BLKLEN) - BLKLEN;
+	SegmentedStream* outSeg = (OutStream->Enumeral() == Enumeration::StreamModes::SegmentedStream) ? static_cast<SegmentedStream*>(OutStream) : nullptr;
+	std::vector<byte> outBuffer(outSeg == nullptr ? Utility::IntUtils::Min(InStream->SegmentSize(), PRCLEN) : 0);
+	ulong inpPos = InStream->Position();
+	ulong outPos = OutStream->Position();
+	size_t prcLen = 0;
+
+	if (outSeg != nullptr && outSeg->Length() < outPos + PRCLEN)
+	{
+		outSeg->SetLength(outPos + PRCLEN);
+	}
+
+	while (prcLen != PRCLEN)
+	{
+		size_t inpLen = 0;
+		const byte* inpPtr = InStream->Segment(inpPos, inpLen);
+		size_t cpyLen = Utility::IntUtils::Min(inpLen, PRCLEN - prcLen);
+		byte* outPtr = nullptr;
+
+		if (outSeg != nullptr)
+		{
+			size_t outLen = 0;
+			outPtr = outSeg->Segment(outPos, outLen);
+			cpyLen = Utility::IntUtils::Min(cpyLen, outLen);
+		}
+		else
+		{
+			outPtr = outBuffer.data();
+		}
+
+		if (m_isStreamCipher)
+		{
+			m_streamCipher->Transform(inpPtr, outPtr, cpyLen);
+		}
+		else
+		{
+			m_cipherEngine->Transform(inpPtr, outPtr, cpyLen);
+		}
+
+		if (outSeg == nullptr)
+		{
+			OutStream->Write(outBuffer, 0, cpyLen);
+		}
+
+		inpPos += cpyLen;
+		outPos += cpyLen;
+		prcLen += cpyLen;
+		m_progressCounter.Add(cpyLen);
+	}
+
+	InStream->Seek(inpPos, IO::SeekOrigin::Begin);
+
+	if (outSeg != nullptr)
+	{
+		outSeg->Seek(outPos, IO::SeekOrigin::Begin);
+	}
+
+	if (INPLEN != PRCLEN)
+	{
+		if (m_isStreamCipher)
+		{
+			StreamTransform(InStream, OutStream);
+		}
+		else
+		{
+			BlockTransform(InStream, OutStream);
+		}
+	}
+}
+
+template<typename Cipher>
+void CipherStream::PipelineTransform(Cipher* Engine, IByteStream* InStream, IByteStream* OutStream, size_t Length, size_t ChunkSize)
+{
+	// the reader and writer stages run on their own threads, the transform stage runs on the calling thread;
+	// a chunk moves through the ring as read (rdCtr), transformed (txCtr), and written (wrCtr)
+	const size_t CNKCNT = Length / ChunkSize;
+	const size_t RNGLEN = Utility::IntUtils::Min(m_pipelineDepth, CNKCNT);
+	std::vector<std::vector<byte>> inpRing(RNGLEN, std::vector<byte>(ChunkSize));
+	std::vector<std::vector<byte>> outRing(RNGLEN, std::vector<byte>(ChunkSize));
+	std::condition_variable stageSignal;
+	std::mutex stageMutex;
+	std::exception_ptr stageError = nullptr;
+	bool isAborted = false;
+	size_t rdCtr = 0;
+	size_t txCtr = 0;
+	size_t wrCtr = 0;
+
+	auto abortStage = [&stageSignal, &stageMutex, &stageError, &isAborted](std::exception_ptr Error)
+	{
+		{
+			std::lock_guard<std::mutex> lock(stageMutex);
+
+			if (stageError == nullptr)
+			{
+				stageError = Error;
+			}
+
+			isAborted = true;
+		}
+
+		stageSignal.notify_all();
+	};
+
+	// the reader can refill a slot once its input has been transformed
+	std::thread reader([&, CNKCNT, RNGLEN, ChunkSize]()
+	{
+		try
+		{
+			for (size_t i = 0; i < CNKCNT; ++i)
+			{
+				{
+					std::unique_lock<std::mutex> lock(stageMutex);
+					stageSignal.wait(lock, [&]() { return isAborted || i - txCtr < RNGLEN; });
+
+					if (isAborted)
+					{
+						return;
+					}
+				}
+
+				if (InStream->Read(inpRing[i % RNGLEN], 0, ChunkSize) != ChunkSize)
+				{
+					throw CryptoProcessingException("CipherStream:PipelineTransform", "The input stream ended unexpectedly!");
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(stageMutex);
+					++rdCtr;
+				}
+
+				stageSignal.notify_all();
+			}
+		}
+		catch (...)
+		{
+			abortStage(std::current_exception());
+		}
+	});
+
+	// the writer drains slots in order as they are transformed
+	std::thread writer([&, CNKCNT, RNGLEN, ChunkSize]()
+	{
+		try
+		{
+			for (size_t i = 0; i < CNKCNT; ++i)
+			{
+				{
+					std::unique_lock<std::mutex> lock(stageMutex);
+					stageSignal.wait(lock, [&]() { return isAborted || i < txCtr; });
+
+					if (isAborted)
+					{
+						return;
+					}
+				}
+
+				OutStream->Write(outRing[i % RNGLEN], 0, ChunkSize);
+
+				{
+					std::lock_guard<std::mutex> lock(stageMutex);
+					++wrCtr;
+				}
+
+				stageSignal.notify_all();
+			}
+		}
+		catch (...)
+		{
+			abortStage(std::current_exception());
+		}
+	});
+
+	// the cipher needs a read input slot and a written output slot
+	try
+	{
+		for (size_t i = 0; i < CNKCNT; ++i)
+		{
+			{
+				std::unique_lock<std::mutex> lock(stageMutex);
+				stageSignal.wait(lock, [&]() { return isAborted || (i < rdCtr && i - wrCtr < RNGLEN); });
+
+				if (isAborted)
+				{
+					break;
+				}
+			}
+
+			Engine->Transform(inpRing[i % RNGLEN], 0, outRing[i % RNGLEN], 0, ChunkSize);
+
+			{
+				std::lock_guard<std::mutex> lock(stageMutex);
+				++txCtr;
+			}
+
+			stageSignal.notify_all();
+			m_progressCounter.Add(ChunkSize);
+		}
+	}
+	catch (...)
+	{
+		abortStage(std::current_exception());
+	}
+
+	reader.join();
+	writer.join();
+
+	if (stageError != nullptr)
+	{
+		std::rethrow_exception(stageError);
+	}
+}
+
 void CipherStream::Scope()
 {
 	if (m_isStreamCipher)
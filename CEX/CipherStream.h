@@ -25,16 +25,19 @@
 #ifndef CEX_CIPHERSTREAM_H
 #define CEX_CIPHERSTREAM_H
 
+#include "AsyncFileStream.h"
 #include "CexDomain.h"
 #include "CryptoProcessingException.h"
 #include "CipherDescription.h"
-#include "Event.h"
 #include "IBlockCipher.h"
 #include "IByteStream.h"
 #include "ICipherMode.h"
 #include "IPadding.h"
 #include "IStreamCipher.h"
+#include "MappedFileStream.h"
 #include "ParallelOptions.h"
+#include "ProgressCounter.h"
+#include "SegmentedStream.h"
 #include "SymmetricKeySize.h"
 #include "SymmetricEngines.h"
 
@@ -44,9 +47,12 @@ using Enumeration::BlockCiphers;
 using Exception::CryptoProcessingException;
 using Enumeration::CipherModes;
 using Enumeration::Digests;
-using Routing::Event;
+using Routing::ProgressCounter;
 using Cipher::Symmetric::Block::IBlockCipher;
 using IO::IByteStream;
+using IO::AsyncFileStream;
+using IO::MappedFileStream;
+using IO::SegmentedStream;
 using Cipher::Symmetric::Block::Mode::ICipherMode;
 using Cipher::Symmetric::Block::Padding::IPadding;
 using Cipher::Symmetric::Stream::IStreamCipher;
@@ -136,7 +142,7 @@ using Key::Symmetric::SymmetricKeySize;
 /// <description><B>Implementation Notes:</B></description>
 /// <list type="bullet">
 /// <item><description>Uses any of the cipher mode wrapped block ciphers, or any of the implemented Stream Ciphers.</description></item>
-/// <item><description>Implementation has a Progress counter that returns total sum of bytes processed during a Write call.</description></item>
+/// <item><description>Progress() is a lock-free count of the input bytes processed by the current Write call; it can be polled from any thread, and a ProgressNotifier attached to it raises time-based progress events.</description></item>
 /// <item><description>The Write methods can not be called until the Initialize(bool, ISymmetricKey) function has been called.</description></item>
 /// <item><description>The Initialize function takes a boolean (Encrypt/Decrypt) flag and an ISymmetricKey, which can be either a SymmetricKey or SymmetricSecureKey container class.</description></item>
 /// <item><description>If the system supports Parallel processing, IsParallel() is set to true; passing an output block of at least ParallelBlockSize to the Write function.</description></item>
@@ -144,12 +150,19 @@ using Key::Symmetric::SymmetricKeySize;
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
 /// <item><description>Parallel block calculation ex. <c>ParallelBlockSize = N - (N % .ParallelMinimumSize);</c></description></item>
+/// <item><description>Setting PipelineDepth() to 2 or more enables the pipelined stream mode; a reader thread fills a ring of ParallelBlockSize buffers, the cipher transforms them on the calling thread, and a writer thread drains them, so sustained throughput is bounded by the slowest stage rather than the sum of the three.</description></item>
+/// <item><description>The pipelined mode applies to the IByteStream Write method only; the input and output must be distinct stream instances, otherwise the stream is processed sequentially.</description></item>
+/// <item><description>If both streams are MappedFileStream instances on different files, the cipher transforms directly from the mapped input pages to the mapped output pages, without intermediate buffers.</description></item>
+/// <item><description>A SegmentedStream input positioned on a 64 byte boundary is transformed directly from its segments; if the output is also a SegmentedStream on a 64 byte boundary, the cipher writes into the output segments, otherwise each transformed segment is written to the output stream.</description></item>
+/// <item><description>If both streams are AsyncFileStream instances on different files, the transform is pipelined through their request queues; up to QueueDepth() chunks are read ahead and written behind while the cipher transforms the current chunk. With Direct i/o, both positions must be aligned to Alignment(), otherwise the stream path is used.</description></item>
 /// </list>
 /// </remarks>
 class CipherStream
 {
 private:
 
+	static const size_t SEGALN = 64;
+
 	std::unique_ptr<ICipherMode> m_cipherEngine;
 	std::unique_ptr<IPadding> m_cipherPadding;
 	bool m_destroyEngine;
@@ -161,15 +174,12 @@ private:
 	bool m_isParallel;
 	bool m_isStreamCipher;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
+	size_t m_pipelineDepth;
+	ProgressCounter m_progressCounter;
 	std::unique_ptr<IStreamCipher> m_streamCipher;
 
 public:
 
-	/// <summary>
-	/// The Progress Percent event
-	/// </summary>
-	Event<int> ProgressPercent;
-
 	//~~~Constructor~~~//
 
 	/// <summary>
@@ -277,6 +287,18 @@ public:
 	/// </summary>
 	ParallelOptions &ParallelProfile();
 
+	/// <summary>
+	/// Read/Write: The number of ParallelBlockSize buffers in the stream pipeline ring.
+	/// <para>A value of 2 or more runs the stream Write with overlapped read, transform, and write stages; 3 or 4 buffers is enough to keep all three stages busy.
+	/// The default value of zero disables the pipeline. The cipher output is identical in either mode.</para>
+	/// </summary>
+	size_t &PipelineDepth();
+
+	/// <summary>
+	/// Read Only: The bytes processed by the current Write call; updated with one relaxed atomic add per block
+	/// </summary>
+	ProgressCounter &Progress();
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -325,12 +347,16 @@ public:
 
 private:
 
+	void AsyncTransform(AsyncFileStream* InStream, AsyncFileStream* OutStream);
 	void BlockTransform(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset);
 	void BlockTransform(IByteStream* InStream, IByteStream* OutStream);
-	void CalculateProgress(size_t Length, size_t Processed);
 	ICipherMode* GetCipherMode(CipherModes ModeType, BlockCiphers CipherType, int BlockSize, int RoundCount, Digests DigestType);
 	IPadding* GetPaddingMode(PaddingModes PaddingType);
 	IStreamCipher* GetStreamCipher(StreamCiphers CipherType, size_t RoundCount);
+	void MappedTransform(MappedFileStream* InStream, MappedFileStream* OutStream);
+	template<typename Cipher>
+	void PipelineTransform(Cipher* Engine, IByteStream* InStream, IByteStream* OutStream, size_t Length, size_t ChunkSize);
+	void SegmentedTransform(SegmentedStream* InStream, IByteStream* OutStream);
 	void StreamTransform(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset);
 	void StreamTransform(IByteStream* InStream, IByteStream* OutStream);
 	void Scope();
@@ -220,6 +220,11 @@ const bool CpuDetect::MPX()
 	return HasFeature(CpuidFlags::CPUID_MPX); 
 }
 
+const bool CpuDetect::OSAVX512()
+{
+	return Avx512Enabled();
+}
+
 const size_t CpuDetect::PhysicalCores()
 { 
 	return m_physCores;
@@ -310,6 +315,11 @@ const bool CpuDetect::SSE42()
 	return HasFeature(CpuidFlags::CPUID_SSE42); 
 }
 
+const bool CpuDetect::VAES()
+{
+	return HasFeature(CpuidFlags::CPUID_VAES);
+}
+
 CpuDetect::CpuVendors CpuDetect::Vendor()
 { 
 	return m_cpuVendor; 
@@ -320,6 +330,11 @@ const size_t CpuDetect::VirtualCores()
 	return m_virtCores; 
 }
 
+const bool CpuDetect::VPCLMULQDQ()
+{
+	return HasFeature(CpuidFlags::CPUID_VPCLMULQDQ);
+}
+
 const bool CpuDetect::XOP() 
 { 
 	return HasFeature(CpuidFlags::CPUID_XOP);
@@ -356,6 +371,21 @@ bool CpuDetect::Avx2Enabled()
 	return status;
 }
 
+bool CpuDetect::Avx512Enabled()
+{
+	std::array<uint, 4> cpuInfo;
+	Cpuid(1, cpuInfo);
+	bool status = false;
+
+	// check if os saves the ymm, opmask and zmm registers
+	if ((cpuInfo[2] & (1 << 27)) && (cpuInfo[2] & (1 << 28)))
+	{
+		status = (_xgetbv(_XCR_XFEATURE_ENABLED_MASK) & 0xE6) == 0xE6;
+	}
+
+	return status;
+}
+
 void CpuDetect::BusInfo()
 {
 	std::array<uint, 4> cpuInfo;
@@ -545,8 +575,10 @@ void CpuDetect::PrintCpuStats()
 	std::cout << "SSE4A: " << BoolStr(SSE4A()) << std::endl;
 	std::cout << "SSE41: " << BoolStr(SSE41()) << std::endl;
 	std::cout << "SSE42: " << BoolStr(SSE42()) << std::endl;
+	std::cout << "VAES: " << BoolStr(VAES()) << std::endl;
 	std::cout << "Vendor: " << ((Vendor() == CpuVendors::UNKNOWN) ? "Unknown" : ((Vendor() == CpuVendors::AMD) ? "AMD" : "Intel")) << std::endl;
 	std::cout << "VirtualCores: " << VirtualCores() << std::endl;
+	std::cout << "VPCLMULQDQ: " << BoolStr(VPCLMULQDQ()) << std::endl;
 	std::cout << "XOP: " << BoolStr(XOP()) << std::endl;
 }
 
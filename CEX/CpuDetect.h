@@ -68,6 +68,8 @@ private:
 		CPUID_SMAP = 64 + 20, // ebx 20
 		CPUID_SHA = 64 + 29, // ebx 29
 		CPUID_PREFETCH = 64 + 32, // ebx 32 -index 2, 3
+		CPUID_VAES = 64 + 32 + 9, // ecx 9
+		CPUID_VPCLMULQDQ = 64 + 32 + 10, // ecx 10
 		// EAX=80000001
 		CPUID_ABM = 128 + 5, // ecx 5
 		CPUID_SSE4A = 128 + 6, // ecx 6
@@ -248,6 +250,12 @@ public:
 	/// </summary>
 	const bool MPX();
 
+	/// <summary>
+	/// Returns true if the operating system saves the AVX-512 register state; the YMM, opmask and ZMM state bits must all be set in XCR0.
+	/// <para>AVX-512 instructions fault if the OS does not save this state, regardless of the AVX512F cpuid flag.</para>
+	/// </summary>
+	const bool OSAVX512();
+
 	/// <summary>
 	/// The total number of physical processor cores
 	/// </summary>
@@ -338,6 +346,11 @@ public:
 	/// </summary>
 	const bool SSE42();
 
+	/// <summary>
+	/// Returns true if the vector AES instructions (VAES) are detected; AES rounds on 256 and 512 bit registers
+	/// </summary>
+	const bool VAES();
+
 	/// <summary>
 	/// Returns the cpu vendors enumeration value
 	/// </summary>
@@ -348,6 +361,11 @@ public:
 	/// </summary>
 	const size_t VirtualCores();
 
+	/// <summary>
+	/// Returns true if the vector carry-less multiply instruction (VPCLMULQDQ) is detected
+	/// </summary>
+	const bool VPCLMULQDQ();
+
 	/// <summary>
 	/// Returns true if the AMD eXtended Operations feature set is detected
 	/// </summary>
@@ -357,6 +375,7 @@ private:
 
 	static bool AvxEnabled();
 	static bool Avx2Enabled();
+	static bool Avx512Enabled();
 	void BusInfo();
 	static void Cpuid(int Flag, std::array<uint, 4> &Output);
 	static void CpuidSublevel(int Flag, int Level, std::array<uint, 4> &Output);
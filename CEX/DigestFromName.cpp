@@ -4,6 +4,7 @@
 #include "Keccak256.h"
 #include "Keccak512.h"
 #include "Keccak1024.h"
+#include "ParallelHash.h"
 #include "SHA256.h"
 #include "SHA512.h"
 #include "Skein256.h"
@@ -45,6 +46,16 @@ IDigest* DigestFromName::GetInstance(Digests DigestType, bool Parallel)
 				dgtPtr = new Digest::Keccak1024(Parallel);
 				break;
 			}
+			case Digests::ParallelHash128:
+			{
+				dgtPtr = new Digest::ParallelHash(Enumeration::ShakeModes::SHAKE128, 8192, false, Parallel);
+				break;
+			}
+			case Digests::ParallelHash256:
+			{
+				dgtPtr = new Digest::ParallelHash(Enumeration::ShakeModes::SHAKE256, 8192, false, Parallel);
+				break;
+			}
 			case Digests::SHA256:
 			{
 				dgtPtr = new Digest::SHA256(Parallel);
@@ -109,7 +120,13 @@ size_t DigestFromName::GetBlockSize(Digests DigestType)
 			blkSize = 128;
 			break;
 		}
+		case Digests::ParallelHash128:
+		{
+			blkSize = 168;
+			break;
+		}
 		case Digests::Keccak256:
+		case Digests::ParallelHash256:
 		{
 			blkSize = 136;
 			break;
@@ -142,6 +159,7 @@ size_t DigestFromName::GetDigestSize(Digests DigestType)
 	{
 		case Digests::Blake256:
 		case Digests::Keccak256:
+		case Digests::ParallelHash128:
 		case Digests::SHA256:
 		case Digests::Skein256:
 		{
@@ -150,6 +168,7 @@ size_t DigestFromName::GetDigestSize(Digests DigestType)
 		}
 		case Digests::Blake512:
 		case Digests::Keccak512:
+		case Digests::ParallelHash256:
 		case Digests::SHA512:
 		case Digests::Skein512:
 		{
@@ -187,6 +206,8 @@ size_t DigestFromName::GetPaddingSize(Digests DigestType)
 		case Digests::Keccak256:
 		case Digests::Keccak512:
 		case Digests::Keccak1024:
+		case Digests::ParallelHash128:
+		case Digests::ParallelHash256:
 		case Digests::Skein256:
 		case Digests::Skein512:
 		case Digests::Skein1024:
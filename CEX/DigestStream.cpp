@@ -1,4 +1,13 @@
 #include "DigestStream.h"
+#include "IntUtils.h"
+#include "Keccak1024.h"
+#include "Keccak256.h"
+#include "Keccak512.h"
+#include "ParallelUtils.h"
+#include "SHA256.h"
+#include "SHA512.h"
+#include <algorithm>
+#include <atomic>
 
 NAMESPACE_PROCESSING
 
@@ -11,6 +20,7 @@ DigestStream::DigestStream(Digests DigestType, bool Parallel)
 	m_destroyEngine(true),
 	m_isDestroyed(false),
 	m_isParallel(Parallel),
+	m_progressCounter(),
 	m_progressInterval(0)
 {
 }
@@ -22,6 +32,7 @@ DigestStream::DigestStream(IDigest* Digest)
 	m_destroyEngine(false),
 	m_isDestroyed(false),
 	m_isParallel(m_digestEngine->IsParallel()),
+	m_progressCounter(),
 	m_progressInterval(0)
 {
 }
@@ -48,6 +59,11 @@ ParallelOptions &DigestStream::ParallelProfile()
 	return m_digestEngine->ParallelProfile();
 }
 
+ProgressCounter &DigestStream::Progress()
+{
+	return m_progressCounter;
+}
+
 //~~~Public Functions~~~//
 
 std::vector<byte> DigestStream::Compute(IByteStream* InStream)
@@ -57,8 +73,18 @@ std::vector<byte> DigestStream::Compute(IByteStream* InStream)
 
 	size_t dataLen = InStream->Length() - InStream->Position();
 	CalculateInterval(dataLen);
+	m_progressCounter.Reset(dataLen);
 	m_digestEngine->Reset();
 
+	if (InStream->Enumeral() == Enumeration::StreamModes::MappedFileStream)
+	{
+		return Process(static_cast<MappedFileStream*>(InStream), dataLen);
+	}
+	else if (InStream->Enumeral() == Enumeration::StreamModes::SegmentedStream)
+	{
+		return Process(static_cast<SegmentedStream*>(InStream), dataLen);
+	}
+
 	return Process(InStream, dataLen);
 }
 
@@ -67,11 +93,44 @@ std::vector<byte> DigestStream::Compute(const std::vector<byte> &Input, size_t I
 	CexAssert((Input.size() - InOffset) > 0 && Length + InOffset <= Input.size(), "the input array is too short");
 
 	CalculateInterval(Length);
+	m_progressCounter.Reset(Length);
 	m_digestEngine->Reset();
 
 	return Process(Input, InOffset, Length);
 }
 
+std::vector<std::vector<byte>> DigestStream::ComputeBatch(const std::vector<IByteStream*> &InStreams, bool MultiBuffer)
+{
+	std::vector<size_t> msgLen(InStreams.size());
+
+	for (size_t i = 0; i < InStreams.size(); ++i)
+	{
+		CexAssert(InStreams[i]->CanRead(), "the input stream is set to write only!");
+		msgLen[i] = static_cast<size_t>(InStreams[i]->Length() - InStreams[i]->Position());
+	}
+
+	return ProcessBatch([&InStreams](size_t Index) -> IByteStream*
+	{
+		return InStreams[Index];
+	}, msgLen, false, MultiBuffer);
+}
+
+std::vector<std::vector<byte>> DigestStream::ComputeBatch(const std::vector<std::string> &FileNames, bool MultiBuffer)
+{
+	std::vector<size_t> msgLen(FileNames.size());
+
+	// the sizes schedule the batch, the files are opened by the workers
+	for (size_t i = 0; i < FileNames.size(); ++i)
+	{
+		msgLen[i] = static_cast<size_t>(IO::FileStream::FileSize(FileNames[i]));
+	}
+
+	return ProcessBatch([&FileNames](size_t Index) -> IByteStream*
+	{
+		return new IO::FileStream(FileNames[Index], IO::FileStream::FileAccess::Read);
+	}, msgLen, true, MultiBuffer);
+}
+
 //~~~Private Functions~~~//
 
 void DigestStream::CalculateInterval(size_t Length)
@@ -93,35 +152,6 @@ void DigestStream::CalculateInterval(size_t Length)
 	}
 }
 
-void DigestStream::CalculateProgress(size_t Length, size_t Processed)
-{
-	if (Length >= Processed)
-	{
-		double progress = 100.0 * (static_cast<double>(Processed) / Length);
-		if (progress > 100.0)
-		{
-			progress = 100.0;
-		}
-
-		if (m_isParallel)
-		{
-			ProgressPercent(static_cast<int>(progress));
-		}
-		else
-		{
-			size_t block = Length / 100;
-			if (block == 0)
-			{
-				ProgressPercent(static_cast<int>(progress));
-			}
-			else if (Processed % block == 0)
-			{
-				ProgressPercent(static_cast<int>(progress));
-			}
-		}
-	}
-}
-
 void DigestStream::Destroy()
 {
 	if (!m_isDestroyed)
@@ -148,6 +178,98 @@ void DigestStream::Destroy()
 	}
 }
 
+void DigestStream::HashBatch(IDigest* Digest, const std::vector<std::vector<byte>> &Input, std::vector<std::vector<byte>> &Output)
+{
+	switch (Digest->Enumeral())
+	{
+		case Digests::Keccak256:
+		{
+			static_cast<Digest::Keccak256*>(Digest)->ComputeBatch(Input, Output);
+			break;
+		}
+		case Digests::Keccak512:
+		{
+			static_cast<Digest::Keccak512*>(Digest)->ComputeBatch(Input, Output);
+			break;
+		}
+		case Digests::Keccak1024:
+		{
+			static_cast<Digest::Keccak1024*>(Digest)->ComputeBatch(Input, Output);
+			break;
+		}
+		case Digests::SHA256:
+		{
+			static_cast<Digest::SHA256*>(Digest)->ComputeBatch(Input, Output);
+			break;
+		}
+		case Digests::SHA512:
+		{
+			static_cast<Digest::SHA512*>(Digest)->ComputeBatch(Input, Output);
+			break;
+		}
+		default:
+		{
+			throw CryptoProcessingException("DigestStream:HashBatch", "The digest does not support multi-buffer hashing!");
+		}
+	}
+}
+
+bool DigestStream::HasBatch(Digests DigestType)
+{
+	return (DigestType == Digests::Keccak256 || DigestType == Digests::Keccak512 || DigestType == Digests::Keccak1024 ||
+		DigestType == Digests::SHA256 || DigestType == Digests::SHA512);
+}
+
+void DigestStream::HashStream(IDigest* Digest, IByteStream* InStream, size_t Length, std::vector<byte> &Buffer, std::vector<byte> &Output, ProgressCounter &Progress)
+{
+	if (Length != 0 && InStream->Enumeral() == Enumeration::StreamModes::MappedFileStream)
+	{
+		MappedFileStream* inpMap = static_cast<MappedFileStream*>(InStream);
+		Digest->Update(inpMap->Pointer() + inpMap->Position(), Length);
+		Progress.Add(Length);
+		inpMap->Seek(Length, IO::SeekOrigin::Current);
+	}
+	else if (Length != 0 && InStream->Enumeral() == Enumeration::StreamModes::SegmentedStream)
+	{
+		SegmentedStream* inpSeg = static_cast<SegmentedStream*>(InStream);
+		ulong inpPos = inpSeg->Position();
+		size_t prcLen = 0;
+
+		while (prcLen != Length)
+		{
+			size_t inpLen = 0;
+			const byte* inpPtr = inpSeg->Segment(inpPos, inpLen);
+			Digest->Update(inpPtr, inpLen);
+			Progress.Add(inpLen);
+			inpPos += inpLen;
+			prcLen += inpLen;
+		}
+
+		inpSeg->Seek(inpPos, IO::SeekOrigin::Begin);
+	}
+	else
+	{
+		size_t prcLen = 0;
+
+		while (prcLen != Length)
+		{
+			const size_t RDLEN = InStream->Read(Buffer, 0, Utility::IntUtils::Min(Buffer.size(), Length - prcLen));
+
+			if (RDLEN == 0)
+			{
+				throw CryptoProcessingException("DigestStream:HashStream", "The input stream is shorter than its length!");
+			}
+
+			Digest->Update(Buffer.data(), RDLEN);
+			Progress.Add(RDLEN);
+			prcLen += RDLEN;
+		}
+	}
+
+	Output.resize(Digest->DigestSize());
+	Digest->Finalize(Output, 0);
+}
+
 std::vector<byte> DigestStream::Process(IByteStream* InStream, size_t Length)
 {
 	size_t prcLen = 0;
@@ -167,7 +289,7 @@ std::vector<byte> DigestStream::Process(IByteStream* InStream, size_t Length)
 				prcRead = InStream->Read(inpBuffer, 0, PRLBLK);
 				m_digestEngine->Update(inpBuffer, 0, prcRead);
 				prcLen += prcRead;
-				CalculateProgress(Length, InStream->Position());
+				m_progressCounter.Add(prcRead);
 			}
 		}
 	}
@@ -181,7 +303,7 @@ std::vector<byte> DigestStream::Process(IByteStream* InStream, size_t Length)
 		prcRead = InStream->Read(inpBuffer, 0, BLKLEN);
 		m_digestEngine->Update(inpBuffer, 0, prcRead);
 		prcLen += prcRead;
-		CalculateProgress(Length, InStream->Position());
+		m_progressCounter.Add(prcRead);
 	}
 
 	// last block
@@ -197,11 +319,179 @@ std::vector<byte> DigestStream::Process(IByteStream* InStream, size_t Length)
 	// get the hash
 	std::vector<byte> chkSum(m_digestEngine->DigestSize());
 	m_digestEngine->Finalize(chkSum, 0);
-	CalculateProgress(Length, prcLen);
+	m_progressCounter.Add(Length - ALNLEN);
 
 	return chkSum;
 }
 
+std::vector<byte> DigestStream::Process(MappedFileStream* InStream, size_t Length)
+{
+	// the mapped pages are passed to the digest directly, in progress interval sized segments
+	const size_t PRLBLK = m_isParallel ? m_digestEngine->ParallelBlockSize() : m_progressInterval;
+	const size_t PRCLEN = (Length / PRLBLK) * PRLBLK;
+	const byte* inpPtr = InStream->Pointer() + InStream->Position();
+	size_t prcLen = 0;
+
+	while (prcLen != PRCLEN)
+	{
+		m_digestEngine->Update(inpPtr + prcLen, PRLBLK);
+		prcLen += PRLBLK;
+		m_progressCounter.Add(PRLBLK);
+	}
+
+	if (prcLen != Length)
+	{
+		m_digestEngine->Update(inpPtr + prcLen, Length - prcLen);
+		prcLen = Length;
+	}
+
+	InStream->Seek(Length, IO::SeekOrigin::Current);
+
+	std::vector<byte> chkSum(m_digestEngine->DigestSize());
+	m_digestEngine->Finalize(chkSum, 0);
+	m_progressCounter.Add(Length - PRCLEN);
+
+	return chkSum;
+}
+
+std::vector<byte> DigestStream::Process(SegmentedStream* InStream, size_t Length)
+{
+	// each segment is passed to the digest directly
+	ulong inpPos = InStream->Position();
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		size_t inpLen = 0;
+		const byte* inpPtr = InStream->Segment(inpPos, inpLen);
+		m_digestEngine->Update(inpPtr, inpLen);
+		inpPos += inpLen;
+		prcLen += inpLen;
+		m_progressCounter.Add(inpLen);
+	}
+
+	InStream->Seek(inpPos, IO::SeekOrigin::Begin);
+
+	std::vector<byte> chkSum(m_digestEngine->DigestSize());
+	m_digestEngine->Finalize(chkSum, 0);
+
+	return chkSum;
+}
+
+std::vector<std::vector<byte>> DigestStream::ProcessBatch(const std::function<IByteStream*(size_t)> &Open, const std::vector<size_t> &Lengths, bool Owned, bool MultiBuffer)
+{
+	const size_t MSGCNT = Lengths.size();
+	const Digests DGTTYPE = m_digestEngine->Enumeral();
+	const bool USELNS = MultiBuffer && !m_isParallel && HasBatch(DGTTYPE);
+	std::vector<std::vector<byte>> dgtCodes(MSGCNT);
+	std::vector<std::vector<size_t>> batchJobs;
+	std::vector<size_t> msgOrder(MSGCNT);
+	std::vector<size_t> smlJob;
+	std::atomic<size_t> nxtJob(0);
+	ulong ttlLen = 0;
+
+	for (size_t i = 0; i < MSGCNT; ++i)
+	{
+		msgOrder[i] = i;
+		ttlLen += Lengths[i];
+	}
+
+	m_progressCounter.Reset(ttlLen);
+
+	// the longest streams are scheduled first, so a long stream is not left running alone at the end of the batch
+	std::stable_sort(msgOrder.begin(), msgOrder.end(), [&Lengths](size_t A, size_t B)
+	{
+		return Lengths[A] > Lengths[B];
+	});
+
+	// each job is a single stream, or a group of small streams hashed together across the SIMD lanes
+	for (size_t i = 0; i < MSGCNT; ++i)
+	{
+		if (USELNS && Lengths[msgOrder[i]] <= BATCH_SMALL)
+		{
+			smlJob.push_back(msgOrder[i]);
+
+			if (smlJob.size() == BATCH_LANES)
+			{
+				batchJobs.push_back(smlJob);
+				smlJob.clear();
+			}
+		}
+		else
+		{
+			batchJobs.push_back(std::vector<size_t>(1, msgOrder[i]));
+		}
+	}
+
+	if (smlJob.size() != 0)
+	{
+		batchJobs.push_back(smlJob);
+	}
+
+	// workers take jobs in turn; each holds one read buffer, so the read-ahead is bounded by the number of workers
+	auto worker = [this, &Open, &Lengths, Owned, &dgtCodes, &batchJobs, &nxtJob](IDigest* Digest)
+	{
+		std::vector<byte> inpBuffer(BATCH_BUFFER);
+		size_t jobIdx;
+
+		while ((jobIdx = nxtJob.fetch_add(1)) < batchJobs.size())
+		{
+			const std::vector<size_t> &job = batchJobs[jobIdx];
+
+			if (job.size() == 1)
+			{
+				std::unique_ptr<IByteStream> inpOwner(Owned ? Open(job[0]) : nullptr);
+				IByteStream* inpStream = Owned ? inpOwner.get() : Open(job[0]);
+				HashStream(Digest, inpStream, Lengths[job[0]], inpBuffer, dgtCodes[job[0]], m_progressCounter);
+			}
+			else
+			{
+				std::vector<std::vector<byte>> msgData(job.size());
+				std::vector<std::vector<byte>> msgCodes;
+
+				for (size_t i = 0; i < job.size(); ++i)
+				{
+					std::unique_ptr<IByteStream> inpOwner(Owned ? Open(job[i]) : nullptr);
+					IByteStream* inpStream = Owned ? inpOwner.get() : Open(job[i]);
+					msgData[i].resize(Lengths[job[i]]);
+
+					if (inpStream->Read(msgData[i], 0, msgData[i].size()) != msgData[i].size())
+					{
+						throw CryptoProcessingException("DigestStream:ProcessBatch", "The input stream is shorter than its length!");
+					}
+				}
+
+				HashBatch(Digest, msgData, msgCodes);
+
+				for (size_t i = 0; i < job.size(); ++i)
+				{
+					dgtCodes[job[i]] = std::move(msgCodes[i]);
+					m_progressCounter.Add(Lengths[job[i]]);
+				}
+			}
+		}
+	};
+
+	m_digestEngine->Reset();
+
+	if (m_isParallel || batchJobs.size() < 2)
+	{
+		worker(m_digestEngine.get());
+	}
+	else
+	{
+		const size_t WRKCNT = Utility::IntUtils::Min(Utility::ParallelUtils::ProcessorCount(), batchJobs.size());
+
+		Utility::ParallelUtils::ParallelFor(0, WRKCNT, [DGTTYPE, &worker](size_t)
+		{
+			std::unique_ptr<IDigest> dgtEngine(DigestFromName::GetInstance(DGTTYPE, false));
+			worker(dgtEngine.get());
+		});
+	}
+
+	return dgtCodes;
+}
+
 std::vector<byte> DigestStream::Process(const std::vector<byte> &Input, size_t InOffset, size_t Length)
 {
 	size_t prcLen = 0;
@@ -218,7 +508,7 @@ std::vector<byte> DigestStream::Process(const std::vector<byte> &Input, size_t I
 				m_digestEngine->Update(Input, InOffset, PRLBLK);
 				InOffset += PRLBLK;
 				prcLen += PRLBLK;
-				CalculateProgress(Length, InOffset);
+				m_progressCounter.Add(PRLBLK);
 			}
 		}
 	}
@@ -231,7 +521,7 @@ std::vector<byte> DigestStream::Process(const std::vector<byte> &Input, size_t I
 		m_digestEngine->Update(Input, InOffset, BLKLEN);
 		InOffset += BLKLEN;
 		prcLen += BLKLEN;
-		CalculateProgress(Length, InOffset);
+		m_progressCounter.Add(BLKLEN);
 	}
 
 	// last block
@@ -245,7 +535,7 @@ std::vector<byte> DigestStream::Process(const std::vector<byte> &Input, size_t I
 	// get the hash
 	std::vector<byte> chkSum(m_digestEngine->DigestSize());
 	m_digestEngine->Finalize(chkSum, 0);
-	CalculateProgress(Length, prcLen);
+	m_progressCounter.Add(Length - ALNLEN);
 
 	return chkSum;
 }
@@ -27,17 +27,23 @@
 #include "CexDomain.h"
 #include "CryptoProcessingException.h"
 #include "DigestFromName.h"
-#include "Event.h"
+#include "FileStream.h"
 #include "IByteStream.h"
+#include "MappedFileStream.h"
 #include "ParallelOptions.h"
+#include "ProgressCounter.h"
+#include "SegmentedStream.h"
+#include <functional>
 
 NAMESPACE_PROCESSING
 
 using Exception::CryptoProcessingException;
 using Helper::DigestFromName;
 using Enumeration::Digests;
-using Routing::Event;
+using Routing::ProgressCounter;
 using IO::IByteStream;
+using IO::MappedFileStream;
+using IO::SegmentedStream;
 using Digest::IDigest;
 using Common::ParallelOptions;
 
@@ -61,26 +67,31 @@ using Common::ParallelOptions;
 /// <description>Implementation Notes:</description>
 /// <list type="bullet">
 /// <item><description>Uses any of the implemented Digests using either the IDigest interface, or a Digests enumeration member.</description></item>
-/// <item><description>Implementation has a Progress counter that returns total sum of bytes processed per either of the Compute() calls.</description></item>
+/// <item><description>Progress() is a lock-free count of the input bytes processed by the current Compute() or ComputeBatch() call; it can be polled from any thread, and a ProgressNotifier attached to it raises time-based progress events.</description></item>
+/// <item><description>A MappedFileStream input is hashed directly from the mapped pages, without copying through an intermediate buffer.</description></item>
+/// <item><description>A SegmentedStream input is hashed directly from its segments.</description></item>
+/// <item><description>The ComputeBatch functions hash a list of streams or files concurrently, one worker per processor core, each worker holding its own digest instance and a single read buffer; the digests are returned in input order.</description></item>
+/// <item><description>With the MultiBuffer option, batched files no longer than 16 KB are gathered in groups of up to 64 and hashed with the digests multi-buffer SIMD kernels (SHA256, SHA512, and Keccak); the digest output is unchanged.</description></item>
+/// <item><description>If the digest is in parallel (tree hashing) mode, the batch is hashed in turn by the parallel digest, which already occupies the processor cores.</description></item>
 /// </list>
 /// </remarks>
 class DigestStream
 {
 private:
 
+	static const size_t BATCH_BUFFER = 64 * 1024;
+	static const size_t BATCH_LANES = 64;
+	static const size_t BATCH_SMALL = 16 * 1024;
+
 	std::unique_ptr<IDigest> m_digestEngine;
 	bool m_destroyEngine;
 	bool m_isDestroyed = false;
 	bool m_isParallel;
+	ProgressCounter m_progressCounter;
 	size_t m_progressInterval;
 
 public:
 
-	/// <summary>
-	/// The Progress Percent event
-	/// </summary>
-	Event<int> ProgressPercent;
-
 	//~~~Constructor~~~//
 
 	/// <summary>
@@ -146,6 +157,11 @@ public:
 	/// </summary>
 	ParallelOptions &ParallelProfile();
 
+	/// <summary>
+	/// Read Only: The bytes processed by the current Compute or ComputeBatch call; updated with one relaxed atomic add per block
+	/// </summary>
+	ProgressCounter &Progress();
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -168,12 +184,42 @@ public:
 	/// <returns>The message hash output code</returns>
 	std::vector<byte> Compute(const std::vector<byte> &Input, size_t InOffset, size_t Length);
 
+	/// <summary>
+	/// Hash a list of streams concurrently.
+	/// <para>Each stream is hashed from its current position to the end of the stream. 
+	/// Digests are identical to those returned by Compute(IByteStream*); Progress() counts the bytes hashed by all of the workers.</para>
+	/// </summary>
+	///
+	/// <param name="InStreams">The source streams to process; each stream must be a distinct instance</param>
+	/// <param name="MultiBuffer">Hash the small streams together with the multi-buffer SIMD kernels, if the digest supports them</param>
+	/// 
+	/// <returns>The message hash of each stream, in the order of the input streams</returns>
+	std::vector<std::vector<byte>> ComputeBatch(const std::vector<IByteStream*> &InStreams, bool MultiBuffer = false);
+
+	/// <summary>
+	/// Hash a list of files concurrently.
+	/// <para>A file is opened only while it is being hashed, so the number of open files is bounded by the number of workers.</para>
+	/// </summary>
+	///
+	/// <param name="FileNames">The full paths of the files to process</param>
+	/// <param name="MultiBuffer">Hash the small files together with the multi-buffer SIMD kernels, if the digest supports them</param>
+	/// 
+	/// <returns>The message hash of each file, in the order of the file names</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if a file can not be opened</exception>
+	std::vector<std::vector<byte>> ComputeBatch(const std::vector<std::string> &FileNames, bool MultiBuffer = false);
+
 private:
 
 	void CalculateInterval(size_t Length);
-	void CalculateProgress(size_t Length, size_t Processed);
+	static void HashBatch(IDigest* Digest, const std::vector<std::vector<byte>> &Input, std::vector<std::vector<byte>> &Output);
+	static bool HasBatch(Digests DigestType);
+	static void HashStream(IDigest* Digest, IByteStream* InStream, size_t Length, std::vector<byte> &Buffer, std::vector<byte> &Output, ProgressCounter &Progress);
 	std::vector<byte> Process(IByteStream* InStream, size_t Length);
+	std::vector<byte> Process(MappedFileStream* InStream, size_t Length);
+	std::vector<byte> Process(SegmentedStream* InStream, size_t Length);
 	std::vector<byte> Process(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+	std::vector<std::vector<byte>> ProcessBatch(const std::function<IByteStream*(size_t)> &Open, const std::vector<size_t> &Lengths, bool Owned, bool MultiBuffer);
 	void Destroy();
 };
 
@@ -69,7 +69,15 @@ enum class Digests : byte
 	/// <summary>
 	/// The Skein digest with a 1024 bit return size
 	/// </summary>
-	Skein1024 = 14
+	Skein1024 = 14,
+	/// <summary>
+	/// The SP800-185 ParallelHash digest with 128 bit security, and a 256 bit default return size
+	/// </summary>
+	ParallelHash128 = 15,
+	/// <summary>
+	/// The SP800-185 ParallelHash digest with 256 bit security, and a 512 bit default return size
+	/// </summary>
+	ParallelHash256 = 16
 };
 
 NAMESPACE_ENUMERATIONEND
@@ -1,7 +1,11 @@
 #include "EAX.h"
+#include "CBC.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
 #include "SymmetricKey.h"
+#if defined(__AVX__)
+#	include "AHX.h"
+#endif
 
 NAMESPACE_MODE
 
@@ -322,16 +326,14 @@ void EAX::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
 
-	if (m_isEncryption)
-	{
-		m_cipherMode->Transform(Input, InOffset, Output, OutOffset, Length);
-		m_macGenerator->Update(Output, OutOffset, Length);
-	}
-	else
-	{
-		m_macGenerator->Update(Input, InOffset, Length);
-		m_cipherMode->Transform(Input, InOffset, Output, OutOffset, Length);
-	}
+	Process(Input.data() + InOffset, Output.data() + OutOffset, Length);
+}
+
+void EAX::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+
+	Process(Input, Output, Length);
 }
 
 bool EAX::Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
@@ -393,6 +395,161 @@ void EAX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	m_macGenerator->Update(Input, InOffset, m_blockSize);
 }
 
+void EAX::Process(const byte* Input, byte* Output, const size_t Length)
+{
+	const size_t PRLBLK = m_cipherMode->ParallelProfile().ParallelBlockSize();
+	size_t prcLen = 0;
+
+	if (m_cipherMode->ParallelProfile().IsParallel() && Length >= PRLBLK)
+	{
+		prcLen = Length - (Length % PRLBLK);
+		ProcessParallel(Input, Output, prcLen);
+	}
+
+	if (prcLen != Length)
+	{
+		ProcessSequential(Input + prcLen, Output + prcLen, Length - prcLen);
+	}
+}
+
+void EAX::ProcessFused(const byte* Input, byte* Output, const size_t Length)
+{
+#if defined(__AVX__)
+	// the cmac chain absorbs the previous block while the key stream of the next block is generated, so the counter mode rounds fill the latency of the chain
+	const std::vector<__m128i> &RNDKEY = static_cast<AHX*>(m_cipherMode->Engine())->RoundKeys();
+	const size_t RNDCNT = RNDKEY.size() - 1;
+	const size_t BLKCNT = Length / BLOCK_SIZE;
+	const __m128i CARRY = _mm_set_epi64x(1, 0);
+	const __m128i LOW = _mm_set_epi64x(0, -1);
+	const __m128i MASK = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i ONE = _mm_set_epi64x(0, 1);
+	const __m128i ZERO = _mm_setzero_si128();
+	std::vector<byte> &macChain = m_macGenerator->ChainState();
+	std::vector<byte> &ctrVector = m_cipherMode->Counter();
+	__m128i C;
+	__m128i P;
+	__m128i K;
+	__m128i ctr = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrVector.data())), MASK);
+	__m128i M = ZERO;
+	__m128i X = _mm_loadu_si128(reinterpret_cast<const __m128i*>(macChain.data()));
+	__m128i Y;
+
+	for (size_t i = 0; i < BLKCNT; ++i)
+	{
+		// the chain holds no unabsorbed block on the first pass, its rounds are discarded
+		Y = _mm_xor_si128(_mm_xor_si128(X, M), RNDKEY[0]);
+		K = _mm_xor_si128(_mm_shuffle_epi8(ctr, MASK), RNDKEY[0]);
+
+		for (size_t j = 1; j < RNDCNT; ++j)
+		{
+			Y = _mm_aesenc_si128(Y, RNDKEY[j]);
+			K = _mm_aesenc_si128(K, RNDKEY[j]);
+		}
+
+		Y = _mm_aesenclast_si128(Y, RNDKEY[RNDCNT]);
+		K = _mm_aesenclast_si128(K, RNDKEY[RNDCNT]);
+		X = (i == 0) ? X : Y;
+		ctr = _mm_add_epi64(ctr, ONE);
+
+		if (_mm_testz_si128(ctr, LOW))
+		{
+			ctr = _mm_add_epi64(ctr, CARRY);
+		}
+
+		// the cipher-text block is absorbed on the next pass
+		P = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Input + (i * BLOCK_SIZE)));
+		C = _mm_xor_si128(P, K);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Output + (i * BLOCK_SIZE)), C);
+		M = m_isEncryption ? C : P;
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(ctrVector.data()), _mm_shuffle_epi8(ctr, MASK));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(macChain.data()), X);
+	// the last block is buffered by the mac, so that it is processed as the final block; copied from the register as the input may have been transformed in place
+	std::vector<byte> lstBlock(BLOCK_SIZE);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lstBlock.data()), M);
+	m_macGenerator->Update(lstBlock, 0, BLOCK_SIZE);
+#endif
+}
+
+void EAX::ProcessParallel(const byte* Input, byte* Output, const size_t Length)
+{
+	// encryption authenticates the previous segment of output, and decryption the next segment of input, so a segment is never read by the mac while it is transformed in place
+	const size_t SEGLEN = m_cipherMode->ParallelProfile().ParallelBlockSize() / m_cipherMode->ParallelProfile().ParallelMaxDegree();
+	const size_t SEGCNT = Length / SEGLEN;
+
+	if (m_isEncryption)
+	{
+		m_cipherMode->Transform(Input, Output, SEGLEN);
+
+		for (size_t i = 1; i < SEGCNT; ++i)
+		{
+			Utility::ParallelUtils::ParallelFor(0, 2, [this, Input, Output, SEGLEN, i](size_t j)
+			{
+				if (j == 0)
+				{
+					m_macGenerator->Update(Output + ((i - 1) * SEGLEN), SEGLEN);
+				}
+				else
+				{
+					m_cipherMode->Transform(Input + (i * SEGLEN), Output + (i * SEGLEN), SEGLEN);
+				}
+			});
+		}
+
+		m_macGenerator->Update(Output + ((SEGCNT - 1) * SEGLEN), SEGLEN);
+	}
+	else
+	{
+		m_macGenerator->Update(Input, SEGLEN);
+
+		for (size_t i = 1; i < SEGCNT; ++i)
+		{
+			Utility::ParallelUtils::ParallelFor(0, 2, [this, Input, Output, SEGLEN, i](size_t j)
+			{
+				if (j == 0)
+				{
+					m_macGenerator->Update(Input + (i * SEGLEN), SEGLEN);
+				}
+				else
+				{
+					m_cipherMode->Transform(Input + ((i - 1) * SEGLEN), Output + ((i - 1) * SEGLEN), SEGLEN);
+				}
+			});
+		}
+
+		m_cipherMode->Transform(Input + ((SEGCNT - 1) * SEGLEN), Output + ((SEGCNT - 1) * SEGLEN), SEGLEN);
+	}
+}
+
+void EAX::ProcessSequential(const byte* Input, byte* Output, const size_t Length)
+{
+	size_t prcLen = 0;
+
+#if defined(__AVX__)
+	// an aligned key stream means the mac holds a whole block or none, the chain can be advanced directly
+	if (Length >= BLOCK_SIZE && m_cipherMode->KeyStreamOffset() == 0 && dynamic_cast<AHX*>(m_cipherMode->Engine()) != nullptr)
+	{
+		prcLen = Length - (Length % BLOCK_SIZE);
+		ProcessFused(Input, Output, prcLen);
+	}
+#endif
+
+	if (prcLen != Length)
+	{
+		if (m_isEncryption)
+		{
+			m_cipherMode->Transform(Input + prcLen, Output + prcLen, Length - prcLen);
+			m_macGenerator->Update(Output + prcLen, Length - prcLen);
+		}
+		else
+		{
+			m_macGenerator->Update(Input + prcLen, Length - prcLen);
+			m_cipherMode->Transform(Input + prcLen, Output + prcLen, Length - prcLen);
+		}
+	}
+}
+
 void EAX::Reset()
 {
 	if (!m_aadPreserve)
@@ -99,6 +99,8 @@ NAMESPACE_MODE
 /// <item><description>Calling the Finalize(Output, Offset, Length) function writes the MAC code to the output array in either encryption or decryption operation mode.</description></item>
 /// <item><description>The Verify(Input, Offset, Length) function can be used to compare the MAC code embedded with the cipher-text to the internal MAC code generated after a Decryption cycle.</description></item>
 /// <item><description>Encryption and decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded.</description></item>
+/// <item><description>The message is processed in a single pass; with the AHX engine, each CMAC block and a block of the counter mode keystream are encrypted together in one round loop, so the keystream is hidden in the latency of the CMAC chain.</description></item>
+/// <item><description>In parallel mode the message is divided into segments, and the counter mode transform of one segment runs on a worker thread while the calling thread authenticates the neighbouring segment.</description></item>
 /// <item><description>If the system supports Parallel processing, and IsParallel() is set to true; passing an input block of ParallelBlockSize() to the transform will be auto parallelized.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
@@ -391,6 +393,18 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
 	/// <summary>
 	/// Generate the internal MAC code and compare it with the tag contained in the Input array.   
 	/// <para>This function finalizes the Decryption cycle and generates the MAC tag.
@@ -414,6 +428,10 @@ private:
 	void CalculateMac();
 	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	void Process(const byte* Input, byte* Output, const size_t Length);
+	void ProcessFused(const byte* Input, byte* Output, const size_t Length);
+	void ProcessParallel(const byte* Input, byte* Output, const size_t Length);
+	void ProcessSequential(const byte* Input, byte* Output, const size_t Length);
 	void Reset();
 	void Scope();
 	void UpdateTag(byte Tag, const std::vector<byte> &Nonce);
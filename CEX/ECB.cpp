@@ -1,7 +1,8 @@
 #include "ECB.h"
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
+#include "BlockScheduler.h"
 #include "IntUtils.h"
-#include "ParallelUtils.h"
 
 NAMESPACE_MODE
 
@@ -183,29 +184,18 @@ void ECB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the length");
 	CexAssert(Length % m_blockCipher->BlockSize() == 0, "The length must be evenly divisible by the block size");
 
-	const size_t PRLBLK = m_parallelProfile.ParallelBlockSize();
-
-	if (m_parallelProfile.IsParallel() && Length >= PRLBLK)
-	{
-		const size_t BLKCNT = Length / PRLBLK;
+	Process(Input, InOffset, Output, OutOffset, Length);
+}
 
-		for (size_t i = 0; i < BLKCNT; ++i)
-		{
-			ProcessParallel(Input, InOffset + (i * PRLBLK), Output, OutOffset + (i * PRLBLK), PRLBLK);
-		}
+void ECB::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized");
+	CexAssert(Length % m_blockCipher->BlockSize() == 0, "The length must be evenly divisible by the block size");
 
-		const size_t RMDLEN = Length - (PRLBLK * BLKCNT);
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
 
-		if (RMDLEN != 0)
-		{
-			const size_t BLKOFT = (PRLBLK * BLKCNT);
-			ProcessSequential(Input, InOffset + BLKOFT, Output, OutOffset + BLKOFT, RMDLEN);
-		}
-	}
-	else
-	{
-		ProcessSequential(Input, InOffset, Output, OutOffset, Length);
-	}
+	Process(inp, 0, otp, 0, Length);
 }
 
 //~~~Private Functions~~~//
@@ -218,72 +208,6 @@ void ECB::Encrypt128(const std::vector<byte> &Input, size_t InOffset, std::vecto
 	m_blockCipher->EncryptBlock(Input, InOffset, Output, OutOffset);
 }
 
-void ECB::Generate(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t BlockCount)
-{
-	size_t blkCtr = BlockCount;
-
-#if defined(__AVX512__)
-	if (blkCtr > 15)
-	{
-		// 512bit avx
-		const size_t AVX512BLK = 256;
-		size_t rndCtr = (blkCtr / 16);
-
-		while (rndCtr != 0)
-		{
-			// transform 16 blocks
-			m_blockCipher->Transform2048(Input, InOffset, Output, OutOffset);
-			InOffset += AVX512BLK;
-			OutOffset += AVX512BLK;
-			blkCtr -= 16;
-			--rndCtr;
-		}
-	}
-#elif defined(__AVX2__)
-	if (blkCtr > 7)
-	{
-		// 256bit avx
-		const size_t AVX2BLK = 128;
-		size_t rndCtr = (blkCtr / 8);
-
-		while (rndCtr != 0)
-		{
-			// 8 blocks
-			m_blockCipher->Transform1024(Input, InOffset, Output, OutOffset);
-			InOffset += AVX2BLK;
-			OutOffset += AVX2BLK;
-			blkCtr -= 8;
-			--rndCtr;
-		}
-	}
-#elif defined(__AVX__)
-	if (blkCtr > 3)
-	{
-		// 128bit sse3
-		const size_t AVXBLK = 64;
-		size_t rndCtr = (blkCtr / 4);
-
-		while (rndCtr != 0)
-		{
-			// 4 blocks
-			m_blockCipher->Transform512(Input, InOffset, Output, OutOffset);
-			InOffset += AVXBLK;
-			OutOffset += AVXBLK;
-			blkCtr -= 4;
-			--rndCtr;
-		}
-	}
-#endif
-
-	while (blkCtr != 0)
-	{
-		m_blockCipher->Transform(Input, InOffset, Output, OutOffset);
-		InOffset += BLOCK_SIZE;
-		OutOffset += BLOCK_SIZE;
-		--blkCtr;
-	}
-}
-
 void ECB::Scope()
 {
 	if (!m_parallelProfile.IsDefault())
@@ -292,25 +216,16 @@ void ECB::Scope()
 	}
 }
 
-void ECB::ProcessParallel(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
-{
-	const size_t SEGLEN = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
-	const size_t BLKCNT = (SEGLEN / BLOCK_SIZE);
-
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, SEGLEN, BLKCNT](size_t i)
-	{
-		this->Generate(Input, InOffset + (i * SEGLEN), Output, OutOffset + (i * SEGLEN), BLKCNT);
-	});
-}
-
-void ECB::ProcessSequential(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+template <typename ArrayA, typename ArrayB>
+void ECB::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
 {
 	const size_t BLKCNT = Length / BLOCK_SIZE;
 
-	for (size_t i = 0; i < BLKCNT; ++i)
+	// the blocks are independent, each segment is transformed directly with the wide kernels
+	BlockScheduler::Schedule(m_parallelProfile, BLKCNT, [this, &Input, InOffset, &Output, OutOffset](size_t, size_t BlockOffset, size_t BlockCount)
 	{
-		m_blockCipher->Transform(Input, InOffset + (i * BLOCK_SIZE), Output, OutOffset + (i * BLOCK_SIZE));
-	}
+		BlockScheduler::Transform(m_blockCipher.get(), Input.data() + InOffset + (BlockOffset * BLOCK_SIZE), Output.data() + OutOffset + (BlockOffset * BLOCK_SIZE), BlockCount);
+	});
 }
 
 NAMESPACE_MODEEND
@@ -40,13 +40,16 @@ NAMESPACE_ROUTING
 /// 		Enumeration::PaddingModes::PKCS7);
 /// 
 /// 	SampleEvent evt;
-/// 	cs.ProgressPercent += &evt.Completed;
+/// 	ProgressNotifier ntf(cs.Progress());
+/// 	ntf.ProgressPercent += &evt.LCompleted;
 /// 	std:vector&lt;byte&gt; key(32);
 /// 	std:vector&lt;byte&gt; iv(16);
 /// 	cs.Initialize(true, Key::Symmetric::SymmetricKey(key, iv));
 /// 	std:vector&lt;byte&gt; data(32000);
 /// 	std:vector&lt;byte&gt; vret(32000);
+/// 	ntf.Start();
 /// 	cs.Write(data, 0, vret, 0);
+/// 	ntf.Stop();
 /// }
 /// </code>
 /// </example>
@@ -1,4 +1,8 @@
 #include "GCM.h"
+#if defined(__AVX__)
+#	include "AHX.h"
+#endif
+#include "ArraySpan.h"
 #include "IntUtils.h"
 #include "SymmetricKey.h"
 
@@ -24,6 +28,7 @@ GCM::GCM(BlockCiphers CipherType)
 	m_gcmKey(0),
 	m_gcmNonce(0),
 	m_gcmVector(0),
+	m_hasStitch(false),
 	m_isDestroyed(false),
 	m_isEncryption(false),
 	m_isFinalized(false),
@@ -53,6 +58,7 @@ GCM::GCM(IBlockCipher* Cipher)
 	m_gcmKey(0),
 	m_gcmNonce(0),
 	m_gcmVector(0),
+	m_hasStitch(false),
 	m_isDestroyed(false),
 	m_isEncryption(false),
 	m_isFinalized(false),
@@ -76,6 +82,7 @@ GCM::~GCM()
 		m_aadSize = 0;
 		m_autoIncrement = false;
 		m_cipherType = BlockCiphers::None;
+		m_hasStitch = false;
 		m_isEncryption = false;
 		m_isFinalized = false;
 		m_isInitialized = false;
@@ -201,6 +208,11 @@ const std::vector<byte> GCM::Tag()
 
 //~~~Public Functions~~~//
 
+bool GCM::DecryptBatch(std::vector<BatchPacket> &Packets)
+{
+	return ProcessBatch(Packets, false);
+}
+
 void GCM::DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
 {
 	Decrypt128(Input, 0, Output, 0);
@@ -211,6 +223,11 @@ void GCM::DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 	Decrypt128(Input, InOffset, Output, OutOffset);
 }
 
+void GCM::EncryptBatch(std::vector<BatchPacket> &Packets)
+{
+	ProcessBatch(Packets, true);
+}
+
 void GCM::EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
 {
 	Encrypt128(Input, 0, Output, 0);
@@ -279,6 +296,17 @@ void GCM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 
 		m_gcmHash->Initialize(gKey);
 		m_gcmKey = KeyParams.Key();
+
+#if defined(__AVX2__)
+		// the stitched kernel requires the aes-ni engine and carry-less multiplication
+		m_hasStitch = m_gcmHash->HasSimd128() && dynamic_cast<Cipher::Symmetric::Block::AHX*>(m_cipherMode->Engine()) != nullptr;
+#endif
+	}
+
+	if (m_isInitialized)
+	{
+		// a new nonce starts a new message, discard the state of an unfinished one
+		Reset();
 	}
 
 	m_isEncryption = Encryption;
@@ -338,15 +366,45 @@ void GCM::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
 
-	if (m_isEncryption)
+	const size_t PRCLEN = (Length != 0) ? ProcessStitched(Input.data() + InOffset, Output.data() + OutOffset, Length) : 0;
+	const size_t RMDLEN = Length - PRCLEN;
+
+	if (RMDLEN != 0)
 	{
-		m_cipherMode->Transform(Input, InOffset, Output, OutOffset, Length);
-		m_gcmHash->Update(Output, OutOffset, m_checkSum, Length);
+		if (m_isEncryption)
+		{
+			m_cipherMode->Transform(Input, InOffset + PRCLEN, Output, OutOffset + PRCLEN, RMDLEN);
+			UpdateHash(Output.data() + OutOffset + PRCLEN, RMDLEN);
+		}
+		else
+		{
+			UpdateHash(Input.data() + InOffset + PRCLEN, RMDLEN);
+			m_cipherMode->Transform(Input, InOffset + PRCLEN, Output, OutOffset + PRCLEN, RMDLEN);
+		}
 	}
-	else
+
+	m_msgSize += Length;
+}
+
+void GCM::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+
+	const size_t PRCLEN = ProcessStitched(Input, Output, Length);
+	const size_t RMDLEN = Length - PRCLEN;
+
+	if (RMDLEN != 0)
 	{
-		m_gcmHash->Update(Input, InOffset, m_checkSum, Length);
-		m_cipherMode->Transform(Input, InOffset, Output, OutOffset, Length);
+		if (m_isEncryption)
+		{
+			m_cipherMode->Transform(Input + PRCLEN, Output + PRCLEN, RMDLEN);
+			UpdateHash(Output + PRCLEN, RMDLEN);
+		}
+		else
+		{
+			UpdateHash(Input + PRCLEN, RMDLEN);
+			m_cipherMode->Transform(Input + PRCLEN, Output + PRCLEN, RMDLEN);
+		}
 	}
 
 	m_msgSize += Length;
@@ -411,6 +469,146 @@ void GCM::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	m_msgSize += BLOCK_SIZE;
 }
 
+bool GCM::ProcessBatch(std::vector<BatchPacket> &Packets, bool Encryption)
+{
+	const size_t PKTCNT = Packets.size();
+	const std::vector<byte> ZEROES(BLOCK_SIZE);
+	std::vector<CTR::BatchPacket> ctrLanes(PKTCNT * 2);
+	std::vector<byte> ctrBlocks(PKTCNT * 2 * BLOCK_SIZE);
+	std::vector<Mac::GHASH::HashLane> hshLanes(PKTCNT);
+	std::vector<byte> pktHash(PKTCNT * BLOCK_SIZE);
+	std::vector<byte> pktMask(PKTCNT * BLOCK_SIZE);
+	std::vector<byte> ctrBlk(BLOCK_SIZE);
+	bool isVerified = true;
+
+	for (size_t i = 0; i < PKTCNT; ++i)
+	{
+		BatchPacket &pkt = Packets[i];
+
+		if (pkt.Session == nullptr || pkt.Session->m_gcmKey.size() == 0)
+		{
+			throw CryptoCipherModeException("GCM:ProcessBatch", "The packet session has not been keyed!");
+		}
+		if (pkt.NonceSize < 8)
+		{
+			throw CryptoCipherModeException("GCM:ProcessBatch", "Requires a nonce of minimum 8 bytes in length!");
+		}
+		if (pkt.TagSize < MIN_TAGSIZE || pkt.TagSize > BLOCK_SIZE)
+		{
+			throw CryptoCipherModeException("GCM:ProcessBatch", "The tag size must be between 12 and 16 bytes!");
+		}
+
+		// the pre-counter block; a 12 byte nonce is used directly, other sizes are hashed
+		Utility::MemUtils::Clear(ctrBlk, 0, BLOCK_SIZE);
+
+		if (pkt.NonceSize == 12)
+		{
+			std::memcpy(ctrBlk.data(), pkt.Nonce, pkt.NonceSize);
+			ctrBlk[15] = 1;
+		}
+		else
+		{
+			std::vector<byte> lenBlk(BLOCK_SIZE);
+			pkt.Session->m_gcmHash->ProcessSegment(Utility::ArraySpan<const byte>(pkt.Nonce, pkt.NonceSize), 0, ctrBlk, pkt.NonceSize);
+			Utility::IntUtils::Be64ToBytes(8 * static_cast<ulong>(pkt.NonceSize), lenBlk, 8);
+			pkt.Session->m_gcmHash->ProcessBlock(lenBlk, 0, ctrBlk);
+		}
+
+		// the first key stream block masks the tag, the message is transformed from the next counter
+		CTR::BatchPacket &mskLane = ctrLanes[i * 2];
+		mskLane.Session = pkt.Session->m_cipherMode.get();
+		std::memcpy(ctrBlocks.data() + (i * 2 * BLOCK_SIZE), ctrBlk.data(), BLOCK_SIZE);
+		mskLane.Nonce = ctrBlocks.data() + (i * 2 * BLOCK_SIZE);
+		mskLane.Input = ZEROES.data();
+		mskLane.Output = pktMask.data() + (i * BLOCK_SIZE);
+		mskLane.Length = BLOCK_SIZE;
+
+		Utility::IntUtils::BeIncrement8(ctrBlk);
+		CTR::BatchPacket &msgLane = ctrLanes[(i * 2) + 1];
+		msgLane.Session = pkt.Session->m_cipherMode.get();
+		std::memcpy(ctrBlocks.data() + (((i * 2) + 1) * BLOCK_SIZE), ctrBlk.data(), BLOCK_SIZE);
+		msgLane.Nonce = ctrBlocks.data() + (((i * 2) + 1) * BLOCK_SIZE);
+		msgLane.Input = pkt.Input;
+		msgLane.Output = pkt.Output;
+		msgLane.Length = pkt.Length;
+		hshLanes[i] = { pkt.Session->m_gcmHash.get(), pkt.AdData, pkt.AdSize, Encryption ? pkt.Output : pkt.Input, pkt.Length, pktHash.data() + (i * BLOCK_SIZE) };
+	}
+
+	if (Encryption)
+	{
+		CTR::TransformBatch(ctrLanes);
+		Mac::GHASH::ProcessBatch(hshLanes);
+	}
+	else
+	{
+		Mac::GHASH::ProcessBatch(hshLanes);
+		CTR::TransformBatch(ctrLanes);
+	}
+
+	for (size_t i = 0; i < PKTCNT; ++i)
+	{
+		BatchPacket &pkt = Packets[i];
+		byte* pktTag = pktHash.data() + (i * BLOCK_SIZE);
+
+		for (size_t j = 0; j < BLOCK_SIZE; ++j)
+		{
+			pktTag[j] ^= pktMask[(i * BLOCK_SIZE) + j];
+		}
+
+		if (Encryption)
+		{
+			std::memcpy(pkt.Tag, pktTag, pkt.TagSize);
+		}
+		else
+		{
+			byte tagDiff = 0;
+
+			for (size_t j = 0; j < pkt.TagSize; ++j)
+			{
+				tagDiff |= static_cast<byte>(pkt.Tag[j] ^ pktTag[j]);
+			}
+
+			pkt.IsVerified = (tagDiff == 0);
+
+			if (!pkt.IsVerified)
+			{
+				if (pkt.Length != 0)
+				{
+					std::memset(pkt.Output, 0, pkt.Length);
+				}
+
+				isVerified = false;
+			}
+		}
+	}
+
+	Utility::MemUtils::Clear(ctrBlk, 0, ctrBlk.size());
+	Utility::MemUtils::Clear(pktHash, 0, pktHash.size());
+	Utility::MemUtils::Clear(pktMask, 0, pktMask.size());
+
+	return isVerified;
+}
+
+size_t GCM::ProcessStitched(const byte* Input, byte* Output, size_t Length)
+{
+	size_t prcLen = 0;
+
+#if defined(__AVX2__)
+	const size_t STRLEN = 8 * BLOCK_SIZE;
+	// large inputs are left to the multi-threaded counter mode
+	const bool ISPRL = m_cipherMode->ParallelProfile().IsParallel() && Length >= m_cipherMode->ParallelProfile().ParallelBlockSize();
+
+	if (m_hasStitch && !ISPRL && Length >= STRLEN && m_msgSize % BLOCK_SIZE == 0)
+	{
+		Cipher::Symmetric::Block::AHX* cprPtr = static_cast<Cipher::Symmetric::Block::AHX*>(m_cipherMode->Engine());
+		prcLen = Length - (Length % STRLEN);
+		m_gcmHash->ProcessCtr(cprPtr->RoundKeys(), m_cipherMode->Counter(), Input, Output, prcLen, m_isEncryption, m_checkSum);
+	}
+#endif
+
+	return prcLen;
+}
+
 void GCM::Reset()
 {
 	if (!m_aadPreserve)
@@ -431,6 +629,28 @@ void GCM::Reset()
 	m_msgSize = 0;
 }
 
+void GCM::UpdateHash(const byte* Input, size_t Length)
+{
+	const size_t PRLBLK = m_cipherMode->ParallelProfile().ParallelBlockSize();
+	const size_t PRLDEG = m_cipherMode->ParallelProfile().ParallelMaxDegree();
+
+	if (m_cipherMode->ParallelProfile().IsParallel() && PRLDEG > 1 && Length >= PRLBLK && m_msgSize % BLOCK_SIZE == 0)
+	{
+		// hash segments of the block aligned input in parallel, the tail is buffered by the sequential update
+		const size_t PRLLEN = Length - (Length % BLOCK_SIZE);
+		m_gcmHash->ParallelUpdate(Input, m_checkSum, PRLLEN, PRLDEG);
+
+		if (PRLLEN != Length)
+		{
+			m_gcmHash->Update(Utility::ArraySpan<const byte>(Input + PRLLEN, Length - PRLLEN), 0, m_checkSum, Length - PRLLEN);
+		}
+	}
+	else
+	{
+		m_gcmHash->Update(Utility::ArraySpan<const byte>(Input, Length), 0, m_checkSum, Length);
+	}
+}
+
 void GCM::Scope()
 {
 	std::vector<SymmetricKeySize> keySizes = m_cipherMode->LegalKeySizes();
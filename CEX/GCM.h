@@ -73,6 +73,23 @@ NAMESPACE_MODE
 /// </code>
 /// </example>
 /// 
+/// <example>
+/// <description>Encrypting a batch of packets with per-session keys:</description>
+/// <code>
+/// // one keyed instance per session
+/// GCM session(BlockCiphers::AHX);
+/// session.Initialize(true, SymmetricKey(Key, Nonce));
+///
+/// std::vector&lt;GCM::BatchPacket&gt; packets(count);
+/// for (size_t i = 0; i &lt; count; ++i)
+/// {
+///     packets[i] = { &amp;session, nonces[i].data(), 12, headers[i].data(), headers[i].size(), input[i].data(), output[i].data(), input[i].size(), tags[i].data(), 16, false };
+/// }
+///
+/// GCM::EncryptBatch(packets);
+/// </code>
+/// </example>
+///
 /// <remarks>
 /// <description><B>Overview:</B></description>
 /// <para>
@@ -104,6 +121,7 @@ NAMESPACE_MODE
 ///
 /// <description><B>Multi-Threading:</B></description>
 /// <para>The encryption and decryption functions of GCM mode can be multi-threaded. This is achieved by processing multiple blocks of message input independently across threads. \n
+/// The authentication is also multi-threaded; the cipher-text is divided into ParallelMaxDegree() segments that are hashed independently, and the segment hashes are combined with powers of the hash key, producing the same tag as the sequential path. \n
 /// The GCM parallel mode also leverages SIMD instructions to 'double parallelize' those segments. An input block assigned to a thread
 /// uses SIMD instructions to decrypt/encrypt 4 or 8 blocks in parallel per cycle, depending on which framework is runtime available, 128 or 256 SIMD instructions. \n
 /// Input blocks equal to, or divisble by the ParallelBlockSize() are processed in parallel on supported systems.
@@ -116,10 +134,12 @@ NAMESPACE_MODE
 /// <item><description>Calling the Finalize(Output, Offset, Length) function writes the MAC code to the output array in either encryption or decryption operation mode.</description></item>
 /// <item><description>The Verify(Input, Offset, Length) function can be used to compare the MAC code embedded with the cipher-text to the internal MAC code generated after a Decryption cycle.</description></item>
 /// <item><description>Encryption and decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded.</description></item>
+/// <item><description>With the AES-NI engine (AHX) and carry-less multiply, sequential input is processed by a stitched kernel; the AES rounds of 8 counter blocks are interleaved with the GHASH of the previous 8 cipher-text blocks, which are reduced once per 8 blocks using the powers H^1..H^8.</description></item>
 /// <item><description>If the system supports Parallel processing, and IsParallel() is set to true; passing an input block of ParallelBlockSize() to the transform will be auto parallelized.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
 /// <item><description>Parallel block calculation ex. <c>ParallelBlockSize = N - (N % ParallelMinimumSize);</c></description></item>
+/// <item><description>EncryptBatch and DecryptBatch process many short packets with independent keys and nonces; each packet names a keyed GCM session, and the sessions are not changed, so one session can serve many packets of a batch.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -131,6 +151,71 @@ NAMESPACE_MODE
 /// </remarks>
 class GCM final : public IAeadMode
 {
+public:
+
+	//~~~Structs~~~//
+
+	/// <summary>
+	/// A packet transformed by the EncryptBatch and DecryptBatch functions
+	/// </summary>
+	struct BatchPacket
+	{
+		/// <summary>
+		/// A GCM instance keyed with the key of the packet; the message state of the instance is not used or changed
+		/// </summary>
+		GCM* Session;
+
+		/// <summary>
+		/// A pointer to the nonce of the packet
+		/// </summary>
+		const byte* Nonce;
+
+		/// <summary>
+		/// The nonce size in bytes; a minimum of 8 bytes, a 12 byte nonce is used directly as the counter
+		/// </summary>
+		size_t NonceSize;
+
+		/// <summary>
+		/// A pointer to the associated data; can be null if the size is zero
+		/// </summary>
+		const byte* AdData;
+
+		/// <summary>
+		/// The number of associated data bytes
+		/// </summary>
+		size_t AdSize;
+
+		/// <summary>
+		/// A pointer to the input bytes
+		/// </summary>
+		const byte* Input;
+
+		/// <summary>
+		/// A pointer to the output bytes; can be the same address as the input
+		/// </summary>
+		byte* Output;
+
+		/// <summary>
+		/// The number of bytes to transform
+		/// </summary>
+		size_t Length;
+
+		/// <summary>
+		/// A pointer to the tag; written by EncryptBatch, and compared with the calculated tag by DecryptBatch
+		/// </summary>
+		byte* Tag;
+
+		/// <summary>
+		/// The tag size in bytes, between 12 and 16
+		/// </summary>
+		size_t TagSize;
+
+		/// <summary>
+		/// Set by DecryptBatch; true if the tag of the packet was verified
+		/// </summary>
+		bool IsVerified;
+	};
+
 private:
 
 	static const size_t BLOCK_SIZE = 16;
@@ -151,6 +236,7 @@ private:
 	std::vector<byte> m_gcmKey;
 	std::vector<byte> m_gcmNonce;
 	std::vector<byte> m_gcmVector;
+	bool m_hasStitch;
 	bool m_isDestroyed;
 	bool m_isEncryption;
 	bool m_isFinalized;
@@ -300,6 +386,19 @@ public:
 
 	//~~~Public Functions~~~//
 
+	/// <summary>
+	/// Decrypt and verify a batch of independent packets, each with its own key and nonce.
+	/// <para>The packets are processed as by EncryptBatch; the cipher-text is hashed before it is decrypted, so a packet can be decrypted in place.
+	/// The output of a packet that fails verification is set to zero.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The packets to decrypt; the IsVerified member of each packet is set</param>
+	///
+	/// <returns>Returns false if the tag of any packet does not match</returns>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a session has not been keyed, or a nonce or tag size is invalid</exception>
+	static bool DecryptBatch(std::vector<BatchPacket> &Packets);
+
 	/// <summary>
 	/// Decrypt a single block of bytes.
 	/// <para>Decrypts one block of bytes beginning at a zero index.
@@ -322,6 +421,18 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	void DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Encrypt a batch of independent packets, each with its own key and nonce, and write the tag of each packet.
+	/// <para>Each packet is encrypted as by initializing its session with the nonce, adding the associated data, transforming the input, and finalizing the tag.
+	/// With the AES-NI engine (AHX), one counter block from each of up to 8 packets is processed per round, and the GHASH of up to 8 packets is interleaved,
+	/// so short packets are processed at close to the rate of a single long message.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The packets to encrypt</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a session has not been keyed, or a nonce or tag size is invalid</exception>
+	static void EncryptBatch(std::vector<BatchPacket> &Packets);
+
 	/// <summary>
 	/// Encrypt a single block of bytes. 
 	/// <para>Encrypts one block of bytes beginning at a zero index.
@@ -408,6 +519,18 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
 	/// <summary>
 	/// Generate the internal MAC code and compare it with the tag contained in the Input array.   
 	/// <para>This function finalizes the Decryption cycle and generates the MAC tag.
@@ -431,8 +554,11 @@ private:
 	void CalculateMac();
 	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	static bool ProcessBatch(std::vector<BatchPacket> &Packets, bool Encryption);
+	size_t ProcessStitched(const byte* Input, byte* Output, size_t Length);
 	void Reset();
 	void Scope();
+	void UpdateHash(const byte* Input, size_t Length);
 };
 
 NAMESPACE_MODEEND
@@ -1,6 +1,8 @@
 #include "GHASH.h"
+#include "ArraySpan.h"
 #include "CpuDetect.h"
 #include "IntUtils.h"
+#include "ParallelUtils.h"
 #if defined(__AVX2__)
 #	include "Intrinsics.h"
 #	include <wmmintrin.h>
@@ -15,6 +17,7 @@ const std::string GHASH::CLASS_NAME("GHASH");
 GHASH::GHASH()
 	:
 	m_ghashKey(0),
+	m_ghashPowers(0),
 	m_hasCMul(false),
 	m_msgBuffer(BLOCK_SIZE),
 	m_msgOffset(0)
@@ -60,79 +63,391 @@ void GHASH::Initialize(const std::vector<ulong> &Key)
 {
 	m_ghashKey.resize(Key.size());
 	std::memcpy(&m_ghashKey[0], &Key[0], Key.size() * sizeof(ulong));
-}
 
-void GHASH::ProcessBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output)
-{
-	Utility::MemUtils::XOR128(Input, InOffset, Output, 0);
-	GcmMultiply(Output);
+	if (m_hasCMul)
+	{
+		// the powers H^1..H^8 used by the aggregated reduction in the stitched counter mode
+		std::vector<byte> tmpH(BLOCK_SIZE);
+		Utility::IntUtils::Be64ToBytes(m_ghashKey[0], tmpH, 0);
+		Utility::IntUtils::Be64ToBytes(m_ghashKey[1], tmpH, 8);
+		m_ghashPowers.resize(STITCH_BLOCKS * 2);
+
+		for (size_t i = 0; i < STITCH_BLOCKS; ++i)
+		{
+			m_ghashPowers[i * 2] = Utility::IntUtils::BeBytesTo64(tmpH, 0);
+			m_ghashPowers[(i * 2) + 1] = Utility::IntUtils::BeBytesTo64(tmpH, 8);
+			GcmMultiply(tmpH);
+		}
+
+		Utility::MemUtils::Clear(tmpH, 0, tmpH.size());
+	}
 }
 
-void GHASH::ProcessSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t Length)
+void GHASH::ParallelUpdate(const byte* Input, std::vector<byte> &Output, size_t Length, size_t Degree)
 {
-	while (Length != 0)
+	CexAssert(Length % BLOCK_SIZE == 0, "the length must be a multiple of the block size");
+	CexAssert(Degree != 0, "the parallel degree can not be zero");
+
+	// a completed block held in the message buffer precedes this input
+	if (m_msgOffset == BLOCK_SIZE)
 	{
-		const size_t DIFFLEN = Utility::IntUtils::Min(Length, BLOCK_SIZE);
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, 0, DIFFLEN);
-		GcmMultiply(Output);
-		InOffset += DIFFLEN;
-		Length -= DIFFLEN;
+		ProcessBlock(m_msgBuffer, 0, Output);
+		m_msgOffset = 0;
+	}
+
+	CexAssert(m_msgOffset == 0, "the hash is not block aligned");
+
+	const size_t BLKCNT = Length / BLOCK_SIZE;
+	const size_t SEGBLK = (BLKCNT + Degree - 1) / Degree;
+	const size_t SEGLEN = SEGBLK * BLOCK_SIZE;
+	const size_t SEGCNT = (SEGBLK != 0) ? (BLKCNT + SEGBLK - 1) / SEGBLK : 0;
+	std::vector<std::vector<byte>> segHash(SEGCNT, std::vector<byte>(BLOCK_SIZE));
+
+	Utility::ParallelUtils::ParallelFor(0, SEGCNT, [this, Input, Length, SEGLEN, &segHash](size_t i)
+	{
+		const size_t SEGOFT = i * SEGLEN;
+		const size_t PRCLEN = Utility::IntUtils::Min(SEGLEN, Length - SEGOFT);
+		ProcessSegment(Utility::ArraySpan<const byte>(Input + SEGOFT, PRCLEN), 0, segHash[i], PRCLEN);
+	});
+
+	// Y = Y * H^m ^ S for each segment in order; only the last segment may be shorter
+	std::vector<ulong> segPow;
+	GcmPower(SEGBLK, segPow);
+
+	for (size_t i = 0; i < SEGCNT; ++i)
+	{
+		const size_t PRCBLK = Utility::IntUtils::Min(SEGBLK, BLKCNT - (i * SEGBLK));
+
+		if (PRCBLK != SEGBLK)
+		{
+			GcmPower(PRCBLK, segPow);
+		}
+
+		GcmMultiply(segPow, Output);
+		Utility::MemUtils::XOR128(segHash[i], 0, Output, 0);
+		Utility::MemUtils::Clear(segHash[i], 0, BLOCK_SIZE);
 	}
+
+	Utility::MemUtils::Clear(segPow, 0, segPow.size() * sizeof(ulong));
 }
 
-void GHASH::Reset(bool Erase)
+void GHASH::ProcessBatch(std::vector<HashLane> &Lanes)
 {
-	if (Erase)
+	std::vector<size_t> wdeLanes;
+
+	for (size_t i = 0; i < Lanes.size(); ++i)
 	{
-		if (m_ghashKey.size() != 0)
+		HashLane &lane = Lanes[i];
+
+#if defined(__AVX2__)
+		if (lane.Hash->m_hasCMul && lane.Hash->m_ghashPowers.size() == STITCH_BLOCKS * 2)
 		{
-			Utility::MemUtils::Clear(m_ghashKey, 0, m_ghashKey.size() * sizeof(ulong));
+			wdeLanes.push_back(i);
+			continue;
 		}
+#endif
 
-		m_hasCMul = false;
+		std::vector<byte> lenBlk(BLOCK_SIZE);
+		std::vector<byte> tmpH(BLOCK_SIZE);
+
+		if (lane.AdSize != 0)
+		{
+			lane.Hash->ProcessSegment(Utility::ArraySpan<const byte>(lane.AdData, lane.AdSize), 0, tmpH, lane.AdSize);
+		}
+
+		if (lane.Length != 0)
+		{
+			lane.Hash->ProcessSegment(Utility::ArraySpan<const byte>(lane.Input, lane.Length), 0, tmpH, lane.Length);
+		}
+
+		Utility::IntUtils::Be64ToBytes(8 * static_cast<ulong>(lane.AdSize), lenBlk, 0);
+		Utility::IntUtils::Be64ToBytes(8 * static_cast<ulong>(lane.Length), lenBlk, 8);
+		lane.Hash->ProcessBlock(lenBlk, 0, tmpH);
+		std::memcpy(lane.Output, tmpH.data(), BLOCK_SIZE);
+		Utility::MemUtils::Clear(tmpH, 0, tmpH.size());
 	}
 
-	if (m_msgBuffer.size() != 0)
+#if defined(__AVX2__)
+	if (wdeLanes.size() == 0)
 	{
-		Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+		return;
 	}
 
-	m_msgOffset = 0;
+	const __m128i MASK = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i ZERO = _mm_setzero_si128();
+	const ulong* hPow[BATCH_LANES];
+	__m128i Y[BATCH_LANES];
+	size_t lnsAdBlock[BATCH_LANES];
+	size_t lnsBlock[BATCH_LANES];
+	size_t lnsCount[BATCH_LANES];
+	size_t lnsIndex[BATCH_LANES];
+	size_t lnsMsgBlock[BATCH_LANES];
+	byte tmpB[BLOCK_SIZE];
+	__m128i C, L, M, H;
+
+	auto loadLane = [&Lanes, &hPow, &Y, &lnsAdBlock, &lnsBlock, &lnsCount, &lnsIndex, &lnsMsgBlock, &ZERO](size_t Slot, size_t Index)
+	{
+		const HashLane &lane = Lanes[Index];
+
+		hPow[Slot] = lane.Hash->m_ghashPowers.data();
+		Y[Slot] = ZERO;
+		lnsAdBlock[Slot] = (lane.AdSize + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		lnsBlock[Slot] = 0;
+		lnsCount[Slot] = lnsAdBlock[Slot] + ((lane.Length + BLOCK_SIZE - 1) / BLOCK_SIZE) + 1;
+		lnsIndex[Slot] = Index;
+		lnsMsgBlock[Slot] = lane.Length / BLOCK_SIZE;
+	};
+
+	// the associated data, a partial message block, or the length block
+	auto loadBlock = [&Lanes, &tmpB, &MASK](size_t Index, size_t AdBlocks, size_t Block)
+	{
+		const HashLane &lane = Lanes[Index];
+		const byte* blkPtr;
+		size_t blkLen;
+
+		if (Block < AdBlocks)
+		{
+			blkPtr = lane.AdData + (Block * BLOCK_SIZE);
+			blkLen = Utility::IntUtils::Min(BLOCK_SIZE, lane.AdSize - (Block * BLOCK_SIZE));
+		}
+		else if (((Block - AdBlocks) * BLOCK_SIZE) < lane.Length)
+		{
+			blkPtr = lane.Input + ((Block - AdBlocks) * BLOCK_SIZE);
+			blkLen = Utility::IntUtils::Min(BLOCK_SIZE, lane.Length - ((Block - AdBlocks) * BLOCK_SIZE));
+		}
+		else
+		{
+			// the byte reversed length block
+			return _mm_set_epi64x(static_cast<long long>(8 * static_cast<ulong>(lane.AdSize)), static_cast<long long>(8 * static_cast<ulong>(lane.Length)));
+		}
+
+		if (blkLen != BLOCK_SIZE)
+		{
+			std::memset(tmpB, 0, BLOCK_SIZE);
+			std::memcpy(tmpB, blkPtr, blkLen);
+			blkPtr = tmpB;
+		}
+
+		return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blkPtr)), MASK);
+	};
+
+	size_t actCnt = 0;
+	size_t nxtLane = 0;
+
+	while (actCnt != BATCH_LANES && nxtLane != wdeLanes.size())
+	{
+		loadLane(actCnt, wdeLanes[nxtLane]);
+		++actCnt;
+		++nxtLane;
+	}
+
+	while (actCnt != 0)
+	{
+		// up to 8 blocks of each message are multiplied by H^k..H^1 and reduced once
+		for (size_t i = 0; i < actCnt; ++i)
+		{
+			const size_t BLKCNT = Utility::IntUtils::Min(STITCH_BLOCKS, lnsCount[i] - lnsBlock[i]);
+			const size_t ADBLK = lnsAdBlock[i];
+			L = ZERO;
+			M = ZERO;
+			H = ZERO;
+
+			if (lnsBlock[i] >= ADBLK && lnsBlock[i] + BLKCNT <= ADBLK + lnsMsgBlock[i])
+			{
+				// whole message blocks are loaded directly
+				const byte* blkPtr = Lanes[lnsIndex[i]].Input + ((lnsBlock[i] - ADBLK) * BLOCK_SIZE);
+
+				for (size_t j = 0; j < BLKCNT; ++j)
+				{
+					C = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blkPtr + (j * BLOCK_SIZE))), MASK);
+					C = (j == 0) ? _mm_xor_si128(C, Y[i]) : C;
+					// the stored power with its words swapped is the byte reversed field element
+					MultiplyAccumulate(C, _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hPow[i] + ((BLKCNT - 1 - j) * 2))), 0x4E), L, M, H);
+				}
+			}
+			else
+			{
+				for (size_t j = 0; j < BLKCNT; ++j)
+				{
+					C = loadBlock(lnsIndex[i], ADBLK, lnsBlock[i] + j);
+					C = (j == 0) ? _mm_xor_si128(C, Y[i]) : C;
+					MultiplyAccumulate(C, _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hPow[i] + ((BLKCNT - 1 - j) * 2))), 0x4E), L, M, H);
+				}
+			}
+
+			Y[i] = ReduceW(L, M, H);
+			lnsBlock[i] += BLKCNT;
+		}
+
+		// a completed message is replaced by the next, or by the last slot when the batch is exhausted
+		size_t slot = 0;
+
+		while (slot != actCnt)
+		{
+			if (lnsBlock[slot] != lnsCount[slot])
+			{
+				++slot;
+				continue;
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes[lnsIndex[slot]].Output), _mm_shuffle_epi8(Y[slot], MASK));
+
+			if (nxtLane != wdeLanes.size())
+			{
+				loadLane(slot, wdeLanes[nxtLane]);
+				++nxtLane;
+				++slot;
+			}
+			else
+			{
+				--actCnt;
+				hPow[slot] = hPow[actCnt];
+				Y[slot] = Y[actCnt];
+				lnsAdBlock[slot] = lnsAdBlock[actCnt];
+				lnsBlock[slot] = lnsBlock[actCnt];
+				lnsCount[slot] = lnsCount[actCnt];
+				lnsIndex[slot] = lnsIndex[actCnt];
+				lnsMsgBlock[slot] = lnsMsgBlock[actCnt];
+			}
+		}
+	}
+
+	std::memset(tmpB, 0, sizeof(tmpB));
+#endif
 }
 
-void GHASH::Update(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t Length)
+#if defined(__AVX2__)
+void GHASH::ProcessCtr(const std::vector<__m128i> &RoundKeys, std::vector<byte> &Counter, const byte* Input, byte* Output, size_t Length, bool Encryption, std::vector<byte> &Hash)
 {
-	if (Length != 0)
+	CexAssert(m_hasCMul && m_ghashPowers.size() == STITCH_BLOCKS * 2, "carry-less multiplication is not available on this system");
+	CexAssert(Counter.size() == BLOCK_SIZE, "the counter must be 16 bytes in length");
+	CexAssert(RoundKeys.size() > STITCH_BLOCKS + 1, "the round key count is too small");
+	CexAssert(Length % (STITCH_BLOCKS * BLOCK_SIZE) == 0, "the length must be a multiple of the stride size");
+
+	const size_t STRLEN = STITCH_BLOCKS * BLOCK_SIZE;
+	const size_t RNDCNT = RoundKeys.size() - 1;
+	const __m128i MASK = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i ZERO = _mm_setzero_si128();
+	__m128i hPow[STITCH_BLOCKS];
+	__m128i X[STITCH_BLOCKS];
+	__m128i C, L, M, H, Y;
+
+	// a completed block held in the message buffer precedes this input
+	if (m_msgOffset == BLOCK_SIZE)
+	{
+		ProcessBlock(m_msgBuffer, 0, Hash);
+		m_msgOffset = 0;
+	}
+
+	CexAssert(m_msgOffset == 0, "the hash is not block aligned");
+
+	// the first block of a stride is multiplied by H^8, the last by H^1
+	for (size_t i = 0; i < STITCH_BLOCKS; ++i)
+	{
+		C = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_ghashPowers[(STITCH_BLOCKS - 1 - i) * 2]));
+		C = _mm_shuffle_epi8(C, _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7));
+		hPow[i] = _mm_shuffle_epi8(C, MASK);
+	}
+
+	Y = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Hash.data())), MASK);
+	ulong ctrHigh = Utility::IntUtils::BeBytesTo64(Counter, 0);
+	ulong ctrLow = Utility::IntUtils::BeBytesTo64(Counter, 8);
+	size_t blkOft = 0;
+
+	while (blkOft != Length)
 	{
-		if (m_msgOffset == BLOCK_SIZE)
+		// encryption hashes the cipher-text written by the previous stride, decryption hashes the input stride
+		const byte* hshPtr = Encryption ? ((blkOft != 0) ? Output + blkOft - STRLEN : nullptr) : Input + blkOft;
+
+		for (size_t i = 0; i < STITCH_BLOCKS; ++i)
 		{
-			ProcessBlock(m_msgBuffer, 0, Output);
-			m_msgOffset = 0;
+			X[i] = _mm_xor_si128(_mm_shuffle_epi8(_mm_set_epi64x(static_cast<long long>(ctrHigh), static_cast<long long>(ctrLow)), MASK), RoundKeys[0]);
+			++ctrLow;
+			ctrHigh += (ctrLow == 0) ? 1 : 0;
 		}
 
-		const size_t RMDLEN = BLOCK_SIZE - m_msgOffset;
-		if (Length > RMDLEN)
+		L = ZERO;
+		M = ZERO;
+		H = ZERO;
+
+		for (size_t r = 1; r != RNDCNT; ++r)
 		{
-			Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgOffset, RMDLEN);
-			ProcessBlock(m_msgBuffer, 0, Output);
-			m_msgOffset = 0;
-			Length -= RMDLEN;
-			InOffset += RMDLEN;
+			for (size_t i = 0; i < STITCH_BLOCKS; ++i)
+			{
+				X[i] = _mm_aesenc_si128(X[i], RoundKeys[r]);
+			}
 
-			while (Length > BLOCK_SIZE)
+			// one cipher-text block is multiplied in each of the first eight rounds
+			if (hshPtr != nullptr && r <= STITCH_BLOCKS)
 			{
-				ProcessBlock(Input, InOffset, Output);
-				Length -= BLOCK_SIZE;
-				InOffset += BLOCK_SIZE;
+				C = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hshPtr + ((r - 1) * BLOCK_SIZE))), MASK);
+				C = (r == 1) ? _mm_xor_si128(C, Y) : C;
+				MultiplyAccumulate(C, hPow[r - 1], L, M, H);
 			}
 		}
 
-		if (Length > 0)
+		if (hshPtr != nullptr)
+		{
+			// one reduction per stride
+			Y = ReduceW(L, M, H);
+		}
+
+		for (size_t i = 0; i < STITCH_BLOCKS; ++i)
+		{
+			C = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Input + blkOft + (i * BLOCK_SIZE)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Output + blkOft + (i * BLOCK_SIZE)), _mm_xor_si128(_mm_aesenclast_si128(X[i], RoundKeys[RNDCNT]), C));
+		}
+
+		blkOft += STRLEN;
+	}
+
+	if (Encryption)
+	{
+		// the last cipher-text stride has no following stride to be stitched with
+		const byte* hshPtr = Output + Length - STRLEN;
+		L = ZERO;
+		M = ZERO;
+		H = ZERO;
+
+		for (size_t i = 0; i < STITCH_BLOCKS; ++i)
 		{
-			Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgOffset, Length);
-			m_msgOffset += Length;
+			C = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hshPtr + (i * BLOCK_SIZE))), MASK);
+			C = (i == 0) ? _mm_xor_si128(C, Y) : C;
+			MultiplyAccumulate(C, hPow[i], L, M, H);
 		}
+
+		Y = ReduceW(L, M, H);
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(Hash.data()), _mm_shuffle_epi8(Y, MASK));
+	Utility::IntUtils::Be64ToBytes(ctrHigh, Counter, 0);
+	Utility::IntUtils::Be64ToBytes(ctrLow, Counter, 8);
+}
+#endif
+
+void GHASH::Reset(bool Erase)
+{
+	if (Erase)
+	{
+		if (m_ghashKey.size() != 0)
+		{
+			Utility::MemUtils::Clear(m_ghashKey, 0, m_ghashKey.size() * sizeof(ulong));
+		}
+
+		if (m_ghashPowers.size() != 0)
+		{
+			Utility::MemUtils::Clear(m_ghashPowers, 0, m_ghashPowers.size() * sizeof(ulong));
+		}
+
+		m_hasCMul = false;
+	}
+
+	if (m_msgBuffer.size() != 0)
+	{
+		Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
 	}
+
+	m_msgOffset = 0;
 }
 
 void GHASH::Detect()
@@ -142,17 +457,56 @@ void GHASH::Detect()
 }
 
 void GHASH::GcmMultiply(std::vector<byte> &X)
+{
+	GcmMultiply(m_ghashKey, X);
+}
+
+void GHASH::GcmMultiply(const std::vector<ulong> &H, std::vector<byte> &X)
 {
 	if (m_hasCMul)
 	{
-		MultiplyW(m_ghashKey, X);
+		MultiplyW(H, X);
 	}
 	else
 	{
-		Multiply(m_ghashKey, X);
+		Multiply(H, X);
 	}
 }
 
+void GHASH::GcmPower(size_t Exponent, std::vector<ulong> &Output)
+{
+	// square and multiply; the field identity is the high bit of the first byte
+	std::vector<byte> tmpR(BLOCK_SIZE);
+	std::vector<byte> tmpS(BLOCK_SIZE);
+	std::vector<ulong> tmpB = m_ghashKey;
+	tmpR[0] = 0x80;
+
+	while (Exponent != 0)
+	{
+		if ((Exponent & 1) != 0)
+		{
+			GcmMultiply(tmpB, tmpR);
+		}
+
+		Exponent >>= 1;
+
+		if (Exponent != 0)
+		{
+			Utility::IntUtils::Be64ToBytes(tmpB[0], tmpS, 0);
+			Utility::IntUtils::Be64ToBytes(tmpB[1], tmpS, 8);
+			GcmMultiply(tmpB, tmpS);
+			tmpB[0] = Utility::IntUtils::BeBytesTo64(tmpS, 0);
+			tmpB[1] = Utility::IntUtils::BeBytesTo64(tmpS, 8);
+		}
+	}
+
+	Output.resize(2);
+	Output[0] = Utility::IntUtils::BeBytesTo64(tmpR, 0);
+	Output[1] = Utility::IntUtils::BeBytesTo64(tmpR, 8);
+	Utility::MemUtils::Clear(tmpB, 0, tmpB.size() * sizeof(ulong));
+	Utility::MemUtils::Clear(tmpS, 0, tmpS.size());
+}
+
 void GHASH::Multiply(const std::vector<ulong> &H, std::vector<byte> &X)
 {
 	const ulong X0 = Utility::IntUtils::BeBytesTo64(X, 0);
@@ -204,20 +558,42 @@ void GHASH::MultiplyW(const std::vector<ulong> &H, std::vector<byte> &X)
 	const __m128i MASK = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
 	__m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(X.data()));
 	__m128i B = _mm_loadu_si128(reinterpret_cast<const __m128i*>(H.data()));
-	__m128i T0, T1, T2, T3, T4, T5;
+	__m128i T0, T1, T2, T3;
 
 	A = _mm_shuffle_epi8(A, MASK);
 	B = _mm_shuffle_epi8(B, _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7));
 	B = _mm_shuffle_epi8(B, MASK);
-	T0 = _mm_clmulepi64_si128(A, B, 0x00);
-	T1 = _mm_clmulepi64_si128(A, B, 0x01);
-	T2 = _mm_clmulepi64_si128(A, B, 0x10);
-	T3 = _mm_clmulepi64_si128(A, B, 0x11);
-	T1 = _mm_xor_si128(T1, T2);
-	T2 = _mm_slli_si128(T1, 8);
-	T1 = _mm_srli_si128(T1, 8);
-	T0 = _mm_xor_si128(T0, T2);
-	T3 = _mm_xor_si128(T3, T1);
+	T0 = _mm_setzero_si128();
+	T1 = _mm_setzero_si128();
+	T2 = _mm_setzero_si128();
+	MultiplyAccumulate(A, B, T0, T1, T2);
+	T3 = ReduceW(T0, T1, T2);
+	T3 = _mm_shuffle_epi8(T3, MASK);
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(X.data()), T3);
+
+#else
+	Multiply(H, X);
+#endif
+}
+
+#if defined(__AVX2__)
+void GHASH::MultiplyAccumulate(const __m128i &X, const __m128i &H, __m128i &Low, __m128i &Middle, __m128i &High)
+{
+	// the unreduced product is linear, products can be summed and reduced once
+	Low = _mm_xor_si128(Low, _mm_clmulepi64_si128(X, H, 0x00));
+	Middle = _mm_xor_si128(Middle, _mm_xor_si128(_mm_clmulepi64_si128(X, H, 0x01), _mm_clmulepi64_si128(X, H, 0x10)));
+	High = _mm_xor_si128(High, _mm_clmulepi64_si128(X, H, 0x11));
+}
+
+__m128i GHASH::ReduceW(const __m128i &Low, const __m128i &Middle, const __m128i &High)
+{
+	__m128i T0, T1, T2, T3, T4, T5;
+
+	T2 = _mm_slli_si128(Middle, 8);
+	T1 = _mm_srli_si128(Middle, 8);
+	T0 = _mm_xor_si128(Low, T2);
+	T3 = _mm_xor_si128(High, T1);
 	T4 = _mm_srli_epi32(T0, 31);
 	T0 = _mm_slli_epi32(T0, 1);
 	T5 = _mm_srli_epi32(T3, 31);
@@ -244,13 +620,9 @@ void GHASH::MultiplyW(const std::vector<ulong> &H, std::vector<byte> &X)
 	T3 = _mm_xor_si128(T3, T1);
 	T3 = _mm_xor_si128(T3, T2);
 	T3 = _mm_xor_si128(T3, T4);
-	T3 = _mm_shuffle_epi8(T3, MASK);
 
-	_mm_storeu_si128(reinterpret_cast<__m128i*>(X.data()), T3);
-
-#else
-	Multiply(H, X);
-#endif
+	return T3;
 }
+#endif
 
 NAMESPACE_MACEND
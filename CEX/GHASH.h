@@ -2,6 +2,11 @@
 #define CEX_GHASH_H
 
 #include "CexDomain.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#if defined(__AVX2__)
+#	include <wmmintrin.h>
+#endif
 
 NAMESPACE_MAC
 
@@ -14,12 +19,55 @@ NAMESPACE_MAC
 /// </summary>
 class GHASH
 {
+public:
+
+	//~~~Structs~~~//
+
+	/// <summary>
+	/// A message hashed by the ProcessBatch function; the associated data and the cipher-text are each zero padded to the block size, and followed by the length block
+	/// </summary>
+	struct HashLane
+	{
+		/// <summary>
+		/// The keyed GHASH instance of the message; only the hash key is used
+		/// </summary>
+		GHASH* Hash;
+
+		/// <summary>
+		/// A pointer to the associated data; can be null if the size is zero
+		/// </summary>
+		const byte* AdData;
+
+		/// <summary>
+		/// The number of associated data bytes
+		/// </summary>
+		size_t AdSize;
+
+		/// <summary>
+		/// A pointer to the cipher-text
+		/// </summary>
+		const byte* Input;
+
+		/// <summary>
+		/// The number of cipher-text bytes
+		/// </summary>
+		size_t Length;
+
+		/// <summary>
+		/// A pointer to the 16 byte output receiving the hash
+		/// </summary>
+		byte* Output;
+	};
+
 private:
 
+	static const size_t BATCH_LANES = 8;
 	static const size_t BLOCK_SIZE = 16;
 	static const std::string CLASS_NAME;
+	static const size_t STITCH_BLOCKS = 8;
 
 	std::vector<ulong> m_ghashKey;
+	std::vector<ulong> m_ghashPowers;
 	bool m_hasCMul;
 	std::vector<byte> m_msgBuffer;
 	size_t m_msgOffset;
@@ -73,6 +121,28 @@ public:
 	/// <param name="Key">The ghash key</param>
 	void Initialize(const std::vector<ulong> &Key);
 
+	/// <summary>
+	/// Update the hash function with a large block aligned input, hashing segments of the input in parallel.
+	/// <para>The input is divided into Degree segments, and each segment is hashed from a zero state on its own thread.
+	/// GHASH is linear, the segment hashes are combined in order as Y = Y * H^m ^ S, where m is the segment length in blocks; the result is identical to a sequential update.
+	/// The hash must be block aligned (no partial block buffered).</para>
+	/// </summary>
+	///
+	/// <param name="Input">A pointer to the input bytes</param>
+	/// <param name="Output">The GHASH state</param>
+	/// <param name="Length">The number of bytes to process; must be a multiple of the 16 byte block size</param>
+	/// <param name="Degree">The number of segments processed in parallel</param>
+	void ParallelUpdate(const byte* Input, std::vector<byte> &Output, size_t Length, size_t Degree);
+
+	/// <summary>
+	/// Hash a batch of independent messages, each with its own key, from a zero state.
+	/// <para>With carry-less multiplication, up to 8 messages are hashed together; each step multiplies up to 8 blocks of a message by the powers of its key and reduces them once,
+	/// and the steps of different messages are independent, so their multiplies overlap. The message buffer of the instances is not used or changed.</para>
+	/// </summary>
+	///
+	/// <param name="Lanes">The messages to hash</param>
+	static void ProcessBatch(std::vector<HashLane> &Lanes);
+
 	/// <summary>
 	/// Process a block of plaintext
 	/// </summary>
@@ -80,7 +150,12 @@ public:
 	/// <param name="Input">The source array</param>
 	/// <param name="InOffset">The offset within the source array</param>
 	/// <param name="Output">The output array</param>
-	void ProcessBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output);
+	template<typename Array>
+	void ProcessBlock(const Array &Input, size_t InOffset, std::vector<byte> &Output)
+	{
+		Utility::MemUtils::XOR128(Input, InOffset, Output, 0);
+		GcmMultiply(Output);
+	}
 
 	/// <summary>
 	/// Process one segment of data
@@ -90,7 +165,36 @@ public:
 	/// <param name="InOffset">The offset within the source array</param>
 	/// <param name="Output">The output array</param>
 	/// <param name="Length">The number of bytes to process</param>
-	void ProcessSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t Length);
+	template<typename Array>
+	void ProcessSegment(const Array &Input, size_t InOffset, std::vector<byte> &Output, size_t Length)
+	{
+		while (Length != 0)
+		{
+			const size_t DIFFLEN = Utility::IntUtils::Min(Length, BLOCK_SIZE);
+			Utility::MemUtils::XorBlock(Input, InOffset, Output, 0, DIFFLEN);
+			GcmMultiply(Output);
+			InOffset += DIFFLEN;
+			Length -= DIFFLEN;
+		}
+	}
+
+#if defined(__AVX2__)
+	/// <summary>
+	/// Encrypt or decrypt a run of 8 block strides in AES counter mode, stitched with the GHASH of the cipher-text.
+	/// <para>The AES rounds of each stride are interleaved with the carry-less multiplies of the previous stride's cipher-text,
+	/// the 8 products are multiplied by the powers H^8..H^1 and summed, and reduced once per stride.
+	/// The hash must be block aligned (no partial block buffered), and the system must support carry-less multiplication.</para>
+	/// </summary>
+	///
+	/// <param name="RoundKeys">The expanded AES encryption key</param>
+	/// <param name="Counter">The 16 byte big endian counter; incremented once per block</param>
+	/// <param name="Input">A pointer to the input bytes</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to process; must be a multiple of 128 bytes</param>
+	/// <param name="Encryption">The cipher-text is the output (encryption), or the input (decryption)</param>
+	/// <param name="Hash">The GHASH state</param>
+	void ProcessCtr(const std::vector<__m128i> &RoundKeys, std::vector<byte> &Counter, const byte* Input, byte* Output, size_t Length, bool Encryption, std::vector<byte> &Hash);
+#endif
 
 	/// <summary>
 	/// Reset the hash function
@@ -107,14 +211,54 @@ public:
 	/// <param name="InOffset">The offset within the source array</param>
 	/// <param name="Output">The output array</param>
 	/// <param name="Length">The number of bytes to process</param>
-	void Update(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t Length);
+	template<typename Array>
+	void Update(const Array &Input, size_t InOffset, std::vector<byte> &Output, size_t Length)
+	{
+		if (Length != 0)
+		{
+			if (m_msgOffset == BLOCK_SIZE)
+			{
+				ProcessBlock(m_msgBuffer, 0, Output);
+				m_msgOffset = 0;
+			}
+
+			const size_t RMDLEN = BLOCK_SIZE - m_msgOffset;
+			if (Length > RMDLEN)
+			{
+				Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgOffset, RMDLEN);
+				ProcessBlock(m_msgBuffer, 0, Output);
+				m_msgOffset = 0;
+				Length -= RMDLEN;
+				InOffset += RMDLEN;
+
+				while (Length > BLOCK_SIZE)
+				{
+					ProcessBlock(Input, InOffset, Output);
+					Length -= BLOCK_SIZE;
+					InOffset += BLOCK_SIZE;
+				}
+			}
+
+			if (Length > 0)
+			{
+				Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgOffset, Length);
+				m_msgOffset += Length;
+			}
+		}
+	}
 
 private:
 
 	void Detect();
 	void GcmMultiply(std::vector<byte> &X);
+	void GcmMultiply(const std::vector<ulong> &H, std::vector<byte> &X);
+	void GcmPower(size_t Exponent, std::vector<ulong> &Output);
 	void Multiply(const std::vector<ulong> &H, std::vector<byte> &X);
 	void MultiplyW(const std::vector<ulong> &H, std::vector<byte> &X);
+#if defined(__AVX2__)
+	static void MultiplyAccumulate(const __m128i &X, const __m128i &H, __m128i &Low, __m128i &Middle, __m128i &High);
+	static __m128i ReduceW(const __m128i &Low, const __m128i &Middle, const __m128i &High);
+#endif
 };
 
 NAMESPACE_MACEND
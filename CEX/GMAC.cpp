@@ -1,4 +1,5 @@
 #include "GMAC.h"
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
 #include "IntUtils.h"
 #include "MemUtils.h"
@@ -212,6 +213,7 @@ void GMAC::Reset()
 	Utility::MemUtils::Clear(m_gmacNonce, 0, m_gmacNonce.size());
 	Utility::MemUtils::Clear(m_msgCode, 0, m_msgCode.size());
 	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	m_gmacHash->Reset();
 	m_msgCounter = 0;
 	m_msgOffset = 0;
 }
@@ -221,6 +223,7 @@ void GMAC::Update(byte Input)
 	CexAssert(m_isInitialized, "The Mac is not initialized");
 
 	m_gmacHash->Update(std::vector<byte> { Input }, 0, m_msgCode, 1);
+	++m_msgCounter;
 }
 
 void GMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
@@ -228,11 +231,16 @@ void GMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 	CexAssert(m_isInitialized, "The Mac is not initialized!");
 	CexAssert((InOffset + Length) <= Input.size(), "The Input buffer is too short!");
 
-	if (Length != 0)
-	{
-		m_gmacHash->Update(Input, InOffset, m_msgCode, Length);
-		m_msgCounter += Length;
-	}
+	Process(Input, InOffset, Length);
+}
+
+void GMAC::Update(const byte* Input, size_t Length)
+{
+	CexAssert(m_isInitialized, "The Mac is not initialized!");
+
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
 }
 
 void GMAC::Scope()
@@ -247,4 +255,14 @@ void GMAC::Scope()
 	}
 }
 
+template <typename Array>
+void GMAC::Process(const Array &Input, size_t InOffset, size_t Length)
+{
+	if (Length != 0)
+	{
+		m_gmacHash->Update(Input, InOffset, m_msgCode, Length);
+		m_msgCounter += Length;
+	}
+}
+
 NAMESPACE_MACEND
@@ -240,8 +240,18 @@ public:
 	/// <param name="Length">The length of data to process in bytes</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the Mac with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
 	void Scope();
 };
 
@@ -230,6 +230,13 @@ void HMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 	m_msgDigest->Update(Input, InOffset, Length);
 }
 
+void HMAC::Update(const byte* Input, size_t Length)
+{
+	CexAssert(m_isInitialized, "The Mac is not initialized!");
+
+	m_msgDigest->Update(Input, Length);
+}
+
 //~~~Private Functions~~~//
 
 void HMAC::Scope()
@@ -252,6 +252,46 @@ public:
 	/// <param name="Output">The output array of transformed bytes</param>
 	/// <param name="OutOffset">Starting offset in the output array</param>
 	virtual void Transform2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) = 0;
+
+	/// <summary>
+	/// Transform a block of bytes using raw memory pointers.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least <see cref="BlockSize"/> bytes; the Input and Output may be the same address for in-place transforms.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	virtual void Transform(const byte* Input, byte* Output) = 0;
+
+	/// <summary>
+	/// Transform 4 blocks of bytes using raw memory pointers.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 4 * <see cref="BlockSize"/> bytes; the Input and Output may be the same address for in-place transforms.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	virtual void Transform512(const byte* Input, byte* Output) = 0;
+
+	/// <summary>
+	/// Transform 8 blocks of bytes using raw memory pointers.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 8 * <see cref="BlockSize"/> bytes; the Input and Output may be the same address for in-place transforms.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	virtual void Transform1024(const byte* Input, byte* Output) = 0;
+
+	/// <summary>
+	/// Transform 16 blocks of bytes using raw memory pointers.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 16 * <see cref="BlockSize"/> bytes; the Input and Output may be the same address for in-place transforms.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	virtual void Transform2048(const byte* Input, byte* Output) = 0;
 };
 
 NAMESPACE_BLOCKEND
@@ -1,7 +1,8 @@
 #include "ICM.h"
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
+#include "BlockScheduler.h"
 #include "IntUtils.h"
-#include "ParallelUtils.h"
 
 NAMESPACE_MODE
 
@@ -14,6 +15,9 @@ ICM::ICM(BlockCiphers CipherType)
 	m_blockCipher(CipherType != BlockCiphers::None ? Helper::BlockCipherFromName::GetInstance(CipherType) :
 		throw CryptoCipherModeException("ICM:CTor", "The Cipher type can not be none!")),
 	m_cipherType(CipherType),
+	m_ctrBuffer(BLOCK_SIZE),
+	m_ctrNonce(2),
+	m_ctrOffset(0),
 	m_ctrVector(2),
 	m_destroyEngine(true),
 	m_isDestroyed(false),
@@ -29,6 +33,9 @@ ICM::ICM(IBlockCipher* Cipher)
 	m_blockCipher(Cipher != nullptr ? Cipher : 
 		throw CryptoCipherModeException("ICM:CTor", "The Cipher can not be null!")),
 	m_cipherType(m_blockCipher->Enumeral()),
+	m_ctrBuffer(BLOCK_SIZE),
+	m_ctrNonce(2),
+	m_ctrOffset(0),
 	m_ctrVector(2),
 	m_destroyEngine(false),
 	m_isDestroyed(false),
@@ -50,6 +57,10 @@ ICM::~ICM()
 		m_isLoaded = false;
 		m_parallelProfile.Reset();
 
+		m_ctrOffset = 0;
+
+		Utility::IntUtils::ClearVector(m_ctrBuffer);
+		Utility::IntUtils::ClearVector(m_ctrNonce);
 		Utility::IntUtils::ClearVector(m_ctrVector);
 
 		if (m_destroyEngine)
@@ -168,6 +179,8 @@ void ICM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	Scope();
 	m_blockCipher->Initialize(true, KeyParams);
 	Utility::MemUtils::COPY128(KeyParams.Nonce(), 0, m_ctrVector, 0);
+	m_ctrNonce = m_ctrVector;
+	m_ctrOffset = 0;
 	m_isEncryption = Encryption;
 	m_isInitialized = true;
 }
@@ -181,33 +194,49 @@ void ICM::ParallelMaxDegree(size_t Degree)
 	m_parallelProfile.SetMaxDegree(Degree);
 }
 
+void ICM::Seek(ulong ByteOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+
+	const ulong BLKCNT = ByteOffset / BLOCK_SIZE;
+
+	// the counter is the initial nonce plus the number of whole blocks preceding the offset
+	m_ctrVector[0] = m_ctrNonce[0] + BLKCNT;
+	m_ctrVector[1] = m_ctrNonce[1] + ((m_ctrVector[0] < m_ctrNonce[0]) ? 1 : 0);
+	m_ctrOffset = static_cast<size_t>(ByteOffset % BLOCK_SIZE);
+
+	if (m_ctrOffset != 0)
+	{
+		// generate the key stream block containing the offset, the next transform starts within it
+		Generate(m_ctrBuffer, 0, BLOCK_SIZE, m_ctrVector);
+	}
+}
+
 void ICM::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the length!");
 
-	const size_t PRLBLK = m_parallelProfile.ParallelBlockSize();
+	const size_t PRTLEN = ProcessPartial(Input, InOffset, Output, OutOffset, Length);
 
-	if (m_parallelProfile.IsParallel() && Length >= PRLBLK)
+	if (PRTLEN != Length)
 	{
-		const size_t BLKCNT = Length / PRLBLK;
+		Process(Input, InOffset + PRTLEN, Output, OutOffset + PRTLEN, Length - PRTLEN);
+	}
+}
 
-		for (size_t i = 0; i < BLKCNT; ++i)
-		{
-			ProcessParallel(Input, InOffset + (i * PRLBLK), Output, OutOffset + (i * PRLBLK), PRLBLK);
-		}
+void ICM::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 
-		const size_t RMDLEN = Length - (PRLBLK * BLKCNT);
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
 
-		if (RMDLEN != 0)
-		{
-			const size_t BLKOFT = (PRLBLK * BLKCNT);
-			ProcessSequential(Input, InOffset + BLKOFT, Output, OutOffset + BLKOFT, RMDLEN);
-		}
-	}
-	else
+	const size_t PRTLEN = ProcessPartial(inp, 0, otp, 0, Length);
+
+	if (PRTLEN != Length)
 	{
-		ProcessSequential(Input, InOffset, Output, OutOffset, Length);
+		Process(inp, PRTLEN, otp, PRTLEN, Length - PRTLEN);
 	}
 }
 
@@ -230,194 +259,104 @@ void ICM::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::MemUtils::XOR128(Input, InOffset, Output, OutOffset);
 }
 
-void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<ulong> &Counter)
+template <typename Array>
+void ICM::Generate(Array &Output, const size_t OutOffset, const size_t Length, std::vector<ulong> &Counter)
 {
-	size_t blkCtr = 0;
-
-#if defined(__AVX512__)
-	const size_t AVX512BLK = 16 * BLOCK_SIZE;
-	if (Length >= AVX512BLK)
-	{
-		const size_t PBKALN = Length - (Length % AVX512BLK);
-		std::vector<byte> ctrBlk(AVX512BLK);
-
-		// stagger counters and process 8 blocks with avx
-		while (blkCtr != PBKALN)
-		{
-			Convert(Counter, ctrBlk, 0);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 64);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 80);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 96);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 112);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 128);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 144);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 160);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 176);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 192);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 208);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 224);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 240);
-			Utility::IntUtils::LeIncrementW(Counter);
-			m_blockCipher->Transform2048(ctrBlk, 0, Output, OutOffset + blkCtr);
-			blkCtr += AVX512BLK;
-		}
-	}
-#elif defined(__AVX2__)
-	const size_t AVX2BLK = 8 * BLOCK_SIZE;
-	if (Length >= AVX2BLK)
-	{
-		const size_t PBKALN = Length - (Length % AVX2BLK);
-		std::vector<byte> ctrBlk(AVX2BLK);
+	const size_t BLKCNT = Length / BLOCK_SIZE;
 
-		// stagger counters and process 8 blocks with avx
-		while (blkCtr != PBKALN)
-		{
-			Convert(Counter, ctrBlk, 0);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 64);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 80);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 96);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 112);
-			Utility::IntUtils::LeIncrementW(Counter);
-			m_blockCipher->Transform1024(ctrBlk, 0, Output, OutOffset + blkCtr);
-			blkCtr += AVX2BLK;
-		}
-	}
-#elif defined(__AVX__)
-	const size_t AVXBLK = 4 * BLOCK_SIZE;
-	if (Length >= AVXBLK)
+	// stagger the counters of each run, and encrypt them at the output offset
+	BlockScheduler::Process(m_blockCipher.get(), nullptr, BLKCNT,
+		[&Counter](size_t, size_t RunCount, BlockScheduler::RunState &State)
 	{
-		const size_t PBKALN = Length - (Length % AVXBLK);
-		std::vector<byte> ctrBlk(AVXBLK);
-
-		// 4 blocks with sse
-		while (blkCtr != PBKALN)
+		for (size_t i = 0; i < RunCount; ++i)
 		{
-			Convert(Counter, ctrBlk, 0);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
-			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
+			Utility::MemUtils::COPY128(Counter, 0, State, i * BLOCK_SIZE);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
-			Utility::IntUtils::LeIncrementW(Counter);
-			m_blockCipher->Transform512(ctrBlk, 0, Output, OutOffset + blkCtr);
-			blkCtr += AVXBLK;
 		}
-	}
-#endif
-
-	const size_t ALNBLK = Length - (Length % BLOCK_SIZE);
-	std::vector<byte> tmpCtr(BLOCK_SIZE);
-
-	while (blkCtr != ALNBLK)
+	},
+		[&Output, OutOffset](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &State)
 	{
-		Convert(Counter, tmpCtr, 0);
-		m_blockCipher->EncryptBlock(tmpCtr, 0, Output, OutOffset + blkCtr);
-		Utility::IntUtils::LeIncrementW(Counter);
-		blkCtr += BLOCK_SIZE;
-	}
+		Utility::MemUtils::Copy(State, 0, Output, OutOffset + (RunOffset * BLOCK_SIZE), RunCount * BLOCK_SIZE);
+	});
 
-	if (blkCtr != Length)
+	if (BLKCNT * BLOCK_SIZE != Length)
 	{
+		std::vector<byte> tmpCtr(BLOCK_SIZE);
 		std::vector<byte> tmp(BLOCK_SIZE);
 		Convert(Counter, tmpCtr, 0);
-		m_blockCipher->EncryptBlock(tmpCtr, 0, tmp, 0);
+		m_blockCipher->Transform(tmpCtr.data(), tmp.data());
 		const size_t FNLLEN = Length % BLOCK_SIZE;
 		Utility::MemUtils::Copy(tmp, 0, Output, OutOffset + (Length - FNLLEN), FNLLEN);
 		Utility::IntUtils::LeIncrementW(Counter);
 	}
 }
 
-void ICM::ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+template <typename ArrayA, typename ArrayB>
+void ICM::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
 {
-	const size_t OUTLEN = Output.size() - OutOffset < Length ? Output.size() - OutOffset : Length;
-	const size_t CNKLEN = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
-	const size_t CTRLEN = (CNKLEN / BLOCK_SIZE);
-	std::vector<ulong> tmpCtr(m_ctrVector.size());
+	const size_t BLKCNT = Length / BLOCK_SIZE;
 
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpCtr, CNKLEN, CTRLEN](size_t i)
+	// each segment offsets the counter by its block offset, the key stream is xored from the run state so the input can be overwritten
+	BlockScheduler::Schedule(m_parallelProfile, BLKCNT, [this, &Input, InOffset, &Output, OutOffset](size_t, size_t BlockOffset, size_t BlockCount)
 	{
-		// thread level counter
 		std::vector<ulong> thdCtr(2, 0);
-		// offset counter by chunk size / block size  
-		Utility::IntUtils::LeIncreaseW(m_ctrVector, thdCtr, CTRLEN * i);
-		// generate random at output array offset
-		this->Generate(Output, OutOffset + (i * CNKLEN), CNKLEN, thdCtr);
-		// xor with input at offsets
-		Utility::MemUtils::XorBlock(Input, InOffset + (i * CNKLEN), Output, OutOffset + (i * CNKLEN), CNKLEN);
-
-		// store last counter
-		if (i == m_parallelProfile.ParallelMaxDegree() - 1)
+		Utility::IntUtils::LeIncreaseW(m_ctrVector, thdCtr, BlockOffset);
+		const size_t INPOFT = InOffset + (BlockOffset * BLOCK_SIZE);
+		const size_t OUTOFT = OutOffset + (BlockOffset * BLOCK_SIZE);
+
+		BlockScheduler::Process(m_blockCipher.get(), Input.data() + INPOFT, BlockCount,
+			[&thdCtr](size_t, size_t RunCount, BlockScheduler::RunState &State)
 		{
-			Utility::MemUtils::COPY128(thdCtr, 0, tmpCtr, 0);
-		}
+			for (size_t i = 0; i < RunCount; ++i)
+			{
+				Utility::MemUtils::COPY128(thdCtr, 0, State, i * BLOCK_SIZE);
+				Utility::IntUtils::LeIncrementW(thdCtr);
+			}
+		},
+			[&Input, INPOFT, &Output, OUTOFT](size_t RunOffset, size_t RunCount, BlockScheduler::RunState &State)
+		{
+			Utility::MemUtils::XorBlock(Input, INPOFT + (RunOffset * BLOCK_SIZE), State, 0, RunCount * BLOCK_SIZE);
+			Utility::MemUtils::Copy(State, 0, Output, OUTOFT + (RunOffset * BLOCK_SIZE), RunCount * BLOCK_SIZE);
+		});
 	});
 
-	// copy last counter to class variable
+	std::vector<ulong> tmpCtr(2, 0);
+	Utility::IntUtils::LeIncreaseW(m_ctrVector, tmpCtr, BLKCNT);
 	Utility::MemUtils::COPY128(tmpCtr, 0, m_ctrVector, 0);
 
-	// last block processing
-	const size_t ALNLEN = CNKLEN * m_parallelProfile.ParallelMaxDegree();
-	if (ALNLEN < OUTLEN)
+	// the remaining bytes are xored with the next key stream block
+	if (BLKCNT * BLOCK_SIZE != Length)
 	{
-		const size_t FNLLEN = (Output.size() - OutOffset) % ALNLEN;
-		Generate(Output, ALNLEN, FNLLEN, m_ctrVector);
+		const size_t FNLLEN = Length % BLOCK_SIZE;
+		std::vector<byte> tmpK(FNLLEN);
+		Generate(tmpK, 0, FNLLEN, m_ctrVector);
 
-		for (size_t i = ALNLEN; i < OUTLEN; i++)
+		for (size_t i = 0; i < FNLLEN; ++i)
 		{
-			Output[i] ^= Input[i];
+			Output[OutOffset + (Length - FNLLEN) + i] = Input[InOffset + (Length - FNLLEN) + i] ^ tmpK[i];
 		}
 	}
 }
 
-void ICM::ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+template <typename ArrayA, typename ArrayB>
+size_t ICM::ProcessPartial(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
 {
-	// generate random
-	Generate(Output, OutOffset, Length, m_ctrVector);
-	// get block aligned
-	size_t ALNLEN = Length - (Length % m_blockCipher->BlockSize());
+	size_t prcLen = 0;
 
-	if (ALNLEN != 0)
+	// use the remainder of the key stream block generated by Seek
+	if (m_ctrOffset != 0)
 	{
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, ALNLEN);
-	}
+		prcLen = Utility::IntUtils::Min(BLOCK_SIZE - m_ctrOffset, Length);
 
-	// get the remaining bytes
-	if (ALNLEN != Length)
-	{
-		for (size_t i = ALNLEN; i < Length; ++i)
+		for (size_t i = 0; i < prcLen; ++i)
 		{
-			Output[i + OutOffset] ^= Input[i + InOffset];
+			Output[OutOffset + i] = static_cast<byte>(Input[InOffset + i] ^ m_ctrBuffer[m_ctrOffset + i]);
 		}
+
+		m_ctrOffset = (m_ctrOffset + prcLen) % BLOCK_SIZE;
 	}
+
+	return prcLen;
 }
 
 void ICM::Scope()
@@ -85,7 +85,7 @@ NAMESPACE_MODE
 ///
 /// <description>Implementation Notes:</description>
 /// <list type="bullet">
-/// <item><description>In ICM mode, Encryption/Decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded.</description></item>
+/// <item><description>In ICM mode, Encryption/Decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded; the counters of a segment are staggered and encrypted 16 blocks at a time.</description></item>
 /// <item><description>A cipher mode constructor can either be initialized with a block cipher instance, or using the block ciphers enumeration name.</description></item>
 /// <item><description>A block cipher instance created using the enumeration constructor, is automatically deleted when the class is destroyed.</description></item>
 /// <item><description>The Transform functions are virtual, and can be accessed from an ICipherMode instance.</description></item>
@@ -114,6 +114,9 @@ private:
 
 	std::unique_ptr<IBlockCipher> m_blockCipher;
 	BlockCiphers m_cipherType;
+	std::vector<byte> m_ctrBuffer;
+	std::vector<ulong> m_ctrNonce;
+	size_t m_ctrOffset;
 	std::vector<ulong> m_ctrVector;
 	bool m_destroyEngine;
 	bool m_isDestroyed;
@@ -289,6 +292,16 @@ public:
 	/// <param name="Degree">The desired number of threads</param>
 	void ParallelMaxDegree(size_t Degree) override;
 
+	/// <summary>
+	/// Position the key stream at a byte offset.
+	/// <para>The counter is calculated directly from the initial nonce and the offset, so seeking costs the same as a sequential transform.
+	/// If the offset is not aligned to the block size, the key stream block containing the offset is generated, and its remaining bytes are used by the next call to Transform.
+	/// The sequential and parallel transforms continue from the new position. Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="ByteOffset">The offset in bytes from the start of the key stream</param>
+	void Seek(ulong ByteOffset);
+
 	/// <summary>
 	/// Transform a length of bytes with offset parameters. 
 	/// <para>This method processes a specified length of bytes, utilizing offsets incremented by the caller.
@@ -304,14 +317,29 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
 private:
 
 	void Convert(const std::vector<ulong> &Input, std::vector<byte> &Output, size_t OutOffset);
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<ulong> &Counter);
+	template <typename Array>
+	void Generate(Array &Output, const size_t OutOffset, const size_t Length, std::vector<ulong> &Counter);
 	void Scope();
-	void ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
-	void ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	size_t ProcessPartial(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
 };
 
 NAMESPACE_MODEEND
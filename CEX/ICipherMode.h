@@ -213,6 +213,19 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	/// <param name="Length">The number of bytes to transform</param>
 	virtual void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) = 0;
+
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the data is processed in place at the given addresses, 
+	/// with the same parallel and intrinsics dispatch as the vector overload.
+	/// Input and Output must each reference at least Length bytes.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	virtual void Transform(const byte* Input, byte* Output, const size_t Length) = 0;
 };
 
 NAMESPACE_MODEEND
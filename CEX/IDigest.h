@@ -137,6 +137,14 @@ public:
 	/// <param name="InOffset">The starting offset within the Input array</param>
 	/// <param name="Length">Amount of data to process in bytes</param>
 	virtual void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) = 0;
+
+	/// <summary>
+	/// Update the buffer using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">Amount of data to process in bytes</param>
+	virtual void Update(const byte* Input, size_t Length) = 0;
 };
 
 NAMESPACE_DIGESTEND
@@ -189,6 +189,17 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	/// <param name="Length">Length of data to process</param>
 	virtual void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) = 0;
+
+	/// <summary>
+	/// Encrypt/Decrypt a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// <see cref="Initialize(SymmetricKey)"/> must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">Length of data to process</param>
+	virtual void Transform(const byte* Input, byte* Output, const size_t Length) = 0;
 };
 
 NAMESPACE_STREAMEND
@@ -680,14 +680,14 @@ public:
 	/// <param name="Output">The modified output byte array</param>
 	/// <param name="Length">The number to increase by</param>
 	template<typename Array>
-	inline static void BeIncrease8(Array &Output, const size_t Length)
+	inline static void BeIncrease8(Array &Output, const ulong Length)
 	{
 		CexAssert(sizeof(Array::value_type) == sizeof(byte), "Input and Output must be an array of 8bit integers");
 		CexAssert(!std::is_signed<Array::value_type>::value, "Input and Output must be an unsigned integer array");
 
 		const int CTRLEN = static_cast<int>(Output.size() - 1);
-		uint ctrLen = static_cast<uint>(Length);
-		std::array<byte, sizeof(uint)> ctrInc;
+		ulong ctrLen = Length;
+		std::array<byte, sizeof(ulong)> ctrInc;
 
 		std::memcpy(&ctrInc[0], &ctrLen, ctrInc.size());
 		byte carry = 0;
@@ -710,14 +710,14 @@ public:
 	/// <param name="Output">The modified output byte array</param>
 	/// <param name="Length">The number to increase by</param>
 	template<typename Array>
-	inline static void BeIncrease8(const Array &Input, Array &Output, const size_t Length)
+	inline static void BeIncrease8(const Array &Input, Array &Output, const ulong Length)
 	{
 		CexAssert(sizeof(Array::value_type) == sizeof(byte), "Input and Output must be an array of 8bit integers");
 		CexAssert(!std::is_signed<Array::value_type>::value, "Input and Output must be an unsigned integer array");
 
 		const int CTRLEN = static_cast<int>(Output.size() - 1);
-		uint ctrLen = static_cast<uint>(Length);
-		std::array<byte, sizeof(uint)> ctrInc;
+		ulong ctrLen = Length;
+		std::array<byte, sizeof(ulong)> ctrInc;
 
 		std::memcpy(&ctrInc[0], &ctrLen, ctrInc.size());
 		std::memcpy(&Output[0], &Input[0], Input.size());
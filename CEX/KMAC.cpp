@@ -1,4 +1,5 @@
 #include "KMAC.h"
+#include "ArraySpan.h"
 #include "IntUtils.h"
 #include "Keccak.h"
 
@@ -11,11 +12,12 @@ const std::string KMAC::CLASS_NAME("KMAC");
 
 //~~~Constructor~~~//
 
-KMAC::KMAC(ShakeModes ShakeMode)
+KMAC::KMAC(ShakeModes ShakeMode, bool Extendable)
 	:
 	m_blockSize((ShakeMode == ShakeModes::SHAKE128) ? 168 : (ShakeMode == ShakeModes::SHAKE256) ? 136 : 72),
 	m_distributionCode { 0x4B, 0x4D, 0x41, 0x43 },
 	m_isDestroyed(false),
+	m_isExtendable(Extendable),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
 	m_macSize((ShakeMode == ShakeModes::SHAKE128) ? 16 : (ShakeMode == ShakeModes::SHAKE256) ? 32 :
@@ -33,6 +35,7 @@ KMAC::~KMAC()
 	{
 		m_blockSize = 0;
 		m_isDestroyed = true;
+		m_isExtendable = false;
 		m_isInitialized = false;
 		m_macSize = 0;
 		m_msgLength = 0;
@@ -83,7 +86,7 @@ std::vector<SymmetricKeySize> KMAC::LegalKeySizes() const
 
 const std::string KMAC::Name()
 {
-	return  CLASS_NAME + "-" + IntUtils::ToString(m_macSize);
+	return  CLASS_NAME + (m_isExtendable ? "XOF-" : "-") + IntUtils::ToString(m_macSize);
 }
 
 const ShakeModes KMAC::ShakeMode()
@@ -117,7 +120,8 @@ size_t KMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 	}
 
 	outLen = Output.size() - OutOffset;
-	outBits = RightEncode(buf, 0, outLen * 8);
+	// the xof variant encodes an output length of zero
+	outBits = RightEncode(buf, 0, m_isExtendable ? 0 : outLen * 8);
 
 	for (i = 0; i < outBits; i++)
 	{
@@ -179,39 +183,16 @@ void KMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 	CexAssert(m_isInitialized, "The Mac is not initialized!");
 	CexAssert((InOffset + Length) <= Input.size(), "The Input buffer is too short!");
 
-	if (Length != 0)
-	{
-		if (m_msgLength != 0 && (m_msgLength + Length >= m_blockSize))
-		{
-			const size_t RMDLEN = m_blockSize - m_msgLength;
-			if (RMDLEN != 0)
-			{
-				Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, RMDLEN);
-			}
+	Process(Input, InOffset, Length);
+}
 
-			AbsorbBlock(m_msgBuffer, 0, m_blockSize, m_kdfState);
-			Permute(m_kdfState);
-			m_msgLength = 0;
-			InOffset += RMDLEN;
-			Length -= RMDLEN;
-		}
+void KMAC::Update(const byte* Input, size_t Length)
+{
+	CexAssert(m_isInitialized, "The Mac is not initialized!");
 
-		// sequential loop through blocks
-		while (Length >= m_blockSize)
-		{
-			AbsorbBlock(Input, InOffset, m_blockSize, m_kdfState);
-			Permute(m_kdfState);
-			InOffset += m_blockSize;
-			Length -= m_blockSize;
-		}
+	const Utility::ArraySpan<const byte> inp(Input, Length);
 
-		// store unaligned bytes
-		if (Length != 0)
-		{
-			Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, Length);
-			m_msgLength += Length;
-		}
-	}
+	Process(inp, 0, Length);
 }
 
 //~~~Private Functions~~~//
@@ -337,6 +318,44 @@ void KMAC::Permute(std::array<ulong, 25> &State)
 	}
 }
 
+template <typename Array>
+void KMAC::Process(const Array &Input, size_t InOffset, size_t Length)
+{
+	if (Length != 0)
+	{
+		if (m_msgLength != 0 && (m_msgLength + Length >= m_blockSize))
+		{
+			const size_t RMDLEN = m_blockSize - m_msgLength;
+			if (RMDLEN != 0)
+			{
+				Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, RMDLEN);
+			}
+
+			AbsorbBlock(m_msgBuffer, 0, m_blockSize, m_kdfState);
+			Permute(m_kdfState);
+			m_msgLength = 0;
+			InOffset += RMDLEN;
+			Length -= RMDLEN;
+		}
+
+		// sequential loop through blocks
+		while (Length >= m_blockSize)
+		{
+			AbsorbBlock(Input, InOffset, m_blockSize, m_kdfState);
+			Permute(m_kdfState);
+			InOffset += m_blockSize;
+			Length -= m_blockSize;
+		}
+
+		// store unaligned bytes
+		if (Length != 0)
+		{
+			Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, Length);
+			m_msgLength += Length;
+		}
+	}
+}
+
 void KMAC::Scope()
 {
 	Reset();
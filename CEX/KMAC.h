@@ -57,6 +57,7 @@ using Enumeration::ShakeModes;
 /// <list type="bullet">
 /// <item><description>The MAC output size is variable; changing the output array size will also change the code array values.</description></item>
 /// <item><description>The MAC return size is derived from the size of the Output array, less the value of any offset parameter.</description></item>
+/// <item><description>Initializing with the Extendable flag set produces the SP800-185 KMACXOF variant, which encodes an output length of zero.</description></item>
 /// <item><description>Block size is the underlying SHAKE functions internal block size in bytes.</description></item>
 /// <item><description>Digest size is the underlying hash functions natural output code size in bytes.</description></item>
 /// <item><description>The key size should be equal or greater than the digests output size, and less or equal to the block-size.</description></item>
@@ -83,6 +84,7 @@ private:
 	size_t m_blockSize;
 	std::vector<byte> m_distributionCode;
 	bool m_isDestroyed;
+	bool m_isExtendable;
 	bool m_isInitialized;
 	std::array<ulong, STATE_SIZE> m_kdfState;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
@@ -110,9 +112,10 @@ public:
 	/// </summary>
 	/// 
 	/// <param name="ShakeMode">The underlying SHAKE implementation mode</param>
+	/// <param name="Extendable">Use the KMACXOF variant; the output length is not bound into the MAC code, and a shorter code is a prefix of a longer code</param>
 	/// 
 	/// <exception cref="CryptoMacException">Thrown if an invalid SHAKE mode is selected</exception>
-	explicit KMAC(ShakeModes ShakeMode = ShakeModes::SHAKE256);
+	explicit KMAC(ShakeModes ShakeMode = ShakeModes::SHAKE256, bool Extendable = false);
 
 	/// <summary>
 	/// Destructor: finalize this class
@@ -226,6 +229,14 @@ public:
 	/// <param name="Length">The length of data to process in bytes</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the Mac with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
 	template<typename ArrayA, typename ArrayB>
@@ -261,6 +272,8 @@ private:
 		return (n + 1);
 	}
 
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
 	template<typename Array>
 	size_t RightEncode(Array &Buffer, size_t Offset, size_t Value)
 	{
@@ -21,6 +21,8 @@
 
 #include "CexDomain.h"
 #include "IntUtils.h"
+#include <algorithm>
+#include <numeric>
 
 #if defined(__AVX512__)
 #	include "ULong512.h"
@@ -7589,6 +7591,227 @@ public:
 
 #endif
 
+	/// <summary>
+	/// Hash a batch of independent messages with the Keccak sponge, permuting several states with each call to the wide permutation function.
+	/// <para>The states of 8 messages are permuted together with AVX512, 4 with AVX2, otherwise the messages are hashed one at a time.
+	/// The longest messages are scheduled first, and a lane is refilled with the next message as soon as its output is complete; the last message is finished with the single state permutation.
+	/// The output of message i is written to OutOffset + (i * OutLength), and is identical to that of the sequential sponge.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">Pointers to the messages; each must reference at least the corresponding Length bytes</param>
+	/// <param name="Length">The length of each message in bytes</param>
+	/// <param name="Output">The output array; must be at least OutOffset + (Input.size() * OutLength) bytes long</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	/// <param name="OutLength">The number of output bytes generated for each message</param>
+	/// <param name="Rate">The sponge rate (block size) in bytes</param>
+	/// <param name="Domain">The domain separation code added to the padding</param>
+	/// <param name="Rounds">The number of permutation rounds; 24 or 48</param>
+	/// <param name="Extendable">Squeeze the output a rate-sized block at a time (XOF), otherwise the output is read from the state after absorption (fixed digest)</param>
+	inline static void PermuteBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset, size_t OutLength, size_t Rate, byte Domain, size_t Rounds, bool Extendable)
+	{
+#if defined(__AVX512__)
+		const size_t LANES = 8;
+#elif defined(__AVX2__)
+		const size_t LANES = 4;
+#else
+		const size_t LANES = 1;
+#endif
+		const size_t STATE_SIZE = 25;
+
+		struct SpongeLane
+		{
+			bool Absorbed;
+			bool Active;
+			size_t Index;
+			size_t InPosition;
+			size_t OutPosition;
+		};
+
+		CexAssert(Input.size() == Length.size(), "The message and length counts must be equal");
+		CexAssert(Output.size() - OutOffset >= Input.size() * OutLength, "The Output buffer is too short!");
+		CexAssert(Rate != 0 && Rate < STATE_SIZE * sizeof(ulong), "The rate is invalid");
+		CexAssert(Extendable || OutLength <= STATE_SIZE * sizeof(ulong), "The output length exceeds the state size");
+
+		std::vector<size_t> order(Input.size());
+		std::iota(order.begin(), order.end(), 0);
+		// longest first, so the lanes running together need a similar number of permutations
+		std::stable_sort(order.begin(), order.end(), [&Length](size_t A, size_t B) { return Length[A] > Length[B]; });
+
+		std::vector<std::array<ulong, STATE_SIZE>> state(LANES);
+		std::array<SpongeLane, LANES> lanes;
+		std::array<byte, STATE_SIZE * sizeof(ulong)> block;
+		size_t active = 0;
+		size_t next = 0;
+
+		auto load = [&](size_t Lane) -> bool
+		{
+			SpongeLane &lane = lanes[Lane];
+
+			lane.Active = (next != order.size());
+
+			if (lane.Active)
+			{
+				lane.Absorbed = false;
+				lane.Index = order[next];
+				lane.InPosition = 0;
+				lane.OutPosition = 0;
+				state[Lane].fill(0);
+				++next;
+			}
+
+			return lane.Active;
+		};
+
+		auto absorb = [&](size_t Lane)
+		{
+			SpongeLane &lane = lanes[Lane];
+			const size_t MSGLEN = Length[lane.Index];
+
+			if (lane.InPosition + Rate <= MSGLEN)
+			{
+				std::memcpy(block.data(), Input[lane.Index] + lane.InPosition, Rate);
+				lane.InPosition += Rate;
+			}
+			else if (!lane.Absorbed)
+			{
+				// pad the message remainder into the final block
+				const size_t RMDLEN = MSGLEN - lane.InPosition;
+
+				std::memset(block.data(), 0, Rate);
+
+				if (RMDLEN != 0)
+				{
+					std::memcpy(block.data(), Input[lane.Index] + lane.InPosition, RMDLEN);
+				}
+
+				block[RMDLEN] ^= Domain;
+				block[Rate - 1] |= 0x80;
+				lane.InPosition = MSGLEN;
+				lane.Absorbed = true;
+			}
+			else
+			{
+				// squeezing, the state is permuted without input
+				return;
+			}
+
+			for (size_t i = 0; i < Rate / sizeof(ulong); ++i)
+			{
+				state[Lane][i] ^= IntUtils::LeBytesTo64(block, i * sizeof(ulong));
+			}
+		};
+
+		auto squeeze = [&](size_t Lane) -> bool
+		{
+			SpongeLane &lane = lanes[Lane];
+
+			if (!lane.Absorbed)
+			{
+				return false;
+			}
+
+			const size_t OUTLEN = Extendable ? IntUtils::Min(Rate, OutLength - lane.OutPosition) : OutLength;
+			const size_t OUTOFT = OutOffset + (lane.Index * OutLength) + lane.OutPosition;
+
+			for (size_t i = 0; i < OUTLEN; ++i)
+			{
+				Output[OUTOFT + i] = static_cast<byte>(state[Lane][i / sizeof(ulong)] >> (8 * (i % sizeof(ulong))));
+			}
+
+			lane.OutPosition += OUTLEN;
+
+			return (lane.OutPosition == OutLength);
+		};
+
+		for (size_t i = 0; i < LANES; ++i)
+		{
+			if (load(i))
+			{
+				++active;
+			}
+		}
+
+		while (active > 1 || (active == 1 && next != order.size()))
+		{
+			for (size_t i = 0; i < LANES; ++i)
+			{
+				if (lanes[i].Active)
+				{
+					absorb(i);
+				}
+			}
+
+			// idle lanes are permuted with the others, their states are discarded
+#if defined(__AVX512__)
+			if (Rounds == 24)
+			{
+				PermuteR24P12800(state);
+			}
+			else
+			{
+				PermuteR48P12800(state);
+			}
+#elif defined(__AVX2__)
+			if (Rounds == 24)
+			{
+				PermuteR24P6400(state);
+			}
+			else
+			{
+				PermuteR48P6400(state);
+			}
+#else
+			if (Rounds == 24)
+			{
+				PermuteR24P1600(state[0]);
+			}
+			else
+			{
+				PermuteR48P1600(state[0]);
+			}
+#endif
+
+			for (size_t i = 0; i < LANES; ++i)
+			{
+				if (lanes[i].Active && squeeze(i) && !load(i))
+				{
+					--active;
+				}
+			}
+		}
+
+		// finish the last message with the single state permutation
+		for (size_t i = 0; i < LANES && active != 0; ++i)
+		{
+			if (lanes[i].Active)
+			{
+				do
+				{
+					absorb(i);
+
+					if (Rounds == 24)
+					{
+						PermuteR24P1600(state[i]);
+					}
+					else
+					{
+						PermuteR48P1600(state[i]);
+					}
+				}
+				while (!squeeze(i));
+
+				lanes[i].Active = false;
+				--active;
+			}
+		}
+
+		for (size_t i = 0; i < LANES; ++i)
+		{
+			state[i].fill(0);
+		}
+
+		std::memset(block.data(), 0, block.size());
+	}
 };
 
 NAMESPACE_DIGESTEND
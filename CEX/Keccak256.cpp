@@ -1,4 +1,5 @@
 #include "Keccak256.h"
+#include "ArraySpan.h"
 #include "Keccak.h"
 #include "ParallelUtils.h"
 
@@ -143,6 +144,36 @@ void Keccak256::Compute(const std::vector<byte> &Input, std::vector<byte> &Outpu
 	Finalize(Output, 0);
 }
 
+void Keccak256::ComputeBatch(const std::vector<std::vector<byte>> &Input, std::vector<std::vector<byte>> &Output)
+{
+	std::vector<const byte*> msgPtr(Input.size());
+	std::vector<size_t> msgLen(Input.size());
+	std::vector<byte> code(Input.size() * DIGEST_SIZE);
+
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		msgPtr[i] = Input[i].data();
+		msgLen[i] = Input[i].size();
+	}
+
+	ComputeBatch(msgPtr, msgLen, code, 0);
+	Output.resize(Input.size());
+
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		Output[i].resize(DIGEST_SIZE);
+		Utility::MemUtils::Copy(code, i * DIGEST_SIZE, Output[i], 0, DIGEST_SIZE);
+	}
+}
+
+void Keccak256::ComputeBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	CexAssert(Input.size() == Length.size(), "The message and length counts must be equal");
+	CexAssert(Output.size() - OutOffset >= Input.size() * DIGEST_SIZE, "The Output buffer is too short!");
+
+	Keccak::PermuteBatch(Input, Length, Output, OutOffset, DIGEST_SIZE, BLOCK_SIZE, DOMAIN_CODE, 24, false);
+}
+
 size_t Keccak256::Finalize(std::vector<byte> &Output, size_t OutOffset)
 {
 	CexAssert(Output.size() - OutOffset >= DIGEST_SIZE, "The Output buffer is too short!");
@@ -253,6 +284,38 @@ void Keccak256::Update(const std::vector<byte> &Input, size_t InOffset, size_t L
 {
 	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
 
+	Process(Input, InOffset, Length);
+}
+
+void Keccak256::Update(const byte* Input, size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+template <typename Array>
+void Keccak256::Absorb(const Array &Input, size_t InOffset, size_t Length, KeccakState &State)
+{
+	for (size_t i = 0; i < Length / sizeof(ulong); ++i)
+	{
+		State.H[i] ^= IntUtils::LeBytesTo64(Input, InOffset + (i * sizeof(ulong)));
+	}
+}
+
+void Keccak256::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, KeccakState &State)
+{
+	Input[InOffset + Length] = DOMAIN_CODE;
+	Input[InOffset + BLOCK_SIZE - 1] |= 128;
+	Absorb(Input, InOffset, BLOCK_SIZE, State);
+	Keccak::PermuteR24P1600(State.H);
+}
+
+template <typename Array>
+void Keccak256::Process(const Array &Input, size_t InOffset, size_t Length)
+{
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
@@ -342,25 +405,8 @@ void Keccak256::Update(const std::vector<byte> &Input, size_t InOffset, size_t L
 	}
 }
 
-//~~~Private Functions~~~//
-
-void Keccak256::Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length, KeccakState &State)
-{
-	for (size_t i = 0; i < Length / sizeof(ulong); ++i)
-	{
-		State.H[i] ^= IntUtils::LeBytesTo64(Input, InOffset + (i * sizeof(ulong)));
-	}
-}
-
-void Keccak256::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, KeccakState &State)
-{
-	Input[InOffset + Length] = DOMAIN_CODE;
-	Input[InOffset + BLOCK_SIZE - 1] |= 128;
-	Absorb(Input, InOffset, BLOCK_SIZE, State);
-	Keccak::PermuteR24P1600(State.H);
-}
-
-void Keccak256::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, KeccakState &State, ulong Length)
+template <typename Array>
+void Keccak256::ProcessLeaf(const Array &Input, size_t InOffset, KeccakState &State, ulong Length)
 {
 	do
 	{
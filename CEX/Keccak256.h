@@ -59,6 +59,7 @@ NAMESPACE_DIGEST
 /// <item><description>Use the <see cref="BlockSize"/> property to determine block sizes at runtime.</description></item>
 /// <item><description>The <see cref="Compute(byte[])"/> method wraps the <see cref="Update(byte[], int, int)"/> and Finalize methods.</description>/></item>
 /// <item><description>The <see cref="Finalize(byte[], int)"/> method resets the internal state.</description></item>
+/// <item><description>The ComputeBatch functions hash many independent messages with the multi-state (4 or 8 way) Keccak permutation, and return the standard sequential digests.</description></item>
 /// </list>
 /// 
 /// <list type="number">
@@ -188,6 +189,28 @@ public:
 	/// <param name="Output">The hash output value array</param>
 	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
 
+	/// <summary>
+	/// Compute the sequential SHA3-256 digest of each message in a batch of independent messages.
+	/// <para>The message states are permuted together; 8 states per permutation with AVX512, otherwise 4 with AVX2.
+	/// A lane is refilled with the next message as soon as its digest completes, and the longest messages are scheduled first, so messages of different lengths can be mixed freely.
+	/// The digests are those of the sequential mode; the parallel (tree hashing) setting and the current state of this instance are not used or modified.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The messages to hash</param>
+	/// <param name="Output">Receives the 32 byte digest of each message, in the order of the Input messages</param>
+	void ComputeBatch(const std::vector<std::vector<byte>> &Input, std::vector<std::vector<byte>> &Output);
+
+	/// <summary>
+	/// Compute the sequential SHA3-256 digest of each message in a batch of messages in caller owned memory.
+	/// <para>The digests are written contiguously, the digest of message i is at OutOffset + (i * 32).</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">Pointers to the messages; each must reference at least the corresponding Length bytes</param>
+	/// <param name="Length">The length of each message in bytes</param>
+	/// <param name="Output">The output array; must be at least OutOffset + (Input.size() * 32) bytes long</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	void ComputeBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset);
+
 	/// <summary>
 	/// Do final processing and get the hash value
 	/// </summary>
@@ -232,11 +255,23 @@ public:
 	/// <exception cref="CryptoDigestException">Thrown if the input buffer is too short</exception>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the digest with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
-	void Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length, KeccakState &State);
+	template <typename Array>
+	void Absorb(const Array &Input, size_t InOffset, size_t Length, KeccakState &State);
 	void HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, KeccakState &State);
-	void ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, KeccakState &State, ulong Length);
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
+	template <typename Array>
+	void ProcessLeaf(const Array &Input, size_t InOffset, KeccakState &State, ulong Length);
 };
 
 NAMESPACE_DIGESTEND
@@ -1,5 +1,9 @@
 #include "MacStream.h"
+#include "IntUtils.h"
 #include "MacFromDescription.h"
+#include "ParallelUtils.h"
+#include <algorithm>
+#include <atomic>
 
 NAMESPACE_PROCESSING
 
@@ -7,23 +11,27 @@ NAMESPACE_PROCESSING
 
 MacStream::MacStream(MacDescription &Description)
 	:
+	m_macDescription(Description.ToBytes()),
 	m_macEngine(Description.MacType() != Macs::GMAC ? Helper::MacFromDescription::GetInstance(Description) :
 		throw CryptoProcessingException("MacStream:CTor", "GMAC is not supported!")),
-	m_destroyEngine(false),
+	m_macKey(nullptr),
+	m_destroyEngine(true),
 	m_isDestroyed(false),
 	m_isInitialized(false),
-	m_progressInterval(0)
+	m_progressCounter()
 {
 }
 
 MacStream::MacStream(IMac* Mac)
 	:
+	m_macDescription(0),
 	m_macEngine(Mac != nullptr && Mac->Enumeral() != Macs::GMAC ? Mac :
 		throw CryptoProcessingException("MacStream:CTor", "The Mac can not be null!")),
+	m_macKey(nullptr),
 	m_destroyEngine(false),
 	m_isDestroyed(false),
 	m_isInitialized(false),
-	m_progressInterval(0)
+	m_progressCounter()
 {
 }
 
@@ -39,6 +47,11 @@ const std::vector<SymmetricKeySize> MacStream::LegalKeySizes()
 	return m_macEngine->LegalKeySizes();
 }
 
+ProgressCounter &MacStream::Progress()
+{
+	return m_progressCounter;
+}
+
 //~~~Public Functions~~~//
 
 std::vector<byte> MacStream::Compute(IByteStream* InStream)
@@ -48,7 +61,7 @@ std::vector<byte> MacStream::Compute(IByteStream* InStream)
 	CexAssert(InStream->CanRead(), "the input stream is set to write only!");
 
 	size_t dataLen = InStream->Length() - InStream->Position();
-	CalculateInterval(dataLen);
+	m_progressCounter.Reset(dataLen);
 
 	return Process(InStream, dataLen);
 }
@@ -58,80 +71,87 @@ std::vector<byte> MacStream::Compute(const std::vector<byte> &Input, size_t InOf
 	CexAssert(m_isInitialized, "the mac has not been initialized");
 	CexAssert((Input.size() - InOffset) > 0 && Length + InOffset <= Input.size(), "the input array is too short");
 
-	size_t dataLen = Length - InOffset;
-	CalculateInterval(dataLen);
+	m_progressCounter.Reset(Length);
 
 	return Process(Input, InOffset, Length);
 }
 
-void MacStream::Initialize(ISymmetricKey &KeyParams)
+std::vector<std::vector<byte>> MacStream::ComputeBatch(const std::vector<IByteStream*> &InStreams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
-	{
-		throw CryptoProcessingException("CipherStream:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
-	}
+	CexAssert(m_isInitialized, "the mac has not been initialized");
 
-	try
+	std::vector<size_t> msgLen(InStreams.size());
+
+	for (size_t i = 0; i < InStreams.size(); ++i)
 	{
-		m_macEngine->Initialize(KeyParams);
-		m_isInitialized = true;
+		CexAssert(InStreams[i]->CanRead(), "the input stream is set to write only!");
+		msgLen[i] = static_cast<size_t>(InStreams[i]->Length() - InStreams[i]->Position());
 	}
-	catch (std::exception& ex)
+
+	return ProcessBatch([&InStreams](size_t Index) -> IByteStream*
 	{
-		throw CryptoProcessingException("CipherStream:Initialize", "The key could not be loaded, check the key and iv sizes!", std::string(ex.what()));
-	}
+		return InStreams[Index];
+	}, msgLen, false);
 }
 
-//~~~Private Functions~~~//
-
-void MacStream::CalculateInterval(size_t Length)
+std::vector<std::vector<byte>> MacStream::ComputeBatch(const std::vector<std::string> &FileNames)
 {
-	size_t interval = Length / 100;
+	CexAssert(m_isInitialized, "the mac has not been initialized");
 
-	if (interval < m_macEngine->BlockSize())
-	{
-		m_progressInterval = m_macEngine->BlockSize();
-	}
-	else
+	std::vector<size_t> msgLen(FileNames.size());
+
+	// the sizes schedule the batch, the files are opened by the workers
+	for (size_t i = 0; i < FileNames.size(); ++i)
 	{
-		m_progressInterval = (interval - (interval % m_macEngine->BlockSize()));
+		msgLen[i] = static_cast<size_t>(IO::FileStream::FileSize(FileNames[i]));
 	}
 
-	if (m_progressInterval == 0)
+	return ProcessBatch([&FileNames](size_t Index) -> IByteStream*
 	{
-		m_progressInterval = m_macEngine->BlockSize();
-	}
+		return new IO::FileStream(FileNames[Index], IO::FileStream::FileAccess::Read);
+	}, msgLen, true);
 }
 
-void MacStream::CalculateProgress(size_t Length, size_t Processed)
+void MacStream::Initialize(ISymmetricKey &KeyParams)
 {
-	if (Length >= Processed)
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
 	{
-		double progress = 100.0 * (static_cast<double>(Processed) / Length);
-		if (progress > 100.0)
-		{
-			progress = 100.0;
-		}
+		throw CryptoProcessingException("CipherStream:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
+	}
 
-		size_t block = Length / 100;
-		if (block == 0)
-		{
-			ProgressPercent(static_cast<int>(progress));
-		}
-		else if (Processed % block == 0)
+	try
+	{
+		m_macEngine->Initialize(KeyParams);
+
+		// the batch workers key their own instances of the mac
+		if (m_macDescription.size() != 0)
 		{
-			ProgressPercent(static_cast<int>(progress));
+			m_macKey.reset(new Key::Symmetric::SymmetricKey(KeyParams.Key(), KeyParams.Nonce(), KeyParams.Info()));
 		}
+
+		m_isInitialized = true;
+	}
+	catch (std::exception& ex)
+	{
+		throw CryptoProcessingException("CipherStream:Initialize", "The key could not be loaded, check the key and iv sizes!", std::string(ex.what()));
 	}
 }
 
+//~~~Private Functions~~~//
+
 void MacStream::Destroy()
 {
 	if (!m_isDestroyed)
 	{
 		m_isDestroyed = true;
 		m_isInitialized = false;
-		m_progressInterval = 0;
+		Utility::IntUtils::ClearVector(m_macDescription);
+
+		if (m_macKey != nullptr)
+		{
+			m_macKey->Destroy();
+			m_macKey.reset(nullptr);
+		}
 
 		if (m_destroyEngine)
 		{
@@ -152,6 +172,28 @@ void MacStream::Destroy()
 	}
 }
 
+void MacStream::ProcessStream(IMac* Mac, IByteStream* InStream, size_t Length, std::vector<byte> &Buffer, std::vector<byte> &Output, ProgressCounter &Progress)
+{
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		const size_t RDLEN = InStream->Read(Buffer, 0, Utility::IntUtils::Min(Buffer.size(), Length - prcLen));
+
+		if (RDLEN == 0)
+		{
+			throw CryptoProcessingException("MacStream:ProcessStream", "The input stream is shorter than its length!");
+		}
+
+		Mac->Update(Buffer.data(), RDLEN);
+		Progress.Add(RDLEN);
+		prcLen += RDLEN;
+	}
+
+	Output.resize(Mac->MacSize());
+	Mac->Finalize(Output, 0);
+}
+
 std::vector<byte> MacStream::Process(IByteStream* InStream, size_t Length)
 {
 	size_t prcLen = 0;
@@ -167,7 +209,7 @@ std::vector<byte> MacStream::Process(IByteStream* InStream, size_t Length)
 		prcRead = InStream->Read(inpBuffer, 0, BLKLEN);
 		m_macEngine->Update(inpBuffer, 0, prcRead);
 		prcLen += prcRead;
-		CalculateProgress(Length, InStream->Position());
+		m_progressCounter.Add(prcRead);
 	}
 
 	// last block
@@ -183,7 +225,7 @@ std::vector<byte> MacStream::Process(IByteStream* InStream, size_t Length)
 	// get the hash
 	std::vector<byte> chkSum(m_macEngine->MacSize());
 	m_macEngine->Finalize(chkSum, 0);
-	CalculateProgress(Length, prcLen);
+	m_progressCounter.Add(Length - ALNLEN);
 
 	return chkSum;
 }
@@ -201,7 +243,7 @@ std::vector<byte> MacStream::Process(const std::vector<byte> &Input, size_t InOf
 		m_macEngine->Update(Input, InOffset, BLKLEN);
 		InOffset += BLKLEN;
 		prcLen += BLKLEN;
-		CalculateProgress(Length, prcLen);
+		m_progressCounter.Add(BLKLEN);
 	}
 
 	// last block
@@ -215,9 +257,66 @@ std::vector<byte> MacStream::Process(const std::vector<byte> &Input, size_t InOf
 	// get the hash
 	std::vector<byte> chkSum(m_macEngine->MacSize());
 	m_macEngine->Finalize(chkSum, 0);
-	CalculateProgress(Length, prcLen);
+	m_progressCounter.Add(Length - ALNLEN);
 
 	return chkSum;
 }
 
+std::vector<std::vector<byte>> MacStream::ProcessBatch(const std::function<IByteStream*(size_t)> &Open, const std::vector<size_t> &Lengths, bool Owned)
+{
+	const size_t MSGCNT = Lengths.size();
+	std::vector<std::vector<byte>> macCodes(MSGCNT);
+	std::vector<size_t> msgOrder(MSGCNT);
+	std::atomic<size_t> nxtMsg(0);
+	ulong ttlLen = 0;
+
+	for (size_t i = 0; i < MSGCNT; ++i)
+	{
+		msgOrder[i] = i;
+		ttlLen += Lengths[i];
+	}
+
+	m_progressCounter.Reset(ttlLen);
+
+	// the longest streams are scheduled first, so a long stream is not left running alone at the end of the batch
+	std::stable_sort(msgOrder.begin(), msgOrder.end(), [&Lengths](size_t A, size_t B)
+	{
+		return Lengths[A] > Lengths[B];
+	});
+
+	// workers take streams in turn; each holds one read buffer, so the read-ahead is bounded by the number of workers
+	auto worker = [this, &Open, &Lengths, Owned, MSGCNT, &macCodes, &msgOrder, &nxtMsg](IMac* Mac)
+	{
+		std::vector<byte> inpBuffer(BATCH_BUFFER);
+		size_t ordIdx;
+
+		while ((ordIdx = nxtMsg.fetch_add(1)) < MSGCNT)
+		{
+			const size_t MSGIDX = msgOrder[ordIdx];
+			std::unique_ptr<IByteStream> inpOwner(Owned ? Open(MSGIDX) : nullptr);
+			IByteStream* inpStream = Owned ? inpOwner.get() : Open(MSGIDX);
+			ProcessStream(Mac, inpStream, Lengths[MSGIDX], inpBuffer, macCodes[MSGIDX], m_progressCounter);
+		}
+	};
+
+	if (m_macKey == nullptr || MSGCNT < 2)
+	{
+		worker(m_macEngine.get());
+	}
+	else
+	{
+		const size_t WRKCNT = Utility::IntUtils::Min(Utility::ParallelUtils::ProcessorCount(), MSGCNT);
+
+		Utility::ParallelUtils::ParallelFor(0, WRKCNT, [this, &worker](size_t)
+		{
+			MacDescription dsc(m_macDescription);
+			std::unique_ptr<IMac> macEngine(Helper::MacFromDescription::GetInstance(dsc));
+			macEngine->Initialize(*m_macKey);
+			worker(macEngine.get());
+		});
+	}
+
+	return macCodes;
+}
+
 NAMESPACE_PROCESSINGEND
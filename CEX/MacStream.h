@@ -26,17 +26,20 @@
 
 #include "CexDomain.h"
 #include "CryptoProcessingException.h"
-#include "Event.h"
+#include "FileStream.h"
 #include "IByteStream.h"
 #include "IMac.h"
 #include "ISymmetricKey.h"
 #include "MacDescription.h"
+#include "ProgressCounter.h"
+#include "SymmetricKey.h"
 #include "SymmetricKeySize.h"
+#include <functional>
 
 NAMESPACE_PROCESSING
 
 using Exception::CryptoProcessingException;
-using Routing::Event;
+using Routing::ProgressCounter;
 using Key::Symmetric::ISymmetricKey;
 using IO::IByteStream;
 using Mac::IMac;
@@ -67,26 +70,27 @@ using Key::Symmetric::SymmetricKeySize;
 /// <list type="bullet">
 /// <item><description>Uses any of the implemented Macs using the IMac interface.</description></item>
 /// <item><description>Mac must be fully initialized before passed to the constructor.</description></item>
-/// <item><description>Implementation has a Progress counter that returns total sum of bytes processed per either Compute() calls.</description></item>
+/// <item><description>Progress() is a lock-free count of the input bytes processed by the current Compute() or ComputeBatch() call; it can be polled from any thread, and a ProgressNotifier attached to it raises time-based progress events.</description></item>
+/// <item><description>The ComputeBatch functions MAC a list of streams or files and return the codes in input order; a stream created from a MacDescription processes the batch concurrently, one keyed MAC instance and one read buffer per worker.</description></item>
+/// <item><description>A stream created from a Mac instance can not duplicate the MAC, and processes the batch in turn on the calling thread.</description></item>
 /// </list>
 /// </remarks>
 class MacStream
 {
 private:
 
+	static const size_t BATCH_BUFFER = 64 * 1024;
+
+	std::vector<byte> m_macDescription;
 	std::unique_ptr<IMac> m_macEngine;
+	std::unique_ptr<ISymmetricKey> m_macKey;
 	bool m_destroyEngine;
 	bool m_isDestroyed;
 	bool m_isInitialized;
-	size_t m_progressInterval;
+	ProgressCounter m_progressCounter;
 
 public:
 
-	/// <summary>
-	/// The Progress Percent event
-	/// </summary>
-	Event<int> ProgressPercent;
-
 	//~~~Constructor~~~//
 
 	/// <summary>
@@ -134,6 +138,11 @@ public:
 	/// </summary>
 	const std::vector<SymmetricKeySize> LegalKeySizes();
 
+	/// <summary>
+	/// Read Only: The bytes processed by the current Compute or ComputeBatch call; updated with one relaxed atomic add per block
+	/// </summary>
+	ProgressCounter &Progress();
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -156,6 +165,29 @@ public:
 	/// <returns>The Mac output code</returns>
 	std::vector<byte> Compute(const std::vector<byte> &Input, size_t InOffset, size_t Length);
 
+	/// <summary>
+	/// Process a list of streams concurrently.
+	/// <para>Each stream is processed from its current position to the end of the stream. 
+	/// Codes are identical to those returned by Compute(IByteStream*); Progress() counts the bytes processed by all of the workers.</para>
+	/// </summary>
+	///
+	/// <param name="InStreams">The source streams to process; each stream must be a distinct instance</param>
+	/// 
+	/// <returns>The Mac code of each stream, in the order of the input streams</returns>
+	std::vector<std::vector<byte>> ComputeBatch(const std::vector<IByteStream*> &InStreams);
+
+	/// <summary>
+	/// Process a list of files concurrently.
+	/// <para>A file is opened only while it is being processed, so the number of open files is bounded by the number of workers.</para>
+	/// </summary>
+	///
+	/// <param name="FileNames">The full paths of the files to process</param>
+	/// 
+	/// <returns>The Mac code of each file, in the order of the file names</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if a file can not be opened</exception>
+	std::vector<std::vector<byte>> ComputeBatch(const std::vector<std::string> &FileNames);
+
 	/// <summary>
 	/// Initialize the MAC generator with a SymmetricKey key container.
 	/// <para>Uses a key array to initialize the MAC.
@@ -169,11 +201,11 @@ public:
 
 private:
 
-	void CalculateInterval(size_t Length);
-	void CalculateProgress(size_t Length, size_t Processed);
 	void Destroy();
+	static void ProcessStream(IMac* Mac, IByteStream* InStream, size_t Length, std::vector<byte> &Buffer, std::vector<byte> &Output, ProgressCounter &Progress);
 	std::vector<byte> Process(IByteStream* InStream, size_t Length);
 	std::vector<byte> Process(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+	std::vector<std::vector<byte>> ProcessBatch(const std::function<IByteStream*(size_t)> &Open, const std::vector<size_t> &Lengths, bool Owned);
 };
 
 NAMESPACE_PROCESSINGEND
@@ -0,0 +1,442 @@
+#include "MappedFileStream.h"
+#include <cstring>
+
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <sys/types.h>
+#	include <unistd.h>
+#endif
+
+NAMESPACE_IO
+
+const std::string MappedFileStream::CLASS_NAME("MappedFileStream");
+
+//~~~Constructor~~~//
+
+MappedFileStream::MappedFileStream(const std::string &FileName, FileAccess Access, bool Sequential)
+	:
+	m_fileAccess(Access),
+	m_fileCapacity(0),
+#if defined(CEX_OS_WINDOWS)
+	m_fileHandle(INVALID_HANDLE_VALUE),
+	m_mapHandle(nullptr),
+#else
+	m_fileHandle(-1),
+#endif
+	m_fileName(FileName),
+	m_filePosition(0),
+	m_fileSize(0),
+	m_isDestroyed(false),
+	m_isSequential(Sequential),
+	m_mapView(nullptr)
+{
+#if defined(CEX_OS_WINDOWS)
+	const DWORD ACCESS = (Access == FileAccess::Read) ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+	const DWORD CREATE = (Access == FileAccess::Read) ? OPEN_EXISTING : (Access == FileAccess::Write) ? CREATE_ALWAYS : OPEN_ALWAYS;
+	const DWORD FLAGS = Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+	LARGE_INTEGER size;
+
+	m_fileHandle = CreateFileA(m_fileName.c_str(), ACCESS, FILE_SHARE_READ, nullptr, CREATE, FLAGS, nullptr);
+
+	if (m_fileHandle == INVALID_HANDLE_VALUE)
+	{
+		throw CryptoProcessingException("MappedFileStream:CTor", "The file could not be opened!");
+	}
+
+	if (!GetFileSizeEx(m_fileHandle, &size))
+	{
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+		throw CryptoProcessingException("MappedFileStream:CTor", "The file size could not be read!");
+	}
+
+	m_fileSize = static_cast<ulong>(size.QuadPart);
+#else
+	const int FLAGS = (Access == FileAccess::Read) ? O_RDONLY : (Access == FileAccess::Write) ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR | O_CREAT;
+	struct stat fst;
+
+	m_fileHandle = open(m_fileName.c_str(), FLAGS, 0644);
+
+	if (m_fileHandle == -1)
+	{
+		throw CryptoProcessingException("MappedFileStream:CTor", "The file could not be opened!");
+	}
+
+	if (fstat(m_fileHandle, &fst) != 0)
+	{
+		close(m_fileHandle);
+		m_fileHandle = -1;
+		throw CryptoProcessingException("MappedFileStream:CTor", "The file size could not be read!");
+	}
+
+	m_fileSize = static_cast<ulong>(fst.st_size);
+#endif
+
+	if (m_fileSize != 0)
+	{
+		try
+		{
+			Map(m_fileSize);
+		}
+		catch (CryptoProcessingException&)
+		{
+			Close();
+			throw;
+		}
+	}
+}
+
+MappedFileStream::~MappedFileStream()
+{
+	Destroy();
+}
+
+//~~~Accessors~~~//
+
+const MappedFileStream::FileAccess MappedFileStream::Access()
+{
+	return m_fileAccess;
+}
+
+const bool MappedFileStream::CanRead()
+{
+	return m_fileAccess != FileAccess::Write;
+}
+
+const bool MappedFileStream::CanSeek()
+{
+	return true;
+}
+
+const bool MappedFileStream::CanWrite()
+{
+	return m_fileAccess != FileAccess::Read;
+}
+
+const StreamModes MappedFileStream::Enumeral()
+{
+	return StreamModes::MappedFileStream;
+}
+
+std::string MappedFileStream::FileName()
+{
+	return m_fileName;
+}
+
+const ulong MappedFileStream::Length()
+{
+	return m_fileSize;
+}
+
+const std::string MappedFileStream::Name()
+{
+	return CLASS_NAME;
+}
+
+byte* MappedFileStream::Pointer()
+{
+	return m_mapView;
+}
+
+const ulong MappedFileStream::Position()
+{
+	return m_filePosition;
+}
+
+//~~~Public Functions~~~//
+
+void MappedFileStream::Close()
+{
+	if (m_mapView != nullptr && m_fileAccess != FileAccess::Read)
+	{
+		Flush();
+	}
+
+	Unmap();
+
+#if defined(CEX_OS_WINDOWS)
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+	{
+		if (m_fileAccess != FileAccess::Read && m_fileCapacity != m_fileSize)
+		{
+			// trim the growth reserve
+			LARGE_INTEGER size;
+			size.QuadPart = static_cast<LONGLONG>(m_fileSize);
+			SetFilePointerEx(m_fileHandle, size, nullptr, FILE_BEGIN);
+			SetEndOfFile(m_fileHandle);
+		}
+
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (m_fileHandle != -1)
+	{
+		if (m_fileAccess != FileAccess::Read && m_fileCapacity != m_fileSize)
+		{
+			// trim the growth reserve; Close is called by the destructor, so a failure is not thrown
+			const int RES = ftruncate(m_fileHandle, static_cast<off_t>(m_fileSize));
+			static_cast<void>(RES);
+		}
+
+		close(m_fileHandle);
+		m_fileHandle = -1;
+	}
+#endif
+
+	m_fileCapacity = 0;
+	m_filePosition = 0;
+	m_fileSize = 0;
+}
+
+void MappedFileStream::CopyTo(IByteStream* Destination)
+{
+	CexAssert(m_fileSize != 0, "stream is too short");
+
+	const size_t CPYLEN = 64 * 1024;
+	std::vector<byte> buffer(CPYLEN);
+	ulong prcLen = 0;
+
+	Destination->Seek(0, IO::SeekOrigin::Begin);
+
+	while (prcLen != m_fileSize)
+	{
+		const size_t BLKLEN = (m_fileSize - prcLen > CPYLEN) ? CPYLEN : static_cast<size_t>(m_fileSize - prcLen);
+		std::memcpy(buffer.data(), m_mapView + prcLen, BLKLEN);
+		Destination->Write(buffer, 0, BLKLEN);
+		prcLen += BLKLEN;
+	}
+}
+
+void MappedFileStream::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_isSequential = false;
+		Close();
+		m_fileName.clear();
+	}
+}
+
+void MappedFileStream::Flush()
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+
+	if (m_mapView != nullptr)
+	{
+#if defined(CEX_OS_WINDOWS)
+		FlushViewOfFile(m_mapView, 0);
+		FlushFileBuffers(m_fileHandle);
+#else
+		msync(m_mapView, static_cast<size_t>(m_fileCapacity), MS_SYNC);
+#endif
+	}
+}
+
+size_t MappedFileStream::Read(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess != FileAccess::Write, "File is write only");
+	CexAssert(Output.size() >= Offset + Length, "Output array is too small");
+
+	if (Length > m_fileSize - m_filePosition)
+	{
+		Length = static_cast<size_t>(m_fileSize - m_filePosition);
+	}
+
+	if (Length > 0)
+	{
+		std::memcpy(Output.data() + Offset, m_mapView + m_filePosition, Length);
+		m_filePosition += Length;
+	}
+
+	return Length;
+}
+
+byte MappedFileStream::ReadByte()
+{
+	CexAssert(m_fileSize - m_filePosition >= 1, "Reached end of file");
+	CexAssert(m_fileAccess != FileAccess::Write, "File is write only");
+
+	byte data = m_mapView[m_filePosition];
+	++m_filePosition;
+
+	return data;
+}
+
+void MappedFileStream::Reserve(ulong Length)
+{
+	if (m_fileAccess == FileAccess::Read)
+	{
+		throw CryptoProcessingException("MappedFileStream:Reserve", "The file is read only!");
+	}
+
+	if (Length > m_fileCapacity)
+	{
+		Unmap();
+		Map(Length);
+	}
+}
+
+void MappedFileStream::Reset()
+{
+	m_filePosition = 0;
+}
+
+void MappedFileStream::Seek(ulong Offset, SeekOrigin Origin)
+{
+	if (Origin == SeekOrigin::Begin)
+	{
+		m_filePosition = Offset;
+	}
+	else if (Origin == SeekOrigin::End)
+	{
+		m_filePosition = m_fileSize - Offset;
+	}
+	else
+	{
+		m_filePosition += Offset;
+	}
+
+	CexAssert(m_filePosition <= m_fileSize, "Seek position exceeds the file length");
+}
+
+void MappedFileStream::SetLength(ulong Length)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+
+	// growing the length within the reserved capacity commits any bytes written through Pointer()
+	if (Length > m_fileCapacity)
+	{
+		Reserve(Length);
+	}
+
+	m_fileSize = Length;
+
+	if (m_filePosition > m_fileSize)
+	{
+		m_filePosition = m_fileSize;
+	}
+}
+
+void MappedFileStream::Write(const std::vector<byte> &Input, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+	CexAssert(Input.size() >= Offset + Length, "Input array is too small");
+
+	if (m_filePosition + Length > m_fileCapacity)
+	{
+		// geometric growth keeps a stream of small writes from remapping the file each time
+		ulong cap = (m_fileCapacity < MIN_GROWTH) ? MIN_GROWTH : m_fileCapacity * 2;
+
+		while (cap < m_filePosition + Length)
+		{
+			cap *= 2;
+		}
+
+		Reserve(cap);
+	}
+
+	if (Length > 0)
+	{
+		std::memcpy(m_mapView + m_filePosition, Input.data() + Offset, Length);
+		m_filePosition += Length;
+	}
+
+	if (m_filePosition > m_fileSize)
+	{
+		m_fileSize = m_filePosition;
+	}
+}
+
+void MappedFileStream::WriteByte(byte Value)
+{
+	CexAssert(m_fileAccess != FileAccess::Read, "File is read only");
+
+	if (m_filePosition + 1 > m_fileCapacity)
+	{
+		Reserve((m_fileCapacity < MIN_GROWTH) ? MIN_GROWTH : m_fileCapacity * 2);
+	}
+
+	m_mapView[m_filePosition] = Value;
+	++m_filePosition;
+
+	if (m_filePosition > m_fileSize)
+	{
+		m_fileSize = m_filePosition;
+	}
+}
+
+//~~~Private Functions~~~//
+
+void MappedFileStream::Map(ulong Capacity)
+{
+#if defined(CEX_OS_WINDOWS)
+	const DWORD PROTECT = (m_fileAccess == FileAccess::Read) ? PAGE_READONLY : PAGE_READWRITE;
+	const DWORD ACCESS = (m_fileAccess == FileAccess::Read) ? FILE_MAP_READ : FILE_MAP_READ | FILE_MAP_WRITE;
+
+	// a writable mapping larger than the file extends the file
+	m_mapHandle = CreateFileMappingA(m_fileHandle, nullptr, PROTECT, static_cast<DWORD>(Capacity >> 32), static_cast<DWORD>(Capacity), nullptr);
+
+	if (m_mapHandle == nullptr)
+	{
+		throw CryptoProcessingException("MappedFileStream:Map", "The file mapping could not be created!");
+	}
+
+	m_mapView = static_cast<byte*>(MapViewOfFile(m_mapHandle, ACCESS, 0, 0, static_cast<SIZE_T>(Capacity)));
+
+	if (m_mapView == nullptr)
+	{
+		CloseHandle(m_mapHandle);
+		m_mapHandle = nullptr;
+		throw CryptoProcessingException("MappedFileStream:Map", "The file could not be mapped!");
+	}
+#else
+	const int PROTECT = (m_fileAccess == FileAccess::Read) ? PROT_READ : PROT_READ | PROT_WRITE;
+
+	if (m_fileAccess != FileAccess::Read)
+	{
+		if (ftruncate(m_fileHandle, static_cast<off_t>(Capacity)) != 0)
+		{
+			throw CryptoProcessingException("MappedFileStream:Map", "The file could not be extended!");
+		}
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(Capacity), PROTECT, MAP_SHARED, m_fileHandle, 0);
+
+	if (view == MAP_FAILED)
+	{
+		throw CryptoProcessingException("MappedFileStream:Map", "The file could not be mapped!");
+	}
+
+	m_mapView = static_cast<byte*>(view);
+
+	if (m_isSequential)
+	{
+		madvise(view, static_cast<size_t>(Capacity), MADV_SEQUENTIAL);
+	}
+#endif
+
+	m_fileCapacity = Capacity;
+}
+
+void MappedFileStream::Unmap()
+{
+	if (m_mapView != nullptr)
+	{
+#if defined(CEX_OS_WINDOWS)
+		UnmapViewOfFile(m_mapView);
+		CloseHandle(m_mapHandle);
+		m_mapHandle = nullptr;
+#else
+		munmap(m_mapView, static_cast<size_t>(m_fileCapacity));
+#endif
+		m_mapView = nullptr;
+	}
+}
+
+NAMESPACE_IOEND
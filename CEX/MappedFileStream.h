@@ -0,0 +1,261 @@
+#ifndef CEX_MAPPEDFILESTREAM_H
+#define CEX_MAPPEDFILESTREAM_H
+
+#include "IByteStream.h"
+
+NAMESPACE_IO
+
+/// <summary>
+/// A memory-mapped file streaming container.
+/// <para>Maps a file into the process address space and manipulates it through a streaming interface, without the iostream copy and locking overhead.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting a file with mapped input and output streams:</description>
+/// <code>
+/// MappedFileStream* fIn = new MappedFileStream("C://Tests//test.txt", MappedFileStream::FileAccess::Read);
+/// MappedFileStream* fOut = new MappedFileStream("C://Tests//testenc.txt", MappedFileStream::FileAccess::Write);
+///
+/// Processing::CipherStream cs(Enumeration::BlockCiphers::AHX, Enumeration::Digests::None, 14, Enumeration::CipherModes::CTR);
+/// cs.Initialize(true, kp);
+/// // the cipher reads and writes the mapped pages directly
+/// cs.Write(fIn, fOut);
+///
+/// fIn->Close();
+/// fOut->Close();
+/// delete fIn;
+/// delete fOut;
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>Read opens an existing file read-only, ReadWrite opens or creates a file and retains its contents, and Write creates or truncates the file.</description></item>
+/// <item><description>A write past the end of the mapping grows the file and remaps it; the capacity is doubled on each growth, and the file is trimmed to Length() when the stream is closed.</description></item>
+/// <item><description>The Pointer() function exposes the mapped pages; CipherStream and DigestStream use it to transform and hash the file in place, without copying through an intermediate buffer.</description></item>
+/// <item><description>When the Sequential flag is set the mapping is advised for sequential access (madvise MADV_SEQUENTIAL on posix systems), so pages are read ahead and released behind the cursor.</description></item>
+/// </list>
+/// </remarks>
+class MappedFileStream final : public IByteStream
+{
+public:
+
+	//~~~Enums~~~//
+
+	/// <summary>
+	/// File access type flags
+	/// </summary>
+	enum class FileAccess : int
+	{
+		Read = 1,
+		ReadWrite = 3,
+		Write = 2
+	};
+
+private:
+
+	static const std::string CLASS_NAME;
+	// the minimum size a writable mapping grows by
+	static const ulong MIN_GROWTH = 1024 * 1024;
+
+	FileAccess m_fileAccess;
+	ulong m_fileCapacity;
+#if defined(CEX_OS_WINDOWS)
+	void* m_fileHandle;
+	void* m_mapHandle;
+#else
+	int m_fileHandle;
+#endif
+	std::string m_fileName;
+	ulong m_filePosition;
+	ulong m_fileSize;
+	bool m_isDestroyed;
+	bool m_isSequential;
+	byte* m_mapView;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	MappedFileStream(const MappedFileStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	MappedFileStream& operator=(const MappedFileStream&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	MappedFileStream() = delete;
+
+	/// <summary>
+	/// Constructor: instantiate this class with a file name and options
+	/// </summary>
+	///
+	/// <param name="FileName">The full path and name of the file</param>
+	/// <param name="Access">The level of access requested</param>
+	/// <param name="Sequential">Advise the operating system that the file will be accessed sequentially</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the file could not be opened or mapped</exception>
+	explicit MappedFileStream(const std::string &FileName, FileAccess Access = FileAccess::Read, bool Sequential = true);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~MappedFileStream() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The file read and write file access flags
+	/// </summary>
+	const FileAccess Access();
+
+	/// <summary>
+	/// Read Only: The stream can be read
+	/// </summary>
+	const bool CanRead() override;
+
+	/// <summary>
+	/// Read Only: The stream is seekable
+	/// </summary>
+	const bool CanSeek() override;
+
+	/// <summary>
+	/// Read Only: The stream can be written to
+	/// </summary>
+	const bool CanWrite() override;
+
+	/// <summary>
+	/// Read Only: The stream container type
+	/// </summary>
+	const StreamModes Enumeral() override;
+
+	/// <summary>
+	/// Read Only: The file name and path
+	/// </summary>
+	std::string FileName();
+
+	/// <summary>
+	/// Read Only: The stream length
+	/// </summary>
+	const ulong Length() override;
+
+	/// <summary>
+	/// Read Only: The streams class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: A pointer to the first byte of the mapped file.
+	/// <para>The pointer is null if the mapping is empty, and is invalidated when the stream grows, or is closed.</para>
+	/// </summary>
+	byte* Pointer();
+
+	/// <summary>
+	/// Read Only: The streams current position
+	/// </summary>
+	const ulong Position() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Flush the mapped pages, trim the file to its length, and close the stream
+	/// </summary>
+	void Close() override;
+
+	/// <summary>
+	/// Copy this stream to another stream
+	/// </summary>
+	///
+	/// <param name="Destination">The destination stream</param>
+	void CopyTo(IByteStream* Destination) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Write the modified pages to disk
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// Copies a portion of the stream into an output buffer
+	/// </summary>
+	///
+	/// <param name="Output">The output array receiving the bytes</param>
+	/// <param name="Offset">Offset within the output array at which to begin</param>
+	/// <param name="Length">The number of bytes to read</param>
+	///
+	/// <returns>The number of bytes read</returns>
+	size_t Read(std::vector<byte> &Output, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Read a single byte from the stream
+	/// </summary>
+	///
+	/// <returns>The read byte value</returns>
+	byte ReadByte() override;
+
+	/// <summary>
+	/// Grow the mapping to at least a length of bytes, without changing the stream length.
+	/// <para>Reserving the final output size before a large write avoids remapping the file as it grows.
+	/// Bytes written directly to the reserved range through Pointer() become part of the stream when SetLength extends the length over them.</para>
+	/// </summary>
+	///
+	/// <param name="Length">The minimum capacity in bytes</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the stream is read only, or the file could not be extended</exception>
+	void Reserve(ulong Length);
+
+	/// <summary>
+	/// Reset the position to the beginning of the stream
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Seek to a position within the stream
+	/// </summary>
+	///
+	/// <param name="Offset">The offset position</param>
+	/// <param name="Origin">The starting point</param>
+	void Seek(ulong Offset, SeekOrigin Origin) override;
+
+	/// <summary>
+	/// Set the length of the stream
+	/// </summary>
+	///
+	/// <param name="Length">The desired length</param>
+	void SetLength(ulong Length) override;
+
+	/// <summary>
+	/// Writes an input buffer to the stream
+	/// </summary>
+	///
+	/// <param name="Input">The input array to write to the stream</param>
+	/// <param name="Offset">Offset within the input array at which to begin</param>
+	/// <param name="Length">The number of bytes to write</param>
+	void Write(const std::vector<byte> &Input, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Write a single byte from the stream
+	/// </summary>
+	///
+	/// <param name="Value">The byte value to write</param>
+	void WriteByte(byte Value) override;
+
+private:
+
+	void Map(ulong Capacity);
+	void Unmap();
+};
+
+NAMESPACE_IOEND
+#endif
@@ -181,9 +181,10 @@ void MemoryStream::Write(const std::vector<byte> &Input, size_t Offset, size_t L
 
 	size_t ttlLen = m_streamPosition + Length;
 
-	if (m_streamData.capacity() - m_streamPosition < Length)
+	if (m_streamData.capacity() < ttlLen)
 	{
-		m_streamData.reserve(ttlLen);
+		// grow geometrically, so a sequence of small writes is not reallocated and copied on every call
+		m_streamData.reserve(Utility::IntUtils::Max(ttlLen, m_streamData.capacity() * 2));
 	}
 	if (m_streamData.size() < ttlLen)
 	{
@@ -198,6 +199,11 @@ void MemoryStream::WriteByte(byte Value)
 {
 	if (m_streamData.size() - m_streamPosition < 1)
 	{
+		if (m_streamData.capacity() == m_streamData.size())
+		{
+			m_streamData.reserve(Utility::IntUtils::Max<size_t>(64, m_streamData.capacity() * 2));
+		}
+
 		m_streamData.resize(m_streamData.size() + 1);
 	}
 
@@ -1,9 +1,11 @@
 #include "OCB.h"
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
 #include "CMAC.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
 #include "SymmetricKey.h"
+#include <array>
 
 NAMESPACE_MODE
 
@@ -269,6 +271,8 @@ void OCB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 
 		m_hashCipher->Initialize(true, KeyParams);
 		m_blockCipher->Initialize(Encryption, KeyParams);
+		// the L table is derived from the key, and is retained across messages
+		GenerateTable();
 	}
 
 	if (KeyParams.Nonce().size() > MAX_NONCESIZE || KeyParams.Nonce().size() < MIN_NONCESIZE)
@@ -284,17 +288,15 @@ void OCB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 		throw CryptoSymmetricCipherException("OCB:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
 	}
 
+	if (m_isInitialized)
+	{
+		// a new nonce starts a new message, discard the state of an unfinished one
+		Reset();
+	}
+
 	m_isEncryption = Encryption;
 	m_ocbNonce = KeyParams.Nonce();
 	m_ocbVector = m_ocbNonce;
-
-	m_hashCipher->Transform(m_listAsterisk, 0, m_listAsterisk, 0);
-
-	DoubleBlock(m_listAsterisk, m_listDollar);
-	std::vector<byte> hash(BLOCK_SIZE);
-	DoubleBlock(m_listDollar, hash);
-
-	m_hashList.push_back(hash);
 	GenerateOffsets(m_ocbVector);
 
 	if (m_isFinalized)
@@ -363,41 +365,17 @@ void OCB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
 
-	if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
-	{
-		if (m_isEncryption)
-		{
-			ParallelEncrypt(Input, InOffset, Output, OutOffset, Length);
-		}
-		else
-		{
-			ParallelDecrypt(Input, InOffset, Output, OutOffset, Length);
-		}
-	}
-	else
-	{
-		const size_t BLKCNT = Length / BLOCK_SIZE;
-		if (m_isEncryption)
-		{
-			for (size_t i = 0; i < BLKCNT; ++i)
-			{
-				EncryptBlock(Input, InOffset + i * BLOCK_SIZE, Output, OutOffset + i * BLOCK_SIZE);
-			}
-		}
-		else
-		{
-			for (size_t i = 0; i < BLKCNT; ++i)
-			{
-				DecryptBlock(Input, InOffset + (i * BLOCK_SIZE), Output, OutOffset + (i * BLOCK_SIZE));
-			}
-		}
+	Process(Input, InOffset, Output, OutOffset, Length);
+}
 
-		if (Length % BLOCK_SIZE != 0)
-		{
-			const size_t BLKOFF = (BLKCNT * BLOCK_SIZE);
-			ProcessPartial(Input, InOffset + BLKOFF, Output, OutOffset + BLKOFF, Length - BLKOFF);
-		}
-	}
+void OCB::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
+
+	Process(inp, 0, otp, 0, Length);
 }
 
 bool OCB::Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
@@ -438,7 +416,8 @@ void OCB::CalculateMac()
 	m_isFinalized = true;
 }
 
-void OCB::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void OCB::Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
@@ -450,12 +429,13 @@ void OCB::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::MemUtils::XorBlock(hash, 0, m_mainOffset, 0, BLOCK_SIZE);
 	Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
 
-	m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
+	m_blockCipher->Transform(Output.data() + OutOffset, Output.data() + OutOffset);
 	Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
 	Utility::MemUtils::XorBlock(Output, OutOffset, m_checkSum, 0, BLOCK_SIZE);
 }
 
-void OCB::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void OCB::Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
@@ -468,7 +448,7 @@ void OCB::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::MemUtils::XorBlock(hash, 0, m_mainOffset, 0, BLOCK_SIZE);
 	Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
 
-	m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
+	m_blockCipher->Transform(Output.data() + OutOffset, Output.data() + OutOffset);
 	Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
 }
 
@@ -536,6 +516,25 @@ void OCB::GenerateOffsets(const std::vector<byte> &Nonce)
 	Utility::MemUtils::COPY128(m_mainOffset0, 0, m_mainOffset, 0);
 }
 
+void OCB::GenerateTable()
+{
+	std::vector<byte> hash(BLOCK_SIZE);
+
+	Utility::MemUtils::Clear(m_listAsterisk, 0, m_listAsterisk.size());
+	// invalidate the cached stretch, it was derived from the previous key
+	Utility::MemUtils::Clear(m_topInput, 0, m_topInput.size());
+
+	m_hashCipher->Transform(m_listAsterisk, 0, m_listAsterisk, 0);
+	DoubleBlock(m_listAsterisk, m_listDollar);
+	DoubleBlock(m_listDollar, hash);
+
+	m_hashList.clear();
+	m_hashList.reserve(PREFETCH_HASH / BLOCK_SIZE);
+	m_hashList.push_back(hash);
+	// precompute the table; offsets beyond 2^32 blocks extend it on demand
+	GetLSub((PREFETCH_HASH / BLOCK_SIZE) - 1, hash);
+}
+
 void OCB::GetLSub(size_t N, std::vector<byte> &LSub)
 {
 	size_t hashCtr = m_hashList.size();
@@ -549,6 +548,22 @@ void OCB::GetLSub(size_t N, std::vector<byte> &LSub)
 	Utility::MemUtils::COPY128(m_hashList[N], 0, LSub, 0);
 }
 
+void OCB::GetOffsetSum(ulong Index, std::vector<byte> &Output)
+{
+	// L[ntz(1)] ^ .. ^ L[ntz(Index)] is the xor of the L values indexed by the bits of the gray code of Index
+	const ulong GRYIDX = Index ^ (Index >> 1);
+
+	Utility::MemUtils::Clear(Output, 0, BLOCK_SIZE);
+
+	for (size_t i = 0; (GRYIDX >> i) != 0; ++i)
+	{
+		if (((GRYIDX >> i) & 1) != 0)
+		{
+			Utility::MemUtils::XOR128(m_hashList[i], 0, Output, 0);
+		}
+	}
+}
+
 uint OCB::Ntz(ulong X)
 {
 	uint zCnt = 0;
@@ -562,242 +577,227 @@ uint OCB::Ntz(ulong X)
 	return zCnt;
 }
 
-void OCB::ProcessSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+template <typename ArrayA, typename ArrayB>
+void OCB::ProcessPartial(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, size_t Length)
 {
-#if defined(__AVX512__)
-	const size_t AVX512BLK = 16 * BLOCK_SIZE;
-	if (Length >= AVX512BLK)
-	{
-		const size_t PBKALN = Length - (Length % AVX512BLK);
-		const size_t SUBBLK = PBKALN / AVX512BLK;
-
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
-
-		for (size_t i = 0; i < SUBBLK; ++i)
-		{
-			m_blockCipher->Transform2048(Output, OutOffset + (i * AVX512BLK), Output, OutOffset + (i * AVX512BLK));
-		}
-
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
-	}
-#elif defined(__AVX2__)
-	const size_t AVX2BLK = 8 * BLOCK_SIZE;
-	if (Length >= AVX2BLK)
+	if (m_isEncryption)
 	{
-		const size_t PBKALN = Length - (Length % AVX2BLK);
-		const size_t SUBBLK = PBKALN / AVX2BLK;
-
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+		Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, Length);
 
-		for (size_t i = 0; i < SUBBLK; ++i)
-		{
-			m_blockCipher->Transform1024(Output, OutOffset + (i * AVX2BLK), Output, OutOffset + (i * AVX2BLK));
-		}
+		// pad a copy of the final block, the output may end at the message boundary
+		std::vector<byte> tmp(BLOCK_SIZE);
+		Utility::MemUtils::Copy(Input, InOffset, tmp, 0, Length);
+		ExtendBlock(tmp, Length);
+		Utility::MemUtils::XOR128(tmp, 0, m_checkSum, 0);
+		Utility::MemUtils::XOR128(m_listAsterisk, 0, m_mainOffset, 0);
 
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+		std::vector<byte> pad(BLOCK_SIZE);
+		m_hashCipher->Transform(m_mainOffset, 0, pad, 0);
+		Utility::MemUtils::XorBlock(pad, 0, Output, OutOffset, Length);
 	}
-#elif defined(__AVX__)
-	const size_t AVXBLK = 4 * BLOCK_SIZE;
-	if (Length >= AVXBLK)
+	else
 	{
-		const size_t PBKALN = Length - (Length % AVXBLK);
-		const size_t SUBBLK = PBKALN / AVXBLK;
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
-
-		for (size_t i = 0; i < SUBBLK; ++i)
-		{
-			m_blockCipher->Transform512(Output, OutOffset + (i * AVXBLK), Output, OutOffset + (i * AVXBLK));
-		}
+		Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, Length);
+		Utility::MemUtils::XOR128(m_listAsterisk, 0, m_mainOffset, 0);
 
-		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
-	}
-#else
-	const size_t PBKALN = Length - (Length % BLOCK_SIZE);
-	const size_t SUBBLK = PBKALN / BLOCK_SIZE;
-	Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
+		std::vector<byte> pad(BLOCK_SIZE);
+		m_hashCipher->Transform(m_mainOffset, 0, pad, 0);
+		Utility::MemUtils::XorBlock(pad, 0, Output, OutOffset, Length);
 
-	for (size_t i = 0; i < SUBBLK; ++i)
-	{
-		m_blockCipher->Transform(Output, OutOffset + (i * BLOCK_SIZE), Output, OutOffset + (i * BLOCK_SIZE));
+		std::vector<byte> tmp(BLOCK_SIZE);
+		Utility::MemUtils::Copy(Output, OutOffset, tmp, 0, Length);
+		ExtendBlock(tmp, Length);
+		Utility::MemUtils::XOR128(tmp, 0, m_checkSum, 0);
 	}
-
-	Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, PBKALN);
-#endif
 }
 
-void OCB::ParallelDecrypt(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+template <typename ArrayA, typename ArrayB>
+void OCB::ProcessWide(const ArrayA &Input, size_t InOffset, ArrayB &Output, size_t OutOffset, ulong BlockIndex, size_t BlockCount, std::vector<byte> &Offset, std::vector<byte> &Checksum)
 {
-	const size_t BLKCNT = Length / BLOCK_SIZE;
-	const size_t ALNLEN = Length - (Length % BLOCK_SIZE);
-	const size_t OUTOFF = OutOffset;
-
-	// copy data into working output
-	Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, ALNLEN);
-	// create the offset chain
-	std::vector<byte> offsetChain(ALNLEN);
-	std::vector<byte> hash(BLOCK_SIZE);
+	const size_t WDEBLK = 16;
+	const size_t WDELEN = WDEBLK * BLOCK_SIZE;
+	std::array<byte, WDELEN> blkOffsets;
+	std::array<byte, WDELEN> blkState;
+	// the checksum is accumulated across a full run of blocks, and folded once at the end
+	std::array<byte, WDELEN> sumState = { 0 };
 
-	for (size_t i = 0; i < BLKCNT; ++i)
+	while (BlockCount != 0)
 	{
-		GetLSub(Ntz(++m_mainBlockCount), hash);
-		Utility::MemUtils::XorBlock(hash, 0, m_mainOffset, 0, BLOCK_SIZE);
-		Utility::MemUtils::COPY128(m_mainOffset, 0, offsetChain, i * BLOCK_SIZE);
-	}
+		const size_t RUNBLK = Utility::IntUtils::Min(WDEBLK, BlockCount);
+		const size_t RUNLEN = RUNBLK * BLOCK_SIZE;
 
-	// parallel offsets
-	const size_t PRLLEN = m_parallelProfile.ParallelBlockSize();
-	const size_t CNKLEN = PRLLEN / m_parallelProfile.ParallelMaxDegree();
-	size_t chainPos = 0;
+		// the offsets of the run are taken from the L table
+		for (size_t i = 0; i < RUNBLK; ++i)
+		{
+			++BlockIndex;
+			Utility::MemUtils::XOR128(m_hashList[Ntz(BlockIndex)], 0, Offset, 0);
+			Utility::MemUtils::COPY128(Offset, 0, blkOffsets, i * BLOCK_SIZE);
+		}
 
-	while (Length >= PRLLEN)
-	{
-		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, &offsetChain, chainPos, CNKLEN](size_t i)
+		if (m_isEncryption)
 		{
-			this->ProcessSegment(offsetChain, chainPos + (i * CNKLEN), Output, OutOffset + (i * CNKLEN), CNKLEN);
-		});
+			Utility::MemUtils::XorBlock(Input, InOffset, sumState, 0, RUNLEN);
+		}
 
-		Length -= PRLLEN;
-		OutOffset += PRLLEN;
-		chainPos += PRLLEN;
-	}
+		Utility::MemUtils::Copy(blkOffsets, 0, blkState, 0, RUNLEN);
+		Utility::MemUtils::XorBlock(Input, InOffset, blkState, 0, RUNLEN);
 
-	if (Length != 0)
-	{
-		while (Length >= BLOCK_SIZE)
-		{
-			Utility::MemUtils::XorBlock(offsetChain, chainPos, Output, OutOffset, BLOCK_SIZE);
-			m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
-			Utility::MemUtils::XorBlock(offsetChain, chainPos, Output, OutOffset, BLOCK_SIZE);
+		size_t blkOff = 0;
 
-			Length -= BLOCK_SIZE;
-			OutOffset += BLOCK_SIZE;
-			chainPos += BLOCK_SIZE;
+#if defined(__AVX512__)
+		if (RUNBLK == WDEBLK)
+		{
+			m_blockCipher->Transform2048(blkState.data(), blkState.data());
+			blkOff = WDELEN;
+		}
+#elif defined(__AVX2__)
+		while (RUNLEN - blkOff >= 8 * BLOCK_SIZE)
+		{
+			m_blockCipher->Transform1024(blkState.data() + blkOff, blkState.data() + blkOff);
+			blkOff += 8 * BLOCK_SIZE;
+		}
+#endif
+#if defined(__AVX__)
+		while (RUNLEN - blkOff >= 4 * BLOCK_SIZE)
+		{
+			m_blockCipher->Transform512(blkState.data() + blkOff, blkState.data() + blkOff);
+			blkOff += 4 * BLOCK_SIZE;
+		}
+#endif
+		while (blkOff != RUNLEN)
+		{
+			m_blockCipher->Transform(blkState.data() + blkOff, blkState.data() + blkOff);
+			blkOff += BLOCK_SIZE;
 		}
 
-		if (Length != 0)
+		Utility::MemUtils::XorBlock(blkOffsets, 0, blkState, 0, RUNLEN);
+
+		if (!m_isEncryption)
 		{
-			ProcessPartial(Input, InOffset + ALNLEN, Output, OutOffset, Length);
+			Utility::MemUtils::XorBlock(blkState, 0, sumState, 0, RUNLEN);
 		}
+
+		Utility::MemUtils::Copy(blkState, 0, Output, OutOffset, RUNLEN);
+
+		BlockCount -= RUNBLK;
+		InOffset += RUNLEN;
+		OutOffset += RUNLEN;
 	}
 
-	// update the checksum
-	for (size_t i = 0; i < BLKCNT; ++i)
+	for (size_t i = 0; i < WDEBLK; ++i)
 	{
-		Utility::MemUtils::XorBlock(Output, OUTOFF + (i * BLOCK_SIZE), m_checkSum, 0, BLOCK_SIZE);
+		Utility::MemUtils::XOR128(sumState, i * BLOCK_SIZE, Checksum, 0);
 	}
+
+	Utility::MemUtils::Clear(blkOffsets, 0, WDELEN);
+	Utility::MemUtils::Clear(blkState, 0, WDELEN);
+	Utility::MemUtils::Clear(sumState, 0, WDELEN);
 }
 
-void OCB::ParallelEncrypt(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+void OCB::Reset()
 {
-	const size_t BLKCNT = Length / BLOCK_SIZE;
-	const size_t ALNLEN = Length - (Length % BLOCK_SIZE);
-
-	// copy data into working output
-	Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, ALNLEN);
-
-	// pre-fold the checksum
-	for (size_t i = 0; i < BLKCNT; ++i)
+	if (!m_aadPreserve)
 	{
-		Utility::MemUtils::XOR128(Output, OutOffset + (i * BLOCK_SIZE), m_checkSum, 0);
+		m_aadLoaded = false;
+		Utility::MemUtils::Clear(m_aadData, 0, m_aadData.size());
 	}
 
-	// create the offset chain
-	std::vector<byte> offsetChain(ALNLEN);
-	std::vector<byte> hash(BLOCK_SIZE);
+	m_mainBlockCount = 0;
+	Utility::MemUtils::Clear(m_checkSum, 0, m_checkSum.size());
+	Utility::MemUtils::Clear(m_mainOffset, 0, m_mainOffset.size());
+	Utility::MemUtils::Clear(m_mainOffset0, 0, m_mainOffset0.size());
+	Utility::MemUtils::Clear(m_ocbVector, 0, m_ocbVector.size());
+	m_isInitialized = false;
+}
 
-	for (size_t i = 0; i < BLKCNT; ++i)
+template <typename ArrayA, typename ArrayB>
+void OCB::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
+{
+	const size_t BLKCNT = Length / BLOCK_SIZE;
+	const size_t ALNLEN = BLKCNT * BLOCK_SIZE;
+
+	if (BLKCNT != 0)
 	{
-		GetLSub(Ntz(++m_mainBlockCount), hash);
-		Utility::MemUtils::XOR128(hash, 0, m_mainOffset, 0);
-		Utility::MemUtils::COPY128(m_mainOffset, 0, offsetChain, i * BLOCK_SIZE);
-	}
+		// extend the L table to the highest offset index, the table is read-only while processing
+		const ulong MAXIDX = m_mainBlockCount + BLKCNT;
+		size_t tblIdx = 0;
 
-	// parallel offsets
-	const size_t PRLLEN = m_parallelProfile.ParallelBlockSize();
-	const size_t CNKLEN = PRLLEN / m_parallelProfile.ParallelMaxDegree();
-	size_t chainPos = 0;
+		while ((MAXIDX >> (tblIdx + 1)) != 0)
+		{
+			++tblIdx;
+		}
 
-	while (Length >= PRLLEN)
-	{
-		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, &offsetChain, chainPos, CNKLEN](size_t i)
+		if (tblIdx >= m_hashList.size())
 		{
-			this->ProcessSegment(offsetChain, chainPos + (i * CNKLEN), Output, OutOffset + (i * CNKLEN), CNKLEN);
-		});
+			std::vector<byte> hash(BLOCK_SIZE);
+			GetLSub(tblIdx, hash);
+		}
 
-		Length -= PRLLEN;
-		OutOffset += PRLLEN;
-		chainPos += PRLLEN;
-	}
+		size_t prcLen = 0;
 
-	if (Length != 0)
-	{
-		while (Length >= BLOCK_SIZE)
+		if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
 		{
-			Utility::MemUtils::XOR128(offsetChain, chainPos, Output, OutOffset);
-			m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
-			Utility::MemUtils::XOR128(offsetChain, chainPos, Output, OutOffset);
-
-			Length -= BLOCK_SIZE;
-			OutOffset += BLOCK_SIZE;
-			chainPos += BLOCK_SIZE;
+			prcLen = Length - (Length % m_parallelProfile.ParallelBlockSize());
+			ProcessParallel(Input, InOffset, Output, OutOffset, prcLen);
 		}
 
-		if (Length != 0)
+		if (prcLen != ALNLEN)
 		{
-			ProcessPartial(Input, InOffset + ALNLEN, Output, OutOffset, Length);
+			const size_t RMDBLK = (ALNLEN - prcLen) / BLOCK_SIZE;
+
+			ProcessWide(Input, InOffset + prcLen, Output, OutOffset + prcLen, m_mainBlockCount, RMDBLK, m_mainOffset, m_checkSum);
+			m_mainBlockCount += RMDBLK;
 		}
 	}
+
+	if (Length != ALNLEN)
+	{
+		ProcessPartial(Input, InOffset + ALNLEN, Output, OutOffset + ALNLEN, Length - ALNLEN);
+	}
 }
 
-void OCB::ProcessPartial(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, size_t Length)
+template <typename ArrayA, typename ArrayB>
+void OCB::ProcessParallel(const ArrayA &Input, size_t InOffset, ArrayB &Output, size_t OutOffset, size_t Length)
 {
-	if (m_isEncryption)
-	{
-		Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, Length);
-		ExtendBlock(Output, OutOffset + Length);
+	const size_t PRLDGR = m_parallelProfile.ParallelMaxDegree();
+	const size_t PRLLEN = m_parallelProfile.ParallelBlockSize();
+	const size_t CNKLEN = PRLLEN / PRLDGR;
+	const size_t CNKBLK = CNKLEN / BLOCK_SIZE;
+	const ulong BLKIDX = m_mainBlockCount;
+	std::vector<byte> baseOffset(BLOCK_SIZE);
+	std::vector<std::vector<byte>> thdSum(PRLDGR, std::vector<byte>(BLOCK_SIZE, 0));
+	size_t prcLen = 0;
 
-		Utility::MemUtils::XorBlock(Output, OutOffset, m_checkSum, 0, Length + 1);
-		Utility::MemUtils::XOR128(m_listAsterisk, 0, m_mainOffset, 0);
+	// remove the running sum from the current offset, so any block offset can be computed from its index
+	GetOffsetSum(BLKIDX, baseOffset);
+	Utility::MemUtils::XOR128(m_mainOffset, 0, baseOffset, 0);
 
-		std::vector<byte> pad(BLOCK_SIZE);
-		m_hashCipher->Transform(m_mainOffset, 0, pad, 0);
-		Utility::MemUtils::XOR128(pad, 0, Output, OutOffset);
-	}
-	else
+	while (prcLen != Length)
 	{
-		Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, Length);
-		Utility::MemUtils::XOR128(m_listAsterisk, 0, m_mainOffset, 0);
+		const ulong SEGIDX = BLKIDX + (prcLen / BLOCK_SIZE);
 
-		std::vector<byte> pad(BLOCK_SIZE);
-		m_hashCipher->Transform(m_mainOffset, 0, pad, 0);
-		Utility::MemUtils::XorBlock(pad, 0, Output, OutOffset, Length);
+		Utility::ParallelUtils::ParallelFor(0, PRLDGR, [this, &Input, InOffset, &Output, OutOffset, &baseOffset, &thdSum, prcLen, SEGIDX, CNKLEN, CNKBLK](size_t i)
+		{
+			// each segment starts from its own offset, and folds a private checksum
+			const ulong THDIDX = SEGIDX + (i * CNKBLK);
+			std::vector<byte> thdOffset(BLOCK_SIZE);
 
-		std::vector<byte> tmp(BLOCK_SIZE);
-		Utility::MemUtils::Copy(Output, OutOffset, tmp, 0, Length);
-		ExtendBlock(tmp, Length);
-		Utility::MemUtils::XOR128(tmp, 0, m_checkSum, 0);
+			this->GetOffsetSum(THDIDX, thdOffset);
+			Utility::MemUtils::XOR128(baseOffset, 0, thdOffset, 0);
+			this->ProcessWide(Input, InOffset + prcLen + (i * CNKLEN), Output, OutOffset + prcLen + (i * CNKLEN), THDIDX, CNKBLK, thdOffset, thdSum[i]);
+		});
+
+		prcLen += PRLLEN;
 	}
-}
 
-void OCB::Reset()
-{
-	if (!m_aadPreserve)
+	for (size_t i = 0; i < PRLDGR; ++i)
 	{
-		m_aadLoaded = false;
-		Utility::MemUtils::Clear(m_aadData, 0, m_aadData.size());
+		Utility::MemUtils::XOR128(thdSum[i], 0, m_checkSum, 0);
 	}
 
-	m_mainBlockCount = 0;
-	Utility::MemUtils::Clear(m_checkSum, 0, m_checkSum.size());
-	Utility::MemUtils::Clear(m_listAsterisk, 0, m_listAsterisk.size());
-	Utility::MemUtils::Clear(m_listDollar, 0, m_listDollar.size());
-	Utility::MemUtils::Clear(m_mainOffset, 0, m_mainOffset.size());
-	Utility::MemUtils::Clear(m_mainOffset0, 0, m_mainOffset0.size());
-	Utility::MemUtils::Clear(m_mainStretch, 0, m_mainStretch.size());
-	Utility::MemUtils::Clear(m_ocbVector, 0, m_ocbVector.size());
-	Utility::MemUtils::Clear(m_topInput, 0, m_topInput.size());
-	m_hashList.clear();
-	m_isInitialized = false;
+	m_mainBlockCount += Length / BLOCK_SIZE;
+	GetOffsetSum(m_mainBlockCount, m_mainOffset);
+	Utility::MemUtils::XOR128(baseOffset, 0, m_mainOffset, 0);
 }
 
 void OCB::Scope()
@@ -810,9 +810,6 @@ void OCB::Scope()
 		m_legalKeySizes[i] = SymmetricKeySize(keySizes[i].KeySize(), MAX_NONCESIZE, keySizes[i].NonceSize());
 	}
 
-	m_hashList.clear();
-	m_hashList.reserve(PREFETCH_HASH);
-
 	if (!m_parallelProfile.IsDefault())
 	{
 		m_parallelProfile.Calculate();
@@ -106,6 +106,8 @@ NAMESPACE_MODE
 /// <item><description>Calling the Finalize(Output, Offset, Length) function writes the MAC code to the output array in either encryption or decryption operation mode.</description></item>
 /// <item><description>The Verify(Input, Offset, Length) function can be used to compare the MAC code embedded with the cipher-text to the internal MAC code generated after a Decryption cycle.</description></item>
 /// <item><description>Encryption and decryption can both be pipelined (SSE3-128 or AVX-256), and multi-threaded.</description></item>
+/// <item><description>The L table is computed once when a key is loaded, and is retained across nonce-only initializations; the offsets of each run of 16 blocks are taken from the table, so sequential input is also processed with the wide block cipher transforms.</description></item>
+/// <item><description>Parallel segments compute their starting offsets directly from the L table, and fold their checksums independently.</description></item>
 /// <item><description>If the system supports Parallel processing, and IsParallel() is set to true; passing an input block of ParallelBlockSize() to the transform will be auto parallelized.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
@@ -406,6 +408,18 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
 	/// <summary>
 	/// Generate the internal MAC code and compare it with the tag contained in the Input array.   
 	/// <para>This function finalizes the Decryption cycle and generates the MAC tag.
@@ -427,18 +441,26 @@ public:
 private:
 
 	void CalculateMac();
-	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
 	void DoubleBlock(const std::vector<byte> &Input, std::vector<byte> &Output);
-	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
 	void ExtendBlock(std::vector<byte> &Output, size_t Position);
 	void GenerateOffsets(const std::vector<byte> &Nonce);
+	void GenerateTable();
 	void GetLSub(size_t N, std::vector<byte> &LSub);
+	void GetOffsetSum(ulong Index, std::vector<byte> &Output);
 	uint Ntz(ulong X);
-	void ParallelDecrypt(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length);
-	void ParallelEncrypt(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length);
-	void ProcessPartial(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, size_t Length);
-	void ProcessSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void ProcessParallel(const ArrayA &Input, size_t InOffset, ArrayB &Output, size_t OutOffset, size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void ProcessPartial(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void ProcessWide(const ArrayA &Input, size_t InOffset, ArrayB &Output, size_t OutOffset, ulong BlockIndex, size_t BlockCount, std::vector<byte> &Offset, std::vector<byte> &Checksum);
 	void Reset();
+	template <typename ArrayA, typename ArrayB>
+	void Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
 	void Scope();
 };
 
@@ -1,4 +1,5 @@
 #include "OFB.h"
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
 #include "IntUtils.h"
 
@@ -205,22 +206,22 @@ void OFB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= m_blockCipher->BlockSize(), "The data arrays are smaller than the the block-size!");
 	CexAssert(Length % m_blockCipher->BlockSize() == 0, "The length must be evenly divisible by the block ciphers block-size!");
 
-	const size_t BLKLEN = m_blockCipher->BlockSize();
+	Process(Input, InOffset, Output, OutOffset, Length);
+}
 
-	if (Length % BLKLEN != 0)
-	{
-		throw CryptoCipherModeException("OFB:Transform", "Invalid length, must be evenly divisible by the ciphers block size!");
-	}
+void OFB::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(Length % m_blockCipher->BlockSize() == 0, "The length must be evenly divisible by the block ciphers block-size!");
 
-	const size_t BLKCNT = Length / BLKLEN;
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
 
-	for (size_t i = 0; i < BLKCNT; ++i)
-	{
-		EncryptBlock(Input, (i * BLKLEN) + InOffset, Output, (i * BLKLEN) + OutOffset);
-	}
+	Process(inp, 0, otp, 0, Length);
 }
 
-void OFB::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void OFB::Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= m_blockCipher->BlockSize(), "The data arrays are smaller than the the block-size!");
@@ -243,4 +244,22 @@ void OFB::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::MemUtils::Copy(m_ofbBuffer, 0, m_ofbVector, m_ofbVector.size() - m_blockSize, m_blockSize);
 }
 
+template <typename ArrayA, typename ArrayB>
+void OFB::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
+{
+	const size_t BLKLEN = m_blockCipher->BlockSize();
+
+	if (Length % BLKLEN != 0)
+	{
+		throw CryptoCipherModeException("OFB:Transform", "Invalid length, must be evenly divisible by the ciphers block size!");
+	}
+
+	const size_t BLKCNT = Length / BLKLEN;
+
+	for (size_t i = 0; i < BLKCNT; ++i)
+	{
+		Encrypt128(Input, (i * BLKLEN) + InOffset, Output, (i * BLKLEN) + OutOffset);
+	}
+}
+
 NAMESPACE_MODEEND
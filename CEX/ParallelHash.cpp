@@ -0,0 +1,401 @@
+#include "ParallelHash.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+
+NAMESPACE_DIGEST
+
+using Utility::IntUtils;
+using Utility::MemUtils;
+
+const std::string ParallelHash::CLASS_NAME("ParallelHash");
+
+//~~~Constructor~~~//
+
+ParallelHash::ParallelHash(ShakeModes ShakeMode, size_t LeafSize, bool Extendable, bool Parallel)
+	:
+	m_blockSize((ShakeMode == ShakeModes::SHAKE128) ? 168 : 136),
+	m_customization(0),
+	m_digestSize((ShakeMode == ShakeModes::SHAKE128) ? 32 : 64),
+	m_isDestroyed(false),
+	m_isExtendable(Extendable),
+	m_isInitialized(false),
+	m_leafCount(0),
+	m_leafSize(LeafSize != 0 ? LeafSize :
+		throw CryptoDigestException("ParallelHash:Ctor", "The leaf size can not be zero!")),
+	m_msgBuffer(LEAF_BATCH * LeafSize),
+	m_msgLength(0),
+	m_parallelProfile(LeafSize, false, 0, false),
+	m_shakeMode(ShakeMode == ShakeModes::SHAKE128 || ShakeMode == ShakeModes::SHAKE256 ? ShakeMode :
+		throw CryptoDigestException("ParallelHash:Ctor", "The SHAKE mode must be SHAKE128 or SHAKE256!")),
+	m_stateLength(0)
+{
+	if (Parallel && !m_parallelProfile.IsParallel())
+	{
+		throw CryptoDigestException("ParallelHash:Ctor", "Cpu does not support parallel processing!");
+	}
+
+	if (m_parallelProfile.IsParallel())
+	{
+		m_parallelProfile.IsParallel() = Parallel;
+	}
+
+	Reset();
+}
+
+ParallelHash::~ParallelHash()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_blockSize = 0;
+		m_digestSize = 0;
+		m_isExtendable = false;
+		m_isInitialized = false;
+		m_leafCount = 0;
+		m_leafSize = 0;
+		m_msgLength = 0;
+		m_parallelProfile.Reset();
+		m_shakeMode = ShakeModes::None;
+		m_stateLength = 0;
+
+		IntUtils::ClearArray(m_dgtState);
+		IntUtils::ClearArray(m_stateBuffer);
+		IntUtils::ClearVector(m_customization);
+		IntUtils::ClearVector(m_msgBuffer);
+	}
+}
+
+//~~~Accessors~~~//
+
+size_t ParallelHash::BlockSize()
+{
+	return m_blockSize;
+}
+
+std::vector<byte> &ParallelHash::Customization()
+{
+	return m_customization;
+}
+
+size_t ParallelHash::DigestSize()
+{
+	return m_digestSize;
+}
+
+const Digests ParallelHash::Enumeral()
+{
+	return (m_shakeMode == ShakeModes::SHAKE128) ? Digests::ParallelHash128 : Digests::ParallelHash256;
+}
+
+const bool ParallelHash::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+const size_t ParallelHash::LeafSize()
+{
+	return m_leafSize;
+}
+
+const std::string ParallelHash::Name()
+{
+	std::string txtName = CLASS_NAME + ((m_shakeMode == ShakeModes::SHAKE128) ? "128" : "256");
+
+	if (m_isExtendable)
+	{
+		txtName += "XOF";
+	}
+
+	if (m_parallelProfile.IsParallel())
+	{
+		txtName += "-P" + IntUtils::ToString(m_parallelProfile.ParallelMaxDegree());
+	}
+
+	return txtName;
+}
+
+const size_t ParallelHash::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+ParallelOptions &ParallelHash::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+//~~~Public Functions~~~//
+
+void ParallelHash::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	Output.resize(m_digestSize);
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+size_t ParallelHash::Finalize(std::vector<byte> &Output, const size_t OutOffset)
+{
+	return Finalize(Output, OutOffset, m_digestSize);
+}
+
+size_t ParallelHash::Finalize(std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	CexAssert(Output.size() - OutOffset >= Length, "The Output buffer is too short!");
+
+	std::array<byte, 2 * (sizeof(size_t) + 1)> enc;
+	size_t encLen;
+	size_t outLen;
+
+	if (!m_isInitialized)
+	{
+		LoadPrefix();
+	}
+
+	// the buffered leaves; only the last can be partial
+	if (m_msgLength != 0)
+	{
+		const size_t LEFCNT = (m_msgLength + m_leafSize - 1) / m_leafSize;
+		HashLeaves(m_msgBuffer.data(), LEFCNT, m_msgLength - ((LEFCNT - 1) * m_leafSize));
+		m_msgLength = 0;
+	}
+
+	// right_encode(n) || right_encode(L), the XOF variant encodes a length of zero
+	encLen = RightEncode(enc, 0, m_leafCount);
+	encLen += RightEncode(enc, encLen, m_isExtendable ? 0 : Length * 8);
+	Absorb(enc.data(), encLen);
+
+	MemUtils::Clear(m_stateBuffer, m_stateLength, m_blockSize - m_stateLength);
+	m_stateBuffer[m_stateLength] = CSHAKE_DOMAIN;
+	m_stateBuffer[m_blockSize - 1] |= 0x80;
+
+	for (size_t i = 0; i < m_blockSize / sizeof(ulong); ++i)
+	{
+		m_dgtState[i] ^= IntUtils::LeBytesTo64(m_stateBuffer, i * sizeof(ulong));
+	}
+
+	Keccak::PermuteR24P1600(m_dgtState);
+	outLen = Length;
+
+	while (outLen != 0)
+	{
+		const size_t BLKLEN = IntUtils::Min(m_blockSize, outLen);
+
+		for (size_t i = 0; i < BLKLEN; ++i)
+		{
+			Output[OutOffset + i] = static_cast<byte>(m_dgtState[i / sizeof(ulong)] >> (8 * (i % sizeof(ulong))));
+		}
+
+		OutOffset += BLKLEN;
+		outLen -= BLKLEN;
+
+		if (outLen != 0)
+		{
+			Keccak::PermuteR24P1600(m_dgtState);
+		}
+	}
+
+	Reset();
+
+	return Length;
+}
+
+void ParallelHash::ParallelMaxDegree(size_t Degree)
+{
+	CexAssert(Degree != 0, "parallel degree can not be zero");
+	CexAssert(Degree <= m_parallelProfile.ProcessorCount(), "parallel degree can not exceed processor count");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+	Reset();
+}
+
+void ParallelHash::Reset()
+{
+	MemUtils::Clear(m_dgtState, 0, STATE_SIZE * sizeof(ulong));
+	MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	MemUtils::Clear(m_stateBuffer, 0, m_stateBuffer.size());
+	m_isInitialized = false;
+	m_leafCount = 0;
+	m_msgLength = 0;
+	m_stateLength = 0;
+}
+
+void ParallelHash::Update(byte Input)
+{
+	Process(&Input, 1);
+}
+
+void ParallelHash::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	CexAssert(Input.size() - InOffset >= Length, "The Input buffer is too short!");
+
+	if (Length != 0)
+	{
+		Process(Input.data() + InOffset, Length);
+	}
+}
+
+void ParallelHash::Update(const byte* Input, size_t Length)
+{
+	Process(Input, Length);
+}
+
+//~~~Private Functions~~~//
+
+void ParallelHash::Absorb(const byte* Input, size_t Length)
+{
+	while (Length != 0)
+	{
+		const size_t CPYLEN = IntUtils::Min(m_blockSize - m_stateLength, Length);
+
+		std::memcpy(m_stateBuffer.data() + m_stateLength, Input, CPYLEN);
+		m_stateLength += CPYLEN;
+		Input += CPYLEN;
+		Length -= CPYLEN;
+
+		if (m_stateLength == m_blockSize)
+		{
+			for (size_t i = 0; i < m_blockSize / sizeof(ulong); ++i)
+			{
+				m_dgtState[i] ^= IntUtils::LeBytesTo64(m_stateBuffer, i * sizeof(ulong));
+			}
+
+			Keccak::PermuteR24P1600(m_dgtState);
+			m_stateLength = 0;
+		}
+	}
+}
+
+void ParallelHash::HashLeaves(const byte* Input, size_t Count, size_t LastLength)
+{
+	// the leaf code is SHAKE with an output of twice the security strength (2C bits)
+	const size_t CODLEN = m_digestSize;
+	const size_t LEFRTE = m_blockSize;
+
+	while (Count != 0)
+	{
+		const size_t LEFCNT = IntUtils::Min(Count, LEAF_MAXBATCH);
+		const size_t THDCNT = m_parallelProfile.IsParallel() ? IntUtils::Min(m_parallelProfile.ParallelMaxDegree(), LEFCNT / LEAF_BATCH) : 1;
+		std::vector<const byte*> lefPtr(LEFCNT);
+		std::vector<size_t> lefLen(LEFCNT, m_leafSize);
+		std::vector<byte> code(LEFCNT * CODLEN);
+
+		for (size_t i = 0; i < LEFCNT; ++i)
+		{
+			lefPtr[i] = Input + (i * m_leafSize);
+		}
+
+		if (LEFCNT == Count)
+		{
+			lefLen[LEFCNT - 1] = LastLength;
+		}
+
+		if (THDCNT > 1)
+		{
+			// contiguous ranges of leaves, each thread writes the codes of its own range
+			const size_t THDLEF = (LEFCNT + THDCNT - 1) / THDCNT;
+
+			Utility::ParallelUtils::ParallelFor(0, THDCNT, [&lefPtr, &lefLen, &code, CODLEN, LEFRTE, LEFCNT, THDLEF](size_t i)
+			{
+				const size_t LEFOFT = IntUtils::Min(i * THDLEF, LEFCNT);
+				const size_t LEFEND = IntUtils::Min(LEFOFT + THDLEF, LEFCNT);
+
+				if (LEFEND != LEFOFT)
+				{
+					std::vector<const byte*> thdPtr(lefPtr.begin() + LEFOFT, lefPtr.begin() + LEFEND);
+					std::vector<size_t> thdLen(lefLen.begin() + LEFOFT, lefLen.begin() + LEFEND);
+
+					Keccak::PermuteBatch(thdPtr, thdLen, code, LEFOFT * CODLEN, CODLEN, LEFRTE, SHAKE_DOMAIN, 24, true);
+				}
+			});
+		}
+		else
+		{
+			Keccak::PermuteBatch(lefPtr, lefLen, code, 0, CODLEN, LEFRTE, SHAKE_DOMAIN, 24, true);
+		}
+
+		Absorb(code.data(), code.size());
+		m_leafCount += LEFCNT;
+		Input += LEFCNT * m_leafSize;
+		Count -= LEFCNT;
+	}
+}
+
+void ParallelHash::LoadPrefix()
+{
+	// bytepad(encode_string("ParallelHash") || encode_string(S), rate) || left_encode(B)
+	const std::string FNCNAME = CLASS_NAME;
+	std::array<byte, sizeof(size_t) + 1> enc;
+	size_t encLen;
+
+	encLen = LeftEncode(enc, 0, m_blockSize);
+	Absorb(enc.data(), encLen);
+	encLen = LeftEncode(enc, 0, FNCNAME.size() * 8);
+	Absorb(enc.data(), encLen);
+	Absorb(reinterpret_cast<const byte*>(FNCNAME.data()), FNCNAME.size());
+	encLen = LeftEncode(enc, 0, m_customization.size() * 8);
+	Absorb(enc.data(), encLen);
+
+	if (m_customization.size() != 0)
+	{
+		Absorb(m_customization.data(), m_customization.size());
+	}
+
+	if (m_stateLength != 0)
+	{
+		// zero pad to the rate
+		const std::array<byte, 168> PADBLK = { 0 };
+		Absorb(PADBLK.data(), m_blockSize - m_stateLength);
+	}
+
+	encLen = LeftEncode(enc, 0, m_leafSize);
+	Absorb(enc.data(), encLen);
+	m_isInitialized = true;
+}
+
+void ParallelHash::Process(const byte* Input, size_t Length)
+{
+	if (Length != 0)
+	{
+		if (!m_isInitialized)
+		{
+			LoadPrefix();
+		}
+
+		// complete the buffered leaves
+		if (m_msgLength != 0)
+		{
+			const size_t CPYLEN = IntUtils::Min(m_msgBuffer.size() - m_msgLength, Length);
+
+			std::memcpy(m_msgBuffer.data() + m_msgLength, Input, CPYLEN);
+			m_msgLength += CPYLEN;
+			Input += CPYLEN;
+			Length -= CPYLEN;
+
+			if (m_msgLength == m_msgBuffer.size())
+			{
+				HashLeaves(m_msgBuffer.data(), LEAF_BATCH, m_leafSize);
+				m_msgLength = 0;
+			}
+		}
+
+		// hash the whole leaves directly from the input
+		if (Length >= m_msgBuffer.size())
+		{
+			const size_t LEFCNT = Length / m_leafSize;
+
+			HashLeaves(Input, LEFCNT, m_leafSize);
+			Input += LEFCNT * m_leafSize;
+			Length -= LEFCNT * m_leafSize;
+		}
+
+		if (Length != 0)
+		{
+			std::memcpy(m_msgBuffer.data() + m_msgLength, Input, Length);
+			m_msgLength += Length;
+		}
+	}
+}
+
+NAMESPACE_DIGESTEND
@@ -0,0 +1,306 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Principal Algorithms:
+// The ParallelHash function defined in NIST SP800-185, built on the cSHAKE and SHAKE functions of the SHA-3 standard.
+// SP800-185 <a href="http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf">SHA-3 Derived Functions</a>.
+//
+// Implementation Details:
+// An implementation of the ParallelHash128, ParallelHash256, and ParallelHashXOF digests.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_PARALLELHASH_H
+#define CEX_PARALLELHASH_H
+
+#include "IDigest.h"
+#include "ShakeModes.h"
+
+NAMESPACE_DIGEST
+
+using Enumeration::ShakeModes;
+
+/// <summary>
+/// An implementation of the NIST SP800-185 ParallelHash digest
+/// </summary>
+///
+/// <example>
+/// <description>Example using the Compute method:</description>
+/// <code>
+/// ParallelHash digest(ShakeModes::SHAKE128);
+/// std:vector&lt;byte&gt; hash(digest.DigestSize(), 0);
+/// // compute a hash
+/// digest.Compute(Input, hash);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>Output aligns with the NIST SP800-185 ParallelHash128 and ParallelHash256 functions, selected with the SHAKE128 and SHAKE256 modes.</description></item>
+/// <item><description>The message is split into leaves of LeafSize bytes, each leaf is hashed with SHAKE, and the leaf codes are absorbed in order by cSHAKE with the function name 'ParallelHash'.</description></item>
+/// <item><description>Leaves are hashed together with the multi-state Keccak permutation, 4 per permutation with AVX2 and 8 with AVX512, and across threads when the parallel mode is enabled.</description></item>
+/// <item><description>Unlike the Keccak tree hashing modes, the hash value does not depend on the thread count or the instruction set, only on the leaf size and the customization string.</description></item>
+/// <item><description>Digest sizes are 32 bytes for ParallelHash128 and 64 bytes for ParallelHash256; any output length can be requested with the Finalize(Output, Offset, Length) function.</description></item>
+/// <item><description>Initializing with the Extendable flag set produces the ParallelHashXOF variant, in which the output length is not bound into the hash.</description></item>
+/// <item><description>The <see cref="Finalize(byte[], int)"/> method resets the internal state; the customization string and leaf size are retained.</description></item>
+/// </list>
+///
+/// <list type="number">
+/// <item><description>NIST <a href = "http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf">SP800-185</a> SHA-3 Derived Functions.</description></item>
+/// <item><description>SHA3 <a href="http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf">Fips202</a>.</description></item>
+/// </list>
+/// </remarks>
+class ParallelHash final : public IDigest
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const byte CSHAKE_DOMAIN = 0x04;
+	static const size_t DEF_LEAFSIZE = 8192;
+	// the number of leaves buffered before the leaf codes are computed in a batch
+	static const size_t LEAF_BATCH = 8;
+	// the maximum number of leaves hashed with a single batch call, bounds the size of the leaf code buffer
+	static const size_t LEAF_MAXBATCH = 1024;
+	static const byte SHAKE_DOMAIN = 0x1F;
+	static const size_t STATE_SIZE = 25;
+
+	size_t m_blockSize;
+	std::vector<byte> m_customization;
+	std::array<ulong, STATE_SIZE> m_dgtState;
+	size_t m_digestSize;
+	bool m_isDestroyed;
+	bool m_isExtendable;
+	bool m_isInitialized;
+	size_t m_leafCount;
+	size_t m_leafSize;
+	std::vector<byte> m_msgBuffer;
+	size_t m_msgLength;
+	ParallelOptions m_parallelProfile;
+	ShakeModes m_shakeMode;
+	std::array<byte, 168> m_stateBuffer;
+	size_t m_stateLength;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	ParallelHash(const ParallelHash&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	ParallelHash& operator=(const ParallelHash&) = delete;
+
+	/// <summary>
+	/// Initialize the digest with the security strength, the leaf size, and the output mode
+	/// </summary>
+	///
+	/// <param name="ShakeMode">The security strength; SHAKE128 selects ParallelHash128, SHAKE256 selects ParallelHash256</param>
+	/// <param name="LeafSize">The leaf (B) size in bytes; the default is 8192 bytes</param>
+	/// <param name="Extendable">Use the ParallelHashXOF variant, the output length is not bound into the hash</param>
+	/// <param name="Parallel">Hash the leaves on multiple threads; the hash value is not changed by this setting</param>
+	///
+	/// <exception cref="Exception::CryptoDigestException">Thrown if the mode is not SHAKE128 or SHAKE256, the leaf size is zero, or parallel processing is not available</exception>
+	explicit ParallelHash(ShakeModes ShakeMode = ShakeModes::SHAKE128, size_t LeafSize = DEF_LEAFSIZE, bool Extendable = false, bool Parallel = false);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~ParallelHash() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The cSHAKE rate in bytes; 168 for ParallelHash128, 136 for ParallelHash256
+	/// </summary>
+	size_t BlockSize() override;
+
+	/// <summary>
+	/// Read/Write: The customization string (S), the default is an empty string.
+	/// <para>Must be set before the first call to Update, or after a call to Finalize or Reset.</para>
+	/// </summary>
+	std::vector<byte> &Customization();
+
+	/// <summary>
+	/// Read Only: Size of the default digest output in bytes
+	/// </summary>
+	size_t DigestSize() override;
+
+	/// <summary>
+	/// Read Only: The digests type name
+	/// </summary>
+	const Digests Enumeral() override;
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability.
+	/// <para>Indicates whether the leaves are hashed on multiple threads.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Read Only: The leaf (B) size in bytes
+	/// </summary>
+	const size_t LeafSize();
+
+	/// <summary>
+	/// Read Only: The digests class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input data array passed to the Update function that triggers parallel processing.
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Read/Write: Contains parallel settings and SIMD capability flags in a ParallelOptions structure.
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree(size_t) function.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Get the Hash value
+	/// </summary>
+	///
+	/// <param name="Input">Input data</param>
+	/// <param name="Output">The hash output value array</param>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Do final processing and get the hash value
+	/// </summary>
+	///
+	/// <param name="Output">The Hash output value array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	///
+	/// <returns>Size of Hash value</returns>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Do final processing and get a hash value of any length
+	/// <para>In the standard mode the output length is bound into the hash, in the Extendable (XOF) mode a shorter output is a prefix of a longer output.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The Hash output value array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	/// <param name="Length">The number of hash bytes to generate</param>
+	///
+	/// <returns>Size of Hash value</returns>
+	size_t Finalize(std::vector<byte> &Output, size_t OutOffset, size_t Length);
+
+	/// <summary>
+	/// Set the number of threads allocated when hashing the leaves on multiple threads.
+	/// <para>Changing this value does not change the hash value.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Reset the internal state
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Update the digest with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input byte</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the buffer
+	/// </summary>
+	///
+	/// <param name="Input">Input data</param>
+	/// <param name="InOffset">The starting offset within the Input array</param>
+	/// <param name="Length">Amount of data to process in bytes</param>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+	/// <summary>
+	/// Update the digest with a length of bytes using caller owned memory
+	/// </summary>
+	///
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
+private:
+
+	template<typename Array>
+	static size_t LeftEncode(Array &Buffer, size_t Offset, size_t Value)
+	{
+		size_t i;
+		size_t n;
+		size_t v;
+
+		for (v = Value, n = 0; v && (n < sizeof(size_t)); ++n, v >>= 8);
+
+		if (n == 0)
+		{
+			n = 1;
+		}
+
+		for (i = 1; i <= n; ++i)
+		{
+			Buffer[Offset + i] = static_cast<byte>(Value >> (8 * (n - i)));
+		}
+
+		Buffer[Offset] = static_cast<byte>(n);
+
+		return (n + 1);
+	}
+
+	template<typename Array>
+	static size_t RightEncode(Array &Buffer, size_t Offset, size_t Value)
+	{
+		size_t i;
+		size_t n;
+		size_t v;
+
+		for (v = Value, n = 0; v && (n < sizeof(size_t)); ++n, v >>= 8);
+
+		if (n == 0)
+		{
+			n = 1;
+		}
+
+		for (i = 1; i <= n; ++i)
+		{
+			Buffer[Offset + (i - 1)] = static_cast<byte>(Value >> (8 * (n - i)));
+		}
+
+		Buffer[Offset + n] = static_cast<byte>(n);
+
+		return (n + 1);
+	}
+
+	void Absorb(const byte* Input, size_t Length);
+	void HashLeaves(const byte* Input, size_t Count, size_t LastLength);
+	void LoadPrefix();
+	void Process(const byte* Input, size_t Length);
+};
+
+NAMESPACE_DIGESTEND
+#endif
@@ -106,6 +106,11 @@ const bool ParallelOptions::HasSimd256()
 	return m_hasSimd256; 
 }
 
+const bool ParallelOptions::HasSimd512() 
+{ 
+	return m_hasSimd512; 
+}
+
 const size_t ParallelOptions::L1DataCacheTotalSize()
 { 
 	return m_l1DataCacheTotal;
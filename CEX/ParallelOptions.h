@@ -158,6 +158,11 @@ public:
 	/// </summary>
 	const bool HasSimd256();
 
+	/// <summary>
+	/// Read Only: Returns True if the system supports 512bit AVX512 intrinsics
+	/// </summary>
+	const bool HasSimd512();
+
 	/// <summary>
 	/// Read Only: The total size in bytes of the L1 Data cache available on the system
 	/// </summary>
@@ -1,5 +1,8 @@
 #include "ParallelUtils.h"
+#include "ThreadPool.h"
 
+#include <memory>
+#include <mutex>
 #if defined(CEX_HAS_OPENMP)
 #	include <omp.h>
 #else
@@ -8,6 +11,21 @@
 
 NAMESPACE_UTILITY
 
+// the registered executor is replaced as a whole under the lock; a running loop holds its own reference, so a concurrent SetExecutor can not destroy it
+static std::mutex &ExecutorLock()
+{
+	static std::mutex lock;
+
+	return lock;
+}
+
+static std::shared_ptr<const ParallelUtils::ParallelExecutor> &HostExecutor()
+{
+	static std::shared_ptr<const ParallelUtils::ParallelExecutor> exec;
+
+	return exec;
+}
+
 size_t ParallelUtils::ProcessorCount()
 {
 #if defined(CEX_HAS_OPENMP)
@@ -17,33 +35,36 @@ size_t ParallelUtils::ProcessorCount()
 #endif
 }
 
+void ParallelUtils::ParallelChunk(size_t Length, size_t ChunkSize, const std::function<void(size_t, size_t)> &F)
+{
+	CexAssert(ChunkSize != 0, "the chunk size can not be zero");
+
+	const size_t CNKCNT = (Length + ChunkSize - 1) / ChunkSize;
+
+	ParallelFor(0, CNKCNT, [Length, ChunkSize, &F](size_t i)
+	{
+		const size_t CNKOFT = i * ChunkSize;
+		F(CNKOFT, (Length - CNKOFT < ChunkSize) ? Length - CNKOFT : ChunkSize);
+	});
+}
+
 void ParallelUtils::ParallelFor(size_t From, size_t To, const std::function<void(size_t)> &F)
 {
-#if defined(CEX_HAS_OPENMP)
-#	pragma omp parallel num_threads(static_cast<int>(To))
+	std::shared_ptr<const ParallelExecutor> exec;
+
 	{
-		size_t i = From + static_cast<size_t>(omp_get_thread_num());
-		F(i);
+		std::lock_guard<std::mutex> lock(ExecutorLock());
+		exec = HostExecutor();
 	}
-#else
-	std::vector<std::future<void>> futures;
 
-	for (size_t i = From; i < To; ++i)
+	if (exec != nullptr)
 	{
-		auto fut = std::async([i, F]()
-		{
-			F(i);
-		});
-		futures.push_back(std::move(fut));
+		(*exec)(From, To, F);
 	}
-
-	for (size_t i = 0; i < futures.size(); ++i)
+	else
 	{
-		futures[i].wait();
+		ThreadPool::Default().ParallelFor(From, To, F);
 	}
-
-	futures.clear();
-#endif
 }
 
 void ParallelUtils::ParallelTask(const std::function<void()> &F)
@@ -66,6 +87,19 @@ void ParallelUtils::ParallelTask(const std::function<void()> &F)
 #endif
 }
 
+void ParallelUtils::SetExecutor(const ParallelExecutor &Executor)
+{
+	std::shared_ptr<const ParallelExecutor> exec;
+
+	if (Executor)
+	{
+		exec = std::make_shared<const ParallelExecutor>(Executor);
+	}
+
+	std::lock_guard<std::mutex> lock(ExecutorLock());
+	HostExecutor() = exec;
+}
+
 void ParallelUtils::Vectorize(const std::function<void()> &F)
 {
 #if defined(CEX_OPENMP_VERSION_30)
@@ -27,10 +27,28 @@ NAMESPACE_UTILITY
 /// <summary>
 /// Parallel functions class
 /// </summary> 
+/// 
+/// <remarks>
+/// <para>Parallel loops are dispatched to the persistent ThreadPool::Default() worker pool, unless the host application has installed its own executor with SetExecutor.</para>
+/// </remarks>
 class ParallelUtils
 {
 public:
 
+	/// <summary>
+	/// A host supplied executor; must call the function delegate once for each index in [From, To), and return only after every call has completed
+	/// </summary>
+	typedef std::function<void(size_t, size_t, const std::function<void(size_t)>&)> ParallelExecutor;
+
+	/// <summary>
+	/// Split a range into fixed size chunks and process each chunk in parallel, returning when all chunks have completed
+	/// </summary>
+	/// 
+	/// <param name="Length">The total length of the range</param>
+	/// <param name="ChunkSize">The length of each chunk; the last chunk holds the remainder</param>
+	/// <param name="F">The function delegate, called with the chunk offset and chunk length</param>
+	static void ParallelChunk(size_t Length, size_t ChunkSize, const std::function<void(size_t, size_t)> &F);
+
 	/// <summary>
 	/// A multi-threaded parallel For loop
 	/// </summary>
@@ -52,6 +70,15 @@ public:
 	/// </summary>
 	static size_t ProcessorCount();
 
+	/// <summary>
+	/// Replace the internal thread pool with an executor supplied by the host application.
+	/// <para>Pass an empty function to restore the internal thread pool. 
+	/// Registration is synchronized with running parallel loops; a loop that has already started completes on the executor it started with.</para>
+	/// </summary>
+	/// 
+	/// <param name="Executor">The host executor, or an empty function</param>
+	static void SetExecutor(const ParallelExecutor &Executor);
+
 	/// <summary>
 	/// An SIMD vectorized For loop (not currently used, requires a higher version of OpenMP)
 	/// </summary>
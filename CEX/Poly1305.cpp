@@ -1,6 +1,14 @@
 #include "Poly1305.h"
+#include "ArraySpan.h"
 #include "BlockCipherFromName.h"
+#include "CpuDetect.h"
 #include "IntUtils.h"
+#if defined(CEX_HAS_UMUL128)
+#	include <intrin.h>
+#endif
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#endif
 
 NAMESPACE_MAC
 
@@ -15,6 +23,8 @@ Poly1305::Poly1305(BlockCiphers CipherType)
 	m_autoClamp(true),
 	m_blockCipher(CipherType != BlockCiphers::None ? Helper::BlockCipherFromName::GetInstance(CipherType) : nullptr),
 	m_destroyEngine(true),
+	m_hasAVX2(false),
+	m_hasMul128(false),
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes{ SymmetricKeySize(KEY_SIZE, 0, 0), SymmetricKeySize(KEY_SIZE, BLOCK_SIZE, 0) },
@@ -26,6 +36,8 @@ Poly1305::Poly1305(BlockCiphers CipherType)
 	{
 		throw CryptoMacException("Poly1305:Ctor", "HX ciphers are not supported with Poly1305!");
 	}
+
+	Detect();
 }
 
 Poly1305::Poly1305(IBlockCipher* Cipher)
@@ -34,6 +46,8 @@ Poly1305::Poly1305(IBlockCipher* Cipher)
 	m_blockCipher(Cipher != nullptr ? Cipher : 
 		throw CryptoMacException("Poly1305:Ctor", "The block cipher instance can not be null!")),
 	m_destroyEngine(false),
+	m_hasAVX2(false),
+	m_hasMul128(false),
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes{ SymmetricKeySize(KEY_SIZE, 0, 0), SymmetricKeySize(KEY_SIZE, BLOCK_SIZE, 0) },
@@ -45,6 +59,8 @@ Poly1305::Poly1305(IBlockCipher* Cipher)
 	{
 		throw CryptoMacException("Poly1305:Ctor", "HX ciphers are not supported with Poly1305!");
 	}
+
+	Detect();
 }
 
 Poly1305::~Poly1305()
@@ -52,6 +68,8 @@ Poly1305::~Poly1305()
 	if (!m_isDestroyed)
 	{
 		m_isDestroyed = true;
+		m_hasAVX2 = false;
+		m_hasMul128 = false;
 		m_isInitialized = false;
 		m_msgLength = 0;
 		m_macState.Reset();
@@ -104,6 +122,23 @@ const bool Poly1305::IsInitialized()
 	return m_isInitialized;
 }
 
+const size_t Poly1305::LimbWidth()
+{
+	return m_hasMul128 ? 44 : 26;
+}
+
+void Poly1305::LimbWidth(size_t Width)
+{
+	if (m_isInitialized)
+	{
+		throw CryptoMacException("Poly1305:LimbWidth", "The limb width must be set before the Mac is initialized!");
+	}
+
+	// a width can only be lowered from what the compiler supports
+	Detect();
+	m_hasMul128 = m_hasMul128 && (Width >= 44);
+}
+
 std::vector<SymmetricKeySize> Poly1305::LegalKeySizes() const
 {
 	return m_legalKeySizes;
@@ -153,56 +188,123 @@ size_t Poly1305::Finalize(std::vector<byte> &Output, size_t OutOffset)
 		ProcessBlock(m_msgBuffer, 0, m_msgLength);
 	}
 
-	uint b = m_macState.H[0] >> 26;
-	m_macState.H[0] = m_macState.H[0] & 0x3FFFFFFUL;
-	m_macState.H[1] += b;
-	b = m_macState.H[1] >> 26; 
-	m_macState.H[1] = m_macState.H[1] & 0x3FFFFFFUL;
-	m_macState.H[2] += b; 
-	b = m_macState.H[2] >> 26;
-	m_macState.H[2] = m_macState.H[2] & 0x3FFFFFFUL;
-	m_macState.H[3] += b;
-	b = m_macState.H[3] >> 26; 
-	m_macState.H[3] = m_macState.H[3] & 0x3FFFFFFUL;
-	m_macState.H[4] += b; 
-	b = m_macState.H[4] >> 26; 
-	m_macState.H[4] = m_macState.H[4] & 0x3FFFFFFUL;
-	m_macState.H[0] += b * 5;
-
-	uint g0 = m_macState.H[0] + 5;
-	b = g0 >> 26;
-	g0 &= 0x3FFFFFFUL;
-	uint g1 = m_macState.H[1] + b;
-	b = g1 >> 26; 
-	g1 &= 0x3FFFFFFUL;
-	uint g2 = m_macState.H[2] + b;
-	b = g2 >> 26;
-	g2 &= 0x3FFFFFFUL;
-	uint g3 = m_macState.H[3] + b;
-	b = g3 >> 26; 
-	g3 &= 0x3FFFFFFUL;
-	uint g4 = m_macState.H[4] + b - (1 << 26);
-
-	b = (g4 >> 31) - 1;
-	uint nb = ~b;
-	m_macState.H[0] = (m_macState.H[0] & nb) | (g0 & b);
-	m_macState.H[1] = (m_macState.H[1] & nb) | (g1 & b);
-	m_macState.H[2] = (m_macState.H[2] & nb) | (g2 & b);
-	m_macState.H[3] = (m_macState.H[3] & nb) | (g3 & b);
-	m_macState.H[4] = (m_macState.H[4] & nb) | (g4 & b);
-
-	ulong f0 = (m_macState.H[0] | (m_macState.H[1] << 26)) + static_cast<ulong>(m_macState.K[0]);
-	ulong f1 = ((m_macState.H[1] >> 6) | (m_macState.H[2] << 20)) + static_cast<ulong>(m_macState.K[1]);
-	ulong f2 = ((m_macState.H[2] >> 12) | (m_macState.H[3] << 14)) + static_cast<ulong>(m_macState.K[2]);
-	ulong f3 = ((m_macState.H[3] >> 18) | (m_macState.H[4] << 8)) + static_cast<ulong>(m_macState.K[3]);
-
-	IntUtils::Le32ToBytes((uint)f0, Output, OutOffset);
-	f1 += (f0 >> 32);
-	IntUtils::Le32ToBytes((uint)f1, Output, OutOffset + 4);
-	f2 += (f1 >> 32);
-	IntUtils::Le32ToBytes((uint)f2, Output, OutOffset + 8);
-	f3 += (f2 >> 32);
-	IntUtils::Le32ToBytes((uint)f3, Output, OutOffset + 12);
+	if (m_hasMul128)
+	{
+		const ulong MASK42 = 0x3FFFFFFFFFFULL;
+		const ulong MASK44 = 0xFFFFFFFFFFFULL;
+		ulong h0 = m_macState.H44[0];
+		ulong h1 = m_macState.H44[1];
+		ulong h2 = m_macState.H44[2];
+		ulong c;
+
+		// fully carry h
+		c = (h1 >> 44);
+		h1 &= MASK44;
+		h2 += c;
+		c = (h2 >> 42);
+		h2 &= MASK42;
+		h0 += c * 5;
+		c = (h0 >> 44);
+		h0 &= MASK44;
+		h1 += c;
+		c = (h1 >> 44);
+		h1 &= MASK44;
+		h2 += c;
+		c = (h2 >> 42);
+		h2 &= MASK42;
+		h0 += c * 5;
+		c = (h0 >> 44);
+		h0 &= MASK44;
+		h1 += c;
+
+		// compute h + -p
+		ulong g0 = h0 + 5;
+		c = (g0 >> 44);
+		g0 &= MASK44;
+		ulong g1 = h1 + c;
+		c = (g1 >> 44);
+		g1 &= MASK44;
+		ulong g2 = h2 + c - (1ULL << 42);
+
+		// select h if h < p, or h + -p if h >= p
+		c = (g2 >> 63) - 1;
+		g0 &= c;
+		g1 &= c;
+		g2 &= c;
+		c = ~c;
+		h0 = (h0 & c) | g0;
+		h1 = (h1 & c) | g1;
+		h2 = (h2 & c) | g2;
+
+		// h = (h + pad)
+		const ulong T0 = static_cast<ulong>(m_macState.K[0]) | (static_cast<ulong>(m_macState.K[1]) << 32);
+		const ulong T1 = static_cast<ulong>(m_macState.K[2]) | (static_cast<ulong>(m_macState.K[3]) << 32);
+
+		h0 += (T0 & MASK44);
+		c = (h0 >> 44);
+		h0 &= MASK44;
+		h1 += (((T0 >> 44) | (T1 << 20)) & MASK44) + c;
+		c = (h1 >> 44);
+		h1 &= MASK44;
+		h2 += ((T1 >> 24) & MASK42) + c;
+		h2 &= MASK42;
+
+		IntUtils::Le64ToBytes(h0 | (h1 << 44), Output, OutOffset);
+		IntUtils::Le64ToBytes((h1 >> 20) | (h2 << 24), Output, OutOffset + 8);
+	}
+	else
+	{
+		uint b = m_macState.H[0] >> 26;
+		m_macState.H[0] = m_macState.H[0] & 0x3FFFFFFUL;
+		m_macState.H[1] += b;
+		b = m_macState.H[1] >> 26; 
+		m_macState.H[1] = m_macState.H[1] & 0x3FFFFFFUL;
+		m_macState.H[2] += b; 
+		b = m_macState.H[2] >> 26;
+		m_macState.H[2] = m_macState.H[2] & 0x3FFFFFFUL;
+		m_macState.H[3] += b;
+		b = m_macState.H[3] >> 26; 
+		m_macState.H[3] = m_macState.H[3] & 0x3FFFFFFUL;
+		m_macState.H[4] += b; 
+		b = m_macState.H[4] >> 26; 
+		m_macState.H[4] = m_macState.H[4] & 0x3FFFFFFUL;
+		m_macState.H[0] += b * 5;
+
+		uint g0 = m_macState.H[0] + 5;
+		b = g0 >> 26;
+		g0 &= 0x3FFFFFFUL;
+		uint g1 = m_macState.H[1] + b;
+		b = g1 >> 26; 
+		g1 &= 0x3FFFFFFUL;
+		uint g2 = m_macState.H[2] + b;
+		b = g2 >> 26;
+		g2 &= 0x3FFFFFFUL;
+		uint g3 = m_macState.H[3] + b;
+		b = g3 >> 26; 
+		g3 &= 0x3FFFFFFUL;
+		uint g4 = m_macState.H[4] + b - (1 << 26);
+
+		b = (g4 >> 31) - 1;
+		uint nb = ~b;
+		m_macState.H[0] = (m_macState.H[0] & nb) | (g0 & b);
+		m_macState.H[1] = (m_macState.H[1] & nb) | (g1 & b);
+		m_macState.H[2] = (m_macState.H[2] & nb) | (g2 & b);
+		m_macState.H[3] = (m_macState.H[3] & nb) | (g3 & b);
+		m_macState.H[4] = (m_macState.H[4] & nb) | (g4 & b);
+
+		ulong f0 = (m_macState.H[0] | (m_macState.H[1] << 26)) + static_cast<ulong>(m_macState.K[0]);
+		ulong f1 = ((m_macState.H[1] >> 6) | (m_macState.H[2] << 20)) + static_cast<ulong>(m_macState.K[1]);
+		ulong f2 = ((m_macState.H[2] >> 12) | (m_macState.H[3] << 14)) + static_cast<ulong>(m_macState.K[2]);
+		ulong f3 = ((m_macState.H[3] >> 18) | (m_macState.H[4] << 8)) + static_cast<ulong>(m_macState.K[3]);
+
+		IntUtils::Le32ToBytes((uint)f0, Output, OutOffset);
+		f1 += (f0 >> 32);
+		IntUtils::Le32ToBytes((uint)f1, Output, OutOffset + 4);
+		f2 += (f1 >> 32);
+		IntUtils::Le32ToBytes((uint)f2, Output, OutOffset + 8);
+		f3 += (f2 >> 32);
+		IntUtils::Le32ToBytes((uint)f3, Output, OutOffset + 12);
+	}
 	Reset();
 
 	return BLOCK_SIZE;
@@ -252,6 +354,28 @@ void Poly1305::Initialize(ISymmetricKey &KeyParams)
 	m_macState.S[2] = m_macState.R[3] * 5;
 	m_macState.S[3] = m_macState.R[4] * 5;
 
+	if (m_hasMul128)
+	{
+		const ulong R0 = static_cast<ulong>(t0) | (static_cast<ulong>(t1) << 32);
+		const ulong R1 = static_cast<ulong>(t2) | (static_cast<ulong>(t3) << 32);
+
+		// the clamped key in 44 bit limbs
+		m_macState.R44[0] = R0 & 0xFFC0FFFFFFFULL;
+		m_macState.R44[1] = ((R0 >> 44) | (R1 << 20)) & 0xFFFFFC0FFFFULL;
+		m_macState.R44[2] = (R1 >> 24) & 0x00FFFFFFC0FULL;
+		m_macState.S44[0] = m_macState.R44[1] * 20;
+		m_macState.S44[1] = m_macState.R44[2] * 20;
+	}
+
+	if (m_hasAVX2)
+	{
+		// precompute r^2, r^3 and r^4 for the 4-way multiply
+		std::array<uint, 5> tmpR1 = m_macState.R;
+		Multiply26(tmpR1, tmpR1, m_macState.R2);
+		Multiply26(m_macState.R2, tmpR1, m_macState.R3);
+		Multiply26(m_macState.R2, m_macState.R2, m_macState.R4);
+	}
+
 	std::vector<byte> tmpK(0);
 	size_t kOff;
 
@@ -306,8 +430,8 @@ void Poly1305::Update(byte Input)
 		m_msgLength = 0;
 	}
 
-	++m_msgLength;
 	m_msgBuffer[m_msgLength] = Input;
+	++m_msgLength;
 }
 
 void Poly1305::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
@@ -315,6 +439,92 @@ void Poly1305::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 	CexAssert(m_isInitialized, "The Mac is not initialized");
 	CexAssert((InOffset + Length) <= Input.size(), "The Mac is not initialized");
 
+	Process(Input, InOffset, Length);
+}
+
+void Poly1305::Update(const byte* Input, size_t Length)
+{
+	CexAssert(m_isInitialized, "The Mac is not initialized");
+
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+ulong Poly1305::CMul(uint A, uint B)
+{
+	return static_cast<ulong>(A) * B;
+}
+
+void Poly1305::Detect()
+{
+#if defined(CEX_HAS_MUL128)
+	m_hasMul128 = true;
+#endif
+#if defined(__AVX2__)
+	Common::CpuDetect detect;
+
+	m_hasAVX2 = detect.AVX2();
+#endif
+}
+
+void Poly1305::MulAdd128(ulong A, ulong B, ulong &Low, ulong &High)
+{
+#if defined(CEX_HAS_UINT128)
+	const unsigned __int128 P = static_cast<unsigned __int128>(A) * B;
+	const ulong PL = static_cast<ulong>(P);
+
+	Low += PL;
+	High += static_cast<ulong>(P >> 64) + (Low < PL);
+#elif defined(CEX_HAS_UMUL128)
+	ulong ph;
+	const ulong PL = _umul128(A, B, &ph);
+
+	Low += PL;
+	High += ph + (Low < PL);
+#else
+	CexAssert(false, "a 128 bit multiply is not available");
+#endif
+}
+
+void Poly1305::Multiply26(const std::array<uint, 5> &A, const std::array<uint, 5> &B, std::array<uint, 5> &Output)
+{
+	const uint S1 = B[1] * 5;
+	const uint S2 = B[2] * 5;
+	const uint S3 = B[3] * 5;
+	const uint S4 = B[4] * 5;
+
+	ulong t0 = CMul(A[0], B[0]) + CMul(A[1], S4) + CMul(A[2], S3) + CMul(A[3], S2) + CMul(A[4], S1);
+	ulong t1 = CMul(A[0], B[1]) + CMul(A[1], B[0]) + CMul(A[2], S4) + CMul(A[3], S3) + CMul(A[4], S2);
+	ulong t2 = CMul(A[0], B[2]) + CMul(A[1], B[1]) + CMul(A[2], B[0]) + CMul(A[3], S4) + CMul(A[4], S3);
+	ulong t3 = CMul(A[0], B[3]) + CMul(A[1], B[2]) + CMul(A[2], B[1]) + CMul(A[3], B[0]) + CMul(A[4], S4);
+	ulong t4 = CMul(A[0], B[4]) + CMul(A[1], B[3]) + CMul(A[2], B[2]) + CMul(A[3], B[1]) + CMul(A[4], B[0]);
+
+	t1 += (t0 >> 26);
+	t0 &= 0x3FFFFFFUL;
+	t2 += (t1 >> 26);
+	t1 &= 0x3FFFFFFUL;
+	t3 += (t2 >> 26);
+	t2 &= 0x3FFFFFFUL;
+	t4 += (t3 >> 26);
+	t3 &= 0x3FFFFFFUL;
+	t0 += (t4 >> 26) * 5;
+	t4 &= 0x3FFFFFFUL;
+	t1 += (t0 >> 26);
+	t0 &= 0x3FFFFFFUL;
+
+	Output[0] = static_cast<uint>(t0);
+	Output[1] = static_cast<uint>(t1);
+	Output[2] = static_cast<uint>(t2);
+	Output[3] = static_cast<uint>(t3);
+	Output[4] = static_cast<uint>(t4);
+}
+
+template <typename Array>
+void Poly1305::Process(const Array &Input, size_t InOffset, size_t Length)
+{
 	if (Length != 0)
 	{
 		if (m_msgLength != 0 && (m_msgLength + Length >= BLOCK_SIZE))
@@ -331,12 +541,13 @@ void Poly1305::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 			Length -= RMDLEN;
 		}
 
-		// loop through blocks
-		while (Length >= BLOCK_SIZE)
+		// process the whole blocks
+		if (Length >= BLOCK_SIZE)
 		{
-			ProcessBlock(Input, InOffset, BLOCK_SIZE);
-			Length -= BLOCK_SIZE;
-			InOffset += BLOCK_SIZE;
+			const size_t BLKLEN = Length - (Length % BLOCK_SIZE);
+			ProcessBlocks(Input, InOffset, BLKLEN);
+			Length -= BLKLEN;
+			InOffset += BLKLEN;
 		}
 
 		if (Length > 0)
@@ -347,73 +558,340 @@ void Poly1305::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 	}
 }
 
-//~~~Private Functions~~~//
+template <typename Array>
+void Poly1305::ProcessBlock(const Array &Input, size_t InOffset, size_t Length)
+{
+	std::array<byte, BLOCK_SIZE> buffer;
 
-ulong Poly1305::CMul(uint A, uint B)
+	if (Length < BLOCK_SIZE)
+	{
+		std::memset(&buffer[Length], 0, BLOCK_SIZE - Length);
+		std::memcpy(&buffer[0], &Input[InOffset], Length);
+		buffer[Length] = 1;
+	}
+
+	if (m_hasMul128)
+	{
+		const ulong MASK42 = 0x3FFFFFFFFFFULL;
+		const ulong MASK44 = 0xFFFFFFFFFFFULL;
+		const ulong HIBIT = (Length == BLOCK_SIZE) ? (1ULL << 40) : 0;
+		const ulong T0 = (Length >= BLOCK_SIZE) ? IntUtils::LeBytesTo64(Input, InOffset) : IntUtils::LeBytesTo64(buffer, 0);
+		const ulong T1 = (Length >= BLOCK_SIZE) ? IntUtils::LeBytesTo64(Input, InOffset + 8) : IntUtils::LeBytesTo64(buffer, 8);
+		const ulong R0 = m_macState.R44[0];
+		const ulong R1 = m_macState.R44[1];
+		const ulong R2 = m_macState.R44[2];
+		const ulong S1 = m_macState.S44[0];
+		const ulong S2 = m_macState.S44[1];
+		ulong h0 = m_macState.H44[0];
+		ulong h1 = m_macState.H44[1];
+		ulong h2 = m_macState.H44[2];
+		ulong c;
+
+		// h += m[i]
+		h0 += T0 & MASK44;
+		h1 += ((T0 >> 44) | (T1 << 20)) & MASK44;
+		h2 += (((T1 >> 24)) & MASK42) | HIBIT;
+
+		// h *= r
+		ulong d0l = 0;
+		ulong d0h = 0;
+		ulong d1l = 0;
+		ulong d1h = 0;
+		ulong d2l = 0;
+		ulong d2h = 0;
+
+		MulAdd128(h0, R0, d0l, d0h);
+		MulAdd128(h1, S2, d0l, d0h);
+		MulAdd128(h2, S1, d0l, d0h);
+		MulAdd128(h0, R1, d1l, d1h);
+		MulAdd128(h1, R0, d1l, d1h);
+		MulAdd128(h2, S2, d1l, d1h);
+		MulAdd128(h0, R2, d2l, d2h);
+		MulAdd128(h1, R1, d2l, d2h);
+		MulAdd128(h2, R0, d2l, d2h);
+
+		// partial h %= p
+		c = (d0l >> 44) | (d0h << 20);
+		h0 = d0l & MASK44;
+		d1l += c;
+		d1h += (d1l < c);
+		c = (d1l >> 44) | (d1h << 20);
+		h1 = d1l & MASK44;
+		d2l += c;
+		d2h += (d2l < c);
+		c = (d2l >> 42) | (d2h << 22);
+		h2 = d2l & MASK42;
+		h0 += c * 5;
+		c = (h0 >> 44);
+		h0 &= MASK44;
+		h1 += c;
+
+		m_macState.H44[0] = h0;
+		m_macState.H44[1] = h1;
+		m_macState.H44[2] = h2;
+	}
+	else
+	{
+		ulong t0;
+		ulong t1;
+		ulong t2;
+		ulong t3;
+
+		if (Length >= BLOCK_SIZE)
+		{
+			t0 = IntUtils::LeBytesTo32(Input, InOffset);
+			t1 = IntUtils::LeBytesTo32(Input, InOffset + 4);
+			t2 = IntUtils::LeBytesTo32(Input, InOffset + 8);
+			t3 = IntUtils::LeBytesTo32(Input, InOffset + 12);
+		}
+		else
+		{
+			t0 = IntUtils::LeBytesTo32(buffer, 0);
+			t1 = IntUtils::LeBytesTo32(buffer, 4);
+			t2 = IntUtils::LeBytesTo32(buffer, 8);
+			t3 = IntUtils::LeBytesTo32(buffer, 12);
+		}
+
+		m_macState.H[0] += static_cast<uint>(t0 & 0x3FFFFFFUL);
+		m_macState.H[1] += static_cast<uint>((((t1 << 32) | t0) >> 26) & 0x3FFFFFFUL);
+		m_macState.H[2] += static_cast<uint>((((t2 << 32) | t1) >> 20) & 0x3FFFFFFUL);
+		m_macState.H[3] += static_cast<uint>((((t3 << 32) | t2) >> 14) & 0x3FFFFFFUL);
+		m_macState.H[4] += static_cast<uint>(t3 >> 8);
+
+		if (Length == BLOCK_SIZE)
+		{
+			m_macState.H[4] += (1 << 24);
+		}
+
+		ulong tp0 = CMul(m_macState.H[0], m_macState.R[0]) + CMul(m_macState.H[1], m_macState.S[3]) + CMul(m_macState.H[2], m_macState.S[2]) + CMul(m_macState.H[3], m_macState.S[1]) + CMul(m_macState.H[4], m_macState.S[0]);
+		ulong tp1 = CMul(m_macState.H[0], m_macState.R[1]) + CMul(m_macState.H[1], m_macState.R[0]) + CMul(m_macState.H[2], m_macState.S[3]) + CMul(m_macState.H[3], m_macState.S[2]) + CMul(m_macState.H[4], m_macState.S[1]);
+		ulong tp2 = CMul(m_macState.H[0], m_macState.R[2]) + CMul(m_macState.H[1], m_macState.R[1]) + CMul(m_macState.H[2], m_macState.R[0]) + CMul(m_macState.H[3], m_macState.S[3]) + CMul(m_macState.H[4], m_macState.S[2]);
+		ulong tp3 = CMul(m_macState.H[0], m_macState.R[3]) + CMul(m_macState.H[1], m_macState.R[2]) + CMul(m_macState.H[2], m_macState.R[1]) + CMul(m_macState.H[3], m_macState.R[0]) + CMul(m_macState.H[4], m_macState.S[3]);
+		ulong tp4 = CMul(m_macState.H[0], m_macState.R[4]) + CMul(m_macState.H[1], m_macState.R[3]) + CMul(m_macState.H[2], m_macState.R[2]) + CMul(m_macState.H[3], m_macState.R[1]) + CMul(m_macState.H[4], m_macState.R[0]);
+
+		ulong b;
+		m_macState.H[0] = static_cast<uint>(tp0 & 0x3FFFFFFUL);
+		b = (tp0 >> 26);
+		tp1 += b; 
+		m_macState.H[1] = static_cast<uint>(tp1 & 0x3FFFFFFUL);
+		b = (tp1 >> 26);
+		tp2 += b;
+		m_macState.H[2] = static_cast<uint>(tp2 & 0x3FFFFFFUL);
+		b = (tp2 >> 26);
+		tp3 += b;
+		m_macState.H[3] = static_cast<uint>(tp3 & 0x3FFFFFFUL);
+		b = (tp3 >> 26);
+		tp4 += b;
+		m_macState.H[4] = static_cast<uint>(tp4 & 0x3FFFFFFUL);
+		b = (tp4 >> 26);
+		m_macState.H[0] += static_cast<uint>(b * 5);
+	}
+}
+
+template <typename Array>
+void Poly1305::ProcessBlocks(const Array &Input, size_t InOffset, size_t Length)
 {
-	return static_cast<ulong>(A) * B;
+	CexAssert(Length % BLOCK_SIZE == 0, "the length must be a multiple of the block size");
+
+#if defined(__AVX2__)
+	// the vector path is worth the limb conversions from 16 blocks
+	if (m_hasAVX2 && Length >= 16 * BLOCK_SIZE)
+	{
+		const size_t VECLEN = Length - (Length % (4 * BLOCK_SIZE));
+		ProcessW(&Input[InOffset], VECLEN);
+		InOffset += VECLEN;
+		Length -= VECLEN;
+	}
+#endif
+
+	while (Length != 0)
+	{
+		ProcessBlock(Input, InOffset, BLOCK_SIZE);
+		InOffset += BLOCK_SIZE;
+		Length -= BLOCK_SIZE;
+	}
 }
 
-void Poly1305::ProcessBlock(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+void Poly1305::ProcessW(const byte* Input, size_t Length)
 {
-	ulong t0;
-	ulong t1;
-	ulong t2;
-	ulong t3;
+#if defined(__AVX2__)
+	const uint MASK26 = 0x3FFFFFFUL;
+	std::array<uint, 5> h;
 
-	if (Length >= BLOCK_SIZE)
+	if (m_hasMul128)
 	{
-		t0 = IntUtils::LeBytesTo32(Input, InOffset);
-		t1 = IntUtils::LeBytesTo32(Input, InOffset + 4);
-		t2 = IntUtils::LeBytesTo32(Input, InOffset + 8);
-		t3 = IntUtils::LeBytesTo32(Input, InOffset + 12);
+		// convert the 44 bit accumulator to 26 bit limbs
+		ulong c = (m_macState.H44[1] >> 44);
+		const ulong H0 = m_macState.H44[0];
+		const ulong H1 = m_macState.H44[1] & 0xFFFFFFFFFFFULL;
+		const ulong H2 = m_macState.H44[2] + c;
+		h[0] = static_cast<uint>(H0 & MASK26);
+		h[1] = static_cast<uint>(((H0 >> 26) | (H1 << 18)) & MASK26);
+		h[2] = static_cast<uint>((H1 >> 8) & MASK26);
+		h[3] = static_cast<uint>(((H1 >> 34) | (H2 << 10)) & MASK26);
+		h[4] = static_cast<uint>(H2 >> 16);
 	}
 	else
 	{
-		std::array<byte, BLOCK_SIZE> buffer;
-		std::memset(&buffer[Length], 0, BLOCK_SIZE - Length);
-		std::memcpy(&buffer[0], &Input[InOffset], Length);
-		buffer[Length] = 1;
-
-		t0 = IntUtils::LeBytesTo32(buffer, 0);
-		t1 = IntUtils::LeBytesTo32(buffer, 4);
-		t2 = IntUtils::LeBytesTo32(buffer, 8);
-		t3 = IntUtils::LeBytesTo32(buffer, 12);
+		h = m_macState.H;
 	}
 
-	m_macState.H[0] += static_cast<uint>(t0 & 0x3FFFFFFUL);
-	m_macState.H[1] += static_cast<uint>((((t1 << 32) | t0) >> 26) & 0x3FFFFFFUL);
-	m_macState.H[2] += static_cast<uint>((((t2 << 32) | t1) >> 20) & 0x3FFFFFFUL);
-	m_macState.H[3] += static_cast<uint>((((t3 << 32) | t2) >> 14) & 0x3FFFFFFUL);
-	m_macState.H[4] += static_cast<uint>(t3 >> 8);
-
-	if (Length == BLOCK_SIZE)
+	const __m256i M26 = _mm256_set1_epi64x(MASK26);
+	const __m256i HIBIT = _mm256_set1_epi64x(1ULL << 24);
+	const __m256i FIVE = _mm256_set1_epi64x(5);
+	// r^4 broadcast to every lane, multiplied through the loop
+	const __m256i RV0 = _mm256_set1_epi64x(m_macState.R4[0]);
+	const __m256i RV1 = _mm256_set1_epi64x(m_macState.R4[1]);
+	const __m256i RV2 = _mm256_set1_epi64x(m_macState.R4[2]);
+	const __m256i RV3 = _mm256_set1_epi64x(m_macState.R4[3]);
+	const __m256i RV4 = _mm256_set1_epi64x(m_macState.R4[4]);
+	const __m256i SV1 = _mm256_set1_epi64x(m_macState.R4[1] * 5);
+	const __m256i SV2 = _mm256_set1_epi64x(m_macState.R4[2] * 5);
+	const __m256i SV3 = _mm256_set1_epi64x(m_macState.R4[3] * 5);
+	const __m256i SV4 = _mm256_set1_epi64x(m_macState.R4[4] * 5);
+	__m256i a0 = _mm256_set_epi64x(0, 0, 0, h[0]);
+	__m256i a1 = _mm256_set_epi64x(0, 0, 0, h[1]);
+	__m256i a2 = _mm256_set_epi64x(0, 0, 0, h[2]);
+	__m256i a3 = _mm256_set_epi64x(0, 0, 0, h[3]);
+	__m256i a4 = _mm256_set_epi64x(0, 0, 0, h[4]);
+	__m256i t0;
+	__m256i t1;
+	__m256i t2;
+	__m256i t3;
+	__m256i t4;
+	__m256i c0;
+	size_t inOff = 0;
+
+	// lane i holds the accumulator for blocks 4n + i
+	while (true)
 	{
-		m_macState.H[4] += (1 << 24);
+		// load four blocks and split them into 26 bit limbs, one block per lane
+		const __m256i V0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input + inOff));
+		const __m256i V1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input + inOff + 32));
+		const __m256i LO = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(V0, V1), _MM_SHUFFLE(3, 1, 2, 0));
+		const __m256i HI = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(V0, V1), _MM_SHUFFLE(3, 1, 2, 0));
+
+		a0 = _mm256_add_epi64(a0, _mm256_and_si256(LO, M26));
+		a1 = _mm256_add_epi64(a1, _mm256_and_si256(_mm256_srli_epi64(LO, 26), M26));
+		a2 = _mm256_add_epi64(a2, _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(LO, 52), _mm256_slli_epi64(HI, 12)), M26));
+		a3 = _mm256_add_epi64(a3, _mm256_and_si256(_mm256_srli_epi64(HI, 14), M26));
+		a4 = _mm256_add_epi64(a4, _mm256_or_si256(_mm256_srli_epi64(HI, 40), HIBIT));
+		inOff += 4 * BLOCK_SIZE;
+
+		if (inOff == Length)
+		{
+			break;
+		}
+
+		// a *= r^4
+		t0 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RV0), _mm256_mul_epu32(a1, SV4)), _mm256_add_epi64(_mm256_mul_epu32(a2, SV3), _mm256_mul_epu32(a3, SV2))), _mm256_mul_epu32(a4, SV1));
+		t1 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RV1), _mm256_mul_epu32(a1, RV0)), _mm256_add_epi64(_mm256_mul_epu32(a2, SV4), _mm256_mul_epu32(a3, SV3))), _mm256_mul_epu32(a4, SV2));
+		t2 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RV2), _mm256_mul_epu32(a1, RV1)), _mm256_add_epi64(_mm256_mul_epu32(a2, RV0), _mm256_mul_epu32(a3, SV4))), _mm256_mul_epu32(a4, SV3));
+		t3 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RV3), _mm256_mul_epu32(a1, RV2)), _mm256_add_epi64(_mm256_mul_epu32(a2, RV1), _mm256_mul_epu32(a3, RV0))), _mm256_mul_epu32(a4, SV4));
+		t4 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RV4), _mm256_mul_epu32(a1, RV3)), _mm256_add_epi64(_mm256_mul_epu32(a2, RV2), _mm256_mul_epu32(a3, RV1))), _mm256_mul_epu32(a4, RV0));
+
+		// partial carry
+		c0 = _mm256_srli_epi64(t0, 26);
+		a0 = _mm256_and_si256(t0, M26);
+		t1 = _mm256_add_epi64(t1, c0);
+		c0 = _mm256_srli_epi64(t1, 26);
+		a1 = _mm256_and_si256(t1, M26);
+		t2 = _mm256_add_epi64(t2, c0);
+		c0 = _mm256_srli_epi64(t2, 26);
+		a2 = _mm256_and_si256(t2, M26);
+		t3 = _mm256_add_epi64(t3, c0);
+		c0 = _mm256_srli_epi64(t3, 26);
+		a3 = _mm256_and_si256(t3, M26);
+		t4 = _mm256_add_epi64(t4, c0);
+		c0 = _mm256_srli_epi64(t4, 26);
+		a4 = _mm256_and_si256(t4, M26);
+		a0 = _mm256_add_epi64(a0, _mm256_mul_epu32(c0, FIVE));
+		c0 = _mm256_srli_epi64(a0, 26);
+		a0 = _mm256_and_si256(a0, M26);
+		a1 = _mm256_add_epi64(a1, c0);
 	}
 
-	ulong tp0 = CMul(m_macState.H[0], m_macState.R[0]) + CMul(m_macState.H[1], m_macState.S[3]) + CMul(m_macState.H[2], m_macState.S[2]) + CMul(m_macState.H[3], m_macState.S[1]) + CMul(m_macState.H[4], m_macState.S[0]);
-	ulong tp1 = CMul(m_macState.H[0], m_macState.R[1]) + CMul(m_macState.H[1], m_macState.R[0]) + CMul(m_macState.H[2], m_macState.S[3]) + CMul(m_macState.H[3], m_macState.S[2]) + CMul(m_macState.H[4], m_macState.S[1]);
-	ulong tp2 = CMul(m_macState.H[0], m_macState.R[2]) + CMul(m_macState.H[1], m_macState.R[1]) + CMul(m_macState.H[2], m_macState.R[0]) + CMul(m_macState.H[3], m_macState.S[3]) + CMul(m_macState.H[4], m_macState.S[2]);
-	ulong tp3 = CMul(m_macState.H[0], m_macState.R[3]) + CMul(m_macState.H[1], m_macState.R[2]) + CMul(m_macState.H[2], m_macState.R[1]) + CMul(m_macState.H[3], m_macState.R[0]) + CMul(m_macState.H[4], m_macState.S[3]);
-	ulong tp4 = CMul(m_macState.H[0], m_macState.R[4]) + CMul(m_macState.H[1], m_macState.R[3]) + CMul(m_macState.H[2], m_macState.R[2]) + CMul(m_macState.H[3], m_macState.R[1]) + CMul(m_macState.H[4], m_macState.R[0]);
-
-	ulong b;
-	m_macState.H[0] = static_cast<uint>(tp0 & 0x3FFFFFFUL);
-	b = (tp0 >> 26);
-	tp1 += b; 
-	m_macState.H[1] = static_cast<uint>(tp1 & 0x3FFFFFFUL);
-	b = (tp1 >> 26);
-	tp2 += b;
-	m_macState.H[2] = static_cast<uint>(tp2 & 0x3FFFFFFUL);
-	b = (tp2 >> 26);
-	tp3 += b;
-	m_macState.H[3] = static_cast<uint>(tp3 & 0x3FFFFFFUL);
-	b = (tp3 >> 26);
-	tp4 += b;
-	m_macState.H[4] = static_cast<uint>(tp4 & 0x3FFFFFFUL);
-	b = (tp4 >> 26);
-	m_macState.H[0] += static_cast<uint>(b * 5);
+	// multiply the lanes by r^4, r^3, r^2 and r
+	const __m256i RP0 = _mm256_set_epi64x(m_macState.R[0], m_macState.R2[0], m_macState.R3[0], m_macState.R4[0]);
+	const __m256i RP1 = _mm256_set_epi64x(m_macState.R[1], m_macState.R2[1], m_macState.R3[1], m_macState.R4[1]);
+	const __m256i RP2 = _mm256_set_epi64x(m_macState.R[2], m_macState.R2[2], m_macState.R3[2], m_macState.R4[2]);
+	const __m256i RP3 = _mm256_set_epi64x(m_macState.R[3], m_macState.R2[3], m_macState.R3[3], m_macState.R4[3]);
+	const __m256i RP4 = _mm256_set_epi64x(m_macState.R[4], m_macState.R2[4], m_macState.R3[4], m_macState.R4[4]);
+	const __m256i SP1 = _mm256_mul_epu32(RP1, FIVE);
+	const __m256i SP2 = _mm256_mul_epu32(RP2, FIVE);
+	const __m256i SP3 = _mm256_mul_epu32(RP3, FIVE);
+	const __m256i SP4 = _mm256_mul_epu32(RP4, FIVE);
+
+	t0 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RP0), _mm256_mul_epu32(a1, SP4)), _mm256_add_epi64(_mm256_mul_epu32(a2, SP3), _mm256_mul_epu32(a3, SP2))), _mm256_mul_epu32(a4, SP1));
+	t1 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RP1), _mm256_mul_epu32(a1, RP0)), _mm256_add_epi64(_mm256_mul_epu32(a2, SP4), _mm256_mul_epu32(a3, SP3))), _mm256_mul_epu32(a4, SP2));
+	t2 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RP2), _mm256_mul_epu32(a1, RP1)), _mm256_add_epi64(_mm256_mul_epu32(a2, RP0), _mm256_mul_epu32(a3, SP4))), _mm256_mul_epu32(a4, SP3));
+	t3 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RP3), _mm256_mul_epu32(a1, RP2)), _mm256_add_epi64(_mm256_mul_epu32(a2, RP1), _mm256_mul_epu32(a3, RP0))), _mm256_mul_epu32(a4, SP4));
+	t4 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a0, RP4), _mm256_mul_epu32(a1, RP3)), _mm256_add_epi64(_mm256_mul_epu32(a2, RP2), _mm256_mul_epu32(a3, RP1))), _mm256_mul_epu32(a4, RP0));
+
+	// sum the lanes and carry into the scalar accumulator
+	std::array<ulong, 4> l0;
+	std::array<ulong, 4> l1;
+	std::array<ulong, 4> l2;
+	std::array<ulong, 4> l3;
+	std::array<ulong, 4> l4;
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&l0[0]), t0);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&l1[0]), t1);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&l2[0]), t2);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&l3[0]), t3);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&l4[0]), t4);
+
+	// each lane is below 2^58, the sum of the four lanes can not overflow
+	ulong d0 = l0[0] + l0[1] + l0[2] + l0[3];
+	ulong d1 = l1[0] + l1[1] + l1[2] + l1[3];
+	ulong d2 = l2[0] + l2[1] + l2[2] + l2[3];
+	ulong d3 = l3[0] + l3[1] + l3[2] + l3[3];
+	ulong d4 = l4[0] + l4[1] + l4[2] + l4[3];
+
+	d1 += (d0 >> 26);
+	d0 &= MASK26;
+	d2 += (d1 >> 26);
+	d1 &= MASK26;
+	d3 += (d2 >> 26);
+	d2 &= MASK26;
+	d4 += (d3 >> 26);
+	d3 &= MASK26;
+	d0 += (d4 >> 26) * 5;
+	d4 &= MASK26;
+	d1 += (d0 >> 26);
+	d0 &= MASK26;
+
+	if (m_hasMul128)
+	{
+		// convert back to 44 bit limbs, the limbs are below 2^27 so the top limb is reduced once
+		ulong x0 = d0 + (d1 << 26);
+		ulong c = (x0 >> 44);
+		x0 &= 0xFFFFFFFFFFFULL;
+		ulong x1 = c + (d2 << 8) + (d3 << 34);
+		c = (x1 >> 44);
+		x1 &= 0xFFFFFFFFFFFULL;
+		ulong x2 = c + (d4 << 16);
+		c = (x2 >> 42);
+		x2 &= 0x3FFFFFFFFFFULL;
+		x0 += c * 5;
+		c = (x0 >> 44);
+		x0 &= 0xFFFFFFFFFFFULL;
+		x1 += c;
+
+		m_macState.H44[0] = x0;
+		m_macState.H44[1] = x1;
+		m_macState.H44[2] = x2;
+	}
+	else
+	{
+		m_macState.H[0] = static_cast<uint>(d0);
+		m_macState.H[1] = static_cast<uint>(d1);
+		m_macState.H[2] = static_cast<uint>(d2);
+		m_macState.H[3] = static_cast<uint>(d3);
+		m_macState.H[4] = static_cast<uint>(d4);
+	}
+#else
+	CexAssert(false, "the vectorized path requires AVX2");
+#endif
 }
 
 NAMESPACE_MACEND
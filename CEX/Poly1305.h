@@ -68,6 +68,8 @@ using Cipher::Symmetric::Block::IBlockCipher;
 /// <item><description>MAC return size is 16 bytes, the array can be can be truncated by the caller.</description></item>
 /// <item><description>The Initialize() function requires a key of 32 bytes (256 bits) in length.</description></item>
 /// <item><description>After a finalizer call (Finalize or Compute), the Mac functions state is reset and must be re-initialized with a new key.</description></item>
+/// <item><description>When the compiler provides a 64x64 bit multiply with a 128 bit product (__int128 or _umul128), the accumulator uses three 44 bit limbs, otherwise five 26 bit limbs; the LimbWidth(size_t) function can select the 26 bit back end.</description></item>
+/// <item><description>On AVX2 capable processors, bulk input of 256 bytes or more is processed four blocks at a time with precomputed powers of r (r^2 through r^4); the AVX2 path is selected at runtime.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -95,6 +97,14 @@ private:
 		std::array<uint, 4> K;
 		std::array<uint, 5> R;
 		std::array<uint, 4> S;
+		// the 44 bit limb accumulator and key, used when a 64x64 bit multiply is available
+		std::array<ulong, 3> H44;
+		std::array<ulong, 3> R44;
+		std::array<ulong, 2> S44;
+		// powers of r used by the 4-way vectorized path
+		std::array<uint, 5> R2;
+		std::array<uint, 5> R3;
+		std::array<uint, 5> R4;
 
 		Poly1305State()
 		{
@@ -107,12 +117,20 @@ private:
 			std::memset(&K[0], 0, K.size() * sizeof(uint));
 			std::memset(&R[0], 0, R.size() * sizeof(uint));
 			std::memset(&S[0], 0, S.size() * sizeof(uint));
+			std::memset(&H44[0], 0, H44.size() * sizeof(ulong));
+			std::memset(&R44[0], 0, R44.size() * sizeof(ulong));
+			std::memset(&S44[0], 0, S44.size() * sizeof(ulong));
+			std::memset(&R2[0], 0, R2.size() * sizeof(uint));
+			std::memset(&R3[0], 0, R3.size() * sizeof(uint));
+			std::memset(&R4[0], 0, R4.size() * sizeof(uint));
 		}
 	};
 
 	bool m_autoClamp;
 	std::unique_ptr<IBlockCipher> m_blockCipher;
 	bool m_destroyEngine;
+	bool m_hasAVX2;
+	bool m_hasMul128;
 	bool m_isDestroyed;
 	bool m_isInitialized;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
@@ -182,6 +200,22 @@ public:
 	/// </summary>
 	const bool IsInitialized() override;
 
+	/// <summary>
+	/// Read/Write: The width in bits of the accumulator limbs; 44 when the compiler provides a 128 bit product, otherwise 26.
+	/// <para>Set to 26 to select the 26 bit limb back end, the width is limited to what the compiler supports.
+	/// Used to test each back end against the reference vectors.</para>
+	/// </summary>
+	const size_t LimbWidth();
+
+	/// <summary>
+	/// Read/Write: Set the maximum width in bits of the accumulator limbs, must be called before the Mac is initialized
+	/// </summary>
+	///
+	/// <param name="Width">The maximum limb width in bits; 26 or 44</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac has already been initialized</exception>
+	void LimbWidth(size_t Width);
+
 	/// <summary>
 	/// Read Only: Recommended Mac key sizes in a SymmetricKeySize array
 	/// </summary>
@@ -268,10 +302,27 @@ public:
 	/// <param name="Length">The length of data to process in bytes</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the Mac with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
 	static ulong CMul(uint A, uint B);
-	void ProcessBlock(const std::vector<byte> &Output, size_t OutOffset, size_t Length);
+	void Detect();
+	static void MulAdd128(ulong A, ulong B, ulong &Low, ulong &High);
+	static void Multiply26(const std::array<uint, 5> &A, const std::array<uint, 5> &B, std::array<uint, 5> &Output);
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
+	template <typename Array>
+	void ProcessBlock(const Array &Input, size_t InOffset, size_t Length);
+	template <typename Array>
+	void ProcessBlocks(const Array &Input, size_t InOffset, size_t Length);
+	void ProcessW(const byte* Input, size_t Length);
 };
 
 NAMESPACE_MACEND
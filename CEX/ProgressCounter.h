@@ -0,0 +1,129 @@
+#ifndef CEX_PROGRESSCOUNTER_H
+#define CEX_PROGRESSCOUNTER_H
+
+#include "CexDomain.h"
+#include <atomic>
+
+NAMESPACE_ROUTING
+
+/// <summary>
+/// A lock-free count of the bytes processed by a stream operation.
+/// <para>The processing loop adds each block to the counter with a single relaxed atomic add; any thread can poll the counter while the operation runs.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Polling the progress of a cipher stream from another thread:</description>
+/// <code>
+/// CipherStream cs(Enumeration::BlockCiphers::RHX);
+/// cs.Initialize(true, kp);
+/// std::thread worker([&amp;cs, fIn, fOut]() { cs.Write(fIn, fOut); });
+///
+/// while (cs.Progress().Percent() != 100)
+/// {
+///     std::cout &lt;&lt; cs.Progress().Processed() &lt;&lt; " of " &lt;&lt; cs.Progress().Total() &lt;&lt; std::endl;
+///     std::this_thread::sleep_for(std::chrono::milliseconds(250));
+/// }
+///
+/// worker.join();
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The stream processors reset the counter with the input length when an operation starts, and add the input bytes as each block is processed.</description></item>
+/// <item><description>The counter is never read by the processing loop; time-based callbacks are raised by a ProgressNotifier attached to the counter.</description></item>
+/// <item><description>The values are read with relaxed ordering, so a poll may briefly lag the processing loop; Percent() is bounded to 100.</description></item>
+/// </list>
+/// </remarks>
+class ProgressCounter
+{
+private:
+
+	std::atomic<ulong> m_processedBytes;
+	std::atomic<ulong> m_totalBytes;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	ProgressCounter(const ProgressCounter&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	ProgressCounter& operator=(const ProgressCounter&) = delete;
+
+	/// <summary>
+	/// Initialize this class
+	/// </summary>
+	ProgressCounter()
+		:
+		m_processedBytes(0),
+		m_totalBytes(0)
+	{
+	}
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The percentage of the total processed, between 0 and 100
+	/// </summary>
+	inline int Percent() const
+	{
+		const ulong TTLLEN = m_totalBytes.load(std::memory_order_relaxed);
+		const ulong PRCLEN = m_processedBytes.load(std::memory_order_relaxed);
+
+		if (TTLLEN == 0)
+		{
+			return 0;
+		}
+
+		return (PRCLEN >= TTLLEN) ? 100 : static_cast<int>((100.0 * static_cast<double>(PRCLEN)) / static_cast<double>(TTLLEN));
+	}
+
+	/// <summary>
+	/// Read Only: The number of bytes processed by the current operation
+	/// </summary>
+	inline ulong Processed() const
+	{
+		return m_processedBytes.load(std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Read Only: The number of bytes the current operation will process
+	/// </summary>
+	inline ulong Total() const
+	{
+		return m_totalBytes.load(std::memory_order_relaxed);
+	}
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Add processed bytes to the counter; safe to call from several threads
+	/// </summary>
+	///
+	/// <param name="Length">The number of bytes processed</param>
+	inline void Add(ulong Length)
+	{
+		m_processedBytes.fetch_add(Length, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Start a new operation; sets the processed count to zero
+	/// </summary>
+	///
+	/// <param name="Total">The number of bytes the operation will process</param>
+	inline void Reset(ulong Total)
+	{
+		m_processedBytes.store(0, std::memory_order_relaxed);
+		m_totalBytes.store(Total, std::memory_order_relaxed);
+	}
+};
+
+NAMESPACE_ROUTINGEND
+#endif
@@ -0,0 +1,99 @@
+#include "ProgressNotifier.h"
+#include "CryptoProcessingException.h"
+#include <chrono>
+
+NAMESPACE_ROUTING
+
+using Exception::CryptoProcessingException;
+
+//~~~Constructor~~~//
+
+ProgressNotifier::ProgressNotifier(ProgressCounter &Counter, size_t Interval)
+	:
+	m_progressCounter(Counter),
+	m_notifyInterval(Interval != 0 ? Interval :
+		throw CryptoProcessingException("ProgressNotifier:CTor", "The interval can not be zero!")),
+	m_notifyThread(),
+	m_isRunning(false),
+	m_lastPercent(-1),
+	m_stateLock(),
+	m_stateSignal()
+{
+}
+
+ProgressNotifier::~ProgressNotifier()
+{
+	Stop();
+}
+
+//~~~Accessors~~~//
+
+const size_t ProgressNotifier::Interval()
+{
+	return m_notifyInterval;
+}
+
+const bool ProgressNotifier::IsRunning()
+{
+	std::lock_guard<std::mutex> lock(m_stateLock);
+
+	return m_isRunning;
+}
+
+//~~~Public Functions~~~//
+
+void ProgressNotifier::Start()
+{
+	std::lock_guard<std::mutex> lock(m_stateLock);
+
+	if (!m_isRunning)
+	{
+		m_isRunning = true;
+		m_lastPercent = -1;
+		m_notifyThread = std::thread(&ProgressNotifier::Notify, this);
+	}
+}
+
+void ProgressNotifier::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_stateLock);
+
+		if (!m_isRunning)
+		{
+			return;
+		}
+
+		m_isRunning = false;
+	}
+
+	m_stateSignal.notify_all();
+	m_notifyThread.join();
+}
+
+//~~~Private Functions~~~//
+
+void ProgressNotifier::Notify()
+{
+	bool isRunning = true;
+
+	// the last pass runs after Stop, so the final percentage is always raised
+	while (isRunning)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_stateLock);
+			m_stateSignal.wait_for(lock, std::chrono::milliseconds(m_notifyInterval), [this]() { return !m_isRunning; });
+			isRunning = m_isRunning;
+		}
+
+		const int PRCPCT = m_progressCounter.Percent();
+
+		if (PRCPCT != m_lastPercent)
+		{
+			m_lastPercent = PRCPCT;
+			ProgressPercent(PRCPCT);
+		}
+	}
+}
+
+NAMESPACE_ROUTINGEND
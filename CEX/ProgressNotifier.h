@@ -0,0 +1,133 @@
+#ifndef CEX_PROGRESSNOTIFIER_H
+#define CEX_PROGRESSNOTIFIER_H
+
+#include "CexDomain.h"
+#include "Event.h"
+#include "ProgressCounter.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+NAMESPACE_ROUTING
+
+/// <summary>
+/// Raises time-based progress events for a ProgressCounter.
+/// <para>A notifier thread polls the counter at a fixed interval and raises the ProgressPercent event when the percentage changes, so the subscribers never run inside the processing loop.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Receiving progress events from a cipher stream:</description>
+/// <code>
+/// class SampleEvent
+/// {
+/// public:
+/// 	SampleEvent() : LCompleted(this) { }
+/// 	void Completed(int Percent) { std::cout &lt;&lt; Percent &lt;&lt; std::endl; }
+/// 	LISTENER(SampleEvent, Completed, int);
+/// };
+///
+/// CipherStream cs(Enumeration::BlockCiphers::RHX);
+/// SampleEvent evt;
+/// ProgressNotifier ntf(cs.Progress(), 100);
+/// ntf.ProgressPercent += &amp;evt.LCompleted;
+///
+/// cs.Initialize(true, kp);
+/// ntf.Start();
+/// cs.Write(fIn, fOut);
+/// // raises the final percentage
+/// ntf.Stop();
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>Subscribers are added before Start() is called, and are invoked on the notifier thread.</description></item>
+/// <item><description>The event is raised at most once per interval, and only when the percentage has changed; Stop() raises the final value before returning.</description></item>
+/// <item><description>A counter can be watched by several notifiers, and the notifier must be stopped or destroyed before the counter.</description></item>
+/// </list>
+/// </remarks>
+class ProgressNotifier
+{
+private:
+
+	static const size_t DEF_INTERVAL = 100;
+
+	ProgressCounter &m_progressCounter;
+	size_t m_notifyInterval;
+	std::thread m_notifyThread;
+	bool m_isRunning;
+	int m_lastPercent;
+	std::mutex m_stateLock;
+	std::condition_variable m_stateSignal;
+
+public:
+
+	/// <summary>
+	/// The Progress Percent event; raised from the notifier thread
+	/// </summary>
+	Event<int> ProgressPercent;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	ProgressNotifier(const ProgressNotifier&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	ProgressNotifier& operator=(const ProgressNotifier&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	ProgressNotifier() = delete;
+
+	/// <summary>
+	/// Initialize this class with the counter to watch
+	/// </summary>
+	///
+	/// <param name="Counter">The progress counter of a stream processor</param>
+	/// <param name="Interval">The polling interval in milliseconds; the default is 100</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the interval is zero</exception>
+	explicit ProgressNotifier(ProgressCounter &Counter, size_t Interval = DEF_INTERVAL);
+
+	/// <summary>
+	/// Destructor: stops the notifier thread
+	/// </summary>
+	~ProgressNotifier();
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The polling interval in milliseconds
+	/// </summary>
+	const size_t Interval();
+
+	/// <summary>
+	/// Read Only: The notifier thread is running
+	/// </summary>
+	const bool IsRunning();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Start the notifier thread
+	/// </summary>
+	void Start();
+
+	/// <summary>
+	/// Stop the notifier thread, and raise the final percentage if it has changed
+	/// </summary>
+	void Stop();
+
+private:
+
+	void Notify();
+};
+
+NAMESPACE_ROUTINGEND
+#endif
@@ -1,4 +1,5 @@
 #include "RHX.h"
+#include "ArraySpan.h"
 #include "Rijndael.h"
 #include "DigestFromName.h"
 #include "HKDF.h"
@@ -275,6 +276,66 @@ void RHX::Transform2048(const std::vector<byte> &Input, const size_t InOffset, s
 	}
 }
 
+void RHX::Transform(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt128(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt128(inp, 0, otp, 0);
+	}
+}
+
+void RHX::Transform512(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 4 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 4 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt512(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt512(inp, 0, otp, 0);
+	}
+}
+
+void RHX::Transform1024(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 8 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 8 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt1024(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt1024(inp, 0, otp, 0);
+	}
+}
+
+void RHX::Transform2048(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 16 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 16 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt2048(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt2048(inp, 0, otp, 0);
+	}
+}
+
 //~~~Key Schedule~~~//
 
 void RHX::ExpandKey(bool Encryption, const std::vector<byte> &Key)
@@ -527,7 +588,8 @@ void RHX::ExpandSubBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffs
 
 //~~~Rounds Processing~~~//
 
-void RHX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void RHX::Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = m_expKey.size() - 4;
 
@@ -581,7 +643,8 @@ void RHX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Output[OutOffset + 15] = static_cast<byte>(ISBox[static_cast<byte>(Y0)] ^ static_cast<byte>(m_expKey[keyCtr]));
 }
 
-void RHX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void RHX::Decrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	Decrypt128(Input, InOffset, Output, OutOffset);
 	Decrypt128(Input, InOffset + 16, Output, OutOffset + 16);
@@ -589,19 +652,22 @@ void RHX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 	Decrypt128(Input, InOffset + 48, Output, OutOffset + 48);
 }
 
-void RHX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void RHX::Decrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	Decrypt512(Input, InOffset, Output, OutOffset);
 	Decrypt512(Input, InOffset + 64, Output, OutOffset + 64);
 }
 
-void RHX::Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void RHX::Decrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	Decrypt1024(Input, InOffset, Output, OutOffset);
 	Decrypt1024(Input, InOffset + 128, Output, OutOffset + 128);
 }
 
-void RHX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void RHX::Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = m_expKey.size() - 4;
 
@@ -653,7 +719,8 @@ void RHX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Output[OutOffset + 15] = static_cast<byte>(SBox[static_cast<byte>(Y2)] ^ static_cast<byte>(m_expKey[keyCtr]));
 }
 
-void RHX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void RHX::Encrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	Encrypt128(Input, InOffset, Output, OutOffset);
 	Encrypt128(Input, InOffset + 16, Output, OutOffset + 16);
@@ -661,13 +728,15 @@ void RHX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 	Encrypt128(Input, InOffset + 48, Output, OutOffset + 48);
 }
 
-void RHX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void RHX::Encrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	Encrypt512(Input, InOffset, Output, OutOffset);
 	Encrypt512(Input, InOffset + 64, Output, OutOffset + 64);
 }
 
-void RHX::Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void RHX::Encrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	Encrypt1024(Input, InOffset, Output, OutOffset);
 	Encrypt1024(Input, InOffset + 128, Output, OutOffset + 128);
@@ -373,16 +373,64 @@ public:
 	/// <param name="OutOffset">Starting offset in the output array</param>
 	void Transform2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Transform a block of bytes using caller owned memory.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least <see cref="BlockSize"/> bytes; they may point to the same address for an in-place transform.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	void Transform(const byte* Input, byte* Output) override;
+
+	/// <summary>
+	/// Transform 4 blocks of bytes using caller owned memory.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 4 * <see cref="BlockSize"/> bytes; they may point to the same address for an in-place transform.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	void Transform512(const byte* Input, byte* Output) override;
+
+	/// <summary>
+	/// Transform 8 blocks of bytes using caller owned memory.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 8 * <see cref="BlockSize"/> bytes; they may point to the same address for an in-place transform.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	void Transform1024(const byte* Input, byte* Output) override;
+
+	/// <summary>
+	/// Transform 16 blocks of bytes using caller owned memory.
+	/// <para><see cref="Initialize(bool, ISymmetricKey)"/> must be called before this method can be used.
+	/// Input and Output must each reference at least 16 * <see cref="BlockSize"/> bytes; they may point to the same address for an in-place transform.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	void Transform2048(const byte* Input, byte* Output) override;
+
 private:
 
-	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Decrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
+	template <typename ArrayA, typename ArrayB>
+	void Encrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset);
 	void ExpandKey(bool Encryption, const std::vector<byte> &Key);
 	void ExpandRotBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex);
 	void ExpandSubBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset);
@@ -96,10 +96,68 @@ private:
 		return ((W << 45) | (W >> 19)) ^ ((W << 3) | (W >> 61)) ^ (W >> 6);
 	}
 
+	inline static const uint* K256()
+	{
+		static const uint K[64] =
+		{
+			0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+			0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+			0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+			0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+			0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+			0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+			0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+			0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL
+		};
+
+		return K;
+	}
+
+	inline static const ulong* K512()
+	{
+		static const ulong K[80] =
+		{
+			0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL, 0xE9B5DBA58189DBBCULL,
+			0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL, 0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL,
+			0xD807AA98A3030242ULL, 0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+			0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL, 0xC19BF174CF692694ULL,
+			0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL, 0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL,
+			0x2DE92C6F592B0275ULL, 0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+			0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL, 0xBF597FC7BEEF0EE4ULL,
+			0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL, 0x06CA6351E003826FULL, 0x142929670A0E6E70ULL,
+			0x27B70A8546D22FFCULL, 0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+			0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL, 0x92722C851482353BULL,
+			0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL, 0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL,
+			0xD192E819D6EF5218ULL, 0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+			0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL, 0x34B0BCB5E19B48A8ULL,
+			0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL, 0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL,
+			0x748F82EE5DEFB2FCULL, 0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+			0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL, 0xC67178F2E372532BULL,
+			0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL, 0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL,
+			0x06F067AA72176FBAULL, 0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+			0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL, 0x431D67C49C100D4CULL,
+			0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL, 0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
+		};
+
+		return K;
+	}
+
+#if defined(__AVX2__)
+	inline static __m256i RotR32x8(const __m256i &X, const int Shift)
+	{
+		return _mm256_or_si256(_mm256_srli_epi32(X, Shift), _mm256_slli_epi32(X, 32 - Shift));
+	}
+
+	inline static __m256i RotR64x4(const __m256i &X, const int Shift)
+	{
+		return _mm256_or_si256(_mm256_srli_epi64(X, Shift), _mm256_slli_epi64(X, 64 - Shift));
+	}
+#endif
+
 public:
 
-	template<typename State>
-	inline static void Compress64(const std::vector<byte> &Input, size_t InOffset, State &Output)
+	template<typename Array, typename State>
+	inline static void Compress64(const Array &Input, size_t InOffset, State &Output)
 	{
 		uint A = Output.H[0];
 		uint B = Output.H[1];
@@ -255,8 +313,8 @@ public:
 		Output.Increase(64);
 	}
 
-	template<typename State>
-	inline static void Compress64W(const std::vector<byte> &Input, size_t InOffset, State &Output)
+	template<typename Array, typename State>
+	inline static void Compress64W(const Array &Input, size_t InOffset, State &Output)
 	{
 #if defined(__AVX__)
 		__m128i S0, S1, T0, T1;
@@ -439,14 +497,191 @@ public:
 		_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output.H[0]), S0);
 		_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output.H[4]), S1);
 
-		Output.Increase(128);
+		Output.Increase(64);
 #else
 		Compress64(Input, InOffset, Output);
 #endif
 	}
 
-	template<typename State>
-	inline static void Compress128(const std::vector<byte> &Input, size_t InOffset, State &Output)
+#if defined(__AVX2__)
+	/// <summary>
+	/// Compress one block in each of 8 independent SHA-256 states.
+	/// <para>The state is stored word-major; word i of lane j is State[(i * 8) + j].</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to a 64 byte block for each lane</param>
+	/// <param name="State">The 8 lane interleaved state</param>
+	inline static void Compress64Lanes(const std::array<const byte*, 8> &Input, std::array<uint, 64> &State)
+	{
+		const __m256i SWAP = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+		const uint* K = K256();
+		__m256i W[16];
+		__m256i R[8];
+		__m256i T[8];
+
+		// load the blocks and transpose them, so that each register holds one message word from every lane
+		for (size_t i = 0; i < 2; ++i)
+		{
+			for (size_t j = 0; j < 8; ++j)
+			{
+				R[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input[j] + (i * 32)));
+			}
+
+			T[0] = _mm256_unpacklo_epi32(R[0], R[1]);
+			T[1] = _mm256_unpackhi_epi32(R[0], R[1]);
+			T[2] = _mm256_unpacklo_epi32(R[2], R[3]);
+			T[3] = _mm256_unpackhi_epi32(R[2], R[3]);
+			T[4] = _mm256_unpacklo_epi32(R[4], R[5]);
+			T[5] = _mm256_unpackhi_epi32(R[4], R[5]);
+			T[6] = _mm256_unpacklo_epi32(R[6], R[7]);
+			T[7] = _mm256_unpackhi_epi32(R[6], R[7]);
+			R[0] = _mm256_unpacklo_epi64(T[0], T[2]);
+			R[1] = _mm256_unpackhi_epi64(T[0], T[2]);
+			R[2] = _mm256_unpacklo_epi64(T[1], T[3]);
+			R[3] = _mm256_unpackhi_epi64(T[1], T[3]);
+			R[4] = _mm256_unpacklo_epi64(T[4], T[6]);
+			R[5] = _mm256_unpackhi_epi64(T[4], T[6]);
+			R[6] = _mm256_unpacklo_epi64(T[5], T[7]);
+			R[7] = _mm256_unpackhi_epi64(T[5], T[7]);
+			W[(i * 8)] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(R[0], R[4], 0x20), SWAP);
+			W[(i * 8) + 1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(R[1], R[5], 0x20), SWAP);
+			W[(i * 8) + 2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(R[2], R[6], 0x20), SWAP);
+			W[(i * 8) + 3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(R[3], R[7], 0x20), SWAP);
+			W[(i * 8) + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(R[0], R[4], 0x31), SWAP);
+			W[(i * 8) + 5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(R[1], R[5], 0x31), SWAP);
+			W[(i * 8) + 6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(R[2], R[6], 0x31), SWAP);
+			W[(i * 8) + 7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(R[3], R[7], 0x31), SWAP);
+		}
+
+		__m256i A = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[0]));
+		__m256i B = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[8]));
+		__m256i C = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[16]));
+		__m256i D = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[24]));
+		__m256i E = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[32]));
+		__m256i F = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[40]));
+		__m256i G = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[48]));
+		__m256i H = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[56]));
+		__m256i T0;
+		__m256i T1;
+
+		for (size_t i = 0; i < 64; ++i)
+		{
+			if (i >= 16)
+			{
+				// expand the message schedule in place
+				const __m256i W2 = W[(i - 2) & 15];
+				const __m256i W15 = W[(i - 15) & 15];
+				T0 = _mm256_xor_si256(_mm256_xor_si256(RotR32x8(W2, 17), RotR32x8(W2, 19)), _mm256_srli_epi32(W2, 10));
+				T1 = _mm256_xor_si256(_mm256_xor_si256(RotR32x8(W15, 7), RotR32x8(W15, 18)), _mm256_srli_epi32(W15, 3));
+				W[i & 15] = _mm256_add_epi32(_mm256_add_epi32(T0, W[(i - 7) & 15]), _mm256_add_epi32(T1, W[i & 15]));
+			}
+
+			T0 = _mm256_xor_si256(_mm256_xor_si256(RotR32x8(E, 6), RotR32x8(E, 11)), RotR32x8(E, 25));
+			T0 = _mm256_add_epi32(_mm256_add_epi32(H, T0), _mm256_xor_si256(_mm256_and_si256(E, F), _mm256_andnot_si256(E, G)));
+			T0 = _mm256_add_epi32(T0, _mm256_add_epi32(_mm256_set1_epi32(K[i]), W[i & 15]));
+			T1 = _mm256_xor_si256(_mm256_xor_si256(RotR32x8(A, 2), RotR32x8(A, 13)), RotR32x8(A, 22));
+			T1 = _mm256_add_epi32(T1, _mm256_or_si256(_mm256_and_si256(A, B), _mm256_and_si256(C, _mm256_or_si256(A, B))));
+			H = G;
+			G = F;
+			F = E;
+			E = _mm256_add_epi32(D, T0);
+			D = C;
+			C = B;
+			B = A;
+			A = _mm256_add_epi32(T0, T1);
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[0]), _mm256_add_epi32(A, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[0]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[8]), _mm256_add_epi32(B, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[8]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[16]), _mm256_add_epi32(C, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[16]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[24]), _mm256_add_epi32(D, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[24]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[32]), _mm256_add_epi32(E, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[32]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[40]), _mm256_add_epi32(F, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[40]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[48]), _mm256_add_epi32(G, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[48]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[56]), _mm256_add_epi32(H, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[56]))));
+	}
+#endif
+
+#if defined(__AVX512__)
+	/// <summary>
+	/// Compress one block in each of 16 independent SHA-256 states.
+	/// <para>The state is stored word-major; word i of lane j is State[(i * 16) + j].</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to a 64 byte block for each lane</param>
+	/// <param name="State">The 16 lane interleaved state</param>
+	inline static void Compress64Lanes(const std::array<const byte*, 16> &Input, std::array<uint, 128> &State)
+	{
+		const __m512i MASKL = _mm512_set1_epi32(0x00FF00FFUL);
+		const __m512i MASKH = _mm512_set1_epi32(0xFF00FF00UL);
+		const uint* K = K256();
+		const long long BASE = reinterpret_cast<long long>(Input[0]);
+		// the block addresses as offsets from the first block, each word is gathered from all 16 lanes
+		const __m512i IDX0 = _mm512_sub_epi64(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[0])), _mm512_set1_epi64(BASE));
+		const __m512i IDX1 = _mm512_sub_epi64(_mm512_loadu_si512(reinterpret_cast<const void*>(&Input[8])), _mm512_set1_epi64(BASE));
+		__m512i W[16];
+		__m512i T0;
+		__m512i T1;
+
+		for (size_t i = 0; i < 16; ++i)
+		{
+			const __m512i OFT = _mm512_set1_epi64(static_cast<long long>(i * 4));
+			const __m256i X0 = _mm512_i64gather_epi32(_mm512_add_epi64(IDX0, OFT), reinterpret_cast<const void*>(Input[0]), 1);
+			const __m256i X1 = _mm512_i64gather_epi32(_mm512_add_epi64(IDX1, OFT), reinterpret_cast<const void*>(Input[0]), 1);
+			T0 = _mm512_inserti64x4(_mm512_castsi256_si512(X0), X1, 1);
+			// byte swap with rotations, avoiding a dependency on AVX512BW
+			W[i] = _mm512_or_si512(_mm512_ror_epi32(_mm512_and_si512(T0, MASKL), 8), _mm512_rol_epi32(_mm512_and_si512(T0, MASKH), 8));
+		}
+
+		__m512i A = _mm512_loadu_si512(reinterpret_cast<const void*>(&State[0]));
+		__m512i B = _mm512_loadu_si512(reinterpret_cast<const void*>(&State[16]));
+		__m512i C = _mm512_loadu_si512(reinterpret_cast<const void*>(&State[32]));
+		__m512i D = _mm512_loadu_si512(reinterpret_cast<const void*>(&State[48]));
+		__m512i E = _mm512_loadu_si512(reinterpret_cast<const void*>(&State[64]));
+		__m512i F = _mm512_loadu_si512(reinterpret_cast<const void*>(&State[80]));
+		__m512i G = _mm512_loadu_si512(reinterpret_cast<const void*>(&State[96]));
+		__m512i H = _mm512_loadu_si512(reinterpret_cast<const void*>(&State[112]));
+
+		for (size_t i = 0; i < 64; ++i)
+		{
+			if (i >= 16)
+			{
+				const __m512i W2 = W[(i - 2) & 15];
+				const __m512i W15 = W[(i - 15) & 15];
+				T0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(W2, 17), _mm512_ror_epi32(W2, 19), _mm512_srli_epi32(W2, 10), 0x96);
+				T1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(W15, 7), _mm512_ror_epi32(W15, 18), _mm512_srli_epi32(W15, 3), 0x96);
+				W[i & 15] = _mm512_add_epi32(_mm512_add_epi32(T0, W[(i - 7) & 15]), _mm512_add_epi32(T1, W[i & 15]));
+			}
+
+			// 0x96 is a three way xor, 0xCA is Ch(E, F, G) and 0xE8 is Maj(A, B, C)
+			T0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(E, 6), _mm512_ror_epi32(E, 11), _mm512_ror_epi32(E, 25), 0x96);
+			T0 = _mm512_add_epi32(_mm512_add_epi32(H, T0), _mm512_ternarylogic_epi32(E, F, G, 0xCA));
+			T0 = _mm512_add_epi32(T0, _mm512_add_epi32(_mm512_set1_epi32(K[i]), W[i & 15]));
+			T1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(A, 2), _mm512_ror_epi32(A, 13), _mm512_ror_epi32(A, 22), 0x96);
+			T1 = _mm512_add_epi32(T1, _mm512_ternarylogic_epi32(A, B, C, 0xE8));
+			H = G;
+			G = F;
+			F = E;
+			E = _mm512_add_epi32(D, T0);
+			D = C;
+			C = B;
+			B = A;
+			A = _mm512_add_epi32(T0, T1);
+		}
+
+		_mm512_storeu_si512(reinterpret_cast<void*>(&State[0]), _mm512_add_epi32(A, _mm512_loadu_si512(reinterpret_cast<const void*>(&State[0]))));
+		_mm512_storeu_si512(reinterpret_cast<void*>(&State[16]), _mm512_add_epi32(B, _mm512_loadu_si512(reinterpret_cast<const void*>(&State[16]))));
+		_mm512_storeu_si512(reinterpret_cast<void*>(&State[32]), _mm512_add_epi32(C, _mm512_loadu_si512(reinterpret_cast<const void*>(&State[32]))));
+		_mm512_storeu_si512(reinterpret_cast<void*>(&State[48]), _mm512_add_epi32(D, _mm512_loadu_si512(reinterpret_cast<const void*>(&State[48]))));
+		_mm512_storeu_si512(reinterpret_cast<void*>(&State[64]), _mm512_add_epi32(E, _mm512_loadu_si512(reinterpret_cast<const void*>(&State[64]))));
+		_mm512_storeu_si512(reinterpret_cast<void*>(&State[80]), _mm512_add_epi32(F, _mm512_loadu_si512(reinterpret_cast<const void*>(&State[80]))));
+		_mm512_storeu_si512(reinterpret_cast<void*>(&State[96]), _mm512_add_epi32(G, _mm512_loadu_si512(reinterpret_cast<const void*>(&State[96]))));
+		_mm512_storeu_si512(reinterpret_cast<void*>(&State[112]), _mm512_add_epi32(H, _mm512_loadu_si512(reinterpret_cast<const void*>(&State[112]))));
+	}
+#endif
+
+	template<typename Array, typename State>
+	inline static void Compress128(const Array &Input, size_t InOffset, State &Output)
 	{
 		ulong A = Output.H[0];
 		ulong B = Output.H[1];
@@ -634,6 +869,89 @@ public:
 
 		Output.Increase(128);
 	}
+
+#if defined(__AVX2__)
+	/// <summary>
+	/// Compress one block in each of 4 independent SHA-512 states.
+	/// <para>The state is stored word-major; word i of lane j is State[(i * 4) + j].</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to a 128 byte block for each lane</param>
+	/// <param name="State">The 4 lane interleaved state</param>
+	inline static void Compress128Lanes(const std::array<const byte*, 4> &Input, std::array<ulong, 32> &State)
+	{
+		const __m256i SWAP = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+		const ulong* K = K512();
+		__m256i W[16];
+		__m256i R[4];
+		__m256i T[4];
+
+		// load the blocks and transpose them, so that each register holds one message word from every lane
+		for (size_t i = 0; i < 4; ++i)
+		{
+			for (size_t j = 0; j < 4; ++j)
+			{
+				R[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input[j] + (i * 32)));
+			}
+
+			T[0] = _mm256_unpacklo_epi64(R[0], R[1]);
+			T[1] = _mm256_unpackhi_epi64(R[0], R[1]);
+			T[2] = _mm256_unpacklo_epi64(R[2], R[3]);
+			T[3] = _mm256_unpackhi_epi64(R[2], R[3]);
+			W[(i * 4)] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(T[0], T[2], 0x20), SWAP);
+			W[(i * 4) + 1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(T[1], T[3], 0x20), SWAP);
+			W[(i * 4) + 2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(T[0], T[2], 0x31), SWAP);
+			W[(i * 4) + 3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(T[1], T[3], 0x31), SWAP);
+		}
+
+		__m256i A = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[0]));
+		__m256i B = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[4]));
+		__m256i C = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[8]));
+		__m256i D = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[12]));
+		__m256i E = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[16]));
+		__m256i F = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[20]));
+		__m256i G = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[24]));
+		__m256i H = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[28]));
+		__m256i T0;
+		__m256i T1;
+
+		for (size_t i = 0; i < 80; ++i)
+		{
+			if (i >= 16)
+			{
+				// expand the message schedule in place
+				const __m256i W2 = W[(i - 2) & 15];
+				const __m256i W15 = W[(i - 15) & 15];
+				T0 = _mm256_xor_si256(_mm256_xor_si256(RotR64x4(W2, 19), RotR64x4(W2, 61)), _mm256_srli_epi64(W2, 6));
+				T1 = _mm256_xor_si256(_mm256_xor_si256(RotR64x4(W15, 1), RotR64x4(W15, 8)), _mm256_srli_epi64(W15, 7));
+				W[i & 15] = _mm256_add_epi64(_mm256_add_epi64(T0, W[(i - 7) & 15]), _mm256_add_epi64(T1, W[i & 15]));
+			}
+
+			T0 = _mm256_xor_si256(_mm256_xor_si256(RotR64x4(E, 14), RotR64x4(E, 18)), RotR64x4(E, 41));
+			T0 = _mm256_add_epi64(_mm256_add_epi64(H, T0), _mm256_xor_si256(_mm256_and_si256(E, F), _mm256_andnot_si256(E, G)));
+			T0 = _mm256_add_epi64(T0, _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(K[i])), W[i & 15]));
+			T1 = _mm256_xor_si256(_mm256_xor_si256(RotR64x4(A, 28), RotR64x4(A, 34)), RotR64x4(A, 39));
+			T1 = _mm256_add_epi64(T1, _mm256_or_si256(_mm256_and_si256(A, B), _mm256_and_si256(C, _mm256_or_si256(A, B))));
+			H = G;
+			G = F;
+			F = E;
+			E = _mm256_add_epi64(D, T0);
+			D = C;
+			C = B;
+			B = A;
+			A = _mm256_add_epi64(T0, T1);
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[0]), _mm256_add_epi64(A, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[0]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[4]), _mm256_add_epi64(B, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[4]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[8]), _mm256_add_epi64(C, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[8]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[12]), _mm256_add_epi64(D, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[12]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[16]), _mm256_add_epi64(E, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[16]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[20]), _mm256_add_epi64(F, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[20]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[24]), _mm256_add_epi64(G, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[24]))));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[28]), _mm256_add_epi64(H, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[28]))));
+	}
+#endif
 };
 
 NAMESPACE_DIGESTEND
@@ -1,7 +1,10 @@
 #include "SHA256.h"
+#include "ArraySpan.h"
 #include "SHA2.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
+#include <algorithm>
+#include <numeric>
 #if defined(__AVX__)
 #	include "Intrinsics.h"
 #endif
@@ -16,6 +19,7 @@ const std::string SHA256::CLASS_NAME("SHA256");
 
 SHA256::SHA256(bool Parallel)
 	:
+	m_batchLanes(0),
 	m_dgtState(Parallel ? DEF_PRLDEGREE : 1),
 	m_isDestroyed(false),
 	m_msgBuffer(Parallel ? DEF_PRLDEGREE * BLOCK_SIZE : BLOCK_SIZE),
@@ -40,6 +44,7 @@ SHA256::SHA256(bool Parallel)
 
 SHA256::SHA256(SHA2Params &Params)
 	:
+	m_batchLanes(0),
 	m_dgtState(1),
 	m_isDestroyed(false),
 	m_msgBuffer(BLOCK_SIZE),
@@ -92,6 +97,50 @@ SHA256::~SHA256()
 
 //~~~Accessors~~~//
 
+const size_t SHA256::BatchLanes()
+{
+	if (m_batchLanes != 0)
+	{
+		return m_batchLanes;
+	}
+
+#if defined(__AVX512__)
+	if (m_parallelProfile.HasSimd512())
+	{
+		return 16;
+	}
+#endif
+#if defined(__AVX2__)
+	// the sha-ni single block compressor is faster than the 8 lane avx2 compressor
+	if (!m_parallelProfile.HasSHA2() && m_parallelProfile.HasSimd256())
+	{
+		return 8;
+	}
+#endif
+
+	return 1;
+}
+
+void SHA256::BatchLanes(size_t Lanes)
+{
+	// the lane count can be forced past the sha-ni preference, but not past what the processor supports
+	m_batchLanes = (Lanes == 0) ? 0 : 1;
+
+#if defined(__AVX512__)
+	if (Lanes >= 16 && m_parallelProfile.HasSimd512())
+	{
+		m_batchLanes = 16;
+		return;
+	}
+#endif
+#if defined(__AVX2__)
+	if (Lanes >= 8 && m_parallelProfile.HasSimd256())
+	{
+		m_batchLanes = 8;
+	}
+#endif
+}
+
 size_t SHA256::BlockSize() 
 { 
 	return BLOCK_SIZE; 
@@ -147,6 +196,56 @@ void SHA256::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
 	Finalize(Output, 0);
 }
 
+void SHA256::ComputeBatch(const std::vector<std::vector<byte>> &Input, std::vector<std::vector<byte>> &Output)
+{
+	std::vector<const byte*> msgPtr(Input.size());
+	std::vector<size_t> msgLen(Input.size());
+	std::vector<byte> code(Input.size() * DIGEST_SIZE);
+
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		msgPtr[i] = Input[i].data();
+		msgLen[i] = Input[i].size();
+	}
+
+	ComputeBatch(msgPtr, msgLen, code, 0);
+	Output.resize(Input.size());
+
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		Output[i].resize(DIGEST_SIZE);
+		Utility::MemUtils::Copy(code, i * DIGEST_SIZE, Output[i], 0, DIGEST_SIZE);
+	}
+}
+
+void SHA256::ComputeBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	CexAssert(Input.size() == Length.size(), "The message and length counts must be equal");
+	CexAssert(Output.size() - OutOffset >= Input.size() * DIGEST_SIZE, "The Output buffer is too short!");
+
+	const size_t LANES = BatchLanes();
+
+#if defined(__AVX512__)
+	if (LANES == 16 && Input.size() >= 16)
+	{
+		ProcessBatch<16>(Input, Length, Output, OutOffset);
+		return;
+	}
+#endif
+#if defined(__AVX2__)
+	if (LANES >= 8 && Input.size() > 1)
+	{
+		ProcessBatch<8>(Input, Length, Output, OutOffset);
+		return;
+	}
+#endif
+
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		HashBatch(Input[i], Length[i], Output, OutOffset + (i * DIGEST_SIZE));
+	}
+}
+
 size_t SHA256::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 {
 	CexAssert(Output.size() - OutOffset >= DIGEST_SIZE, "The Output buffer is too short!");
@@ -257,6 +356,107 @@ void SHA256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Leng
 {
 	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
 
+	Process(Input, InOffset, Length);
+}
+
+void SHA256::Update(const byte* Input, size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+template <typename Array>
+void SHA256::Compress(const Array &Input, size_t InOffset, SHA256State &State)
+{
+	if (m_parallelProfile.HasSHA2())
+	{
+		SHA2::Compress64W(Input, InOffset, State);
+	}
+	else
+	{
+		SHA2::Compress64(Input, InOffset, State);
+	}
+}
+
+void SHA256::HashBatch(const byte* Input, size_t Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	std::array<byte, 2 * BLOCK_SIZE> tail;
+	const size_t TAILCNT = PadBatch(Input, Length, tail);
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	SHA256State state;
+
+	state.Reset();
+
+	for (size_t i = 0; i < Length / BLOCK_SIZE; ++i)
+	{
+		Compress(inp, i * BLOCK_SIZE, state);
+	}
+
+	for (size_t i = 0; i < TAILCNT; ++i)
+	{
+		Compress(tail, i * BLOCK_SIZE, state);
+	}
+
+	IntUtils::BeUL256ToBlock(state.H, 0, Output, OutOffset);
+}
+
+void SHA256::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, SHA256State &State)
+{
+	State.T += Length;
+	ulong bitLen = (State.T << 3);
+
+	if (Length == BLOCK_SIZE)
+	{
+		Compress(Input, InOffset, State);
+		Length = 0;
+	}
+
+	Input[InOffset + Length] = 128;
+	++Length;
+
+	// padding
+	if (Length < BLOCK_SIZE)
+	{
+		Utility::MemUtils::Clear(Input, InOffset + Length, BLOCK_SIZE - Length);
+	}
+
+	if (Length > 56)
+	{
+		Compress(Input, InOffset, State);
+		Utility::MemUtils::Clear(Input, 0, BLOCK_SIZE);
+	}
+
+	// finalize state with counter and last compression
+	IntUtils::Be32ToBytes(static_cast<uint>(static_cast<ulong>(bitLen) >> 32), Input, InOffset + 56);
+	IntUtils::Be32ToBytes(static_cast<uint>(static_cast<ulong>(bitLen)), Input, InOffset + 60);
+	Compress(Input, InOffset, State);
+}
+
+size_t SHA256::PadBatch(const byte* Input, size_t Length, std::array<byte, 2 * BLOCK_SIZE> &Output)
+{
+	// the final partial block, the padding byte, and the message bit length; one or two blocks
+	const size_t RMDLEN = Length % BLOCK_SIZE;
+	const size_t PADLEN = (RMDLEN < BLOCK_SIZE - 8) ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+
+	std::memset(&Output[0], 0, Output.size());
+
+	if (RMDLEN != 0)
+	{
+		std::memcpy(&Output[0], Input + (Length - RMDLEN), RMDLEN);
+	}
+
+	Output[RMDLEN] = 0x80;
+	IntUtils::Be64ToBytes(static_cast<ulong>(Length) << 3, Output, PADLEN - 8);
+
+	return PADLEN / BLOCK_SIZE;
+}
+
+template <typename Array>
+void SHA256::Process(const Array &Input, size_t InOffset, size_t Length)
+{
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
@@ -343,53 +543,154 @@ void SHA256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Leng
 	}
 }
 
-//~~~Private Functions~~~//
-
-void SHA256::Compress(const std::vector<byte> &Input, size_t InOffset, SHA256State &State)
+template <size_t LANES>
+void SHA256::ProcessBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset)
 {
-	if (m_parallelProfile.HasSHA2())
+#if defined(__AVX2__)
+	struct BatchLane
 	{
-		SHA2::Compress64W(Input, InOffset, State);
-	}
-	else
+		std::array<byte, 2 * BLOCK_SIZE> Final;
+		size_t FinalCount;
+		size_t FinalOffset;
+		size_t Index;
+		const byte* Message;
+		size_t MessageBlocks;
+		bool Active;
+	};
+
+	const size_t MSGCNT = Input.size();
+	std::array<BatchLane, LANES> lanes;
+	std::array<const byte*, LANES> blocks;
+	std::array<uint, 8 * LANES> state;
+	std::array<uint, 8> digest;
+	const std::array<byte, BLOCK_SIZE> idle = { 0 };
+	std::vector<size_t> order(MSGCNT);
+	size_t actCtr = 0;
+	size_t msgCtr = 0;
+
+	// schedule the longest messages first, the short messages then fill the lanes as they are released
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&Length](size_t A, size_t B) { return Length[A] > Length[B]; });
+
+	auto assign = [&](size_t Lane)
 	{
-		SHA2::Compress64(Input, InOffset, State);
-	}
-}
+		BatchLane &lane = lanes[Lane];
 
-void SHA256::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, SHA256State &State)
-{
-	State.T += Length;
-	ulong bitLen = (State.T << 3);
+		if (msgCtr == MSGCNT)
+		{
+			lane.Active = false;
+			return;
+		}
 
-	if (Length == BLOCK_SIZE)
+		SHA256State iv;
+		iv.Reset();
+		lane.Index = order[msgCtr];
+		lane.Message = Input[lane.Index];
+		lane.MessageBlocks = Length[lane.Index] / BLOCK_SIZE;
+		lane.FinalCount = PadBatch(lane.Message, Length[lane.Index], lane.Final);
+		lane.FinalOffset = 0;
+		lane.Active = true;
+
+		for (size_t i = 0; i < 8; ++i)
+		{
+			state[(i * LANES) + Lane] = iv.H[i];
+		}
+
+		++msgCtr;
+		++actCtr;
+	};
+
+	for (size_t i = 0; i < LANES; ++i)
 	{
-		Compress(Input, InOffset, State);
-		Length = 0;
+		assign(i);
 	}
 
-	Input[InOffset + Length] = 128;
-	++Length;
-
-	// padding
-	if (Length < BLOCK_SIZE)
+	// when one message remains it is finished with the single lane compressor
+	while (actCtr > 1 || (actCtr == 1 && msgCtr < MSGCNT))
 	{
-		Utility::MemUtils::Clear(Input, InOffset + Length, BLOCK_SIZE - Length);
+		for (size_t i = 0; i < LANES; ++i)
+		{
+			const BatchLane &lane = lanes[i];
+			blocks[i] = !lane.Active ? idle.data() : (lane.MessageBlocks != 0) ? lane.Message : lane.Final.data() + (lane.FinalOffset * BLOCK_SIZE);
+		}
+
+		SHA2::Compress64Lanes(blocks, state);
+
+		for (size_t i = 0; i < LANES; ++i)
+		{
+			BatchLane &lane = lanes[i];
+
+			if (!lane.Active)
+			{
+				continue;
+			}
+
+			if (lane.MessageBlocks != 0)
+			{
+				lane.Message += BLOCK_SIZE;
+				--lane.MessageBlocks;
+			}
+			else
+			{
+				++lane.FinalOffset;
+			}
+
+			if (lane.MessageBlocks == 0 && lane.FinalOffset == lane.FinalCount)
+			{
+				for (size_t j = 0; j < 8; ++j)
+				{
+					digest[j] = state[(j * LANES) + i];
+				}
+
+				IntUtils::BeUL256ToBlock(digest, 0, Output, OutOffset + (lane.Index * DIGEST_SIZE));
+				--actCtr;
+				assign(i);
+			}
+		}
 	}
 
-	if (Length > 56)
+	for (size_t i = 0; i < LANES; ++i)
 	{
-		Compress(Input, InOffset, State);
-		Utility::MemUtils::Clear(Input, 0, BLOCK_SIZE);
+		BatchLane &lane = lanes[i];
+
+		if (lane.Active)
+		{
+			const Utility::ArraySpan<const byte> inp(lane.Message, lane.MessageBlocks * BLOCK_SIZE);
+			SHA256State tmpS;
+			tmpS.Reset();
+
+			for (size_t j = 0; j < 8; ++j)
+			{
+				tmpS.H[j] = state[(j * LANES) + i];
+			}
+
+			for (size_t j = 0; j < lane.MessageBlocks; ++j)
+			{
+				Compress(inp, j * BLOCK_SIZE, tmpS);
+			}
+
+			for (size_t j = lane.FinalOffset; j < lane.FinalCount; ++j)
+			{
+				Compress(lane.Final, j * BLOCK_SIZE, tmpS);
+			}
+
+			IntUtils::BeUL256ToBlock(tmpS.H, 0, Output, OutOffset + (lane.Index * DIGEST_SIZE));
+			lane.Active = false;
+		}
 	}
 
-	// finalize state with counter and last compression
-	IntUtils::Be32ToBytes(static_cast<uint>(static_cast<ulong>(bitLen) >> 32), Input, InOffset + 56);
-	IntUtils::Be32ToBytes(static_cast<uint>(static_cast<ulong>(bitLen)), Input, InOffset + 60);
-	Compress(Input, InOffset, State);
+	Utility::MemUtils::Clear(state, 0, state.size() * sizeof(uint));
+	Utility::MemUtils::Clear(digest, 0, digest.size() * sizeof(uint));
+
+	for (size_t i = 0; i < LANES; ++i)
+	{
+		Utility::MemUtils::Clear(lanes[i].Final, 0, lanes[i].Final.size());
+	}
+#endif
 }
 
-void SHA256::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, SHA256State &State, ulong Length)
+template <typename Array>
+void SHA256::ProcessLeaf(const Array &Input, size_t InOffset, SHA256State &State, ulong Length)
 {
 	do
 	{
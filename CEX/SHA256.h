@@ -74,6 +74,7 @@ NAMESPACE_DIGEST
 /// <item><description>The <see cref="Finalize(byte[], size_t)"/> method returns the hash or MAC code and resets the internal state.</description></item>
 /// <item><description>Setting Parallel to true in the constructor instantiates the multi-threaded variant.</description></item>
 /// <item><description>Multi-threaded and sequential versions produce a different output hash for a message, this is expected.</description></item>
+/// <item><description>The ComputeBatch functions hash many independent messages across SIMD lanes (multi-buffer), and return the standard sequential digests.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -130,6 +131,7 @@ private:
 		}
 	};
 
+	size_t m_batchLanes;
 	std::vector<SHA256State> m_dgtState;
 	bool m_isDestroyed;
 	std::vector<byte> m_msgBuffer;
@@ -182,6 +184,20 @@ public:
 
 	//~~~Accessors~~~//
 
+	/// <summary>
+	/// Read/Write: The number of messages hashed together by the ComputeBatch functions; 16 (AVX512), 8 (AVX2), or 1 (each message in turn).
+	/// <para>The default is the fastest compressor for the processor, on processors with the SHA extensions this is 1.
+	/// Used to test the lane compressors on every processor that supports them.</para>
+	/// </summary>
+	const size_t BatchLanes();
+
+	/// <summary>
+	/// Read/Write: Set the maximum number of lanes used by the ComputeBatch functions
+	/// </summary>
+	///
+	/// <param name="Lanes">The maximum number of lanes; 16, 8 or 1, the widest lane count the processor supports is used. Zero restores the default.</param>
+	void BatchLanes(size_t Lanes);
+
 	/// <summary>
 	/// Read Only: The Digests internal blocksize in bytes
 	/// </summary>
@@ -234,6 +250,29 @@ public:
 	/// <param name="Output">The hash output code array</param>
 	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
 
+	/// <summary>
+	/// Compute the standard SHA-256 digest of each message in a batch of independent messages.
+	/// <para>The messages are hashed together across SIMD lanes; 16 lanes with AVX512, otherwise 8 lanes with AVX2.
+	/// On processors with the SHA extensions, the SHA-NI compressor is faster than 8 AVX2 lanes and hashes each message in turn, unless the lanes are forced with BatchLanes(size_t).
+	/// A lane is refilled with the next message as soon as its message completes, and the longest messages are scheduled first, so messages of different lengths can be mixed freely.
+	/// The digests are those of the sequential mode; the parallel (tree hashing) setting and the current state of this instance are not used or modified.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The messages to hash</param>
+	/// <param name="Output">Receives the 32 byte digest of each message, in the order of the Input messages</param>
+	void ComputeBatch(const std::vector<std::vector<byte>> &Input, std::vector<std::vector<byte>> &Output);
+
+	/// <summary>
+	/// Compute the standard SHA-256 digest of each message in a batch of messages in caller owned memory.
+	/// <para>The digests are written contiguously, the digest of message i is at OutOffset + (i * 32).</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">Pointers to the messages; each must reference at least the corresponding Length bytes</param>
+	/// <param name="Length">The length of each message in bytes</param>
+	/// <param name="Output">The output array; must be at least OutOffset + (Input.size() * 32) bytes long</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	void ComputeBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset);
+
 	/// <summary>
 	/// Finalize processing and get the hash code
 	/// </summary>
@@ -276,11 +315,27 @@ public:
 	/// <param name="Length">The number of message bytes to process</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the digest with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
-	void Compress(const std::vector<byte> &Input, size_t InOffset, SHA256State &State);
+	template <typename Array>
+	void Compress(const Array &Input, size_t InOffset, SHA256State &State);
+	void HashBatch(const byte* Input, size_t Length, std::vector<byte> &Output, size_t OutOffset);
 	void HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, SHA256State &State);
-	void ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, SHA256State &State, ulong Length);
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
+	template <size_t LANES>
+	void ProcessBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset);
+	template <typename Array>
+	void ProcessLeaf(const Array &Input, size_t InOffset, SHA256State &State, ulong Length);
+	static size_t PadBatch(const byte* Input, size_t Length, std::array<byte, 2 * BLOCK_SIZE> &Output);
 };
 
 NAMESPACE_DIGESTEND
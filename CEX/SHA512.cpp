@@ -1,7 +1,13 @@
 #include "SHA512.h"
+#include "ArraySpan.h"
 #include "SHA2.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
+#include <algorithm>
+#include <numeric>
+#if defined(__AVX__)
+#	include "Intrinsics.h"
+#endif
 
 NAMESPACE_DIGEST
 
@@ -161,6 +167,47 @@ void SHA512::Destroy()
 	}
 }
 
+void SHA512::ComputeBatch(const std::vector<std::vector<byte>> &Input, std::vector<std::vector<byte>> &Output)
+{
+	std::vector<const byte*> msgPtr(Input.size());
+	std::vector<size_t> msgLen(Input.size());
+	std::vector<byte> code(Input.size() * DIGEST_SIZE);
+
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		msgPtr[i] = Input[i].data();
+		msgLen[i] = Input[i].size();
+	}
+
+	ComputeBatch(msgPtr, msgLen, code, 0);
+	Output.resize(Input.size());
+
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		Output[i].resize(DIGEST_SIZE);
+		Utility::MemUtils::Copy(code, i * DIGEST_SIZE, Output[i], 0, DIGEST_SIZE);
+	}
+}
+
+void SHA512::ComputeBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	CexAssert(Input.size() == Length.size(), "The message and length counts must be equal");
+	CexAssert(Output.size() - OutOffset >= Input.size() * DIGEST_SIZE, "The Output buffer is too short!");
+
+#if defined(__AVX2__)
+	if (m_parallelProfile.HasSimd256() && Input.size() > 1)
+	{
+		ProcessBatch<4>(Input, Length, Output, OutOffset);
+		return;
+	}
+#endif
+
+	for (size_t i = 0; i < Input.size(); ++i)
+	{
+		HashBatch(Input[i], Length[i], Output, OutOffset + (i * DIGEST_SIZE));
+	}
+}
+
 size_t SHA512::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 {
 	CexAssert(Output.size() - OutOffset >= DIGEST_SIZE, "The Output buffer is too short!");
@@ -271,6 +318,93 @@ void SHA512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Leng
 {
 	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
 
+	Process(Input, InOffset, Length);
+}
+
+void SHA512::Update(const byte* Input, size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+void SHA512::HashBatch(const byte* Input, size_t Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	std::array<byte, 2 * BLOCK_SIZE> tail;
+	const size_t TAILCNT = PadBatch(Input, Length, tail);
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	SHA512State state;
+
+	state.Reset();
+
+	for (size_t i = 0; i < Length / BLOCK_SIZE; ++i)
+	{
+		SHA2::Compress128(inp, i * BLOCK_SIZE, state);
+	}
+
+	for (size_t i = 0; i < TAILCNT; ++i)
+	{
+		SHA2::Compress128(tail, i * BLOCK_SIZE, state);
+	}
+
+	IntUtils::BeULL512ToBlock(state.H, 0, Output, OutOffset);
+}
+
+void SHA512::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, SHA512State &State)
+{
+	State.Increase(Length);
+	ulong bitLen = (State.T[0] << 3);
+
+	if (Length == BLOCK_SIZE)
+	{
+		SHA2::Compress128(Input, InOffset, State);
+		Length = 0;
+	}
+
+	Input[InOffset + Length] = 128;
+	++Length;
+
+	// padding
+	if (Length < BLOCK_SIZE)
+		Utility::MemUtils::Clear(Input, InOffset + Length, BLOCK_SIZE - Length);
+
+	if (Length > 112)
+	{
+		SHA2::Compress128(Input, InOffset, State);
+		Utility::MemUtils::Clear(Input, InOffset, BLOCK_SIZE);
+	}
+
+	// finalize state with counter and last compression
+	IntUtils::Be64ToBytes(State.T[1], Input, InOffset + 112);
+	IntUtils::Be64ToBytes(bitLen, Input, InOffset + 120);
+	SHA2::Compress128(Input, InOffset, State);
+}
+
+size_t SHA512::PadBatch(const byte* Input, size_t Length, std::array<byte, 2 * BLOCK_SIZE> &Output)
+{
+	// the final partial block, the padding byte, and the message bit length; one or two blocks
+	const size_t RMDLEN = Length % BLOCK_SIZE;
+	const size_t PADLEN = (RMDLEN < BLOCK_SIZE - 16) ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+
+	std::memset(&Output[0], 0, Output.size());
+
+	if (RMDLEN != 0)
+	{
+		std::memcpy(&Output[0], Input + (Length - RMDLEN), RMDLEN);
+	}
+
+	Output[RMDLEN] = 0x80;
+	IntUtils::Be64ToBytes(static_cast<ulong>(Length) >> 61, Output, PADLEN - 16);
+	IntUtils::Be64ToBytes(static_cast<ulong>(Length) << 3, Output, PADLEN - 8);
+
+	return PADLEN / BLOCK_SIZE;
+}
+
+template <typename Array>
+void SHA512::Process(const Array &Input, size_t InOffset, size_t Length)
+{
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
@@ -356,39 +490,154 @@ void SHA512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Leng
 	}
 }
 
-//~~~Private Functions~~~//
-
-void SHA512::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, SHA512State &State)
+template <size_t LANES>
+void SHA512::ProcessBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset)
 {
-	State.Increase(Length);
-	ulong bitLen = (State.T[0] << 3);
+#if defined(__AVX2__)
+	struct BatchLane
+	{
+		std::array<byte, 2 * BLOCK_SIZE> Final;
+		size_t FinalCount;
+		size_t FinalOffset;
+		size_t Index;
+		const byte* Message;
+		size_t MessageBlocks;
+		bool Active;
+	};
+
+	const size_t MSGCNT = Input.size();
+	std::array<BatchLane, LANES> lanes;
+	std::array<const byte*, LANES> blocks;
+	std::array<ulong, 8 * LANES> state;
+	std::array<ulong, 8> digest;
+	const std::array<byte, BLOCK_SIZE> idle = { 0 };
+	std::vector<size_t> order(MSGCNT);
+	size_t actCtr = 0;
+	size_t msgCtr = 0;
+
+	// schedule the longest messages first, the short messages then fill the lanes as they are released
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&Length](size_t A, size_t B) { return Length[A] > Length[B]; });
+
+	auto assign = [&](size_t Lane)
+	{
+		BatchLane &lane = lanes[Lane];
 
-	if (Length == BLOCK_SIZE)
+		if (msgCtr == MSGCNT)
+		{
+			lane.Active = false;
+			return;
+		}
+
+		SHA512State iv;
+		iv.Reset();
+		lane.Index = order[msgCtr];
+		lane.Message = Input[lane.Index];
+		lane.MessageBlocks = Length[lane.Index] / BLOCK_SIZE;
+		lane.FinalCount = PadBatch(lane.Message, Length[lane.Index], lane.Final);
+		lane.FinalOffset = 0;
+		lane.Active = true;
+
+		for (size_t i = 0; i < 8; ++i)
+		{
+			state[(i * LANES) + Lane] = iv.H[i];
+		}
+
+		++msgCtr;
+		++actCtr;
+	};
+
+	for (size_t i = 0; i < LANES; ++i)
 	{
-		SHA2::Compress128(Input, InOffset, State);
-		Length = 0;
+		assign(i);
 	}
 
-	Input[InOffset + Length] = 128;
-	++Length;
+	// when one message remains it is finished with the single lane compressor
+	while (actCtr > 1 || (actCtr == 1 && msgCtr < MSGCNT))
+	{
+		for (size_t i = 0; i < LANES; ++i)
+		{
+			const BatchLane &lane = lanes[i];
+			blocks[i] = !lane.Active ? idle.data() : (lane.MessageBlocks != 0) ? lane.Message : lane.Final.data() + (lane.FinalOffset * BLOCK_SIZE);
+		}
 
-	// padding
-	if (Length < BLOCK_SIZE)
-		Utility::MemUtils::Clear(Input, InOffset + Length, BLOCK_SIZE - Length);
+		SHA2::Compress128Lanes(blocks, state);
 
-	if (Length > 112)
+		for (size_t i = 0; i < LANES; ++i)
+		{
+			BatchLane &lane = lanes[i];
+
+			if (!lane.Active)
+			{
+				continue;
+			}
+
+			if (lane.MessageBlocks != 0)
+			{
+				lane.Message += BLOCK_SIZE;
+				--lane.MessageBlocks;
+			}
+			else
+			{
+				++lane.FinalOffset;
+			}
+
+			if (lane.MessageBlocks == 0 && lane.FinalOffset == lane.FinalCount)
+			{
+				for (size_t j = 0; j < 8; ++j)
+				{
+					digest[j] = state[(j * LANES) + i];
+				}
+
+				IntUtils::BeULL512ToBlock(digest, 0, Output, OutOffset + (lane.Index * DIGEST_SIZE));
+				--actCtr;
+				assign(i);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < LANES; ++i)
 	{
-		SHA2::Compress128(Input, InOffset, State);
-		Utility::MemUtils::Clear(Input, InOffset, BLOCK_SIZE);
+		BatchLane &lane = lanes[i];
+
+		if (lane.Active)
+		{
+			const Utility::ArraySpan<const byte> inp(lane.Message, lane.MessageBlocks * BLOCK_SIZE);
+			SHA512State tmpS;
+			tmpS.Reset();
+
+			for (size_t j = 0; j < 8; ++j)
+			{
+				tmpS.H[j] = state[(j * LANES) + i];
+			}
+
+			for (size_t j = 0; j < lane.MessageBlocks; ++j)
+			{
+				SHA2::Compress128(inp, j * BLOCK_SIZE, tmpS);
+			}
+
+			for (size_t j = lane.FinalOffset; j < lane.FinalCount; ++j)
+			{
+				SHA2::Compress128(lane.Final, j * BLOCK_SIZE, tmpS);
+			}
+
+			IntUtils::BeULL512ToBlock(tmpS.H, 0, Output, OutOffset + (lane.Index * DIGEST_SIZE));
+			lane.Active = false;
+		}
 	}
 
-	// finalize state with counter and last compression
-	IntUtils::Be64ToBytes(State.T[1], Input, InOffset + 112);
-	IntUtils::Be64ToBytes(bitLen, Input, InOffset + 120);
-	SHA2::Compress128(Input, InOffset, State);
+	Utility::MemUtils::Clear(state, 0, state.size() * sizeof(ulong));
+	Utility::MemUtils::Clear(digest, 0, digest.size() * sizeof(ulong));
+
+	for (size_t i = 0; i < LANES; ++i)
+	{
+		Utility::MemUtils::Clear(lanes[i].Final, 0, lanes[i].Final.size());
+	}
+#endif
 }
 
-void SHA512::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, SHA512State &State, ulong Length)
+template <typename Array>
+void SHA512::ProcessLeaf(const Array &Input, size_t InOffset, SHA512State &State, ulong Length)
 {
 	do
 	{
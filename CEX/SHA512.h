@@ -74,6 +74,7 @@ NAMESPACE_DIGEST
 /// <item><description>The <see cref="Finalize(byte[], size_t)"/> method returns the hash or MAC code and resets the internal state.</description></item>
 /// <item><description>Setting Parallel to true in the constructor instantiates the multi-threaded variant.</description></item>
 /// <item><description>Multi-threaded and sequential versions produce a different output hash for a message, this is expected.</description></item>
+/// <item><description>The ComputeBatch functions hash many independent messages across SIMD lanes (multi-buffer), and return the standard sequential digests.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -239,6 +240,28 @@ public:
 	/// <param name="Output">The hash output code array</param>
 	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
 
+	/// <summary>
+	/// Compute the standard SHA-512 digest of each message in a batch of independent messages.
+	/// <para>The messages are hashed together across SIMD lanes; 4 lanes with AVX2.
+	/// A lane is refilled with the next message as soon as its message completes, and the longest messages are scheduled first, so messages of different lengths can be mixed freely.
+	/// The digests are those of the sequential mode; the parallel (tree hashing) setting and the current state of this instance are not used or modified.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The messages to hash</param>
+	/// <param name="Output">Receives the 64 byte digest of each message, in the order of the Input messages</param>
+	void ComputeBatch(const std::vector<std::vector<byte>> &Input, std::vector<std::vector<byte>> &Output);
+
+	/// <summary>
+	/// Compute the standard SHA-512 digest of each message in a batch of messages in caller owned memory.
+	/// <para>The digests are written contiguously, the digest of message i is at OutOffset + (i * 64).</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">Pointers to the messages; each must reference at least the corresponding Length bytes</param>
+	/// <param name="Length">The length of each message in bytes</param>
+	/// <param name="Output">The output array; must be at least OutOffset + (Input.size() * 64) bytes long</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	void ComputeBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset);
+
 	/// <summary>
 	/// Finalize processing and get the hash code
 	/// </summary>
@@ -281,11 +304,26 @@ public:
 	/// <param name="Length">The number of message bytes to process</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the digest with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
 	void Destroy();
+	void HashBatch(const byte* Input, size_t Length, std::vector<byte> &Output, size_t OutOffset);
 	void HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, SHA512State &State);
-	void ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, SHA512State &State, ulong Length);
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
+	template <size_t LANES>
+	void ProcessBatch(const std::vector<const byte*> &Input, const std::vector<size_t> &Length, std::vector<byte> &Output, size_t OutOffset);
+	template <typename Array>
+	void ProcessLeaf(const Array &Input, size_t InOffset, SHA512State &State, ulong Length);
+	static size_t PadBatch(const byte* Input, size_t Length, std::array<byte, 2 * BLOCK_SIZE> &Output);
 };
 
 NAMESPACE_DIGESTEND
@@ -102,6 +102,40 @@ size_t SHAKE::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Lengt
 	return Length;
 }
 
+void SHAKE::GenerateBatch(const std::vector<std::vector<byte>> &Key, std::vector<std::vector<byte>> &Output, size_t Length)
+{
+	std::vector<const byte*> keyPtr(Key.size());
+	std::vector<size_t> keyLen(Key.size());
+	std::vector<byte> otp(Key.size() * Length);
+
+	for (size_t i = 0; i < Key.size(); ++i)
+	{
+		keyPtr[i] = Key[i].data();
+		keyLen[i] = Key[i].size();
+	}
+
+	GenerateBatch(keyPtr, keyLen, otp, 0, Length);
+	Output.resize(Key.size());
+
+	for (size_t i = 0; i < Key.size(); ++i)
+	{
+		Output[i].resize(Length);
+
+		if (Length != 0)
+		{
+			MemUtils::Copy(otp, i * Length, Output[i], 0, Length);
+		}
+	}
+}
+
+void SHAKE::GenerateBatch(const std::vector<const byte*> &Key, const std::vector<size_t> &KeyLength, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	CexAssert(Key.size() == KeyLength.size(), "The key and length counts must be equal");
+	CexAssert(Output.size() - OutOffset >= Key.size() * Length, "The Output buffer is too short!");
+
+	Digest::Keccak::PermuteBatch(Key, KeyLength, Output, OutOffset, Length, m_blockSize, SHAKE_DOMAIN, (m_shakeMode == ShakeModes::SHAKE1024) ? 48 : 24, true);
+}
+
 void SHAKE::Initialize(ISymmetricKey &GenParam)
 {
 	if (GenParam.Nonce().size() != 0)
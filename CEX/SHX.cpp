@@ -1,4 +1,5 @@
 #include "SHX.h"
+#include "ArraySpan.h"
 #include "Serpent.h"
 #include "DigestFromName.h"
 #include "HKDF.h"
@@ -277,6 +278,66 @@ void SHX::Transform2048(const std::vector<byte> &Input, const size_t InOffset, s
 	}
 }
 
+void SHX::Transform(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt128(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt128(inp, 0, otp, 0);
+	}
+}
+
+void SHX::Transform512(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 4 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 4 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt512(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt512(inp, 0, otp, 0);
+	}
+}
+
+void SHX::Transform1024(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 8 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 8 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt1024(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt1024(inp, 0, otp, 0);
+	}
+}
+
+void SHX::Transform2048(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 16 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 16 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt2048(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt2048(inp, 0, otp, 0);
+	}
+}
+
 //~~~Key Schedule~~~//
 
 void SHX::ExpandKey(const std::vector<byte> &Key)
@@ -423,7 +484,8 @@ void SHX::StandardExpand(const std::vector<byte> &Key)
 
 //~~~Rounds Processing~~~//
 
-void SHX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void SHX::Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = 4;
 	size_t keyCtr = m_expKey.size();
@@ -515,7 +577,8 @@ void SHX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::IntUtils::Le32ToBytes(R0 ^ m_expKey[keyCtr - 4], Output, OutOffset);
 }
 
-void SHX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void SHX::Decrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
 	SHXDecryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey);
@@ -527,7 +590,8 @@ void SHX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 #endif
 }
 
-void SHX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void SHX::Decrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if (!defined(__AVX512__)) && defined(__AVX2__)
 	SHXDecryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey);
@@ -546,7 +610,8 @@ void SHX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std
 #endif
 }
 
-void SHX::Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void SHX::Decrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if defined(__AVX512__)
 	SHXDecryptW<Numeric::UInt512>(Input, InOffset, Output, OutOffset, m_expKey);
@@ -578,7 +643,8 @@ void SHX::Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std
 #endif
 }
 
-void SHX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void SHX::Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = m_expKey.size() - 4;
 	size_t keyCtr = 0;
@@ -663,7 +729,8 @@ void SHX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::IntUtils::Le32ToBytes(m_expKey[keyCtr + 3] ^ R3, Output, OutOffset + 12);
 }
 
-void SHX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void SHX::Encrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__)
 	SHXEncryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey);
@@ -675,7 +742,8 @@ void SHX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 #endif
 }
 
-void SHX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void SHX::Encrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if (!defined(__AVX512__)) && defined(__AVX2__)
 	SHXEncryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey);
@@ -694,7 +762,8 @@ void SHX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std
 #endif
 }
 
-void SHX::Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void SHX::Encrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if defined(__AVX512__)
 	SHXEncryptW<Numeric::UInt512>(Input, InOffset, Output, OutOffset, m_expKey);
@@ -108,6 +108,8 @@ private:
 	static const std::string SIGMA_INFO;
 	static const std::string TAU_INFO;
 
+	std::vector<byte> m_ctrBuffer;
+	size_t m_ctrOffset;
 	std::vector<uint> m_ctrVector;
 	std::vector<byte> m_dstCode;
 	bool m_isDestroyed;
@@ -241,6 +243,16 @@ public:
 	/// <param name="Degree">The desired number of threads</param>
 	void ParallelMaxDegree(size_t Degree) override;
 
+	/// <summary>
+	/// Position the key stream at a byte offset.
+	/// <para>The counter is calculated directly from the block count and the offset, so seeking costs the same as a sequential transform.
+	/// If the offset is not aligned to the block size, the key stream block containing the offset is generated, and its remaining bytes are used by the next call to Transform.
+	/// The sequential and parallel transforms continue from the new position. Initialize(ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="ByteOffset">The offset in bytes from the start of the key stream</param>
+	void Seek(ulong ByteOffset);
+
 	/// <summary>
 	/// Encrypt/Decrypt one block of bytes
 	/// </summary>
@@ -271,11 +283,27 @@ public:
 	/// <param name="Length">Number of bytes to process</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// <see cref="Initialize(SymmetricKey)"/> must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
 private:
 
 	void Expand(const std::vector<byte> &Key, const std::vector<byte> &Iv);
-	void Generate(std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Counter, const size_t Length);
-	void Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+	template <typename Array>
+	void Generate(Array &Output, const size_t OutOffset, std::vector<uint> &Counter, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	size_t ProcessPartial(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
 	void Reset();
 	void Scope();
 };
@@ -1,6 +1,6 @@
 #include "SecureStream.h"
 #include "ArrayUtils.h"
-#include "CTR.h"
+#include "BlockCipherFromName.h"
 #include "SHA512.h"
 #include "SymmetricKey.h"
 #include "SysUtils.h"
@@ -13,17 +13,28 @@ const std::string SecureStream::CLASS_NAME("SecureStream");
 
 SecureStream::SecureStream()
 	:
+	m_cipherEngine(nullptr),
+	m_cipherNonce(BLOCK_SIZE),
 	m_isDestroyed(false),
 	m_keySalt(0),
+	m_keyStream(PAGE_SIZE),
+	m_pageBuffer(PAGE_SIZE),
+	m_pageVersions(0),
 	m_streamData(0),
 	m_streamPosition(0)
 {
+	LoadKey();
 }
 
 SecureStream::SecureStream(size_t Length, ulong KeySalt)
 	:
+	m_cipherEngine(nullptr),
+	m_cipherNonce(BLOCK_SIZE),
 	m_isDestroyed(false),
-	m_keySalt(KeySalt),
+	m_keySalt(0),
+	m_keyStream(PAGE_SIZE),
+	m_pageBuffer(PAGE_SIZE),
+	m_pageVersions(0),
 	m_streamData(0),
 	m_streamPosition(0)
 {
@@ -34,12 +45,18 @@ SecureStream::SecureStream(size_t Length, ulong KeySalt)
 	}
 
 	m_streamData.reserve(Length);
+	LoadKey();
 }
 
 SecureStream::SecureStream(const std::vector<byte> &Data, ulong KeySalt)
 	:
+	m_cipherEngine(nullptr),
+	m_cipherNonce(BLOCK_SIZE),
 	m_isDestroyed(false),
-	m_keySalt(KeySalt),
+	m_keySalt(0),
+	m_keyStream(PAGE_SIZE),
+	m_pageBuffer(PAGE_SIZE),
+	m_pageVersions(0),
 	m_streamData(Data),
 	m_streamPosition(0)
 {
@@ -49,13 +66,19 @@ SecureStream::SecureStream(const std::vector<byte> &Data, ulong KeySalt)
 		Utility::MemUtils::CopyFromValue(KeySalt, m_keySalt, 0, sizeof(ulong));
 	}
 
-	Transform();
+	LoadKey();
+	Encrypt();
 }
 
 SecureStream::SecureStream(std::vector<byte> &Data, size_t Offset, size_t Length, ulong KeySalt)
 	:
+	m_cipherEngine(nullptr),
+	m_cipherNonce(BLOCK_SIZE),
 	m_isDestroyed(false),
-	m_keySalt(KeySalt),
+	m_keySalt(0),
+	m_keyStream(PAGE_SIZE),
+	m_pageBuffer(PAGE_SIZE),
+	m_pageVersions(0),
 	m_streamData(0),
 	m_streamPosition(0)
 {
@@ -70,7 +93,8 @@ SecureStream::SecureStream(std::vector<byte> &Data, size_t Offset, size_t Length
 		Utility::MemUtils::CopyFromValue(KeySalt, m_keySalt, 0, sizeof(ulong));
 	}
 
-	Transform();
+	LoadKey();
+	Encrypt();
 }
 
 SecureStream::~SecureStream()
@@ -120,14 +144,22 @@ const ulong SecureStream::Position()
 void SecureStream::Close()
 {
 	m_streamData.clear();
+	m_pageVersions.clear();
 	m_streamPosition = 0;
 }
 
 void SecureStream::CopyTo(IByteStream* Destination)
 {
-	Transform();
-	Destination->Write(m_streamData, 0, m_streamData.size());
-	Transform();
+	for (size_t i = 0; i < m_streamData.size(); i += PAGE_SIZE)
+	{
+		const size_t PGELEN = Utility::IntUtils::Min(PAGE_SIZE, m_streamData.size() - i);
+
+		Utility::MemUtils::Copy(m_streamData, i, m_pageBuffer, 0, PGELEN);
+		Transform(i / PAGE_SIZE, 0, m_pageBuffer, 0, PGELEN);
+		Destination->Write(m_pageBuffer, 0, PGELEN);
+	}
+
+	Utility::MemUtils::Clear(m_pageBuffer, 0, m_pageBuffer.size());
 }
 
 void SecureStream::Destroy()
@@ -136,25 +168,51 @@ void SecureStream::Destroy()
 	{
 		m_isDestroyed = true;
 		m_streamPosition = 0;
+
+		if (m_cipherEngine != nullptr)
+		{
+			m_cipherEngine.reset(nullptr);
+		}
+
+		Utility::IntUtils::ClearVector(m_cipherNonce);
+		Utility::IntUtils::ClearVector(m_keySalt);
+		Utility::IntUtils::ClearVector(m_keyStream);
+		Utility::IntUtils::ClearVector(m_pageBuffer);
+		Utility::IntUtils::ClearVector(m_pageVersions);
 		Utility::IntUtils::ClearVector(m_streamData);
 	}
 }
 
 size_t SecureStream::Read(std::vector<byte> &Output, size_t Offset, size_t Length)
 {
-	if (Offset + Length > m_streamData.size() - m_streamPosition)
+	CexAssert(Offset + Length <= Output.size(), "length is longer than the array size");
+
+	if (m_streamPosition >= m_streamData.size())
+	{
+		return 0;
+	}
+
+	if (Length > m_streamData.size() - m_streamPosition)
 	{
-		Length = m_streamData.size() - m_streamPosition;
+		Length = static_cast<size_t>(m_streamData.size() - m_streamPosition);
 	}
 
-	if (Length > 0)
+	size_t prcLen = 0;
+
+	// decrypt only the bytes being copied, the stream state is not modified
+	while (prcLen != Length)
 	{
-		Transform();
-		Utility::MemUtils::Copy(m_streamData, m_streamPosition, Output, Offset, Length);
-		Transform();
-		m_streamPosition += Length;
+		const size_t STMPOS = static_cast<size_t>(m_streamPosition) + prcLen;
+		const size_t PGEOFT = STMPOS % PAGE_SIZE;
+		const size_t CPYLEN = Utility::IntUtils::Min(PAGE_SIZE - PGEOFT, Length - prcLen);
+
+		Utility::MemUtils::Copy(m_streamData, STMPOS, Output, Offset + prcLen, CPYLEN);
+		Transform(STMPOS / PAGE_SIZE, PGEOFT, Output, Offset + prcLen, CPYLEN);
+		prcLen += CPYLEN;
 	}
 
+	m_streamPosition += Length;
+
 	return Length;
 }
 
@@ -162,19 +220,17 @@ byte SecureStream::ReadByte()
 {
 	CexAssert(m_streamData.size() - m_streamPosition >= 1, "Stream capacity exceeded");
 
-	byte data = 0;
-	Transform();
-	Utility::MemUtils::CopyToValue(m_streamData, m_streamPosition, data, 1);
-	Transform();
-	m_streamPosition += 1;
+	std::vector<byte> data(1);
+	Read(data, 0, 1);
 
-	return data;
+	return data[0];
 }
 
 void SecureStream::Reset()
 {
 	m_streamData.clear();
 	m_streamData.resize(0);
+	m_pageVersions.clear();
 	m_streamPosition = 0;
 }
 
@@ -206,9 +262,12 @@ std::vector<byte> SecureStream::ToArray()
 		return std::vector<byte>(0);
 	}
 
-	Transform();
 	std::vector<byte> tmp = m_streamData;
-	Transform();
+
+	for (size_t i = 0; i < tmp.size(); i += PAGE_SIZE)
+	{
+		Transform(i / PAGE_SIZE, 0, tmp, i, Utility::IntUtils::Min(PAGE_SIZE, tmp.size() - i));
+	}
 
 	return tmp;
 }
@@ -217,37 +276,82 @@ void SecureStream::Write(const std::vector<byte> &Input, size_t Offset, size_t L
 {
 	CexAssert(Offset + Length <= Input.size(), "length is longer than the array size");
 
-	size_t len = m_streamPosition + Length;
-	if (m_streamData.capacity() - m_streamPosition < Length)
+	if (Length == 0)
 	{
-		m_streamData.reserve(len);
+		return;
 	}
-	if (m_streamData.size() < len)
+
+	const size_t OLDLEN = m_streamData.size();
+	const size_t STRPOS = static_cast<size_t>(m_streamPosition);
+	const size_t ENDPOS = STRPOS + Length;
+
+	if (ENDPOS > OLDLEN)
 	{
-		m_streamData.resize(len);
+		if (m_streamData.capacity() < ENDPOS)
+		{
+			m_streamData.reserve(Utility::IntUtils::Max(ENDPOS, m_streamData.capacity() * 2));
+		}
+
+		m_streamData.resize(ENDPOS);
+		m_pageVersions.resize((ENDPOS + PAGE_SIZE - 1) / PAGE_SIZE, 0);
 	}
 
-	Transform();
-	Utility::MemUtils::Copy(Input, Offset, m_streamData, m_streamPosition, Length);
-	Transform();
-	m_streamPosition += Length;
-}
+	// a gap between the old length and the write position is zero filled, so it is encrypted along with the written pages
+	const size_t FSTPOS = Utility::IntUtils::Min(STRPOS, OLDLEN);
 
-void SecureStream::WriteByte(byte Value)
-{
-	if (m_streamData.size() - m_streamPosition < 1)
+	for (size_t i = FSTPOS / PAGE_SIZE; i * PAGE_SIZE < ENDPOS; ++i)
 	{
-		m_streamData.resize(m_streamData.size() + 1);
+		const size_t PGEPOS = i * PAGE_SIZE;
+		const size_t PGELEN = Utility::IntUtils::Min(PAGE_SIZE, m_streamData.size() - PGEPOS);
+		const size_t CPYSTR = Utility::IntUtils::Max(STRPOS, PGEPOS);
+		const size_t CPYEND = Utility::IntUtils::Min(ENDPOS, PGEPOS + PGELEN);
+		const size_t RETLEN = (OLDLEN > PGEPOS) ? Utility::IntUtils::Min(PGELEN, OLDLEN - PGEPOS) : 0;
+
+		// decrypt the retained bytes, unless the page is entirely overwritten
+		if (RETLEN != 0 && (CPYSTR != PGEPOS || CPYEND != PGEPOS + PGELEN))
+		{
+			Utility::MemUtils::Copy(m_streamData, PGEPOS, m_pageBuffer, 0, RETLEN);
+			Transform(i, 0, m_pageBuffer, 0, RETLEN);
+		}
+
+		if (RETLEN < PGELEN)
+		{
+			Utility::MemUtils::Clear(m_pageBuffer, RETLEN, PGELEN - RETLEN);
+		}
+
+		if (CPYEND > CPYSTR)
+		{
+			Utility::MemUtils::Copy(Input, Offset + (CPYSTR - STRPOS), m_pageBuffer, CPYSTR - PGEPOS, CPYEND - CPYSTR);
+		}
+
+		// a rewritten page is encrypted under a new counter space
+		++m_pageVersions[i];
+		Transform(i, 0, m_pageBuffer, 0, PGELEN);
+		Utility::MemUtils::Copy(m_pageBuffer, 0, m_streamData, PGEPOS, PGELEN);
 	}
 
-	Transform();
-	Utility::MemUtils::CopyFromValue(Value, m_streamData, m_streamPosition, 1);
-	Transform();
-	m_streamPosition += 1;
+	Utility::MemUtils::Clear(m_pageBuffer, 0, m_pageBuffer.size());
+	m_streamPosition = ENDPOS;
+}
+
+void SecureStream::WriteByte(byte Value)
+{
+	std::vector<byte> data(1, Value);
+	Write(data, 0, 1);
 }
 
 //~~~Private Functions~~~//
 
+void SecureStream::Encrypt()
+{
+	m_pageVersions.resize((m_streamData.size() + PAGE_SIZE - 1) / PAGE_SIZE, 0);
+
+	for (size_t i = 0; i < m_streamData.size(); i += PAGE_SIZE)
+	{
+		Transform(i / PAGE_SIZE, 0, m_streamData, i, Utility::IntUtils::Min(PAGE_SIZE, m_streamData.size() - i));
+	}
+}
+
 std::vector<byte> SecureStream::GetSystemKey()
 {
 	std::vector<byte> state(0);
@@ -269,25 +373,78 @@ std::vector<byte> SecureStream::GetSystemKey()
 	return hash;
 }
 
-void SecureStream::Transform()
+void SecureStream::LoadKey()
 {
-	if (m_streamData.size() != 0)
+	std::vector<byte> seed = GetSystemKey();
+	std::vector<byte> key(KEY_SIZE);
+
+	Utility::MemUtils::Copy(seed, 0, key, 0, KEY_SIZE);
+	Utility::MemUtils::Copy(seed, KEY_SIZE, m_cipherNonce, 0, BLOCK_SIZE);
+	Key::Symmetric::SymmetricKey kp(key);
+
+	// AES256, the key schedule is expanded once and used for every page
+	m_cipherEngine.reset(Helper::BlockCipherFromName::GetInstance(Enumeration::BlockCiphers::Rijndael, Enumeration::Digests::None));
+	m_cipherEngine->Initialize(true, kp);
+
+	Utility::IntUtils::ClearVector(key);
+	Utility::IntUtils::ClearVector(seed);
+}
+
+void SecureStream::Transform(size_t Page, size_t PageOffset, std::vector<byte> &Buffer, size_t BufOffset, size_t Length)
+{
+	if (Length == 0)
+	{
+		return;
+	}
+
+	const size_t FSTBLK = PageOffset / BLOCK_SIZE;
+	const size_t BLKCNT = ((PageOffset + Length - 1) / BLOCK_SIZE) - FSTBLK + 1;
+	const ulong PGEIDX = static_cast<ulong>(Page);
+	const uint PGEVER = m_pageVersions[Page];
+
+	// the counter block is the nonce xor (page index || page version || block index)
+	for (size_t i = 0; i < BLKCNT; ++i)
+	{
+		const size_t CTROFT = i * BLOCK_SIZE;
+		const uint BLKIDX = static_cast<uint>(FSTBLK + i);
+
+		Utility::MemUtils::Copy(m_cipherNonce, 0, m_keyStream, CTROFT, BLOCK_SIZE);
+
+		for (size_t j = 0; j < sizeof(ulong); ++j)
+		{
+			m_keyStream[CTROFT + j] ^= static_cast<byte>(PGEIDX >> (8 * j));
+		}
+
+		for (size_t j = 0; j < sizeof(uint); ++j)
+		{
+			m_keyStream[CTROFT + 8 + j] ^= static_cast<byte>(PGEVER >> (8 * j));
+			m_keyStream[CTROFT + 12 + j] ^= static_cast<byte>(BLKIDX >> (8 * j));
+		}
+	}
+
+	size_t prcLen = 0;
+	const size_t KSTLEN = BLKCNT * BLOCK_SIZE;
+
+	while (KSTLEN - prcLen >= 16 * BLOCK_SIZE)
 	{
-		std::vector<byte> seed = GetSystemKey();
-		std::vector<byte> key(32);
-		std::vector<byte> iv(16);
-
-		Utility::MemUtils::Copy(seed, 0, key, 0, key.size());
-		Utility::MemUtils::Copy(seed, key.size(), iv, 0, iv.size());
-		Key::Symmetric::SymmetricKey kp(key, iv);
-
-		// AES256-CTR
-		Cipher::Symmetric::Block::Mode::CTR cpr(Enumeration::BlockCiphers::Rijndael);
-		cpr.Initialize(true, kp);
-		std::vector<byte> state(m_streamData.size());
-		cpr.Transform(m_streamData, 0, state, 0, state.size());
-		m_streamData = state;
+		m_cipherEngine->Transform2048(m_keyStream, prcLen, m_keyStream, prcLen);
+		prcLen += 16 * BLOCK_SIZE;
 	}
+
+	while (KSTLEN - prcLen >= 4 * BLOCK_SIZE)
+	{
+		m_cipherEngine->Transform512(m_keyStream, prcLen, m_keyStream, prcLen);
+		prcLen += 4 * BLOCK_SIZE;
+	}
+
+	while (prcLen != KSTLEN)
+	{
+		m_cipherEngine->EncryptBlock(m_keyStream, prcLen, m_keyStream, prcLen);
+		prcLen += BLOCK_SIZE;
+	}
+
+	Utility::MemUtils::XorBlock(m_keyStream, PageOffset % BLOCK_SIZE, Buffer, BufOffset, Length);
+	Utility::MemUtils::Clear(m_keyStream, 0, KSTLEN);
 }
 
 NAMESPACE_IOEND
@@ -2,21 +2,43 @@
 #define CEX_SECURESTREAM_H
 
 #include "IByteStream.h"
+#include "IBlockCipher.h"
 
 NAMESPACE_IO
 
+using Cipher::Symmetric::Block::IBlockCipher;
+
 /// <summary>
 /// A secure memory stream container.
 /// <para>Manipulate a byte array through a streaming interface.
 /// State is encrypted, and only decrypted during read/write operations.</para>
 /// </summary>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The stream is encrypted with AES256 in counter mode, keyed with a hash of the machine and user identity, the process id, and the optional key salt; the key is derived once when the stream is created.</description></item>
+/// <item><description>The state is divided into 4 KB pages, each with its own counter space built from the page index and a page version number.</description></item>
+/// <item><description>Read operations decrypt only the bytes they copy out, and write operations decrypt and re-encrypt only the pages they touch, so the cost of an operation is proportional to its length, not the length of the stream.</description></item>
+/// <item><description>The page version is incremented each time a page is re-encrypted, so a rewritten page never reuses a key stream.</description></item>
+/// </list>
+/// </remarks>
 class SecureStream final : public IByteStream
 {
 private:
+
+	static const size_t BLOCK_SIZE = 16;
 	static const std::string CLASS_NAME;
+	static const size_t KEY_SIZE = 32;
+	static const size_t PAGE_SIZE = 4096;
 
+	std::unique_ptr<IBlockCipher> m_cipherEngine;
+	std::vector<byte> m_cipherNonce;
 	bool m_isDestroyed;
 	std::vector<byte> m_keySalt;
+	std::vector<byte> m_keyStream;
+	std::vector<byte> m_pageBuffer;
+	std::vector<uint> m_pageVersions;
 	std::vector<byte> m_streamData;
 	ulong m_streamPosition;
 
@@ -189,8 +211,10 @@ public:
 
 private:
 
+	void Encrypt();
 	std::vector<byte> GetSystemKey();
-	void Transform();
+	void LoadKey();
+	void Transform(size_t Page, size_t PageOffset, std::vector<byte> &Buffer, size_t BufOffset, size_t Length);
 };
 
 NAMESPACE_IOEND
@@ -0,0 +1,323 @@
+#include "SegmentedStream.h"
+#include "IntUtils.h"
+
+NAMESPACE_IO
+
+const std::string SegmentedStream::CLASS_NAME("SegmentedStream");
+
+//~~~Constructor~~~//
+
+SegmentedStream::SegmentedStream(size_t SegmentSize)
+	:
+	m_isDestroyed(false),
+	m_segmentPool(0),
+	m_segmentSize(SegmentSize != 0 && SegmentSize % 64 == 0 ? SegmentSize :
+		throw CryptoProcessingException("SegmentedStream:CTor", "The segment size must be a non-zero multiple of 64 bytes!")),
+	m_streamSegments(0),
+	m_streamLength(0),
+	m_streamPosition(0)
+{
+}
+
+SegmentedStream::SegmentedStream(const std::vector<byte> &Data, size_t SegmentSize)
+	:
+	m_isDestroyed(false),
+	m_segmentPool(0),
+	m_segmentSize(SegmentSize != 0 && SegmentSize % 64 == 0 ? SegmentSize :
+		throw CryptoProcessingException("SegmentedStream:CTor", "The segment size must be a non-zero multiple of 64 bytes!")),
+	m_streamSegments(0),
+	m_streamLength(0),
+	m_streamPosition(0)
+{
+	if (Data.size() != 0)
+	{
+		Write(Data, 0, Data.size());
+		m_streamPosition = 0;
+	}
+}
+
+SegmentedStream::~SegmentedStream()
+{
+	Destroy();
+}
+
+//~~~Accessors~~~//
+
+const bool SegmentedStream::CanRead()
+{
+	return true;
+}
+
+const bool SegmentedStream::CanSeek()
+{
+	return true;
+}
+
+const bool SegmentedStream::CanWrite()
+{
+	return true;
+}
+
+const StreamModes SegmentedStream::Enumeral()
+{
+	return StreamModes::SegmentedStream;
+}
+
+const ulong SegmentedStream::Length()
+{
+	return m_streamLength;
+}
+
+const std::string SegmentedStream::Name()
+{
+	return CLASS_NAME;
+}
+
+const ulong SegmentedStream::Position()
+{
+	return m_streamPosition;
+}
+
+const size_t SegmentedStream::SegmentCount()
+{
+	return m_streamSegments.size();
+}
+
+const size_t SegmentedStream::SegmentSize()
+{
+	return m_segmentSize;
+}
+
+std::vector<byte> SegmentedStream::ToArray()
+{
+	std::vector<byte> data(static_cast<size_t>(m_streamLength));
+	size_t prcLen = 0;
+
+	for (size_t i = 0; prcLen != data.size(); ++i)
+	{
+		const size_t CPYLEN = Utility::IntUtils::Min(m_segmentSize, data.size() - prcLen);
+		Utility::MemUtils::Copy(m_streamSegments[i], 0, data, prcLen, CPYLEN);
+		prcLen += CPYLEN;
+	}
+
+	return data;
+}
+
+//~~~Public Functions~~~//
+
+void SegmentedStream::Close()
+{
+	Reset();
+}
+
+void SegmentedStream::CopyTo(IByteStream* Destination)
+{
+	ulong prcLen = 0;
+
+	// each segment is written directly, without an intermediate buffer
+	for (size_t i = 0; prcLen != m_streamLength; ++i)
+	{
+		const size_t CPYLEN = static_cast<size_t>(Utility::IntUtils::Min(static_cast<ulong>(m_segmentSize), m_streamLength - prcLen));
+		Destination->Write(m_streamSegments[i], 0, CPYLEN);
+		prcLen += CPYLEN;
+	}
+}
+
+void SegmentedStream::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_streamLength = 0;
+		m_streamPosition = 0;
+
+		for (size_t i = 0; i < m_streamSegments.size(); ++i)
+		{
+			Utility::IntUtils::ClearVector(m_streamSegments[i]);
+		}
+
+		for (size_t i = 0; i < m_segmentPool.size(); ++i)
+		{
+			Utility::IntUtils::ClearVector(m_segmentPool[i]);
+		}
+
+		m_streamSegments.clear();
+		m_segmentPool.clear();
+	}
+}
+
+size_t SegmentedStream::Read(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	CexAssert(Offset + Length <= Output.size(), "Output array length exceeded");
+
+	if (m_streamPosition >= m_streamLength)
+	{
+		return 0;
+	}
+
+	if (Length > m_streamLength - m_streamPosition)
+	{
+		Length = static_cast<size_t>(m_streamLength - m_streamPosition);
+	}
+
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		const size_t SEGIDX = static_cast<size_t>(m_streamPosition / m_segmentSize);
+		const size_t SEGOFT = static_cast<size_t>(m_streamPosition % m_segmentSize);
+		const size_t CPYLEN = Utility::IntUtils::Min(m_segmentSize - SEGOFT, Length - prcLen);
+
+		Utility::MemUtils::Copy(m_streamSegments[SEGIDX], SEGOFT, Output, Offset + prcLen, CPYLEN);
+		m_streamPosition += CPYLEN;
+		prcLen += CPYLEN;
+	}
+
+	return Length;
+}
+
+byte SegmentedStream::ReadByte()
+{
+	CexAssert(m_streamPosition < m_streamLength, "Stream length exceeded");
+
+	const byte DATA = m_streamSegments[static_cast<size_t>(m_streamPosition / m_segmentSize)][static_cast<size_t>(m_streamPosition % m_segmentSize)];
+	++m_streamPosition;
+
+	return DATA;
+}
+
+void SegmentedStream::Reset()
+{
+	SetLength(0);
+	m_streamPosition = 0;
+}
+
+void SegmentedStream::Seek(ulong Offset, SeekOrigin Origin)
+{
+	if (Origin == SeekOrigin::Begin)
+	{
+		m_streamPosition = Offset;
+	}
+	else if (Origin == SeekOrigin::End)
+	{
+		m_streamPosition = m_streamLength - Offset;
+	}
+	else
+	{
+		m_streamPosition += Offset;
+	}
+}
+
+byte* SegmentedStream::Segment(ulong Offset, size_t &Length)
+{
+	CexAssert(Offset < m_streamLength, "The offset exceeds the stream length");
+
+	const size_t SEGIDX = static_cast<size_t>(Offset / m_segmentSize);
+	const size_t SEGOFT = static_cast<size_t>(Offset % m_segmentSize);
+
+	Length = static_cast<size_t>(Utility::IntUtils::Min(static_cast<ulong>(m_segmentSize - SEGOFT), m_streamLength - Offset));
+
+	return m_streamSegments[SEGIDX].data() + SEGOFT;
+}
+
+void SegmentedStream::SetLength(ulong Length)
+{
+	if (Length > m_streamLength)
+	{
+		// the bytes beyond the stream length are always zero, so extending only adds segments
+		Grow(Length);
+	}
+	else if (Length < m_streamLength)
+	{
+		const size_t SEGCNT = static_cast<size_t>((Length + m_segmentSize - 1) / m_segmentSize);
+
+		// clear the removed bytes in the last retained segment
+		if (Length % m_segmentSize != 0)
+		{
+			const size_t SEGOFT = static_cast<size_t>(Length % m_segmentSize);
+			const size_t CLRLEN = static_cast<size_t>(Utility::IntUtils::Min(static_cast<ulong>(m_segmentSize - SEGOFT), m_streamLength - Length));
+			Utility::MemUtils::Clear(m_streamSegments[SEGCNT - 1], SEGOFT, CLRLEN);
+		}
+
+		Release(SEGCNT);
+	}
+
+	m_streamLength = Length;
+
+	if (m_streamPosition > m_streamLength)
+	{
+		m_streamPosition = m_streamLength;
+	}
+}
+
+void SegmentedStream::Write(const std::vector<byte> &Input, size_t Offset, size_t Length)
+{
+	CexAssert(Offset + Length <= Input.size(), "Input stream length exceeded");
+
+	const ulong TTLLEN = m_streamPosition + Length;
+	size_t prcLen = 0;
+
+	Grow(TTLLEN);
+
+	while (prcLen != Length)
+	{
+		const size_t SEGIDX = static_cast<size_t>(m_streamPosition / m_segmentSize);
+		const size_t SEGOFT = static_cast<size_t>(m_streamPosition % m_segmentSize);
+		const size_t CPYLEN = Utility::IntUtils::Min(m_segmentSize - SEGOFT, Length - prcLen);
+
+		Utility::MemUtils::Copy(Input, Offset + prcLen, m_streamSegments[SEGIDX], SEGOFT, CPYLEN);
+		m_streamPosition += CPYLEN;
+		prcLen += CPYLEN;
+	}
+
+	if (m_streamLength < TTLLEN)
+	{
+		m_streamLength = TTLLEN;
+	}
+}
+
+void SegmentedStream::WriteByte(byte Value)
+{
+	Grow(m_streamPosition + 1);
+	m_streamSegments[static_cast<size_t>(m_streamPosition / m_segmentSize)][static_cast<size_t>(m_streamPosition % m_segmentSize)] = Value;
+	++m_streamPosition;
+
+	if (m_streamLength < m_streamPosition)
+	{
+		m_streamLength = m_streamPosition;
+	}
+}
+
+//~~~Private Functions~~~//
+
+void SegmentedStream::Grow(ulong Length)
+{
+	const size_t SEGCNT = static_cast<size_t>((Length + m_segmentSize - 1) / m_segmentSize);
+
+	while (m_streamSegments.size() < SEGCNT)
+	{
+		// pooled segments were cleared when they were released
+		if (m_segmentPool.size() != 0)
+		{
+			m_streamSegments.push_back(std::move(m_segmentPool.back()));
+			m_segmentPool.pop_back();
+		}
+		else
+		{
+			m_streamSegments.push_back(std::vector<byte>(m_segmentSize));
+		}
+	}
+}
+
+void SegmentedStream::Release(size_t Count)
+{
+	while (m_streamSegments.size() > Count)
+	{
+		std::vector<byte> &seg = m_streamSegments.back();
+		Utility::MemUtils::Clear(seg, 0, seg.size());
+		m_segmentPool.push_back(std::move(seg));
+		m_streamSegments.pop_back();
+	}
+}
+
+NAMESPACE_IOEND
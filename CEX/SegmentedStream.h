@@ -0,0 +1,235 @@
+#ifndef CEX_SEGMENTEDSTREAM_H
+#define CEX_SEGMENTEDSTREAM_H
+
+#include "IByteStream.h"
+
+NAMESPACE_IO
+
+/// <summary>
+/// A segmented memory stream container.
+/// <para>Stores the stream in a list of fixed-size segments, so the stream grows without reallocating or copying the data already written.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Serializing records, and hashing the segments in place:</description>
+/// <code>
+/// SegmentedStream* ss = new SegmentedStream();
+/// for (size_t i = 0; i &lt; records.size(); ++i)
+/// {
+///     ss->Write(records[i], 0, records[i].size());
+/// }
+///
+/// ss->Seek(0, SeekOrigin::Begin);
+/// Processing::DigestStream ds(Enumeration::Digests::SHA256);
+/// // the digest reads the segments directly
+/// std::vector&lt;byte&gt; hash = ds.Compute(ss);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The stream is a list of SegmentSize() byte segments; writing past the end appends segments, so appending is linear in the data written, and the segment list itself grows geometrically.</description></item>
+/// <item><description>Segments released by SetLength, Reset, or Close are cleared and kept in a pool, and are reused before new memory is allocated.</description></item>
+/// <item><description>The Segment(ulong, size_t) function exposes the contiguous bytes of the segment containing an offset; CipherStream and DigestStream use it to process the stream in place, and StreamWriter to gather it with a single allocation.</description></item>
+/// <item><description>The segment size must be a multiple of 64 bytes, so cipher blocks never span a segment boundary.</description></item>
+/// <item><description>ToArray() returns a contiguous copy of the stream.</description></item>
+/// </list>
+/// </remarks>
+class SegmentedStream final : public IByteStream
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const size_t DEF_SEGMENTSIZE = 64 * 1024;
+
+	bool m_isDestroyed;
+	std::vector<std::vector<byte>> m_segmentPool;
+	size_t m_segmentSize;
+	std::vector<std::vector<byte>> m_streamSegments;
+	ulong m_streamLength;
+	ulong m_streamPosition;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	SegmentedStream(const SegmentedStream&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	SegmentedStream& operator=(const SegmentedStream&) = delete;
+
+	/// <summary>
+	/// Initialize this class with the segment size
+	/// </summary>
+	///
+	/// <param name="SegmentSize">The size of each segment in bytes; must be a non-zero multiple of 64, the default is 64 KB</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the segment size is invalid</exception>
+	explicit SegmentedStream(size_t SegmentSize = DEF_SEGMENTSIZE);
+
+	/// <summary>
+	/// Initialize this class with a byte array
+	/// </summary>
+	///
+	/// <param name="Data">The array used to initialize the stream</param>
+	/// <param name="SegmentSize">The size of each segment in bytes; must be a non-zero multiple of 64, the default is 64 KB</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the segment size is invalid</exception>
+	explicit SegmentedStream(const std::vector<byte> &Data, size_t SegmentSize = DEF_SEGMENTSIZE);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~SegmentedStream() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The stream can be read
+	/// </summary>
+	const bool CanRead() override;
+
+	/// <summary>
+	/// Read Only: The stream is seekable
+	/// </summary>
+	const bool CanSeek() override;
+
+	/// <summary>
+	/// Read Only: The stream can be written to
+	/// </summary>
+	const bool CanWrite() override;
+
+	/// <summary>
+	/// Read Only: The stream container type
+	/// </summary>
+	const StreamModes Enumeral() override;
+
+	/// <summary>
+	/// Read Only: The stream length
+	/// </summary>
+	const ulong Length() override;
+
+	/// <summary>
+	/// Read Only: The streams class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: The streams current position
+	/// </summary>
+	const ulong Position() override;
+
+	/// <summary>
+	/// Read Only: The number of segments holding the stream
+	/// </summary>
+	const size_t SegmentCount();
+
+	/// <summary>
+	/// Read Only: The size of each segment in bytes
+	/// </summary>
+	const size_t SegmentSize();
+
+	/// <summary>
+	/// Read Only: A contiguous copy of the stream
+	/// </summary>
+	std::vector<byte> ToArray();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Release the segments to the pool, and reset the length and position to zero
+	/// </summary>
+	void Close() override;
+
+	/// <summary>
+	/// Write the stream to another stream, one segment at a time
+	/// </summary>
+	///
+	/// <param name="Destination">The destination stream</param>
+	void CopyTo(IByteStream* Destination) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Copies a portion of the stream into an output buffer
+	/// </summary>
+	///
+	/// <param name="Output">The output array receiving the bytes</param>
+	/// <param name="Offset">Offset within the output array at which to begin</param>
+	/// <param name="Length">The number of bytes to read</param>
+	///
+	/// <returns>The number of bytes read</returns>
+	size_t Read(std::vector<byte> &Output, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Read a single byte from the stream
+	/// </summary>
+	///
+	/// <returns>The read byte value</returns>
+	byte ReadByte() override;
+
+	/// <summary>
+	/// Release the segments to the pool, and reset the length and position to zero
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Seek to a position within the stream
+	/// </summary>
+	///
+	/// <param name="Offset">The offset position</param>
+	/// <param name="Origin">The starting point</param>
+	void Seek(ulong Offset, SeekOrigin Origin) override;
+
+	/// <summary>
+	/// Get the contiguous bytes of the segment containing a stream offset.
+	/// <para>The pointer is valid until the stream is shortened, reset, or destroyed; writing through it modifies the stream.</para>
+	/// </summary>
+	///
+	/// <param name="Offset">The offset within the stream; must be less than the stream length</param>
+	/// <param name="Length">Receives the number of contiguous bytes available from the offset, bounded by the segment end and the stream length</param>
+	///
+	/// <returns>A pointer to the byte at the offset</returns>
+	byte* Segment(ulong Offset, size_t &Length);
+
+	/// <summary>
+	/// Set the length of the stream.
+	/// <para>Extending the stream appends zeroed segments, shortening it clears the removed bytes and returns the unused segments to the pool.</para>
+	/// </summary>
+	///
+	/// <param name="Length">The desired length</param>
+	void SetLength(ulong Length) override;
+
+	/// <summary>
+	/// Writes an input buffer to the stream
+	/// </summary>
+	///
+	/// <param name="Input">The input array to write to the stream</param>
+	/// <param name="Offset">Offset within the input array at which to begin</param>
+	/// <param name="Length">The number of bytes to write</param>
+	void Write(const std::vector<byte> &Input, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Write a single byte from the stream
+	/// </summary>
+	///
+	/// <param name="Value">The byte value to write</param>
+	void WriteByte(byte Value) override;
+
+private:
+
+	void Grow(ulong Length);
+	void Release(size_t Count);
+};
+
+NAMESPACE_IOEND
+#endif
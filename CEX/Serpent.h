@@ -27,8 +27,8 @@ NAMESPACE_BLOCK
 /// internal
 /// 
 
-template<typename T>
-static void SHXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key)
+template<typename T, typename ArrayA, typename ArrayB>
+static void SHXDecryptW(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, std::vector<uint> &Key)
 {
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
@@ -169,8 +169,8 @@ static void SHXDecryptW(const std::vector<byte> &Input, const size_t InOffset, s
 #endif
 }
 
-template<typename T>
-static void SHXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key)
+template<typename T, typename ArrayA, typename ArrayB>
+static void SHXEncryptW(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, std::vector<uint> &Key)
 {
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
@@ -1,4 +1,5 @@
 #include "Skein256.h"
+#include "ArraySpan.h"
 #include "IntUtils.h"
 #include "ParallelUtils.h"
 #include "Skein.h"
@@ -249,6 +250,40 @@ void Skein256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 {
 	CexAssert(Input.size() - InOffset >= Length, "The Output buffer is too short!");
 
+	Process(Input, InOffset, Length);
+}
+
+void Skein256::Update(const byte* Input, size_t Length)
+{
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+
+	Process(inp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+void Skein256::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<Skein256State> &State, size_t StateOffset)
+{
+	// process message block
+	SkeinUbiTweak::IsFinalBlock(State[StateOffset].T, true);
+	while (Length != 0)
+	{
+		const size_t MSGRMD = (Length >= BLOCK_SIZE) ? BLOCK_SIZE : Length;
+		ProcessBlock(Input, InOffset, State, StateOffset, MSGRMD);
+		Length -= MSGRMD;
+		InOffset += MSGRMD;
+	}
+
+	// finalize block
+	SkeinUbiTweak::StartNewBlockType(State[StateOffset].T, SkeinUbiType::Out);
+	SkeinUbiTweak::IsFinalBlock(State[StateOffset].T, true);
+	std::vector<byte> tmp(BLOCK_SIZE);
+	ProcessBlock(tmp, 0, State, StateOffset, 8);
+}
+
+template <typename Array>
+void Skein256::Process(const Array &Input, size_t InOffset, size_t Length)
+{
 	if (Length != 0)
 	{
 		if (m_parallelProfile.IsParallel())
@@ -348,28 +383,8 @@ void Skein256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 	}
 }
 
-//~~~Private Functions~~~//
-
-void Skein256::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<Skein256State> &State, size_t StateOffset)
-{
-	// process message block
-	SkeinUbiTweak::IsFinalBlock(State[StateOffset].T, true);
-	while (Length != 0)
-	{
-		const size_t MSGRMD = (Length >= BLOCK_SIZE) ? BLOCK_SIZE : Length;
-		ProcessBlock(Input, InOffset, State, StateOffset, MSGRMD);
-		Length -= MSGRMD;
-		InOffset += MSGRMD;
-	}
-
-	// finalize block
-	SkeinUbiTweak::StartNewBlockType(State[StateOffset].T, SkeinUbiType::Out);
-	SkeinUbiTweak::IsFinalBlock(State[StateOffset].T, true);
-	std::vector<byte> tmp(BLOCK_SIZE);
-	ProcessBlock(tmp, 0, State, StateOffset, 8);
-}
-
-void Skein256::ProcessBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<Skein256State> &State, size_t StateOffset, size_t Length)
+template <typename Array>
+void Skein256::ProcessBlock(const Array &Input, size_t InOffset, std::vector<Skein256State> &State, size_t StateOffset, size_t Length)
 {
 	// update length
 	State[StateOffset].Increase(Length);
@@ -389,7 +404,8 @@ void Skein256::ProcessBlock(const std::vector<byte> &Input, size_t InOffset, std
 	}
 }
 
-void Skein256::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, std::vector<Skein256State> &State, size_t StateOffset, ulong Length)
+template <typename Array>
+void Skein256::ProcessLeaf(const Array &Input, size_t InOffset, std::vector<Skein256State> &State, size_t StateOffset, ulong Length)
 {
 	do
 	{
@@ -280,13 +280,25 @@ public:
 	/// <exception cref="CryptoDigestException">Thrown if the input buffer is too short</exception>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the digest with a length of bytes using caller owned memory
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the input data; must reference at least Length bytes</param>
+	/// <param name="Length">The number of bytes to process</param>
+	void Update(const byte* Input, size_t Length) override;
+
 private:
 
 	void HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<Skein256State> &State, size_t StateOffset);
 	void Initialize();
 	void LoadState(Skein256State &State, std::vector<ulong> &Config);
-	void ProcessBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<Skein256State> &State, size_t StateOffset, size_t Length = BLOCK_SIZE);
-	void ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, std::vector<Skein256State> &State, size_t StateOffset, ulong Length);
+	template <typename Array>
+	void Process(const Array &Input, size_t InOffset, size_t Length);
+	template <typename Array>
+	void ProcessBlock(const Array &Input, size_t InOffset, std::vector<Skein256State> &State, size_t StateOffset, size_t Length = BLOCK_SIZE);
+	template <typename Array>
+	void ProcessLeaf(const Array &Input, size_t InOffset, std::vector<Skein256State> &State, size_t StateOffset, ulong Length);
 };
 
 NAMESPACE_DIGESTEND
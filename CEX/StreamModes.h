@@ -25,7 +25,19 @@ enum class StreamModes : byte
 	/// <summary>
 	/// A SecureStream class, provides streaming encrytped memory storage
 	/// </summary>
-	SecureStream = 4
+	SecureStream = 4,
+	/// <summary>
+	/// A MappedFileStream class, provides memory-mapped file access
+	/// </summary>
+	MappedFileStream = 8,
+	/// <summary>
+	/// A SegmentedStream class, provides segmented memory storage
+	/// </summary>
+	SegmentedStream = 16,
+	/// <summary>
+	/// An AsyncFileStream class, provides queued asynchronous file access
+	/// </summary>
+	AsyncFileStream = 32
 };
 
 NAMESPACE_ENUMERATIONEND
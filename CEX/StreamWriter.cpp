@@ -25,6 +25,23 @@ StreamWriter::StreamWriter(MemoryStream &DataStream)
 {
 }
 
+StreamWriter::StreamWriter(SegmentedStream &DataStream)
+	:
+	m_streamState(static_cast<size_t>(DataStream.Length())),
+	m_streamPosition(0)
+{
+	size_t prcLen = 0;
+
+	// copy each segment into the state in place, without gathering the stream into a temporary array
+	while (prcLen != m_streamState.size())
+	{
+		size_t segLen = 0;
+		const byte* segPtr = DataStream.Segment(prcLen, segLen);
+		std::memcpy(m_streamState.data() + prcLen, segPtr, segLen);
+		prcLen += segLen;
+	}
+}
+
 StreamWriter::~StreamWriter()
 {
 	m_streamPosition = 0;
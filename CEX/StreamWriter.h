@@ -4,6 +4,7 @@
 #include "MemoryStream.h"
 #include "IntUtils.h"
 #include "MemUtils.h"
+#include "SegmentedStream.h"
 
 NAMESPACE_IO
 
@@ -57,6 +58,13 @@ public:
 	/// <param name="DataStream">The MemoryStream to write data to</param>
 	explicit StreamWriter(MemoryStream &DataStream);
 
+	/// <summary>
+	/// Constructor: instantiate this class with a SegmentedStream
+	/// </summary>
+	///
+	/// <param name="DataStream">The SegmentedStream to write data to; each segment is copied directly into the writer state</param>
+	explicit StreamWriter(SegmentedStream &DataStream);
+
 	/// <summary>
 	/// Destructor: finalize this class
 	/// </summary>
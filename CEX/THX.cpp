@@ -1,4 +1,5 @@
 #include "THX.h"
+#include "ArraySpan.h"
 #include "Twofish.h"
 #include "DigestFromName.h"
 #include "HKDF.h"
@@ -287,6 +288,66 @@ void THX::Transform2048(const std::vector<byte> &Input, const size_t InOffset, s
 	}
 }
 
+void THX::Transform(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt128(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt128(inp, 0, otp, 0);
+	}
+}
+
+void THX::Transform512(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 4 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 4 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt512(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt512(inp, 0, otp, 0);
+	}
+}
+
+void THX::Transform1024(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 8 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 8 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt1024(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt1024(inp, 0, otp, 0);
+	}
+}
+
+void THX::Transform2048(const byte* Input, byte* Output)
+{
+	const Utility::ArraySpan<const byte> inp(Input, 16 * BLOCK_SIZE);
+	Utility::ArraySpan<byte> otp(Output, 16 * BLOCK_SIZE);
+
+	if (m_isEncryption)
+	{
+		Encrypt2048(inp, 0, otp, 0);
+	}
+	else
+	{
+		Decrypt2048(inp, 0, otp, 0);
+	}
+}
+
 //~~~Key Schedule~~~//
 
 void THX::ExpandKey(const std::vector<byte> &Key)
@@ -442,7 +503,8 @@ void THX::StandardExpand(const std::vector<byte> &Key)
 
 //~~~Rounds Processing~~~//
 
-void THX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void THX::Decrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = 8;
 	uint X2 = Utility::IntUtils::LeBytesTo32(Input, InOffset) ^ m_expKey[4];
@@ -478,7 +540,8 @@ void THX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::IntUtils::Le32ToBytes(X3 ^ m_expKey[keyCtr + 3], Output, OutOffset + 12);
 }
 
-void THX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void THX::Decrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__) && defined(CEX_COMPILER_MSC)
 	THXDecryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
@@ -490,7 +553,8 @@ void THX::Decrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 #endif
 }
 
-void THX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void THX::Decrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if (!defined(__AVX512__)) && defined(__AVX2__) && defined(CEX_COMPILER_MSC)
 	THXDecryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
@@ -509,7 +573,8 @@ void THX::Decrypt1024(const std::vector<byte> &Input, const size_t InOffset, std
 #endif
 }
 
-void THX::Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void THX::Decrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if defined(__AVX512__) && defined(CEX_COMPILER_MSC)
 	THXDecryptW<Numeric::UInt512>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
@@ -541,7 +606,8 @@ void THX::Decrypt2048(const std::vector<byte> &Input, const size_t InOffset, std
 #endif
 }
 
-void THX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void THX::Encrypt128(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 	const size_t RNDCNT = m_expKey.size() - 1;
 	uint X0 = Utility::IntUtils::LeBytesTo32(Input, InOffset) ^ m_expKey[0];
@@ -582,7 +648,8 @@ void THX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::IntUtils::Le32ToBytes(X1, Output, OutOffset + 12);
 }
 
-void THX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void THX::Encrypt512(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if (!defined(__AVX512__)) && (!defined(__AVX2__)) && defined(__AVX__) && defined(CEX_COMPILER_MSC)
 	THXEncryptW<Numeric::UInt128>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
@@ -594,7 +661,8 @@ void THX::Encrypt512(const std::vector<byte> &Input, const size_t InOffset, std:
 #endif
 }
 
-void THX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void THX::Encrypt1024(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if (!defined(__AVX512__)) && defined(__AVX2__) && defined(CEX_COMPILER_MSC)
 	THXEncryptW<Numeric::UInt256>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
@@ -613,7 +681,8 @@ void THX::Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std
 #endif
 }
 
-void THX::Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+template <typename ArrayA, typename ArrayB>
+void THX::Encrypt2048(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset)
 {
 #if defined(__AVX512__) && defined(CEX_COMPILER_MSC)
 	THXEncryptW<Numeric::UInt512>(Input, InOffset, Output, OutOffset, m_expKey, m_sBox);
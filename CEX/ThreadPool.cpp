@@ -0,0 +1,339 @@
+#include "ThreadPool.h"
+#include "ParallelUtils.h"
+
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#elif defined(CEX_OS_LINUX)
+#	include <pthread.h>
+#	include <sched.h>
+#endif
+
+NAMESPACE_UTILITY
+
+//~~~Task Latch~~~//
+
+class ThreadPool::TaskLatch
+{
+private:
+
+	std::mutex m_latchLock;
+	std::condition_variable m_latchSignal;
+	size_t m_taskCount;
+	std::exception_ptr m_taskException;
+
+public:
+
+	explicit TaskLatch(size_t TaskCount)
+		:
+		m_taskCount(TaskCount),
+		m_taskException(nullptr)
+	{
+	}
+
+	void Await()
+	{
+		std::unique_lock<std::mutex> lock(m_latchLock);
+		m_latchSignal.wait(lock, [this]() { return m_taskCount == 0; });
+	}
+
+	void CountDown(std::exception_ptr Exception)
+	{
+		// the signal is sent while holding the lock; the waiting thread owns the latch and may destroy it as soon as the count reaches zero
+		std::lock_guard<std::mutex> lock(m_latchLock);
+
+		if (Exception != nullptr && m_taskException == nullptr)
+		{
+			m_taskException = Exception;
+		}
+
+		--m_taskCount;
+
+		if (m_taskCount == 0)
+		{
+			m_latchSignal.notify_all();
+		}
+	}
+
+	std::exception_ptr Exception()
+	{
+		std::lock_guard<std::mutex> lock(m_latchLock);
+		return m_taskException;
+	}
+
+	bool IsReleased()
+	{
+		std::lock_guard<std::mutex> lock(m_latchLock);
+		return m_taskCount == 0;
+	}
+};
+
+struct ThreadPool::TaskQueue
+{
+	std::mutex QueueLock;
+	std::deque<std::function<void()>> Tasks;
+};
+
+// the pool and queue owned by the current thread; a worker pushes nested tasks onto its own queue
+static thread_local ThreadPool* t_ownerPool = nullptr;
+static thread_local size_t t_queueIndex = 0;
+
+//~~~Constructor~~~//
+
+ThreadPool::ThreadPool(size_t ThreadCount, bool PinThreads)
+	:
+	m_isDestroyed(false),
+	m_nextQueue(0),
+	m_pendingTasks(0),
+	m_poolLock(),
+	m_poolSignal(),
+	m_taskQueues(0),
+	m_workerThreads(0)
+{
+	CexAssert(ThreadCount != 0, "the thread count can not be zero");
+
+	const size_t CORECNT = ParallelUtils::ProcessorCount();
+
+	for (size_t i = 0; i < ThreadCount; ++i)
+	{
+		m_taskQueues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+	}
+
+	for (size_t i = 0; i < ThreadCount; ++i)
+	{
+		m_workerThreads.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+
+		if (PinThreads && CORECNT > 1)
+		{
+			// core zero is left to the calling thread
+			PinThread(m_workerThreads[i], (i + 1) % CORECNT);
+		}
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_poolLock);
+		m_isDestroyed = true;
+	}
+
+	m_poolSignal.notify_all();
+
+	for (size_t i = 0; i < m_workerThreads.size(); ++i)
+	{
+		if (m_workerThreads[i].joinable())
+		{
+			m_workerThreads[i].join();
+		}
+	}
+
+	m_workerThreads.clear();
+	m_taskQueues.clear();
+}
+
+//~~~Accessors~~~//
+
+const size_t ThreadPool::ThreadCount()
+{
+	return m_workerThreads.size();
+}
+
+//~~~Public Functions~~~//
+
+ThreadPool &ThreadPool::Default()
+{
+	static ThreadPool pool((ParallelUtils::ProcessorCount() > 1) ? ParallelUtils::ProcessorCount() - 1 : 1, true);
+
+	return pool;
+}
+
+void ThreadPool::ParallelFor(size_t From, size_t To, const std::function<void(size_t)> &F)
+{
+	if (To <= From)
+	{
+		return;
+	}
+
+	TaskLatch latch(To - From - 1);
+
+	// queue all but the first index, the calling thread processes the first index itself
+	for (size_t i = From + 1; i < To; ++i)
+	{
+		Enqueue([&latch, &F, i]()
+		{
+			std::exception_ptr exc = nullptr;
+
+			try
+			{
+				F(i);
+			}
+			catch (...)
+			{
+				exc = std::current_exception();
+			}
+
+			latch.CountDown(exc);
+		});
+	}
+
+	std::exception_ptr exc = nullptr;
+
+	try
+	{
+		F(From);
+	}
+	catch (...)
+	{
+		exc = std::current_exception();
+	}
+
+	Wait(latch);
+
+	if (exc == nullptr)
+	{
+		exc = latch.Exception();
+	}
+
+	if (exc != nullptr)
+	{
+		std::rethrow_exception(exc);
+	}
+}
+
+void ThreadPool::Submit(const std::function<void()> &F)
+{
+	Enqueue([F]()
+	{
+		try
+		{
+			F();
+		}
+		catch (...)
+		{
+		}
+	});
+}
+
+//~~~Private Functions~~~//
+
+void ThreadPool::Enqueue(std::function<void()> &&Task)
+{
+	const size_t QUEIDX = (t_ownerPool == this) ? t_queueIndex : m_nextQueue.fetch_add(1) % m_taskQueues.size();
+
+	{
+		// the count is raised before the task is visible, so a worker that dequeues the task can not decrement the count below zero;
+		// it is raised under the pool lock so that a worker can not miss the signal between its check and its wait
+		std::lock_guard<std::mutex> lock(m_poolLock);
+		++m_pendingTasks;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_taskQueues[QUEIDX]->QueueLock);
+		m_taskQueues[QUEIDX]->Tasks.push_back(std::move(Task));
+	}
+
+	m_poolSignal.notify_one();
+}
+
+void ThreadPool::PinThread(std::thread &Worker, size_t Core)
+{
+#if defined(CEX_OS_WINDOWS)
+	const size_t MSKBTS = sizeof(DWORD_PTR) * 8;
+	SetThreadAffinityMask(static_cast<HANDLE>(Worker.native_handle()), static_cast<DWORD_PTR>(1) << (Core % MSKBTS));
+#elif defined(CEX_OS_LINUX)
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(Core, &cpuSet);
+	// affinity is a hint; if the core is outside of the process cpu set the thread remains unpinned
+	pthread_setaffinity_np(Worker.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#else
+	// affinity is not supported on this platform
+	(void)Worker;
+	(void)Core;
+#endif
+}
+
+bool ThreadPool::RunPending()
+{
+	const size_t QUECNT = m_taskQueues.size();
+	const size_t QUEIDX = (t_ownerPool == this) ? t_queueIndex : m_nextQueue.load() % QUECNT;
+	std::function<void()> task;
+
+	// check the owned queue first, then steal from the others
+	for (size_t i = 0; i < QUECNT; ++i)
+	{
+		if (TryDequeue((QUEIDX + i) % QUECNT, task))
+		{
+			--m_pendingTasks;
+			task();
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ThreadPool::TryDequeue(size_t Index, std::function<void()> &Task)
+{
+	std::lock_guard<std::mutex> lock(m_taskQueues[Index]->QueueLock);
+	std::deque<std::function<void()>> &tasks = m_taskQueues[Index]->Tasks;
+
+	if (tasks.empty())
+	{
+		return false;
+	}
+
+	if (t_ownerPool == this && t_queueIndex == Index)
+	{
+		// the owner works from the back of its queue, the most recently queued (cache warm) task
+		Task = std::move(tasks.back());
+		tasks.pop_back();
+	}
+	else
+	{
+		// thieves take from the front, the oldest task
+		Task = std::move(tasks.front());
+		tasks.pop_front();
+	}
+
+	return true;
+}
+
+void ThreadPool::Wait(TaskLatch &Latch)
+{
+	// help with queued work until the batch completes; once the queues are empty the remaining tasks are running, so block
+	while (!Latch.IsReleased())
+	{
+		if (!RunPending())
+		{
+			Latch.Await();
+		}
+	}
+}
+
+void ThreadPool::WorkerLoop(size_t Index)
+{
+	t_ownerPool = this;
+	t_queueIndex = Index;
+
+	while (true)
+	{
+		if (RunPending())
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_poolLock);
+		m_poolSignal.wait(lock, [this]() { return m_isDestroyed || m_pendingTasks != 0; });
+
+		if (m_isDestroyed && m_pendingTasks == 0)
+		{
+			break;
+		}
+	}
+
+	t_ownerPool = nullptr;
+}
+
+NAMESPACE_UTILITYEND
@@ -0,0 +1,148 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_THREADPOOL_H
+#define CEX_THREADPOOL_H
+
+#include "CexDomain.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+NAMESPACE_UTILITY
+
+/// <summary>
+/// A persistent work-stealing thread pool.
+/// <para>Worker threads are created once and reused by every parallel call, removing the thread start-up cost paid by a fork-join per transform.
+/// Each worker owns a task queue; a worker pops tasks from the back of its own queue, and steals from the front of the other queues when its own queue is empty.
+/// A thread that waits on a batch of tasks executes queued tasks while it waits, so a task may itself submit and wait on a nested batch without deadlocking the pool.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Process a buffer of 16KB blocks in parallel:</description>
+/// <code>
+/// const size_t CNKCNT = Input.size() / 16384;
+/// ThreadPool::Default().ParallelFor(0, CNKCNT, [&amp;](size_t i)
+/// {
+///     Process(Input, i * 16384, Output, i * 16384, 16384);
+/// });
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <para>The shared instance returned by Default() is created on first use, with one worker per processor core less the calling thread.
+/// Workers of the shared instance are pinned to a processor core, which keeps each worker's cache warm between successive parallel blocks.
+/// An exception thrown by a task is captured, and rethrown to the thread waiting on the batch once every task in the batch has completed.</para>
+/// </remarks>
+class ThreadPool
+{
+private:
+
+	class TaskLatch;
+	struct TaskQueue;
+
+	std::atomic<bool> m_isDestroyed;
+	std::atomic<size_t> m_nextQueue;
+	std::atomic<size_t> m_pendingTasks;
+	std::mutex m_poolLock;
+	std::condition_variable m_poolSignal;
+	std::vector<std::unique_ptr<TaskQueue>> m_taskQueues;
+	std::vector<std::thread> m_workerThreads;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	ThreadPool(const ThreadPool&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	ThreadPool() = delete;
+
+	/// <summary>
+	/// Constructor: instantiate the pool and start the worker threads
+	/// </summary>
+	///
+	/// <param name="ThreadCount">The number of worker threads; must be at least one</param>
+	/// <param name="PinThreads">Set the affinity of each worker thread to a single processor core</param>
+	ThreadPool(size_t ThreadCount, bool PinThreads);
+
+	/// <summary>
+	/// Destructor: signal the workers to exit and join the threads
+	/// </summary>
+	~ThreadPool();
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: The number of worker threads in the pool
+	/// </summary>
+	const size_t ThreadCount();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// The shared thread pool instance used by ParallelUtils
+	/// </summary>
+	///
+	/// <returns>A reference to the process wide thread pool</returns>
+	static ThreadPool &Default();
+
+	/// <summary>
+	/// Execute a function once for each index in a range, and wait until every index has completed
+	/// </summary>
+	///
+	/// <param name="From">The inclusive starting index</param>
+	/// <param name="To">The exclusive ending index</param>
+	/// <param name="F">The function delegate</param>
+	void ParallelFor(size_t From, size_t To, const std::function<void(size_t)> &F);
+
+	/// <summary>
+	/// Queue a function for asynchronous execution on the pool.
+	/// <para>The caller is responsible for synchronizing with the task; exceptions thrown by the task are discarded.</para>
+	/// </summary>
+	///
+	/// <param name="F">The function delegate</param>
+	void Submit(const std::function<void()> &F);
+
+private:
+
+	void Enqueue(std::function<void()> &&Task);
+	void PinThread(std::thread &Worker, size_t Core);
+	bool RunPending();
+	bool TryDequeue(size_t Index, std::function<void()> &Task);
+	void Wait(TaskLatch &Latch);
+	void WorkerLoop(size_t Index);
+};
+
+NAMESPACE_UTILITYEND
+#endif
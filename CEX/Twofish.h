@@ -27,8 +27,8 @@ NAMESPACE_BLOCK
 /// internal
 /// 
 
-template<typename T>
-static void THXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key, std::vector<uint> &Sbox)
+template<typename T, typename ArrayA, typename ArrayB>
+static void THXDecryptW(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, std::vector<uint> &Key, std::vector<uint> &Sbox)
 {
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
@@ -95,8 +95,8 @@ static void THXDecryptW(const std::vector<byte> &Input, const size_t InOffset, s
 #endif
 }
 
-template<typename T>
-static void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key, std::vector<uint> &Sbox)
+template<typename T, typename ArrayA, typename ArrayB>
+static void THXEncryptW(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, std::vector<uint> &Key, std::vector<uint> &Sbox)
 {
 #if defined(__AVX__) || defined(__AVX2__) || defined(__AVX512__)
 
@@ -100,7 +100,7 @@ public:
 	/// <param name="X3">ulong 3</param>
 	explicit ULong256(ulong X0, ulong X1, ulong X2, ulong X3)
 	{
-		ymm = _mm256_set_epi64x(X0, X1, X2, X3);
+		ymm = _mm256_set_epi64x(X3, X2, X1, X0);
 	}
 
 	/// <summary>
@@ -137,7 +137,7 @@ public:
 	/// <param name="X3">uint64 3</param>
 	inline void Load(ulong X0, ulong X1, ulong X2, ulong X3)
 	{
-		ymm = _mm256_set_epi64x(X0, X1, X2, X3);
+		ymm = _mm256_set_epi64x(X3, X2, X1, X0);
 	}
 
 	/// <summary>
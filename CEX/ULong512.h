@@ -75,7 +75,7 @@ public:
 	/// </summary>
 	///
 	/// <param name="Z">The 512bit register</param>
-	explicit UInt128(__m512i const &Z)
+	explicit ULong512(__m512i const &Z)
 	{
 		zmm = Z;
 	}
@@ -106,7 +106,7 @@ public:
 	/// <param name="X7">uint64 7</param>
 	explicit ULong512(ulong X0, ulong X1, ulong X2, ulong X3, ulong X4, ulong X5, ulong X6, ulong X7)
 	{
-		zmm = _mm512_set_epi64(X0, X1, X2, X3, X4, X5, X6, X7);
+		zmm = _mm512_set_epi64(X7, X6, X5, X4, X3, X2, X1, X0);
 	}
 
 	/// <summary>
@@ -147,7 +147,7 @@ public:
 	/// <param name="X7">uint64 7</param>
 	inline void Load(ulong X0, ulong X1, ulong X2, ulong X3, ulong X4, ulong X5, ulong X6, ulong X7)
 	{
-		zmm = _mm512_set_epi64(X0, X1, X2, X3, X4, X5, X6, X7);
+		zmm = _mm512_set_epi64(X7, X6, X5, X4, X3, X2, X1, X0);
 	}
 
 	/// <summary>
@@ -194,7 +194,7 @@ public:
 	/// <param name="X5">uint64 5</param>
 	/// <param name="X6">uint64 6</param>
 	/// <param name="X7">uint64 7</param>
-	inline void Store(ulong X0, ulong &X1, ulong &X2, ulong &X3, ulong &X4, ulong &X5, ulong &X6, ulong &X7) const
+	inline void Store(ulong &X0, ulong &X1, ulong &X2, ulong &X3, ulong &X4, ulong &X5, ulong &X6, ulong &X7) const
 	{
 		std::array<ulong, 8> tmp;
 
@@ -304,7 +304,7 @@ public:
 	inline static ULong512 ShiftRA(const ULong512 &Value, const int Shift)
 	{
 		CexAssert(Shift <= 64, "Shift size is too large");
-		return ULong512(_mm512_sra_epi64(Value, _mm_set1_epi64(Shift)));
+		return ULong512(_mm512_sra_epi64(Value.zmm, _mm_set1_epi64x(Shift)));
 	}
 
 	/// <summary>
@@ -318,7 +318,7 @@ public:
 	inline static ULong512 ShiftRL(const ULong512 &Value, const int Shift)
 	{
 		CexAssert(Shift <= 64, "Shift size is too large");
-		return ULong512(_mm512_srl_epi64(Value, _mm_set1_epi64(Shift)));
+		return ULong512(_mm512_srl_epi64(Value.zmm, _mm_set1_epi64x(Shift)));
 	}
 
 	/// <summary>
@@ -424,7 +424,7 @@ public:
 	/// </summary>
 	inline ULong512 operator -- ()
 	{
-		return ULong512(zmm) - ZMM1();
+		return ULong512(zmm) - ONE();
 	}
 
 	/// <summary>
@@ -654,7 +654,7 @@ public:
 	/// <param name="X">The values to compare</param>
 	inline ULong512 operator > (ULong512 const &X) const
 	{
-		return ULong512(_mm512_cmpgt_epi64_mask(zmm, X.zmm));
+		return ULong512(_mm512_maskz_set1_epi64(_mm512_cmpgt_epi64_mask(zmm, X.zmm), -1));
 	}
 
 	/// <summary>
@@ -664,7 +664,7 @@ public:
 	/// <param name="X">The values to compare</param>
 	inline ULong512 operator < (ULong512 const &X) const
 	{
-		return ULong512(_mm512_cmpgt_epi64_mask(X.zmm, zmm));
+		return ULong512(_mm512_maskz_set1_epi64(_mm512_cmpgt_epi64_mask(X.zmm, zmm), -1));
 	}
 
 	/// <summary>
@@ -694,7 +694,7 @@ public:
 	/// <param name="X">The values to compare</param>
 	inline ULong512 operator == (ULong512 const &X) const
 	{
-		return ULong512(_mm512_cmpeq_epi64_mask(zmm, X.zmm));
+		return ULong512(_mm512_maskz_set1_epi64(_mm512_cmpeq_epi64_mask(zmm, X.zmm), -1));
 	}
 
 	/// <summary>
@@ -702,7 +702,7 @@ public:
 	/// </summary>
 	inline ULong512 operator ! () const
 	{
-		return ULong512(_mm512_cmpeq_epi64(zmm, _mm512_setzero_si512()));
+		return ULong512(_mm512_maskz_set1_epi64(_mm512_cmpeq_epi64_mask(zmm, _mm512_setzero_si512()), -1));
 	}
 
 	/// <summary>
@@ -712,7 +712,7 @@ public:
 	/// <param name="X">The values to compare</param>
 	inline ULong512 operator != (const ULong512 &X) const
 	{
-		return ~ULong512(_mm512_cmpneq_epi64_mask(zmm, X.zmm));
+		return ULong512(_mm512_maskz_set1_epi64(_mm512_cmpneq_epi64_mask(zmm, X.zmm), -1));
 	}
 
 #endif
@@ -0,0 +1,519 @@
+#include "XTS.h"
+#include "ArraySpan.h"
+#include "BlockCipherFromName.h"
+#include "IntUtils.h"
+#include "ParallelUtils.h"
+#include "SymmetricKey.h"
+#if defined(__AVX__)
+#	include "Intrinsics.h"
+#endif
+
+NAMESPACE_MODE
+
+const std::string XTS::CLASS_NAME("XTS");
+
+//~~~Constructor~~~//
+
+XTS::XTS(BlockCiphers CipherType)
+	:
+	m_blockCipher(CipherType != BlockCiphers::None ? Helper::BlockCipherFromName::GetInstance(CipherType) :
+		throw CryptoCipherModeException("XTS:CTor", "The Cipher type can not be none!")),
+	m_cipherType(CipherType),
+	m_destroyEngine(true),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_sectorNonce(BLOCK_SIZE),
+	m_sectorSize(DEF_SECTORSIZE),
+	m_sectorTweak(BLOCK_SIZE),
+	m_tweakCipher(Helper::BlockCipherFromName::GetInstance(m_blockCipher->Enumeral(), m_blockCipher->KdfEngine(), static_cast<uint>(m_blockCipher->Rounds())))
+{
+	LoadState();
+}
+
+XTS::XTS(IBlockCipher* Cipher)
+	:
+	m_blockCipher(Cipher != nullptr ? Cipher :
+		throw CryptoCipherModeException("XTS:CTor", "The Cipher can not be null!")),
+	m_cipherType(m_blockCipher->Enumeral()),
+	m_destroyEngine(false),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_sectorNonce(BLOCK_SIZE),
+	m_sectorSize(DEF_SECTORSIZE),
+	m_sectorTweak(BLOCK_SIZE),
+	m_tweakCipher(Helper::BlockCipherFromName::GetInstance(m_blockCipher->Enumeral(), m_blockCipher->KdfEngine(), static_cast<uint>(m_blockCipher->Rounds())))
+{
+	LoadState();
+}
+
+XTS::~XTS()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_cipherType = BlockCiphers::None;
+		m_isEncryption = false;
+		m_isInitialized = false;
+		m_parallelProfile.Reset();
+		m_sectorSize = 0;
+
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_sectorNonce);
+		Utility::IntUtils::ClearVector(m_sectorTweak);
+
+		if (m_tweakCipher != nullptr)
+		{
+			m_tweakCipher.reset(nullptr);
+		}
+
+		if (m_destroyEngine)
+		{
+			m_destroyEngine = false;
+
+			if (m_blockCipher != nullptr)
+			{
+				m_blockCipher.reset(nullptr);
+			}
+		}
+		else
+		{
+			if (m_blockCipher != nullptr)
+			{
+				m_blockCipher.release();
+			}
+		}
+	}
+}
+
+//~~~Accessors~~~//
+
+const size_t XTS::BlockSize()
+{
+	return BLOCK_SIZE;
+}
+
+const BlockCiphers XTS::CipherType()
+{
+	return m_cipherType;
+}
+
+IBlockCipher* XTS::Engine()
+{
+	return m_blockCipher.get();
+}
+
+const CipherModes XTS::Enumeral()
+{
+	return CipherModes::XTS;
+}
+
+const bool XTS::IsEncryption()
+{
+	return m_isEncryption;
+}
+
+const bool XTS::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+const bool XTS::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+const std::vector<SymmetricKeySize> &XTS::LegalKeySizes()
+{
+	return m_legalKeySizes;
+}
+
+const std::string XTS::Name()
+{
+	return CLASS_NAME + "-" + m_blockCipher->Name();
+}
+
+const size_t XTS::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+ParallelOptions &XTS::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+size_t &XTS::SectorSize()
+{
+	return m_sectorSize;
+}
+
+//~~~Public Functions~~~//
+
+void XTS::DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	DecryptBlock(Input, 0, Output, 0);
+}
+
+void XTS::DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(!m_isEncryption, "The cipher mode has been initialized for encryption!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+	ProcessSector(Input, InOffset, Output, OutOffset, BLOCK_SIZE, m_sectorTweak);
+	Increase(m_sectorTweak, m_sectorTweak, 1);
+}
+
+void XTS::EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	EncryptBlock(Input, 0, Output, 0);
+}
+
+void XTS::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(m_isEncryption, "The cipher mode has been initialized for decryption!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+	ProcessSector(Input, InOffset, Output, OutOffset, BLOCK_SIZE, m_sectorTweak);
+	Increase(m_sectorTweak, m_sectorTweak, 1);
+}
+
+void XTS::Initialize(bool Encryption, ISymmetricKey &KeyParams)
+{
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size(), KeyParams.Nonce().size()))
+	{
+		throw CryptoSymmetricCipherException("XTS:Initialize", "Invalid key or nonce size! Key and nonce must be one of the LegalKeySizes() members in length.");
+	}
+	if (m_sectorSize < BLOCK_SIZE)
+	{
+		throw CryptoSymmetricCipherException("XTS:Initialize", "The sector size must be at least one block!");
+	}
+	if (m_parallelProfile.IsParallel() && (m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize()))
+	{
+		throw CryptoSymmetricCipherException("XTS:Initialize", "The parallel block size is out of bounds!");
+	}
+	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() % m_parallelProfile.ParallelMinimumSize() != 0)
+	{
+		throw CryptoSymmetricCipherException("XTS:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
+	}
+
+	Scope();
+
+	// the first half of the key is the data key, the second half the tweak key
+	const size_t KEYLEN = KeyParams.Key().size() / 2;
+	std::vector<byte> datKey(KEYLEN);
+	std::vector<byte> twkKey(KEYLEN);
+	Utility::MemUtils::Copy(KeyParams.Key(), 0, datKey, 0, KEYLEN);
+	Utility::MemUtils::Copy(KeyParams.Key(), KEYLEN, twkKey, 0, KEYLEN);
+	Key::Symmetric::SymmetricKey datParams(datKey);
+	Key::Symmetric::SymmetricKey twkParams(twkKey);
+
+	m_blockCipher->Initialize(Encryption, datParams);
+	m_tweakCipher->Initialize(true, twkParams);
+	Utility::IntUtils::ClearVector(datKey);
+	Utility::IntUtils::ClearVector(twkKey);
+
+	m_sectorNonce = KeyParams.Nonce();
+	m_sectorTweak = m_sectorNonce;
+	m_isEncryption = Encryption;
+	m_isInitialized = true;
+}
+
+void XTS::ParallelMaxDegree(size_t Degree)
+{
+	CexAssert(Degree != 0, "parallel degree can not be zero");
+	CexAssert(Degree % 2 == 0, "parallel degree must be an even number");
+	CexAssert(Degree <= m_parallelProfile.ProcessorCount(), "parallel degree can not exceed processor count");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+}
+
+void XTS::Seek(ulong Sector)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+
+	Increase(m_sectorNonce, m_sectorTweak, Sector);
+}
+
+void XTS::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
+
+	Process(Input, InOffset, Output, OutOffset, Length);
+}
+
+void XTS::Transform(const byte* Input, byte* Output, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+
+	const Utility::ArraySpan<const byte> inp(Input, Length);
+	Utility::ArraySpan<byte> otp(Output, Length);
+
+	Process(inp, 0, otp, 0, Length);
+}
+
+//~~~Private Functions~~~//
+
+void XTS::GenerateTweaks(std::vector<byte> &Tweak, std::vector<byte> &Output, const size_t Count)
+{
+	// successive tweaks are the previous tweak multiplied by the primitive element x of GF(2^128)
+#if defined(__AVX__)
+	// the x^128 reduction (0x87) is folded into the low qword when bit 127 is set, and bit 63 is carried into the high qword
+	const __m128i POLY = _mm_set_epi32(0, 1, 0, 0x87);
+	__m128i twk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Tweak.data()));
+
+	for (size_t i = 0; i < Count; ++i)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Output.data() + (i * BLOCK_SIZE)), twk);
+		const __m128i MSK = _mm_srai_epi32(_mm_shuffle_epi32(twk, 0x13), 31);
+		twk = _mm_xor_si128(_mm_add_epi64(twk, twk), _mm_and_si128(MSK, POLY));
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(Tweak.data()), twk);
+#else
+	ulong twkLo = Utility::IntUtils::LeBytesTo64(Tweak, 0);
+	ulong twkHi = Utility::IntUtils::LeBytesTo64(Tweak, 8);
+
+	for (size_t i = 0; i < Count; ++i)
+	{
+		Utility::IntUtils::Le64ToBytes(twkLo, Output, i * BLOCK_SIZE);
+		Utility::IntUtils::Le64ToBytes(twkHi, Output, (i * BLOCK_SIZE) + 8);
+		const ulong CARRY = twkHi >> 63;
+		twkHi = (twkHi << 1) | (twkLo >> 63);
+		twkLo = (twkLo << 1) ^ (0x87 & (0 - CARRY));
+	}
+
+	Utility::IntUtils::Le64ToBytes(twkLo, Tweak, 0);
+	Utility::IntUtils::Le64ToBytes(twkHi, Tweak, 8);
+#endif
+}
+
+void XTS::Increase(const std::vector<byte> &Input, std::vector<byte> &Output, const ulong Length)
+{
+	// the sector tweak is a 128 bit little endian integer
+	const ulong INPLO = Utility::IntUtils::LeBytesTo64(Input, 0);
+	const ulong INPHI = Utility::IntUtils::LeBytesTo64(Input, 8);
+	const ulong OUTLO = INPLO + Length;
+
+	Utility::IntUtils::Le64ToBytes(OUTLO, Output, 0);
+	Utility::IntUtils::Le64ToBytes(INPHI + (OUTLO < INPLO ? 1 : 0), Output, 8);
+}
+
+void XTS::LoadState()
+{
+	// the key is the concatenation of a data key and a tweak key of the same size
+	const std::vector<SymmetricKeySize> &KEYSZE = m_blockCipher->LegalKeySizes();
+	m_legalKeySizes.resize(KEYSZE.size());
+
+	for (size_t i = 0; i < KEYSZE.size(); ++i)
+	{
+		SymmetricKeySize keySize = KEYSZE[i];
+		m_legalKeySizes[i] = SymmetricKeySize(keySize.KeySize() * 2, BLOCK_SIZE, 0);
+	}
+}
+
+template <typename ArrayA, typename ArrayB>
+void XTS::Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length)
+{
+	const size_t SECCNT = Length / m_sectorSize;
+	const size_t RMDLEN = Length - (SECCNT * m_sectorSize);
+
+	CexAssert(RMDLEN == 0 || RMDLEN >= BLOCK_SIZE, "A partial sector must be at least one block!");
+
+	if (m_parallelProfile.IsParallel() && SECCNT > 1)
+	{
+		ProcessParallel(Input, InOffset, Output, OutOffset, SECCNT);
+	}
+	else
+	{
+		for (size_t i = 0; i < SECCNT; ++i)
+		{
+			ProcessSector(Input, InOffset + (i * m_sectorSize), Output, OutOffset + (i * m_sectorSize), m_sectorSize, m_sectorTweak);
+			Increase(m_sectorTweak, m_sectorTweak, 1);
+		}
+	}
+
+	if (RMDLEN != 0)
+	{
+		const size_t SECOFT = SECCNT * m_sectorSize;
+		ProcessSector(Input, InOffset + SECOFT, Output, OutOffset + SECOFT, RMDLEN, m_sectorTweak);
+		Increase(m_sectorTweak, m_sectorTweak, 1);
+	}
+}
+
+template <typename ArrayA, typename ArrayB>
+void XTS::ProcessBlocks(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Tweak)
+{
+	size_t blkCtr = 0;
+
+#if defined(__AVX512__)
+	const size_t AVX512BLK = 16 * BLOCK_SIZE;
+	if (Length >= AVX512BLK)
+	{
+		const size_t PBKALN = Length - (Length % AVX512BLK);
+		std::vector<byte> twkBlk(AVX512BLK);
+		std::vector<byte> tmpBlk(AVX512BLK);
+
+		// 16 blocks with avx512
+		while (blkCtr != PBKALN)
+		{
+			GenerateTweaks(Tweak, twkBlk, 16);
+			Utility::MemUtils::Copy(Input, InOffset + blkCtr, tmpBlk, 0, AVX512BLK);
+			Utility::MemUtils::XorBlock(twkBlk, 0, tmpBlk, 0, AVX512BLK);
+			m_blockCipher->Transform2048(tmpBlk.data(), Output.data() + OutOffset + blkCtr);
+			Utility::MemUtils::XorBlock(twkBlk, 0, Output, OutOffset + blkCtr, AVX512BLK);
+			blkCtr += AVX512BLK;
+		}
+	}
+#elif defined(__AVX2__)
+	const size_t AVX2BLK = 8 * BLOCK_SIZE;
+	if (Length >= AVX2BLK)
+	{
+		const size_t PBKALN = Length - (Length % AVX2BLK);
+		std::vector<byte> twkBlk(AVX2BLK);
+		std::vector<byte> tmpBlk(AVX2BLK);
+
+		// 8 blocks with avx2
+		while (blkCtr != PBKALN)
+		{
+			GenerateTweaks(Tweak, twkBlk, 8);
+			Utility::MemUtils::Copy(Input, InOffset + blkCtr, tmpBlk, 0, AVX2BLK);
+			Utility::MemUtils::XorBlock(twkBlk, 0, tmpBlk, 0, AVX2BLK);
+			m_blockCipher->Transform1024(tmpBlk.data(), Output.data() + OutOffset + blkCtr);
+			Utility::MemUtils::XorBlock(twkBlk, 0, Output, OutOffset + blkCtr, AVX2BLK);
+			blkCtr += AVX2BLK;
+		}
+	}
+#elif defined(__AVX__)
+	const size_t AVXBLK = 4 * BLOCK_SIZE;
+	if (Length >= AVXBLK)
+	{
+		const size_t PBKALN = Length - (Length % AVXBLK);
+		std::vector<byte> twkBlk(AVXBLK);
+		std::vector<byte> tmpBlk(AVXBLK);
+
+		// 4 blocks with avx
+		while (blkCtr != PBKALN)
+		{
+			GenerateTweaks(Tweak, twkBlk, 4);
+			Utility::MemUtils::Copy(Input, InOffset + blkCtr, tmpBlk, 0, AVXBLK);
+			Utility::MemUtils::XorBlock(twkBlk, 0, tmpBlk, 0, AVXBLK);
+			m_blockCipher->Transform512(tmpBlk.data(), Output.data() + OutOffset + blkCtr);
+			Utility::MemUtils::XorBlock(twkBlk, 0, Output, OutOffset + blkCtr, AVXBLK);
+			blkCtr += AVXBLK;
+		}
+	}
+#endif
+
+	std::vector<byte> twkBlk(BLOCK_SIZE);
+	std::vector<byte> tmpBlk(BLOCK_SIZE);
+
+	while (blkCtr != Length)
+	{
+		GenerateTweaks(Tweak, twkBlk, 1);
+		Utility::MemUtils::COPY128(Input, InOffset + blkCtr, tmpBlk, 0);
+		Utility::MemUtils::XOR128(twkBlk, 0, tmpBlk, 0);
+		m_blockCipher->Transform(tmpBlk.data(), Output.data() + OutOffset + blkCtr);
+		Utility::MemUtils::XOR128(twkBlk, 0, Output, OutOffset + blkCtr);
+		blkCtr += BLOCK_SIZE;
+	}
+}
+
+template <typename ArrayA, typename ArrayB>
+void XTS::ProcessParallel(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t SectorCount)
+{
+	const size_t THDCNT = Utility::IntUtils::Min(m_parallelProfile.ParallelMaxDegree(), SectorCount);
+	const size_t SECLEN = m_sectorSize;
+
+	Utility::ParallelUtils::ParallelFor(0, THDCNT, [this, &Input, InOffset, &Output, OutOffset, SectorCount, THDCNT, SECLEN](size_t i)
+	{
+		// each thread processes a contiguous range of sectors
+		const size_t FSTSEC = (SectorCount * i) / THDCNT;
+		const size_t LSTSEC = (SectorCount * (i + 1)) / THDCNT;
+		std::vector<byte> thdSec(BLOCK_SIZE);
+		Increase(m_sectorTweak, thdSec, FSTSEC);
+
+		for (size_t j = FSTSEC; j < LSTSEC; ++j)
+		{
+			this->ProcessSector(Input, InOffset + (j * SECLEN), Output, OutOffset + (j * SECLEN), SECLEN, thdSec);
+			Increase(thdSec, thdSec, 1);
+		}
+	});
+
+	Increase(m_sectorTweak, m_sectorTweak, SectorCount);
+}
+
+template <typename ArrayA, typename ArrayB>
+void XTS::ProcessSector(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length, const std::vector<byte> &Sector)
+{
+	// the first block tweak is the encrypted sector number
+	std::vector<byte> twk(BLOCK_SIZE);
+	m_tweakCipher->EncryptBlock(Sector, twk);
+
+	const size_t RMDLEN = Length % BLOCK_SIZE;
+
+	if (RMDLEN == 0)
+	{
+		ProcessBlocks(Input, InOffset, Output, OutOffset, Length, twk);
+	}
+	else
+	{
+		// the last full block and the partial block are processed with ciphertext stealing
+		const size_t ALNLEN = Length - RMDLEN - BLOCK_SIZE;
+
+		if (ALNLEN != 0)
+		{
+			ProcessBlocks(Input, InOffset, Output, OutOffset, ALNLEN, twk);
+		}
+
+		ProcessStealing(Input, InOffset + ALNLEN, Output, OutOffset + ALNLEN, BLOCK_SIZE + RMDLEN, twk);
+	}
+}
+
+template <typename ArrayA, typename ArrayB>
+void XTS::ProcessStealing(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Tweak)
+{
+	const size_t RMDLEN = Length - BLOCK_SIZE;
+	std::vector<byte> twkBlk(2 * BLOCK_SIZE);
+	std::vector<byte> tmpBlk(BLOCK_SIZE);
+	std::vector<byte> stlBlk(BLOCK_SIZE);
+
+	// encryption uses the tweaks in sequence, decryption processes the last full block with the final tweak
+	GenerateTweaks(Tweak, twkBlk, 2);
+	const size_t FSTOFT = m_isEncryption ? 0 : BLOCK_SIZE;
+	const size_t LSTOFT = m_isEncryption ? BLOCK_SIZE : 0;
+
+	// transform the last full block
+	Utility::MemUtils::COPY128(Input, InOffset, tmpBlk, 0);
+	Utility::MemUtils::XOR128(twkBlk, FSTOFT, tmpBlk, 0);
+	m_blockCipher->Transform(tmpBlk.data(), stlBlk.data());
+	Utility::MemUtils::XOR128(twkBlk, FSTOFT, stlBlk, 0);
+
+	// the partial block borrows the tail of the transformed block
+	Utility::MemUtils::COPY128(stlBlk, 0, tmpBlk, 0);
+	Utility::MemUtils::Copy(Input, InOffset + BLOCK_SIZE, tmpBlk, 0, RMDLEN);
+	Utility::MemUtils::Copy(stlBlk, 0, Output, OutOffset + BLOCK_SIZE, RMDLEN);
+
+	// transform the combined block into the last full block position
+	Utility::MemUtils::XOR128(twkBlk, LSTOFT, tmpBlk, 0);
+	m_blockCipher->Transform(tmpBlk.data(), Output.data() + OutOffset);
+	Utility::MemUtils::XOR128(twkBlk, LSTOFT, Output, OutOffset);
+}
+
+void XTS::Scope()
+{
+	if (!m_parallelProfile.IsDefault())
+	{
+		m_parallelProfile.Calculate();
+	}
+}
+
+NAMESPACE_MODEEND
@@ -0,0 +1,333 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// An implementation of the XEX-based Tweaked-codebook mode with ciphertext Stealing (XTS).
+// Contact: develop@vtdev.com
+
+#ifndef CEX_XTS_H
+#define CEX_XTS_H
+
+#include "ICipherMode.h"
+
+NAMESPACE_MODE
+
+/// <summary>
+/// An implementation of the XEX-based Tweaked-codebook mode with ciphertext Stealing (XTS)
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting a range of 4 KB sectors:</description>
+/// <code>
+/// XTS cipher(BlockCiphers::AHX);
+/// cipher.SectorSize() = 4096;
+/// // the key is the data key followed by the tweak key, the nonce is the tweak of sector zero
+/// cipher.Initialize(true, SymmetricKey(Key, Nonce));
+/// // position the cipher at the first sector to encrypt
+/// cipher.Seek(Sector);
+/// // encrypt 16 consecutive sectors
+/// cipher.Transform(Input, 0, Output, 0, 16 * 4096);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>XTS is a tweakable narrow-block mode designed for storage devices, where each sector (data unit) is encrypted independently and the ciphertext is the same size as the plaintext. \n
+/// Each sector is encrypted under a tweak derived from its sector number, so identical plaintext stored in different sectors produces different ciphertext. \n
+/// The sector tweak is encrypted with a second key, and is multiplied by the primitive element of GF(2^128) for each block within the sector. \n
+/// A sector that is not a multiple of the block size is completed with ciphertext stealing, so a sector may be any length of at least one block.</para>
+///
+/// <description><B>Description:</B></description>
+/// <para><EM>Legend:</EM> \n
+/// <B>C</B>=ciphertext, <B>P</B>=plaintext, <B>K1</B>=data key, <B>K2</B>=tweak key, <B>E</B>=encrypt, <B>i</B>=sector tweak, <B>a</B>=primitive element, <B>^</B>=XOR, <B>*</B>=GF(2^128) multiply \n
+/// <EM>Encryption</EM> \n
+/// T0 ← EK2(i). For 0 ≤ j &lt; m, Cj ← EK1(Pj ^ Tj) ^ Tj, Tj+1 ← Tj * a.</para> \n
+///
+/// <description><B>Multi-Threading:</B></description>
+/// <para>The blocks of a sector are independent once their tweaks are known, so the tweak sequence is computed in batches with 128-bit SIMD doubling, and the blocks are processed 4, 8, or 16 at a time through the block ciphers Transform512, Transform1024, and Transform2048 functions. \n
+/// Sectors are independent of each other, and when a transform spans multiple sectors they are divided among the processor cores.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The key is the concatenation of two block cipher keys of the same size; the first encrypts the data and the second encrypts the tweak, the two halves should be different.</description></item>
+/// <item><description>The nonce is the 16 byte tweak of sector zero, treated as a little endian integer and increased by the sector number; a zero nonce produces the IEEE 1619 data unit sequence numbering.</description></item>
+/// <item><description>SectorSize() sets the data unit size, the default is 4096 bytes; a transform processes consecutive sectors beginning with the current sector, and a trailing partial sector (of at least one block) is processed as a shorter data unit.</description></item>
+/// <item><description>Seek(ulong) positions the cipher at a sector, allowing any sector on a device to be encrypted or decrypted independently.</description></item>
+/// <item><description>The EncryptBlock and DecryptBlock functions process one block as a single block data unit, and advance the sector number.</description></item>
+/// <item><description>A cipher mode constructor can either be initialized with a block cipher instance, or using the block ciphers enumeration name; the tweak cipher is created with the same configuration as the data cipher.</description></item>
+/// <item><description>If the system supports Parallel processing, and IsParallel() is set to true; passing more than one sector to the transform will be auto parallelized.</description></item>
+/// <item><description>Input and Output may reference the same array, sectors can be transformed in place.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>IEEE <a href="http://ieeexplore.ieee.org/document/4493450/">1619-2007</a>: Cryptographic Protection of Data on Block-Oriented Storage Devices.</description></item>
+/// <item><description>NIST <a href="https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38e.pdf">SP800-38E</a>: The XTS-AES Mode for Confidentiality on Storage Devices.</description></item>
+/// <item><description>Efficient Instantiations of Tweakable Blockciphers: <a href="https://www.cs.ucdavis.edu/~rogaway/papers/offsets.pdf">XEX</a>.</description></item>
+/// </list>
+/// </remarks>
+class XTS final : public ICipherMode
+{
+private:
+
+	static const size_t BLOCK_SIZE = 16;
+	static const std::string CLASS_NAME;
+	static const size_t DEF_SECTORSIZE = 4096;
+
+	std::unique_ptr<IBlockCipher> m_blockCipher;
+	BlockCiphers m_cipherType;
+	bool m_destroyEngine;
+	bool m_isDestroyed;
+	bool m_isEncryption;
+	bool m_isInitialized;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_sectorNonce;
+	size_t m_sectorSize;
+	std::vector<byte> m_sectorTweak;
+	std::unique_ptr<IBlockCipher> m_tweakCipher;
+
+public:
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Copy constructor: copy is restricted, this function has been deleted
+	/// </summary>
+	XTS(const XTS&) = delete;
+
+	/// <summary>
+	/// Copy operator: copy is restricted, this function has been deleted
+	/// </summary>
+	XTS& operator=(const XTS&) = delete;
+
+	/// <summary>
+	/// Default constructor: default is restricted, this function has been deleted
+	/// </summary>
+	XTS() = delete;
+
+	/// <summary>
+	/// Initialize the Cipher Mode using a block cipher type name
+	/// </summary>
+	///
+	/// <param name="CipherType">The formal enumeration name of a block cipher</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if an undefined block cipher type name is used</exception>
+	explicit XTS(BlockCiphers CipherType);
+
+	/// <summary>
+	/// Initialize the Cipher Mode using a block cipher instance
+	/// </summary>
+	///
+	/// <param name="Cipher">The uninitialized block cipher instance; can not be null</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a null block cipher is used</exception>
+	explicit XTS(IBlockCipher* Cipher);
+
+	/// <summary>
+	/// Destructor: finalize this class
+	/// </summary>
+	~XTS() override;
+
+	//~~~Accessors~~~//
+
+	/// <summary>
+	/// Read Only: Block size of internal cipher in bytes
+	/// </summary>
+	const size_t BlockSize() override;
+
+	/// <summary>
+	/// Read Only: The block ciphers formal type name
+	/// </summary>
+	const BlockCiphers CipherType() override;
+
+	/// <summary>
+	/// Read Only: The underlying Block Cipher instance
+	/// </summary>
+	IBlockCipher* Engine() override;
+
+	/// <summary>
+	/// Read Only: The cipher modes type name
+	/// </summary>
+	const CipherModes Enumeral() override;
+
+	/// <summary>
+	/// Read Only: True if initialized for encryption, False for decryption
+	/// </summary>
+	const bool IsEncryption() override;
+
+	/// <summary>
+	/// Read Only: The Block Cipher is ready to transform data
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Read Only: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available with this mode.
+	/// If parallel capable, a transform that spans more than one sector is processed across threads.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Read Only: Array of allowed cipher input key byte-sizes; the key sizes are twice the block cipher key sizes
+	/// </summary>
+	const std::vector<SymmetricKeySize> &LegalKeySizes() override;
+
+	/// <summary>
+	/// Read Only: The cipher modes class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Read Only: Parallel block size; the byte-size of the input/output data arrays passed to a transform that trigger parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.</para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Read/Write: Parallel and SIMD capability flags and sizes
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	/// <summary>
+	/// Read/Write: The size of a sector (data unit) in bytes.
+	/// <para>Must be at least the block size, and set before the Initialize function is called. The default is 4096 bytes.</para>
+	/// </summary>
+	size_t &SectorSize();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Decrypt a single block of bytes.
+	/// <para>Decrypts one block as a single block data unit, and advances the sector number.
+	/// Initialize(bool, ISymmetricKey) must be called for decryption before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	void DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Decrypt a block of bytes with offset parameters.
+	/// <para>Decrypts one block as a single block data unit, and advances the sector number.
+	/// Initialize(bool, ISymmetricKey) must be called for decryption before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="InOffset">Starting offset within the Input array</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the Output array</param>
+	void DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Encrypt a single block of bytes.
+	/// <para>Encrypts one block as a single block data unit, and advances the sector number.
+	/// Initialize(bool, ISymmetricKey) must be called for encryption before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	void EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Encrypt a block of bytes using offset parameters.
+	/// <para>Encrypts one block as a single block data unit, and advances the sector number.
+	/// Initialize(bool, ISymmetricKey) must be called for encryption before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Initialize the Cipher instance
+	/// </summary>
+	///
+	/// <param name="Encryption">True if cipher is used for encryption, False to decrypt</param>
+	/// <param name="KeyParams">SymmetricKey containing the data and tweak keys, and the tweak of sector zero</param>
+	///
+	/// <exception cref="CryptoSymmetricCipherException">Thrown if an invalid key or nonce size is used, or the sector size is smaller than a block</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams) override;
+
+	/// <summary>
+	/// Set the maximum number of threads allocated when using multi-threaded processing.
+	/// <para>When set to zero, thread count is set automatically. If set to 1, sets IsParallel() to false and runs in sequential mode.
+	/// Thread count must be an even number, and not exceed the number of processor cores.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Position the cipher at a sector.
+	/// <para>The sector tweak is calculated directly from the initial nonce and the sector number, and the next transform begins with this sector.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Sector">The sector number, relative to the initial nonce</param>
+	void Seek(ulong Sector);
+
+	/// <summary>
+	/// Transform a length of bytes with offset parameters.
+	/// <para>The bytes are processed as consecutive sectors of SectorSize() bytes beginning with the current sector; a trailing partial sector must be at least one block.
+	/// If IsParallel() is set to true, and the length spans more than one sector, the sectors are processed in parallel.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes to transform</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of transformed bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
+
+	/// <summary>
+	/// Transform a length of bytes using caller owned memory.
+	/// <para>The zero-copy equivalent of the offset based transform; the bytes are processed directly at the given addresses.
+	/// Input and Output must each reference at least Length bytes, and may point to the same address.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">A pointer to the input bytes to transform</param>
+	/// <param name="Output">A pointer to the output bytes</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const byte* Input, byte* Output, const size_t Length) override;
+
+private:
+
+	static void GenerateTweaks(std::vector<byte> &Tweak, std::vector<byte> &Output, const size_t Count);
+	static void Increase(const std::vector<byte> &Input, std::vector<byte> &Output, const ulong Length);
+	void LoadState();
+	template <typename ArrayA, typename ArrayB>
+	void Process(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length);
+	template <typename ArrayA, typename ArrayB>
+	void ProcessBlocks(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Tweak);
+	template <typename ArrayA, typename ArrayB>
+	void ProcessParallel(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t SectorCount);
+	template <typename ArrayA, typename ArrayB>
+	void ProcessSector(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length, const std::vector<byte> &Sector);
+	template <typename ArrayA, typename ArrayB>
+	void ProcessStealing(const ArrayA &Input, const size_t InOffset, ArrayB &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Tweak);
+	void Scope();
+};
+
+NAMESPACE_MODEEND
+#endif
@@ -1,18 +1,22 @@
 #include "AEADTest.h"
+#include "../CEX/ChaCha20Poly1305.h"
 #include "../CEX/EAX.h"
 #include "../CEX/GCM.h"
 #include "../CEX/GMAC.h"
 #include "../CEX/OCB.h"
 #include "../CEX/RHX.h"
 #include "../CEX/SecureRandom.h"
+#include <algorithm>
 
 namespace Test
 {
+	using Cipher::Symmetric::Block::Mode::ChaCha20Poly1305;
 	using Cipher::Symmetric::Block::Mode::EAX;
 	using Cipher::Symmetric::Block::Mode::GCM;
 	using Cipher::Symmetric::Block::Mode::OCB;
 	using Cipher::Symmetric::Block::RHX;
 	using Cipher::Symmetric::Block::IBlockCipher;
+	using Exception::CryptoCipherModeException;
 
 	const std::string AEADTest::DESCRIPTION = "Authenticate Encrypt and Associated Data (AEAD) Cipher Mode Tests.";
 	const std::string AEADTest::FAILURE = "FAILURE! ";
@@ -62,6 +66,22 @@ namespace Test
 
 			delete cipher1;
 
+			cipher1 = new EAX(Enumeration::BlockCiphers::Rijndael);
+			RHX* eng1 = new RHX();
+			EAX* ref1 = new EAX(eng1);
+			ReferenceTest(cipher1, ref1);
+			OnProgress(std::string("AEADTest: Passed EAX segmented reference engine tests.."));
+			delete cipher1;
+
+			// the degree is forced, so the parallel segments interleave the mac and the transform regardless of the processor count
+			cipher1 = new EAX(Enumeration::BlockCiphers::Rijndael);
+			cipher1->ParallelProfile().SetMaxDegree(2);
+			ReferenceTest(cipher1, ref1);
+			OnProgress(std::string("AEADTest: Passed EAX interleaved parallel reference engine tests.."));
+			delete ref1;
+			delete eng1;
+			delete cipher1;
+
 			OCB* cipher2 = new OCB(Enumeration::BlockCiphers::Rijndael);
 
 			for (size_t i = EAX_TESTSIZE; i < EAX_TESTSIZE + OCB_TESTSIZE; ++i)
@@ -81,6 +101,15 @@ namespace Test
 
 			delete cipher2;
 
+			cipher2 = new OCB(Enumeration::BlockCiphers::Rijndael);
+			RHX* eng2 = new RHX();
+			OCB* ref2 = new OCB(eng2);
+			ReferenceTest(cipher2, ref2, true);
+			OnProgress(std::string("AEADTest: Passed OCB wide and block reference tests.."));
+			delete ref2;
+			delete eng2;
+			delete cipher2;
+
 			GCM* cipher3 = new GCM(Enumeration::BlockCiphers::Rijndael);
 
 			for (size_t i = EAX_TESTSIZE + OCB_TESTSIZE; i < EAX_TESTSIZE + OCB_TESTSIZE + GCM_TESTSIZE; ++i)
@@ -93,11 +122,49 @@ namespace Test
 			ParallelTest(cipher3);
 			OnProgress(std::string("AEADTest: Passed GCM parallel tests.."));
 
+			ParallelDegreeTest();
+			OnProgress(std::string("AEADTest: Passed GCM parallel hash tests with 2 and 4 threads.."));
+
 			IncrementalCheck(cipher3);
 			OnProgress(std::string("AEADTest: Passed GCM auto incrementing tests.."));
 
+			BatchTest();
+			OnProgress(std::string("AEADTest: Passed GCM packet batch tests.."));
+
+			delete cipher3;
+
+			cipher3 = new GCM(Enumeration::BlockCiphers::Rijndael);
+			RHX* eng3 = new RHX();
+			GCM* ref3 = new GCM(eng3);
+			ReferenceTest(cipher3, ref3);
+			OnProgress(std::string("AEADTest: Passed GCM stitched kernel reference engine tests.."));
+			delete ref3;
+			delete eng3;
 			delete cipher3;
 
+			ChaCha20Poly1305* cipher4 = new ChaCha20Poly1305();
+
+			for (size_t i = EAX_TESTSIZE + OCB_TESTSIZE + GCM_TESTSIZE; i < EAX_TESTSIZE + OCB_TESTSIZE + GCM_TESTSIZE + CHACHAPOLY_TESTSIZE; ++i)
+			{
+				CompareVector(cipher4, m_key[i], m_nonce[i], m_associatedText[i], m_plainText[i], m_cipherText[i], m_expectedCode[i]);
+			}
+			OnProgress(std::string("AEADTest: Passed ChaCha20Poly1305 known answer comparison tests.."));
+
+			StressTest(cipher4);
+			OnProgress(std::string("AEADTest: Passed ChaCha20Poly1305 stress tests.."));
+
+			ParallelTest(cipher4);
+			OnProgress(std::string("AEADTest: Passed ChaCha20Poly1305 parallel tests.."));
+
+			IncrementalCheck(cipher4);
+			OnProgress(std::string("AEADTest: Passed ChaCha20Poly1305 auto incrementing tests.."));
+			MessageLimitTest();
+			OnProgress(std::string("AEADTest: Passed ChaCha20Poly1305 message length limit tests.."));
+			PointerTest();
+			OnProgress(std::string("AEADTest: Passed pointer and vector transform equivalence tests.."));
+
+			delete cipher4;
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -110,6 +177,130 @@ namespace Test
 		}
 	}
 
+	void AEADTest::BatchTest()
+	{
+		const size_t PKTCNT = 60;
+		Prng::SecureRandom rng;
+		// the default engine with 128 and 256 bit keys, and the reference engine
+		RHX eng;
+		GCM gcm128(Enumeration::BlockCiphers::Rijndael);
+		GCM gcm256(Enumeration::BlockCiphers::Rijndael);
+		GCM gcmRhx(&eng);
+		GCM* sessions[3] = { &gcm128, &gcm256, &gcmRhx };
+		std::vector<std::vector<byte>> keys = { std::vector<byte>(16), std::vector<byte>(32), std::vector<byte>(32) };
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			rng.GetBytes(keys[i]);
+			std::vector<byte> nonce(12);
+			rng.GetBytes(nonce);
+			Key::Symmetric::SymmetricKey kp(keys[i], nonce);
+			sessions[i]->Initialize(true, kp);
+		}
+
+		std::vector<std::vector<byte>> assoc(PKTCNT);
+		std::vector<std::vector<byte>> data(PKTCNT);
+		std::vector<std::vector<byte>> enc(PKTCNT);
+		std::vector<std::vector<byte>> nonces(PKTCNT);
+		std::vector<std::vector<byte>> tags(PKTCNT, std::vector<byte>(16));
+		std::vector<GCM::BatchPacket> packets(PKTCNT);
+
+		// packet sized messages; some have no associated data, long nonces, or short tags
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			const size_t MSGLEN = (i == 0) ? 0 : rng.NextUInt32(1500, 1);
+			data[i].resize(MSGLEN);
+			assoc[i].resize((i % 4 == 0) ? 0 : rng.NextUInt32(40, 1));
+			nonces[i].resize((i % 7 == 0) ? 16 : 12);
+
+			if (MSGLEN != 0)
+			{
+				rng.GetBytes(data[i]);
+			}
+			if (assoc[i].size() != 0)
+			{
+				rng.GetBytes(assoc[i]);
+			}
+
+			rng.GetBytes(nonces[i]);
+			enc[i].resize(MSGLEN);
+			packets[i] = { sessions[i % 3], nonces[i].data(), nonces[i].size(), assoc[i].data(), assoc[i].size(), data[i].data(), enc[i].data(), MSGLEN, tags[i].data(), (i % 5 == 0) ? 12U : 16U, false };
+		}
+
+		GCM::EncryptBatch(packets);
+
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			GCM* cipher = sessions[i % 3];
+			std::vector<byte> exp(data[i].size());
+			std::vector<byte> expTag(packets[i].TagSize);
+			Key::Symmetric::SymmetricKey kp(keys[i % 3], nonces[i]);
+
+			cipher->Initialize(true, kp);
+
+			if (assoc[i].size() != 0)
+			{
+				cipher->SetAssociatedData(assoc[i], 0, assoc[i].size());
+			}
+
+			cipher->Transform(data[i], 0, exp, 0, exp.size());
+			cipher->Finalize(expTag, 0, expTag.size());
+
+			if (exp != enc[i])
+			{
+				throw TestException("AEADTest: GCM batch output is not equal!");
+			}
+			if (!std::equal(expTag.begin(), expTag.end(), tags[i].begin()))
+			{
+				throw TestException("AEADTest: GCM batch tag is not equal!");
+			}
+
+			// decrypt in place
+			packets[i].Input = enc[i].data();
+		}
+
+		if (!GCM::DecryptBatch(packets))
+		{
+			throw TestException("AEADTest: GCM batch authentication has failed!");
+		}
+
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			if (!packets[i].IsVerified || enc[i] != data[i])
+			{
+				throw TestException("AEADTest: GCM batch decryption output is not equal!");
+			}
+		}
+
+		// a modified tag or cipher-text fails only that packet
+		GCM::EncryptBatch(packets);
+		tags[3][0] ^= 1;
+		enc[5][enc[5].size() - 1] ^= 1;
+
+		if (GCM::DecryptBatch(packets))
+		{
+			throw TestException("AEADTest: GCM batch authentication did not detect the modified packets!");
+		}
+
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			const bool ISMOD = (i == 3 || i == 5);
+
+			if (packets[i].IsVerified == ISMOD)
+			{
+				throw TestException("AEADTest: GCM batch authentication has failed!");
+			}
+			if (ISMOD && enc[i] != std::vector<byte>(enc[i].size()))
+			{
+				throw TestException("AEADTest: GCM batch output of a failed packet was not erased!");
+			}
+			if (!ISMOD && enc[i] != data[i])
+			{
+				throw TestException("AEADTest: GCM batch decryption output is not equal!");
+			}
+		}
+	}
+
 	void AEADTest::CompareVector(IAeadMode* Cipher, std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &AssociatedText, std::vector<byte> &PlainText,
 		std::vector<byte> &CipherText, std::vector<byte> &MacCode)
 	{
@@ -175,7 +366,7 @@ namespace Test
 		}
 		std::vector<byte> adData1(10, (byte)16);
 		std::vector<byte> nonce(nLen, (byte)17);
-		std::vector<byte> key(16, (byte)5);
+		std::vector<byte> key(Cipher->LegalKeySizes()[0].KeySize(), (byte)5);
 		std::vector<byte> decData(64, (byte)7);
 		std::vector<byte> encData1(80);
 
@@ -221,6 +412,119 @@ namespace Test
 		}
 	}
 
+	void AEADTest::MessageLimitTest()
+	{
+		// RFC 8439: 2^32 key-stream blocks per nonce, less the poly1305 key block
+		const ulong MAXLEN = 274877906880;
+
+		if (sizeof(size_t) < sizeof(ulong))
+		{
+			return;
+		}
+
+		std::vector<byte> data(64);
+		std::vector<byte> key(32);
+		std::vector<byte> nonce(12);
+		Prng::SecureRandom rng;
+		rng.GetBytes(key);
+		rng.GetBytes(nonce);
+		Key::Symmetric::SymmetricKey kp(key, nonce);
+		ChaCha20Poly1305 cipher;
+		bool thrown = false;
+
+		cipher.Initialize(true, kp);
+		cipher.Transform(data, 0, data, 0, data.size());
+
+		try
+		{
+			// the length is checked before any input is read
+			cipher.Transform(data.data(), data.data(), static_cast<size_t>(MAXLEN - data.size() + 1));
+		}
+		catch (CryptoCipherModeException const &)
+		{
+			thrown = true;
+		}
+
+		if (!thrown)
+		{
+			throw TestException("AEADTest: The message length limit was not enforced!");
+		}
+	}
+
+	void AEADTest::ParallelDegreeTest()
+	{
+		const size_t DEGREES[2] = { 2, 4 };
+		std::vector<byte> assoc;
+		std::vector<byte> data;
+		std::vector<byte> decData;
+		std::vector<byte> encData1;
+		std::vector<byte> encData2;
+		std::vector<byte> key(32);
+		std::vector<byte> nonce(12);
+		Prng::SecureRandom rng;
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			// the degree is forced, the hash is split into that many segments regardless of the processor count
+			GCM cipher1(Enumeration::BlockCiphers::Rijndael);
+			GCM cipher2(Enumeration::BlockCiphers::Rijndael);
+			cipher1.ParallelProfile().SetMaxDegree(DEGREES[i]);
+			cipher1.ParallelProfile().IsParallel() = true;
+			cipher2.ParallelProfile().IsParallel() = false;
+			const size_t MINPRL = cipher1.ParallelProfile().ParallelMinimumSize();
+
+			for (size_t j = 0; j < 20; ++j)
+			{
+				const size_t DATLEN = rng.NextUInt32(static_cast<uint32_t>(MINPRL * 10), static_cast<uint32_t>(MINPRL * 2));
+				// a partial first block defers to the sequential hash, an aligned first block keeps the second call parallel
+				const size_t PRTLEN = rng.NextUInt32(static_cast<uint32_t>(MINPRL - 1), 1);
+				const size_t SPLLEN = (j % 3 == 0) ? PRTLEN : (j % 3 == 1) ? PRTLEN - (PRTLEN % 16) : 0;
+				cipher1.ParallelProfile().ParallelBlockSize() = (DATLEN - SPLLEN) - ((DATLEN - SPLLEN) % MINPRL);
+
+				// alternate long and short associated data
+				assoc.resize((j % 2 == 0) ? rng.NextUInt32(8192, 1024) : rng.NextUInt32(64, 1));
+				data.resize(DATLEN);
+				rng.GetBytes(assoc);
+				rng.GetBytes(data);
+				rng.GetBytes(key);
+				rng.GetBytes(nonce);
+				Key::Symmetric::SymmetricKey kp(key, nonce);
+				encData1.resize(DATLEN + cipher1.MaxTagSize());
+				encData2.resize(DATLEN + cipher2.MaxTagSize());
+
+				cipher1.Initialize(true, kp);
+				cipher1.SetAssociatedData(assoc, 0, assoc.size());
+				cipher1.Transform(data, 0, encData1, 0, SPLLEN);
+				cipher1.Transform(data, SPLLEN, encData1, SPLLEN, DATLEN - SPLLEN);
+				cipher1.Finalize(encData1, DATLEN, cipher1.MaxTagSize());
+
+				cipher2.Initialize(true, kp);
+				cipher2.SetAssociatedData(assoc, 0, assoc.size());
+				cipher2.Transform(data, 0, encData2, 0, DATLEN);
+				cipher2.Finalize(encData2, DATLEN, cipher2.MaxTagSize());
+
+				if (encData1 != encData2)
+				{
+					throw TestException("AEADTest: The parallel GCM hash is not equal to the sequential hash!");
+				}
+
+				decData.resize(DATLEN);
+				cipher1.Initialize(false, kp);
+				cipher1.SetAssociatedData(assoc, 0, assoc.size());
+				cipher1.Transform(encData1, 0, decData, 0, DATLEN);
+
+				if (!cipher1.Verify(encData2, DATLEN, cipher1.MaxTagSize()))
+				{
+					throw TestException("AEADTest: The parallel GCM tags do not match!");
+				}
+				if (decData != data)
+				{
+					throw TestException("AEADTest: Decrypted output is not equal!");
+				}
+			}
+		}
+	}
+
 	void AEADTest::ParallelTest(IAeadMode* Cipher)
 	{
 		std::vector<byte> data;
@@ -300,6 +604,130 @@ namespace Test
 		}
 	}
 
+	void AEADTest::ReferenceTest(IAeadMode* Cipher, IAeadMode* Reference, bool BlockAligned)
+	{
+		std::vector<byte> assoc;
+		std::vector<byte> data;
+		std::vector<byte> encData1;
+		std::vector<byte> encData2;
+		std::vector<byte> key(32);
+		std::vector<byte> nonce(Cipher->LegalKeySizes()[0].NonceSize());
+		const std::vector<byte> zero(0);
+		const size_t BLKLEN = Cipher->BlockSize();
+		const size_t MINPRL = Cipher->ParallelProfile().ParallelMinimumSize();
+		const size_t MAXLEN = (MINPRL * 8 > 1024) ? MINPRL * 8 : 1024;
+		// block aligned runs encrypt a second message after a nonce only initialization, which reuses the cached key schedule
+		const size_t MSGCNT = BlockAligned ? 2 : 1;
+		Prng::SecureRandom rng;
+
+		for (size_t i = 0; i < 50; ++i)
+		{
+			// messages transformed in up to four calls, with and without associated data, alternating parallel and sequential processing;
+			// half of the messages are at least 8 blocks long, the minimum input of the stitched and fused wide kernels
+			const size_t MINLEN = (i % 4 < 2) ? 1 : 128;
+			const size_t DATLEN = rng.NextUInt32(static_cast<uint32_t>(MAXLEN), static_cast<uint32_t>(MINLEN));
+			const size_t ALNLEN = DATLEN - (DATLEN % BLKLEN);
+			std::vector<size_t> splits = { 0, rng.NextUInt32(static_cast<uint32_t>(DATLEN), 0), rng.NextUInt32(static_cast<uint32_t>(DATLEN), 0), DATLEN };
+
+			if (BlockAligned)
+			{
+				splits[1] -= splits[1] % BLKLEN;
+				splits[2] -= splits[2] % BLKLEN;
+			}
+
+			std::sort(splits.begin(), splits.end());
+			assoc.resize((i % 3 == 0) ? 0 : rng.NextUInt32(40, 1));
+			data.resize(DATLEN);
+			rng.GetBytes(data);
+			rng.GetBytes(key);
+			encData1.resize(DATLEN + Cipher->MaxTagSize());
+			encData2.resize(DATLEN + Cipher->MaxTagSize());
+
+			if (assoc.size() != 0)
+			{
+				rng.GetBytes(assoc);
+			}
+
+			Cipher->ParallelProfile().IsParallel() = (i % 2 != 0);
+			Cipher->ParallelProfile().ParallelBlockSize() = MINPRL * 2;
+
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				rng.GetBytes(nonce);
+				Key::Symmetric::SymmetricKey kp(key, nonce);
+				Key::Symmetric::SymmetricKey np(zero, nonce);
+
+				Cipher->Initialize(true, (j == 0) ? kp : np);
+				Reference->Initialize(true, kp);
+
+				if (assoc.size() != 0)
+				{
+					Cipher->SetAssociatedData(assoc, 0, assoc.size());
+					Reference->SetAssociatedData(assoc, 0, assoc.size());
+				}
+
+				for (size_t k = 1; k < splits.size(); ++k)
+				{
+					Cipher->Transform(data, splits[k - 1], encData1, splits[k - 1], splits[k] - splits[k - 1]);
+				}
+
+				if (BlockAligned)
+				{
+					// the reference processes one block at a time
+					for (size_t k = 0; k < ALNLEN; k += BLKLEN)
+					{
+						Reference->EncryptBlock(data, k, encData2, k);
+					}
+
+					Reference->Transform(data, ALNLEN, encData2, ALNLEN, DATLEN - ALNLEN);
+				}
+				else
+				{
+					for (size_t k = 1; k < splits.size(); ++k)
+					{
+						Reference->Transform(data, splits[k - 1], encData2, splits[k - 1], splits[k] - splits[k - 1]);
+					}
+				}
+
+				Cipher->Finalize(encData1, DATLEN, Cipher->MaxTagSize());
+				Reference->Finalize(encData2, DATLEN, Reference->MaxTagSize());
+
+				if (encData1 != encData2)
+				{
+					throw TestException("AEADTest: Encrypted output is not equal to the reference engine!");
+				}
+			}
+
+			// decrypt in place
+			Key::Symmetric::SymmetricKey kp(key, nonce);
+			Cipher->Initialize(false, kp);
+
+			if (assoc.size() != 0)
+			{
+				Cipher->SetAssociatedData(assoc, 0, assoc.size());
+			}
+
+			for (size_t k = 1; k < splits.size(); ++k)
+			{
+				Cipher->Transform(encData1, splits[k - 1], encData1, splits[k - 1], splits[k] - splits[k - 1]);
+			}
+
+			if (!Cipher->Verify(encData2, DATLEN, Cipher->MaxTagSize()))
+			{
+				throw TestException("AEADTest: Tags do not match!");
+			}
+
+			encData1.resize(DATLEN);
+
+			if (encData1 != data)
+			{
+				throw TestException("AEADTest: Decrypted output is not equal!");
+			}
+		}
+
+		Cipher->ParallelProfile().IsParallel() = false;
+	}
+
 	void AEADTest::StressTest(IAeadMode* Cipher)
 	{
 		Key::Symmetric::SymmetricKeySize keySize = Cipher->LegalKeySizes()[0];
@@ -394,9 +822,11 @@ namespace Test
 			std::string("FEFFE9928665731C6D6A8F9467308308FEFFE9928665731C6D6A8F9467308308"),
 			std::string("FEFFE9928665731C6D6A8F9467308308FEFFE9928665731C6D6A8F9467308308"),
 			std::string("FEFFE9928665731C6D6A8F9467308308FEFFE9928665731C6D6A8F9467308308"),
-			std::string("FEFFE9928665731C6D6A8F9467308308FEFFE9928665731C6D6A8F9467308308")
+			std::string("FEFFE9928665731C6D6A8F9467308308FEFFE9928665731C6D6A8F9467308308"),
+			// chacha20-poly1305
+			std::string("808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F")
 		};
-		HexConverter::Decode(key, 44, m_key);
+		HexConverter::Decode(key, 45, m_key);
 
 		const std::vector<std::string> nonce =
 		{
@@ -446,9 +876,11 @@ namespace Test
 			std::string("CAFEBABEFACEDBADDECAF888"),
 			std::string("CAFEBABEFACEDBADDECAF888"),
 			std::string("CAFEBABEFACEDBAD"),
-			std::string("9313225DF88406E555909C5AFF5269AA6A7A9538534F7DA1E4C303D2A318A728C3C0C95156809539FCF0E2429A6B525416AEDBF5A0DE6A57A637B39B")
+			std::string("9313225DF88406E555909C5AFF5269AA6A7A9538534F7DA1E4C303D2A318A728C3C0C95156809539FCF0E2429A6B525416AEDBF5A0DE6A57A637B39B"),
+			// chacha20-poly1305
+			std::string("070000004041424344454647")
 		};
-		HexConverter::Decode(nonce, 44, m_nonce);
+		HexConverter::Decode(nonce, 45, m_nonce);
 
 		const std::vector<std::string> associated =
 		{
@@ -498,9 +930,11 @@ namespace Test
 			std::string(""),
 			std::string("FEEDFACEDEADBEEFFEEDFACEDEADBEEFABADDAD2"),
 			std::string("FEEDFACEDEADBEEFFEEDFACEDEADBEEFABADDAD2"),
-			std::string("FEEDFACEDEADBEEFFEEDFACEDEADBEEFABADDAD2")
+			std::string("FEEDFACEDEADBEEFFEEDFACEDEADBEEFABADDAD2"),
+			// chacha20-poly1305
+			std::string("50515253C0C1C2C3C4C5C6C7")
 		};
-		HexConverter::Decode(associated, 44, m_associatedText);
+		HexConverter::Decode(associated, 45, m_associatedText);
 
 		const std::vector<std::string> plain =
 		{
@@ -550,9 +984,11 @@ namespace Test
 			std::string("D9313225F88406E5A55909C5AFF5269A86A7A9531534F7DA2E4C303D8A318A721C3C0C95956809532FCF0E2449A6B525B16AEDF5AA0DE657BA637B391AAFD255"),
 			std::string("D9313225F88406E5A55909C5AFF5269A86A7A9531534F7DA2E4C303D8A318A721C3C0C95956809532FCF0E2449A6B525B16AEDF5AA0DE657BA637B39"),
 			std::string("D9313225F88406E5A55909C5AFF5269A86A7A9531534F7DA2E4C303D8A318A721C3C0C95956809532FCF0E2449A6B525B16AEDF5AA0DE657BA637B39"),
-			std::string("D9313225F88406E5A55909C5AFF5269A86A7A9531534F7DA2E4C303D8A318A721C3C0C95956809532FCF0E2449A6B525B16AEDF5AA0DE657BA637B39")
+			std::string("D9313225F88406E5A55909C5AFF5269A86A7A9531534F7DA2E4C303D8A318A721C3C0C95956809532FCF0E2449A6B525B16AEDF5AA0DE657BA637B39"),
+			// chacha20-poly1305
+			std::string("4C616469657320616E642047656E746C656D656E206F662074686520636C617373206F66202739393A204966204920636F756C64206F6666657220796F75206F6E6C79206F6E652074697020666F7220746865206675747572652C2073756E73637265656E20776F756C642062652069742E")
 		};
-		HexConverter::Decode(plain, 44, m_plainText);
+		HexConverter::Decode(plain, 45, m_plainText);
 
 		const std::vector<std::string> cipher =
 		{
@@ -602,9 +1038,11 @@ namespace Test
 			std::string("522DC1F099567D07F47F37A32A84427D643A8CDCBFE5C0C97598A2BD2555D1AA8CB08E48590DBB3DA7B08B1056828838C5F61E6393BA7A0ABCC9F662898015ADB094DAC5D93471BDEC1A502270E3CC6C"),
 			std::string("522DC1F099567D07F47F37A32A84427D643A8CDCBFE5C0C97598A2BD2555D1AA8CB08E48590DBB3DA7B08B1056828838C5F61E6393BA7A0ABCC9F66276FC6ECE0F4E1768CDDF8853BB2D551B"),
 			std::string("C3762DF1CA787D32AE47C13BF19844CBAF1AE14D0B976AFAC52FF7D79BBA9DE0FEB582D33934A4F0954CC2363BC73F7862AC430E64ABE499F47C9B1F3A337DBF46A792C45E454913FE2EA8F2"),
-			std::string("5A8DEF2F0C9E53F1F75D7853659E2A20EEB2B22AAFDE6419A058AB4F6F746BF40FC0C3B780F244452DA3EBF1C5D82CDEA2418997200EF82E44AE7E3FA44A8266EE1C8EB0C8B5D4CF5AE9F19A")
+			std::string("5A8DEF2F0C9E53F1F75D7853659E2A20EEB2B22AAFDE6419A058AB4F6F746BF40FC0C3B780F244452DA3EBF1C5D82CDEA2418997200EF82E44AE7E3FA44A8266EE1C8EB0C8B5D4CF5AE9F19A"),
+			// chacha20-poly1305
+			std::string("D31A8D34648E60DB7B86AFBC53EF7EC2A4ADED51296E08FEA9E2B5A736EE62D63DBEA45E8CA9671282FAFB69DA92728B1A71DE0A9E060B2905D6A5B67ECD3B3692DDBD7F2D778B8C9803AEE328091B58FAB324E4FAD675945585808B4831D7BC3FF4DEF08E4B7A9DE576D26586CEC64B61161AE10B594F09E26A7E902ECBD0600691")
 		};
-		HexConverter::Decode(cipher, 44, m_cipherText);
+		HexConverter::Decode(cipher, 45, m_cipherText);
 
 		const std::vector<std::string> code =
 		{
@@ -654,9 +1092,11 @@ namespace Test
 			std::string("B094DAC5D93471BDEC1A502270E3CC6C"),
 			std::string("76FC6ECE0F4E1768CDDF8853BB2D551B"),
 			std::string("3A337DBF46A792C45E454913FE2EA8F2"),
-			std::string("A44A8266EE1C8EB0C8B5D4CF5AE9F19A")
+			std::string("A44A8266EE1C8EB0C8B5D4CF5AE9F19A"),
+			// chacha20-poly1305
+			std::string("1AE10B594F09E26A7E902ECBD0600691")
 		};
-		HexConverter::Decode(code, 44, m_expectedCode);
+		HexConverter::Decode(code, 45, m_expectedCode);
 		/*lint -restore */
 	}
 
@@ -664,4 +1104,37 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void AEADTest::PointerTest()
+	{
+		std::vector<IAeadMode*> modes = {
+			new EAX(Enumeration::BlockCiphers::Rijndael),
+			new GCM(Enumeration::BlockCiphers::Rijndael),
+			new OCB(Enumeration::BlockCiphers::Rijndael),
+			new ChaCha20Poly1305() };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < modes.size(); ++i)
+		{
+			// the legal nonce sizes differ between the modes
+			std::vector<byte> key(modes[i]->LegalKeySizes()[0].KeySize());
+			TestUtils::GetRandom(key);
+			std::vector<byte> nonce(modes[i]->LegalKeySizes()[0].NonceSize());
+			TestUtils::GetRandom(nonce);
+			Key::Symmetric::SymmetricKey kp(key, nonce);
+
+			for (size_t j = 0; j < 2; ++j)
+			{
+				const bool ENCRYPT = (j == 0);
+				isEqual &= TestUtils::ComparePointerTransform(modes[i], [&modes, i, ENCRYPT, &kp]() { modes[i]->Initialize(ENCRYPT, kp); }, 1000);
+			}
+
+			delete modes[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("AEADTest: The pointer and vector transforms are not equal!");
+		}
+	}
 }
@@ -9,7 +9,7 @@ namespace Test
 	using Cipher::Symmetric::Block::Mode::IAeadMode;
 
 	/// <summary>
-	/// Tests the AEAD cipher modes; EAX, OCB and GCM
+	/// Tests the AEAD cipher modes; EAX, OCB, GCM and ChaCha20Poly1305
 	/// </summary>
 	class AEADTest final : public ITest
 	{
@@ -27,6 +27,7 @@ namespace Test
 		static const size_t EAX_TESTSIZE = 10;
 		static const size_t OCB_TESTSIZE = 16;
 		static const size_t GCM_TESTSIZE = 18;
+		static const size_t CHACHAPOLY_TESTSIZE = 1;
 
 		std::vector<std::vector<byte>> m_associatedText;
 		std::vector<std::vector<byte>> m_cipherText;
@@ -65,11 +66,16 @@ namespace Test
 
 	private:
 
+		void BatchTest();
 		void CompareVector(IAeadMode* Cipher, std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &AssociatedText, std::vector<byte> &PlainText, std::vector<byte> &CipherText, std::vector<byte> &MacCode);
 		void IncrementalCheck(IAeadMode* Cipher);
 		void Initialize();
+		void MessageLimitTest();
 		void OnProgress(std::string Data);
+		void PointerTest();
+		void ParallelDegreeTest();
 		void ParallelTest(IAeadMode* Cipher);
+		void ReferenceTest(IAeadMode* Cipher, IAeadMode* Reference, bool BlockAligned = false);
 		void StressTest(IAeadMode* Cipher);
 	};
 }
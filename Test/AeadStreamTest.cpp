@@ -0,0 +1,394 @@
+#include "AeadStreamTest.h"
+#include "../CEX/AeadStream.h"
+#include "../CEX/CSP.h"
+#include "../CEX/CryptoAuthenticationFailure.h"
+#include "../CEX/CryptoProcessingException.h"
+#include "../CEX/IntUtils.h"
+#include "../CEX/MemoryStream.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	using Enumeration::BlockCiphers;
+	using Enumeration::BlockSizes;
+	using Enumeration::CipherModes;
+	using Enumeration::Digests;
+	using Enumeration::IVSizes;
+	using Enumeration::PaddingModes;
+	using Enumeration::RoundCounts;
+	using Exception::CryptoAuthenticationFailure;
+	using Exception::CryptoProcessingException;
+	using Processing::AeadStream;
+	using IO::MemoryStream;
+	using Provider::CSP;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string AeadStreamTest::DESCRIPTION = "AeadStream chunked authenticated container round trip, authentication, and random-access tests.";
+	const std::string AeadStreamTest::FAILURE = "FAILURE! ";
+	const std::string AeadStreamTest::SUCCESS = "SUCCESS! AeadStream tests have executed succesfully.";
+
+	AeadStreamTest::AeadStreamTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	AeadStreamTest::~AeadStreamTest()
+	{
+	}
+
+	const std::string AeadStreamTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &AeadStreamTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string AeadStreamTest::Run()
+	{
+		try
+		{
+			CipherDescription eax(BlockCiphers::AHX, 32, IVSizes::V128, CipherModes::EAX, PaddingModes::None, BlockSizes::B128, RoundCounts::R14, Digests::None);
+			CipherDescription gcm(BlockCiphers::AHX, 32, IVSizes::V128, CipherModes::GCM, PaddingModes::None, BlockSizes::B128, RoundCounts::R14, Digests::None);
+			CipherDescription ocb(BlockCiphers::AHX, 32, IVSizes::V128, CipherModes::OCB, PaddingModes::None, BlockSizes::B128, RoundCounts::R14, Digests::None);
+			CipherDescription ccp(BlockCiphers::None, 32, IVSizes::None, CipherModes::ChaCha20Poly1305, PaddingModes::None, BlockSizes::None, RoundCounts::R20, Digests::None);
+
+			RoundTripTest(eax);
+			RoundTripTest(gcm);
+			RoundTripTest(ocb);
+			RoundTripTest(ccp);
+			OnProgress(std::string("AeadStreamTest: Passed EAX, GCM, OCB, and ChaCha20Poly1305 sequential and parallel round trip tests.."));
+
+			AuthenticationTest(gcm);
+			AuthenticationTest(ccp);
+			OnProgress(std::string("AeadStreamTest: Passed modified, reordered, and truncated container authentication tests.."));
+
+			LengthLimitTest(gcm);
+			OnProgress(std::string("AeadStreamTest: Passed the maximum chunk count tests.."));
+
+			RandomAccessTest(ocb);
+			RandomAccessTest(ccp);
+			OnProgress(std::string("AeadStreamTest: Passed random-access range decryption tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void AeadStreamTest::AuthenticationTest(CipherDescription &Description)
+	{
+		const size_t PLNLEN = (CHUNK_SIZE * 5) + 10;
+		const size_t RECLEN = CHUNK_SIZE + 16;
+		std::vector<byte> key(32);
+		std::vector<byte> plnText(PLNLEN);
+		CSP rng;
+		rng.GetBytes(key);
+		rng.GetBytes(plnText);
+		SymmetricKey kp(key);
+
+		AeadStream cipher(&Description, CHUNK_SIZE);
+		MemoryStream mIn(plnText);
+		MemoryStream mOut;
+		cipher.Initialize(true, kp);
+		cipher.Write(&mIn, &mOut);
+		const std::vector<byte> CPRTXT = mOut.ToArray();
+		const size_t HDRLEN = cipher.HeaderSize();
+
+		auto isRejected = [&Description, &kp](const std::vector<byte> &Container)
+		{
+			AeadStream dec(&Description, CHUNK_SIZE);
+			MemoryStream cIn(Container);
+			MemoryStream cOut;
+			dec.Initialize(false, kp);
+
+			try
+			{
+				dec.Write(&cIn, &cOut);
+			}
+			catch (CryptoAuthenticationFailure const &)
+			{
+				return true;
+			}
+
+			return false;
+		};
+
+		// the unmodified container is accepted
+		if (isRejected(CPRTXT))
+		{
+			throw TestException("AuthenticationTest: A valid container failed authentication!");
+		}
+
+		// modified cipher-text
+		std::vector<byte> tmp = CPRTXT;
+		tmp[HDRLEN + (2 * RECLEN) + 7] ^= 0x01;
+		if (!isRejected(tmp))
+		{
+			throw TestException("AuthenticationTest: A modified chunk was not detected!");
+		}
+
+		// modified tag of the final chunk
+		tmp = CPRTXT;
+		tmp[tmp.size() - 1] ^= 0x80;
+		if (!isRejected(tmp))
+		{
+			throw TestException("AuthenticationTest: A modified tag was not detected!");
+		}
+
+		// reordered chunks
+		tmp = CPRTXT;
+		std::swap_ranges(tmp.begin() + HDRLEN + RECLEN, tmp.begin() + HDRLEN + (2 * RECLEN), tmp.begin() + HDRLEN + (2 * RECLEN));
+		if (!isRejected(tmp))
+		{
+			throw TestException("AuthenticationTest: Reordered chunks were not detected!");
+		}
+
+		// truncated container
+		tmp = CPRTXT;
+		tmp.resize(tmp.size() - (10 + 16));
+		if (!isRejected(tmp))
+		{
+			throw TestException("AuthenticationTest: A truncated container was not detected!");
+		}
+
+		// truncated container with the plaintext length rewritten to match
+		Utility::IntUtils::Le64ToBytes(static_cast<ulong>(CHUNK_SIZE * 5), tmp, Description.ToBytes().size() + sizeof(uint));
+		if (!isRejected(tmp))
+		{
+			throw TestException("AuthenticationTest: A truncated container with a modified header was not detected!");
+		}
+
+		// the wrong key
+		std::vector<byte> key2 = key;
+		key2[0] ^= 0x01;
+		SymmetricKey kp2(key2);
+		AeadStream dec(&Description, CHUNK_SIZE);
+		MemoryStream cIn(CPRTXT);
+		MemoryStream cOut;
+		dec.Initialize(false, kp2);
+		bool rejected = false;
+
+		try
+		{
+			dec.Write(&cIn, &cOut);
+		}
+		catch (CryptoAuthenticationFailure const &)
+		{
+			rejected = true;
+		}
+
+		if (!rejected)
+		{
+			throw TestException("AuthenticationTest: A container decrypted with the wrong key was accepted!");
+		}
+	}
+
+	void AeadStreamTest::LengthLimitTest(CipherDescription &Description)
+	{
+		// the chunk index is 32 bits, so a container holds at most 2^32 chunks before a nonce would repeat
+		const ulong MAXLEN = static_cast<ulong>(CHUNK_SIZE) * 4294967296ULL;
+		std::vector<byte> key(32);
+		std::vector<byte> plnText(CHUNK_SIZE * 2);
+		CSP rng;
+		rng.GetBytes(key);
+		rng.GetBytes(plnText);
+		SymmetricKey kp(key);
+
+		AeadStream cipher(&Description, CHUNK_SIZE);
+
+		if (cipher.CipherLength(MAXLEN) != cipher.HeaderSize() + MAXLEN + (4294967296ULL * 16))
+		{
+			throw TestException("LengthLimitTest: The maximum container length is incorrect!");
+		}
+
+		bool rejected = false;
+
+		try
+		{
+			cipher.CipherLength(MAXLEN + 1);
+		}
+		catch (CryptoProcessingException const &)
+		{
+			rejected = true;
+		}
+
+		if (!rejected)
+		{
+			throw TestException("LengthLimitTest: A plaintext longer than the chunk index range was accepted!");
+		}
+
+		// a container header claiming one chunk more than the index range is rejected before any chunk is processed
+		MemoryStream mIn(plnText);
+		MemoryStream mOut;
+		cipher.Initialize(true, kp);
+		cipher.Write(&mIn, &mOut);
+		std::vector<byte> tmp = mOut.ToArray();
+		Utility::IntUtils::Le64ToBytes(MAXLEN + 1, tmp, Description.ToBytes().size() + sizeof(uint));
+
+		AeadStream dec(&Description, CHUNK_SIZE);
+		MemoryStream cIn(tmp);
+		MemoryStream cOut;
+		dec.Initialize(false, kp);
+		rejected = false;
+
+		try
+		{
+			dec.Write(&cIn, &cOut);
+		}
+		catch (CryptoProcessingException const &)
+		{
+			rejected = true;
+		}
+
+		if (!rejected)
+		{
+			throw TestException("LengthLimitTest: A container longer than the chunk index range was accepted!");
+		}
+	}
+
+	void AeadStreamTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	void AeadStreamTest::RandomAccessTest(CipherDescription &Description)
+	{
+		const size_t PLNLEN = (CHUNK_SIZE * 20) + 33;
+		const size_t RECLEN = CHUNK_SIZE + 16;
+		std::vector<byte> key(32);
+		std::vector<byte> plnText(PLNLEN);
+		std::vector<byte> rnd(8);
+		CSP rng;
+		rng.GetBytes(key);
+		rng.GetBytes(plnText);
+		SymmetricKey kp(key);
+
+		AeadStream cipher(&Description, CHUNK_SIZE);
+		MemoryStream mIn(plnText);
+		MemoryStream mOut;
+		cipher.Initialize(true, kp);
+		cipher.Write(&mIn, &mOut);
+		cipher.Initialize(false, kp);
+
+		for (size_t i = 0; i < TEST_CYCLES; ++i)
+		{
+			rng.GetBytes(rnd);
+			const size_t OFFSET = Utility::IntUtils::LeBytesTo32(rnd, 0) % PLNLEN;
+			const size_t LENGTH = (Utility::IntUtils::LeBytesTo32(rnd, 4) % (PLNLEN - OFFSET)) + 1;
+			std::vector<byte> output(LENGTH + 3);
+
+			cipher.Read(&mOut, OFFSET, output, 3, LENGTH);
+
+			if (!std::equal(output.begin() + 3, output.end(), plnText.begin() + OFFSET))
+			{
+				throw TestException("RandomAccessTest: The decrypted range is not equal!");
+			}
+		}
+
+		// the entire plaintext, and the final byte
+		std::vector<byte> output(PLNLEN);
+		cipher.Read(&mOut, 0, output, 0, PLNLEN);
+		if (output != plnText)
+		{
+			throw TestException("RandomAccessTest: The decrypted plaintext is not equal!");
+		}
+
+		cipher.Read(&mOut, PLNLEN - 1, output, 0, 1);
+		if (output[0] != plnText[PLNLEN - 1])
+		{
+			throw TestException("RandomAccessTest: The final byte is not equal!");
+		}
+
+		// only the chunks covering the range are authenticated
+		std::vector<byte> tmp = mOut.ToArray();
+		tmp[cipher.HeaderSize() + (15 * RECLEN) + 1] ^= 0x01;
+		MemoryStream mMod(tmp);
+		cipher.Read(&mMod, CHUNK_SIZE * 2, output, 0, CHUNK_SIZE);
+
+		if (!std::equal(output.begin(), output.begin() + CHUNK_SIZE, plnText.begin() + (CHUNK_SIZE * 2)))
+		{
+			throw TestException("RandomAccessTest: The decrypted range is not equal!");
+		}
+
+		bool rejected = false;
+
+		try
+		{
+			cipher.Read(&mMod, (CHUNK_SIZE * 15) + 10, output, 0, 10);
+		}
+		catch (CryptoAuthenticationFailure const &)
+		{
+			rejected = true;
+		}
+
+		if (!rejected)
+		{
+			throw TestException("RandomAccessTest: A modified chunk was not detected!");
+		}
+	}
+
+	void AeadStreamTest::RoundTripTest(CipherDescription &Description)
+	{
+		const std::vector<size_t> LENGTHS = { 0, 1, CHUNK_SIZE - 1, CHUNK_SIZE, CHUNK_SIZE + 1, (CHUNK_SIZE * 9) + 17, CHUNK_SIZE * 64 };
+		std::vector<byte> key(32);
+		CSP rng;
+		rng.GetBytes(key);
+		SymmetricKey kp(key);
+
+		for (size_t i = 0; i < LENGTHS.size(); ++i)
+		{
+			std::vector<byte> plnText(LENGTHS[i]);
+
+			if (plnText.size() != 0)
+			{
+				rng.GetBytes(plnText);
+			}
+
+			for (size_t j = 0; j < 2; ++j)
+			{
+				AeadStream enc(&Description, CHUNK_SIZE);
+				AeadStream dec(&Description, CHUNK_SIZE);
+				// encrypt sequentially and decrypt in parallel, then the reverse
+				enc.IsParallel() = (j == 0);
+				dec.IsParallel() = (j != 0);
+
+				MemoryStream mIn(plnText);
+				MemoryStream mOut;
+				MemoryStream mRes;
+
+				enc.Initialize(true, kp);
+				enc.Write(&mIn, &mOut);
+
+				if (mOut.Length() != enc.CipherLength(LENGTHS[i]))
+				{
+					throw TestException("RoundTripTest: The container length is invalid!");
+				}
+
+				mOut.Seek(0, IO::SeekOrigin::Begin);
+
+				if (dec.PlainLength(&mOut) != LENGTHS[i])
+				{
+					throw TestException("RoundTripTest: The plaintext length is invalid!");
+				}
+
+				dec.Initialize(false, kp);
+				dec.Write(&mOut, &mRes);
+
+				if (mRes.ToArray() != plnText)
+				{
+					throw TestException("RoundTripTest: Decrypted arrays are not equal!");
+				}
+			}
+		}
+	}
+}
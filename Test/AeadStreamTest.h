@@ -0,0 +1,63 @@
+#ifndef CEXTEST_AEADSTREAMTEST_H
+#define CEXTEST_AEADSTREAMTEST_H
+
+#include "ITest.h"
+#include "../CEX/CipherDescription.h"
+
+namespace Test
+{
+	using Processing::CipherDescription;
+
+	/// <summary>
+	/// Tests the AeadStream chunked authenticated container; round trips, authentication of modified containers, and random-access reads
+	/// </summary>
+	class AeadStreamTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+		static const size_t CHUNK_SIZE = 256;
+		static const size_t TEST_CYCLES = 10;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Compares AeadStream output with the plaintext, and verifies chunk authentication
+		/// </summary>
+		AeadStreamTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~AeadStreamTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void AuthenticationTest(CipherDescription &Description);
+		void LengthLimitTest(CipherDescription &Description);
+		void OnProgress(std::string Data);
+		void RandomAccessTest(CipherDescription &Description);
+		void RoundTripTest(CipherDescription &Description);
+	};
+}
+
+#endif
@@ -59,6 +59,8 @@ namespace Test
 			OnProgress(std::string("Passed Blake2-B 512 vector tests.."));
 			Blake2BPTest();
 			OnProgress(std::string("Passed Blake2-BP 512 vector tests.."));    
+			PointerTest();
+			OnProgress(std::string("Passed Blake2 pointer and vector update equivalence tests.."));
 
 			return SUCCESS;
 		}
@@ -348,4 +350,27 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void Blake2Test::PointerTest()
+	{
+		std::vector<Digest::IDigest*> digests = {
+			new Blake256(),
+			new Blake256(true),
+			new Blake512(),
+			new Blake512(true) };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < digests.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(digests[i], [&digests, i]() { digests[i]->Reset(); }, digests[i]->DigestSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(digests[i], [&digests, i]() { digests[i]->Reset(); }, digests[i]->DigestSize(), 5000);
+			delete digests[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("Blake2Test: The pointer and vector updates are not equal!");
+		}
+	}
 }
@@ -61,6 +61,7 @@ namespace Test
 		void MacParamsTest();
 		void TreeParamsTest();
 		void OnProgress(std::string Data);
+		void PointerTest();
 	};
 }
 #endif
@@ -1,5 +1,7 @@
 #include "CMACTest.h"
 #include "../CEX/CMAC.h"
+#include "../CEX/CSP.h"
+#include "../CEX/IntUtils.h"
 #include "../CEX/RHX.h"
 #include "../CEX/SymmetricKey.h"
 
@@ -53,6 +55,10 @@ namespace Test
 			OnProgress(std::string("Passed 256 bit key vector tests.."));
 			CompareAccess(m_keys[2]);
 			OnProgress(std::string("Passed Finalize/Compute methods output comparison.."));
+			CompareBatch(m_keys[2]);
+			OnProgress(std::string("Passed multi-message batch tests.."));
+			PointerTest();
+			OnProgress(std::string("Passed pointer and vector update equivalence tests.."));
 
 			return SUCCESS;
 		}
@@ -89,6 +95,88 @@ namespace Test
 		}
 	}
 
+	void CMACTest::CompareBatch(std::vector<byte> &Key)
+	{
+		const size_t PKTCNT = 50;
+		Provider::CSP rng;
+		std::vector<byte> rnd(4);
+		Cipher::Symmetric::Block::RHX* eng = new Cipher::Symmetric::Block::RHX();
+		Mac::CMAC macAes(Enumeration::BlockCiphers::Rijndael);
+		Mac::CMAC macRhx(eng);
+		Mac::CMAC* macs[2] = { &macAes, &macRhx };
+		SymmetricKey kp(Key);
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			std::vector<std::vector<byte>> data(PKTCNT);
+			std::vector<std::vector<byte>> codes;
+			Mac::CMAC* mac = macs[i];
+
+			// the known answer messages, then random messages with aligned and unaligned lengths
+			for (size_t j = 0; j < PKTCNT; ++j)
+			{
+				if (j < m_input.size())
+				{
+					data[j] = m_input[j];
+				}
+				else
+				{
+					rng.GetBytes(rnd);
+					data[j].resize((j % 4 == 0) ? (rnd[0] % 32) * 16 : Utility::IntUtils::LeBytesTo32(rnd, 0) % 600);
+
+					if (data[j].size() != 0)
+					{
+						rng.GetBytes(data[j]);
+					}
+				}
+			}
+
+			const bool ISEQUAL = TestUtils::CompareBatch(data, 16,
+				[this, mac, &kp, &data](const std::vector<const byte*> &Input, const std::vector<byte*> &Output)
+			{
+				std::vector<Mac::CMAC::BatchPacket> packets(Input.size());
+
+				for (size_t j = 0; j < Input.size(); ++j)
+				{
+					packets[j] = { Input[j], Output[j], data[j].size() };
+				}
+
+				mac->Initialize(kp);
+				// a pending message is not changed by the batch
+				mac->Update(m_input[3], 0, 20);
+				mac->ComputeBatch(packets);
+				std::vector<byte> hash(16);
+				mac->Update(m_input[3], 20, m_input[3].size() - 20);
+				mac->Finalize(hash, 0);
+
+				if (hash != m_expected[11])
+				{
+					throw TestException("CMAC batch changed the message state!");
+				}
+			},
+				[mac, &kp, &data](size_t Index, std::vector<byte> &Output)
+			{
+				mac->Initialize(kp);
+				mac->Compute(data[Index], Output);
+			}, codes);
+
+			for (size_t j = 0; j < m_input.size(); ++j)
+			{
+				if (codes[j] != m_expected[8 + j])
+				{
+					throw TestException("CMAC batch known answer is not equal!");
+				}
+			}
+
+			if (!ISEQUAL)
+			{
+				throw TestException("CMAC batch is not equal!");
+			}
+		}
+
+		delete eng;
+	}
+
 	void CMACTest::CompareVector(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Expected)
 	{
 		std::vector<byte> hash(16);
@@ -149,4 +237,27 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void CMACTest::PointerTest()
+	{
+		std::vector<byte> key(32);
+		TestUtils::GetRandom(key);
+		Key::Symmetric::SymmetricKey kp(key);
+		std::vector<Mac::IMac*> generators = {
+			new Mac::CMAC(Enumeration::BlockCiphers::Rijndael) };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < generators.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 5000);
+			delete generators[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("CMACTest: The pointer and vector updates are not equal!");
+		}
+	}
 }
@@ -53,9 +53,11 @@ namespace Test
 	private:
 
 		void CompareAccess(std::vector<byte> &Key);
+		void CompareBatch(std::vector<byte> &Key);
 		void CompareVector(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Expected);
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
 	};
 }
 
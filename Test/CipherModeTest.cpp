@@ -3,8 +3,11 @@
 #include "../CEX/CFB.h"
 #include "../CEX/CTR.h"
 #include "../CEX/ECB.h"
+#include "../CEX/ICM.h"
+#include "../CEX/IntUtils.h"
 #include "../CEX/OFB.h"
 #include "../CEX/RHX.h"
+#include "../CEX/CSP.h"
 
 namespace Test
 {
@@ -65,6 +68,30 @@ namespace Test
 			CompareOFB(m_keys[2], m_input, m_output);
 			OnProgress(std::string("CipherModeTest: Passed OFB 128/192/256 bit key encryption/decryption tests.."));
 
+			Mode::CTR ctr(BlockCiphers::Rijndael);
+			CompareSeek(ctr);
+			Mode::ICM icm(BlockCiphers::Rijndael);
+			CompareSeek(icm);
+			OnProgress(std::string("CipherModeTest: Passed CTR and ICM random-access key stream seek tests.."));
+
+			CompareBatch();
+			OnProgress(std::string("CipherModeTest: Passed CTR multi-message batch tests.."));
+			CompareBatchCBC();
+			OnProgress(std::string("CipherModeTest: Passed CBC multi-message batch tests.."));
+
+			Mode::ECB ecb(BlockCiphers::Rijndael);
+			CompareScheduler(ecb, false);
+			Mode::CBC cbc(BlockCiphers::Rijndael);
+			CompareScheduler(cbc, false);
+			Mode::CFB cfb(BlockCiphers::Rijndael);
+			CompareScheduler(cfb, false);
+			CompareScheduler(ctr, true);
+			CompareScheduler(icm, true);
+			OnProgress(std::string("CipherModeTest: Passed ECB, CBC, CFB, CTR and ICM block scheduler tests.."));
+
+			PointerTest();
+			OnProgress(std::string("CipherModeTest: Passed pointer and vector transform equivalence tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -77,6 +104,141 @@ namespace Test
 		}
 	}
 
+	void CipherModeTest::CompareBatch()
+	{
+		const size_t PKTCNT = 40;
+		Provider::CSP rng;
+		std::vector<byte> rnd(4);
+		// the default engine with 128 and 256 bit keys, and the reference engine
+		RHX eng;
+		Mode::CTR ctr128(BlockCiphers::Rijndael);
+		Mode::CTR ctr256(BlockCiphers::Rijndael);
+		Mode::CTR ctrRhx(&eng);
+		Mode::CTR* sessions[3] = { &ctr128, &ctr256, &ctrRhx };
+		std::vector<std::vector<byte>> keys = { std::vector<byte>(16), std::vector<byte>(32), std::vector<byte>(32) };
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			rng.GetBytes(keys[i]);
+			Key::Symmetric::SymmetricKey kp(keys[i], std::vector<byte>(16));
+			sessions[i]->Initialize(true, kp);
+		}
+
+		std::vector<std::vector<byte>> data(PKTCNT);
+		std::vector<std::vector<byte>> enc;
+		std::vector<std::vector<byte>> nonces(PKTCNT, std::vector<byte>(16));
+
+		// short messages with uneven lengths
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			rng.GetBytes(rnd);
+			const size_t MSGLEN = (i == 0) ? 0 : (Utility::IntUtils::LeBytesTo32(rnd, 0) % 1500) + 1;
+			data[i].resize(MSGLEN);
+
+			if (MSGLEN != 0)
+			{
+				rng.GetBytes(data[i]);
+			}
+
+			rng.GetBytes(nonces[i]);
+		}
+
+		const bool ISEQUAL = TestUtils::CompareBatch(data, 0,
+			[&sessions, &nonces, &data](const std::vector<const byte*> &Input, const std::vector<byte*> &Output)
+		{
+			std::vector<Mode::CTR::BatchPacket> packets(Input.size());
+
+			for (size_t i = 0; i < Input.size(); ++i)
+			{
+				packets[i] = { sessions[i % 3], nonces[i].data(), Input[i], Output[i], data[i].size() };
+			}
+
+			Mode::CTR::TransformBatch(packets);
+		},
+			[&sessions, &keys, &nonces, &data](size_t Index, std::vector<byte> &Output)
+		{
+			Key::Symmetric::SymmetricKey kp(keys[Index % 3], nonces[Index]);
+			sessions[Index % 3]->Initialize(true, kp);
+
+			if (Output.size() != 0)
+			{
+				sessions[Index % 3]->Transform(data[Index], 0, Output, 0, Output.size());
+			}
+		}, enc);
+
+		if (!ISEQUAL)
+		{
+			throw TestException("CipherModeTest: CTR batch output is not equal!");
+		}
+	}
+
+	void CipherModeTest::CompareBatchCBC()
+	{
+		const size_t PKTCNT = 40;
+		Provider::CSP rng;
+		std::vector<byte> rnd(4);
+		std::vector<byte> key(32);
+		rng.GetBytes(key);
+		// the default engine, and the reference engine
+		RHX eng;
+		Mode::CBC cbcAes(BlockCiphers::Rijndael);
+		Mode::CBC cbcRhx(&eng);
+		Mode::CBC* sessions[2] = { &cbcAes, &cbcRhx };
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			std::vector<std::vector<byte>> data(PKTCNT);
+			std::vector<std::vector<byte>> enc;
+			std::vector<std::vector<byte>> nonces(PKTCNT, std::vector<byte>(16));
+			Mode::CBC* session = sessions[i];
+
+			// block aligned messages with uneven block counts
+			for (size_t j = 0; j < PKTCNT; ++j)
+			{
+				rng.GetBytes(rnd);
+				const size_t MSGLEN = (j == 0) ? 0 : ((Utility::IntUtils::LeBytesTo32(rnd, 0) % 96) + 1) * 16;
+				data[j].resize(MSGLEN);
+
+				if (MSGLEN != 0)
+				{
+					rng.GetBytes(data[j]);
+				}
+
+				rng.GetBytes(nonces[j]);
+			}
+
+			const bool ISEQUAL = TestUtils::CompareBatch(data, 0,
+				[session, &key, &nonces, &data](const std::vector<const byte*> &Input, const std::vector<byte*> &Output)
+			{
+				std::vector<Mode::CBC::BatchPacket> packets(Input.size());
+
+				for (size_t j = 0; j < Input.size(); ++j)
+				{
+					packets[j] = { nonces[j].data(), Input[j], Output[j], data[j].size() };
+				}
+
+				Key::Symmetric::SymmetricKey kp(key, nonces[0]);
+				session->Initialize(true, kp);
+				session->EncryptBatch(packets);
+			},
+				[session, &key, &nonces, &data](size_t Index, std::vector<byte> &Output)
+			{
+				Key::Symmetric::SymmetricKey kp(key, nonces[Index]);
+				session->Initialize(true, kp);
+
+				if (Output.size() != 0)
+				{
+					session->Transform(data[Index], 0, Output, 0, Output.size());
+				}
+			}, enc);
+
+			if (!ISEQUAL)
+			{
+				throw TestException("CipherModeTest: CBC batch output is not equal!");
+			}
+		}
+	}
+
 	void CipherModeTest::CompareCBC(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output)
 	{
 		std::vector<byte> outBytes(16, 0);
@@ -345,6 +507,128 @@ namespace Test
 		}
 	}
 
+	template<typename T>
+	void CipherModeTest::CompareScheduler(T &Cipher, bool Encryption)
+	{
+		Provider::CSP rng;
+		std::vector<byte> key(32);
+		rng.GetBytes(key);
+		std::vector<byte> iv(16);
+		rng.GetBytes(iv);
+		Key::Symmetric::SymmetricKey k(key, iv);
+		Cipher.ParallelProfile().IsParallel() = true;
+		Cipher.ParallelProfile().ParallelBlockSize() = Cipher.ParallelProfile().ParallelMinimumSize();
+		const size_t PRLBLK = Cipher.ParallelProfile().ParallelBlockSize();
+		// parallel rounds, and a remainder with a partial run of blocks
+		std::vector<byte> data((PRLBLK * 3) + (16 * 21));
+		rng.GetBytes(data);
+		std::vector<byte> exp(data.size());
+		std::vector<byte> otp(data.size());
+
+		// the reference is transformed a block at a time
+		Cipher.ParallelProfile().IsParallel() = false;
+		Cipher.Initialize(Encryption, k);
+
+		for (size_t i = 0; i < data.size(); i += 16)
+		{
+			Cipher.Transform(data, i, exp, i, 16);
+		}
+
+		// sequential and in place
+		otp = data;
+		Cipher.Initialize(Encryption, k);
+		Cipher.Transform(otp, 0, otp, 0, otp.size());
+
+		if (otp != exp)
+		{
+			throw TestException("CompareScheduler: The sequential in place output is not equal!");
+		}
+
+		// parallel segments
+		Cipher.ParallelProfile().IsParallel() = true;
+		Cipher.Initialize(Encryption, k);
+		Cipher.Transform(data, 0, otp, 0, data.size());
+
+		if (otp != exp)
+		{
+			throw TestException("CompareScheduler: The parallel output is not equal!");
+		}
+
+		// parallel and in place, split within a segment so the mode state is carried between calls
+		const size_t SPLLEN = PRLBLK + (16 * 5);
+		otp = data;
+		Cipher.Initialize(Encryption, k);
+		Cipher.Transform(otp, 0, otp, 0, SPLLEN);
+		Cipher.Transform(otp, SPLLEN, otp, SPLLEN, otp.size() - SPLLEN);
+
+		if (otp != exp)
+		{
+			throw TestException("CompareScheduler: The parallel in place output is not equal!");
+		}
+	}
+
+	template<typename T>
+	void CipherModeTest::CompareSeek(T &Cipher)
+	{
+		Provider::CSP rng;
+		std::vector<byte> key(32);
+		rng.GetBytes(key);
+		std::vector<byte> iv(16);
+		rng.GetBytes(iv);
+		// start near a 64 bit counter boundary to test the carry
+		iv[8] = 0xFF;
+		iv[9] = 0xFF;
+		iv[10] = 0xFF;
+		iv[11] = 0xFF;
+		iv[12] = 0xFF;
+		iv[13] = 0xFF;
+		iv[14] = 0xFF;
+		std::vector<byte> data(40960);
+		rng.GetBytes(data);
+		std::vector<byte> enc(data.size(), 0);
+		std::vector<byte> rnd(8);
+		Key::Symmetric::SymmetricKey k(key, iv);
+
+		// the sequential key stream
+		Cipher.ParallelProfile().IsParallel() = false;
+		Cipher.Initialize(true, k);
+		Cipher.Transform(data, 0, enc, 0, data.size());
+
+		// seek to random offsets, and transform a random length with the parallel profile enabled
+		Cipher.ParallelProfile().IsParallel() = true;
+		Cipher.ParallelProfile().ParallelBlockSize() = Cipher.ParallelProfile().ParallelMinimumSize();
+		Cipher.Initialize(true, k);
+
+		for (size_t i = 0; i < 100; ++i)
+		{
+			rng.GetBytes(rnd);
+			const size_t OFFSET = Utility::IntUtils::LeBytesTo32(rnd, 0) % data.size();
+			const size_t LENGTH = (Utility::IntUtils::LeBytesTo32(rnd, 4) % (data.size() - OFFSET)) + 1;
+			std::vector<byte> otp(LENGTH);
+
+			Cipher.Seek(OFFSET);
+			Cipher.Transform(data, OFFSET, otp, 0, LENGTH);
+
+			if (!std::equal(otp.begin(), otp.end(), enc.begin() + OFFSET))
+			{
+				throw TestException("CompareSeek: The key stream at the seek position is not equal!");
+			}
+		}
+
+		// consecutive transforms smaller than a block, starting within a block
+		std::vector<byte> otp(data.size());
+		const size_t OFFSET = (16 * 3) + 5;
+		Cipher.Seek(OFFSET);
+		Cipher.Transform(data, OFFSET, otp, OFFSET, 3);
+		Cipher.Transform(data, OFFSET + 3, otp, OFFSET + 3, 6);
+		Cipher.Transform(data, OFFSET + 9, otp, OFFSET + 9, 1000);
+
+		if (!std::equal(otp.begin() + OFFSET, otp.begin() + OFFSET + 1009, enc.begin() + OFFSET))
+		{
+			throw TestException("CompareSeek: The key stream at the seek position is not equal!");
+		}
+	}
+
 	void CipherModeTest::Initialize()
 	{
 		const std::vector<std::string> keys =
@@ -759,4 +1043,39 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void CipherModeTest::PointerTest()
+	{
+		std::vector<byte> key(32);
+		TestUtils::GetRandom(key);
+		std::vector<byte> iv(16);
+		TestUtils::GetRandom(iv);
+		Key::Symmetric::SymmetricKey k(key, iv);
+		std::vector<Mode::ICipherMode*> modes = {
+			new Mode::CBC(BlockCiphers::Rijndael),
+			new Mode::CFB(BlockCiphers::Rijndael),
+			new Mode::CTR(BlockCiphers::Rijndael),
+			new Mode::ECB(BlockCiphers::Rijndael),
+			new Mode::ICM(BlockCiphers::Rijndael),
+			new Mode::OFB(BlockCiphers::Rijndael) };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < modes.size(); ++i)
+		{
+			for (size_t j = 0; j < 2; ++j)
+			{
+				const bool ENCRYPT = (j == 0);
+				// below and above the parallel block size
+				isEqual &= TestUtils::ComparePointerTransform(modes[i], [&modes, i, ENCRYPT, &k]() { modes[i]->Initialize(ENCRYPT, k); }, 16 * 67);
+				isEqual &= TestUtils::ComparePointerTransform(modes[i], [&modes, i, ENCRYPT, &k]() { modes[i]->Initialize(ENCRYPT, k); }, modes[i]->ParallelBlockSize() + (16 * 67));
+			}
+
+			delete modes[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("CipherModeTest: The pointer and vector transforms are not equal!");
+		}
+	}
 }
@@ -53,13 +53,20 @@ namespace Test
         
     private:
 
+		void CompareBatch();
+		void CompareBatchCBC();
 		void CompareCBC(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
 		void CompareCFB(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
 		void CompareCTR(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
 		void CompareECB(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
 		void CompareOFB(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
+		template<typename T>
+		void CompareScheduler(T &Cipher, bool Encryption);
+		template<typename T>
+		void CompareSeek(T &Cipher);
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
     };
 }
 
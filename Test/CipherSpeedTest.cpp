@@ -17,6 +17,7 @@
 #include "../CEX/GCM.h"
 #include "../CEX/OCB.h"
 #include "../CEX/ChaCha20.h"
+#include "../CEX/ChaCha20Poly1305.h"
 #include "../CEX/Salsa20.h"
 #include "../CEX/SHA512.h"
 
@@ -125,7 +126,7 @@ namespace Test
 			OFBSpeedTest(engine, true, false);
 
 			OnProgress(std::string("### AEAD Authenticated Cipher Modes ###"));
-			OnProgress(std::string("### Tests speeds of EAX, GCM, and OCB authenticated modes"));
+			OnProgress(std::string("### Tests speeds of EAX, GCM, OCB, and ChaCha20Poly1305 authenticated modes"));
 			OnProgress(std::string("### Uses the standard rounds and a 256 bit key"));
 			OnProgress(std::string(""));
 
@@ -144,6 +145,11 @@ namespace Test
 			OnProgress(std::string("***AES-OCB Parallel Encryption***"));
 			OCBSpeedTest(engine, true, true);
 
+			OnProgress(std::string("***ChaCha20Poly1305 Sequential Encryption***"));
+			ChaCha20Poly1305SpeedTest(true, false);
+			OnProgress(std::string("***ChaCha20Poly1305 Parallel Encryption***"));
+			ChaCha20Poly1305SpeedTest(true, true);
+
 			if (engine != nullptr)
 			{
 				delete engine;
@@ -250,6 +256,13 @@ namespace Test
 
 	//*** IEAD Mode Tests ***//
 
+	void CipherSpeedTest::ChaCha20Poly1305SpeedTest(bool Encrypt, bool Parallel)
+	{
+		Mode::ChaCha20Poly1305* cipher = new Mode::ChaCha20Poly1305();
+		ParallelBlockLoop(cipher, Encrypt, Parallel, MB100, 32, 12, 10, m_progressEvent);
+		delete cipher;
+	}
+
 	void CipherSpeedTest::EAXSpeedTest(IBlockCipher* Engine, bool Encrypt, bool Parallel)
 	{
 		Mode::EAX* cipher = new Mode::EAX(Engine);
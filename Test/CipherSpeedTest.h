@@ -137,6 +137,7 @@ namespace Test
 		void CBCSpeedTest(Cipher::Symmetric::Block::IBlockCipher* Engine, bool Encrypt, bool Parallel);
 		void CFBSpeedTest(Cipher::Symmetric::Block::IBlockCipher* Engine, bool Encrypt, bool Parallel);
 		void CTRSpeedTest(Cipher::Symmetric::Block::IBlockCipher* Engine, bool Encrypt, bool Parallel);
+		void ChaCha20Poly1305SpeedTest(bool Encrypt, bool Parallel);
 		void ChaChaSpeedTest();
 		void CounterSpeedTest();
 		void EAXSpeedTest(Cipher::Symmetric::Block::IBlockCipher* Engine, bool Encrypt, bool Parallel);
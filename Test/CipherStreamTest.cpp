@@ -1,8 +1,13 @@
 #include "CipherStreamTest.h"
 #include "../CEX/CipherStream.h"
 #include "../CEX/FileStream.h"
+#include "../CEX/AsyncFileStream.h"
+#include "../CEX/MappedFileStream.h"
+#include "../CEX/SegmentedStream.h"
 #include "../CEX/MemoryStream.h"
+#include "../CEX/ProgressNotifier.h"
 #include "../CEX/SecureRandom.h"
+#include "../CEX/StreamWriter.h"
 #include "../CEX/CTR.h"
 #include "../CEX/CBC.h"
 #include "../CEX/CFB.h"
@@ -17,6 +22,7 @@
 #include "../CEX/THX.h"
 #include "../CEX/ChaCha20.h"
 #include "../CEX/Salsa20.h"
+#include <cstdio>
 
 namespace Test
 {
@@ -117,6 +123,53 @@ namespace Test
 			OnProgress(std::string("Passed Salsa20 CipherStream test.."));
 			OnProgress(std::string(""));
 
+			OnProgress(std::string("***Testing Pipelined Streams***"));
+			Cipher::Symmetric::Block::RHX* pip = new Cipher::Symmetric::Block::RHX();
+			PipelineTest(new CTR(pip), nullptr);
+			OnProgress(std::string("Passed CTR pipelined CipherStream test.."));
+			PipelineTest(new CBC(pip), new ISO7816());
+			OnProgress(std::string("Passed CBC pipelined CipherStream test.."));
+			delete pip;
+			PipelineTest(new Cipher::Symmetric::Stream::ChaCha20());
+			OnProgress(std::string("Passed ChaCha20 pipelined CipherStream test.."));
+			OnProgress(std::string(""));
+
+			OnProgress(std::string("***Testing Mapped File Streams***"));
+			Cipher::Symmetric::Block::RHX* mpe = new Cipher::Symmetric::Block::RHX();
+			MappedStreamTest(new CTR(mpe), nullptr);
+			OnProgress(std::string("Passed CTR mapped file CipherStream test.."));
+			MappedStreamTest(new CBC(mpe), new ISO7816());
+			OnProgress(std::string("Passed CBC mapped file CipherStream test.."));
+			delete mpe;
+			OnProgress(std::string(""));
+
+			OnProgress(std::string("***Testing Asynchronous File Streams***"));
+			Cipher::Symmetric::Block::RHX* ase = new Cipher::Symmetric::Block::RHX();
+			AsyncStreamTest(new CTR(ase), nullptr);
+			OnProgress(std::string("Passed CTR asynchronous file CipherStream test.."));
+			AsyncStreamTest(new CBC(ase), new ISO7816());
+			OnProgress(std::string("Passed CBC asynchronous file CipherStream test.."));
+			delete ase;
+			OnProgress(std::string(""));
+
+			OnProgress(std::string("***Testing Segmented Streams***"));
+			Cipher::Symmetric::Block::RHX* sge = new Cipher::Symmetric::Block::RHX();
+			SegmentedStreamTest(new CTR(sge), nullptr);
+			OnProgress(std::string("Passed CTR segmented CipherStream test.."));
+			SegmentedStreamTest(new CBC(sge), new ISO7816());
+			OnProgress(std::string("Passed CBC segmented CipherStream test.."));
+			delete sge;
+			OnProgress(std::string(""));
+
+			OnProgress(std::string("***Testing Progress Counters***"));
+			Cipher::Symmetric::Block::RHX* pge = new Cipher::Symmetric::Block::RHX();
+			ProgressTest(new CTR(pge), nullptr);
+			OnProgress(std::string("Passed CTR CipherStream progress test.."));
+			ProgressTest(new CBC(pge), new ISO7816());
+			OnProgress(std::string("Passed CBC CipherStream progress test.."));
+			delete pge;
+			OnProgress(std::string(""));
+
 			OnProgress(std::string("***Testing Cipher Description Initialization***"));
 			Processing::CipherDescription cd(
 				BlockCiphers::Rijndael,		// cipher engine
@@ -642,6 +695,80 @@ namespace Test
 		m_processorCount = Utility::ParallelUtils::ProcessorCount();
 	}
 
+	void CipherStreamTest::MappedStreamTest(Cipher::Symmetric::Block::Mode::ICipherMode* Cipher, Cipher::Symmetric::Block::Padding::IPadding* Padding)
+	{
+		const std::string PLNFILE = "CipherStreamTest.pln.tmp";
+		const std::string ENCFILE = "CipherStreamTest.enc.tmp";
+		const std::string DECFILE = "CipherStreamTest.dec.tmp";
+
+		AllocateRandom(m_iv, 16);
+		AllocateRandom(m_key, 32);
+		Key::Symmetric::SymmetricKey kp(m_key, m_iv);
+		Processing::CipherStream cs(Cipher, Padding);
+		const size_t PRLBLK = cs.ParallelBlockSize();
+		const size_t BLKLEN = Cipher->BlockSize();
+
+		// an unaligned tail, an exact multiple of the parallel block, a single parallel block, and a parallel block with a one block tail
+		const size_t SMPLEN[4] = { PRLBLK * 3 + 45, PRLBLK * 2, PRLBLK, PRLBLK + BLKLEN };
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			AllocateRandom(m_plnText, SMPLEN[i]);
+			// an aligned message is not padded, a final byte that is not a pad value keeps it from being stripped on decryption
+			m_plnText[m_plnText.size() - 1] = 0x01;
+
+			// memory stream reference
+			IO::MemoryStream mIn(m_plnText);
+			IO::MemoryStream mExp;
+			cs.Initialize(true, kp);
+			cs.Write(&mIn, &mExp);
+
+			IO::MappedFileStream* fPln = new IO::MappedFileStream(PLNFILE, IO::MappedFileStream::FileAccess::Write);
+			fPln->Write(m_plnText, 0, m_plnText.size());
+			delete fPln;
+
+			fPln = new IO::MappedFileStream(PLNFILE, IO::MappedFileStream::FileAccess::Read);
+			IO::MappedFileStream* fEnc = new IO::MappedFileStream(ENCFILE, IO::MappedFileStream::FileAccess::Write);
+			cs.Initialize(true, kp);
+			cs.Write(fPln, fEnc);
+			delete fPln;
+			delete fEnc;
+
+			fEnc = new IO::MappedFileStream(ENCFILE, IO::MappedFileStream::FileAccess::Read);
+			std::vector<byte> encText(static_cast<size_t>(fEnc->Length()));
+			fEnc->Read(encText, 0, encText.size());
+
+			if (encText != mExp.ToArray())
+			{
+				delete fEnc;
+				throw TestException("CipherStreamTest: Mapped file encryption output is not equal!");
+			}
+
+			fEnc->Seek(0, IO::SeekOrigin::Begin);
+			IO::MappedFileStream* fDec = new IO::MappedFileStream(DECFILE, IO::MappedFileStream::FileAccess::Write);
+			cs.Initialize(false, kp);
+			cs.Write(fEnc, fDec);
+			delete fEnc;
+			delete fDec;
+
+			fDec = new IO::MappedFileStream(DECFILE, IO::MappedFileStream::FileAccess::Read);
+			m_decText.resize(static_cast<size_t>(fDec->Length()));
+			fDec->Read(m_decText, 0, m_decText.size());
+			delete fDec;
+
+			if (m_decText != m_plnText)
+			{
+				throw TestException("CipherStreamTest: Mapped file decryption output is not equal!");
+			}
+		}
+
+		std::remove(PLNFILE.c_str());
+		std::remove(ENCFILE.c_str());
+		std::remove(DECFILE.c_str());
+		delete Cipher;
+		delete Padding;
+	}
+
 	void CipherStreamTest::MemoryStreamTest()
 	{
 		IO::MemoryStream ms;
@@ -844,6 +971,100 @@ namespace Test
 		delete engine;
 	}
 
+	void CipherStreamTest::PipelineTest(Cipher::Symmetric::Block::Mode::ICipherMode* Cipher, Cipher::Symmetric::Block::Padding::IPadding* Padding)
+	{
+		AllocateRandom(m_iv, 16);
+		AllocateRandom(m_key, 32);
+		Key::Symmetric::SymmetricKey kp(m_key, m_iv);
+		Processing::CipherStream cs(Cipher, Padding);
+		const size_t PRLBLK = cs.ParallelBlockSize();
+
+		// multiple ring cycles, a full final chunk, and a padded tail
+		const size_t SMPLEN[3] = { PRLBLK * 9 + 37, PRLBLK * 4, PRLBLK + 1 };
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			AllocateRandom(m_plnText, SMPLEN[i]);
+			// the full final chunk is not padded, a last byte of 0x01 can not be mistaken for an ISO7816 pad
+			m_plnText[m_plnText.size() - 1] = 0x01;
+
+			for (size_t j = 0; j < 2; ++j)
+			{
+				cs.ParallelProfile().IsParallel() = (j != 0);
+				IO::MemoryStream mIn(m_plnText);
+				IO::MemoryStream mExp;
+				IO::MemoryStream mOut;
+				IO::MemoryStream mRes;
+
+				// sequential reference
+				cs.PipelineDepth() = 0;
+				cs.Initialize(true, kp);
+				cs.Write(&mIn, &mExp);
+
+				mIn.Seek(0, IO::SeekOrigin::Begin);
+				cs.PipelineDepth() = 3;
+				cs.Initialize(true, kp);
+				cs.Write(&mIn, &mOut);
+
+				if (mOut.ToArray() != mExp.ToArray())
+				{
+					throw TestException("CipherStreamTest: Pipelined encryption output is not equal!");
+				}
+
+				mOut.Seek(0, IO::SeekOrigin::Begin);
+				cs.PipelineDepth() = 2;
+				cs.Initialize(false, kp);
+				cs.Write(&mOut, &mRes);
+
+				if (mRes.ToArray() != m_plnText)
+				{
+					throw TestException("CipherStreamTest: Pipelined decryption output is not equal!");
+				}
+			}
+		}
+
+		delete Cipher;
+		delete Padding;
+	}
+
+	void CipherStreamTest::PipelineTest(Cipher::Symmetric::Stream::IStreamCipher* Cipher)
+	{
+		AllocateRandom(m_iv, 8);
+		AllocateRandom(m_key, 32);
+		Key::Symmetric::SymmetricKey kp(m_key, m_iv);
+		Processing::CipherStream cs(Cipher);
+		const size_t PRLBLK = cs.ParallelBlockSize();
+
+		AllocateRandom(m_plnText, PRLBLK * 7 + 101);
+		IO::MemoryStream mIn(m_plnText);
+		IO::MemoryStream mExp;
+		IO::MemoryStream mOut;
+		IO::MemoryStream mRes;
+
+		cs.Initialize(true, kp);
+		cs.Write(&mIn, &mExp);
+
+		mIn.Seek(0, IO::SeekOrigin::Begin);
+		cs.PipelineDepth() = 4;
+		cs.Initialize(true, kp);
+		cs.Write(&mIn, &mOut);
+
+		if (mOut.ToArray() != mExp.ToArray())
+		{
+			throw TestException("CipherStreamTest: Pipelined encryption output is not equal!");
+		}
+
+		mOut.Seek(0, IO::SeekOrigin::Begin);
+		cs.Initialize(false, kp);
+		cs.Write(&mOut, &mRes);
+		delete Cipher;
+
+		if (mRes.ToArray() != m_plnText)
+		{
+			throw TestException("CipherStreamTest: Pipelined decryption output is not equal!");
+		}
+	}
+
 	void CipherStreamTest::OfbModeTest()
 	{
 		AllocateRandom(m_iv, 16);
@@ -936,6 +1157,89 @@ namespace Test
 		delete padding;
 	}
 
+	void CipherStreamTest::SegmentedStreamTest(Cipher::Symmetric::Block::Mode::ICipherMode* Cipher, Cipher::Symmetric::Block::Padding::IPadding* Padding)
+	{
+		AllocateRandom(m_iv, 16);
+		AllocateRandom(m_key, 32);
+		Key::Symmetric::SymmetricKey kp(m_key, m_iv);
+		Processing::CipherStream cs(Cipher, Padding);
+		const size_t PRLBLK = cs.ParallelBlockSize();
+
+		// an unaligned tail, an exact multiple of the segment size, and a single partial segment
+		const size_t SMPLEN[3] = { PRLBLK * 3 + 45, 4096, 100 };
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			AllocateRandom(m_plnText, SMPLEN[i]);
+			// 4096 bytes is block aligned and is not padded, the final byte is set so decryption finds no pad to strip
+			m_plnText[m_plnText.size() - 1] = 0x01;
+
+			// memory stream reference
+			IO::MemoryStream mIn(m_plnText);
+			IO::MemoryStream mExp;
+			cs.Initialize(true, kp);
+			cs.Write(&mIn, &mExp);
+
+			// segmented input and output, with differing segment sizes
+			IO::SegmentedStream sPln(m_plnText, 1024);
+			IO::SegmentedStream sEnc(192);
+			cs.Initialize(true, kp);
+			cs.Write(&sPln, &sEnc);
+
+			if (sEnc.ToArray() != mExp.ToArray())
+			{
+				throw TestException("CipherStreamTest: Segmented stream encryption output is not equal!");
+			}
+
+			// segmented input to a memory stream
+			IO::MemoryStream mEnc;
+			sPln.Seek(0, IO::SeekOrigin::Begin);
+			cs.Initialize(true, kp);
+			cs.Write(&sPln, &mEnc);
+
+			if (mEnc.ToArray() != mExp.ToArray())
+			{
+				throw TestException("CipherStreamTest: Segmented stream encryption output is not equal!");
+			}
+
+			// decrypt into a reused stream, the released segments are taken from the pool
+			sEnc.Seek(0, IO::SeekOrigin::Begin);
+			sPln.Reset();
+			cs.Initialize(false, kp);
+			cs.Write(&sEnc, &sPln);
+
+			if (sPln.ToArray() != m_plnText)
+			{
+				throw TestException("CipherStreamTest: Segmented stream decryption output is not equal!");
+			}
+
+			// a writer over the segmented stream copies each segment into its state
+			IO::StreamWriter writer(sPln);
+
+			if (writer.GetBytes() != m_plnText)
+			{
+				throw TestException("CipherStreamTest: Segmented stream writer state is not equal!");
+			}
+
+			// shortening clears the removed bytes, extending exposes them as zeroes
+			const ulong HLFLEN = sPln.Length() / 2;
+			sPln.SetLength(HLFLEN);
+			sPln.SetLength(HLFLEN * 2);
+			m_decText = sPln.ToArray();
+
+			for (size_t j = 0; j < m_decText.size(); ++j)
+			{
+				if (m_decText[j] != (j < HLFLEN ? m_plnText[j] : 0))
+				{
+					throw TestException("CipherStreamTest: Segmented stream length change is invalid!");
+				}
+			}
+		}
+
+		delete Cipher;
+		delete Padding;
+	}
+
 	void CipherStreamTest::SerializeStructTest()
 	{
 		using namespace Enumeration;
@@ -1193,6 +1497,120 @@ namespace Test
 		return (int)Data.size();
 	}
 
+	void CipherStreamTest::AsyncStreamTest(Cipher::Symmetric::Block::Mode::ICipherMode* Cipher, Cipher::Symmetric::Block::Padding::IPadding* Padding)
+	{
+		const std::string PLNFILE = "CipherStreamTest.pln.tmp";
+		const std::string ENCFILE = "CipherStreamTest.enc.tmp";
+		const std::string DECFILE = "CipherStreamTest.dec.tmp";
+		// buffered i/o, direct i/o, and a single request in flight without the ring
+		const bool DIRECT[3] = { false, true, false };
+		const size_t QUEDEPTH[3] = { 16, 16, 1 };
+
+		AllocateRandom(m_iv, 16);
+		AllocateRandom(m_key, 32);
+		Key::Symmetric::SymmetricKey kp(m_key, m_iv);
+		Processing::CipherStream cs(Cipher, Padding);
+		const size_t PRLBLK = cs.ParallelBlockSize();
+
+		// several request chunks with an unaligned tail, and an exact multiple of the parallel block
+		const size_t SMPLEN[2] = { (128 * 1024 * 5) + 45, PRLBLK * 2 };
+		IO::AsyncFileStream* fDec = nullptr;
+		IO::AsyncFileStream* fEnc = nullptr;
+		IO::AsyncFileStream* fPln = nullptr;
+
+		try
+		{
+			for (size_t i = 0; i < 2; ++i)
+			{
+				AllocateRandom(m_plnText, SMPLEN[i]);
+				// the aligned message carries no padding, so its last byte must not read as an ISO7816 pad
+				m_plnText[m_plnText.size() - 1] = 0x01;
+
+				// memory stream reference
+				IO::MemoryStream mIn(m_plnText);
+				IO::MemoryStream mExp;
+				cs.Initialize(true, kp);
+				cs.Write(&mIn, &mExp);
+
+				for (size_t j = 0; j < 3; ++j)
+				{
+					// the plaintext is written and read back through the write-behind and read-ahead buffers
+					fPln = new IO::AsyncFileStream(PLNFILE, IO::AsyncFileStream::FileAccess::ReadWrite, false, QUEDEPTH[j]);
+					fPln->Write(m_plnText, 0, m_plnText.size());
+					// a read-write stream retains the previous contents
+					fPln->SetLength(m_plnText.size());
+					fPln->Seek(0, IO::SeekOrigin::Begin);
+					m_cmpText.resize(m_plnText.size());
+					fPln->Read(m_cmpText, 0, m_cmpText.size());
+					delete fPln;
+					fPln = nullptr;
+
+					if (m_cmpText != m_plnText)
+					{
+						throw TestException("CipherStreamTest: Asynchronous file stream output is not equal!");
+					}
+
+					fPln = new IO::AsyncFileStream(PLNFILE, IO::AsyncFileStream::FileAccess::Read, DIRECT[j], QUEDEPTH[j]);
+					fEnc = new IO::AsyncFileStream(ENCFILE, IO::AsyncFileStream::FileAccess::Write, DIRECT[j], QUEDEPTH[j]);
+					cs.Initialize(true, kp);
+					cs.Write(fPln, fEnc);
+					delete fPln;
+					fPln = nullptr;
+					delete fEnc;
+					fEnc = nullptr;
+
+					fEnc = new IO::AsyncFileStream(ENCFILE, IO::AsyncFileStream::FileAccess::Read, DIRECT[j], QUEDEPTH[j]);
+					std::vector<byte> encText(static_cast<size_t>(fEnc->Length()));
+					fEnc->Read(encText, 0, encText.size());
+
+					if (encText != mExp.ToArray())
+					{
+						throw TestException("CipherStreamTest: Asynchronous file encryption output is not equal!");
+					}
+
+					fEnc->Seek(0, IO::SeekOrigin::Begin);
+					fDec = new IO::AsyncFileStream(DECFILE, IO::AsyncFileStream::FileAccess::Write, DIRECT[j], QUEDEPTH[j]);
+					cs.Initialize(false, kp);
+					cs.Write(fEnc, fDec);
+					delete fEnc;
+					fEnc = nullptr;
+					delete fDec;
+					fDec = nullptr;
+
+					fDec = new IO::AsyncFileStream(DECFILE, IO::AsyncFileStream::FileAccess::Read, DIRECT[j], QUEDEPTH[j]);
+					m_decText.resize(static_cast<size_t>(fDec->Length()));
+					fDec->Read(m_decText, 0, m_decText.size());
+					delete fDec;
+					fDec = nullptr;
+
+					if (m_decText != m_plnText)
+					{
+						throw TestException("CipherStreamTest: Asynchronous file decryption output is not equal!");
+					}
+				}
+			}
+		}
+		catch (...)
+		{
+			// close the streams so the temporary files can be removed
+			delete fPln;
+			delete fEnc;
+			delete fDec;
+			std::remove(PLNFILE.c_str());
+			std::remove(ENCFILE.c_str());
+			std::remove(DECFILE.c_str());
+			delete Cipher;
+			delete Padding;
+			throw;
+		}
+
+		std::remove(PLNFILE.c_str());
+		std::remove(ENCFILE.c_str());
+		std::remove(DECFILE.c_str());
+		delete Cipher;
+		delete Padding;
+	}
+
 	void CipherStreamTest::BlockCTR(Cipher::Symmetric::Block::Mode::ICipherMode* Cipher, const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset)
 	{
 		const size_t INPSZE = Input.size() - InOffset;
@@ -1273,4 +1691,69 @@ namespace Test
 		const size_t INPSZE = Input.size() - InOffset;
 		Cipher->Transform(Input, InOffset, Output, OutOffset, INPSZE);
 	}
+
+	void CipherStreamTest::ProgressTest(Cipher::Symmetric::Block::Mode::ICipherMode* Cipher, Cipher::Symmetric::Block::Padding::IPadding* Padding)
+	{
+		// records each percentage raised by the notifier
+		class PercentListener : public Routing::Delegate<int>
+		{
+		public:
+			std::vector<int> Values;
+
+			void operator()(int Percent) override
+			{
+				Values.push_back(Percent);
+			}
+		};
+
+		AllocateRandom(m_iv, 16);
+		AllocateRandom(m_key, 32);
+		Key::Symmetric::SymmetricKey kp(m_key, m_iv);
+		Processing::CipherStream cs(Cipher, Padding);
+		const size_t PRLBLK = cs.ParallelBlockSize();
+
+		AllocateRandom(m_plnText, PRLBLK * 3 + 37);
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			cs.ParallelProfile().IsParallel() = (i != 0);
+			PercentListener lst;
+			Routing::ProgressNotifier ntf(cs.Progress(), 1);
+			ntf.ProgressPercent += &lst;
+			IO::MemoryStream mIn(m_plnText);
+			IO::MemoryStream mOut;
+			IO::MemoryStream mRes;
+
+			cs.Initialize(true, kp);
+			ntf.Start();
+			cs.Write(&mIn, &mOut);
+			ntf.Stop();
+
+			if (cs.Progress().Processed() != m_plnText.size() || cs.Progress().Total() != m_plnText.size())
+			{
+				throw TestException("CipherStreamTest: Progress count is not equal to the input length!");
+			}
+			if (lst.Values.size() == 0 || lst.Values.back() != 100)
+			{
+				throw TestException("CipherStreamTest: Progress notifier did not raise the final percentage!");
+			}
+
+			// the counter is reset by each operation
+			mOut.Seek(0, IO::SeekOrigin::Begin);
+			cs.Initialize(false, kp);
+			cs.Write(&mOut, &mRes);
+
+			if (cs.Progress().Processed() != mOut.Length() || cs.Progress().Percent() != 100)
+			{
+				throw TestException("CipherStreamTest: Progress count is not equal to the input length!");
+			}
+			if (mRes.ToArray() != m_plnText)
+			{
+				throw TestException("CipherStreamTest: Progress test output is not equal!");
+			}
+		}
+
+		delete Cipher;
+		delete Padding;
+	}
 }
@@ -2,8 +2,13 @@
 #include "../CEX/SecureRandom.h"
 #include "../CEX/DigestStream.h"
 #include "../CEX/DigestFromName.h"
+#include "../CEX/FileStream.h"
 #include "../CEX/MemoryStream.h"
+#include "../CEX/ParallelUtils.h"
 #include "../CEX/IByteStream.h"
+#include "../CEX/MappedFileStream.h"
+#include "../CEX/SegmentedStream.h"
+#include <cstdio>
 
 namespace Test
 {
@@ -28,6 +33,15 @@ namespace Test
 			CompareOutput(Enumeration::Digests::SHA512);
 			OnProgress(std::string("Passed DigestStream SHA512 comparison tests.."));
 
+			BatchTest(Enumeration::Digests::SHA256);
+			OnProgress(std::string("Passed DigestStream SHA256 batch tests.."));
+
+			BatchTest(Enumeration::Digests::Keccak512);
+			OnProgress(std::string("Passed DigestStream Keccak512 batch tests.."));
+
+			BatchTest(Enumeration::Digests::Blake512);
+			OnProgress(std::string("Passed DigestStream Blake512 batch tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -40,6 +54,110 @@ namespace Test
 		}
 	}
 
+	void DigestStreamTest::BatchTest(Enumeration::Digests Engine)
+	{
+		const size_t MSGCNT = 150;
+		const size_t FILCNT = 4;
+		Prng::SecureRandom rnd;
+		std::vector<std::vector<byte>> msgData(MSGCNT);
+		std::vector<std::vector<byte>> expCodes(MSGCNT);
+		std::vector<IO::IByteStream*> msgStreams(MSGCNT);
+
+		// mostly small messages, every fifth is larger than the multi-buffer threshold, and an empty message
+		for (size_t i = 0; i < MSGCNT; ++i)
+		{
+			msgData[i].resize(i == 0 ? 0 : (i % 5 == 0) ? rnd.NextUInt32(100000, 20000) : rnd.NextUInt32(4000, 1));
+
+			if (msgData[i].size() != 0)
+			{
+				rnd.GetBytes(msgData[i]);
+			}
+		}
+
+		// digest instance for baseline
+		Digest::IDigest* eng = Helper::DigestFromName::GetInstance(Engine);
+
+		for (size_t i = 0; i < MSGCNT; ++i)
+		{
+			expCodes[i].resize(eng->DigestSize());
+			eng->Compute(msgData[i], expCodes[i]);
+		}
+
+		delete eng;
+
+		Processing::DigestStream ds(Engine);
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				msgStreams[j] = new IO::MemoryStream(msgData[j]);
+			}
+
+			std::vector<std::vector<byte>> batCodes = ds.ComputeBatch(msgStreams, i == 0);
+
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				delete msgStreams[j];
+			}
+
+			if (batCodes != expCodes)
+			{
+				throw TestException("DigestStreamTest: Batch hash is not equal!");
+			}
+
+			size_t ttlLen = 0;
+
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				ttlLen += msgData[j].size();
+			}
+
+			if (ds.Progress().Processed() != ttlLen || ds.Progress().Percent() != 100)
+			{
+				throw TestException("DigestStreamTest: Batch progress is not equal to the input length!");
+			}
+		}
+
+		// test the file method
+		std::vector<std::string> fileNames(FILCNT);
+
+		for (size_t i = 0; i < FILCNT; ++i)
+		{
+			fileNames[i] = "DigestStreamTest" + std::to_string(i) + ".tmp";
+			IO::FileStream fOut(fileNames[i], IO::FileStream::FileAccess::Write);
+			fOut.Write(msgData[i + 4], 0, msgData[i + 4].size());
+			fOut.Close();
+		}
+
+		std::vector<std::vector<byte>> filCodes = ds.ComputeBatch(fileNames, true);
+
+		for (size_t i = 0; i < FILCNT; ++i)
+		{
+			std::remove(fileNames[i].c_str());
+
+			if (filCodes[i] != expCodes[i + 4])
+			{
+				throw TestException("DigestStreamTest: Batch file hash is not equal!");
+			}
+		}
+
+		// a parallel digest hashes the batch in turn, and matches its own Compute output
+		if (Utility::ParallelUtils::ProcessorCount() > 1)
+		{
+			Processing::DigestStream dsp(Engine, true);
+			IO::MemoryStream msp(msgData[5]);
+			std::vector<byte> prlCode = dsp.Compute(&msp);
+			msp.Seek(0, IO::SeekOrigin::Begin);
+			std::vector<IO::IByteStream*> prlStreams(1, &msp);
+
+			if (dsp.ComputeBatch(prlStreams, true)[0] != prlCode)
+			{
+				throw TestException("DigestStreamTest: Parallel batch hash is not equal!");
+			}
+		}
+	}
+
 	void DigestStreamTest::CompareOutput(Enumeration::Digests Engine)
 	{
 		Prng::SecureRandom rnd;
@@ -71,6 +189,31 @@ namespace Test
 		{
 			throw TestException("DigestStreamTest: Expected hash is not equal!");
 		}
+
+		// test the mapped file method
+		const std::string FILENAME = "DigestStreamTest.tmp";
+		IO::MappedFileStream* fOut = new IO::MappedFileStream(FILENAME, IO::MappedFileStream::FileAccess::Write);
+		fOut->Write(data, 0, data.size());
+		delete fOut;
+
+		IO::MappedFileStream* fIn = new IO::MappedFileStream(FILENAME, IO::MappedFileStream::FileAccess::Read);
+		hash2 = ds.Compute(fIn);
+		delete fIn;
+		std::remove(FILENAME.c_str());
+
+		if (hash1 != hash2)
+		{
+			throw TestException("DigestStreamTest: Expected hash is not equal!");
+		}
+
+		// test the segmented stream method
+		IO::SegmentedStream sIn(data, 1024);
+		hash2 = ds.Compute(&sIn);
+
+		if (hash1 != hash2)
+		{
+			throw TestException("DigestStreamTest: Expected hash is not equal!");
+		}
 	}
 
 	void DigestStreamTest::OnProgress(std::string Data)
@@ -52,6 +52,7 @@ namespace Test
 
 	private:
 
+		void BatchTest(Enumeration::Digests Engine);
 		void CompareOutput(Enumeration::Digests Engine);
 		void OnProgress(std::string Data);
 	};
@@ -45,6 +45,8 @@ namespace Test
 			}
 
 			OnProgress(std::string("GMACTest: Passed GMAC known answer vector tests.."));
+			PointerTest();
+			OnProgress(std::string("GMACTest: Passed pointer and vector update equivalence tests.."));
 
 			return SUCCESS;
 		}
@@ -146,4 +148,29 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void GMACTest::PointerTest()
+	{
+		std::vector<byte> key(32);
+		TestUtils::GetRandom(key);
+		std::vector<byte> iv(12);
+		TestUtils::GetRandom(iv);
+		Key::Symmetric::SymmetricKey kp(key, iv);
+		std::vector<Mac::IMac*> generators = {
+			new Mac::GMAC(Enumeration::BlockCiphers::Rijndael) };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < generators.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 5000);
+			delete generators[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("GMACTest: The pointer and vector updates are not equal!");
+		}
+	}
 }
@@ -58,6 +58,7 @@ namespace Test
 		void GMACCompare(std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &PlainText, std::vector<byte> &MacCode);
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
 	};
 }
 
@@ -57,6 +57,8 @@ namespace Test
 
 			CompareAccess(m_keys[3]);
 			OnProgress(std::string("Passed Finalize/Compute methods output comparison.."));
+			PointerTest();
+			OnProgress(std::string("Passed pointer and vector update equivalence tests.."));
 
 			return SUCCESS;
 		}
@@ -229,4 +231,28 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void HMACTest::PointerTest()
+	{
+		std::vector<byte> key(64);
+		TestUtils::GetRandom(key);
+		Key::Symmetric::SymmetricKey kp(key);
+		std::vector<Mac::IMac*> generators = {
+			new Mac::HMAC(Enumeration::Digests::SHA256),
+			new Mac::HMAC(Enumeration::Digests::SHA512) };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < generators.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 5000);
+			delete generators[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("HMACTest: The pointer and vector updates are not equal!");
+		}
+	}
 }
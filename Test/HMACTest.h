@@ -58,6 +58,7 @@ namespace Test
 		void CompareVector512(std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Expected);
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
 	};
 }
 
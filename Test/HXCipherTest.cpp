@@ -53,6 +53,8 @@ namespace Test
 			{
 				AHXMonteCarlo();
 				OnProgress(std::string("AHX: Passed AES-NI Monte Carlo tests.."));
+				AHXKernelTest();
+				OnProgress(std::string("AHX: Passed AES-NI and VAES kernel width comparisons with RHX.."));
 			}
 #endif
 			RHXMonteCarlo();
@@ -61,6 +63,8 @@ namespace Test
 			OnProgress(std::string("SHX: Passed SHX Monte Carlo tests.."));
 			THXMonteCarlo();
 			OnProgress(std::string("THX: Passed THX Monte Carlo tests.."));
+			PointerTest();
+			OnProgress(std::string("HXCipherTest: Passed pointer and vector transform equivalence tests.."));
 
 			return SUCCESS;
 		}
@@ -120,7 +124,106 @@ namespace Test
 		m_progressEvent(Data);
 	}
 
+	void HXCipherTest::PointerTest()
+	{
+		Common::CpuDetect detect;
+		std::vector<byte> key(32);
+		TestUtils::GetRandom(key);
+		Key::Symmetric::SymmetricKey k(key);
+		std::vector<IBlockCipher*> engines;
+		bool isEqual = true;
+
+#if defined(__AVX__)
+		if (detect.AESNI())
+		{
+			engines.push_back(new AHX());
+		}
+#endif
+		engines.push_back(new RHX());
+		engines.push_back(new SHX());
+		engines.push_back(new THX());
+
+		for (size_t i = 0; i < engines.size(); ++i)
+		{
+			// the encryption and decryption key schedules
+			for (size_t j = 0; j < 2; ++j)
+			{
+				engines[i]->Initialize(j == 0, k);
+				isEqual &= TestUtils::ComparePointerBlock(engines[i]);
+			}
+
+			delete engines[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("HXCipherTest: The pointer and vector transforms are not equal!");
+		}
+	}
+
 #if defined(__AVX__)
+	void HXCipherTest::AHXKernelTest()
+	{
+		const size_t BLKCNT = 16 * 8;
+		std::vector<byte> key(32);
+		TestUtils::GetRandom(key);
+		Key::Symmetric::SymmetricKey k(key);
+		std::vector<byte> inp(BLKCNT * 16);
+		TestUtils::GetRandom(inp);
+		const size_t WIDTHS[3] = { 128, 256, 512 };
+		Common::CpuDetect detect;
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			AHX eng;
+			eng.KernelWidth(WIDTHS[i]);
+
+			// the processor does not support this kernel
+			if (eng.KernelWidth() != WIDTHS[i])
+			{
+#if defined(CEX_HAS_VAES512)
+				// a build that targets the 512 bit kernel must select it on a capable processor
+				if (WIDTHS[i] == 512 && detect.VAES() && detect.AVX512F() && detect.OSAVX512())
+				{
+					throw TestException("AHX: The 512 bit kernel was not selected on a supporting processor!");
+				}
+#endif
+				continue;
+			}
+
+			for (size_t j = 0; j < 2; ++j)
+			{
+				RHX ref;
+				std::vector<byte> exp(inp.size());
+				std::vector<byte> otp1(inp.size());
+				std::vector<byte> otp2(inp.size());
+
+				eng.Initialize(j == 0, k);
+				ref.Initialize(j == 0, k);
+
+				for (size_t n = 0; n < BLKCNT; ++n)
+				{
+					ref.Transform(inp, n * 16, exp, n * 16);
+				}
+
+				for (size_t n = 0; n < BLKCNT; n += 16)
+				{
+					eng.Transform2048(inp, n * 16, otp2, n * 16);
+				}
+
+				for (size_t n = 0; n < BLKCNT; n += 8)
+				{
+					eng.Transform1024(inp, n * 16, otp1, n * 16);
+				}
+
+				if (otp1 != exp || otp2 != exp)
+				{
+					throw TestException("AHX: The " + std::to_string(WIDTHS[i]) + " bit kernel output does not match RHX!");
+				}
+			}
+		}
+	}
+
 	void HXCipherTest::AHXMonteCarlo()
 	{
 		std::vector<byte> inpBytes(16, 0);
@@ -56,7 +56,9 @@ namespace Test
 
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
 #if defined(__AVX__)
+		void AHXKernelTest();
 		void AHXMonteCarlo();
 #endif
 		void RHXMonteCarlo();
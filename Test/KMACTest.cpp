@@ -7,7 +7,7 @@ namespace Test
 	using Mac::KMAC;
 	using Key::Symmetric::SymmetricKey;
 
-	const std::string KMACTest::DESCRIPTION = "SP800-185 Test Vectors for KMAC-128 and KMAC-256.";
+	const std::string KMACTest::DESCRIPTION = "SP800-185 Test Vectors for KMAC-128, KMAC-256, KMACXOF-128, and KMACXOF-256.";
 	const std::string KMACTest::FAILURE = "FAILURE! ";
 	const std::string KMACTest::SUCCESS = "SUCCESS! All KMAC tests have executed succesfully.";
 
@@ -52,6 +52,24 @@ namespace Test
 
 			OnProgress(std::string("KMACTest: Passed KMAC-256 known answer vector tests.."));
 
+			KMAC* gen3 = new KMAC(Enumeration::ShakeModes::SHAKE128, true);
+			CompareVector(gen3, m_custom[0], m_message[0], m_expected[6]);
+			CompareVector(gen3, m_custom[1], m_message[0], m_expected[7]);
+			CompareVector(gen3, m_custom[1], m_message[1], m_expected[8]);
+			delete gen3;
+
+			OnProgress(std::string("KMACTest: Passed KMACXOF-128 known answer vector tests.."));
+
+			KMAC* gen4 = new KMAC(Enumeration::ShakeModes::SHAKE256, true);
+			CompareVector(gen4, m_custom[1], m_message[0], m_expected[9]);
+			CompareVector(gen4, m_custom[0], m_message[1], m_expected[10]);
+			CompareVector(gen4, m_custom[1], m_message[1], m_expected[11]);
+			delete gen4;
+
+			OnProgress(std::string("KMACTest: Passed KMACXOF-256 known answer vector tests.."));
+			PointerTest();
+			OnProgress(std::string("KMACTest: Passed pointer and vector update equivalence tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -122,8 +140,15 @@ namespace Test
 			std::string("20C570C31346F703C9AC36C61C03CB64C3970D0CFC787E9B79599D273A68D2F7F69D4CC3DE9D104A351689F27CF6F5951F0103F33F4F24871024D9C27773A8DD"),
 			std::string("75358CF39E41494E949707927CEE0AF20A3FF553904C86B08F21CC414BCFD691589D27CF5E15369CBBFF8B9A4C2EB17800855D0235FF635DA82533EC6B759B69"),
 			std::string("B58618F71F92E1D56C1B8C55DDD7CD188B97B4CA4D99831EB2699A837DA2E4D970FBACFDE50033AEA585F1A2708510C32D07880801BD182898FE476876FC8965"),
+			// kmacxof
+			std::string("CD83740BBD92CCC8CF032B1481A0F4460E7CA9DD12B08A0C4031178BACD6EC35"),
+			std::string("31A44527B4ED9F5C6101D11DE6D26F0620AA5C341DEF41299657FE9DF1A3B16C"),
+			std::string("47026C7CD793084AA0283C253EF658490C0DB61438B8326FE9BDDF281B83AE0F"),
+			std::string("1755133F1534752AAD0748F2C706FB5C784512CAB835CD15676B16C0C6647FA96FAA7AF634A0BF8FF6DF39374FA00FAD9A39E322A7C92065A64EB1FB0801EB2B"),
+			std::string("FF7B171F1E8A2B24683EED37830EE797538BA8DC563F6DA1E667391A75EDC02CA633079F81CE12A25F45615EC89972031D18337331D24CEB8F8CA8E6A19FD98B"),
+			std::string("D5BE731C954ED7732846BB59DBE3A8E30F83E77A4BFF4459F2F1C2B4ECEBB8CE67BA01C62E8AB8578D2D499BD1BB276768781190020A306A97DE281DCC30305D")
 		};
-		HexConverter::Decode(expected, 6, m_expected);
+		HexConverter::Decode(expected, 12, m_expected);
 
 		/*lint -restore */
 	}
@@ -132,4 +157,28 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void KMACTest::PointerTest()
+	{
+		std::vector<byte> key(32);
+		TestUtils::GetRandom(key);
+		Key::Symmetric::SymmetricKey kp(key);
+		std::vector<Mac::IMac*> generators = {
+			new KMAC(Enumeration::ShakeModes::SHAKE128),
+			new KMAC(Enumeration::ShakeModes::SHAKE256) };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < generators.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 5000);
+			delete generators[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("KMACTest: The pointer and vector updates are not equal!");
+		}
+	}
 }
@@ -59,6 +59,7 @@ namespace Test
 		void CompareVector(Mac::IMac* Generator, std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Expected);
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
 	};
 }
 
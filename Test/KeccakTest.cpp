@@ -49,6 +49,11 @@ namespace Test
 			TreeParamsTest();
 			OnProgress(std::string("KeccakTest: Passed KeccakParams parameter serialization test.."));
 
+			BatchTest();
+			OnProgress(std::string("KeccakTest: Passed SHA3 256/512 and Keccak 1024 multi-buffer batch tests.."));
+			PointerTest();
+			OnProgress(std::string("KeccakTest: Passed pointer and vector update equivalence tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -61,6 +66,88 @@ namespace Test
 		}
 	}
 
+	void KeccakTest::BatchTest()
+	{
+		// the vector messages hashed as one batch
+		std::vector<std::vector<byte>> out;
+		Keccak256 dgt256;
+		Keccak512 dgt512;
+		Keccak1024 dgt1024;
+
+		dgt256.ComputeBatch(m_message, out);
+
+		if (out != m_exp256)
+		{
+			throw TestException("Keccak: Batch SHA3-256 hash is not equal!");
+		}
+
+		dgt512.ComputeBatch(m_message, out);
+
+		if (out != m_exp512)
+		{
+			throw TestException("Keccak: Batch SHA3-512 hash is not equal!");
+		}
+
+		dgt1024.ComputeBatch(m_message, out);
+
+		if (out != m_exp1024)
+		{
+			throw TestException("Keccak: Batch Keccak-1024 hash is not equal!");
+		}
+
+		// the rate and round count of each variant
+		CompareBatch(dgt256);
+		CompareBatch(dgt512);
+		CompareBatch(dgt1024);
+	}
+
+	template<typename T>
+	void KeccakTest::CompareBatch(T &Digest)
+	{
+		const size_t DGTLEN = Digest.DigestSize();
+		const size_t OUTOFT = 3;
+		const size_t RATE = Digest.BlockSize();
+		// the edges of the sponge padding; at RATE - 1 the domain code and the final bit share one byte, at RATE the padding takes a block of its own
+		const size_t MSGLEN[8] = { 0, 1, RATE - 1, RATE, RATE + 1, (2 * RATE) - 1, 2 * RATE, (3 * RATE) + 7 };
+		// fewer messages than the 4 and 8 state lanes, a full set, a lane refilled, and a last message finished on the single state
+		const size_t MSGCNT[7] = { 1, 3, 4, 5, 8, 9, 17 };
+
+		for (size_t i = 0; i < 7; ++i)
+		{
+			std::vector<std::vector<byte>> msg(MSGCNT[i]);
+			std::vector<const byte*> msgPtr(MSGCNT[i]);
+			std::vector<size_t> msgLen(MSGCNT[i]);
+			std::vector<byte> code(OUTOFT + (MSGCNT[i] * DGTLEN));
+
+			for (size_t j = 0; j < MSGCNT[i]; ++j)
+			{
+				msg[j].resize(MSGLEN[(i + j) % 8]);
+
+				if (msg[j].size() != 0)
+				{
+					TestUtils::GetRandom(msg[j]);
+				}
+
+				msgPtr[j] = msg[j].data();
+				msgLen[j] = msg[j].size();
+			}
+
+			Digest.ComputeBatch(msgPtr, msgLen, code, OUTOFT);
+
+			for (size_t j = 0; j < MSGCNT[i]; ++j)
+			{
+				std::vector<byte> exp(DGTLEN);
+				std::vector<byte> otp(code.begin() + OUTOFT + (j * DGTLEN), code.begin() + OUTOFT + ((j + 1) * DGTLEN));
+				Digest.Compute(msg[j], exp);
+
+				if (otp != exp)
+				{
+					throw TestException("Keccak: Batch " + Digest.Name() + " hash is not equal at a rate boundary!");
+				}
+			}
+		}
+	}
+
 	void KeccakTest::SHA3256KatTest()
 	{
 		std::vector<byte> output(32);
@@ -233,6 +320,28 @@ namespace Test
 		m_progressEvent(Data);
 	}
 
+	void KeccakTest::PointerTest()
+	{
+		std::vector<Digest::IDigest*> digests = {
+			new Keccak256(),
+			new Keccak512(),
+			new Keccak1024() };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < digests.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(digests[i], [&digests, i]() { digests[i]->Reset(); }, digests[i]->DigestSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(digests[i], [&digests, i]() { digests[i]->Reset(); }, digests[i]->DigestSize(), 5000);
+			delete digests[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("KeccakTest: The pointer and vector updates are not equal!");
+		}
+	}
+
 	void KeccakTest::TreeParamsTest()
 	{
 		std::vector<byte> code1(8, 7);
@@ -87,8 +87,17 @@ namespace Test
 		/// </summary>
 		void Keccak1024KatTest();
 
+		/// <summary>
+		/// Compare the multi-buffer batch digests of each Keccak variant with the vectors and the sequential digests
+		/// </summary>
+		void BatchTest();
+
+		template<typename T>
+		void CompareBatch(T &Digest);
+
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
 		void TreeParamsTest();
 	};
 }
@@ -0,0 +1,113 @@
+#include "MacSpeedTest.h"
+#include "../CEX/CMAC.h"
+#include "../CEX/HMAC.h"
+#include "../CEX/Poly1305.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	const std::string MacSpeedTest::DESCRIPTION = "Message Authentication Code Speed Tests.";
+	const std::string MacSpeedTest::FAILURE = "FAILURE! ";
+	const std::string MacSpeedTest::MESSAGE = "COMPLETE! Speed tests have executed succesfully.";
+
+	MacSpeedTest::MacSpeedTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	MacSpeedTest::~MacSpeedTest()
+	{
+	}
+
+	const std::string MacSpeedTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &MacSpeedTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string MacSpeedTest::Run()
+	{
+		using namespace Enumeration;
+
+		try
+		{
+			OnProgress(std::string("### Message Authentication Code Speed Tests: 10 loops * 100MB ###"));
+
+			OnProgress(std::string("***The CMAC AES MAC***"));
+			MacBlockLoop(new Mac::CMAC(BlockCiphers::Rijndael), MB100);
+
+			OnProgress(std::string("***The HMAC SHA2 256 MAC***"));
+			MacBlockLoop(new Mac::HMAC(Digests::SHA256), MB100);
+
+			OnProgress(std::string("***The Poly1305 MAC***"));
+			MacBlockLoop(new Mac::Poly1305(), MB100);
+
+			return MESSAGE;
+		}
+		catch (std::exception const &ex)
+		{
+			return FAILURE + " : " + ex.what();
+		}
+		catch (...)
+		{
+			return FAILURE + " : Unknown Error";
+		}
+	}
+
+	uint64_t MacSpeedTest::GetBytesPerSecond(uint64_t DurationTicks, uint64_t DataSize)
+	{
+		double sec = (double)DurationTicks / 1000.0;
+		double sze = (double)DataSize;
+
+		return (uint64_t)(sze / sec);
+	}
+
+	void MacSpeedTest::MacBlockLoop(Mac::IMac* Generator, size_t SampleSize, size_t Loops)
+	{
+		std::vector<byte> key(Generator->LegalKeySizes()[0].KeySize(), 0);
+		std::vector<byte> code(Generator->MacSize(), 0);
+		// a larger buffer than the block size, so that the wide code paths are measured
+		std::vector<byte> buffer(KB16, 0);
+		Key::Symmetric::SymmetricKey kp(key);
+
+		Generator->Initialize(kp);
+		uint64_t start = TestUtils::GetTimeMs64();
+
+		for (size_t i = 0; i < Loops; ++i)
+		{
+			size_t counter = 0;
+			uint64_t lstart = TestUtils::GetTimeMs64();
+
+			while (counter < SampleSize)
+			{
+				Generator->Update(buffer, 0, buffer.size());
+				counter += buffer.size();
+			}
+			std::string calc = TestUtils::ToString((TestUtils::GetTimeMs64() - lstart) / 1000.0);
+			OnProgress(calc);
+		}
+		Generator->Finalize(code, 0);
+		delete Generator;
+
+		uint64_t dur = TestUtils::GetTimeMs64() - start;
+		uint64_t len = Loops * SampleSize;
+		uint64_t rate = GetBytesPerSecond(dur, len);
+		std::string glen = TestUtils::ToString(len / GB1);
+		std::string mbps = TestUtils::ToString((rate / MB1));
+		std::string secs = TestUtils::ToString((double)dur / 1000.0);
+		std::string resp = std::string(glen + "GB in " + secs + " seconds, avg. " + mbps + " MB per Second");
+
+		OnProgress(resp);
+		OnProgress(std::string(""));
+	}
+
+	void MacSpeedTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef CEXTEST_MACSPEEDTEST_H
+#define CEXTEST_MACSPEEDTEST_H
+
+#include "ITest.h"
+#include "../CEX/IMac.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Message Authentication Code Speed Tests
+	/// </summary>
+	class MacSpeedTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string MESSAGE;
+		static const uint64_t KB1 = 1000;
+		static const uint64_t KB16 = KB1 * 16;
+		static const uint64_t MB1 = KB1 * 1000;
+		static const uint64_t MB100 = MB1 * 100;
+		static const uint64_t GB1 = MB1 * 1000;
+		static const uint64_t DEFITER = 10;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Initailize this class
+		/// </summary>
+		MacSpeedTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~MacSpeedTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		uint64_t GetBytesPerSecond(uint64_t DurationTicks, uint64_t DataSize);
+		void MacBlockLoop(Mac::IMac* Generator, size_t SampleSize, size_t Loops = DEFITER);
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
@@ -54,6 +54,8 @@ namespace Test
 			OnProgress(std::string("Passed CMAC description initialization test.."));
 			HmacDescriptionTest();
 			OnProgress(std::string("Passed HMAC description initialization test.."));
+			BatchTest();
+			OnProgress(std::string("Passed MacStream batch tests.."));
 
 			return SUCCESS;
 		}
@@ -67,6 +69,57 @@ namespace Test
 		}
 	}
 
+	void MacStreamTest::BatchTest()
+	{
+		const size_t MSGCNT = 60;
+		Prng::SecureRandom rng;
+		std::vector<byte> key = rng.GetBytes(64);
+		std::vector<std::vector<byte>> msgData(MSGCNT);
+		std::vector<std::vector<byte>> expCodes(MSGCNT);
+		std::vector<IO::IByteStream*> msgStreams(MSGCNT);
+		Mac::HMAC mac(Enumeration::Digests::SHA256);
+		SymmetricKey kp(key);
+		mac.Initialize(kp);
+
+		for (size_t i = 0; i < MSGCNT; ++i)
+		{
+			msgData[i] = rng.GetBytes(rng.NextUInt32(70000, 1));
+			expCodes[i].resize(mac.MacSize());
+			mac.Compute(msgData[i], expCodes[i]);
+		}
+
+		// a description creates a keyed mac per worker, a mac instance processes the batch in turn
+		Processing::MacDescription mds(64, Enumeration::Digests::SHA256);
+		Processing::MacStream mst1(mds);
+		mst1.Initialize(kp);
+		Mac::HMAC* eng = new Mac::HMAC(Enumeration::Digests::SHA256);
+		Processing::MacStream mst2(eng);
+		mst2.Initialize(kp);
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				msgStreams[j] = new IO::MemoryStream(msgData[j]);
+			}
+
+			std::vector<std::vector<byte>> batCodes = (i == 0) ? mst1.ComputeBatch(msgStreams) : mst2.ComputeBatch(msgStreams);
+
+			for (size_t j = 0; j < MSGCNT; ++j)
+			{
+				delete msgStreams[j];
+			}
+
+			if (batCodes != expCodes)
+			{
+				delete eng;
+				throw TestException("MacStreamTest: Batch code arrays are not equal!");
+			}
+		}
+
+		delete eng;
+	}
+
 	void MacStreamTest::CompareCmac()
 	{
 		Prng::SecureRandom rnd;
@@ -48,6 +48,7 @@ namespace Test
 
 	private:
 
+		void BatchTest();
 		void CompareCmac();
 		void CompareHmac();
 		void CmacDescriptionTest();
@@ -0,0 +1,210 @@
+#include "ParallelHashTest.h"
+#include "../CEX/ParallelHash.h"
+#include "../CEX/ParallelUtils.h"
+
+namespace Test
+{
+	using Digest::ParallelHash;
+
+	const std::string ParallelHashTest::DESCRIPTION = "SP800-185 Test Vectors for ParallelHash-128, ParallelHash-256, and ParallelHashXOF.";
+	const std::string ParallelHashTest::FAILURE = "FAILURE! ";
+	const std::string ParallelHashTest::SUCCESS = "SUCCESS! All ParallelHash tests have executed succesfully.";
+
+	ParallelHashTest::ParallelHashTest()
+		:
+		m_progressEvent()
+	{
+		Initialize();
+	}
+
+	ParallelHashTest::~ParallelHashTest()
+	{
+	}
+
+	const std::string ParallelHashTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &ParallelHashTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string ParallelHashTest::Run()
+	{
+		try
+		{
+			CompareVector(ShakeModes::SHAKE128, 8, false, m_custom[0], m_message[0], m_expected[0]);
+			CompareVector(ShakeModes::SHAKE128, 8, false, m_custom[1], m_message[0], m_expected[1]);
+			CompareVector(ShakeModes::SHAKE128, 12, false, m_custom[1], m_message[1], m_expected[2]);
+			CompareVector(ShakeModes::SHAKE128, 64, false, m_custom[0], m_message[2], m_expected[3]);
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHash-128 known answer vector tests.."));
+
+			CompareVector(ShakeModes::SHAKE256, 8, false, m_custom[0], m_message[0], m_expected[4]);
+			CompareVector(ShakeModes::SHAKE256, 8, false, m_custom[1], m_message[0], m_expected[5]);
+			CompareVector(ShakeModes::SHAKE256, 12, false, m_custom[1], m_message[1], m_expected[6]);
+			CompareVector(ShakeModes::SHAKE256, 64, false, m_custom[0], m_message[2], m_expected[7]);
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHash-256 known answer vector tests.."));
+
+			CompareVector(ShakeModes::SHAKE128, 8, true, m_custom[0], m_message[0], m_expected[8]);
+			CompareVector(ShakeModes::SHAKE128, 8, true, m_custom[1], m_message[0], m_expected[9]);
+			CompareVector(ShakeModes::SHAKE128, 12, true, m_custom[1], m_message[1], m_expected[10]);
+			CompareVector(ShakeModes::SHAKE256, 8, true, m_custom[0], m_message[0], m_expected[11]);
+			CompareVector(ShakeModes::SHAKE256, 8, true, m_custom[1], m_message[0], m_expected[12]);
+			CompareVector(ShakeModes::SHAKE256, 12, true, m_custom[1], m_message[1], m_expected[13]);
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHashXOF-128 and ParallelHashXOF-256 known answer vector tests.."));
+
+			StressTest(ShakeModes::SHAKE128);
+			StressTest(ShakeModes::SHAKE256);
+			OnProgress(std::string("ParallelHashTest: Passed ParallelHash segmented update and multi-threaded stress tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void ParallelHashTest::CompareVector(ShakeModes Mode, size_t LeafSize, bool Extendable, std::vector<byte> &Custom, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		ParallelHash gen(Mode, LeafSize, Extendable);
+		std::vector<byte> output1(Expected.size());
+		std::vector<byte> output2(Expected.size());
+
+		gen.Customization() = Custom;
+		gen.Update(Input, 0, Input.size());
+		gen.Finalize(output1, 0, output1.size());
+
+		if (output1 != Expected)
+		{
+			throw TestException("ParallelHashTest: return code is not equal!");
+		}
+
+		// byte by byte updates
+		for (size_t i = 0; i < Input.size(); ++i)
+		{
+			gen.Update(Input[i]);
+		}
+
+		gen.Finalize(output2, 0, output2.size());
+
+		if (output2 != Expected)
+		{
+			throw TestException("ParallelHashTest: return code is not equal!");
+		}
+	}
+
+	void ParallelHashTest::StressTest(ShakeModes Mode)
+	{
+		const size_t LEFSZE = 1024;
+		std::vector<byte> msg(1024 * 1024 + 777);
+		std::vector<byte> exp(0);
+		std::vector<byte> otp(0);
+		size_t i;
+
+		for (i = 0; i < msg.size(); ++i)
+		{
+			msg[i] = static_cast<byte>(i * 7);
+		}
+
+		ParallelHash gen1(Mode, LEFSZE);
+		gen1.Compute(msg, exp);
+
+		// odd sized updates, so that the leaf buffer and the direct leaf path are both used
+		const std::vector<size_t> SEGLEN = { 1, 333, LEFSZE, 9 * LEFSZE + 5, 64 * LEFSZE, 17 };
+		size_t pos = 0;
+		i = 0;
+
+		while (pos != msg.size())
+		{
+			const size_t UPDLEN = (msg.size() - pos < SEGLEN[i % SEGLEN.size()]) ? msg.size() - pos : SEGLEN[i % SEGLEN.size()];
+			gen1.Update(msg, pos, UPDLEN);
+			pos += UPDLEN;
+			++i;
+		}
+
+		otp.resize(gen1.DigestSize());
+		gen1.Finalize(otp, 0);
+
+		if (otp != exp)
+		{
+			throw TestException("ParallelHashTest: segmented update return code is not equal!");
+		}
+
+		if (Utility::ParallelUtils::ProcessorCount() > 1)
+		{
+			ParallelHash gen2(Mode, LEFSZE, false, true);
+			gen2.Compute(msg, otp);
+
+			if (otp != exp)
+			{
+				throw TestException("ParallelHashTest: multi-threaded return code is not equal!");
+			}
+		}
+	}
+
+	void ParallelHashTest::Initialize()
+	{
+		/*lint -save -e122 */
+		/*lint -save -e146 */
+		/*lint -save -e417 */
+
+		const std::vector<std::string> custom =
+		{
+			std::string(""),
+			std::string("506172616C6C656C2044617461")
+		};
+		HexConverter::Decode(custom, 2, m_custom);
+
+		std::vector<std::string> message =
+		{
+			std::string("000102030405060710111213141516172021222324252627"),
+			std::string("000102030405060708090A0B101112131415161718191A1B202122232425262728292A2B303132333435363738393A3B404142434445464748494A4B505152535455565758595A5B")
+		};
+		HexConverter::Decode(message, 2, m_message);
+
+		// a message of 3000 bytes hashed with 64 byte leaves, exercises the leaf batches and the partial last leaf
+		std::vector<byte> tmp(3000);
+		for (size_t i = 0; i < tmp.size(); ++i)
+		{
+			tmp[i] = static_cast<byte>(i % 251);
+		}
+		m_message.push_back(tmp);
+
+		const std::vector<std::string> expected =
+		{
+			// parallelhash128
+			std::string("BA8DC1D1D979331D3F813603C67F72609AB5E44B94A0B8F9AF46514454A2B4F5"),
+			std::string("FC484DCB3F84DCEEDC353438151BEE58157D6EFED0445A81F165E495795B7206"),
+			std::string("F7FD5312896C6685C828AF7E2ADB97E393E7F8D54E3C2EA4B95E5ACA3796E8FC"),
+			std::string("58EA6090D896E0C48780E7BDCF8B40E5EFF20856E199FE742BF2FD7FE7142542"),
+			// parallelhash256
+			std::string("BC1EF124DA34495E948EAD207DD9842235DA432D2BBC54B4C110E64C451105531B7F2A3E0CE055C02805E7C2DE1FB746AF97A1DD01F43B824E31B87612410429"),
+			std::string("CDF15289B54F6212B4BC270528B49526006DD9B54E2B6ADD1EF6900DDA3963BB33A72491F236969CA8AFAEA29C682D47A393C065B38E29FAE651A2091C833110"),
+			std::string("69D0FCB764EA055DD09334BC6021CB7E4B61348DFF375DA262671CDEC3EFFA8D1B4568A6CCE16B1CAD946DDDE27F6CE2B8DEE4CD1B24851EBF00EB90D43813E9"),
+			std::string("4082392E7F75FCE36D49664ECD57737D9F2A321C4CD3011C8C567849949F40B9F6F0A1CFCDAF4DBBBAD14367E33F9CB6D1B3805F649FAABBFE756247FFC16AD7"),
+			// parallelhashxof128
+			std::string("FE47D661E49FFE5B7D999922C062356750CAF552985B8E8CE6667F2727C3C8D3"),
+			std::string("EA2A793140820F7A128B8EB70A9439F93257C6E6E79B4A540D291D6DAE7098D7"),
+			std::string("0127AD9772AB904691987FCC4A24888F341FA0DB2145E872D4EFD255376602F0"),
+			// parallelhashxof256
+			std::string("C10A052722614684144D28474850B410757E3CBA87651BA167A5CBDDFF7F466675FBF84BCAE7378AC444BE681D729499AFCA667FB879348BFDDA427863C82F1C"),
+			std::string("538E105F1A22F44ED2F5CC1674FBD40BE803D9C99BF5F8D90A2C8193F3FE6EA768E5C1A20987E2C9C65FEBED03887A51D35624ED12377594B5585541DC377EFC"),
+			std::string("6B3E790B330C889A204C2FBC728D809F19367328D852F4002DC829F73AFD6BCEFB7FE5B607B13A801C0BE5C1170BDB794E339458FDB0E62A6AF3D42558970249")
+		};
+		HexConverter::Decode(expected, 14, m_expected);
+
+		/*lint -restore */
+	}
+
+	void ParallelHashTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,72 @@
+#ifndef CEXTEST_PARALLELHASHTEST_H
+#define CEXTEST_PARALLELHASHTEST_H
+
+#include "ITest.h"
+#include "../CEX/ShakeModes.h"
+
+namespace Test
+{
+	using Enumeration::ShakeModes;
+
+	/// <summary>
+	/// ParallelHash implementation vector comparison tests.
+	///
+	/// <para>SP800-185: <a href="http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf">SHA-3 Derived Functions</a>
+	/// Using vectors from the official NIST SP800-185 vector set:
+	/// <a href="https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/ParallelHash_samples.pdf">ParallelHash example values</a>, and
+	/// <a href="https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/ParallelHashXOF_samples.pdf">ParallelHashXOF example values</a></para>
+	/// </summary>
+	class ParallelHashTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_custom;
+		std::vector<std::vector<byte>> m_expected;
+		std::vector<std::vector<byte>> m_message;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Compares known answer ParallelHash vectors for equality
+		/// </summary>
+		ParallelHashTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~ParallelHashTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void CompareVector(ShakeModes Mode, size_t LeafSize, bool Extendable, std::vector<byte> &Custom, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void Initialize();
+		void OnProgress(std::string Data);
+
+		/// <summary>
+		/// Compares the hash of a large message processed in a single call, in odd sized updates, and on multiple threads
+		/// </summary>
+		void StressTest(ShakeModes Mode);
+	};
+}
+
+#endif
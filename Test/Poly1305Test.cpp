@@ -1,5 +1,6 @@
 #include "Poly1305Test.h"
 #include "../CEX/Poly1305.h"
+#include "../CEX/SecureRandom.h"
 
 namespace Test
 {
@@ -32,20 +33,38 @@ namespace Test
 	{
 		try
 		{
-			const size_t SEQLEN = 16;
+			const size_t SEQLEN = 19;
 			for (size_t i = 0; i < SEQLEN; ++i)
 			{
-				Poly1305Compare(m_key[i], m_plainText[i], m_expectedCode[i]);
+				Poly1305Compare(m_key[i], m_plainText[i], m_expectedCode[i], 44);
 			}
 
 			OnProgress(std::string("Poly1305Test: Passed Poly1305 sequential known answer vector tests.."));
 
+			for (size_t i = 0; i < SEQLEN; ++i)
+			{
+				SplitCompare(m_key[i], m_plainText[i], m_expectedCode[i], 44);
+			}
+
+			OnProgress(std::string("Poly1305Test: Passed Poly1305 split update known answer tests.."));
+
+			// the 26 bit limb back end is only selected by default when the compiler has no 128 bit multiply
+			for (size_t i = 0; i < SEQLEN; ++i)
+			{
+				Poly1305Compare(m_key[i], m_plainText[i], m_expectedCode[i], 26);
+				SplitCompare(m_key[i], m_plainText[i], m_expectedCode[i], 26);
+			}
+
+			OnProgress(std::string("Poly1305Test: Passed Poly1305 26 bit limb known answer vector tests.."));
+
 			for (size_t i = SEQLEN; i < m_key.size(); ++i)
 			{
 				Poly1305AESCompare(m_key[i], m_nonce[i - SEQLEN], m_plainText[i], m_expectedCode[i]);
 			}
 
 			OnProgress(std::string("Poly1305Test: Passed Poly1305-AES known answer vector tests.."));
+			PointerTest();
+			OnProgress(std::string("Poly1305Test: Passed pointer and vector update equivalence tests.."));
 
 			return SUCCESS;
 		}
@@ -59,9 +78,16 @@ namespace Test
 		}
 	}
 
-	void Poly1305Test::Poly1305Compare(std::vector<byte> &Key, std::vector<byte> &PlainText, std::vector<byte> &MacCode)
+	void Poly1305Test::Poly1305Compare(std::vector<byte> &Key, std::vector<byte> &PlainText, std::vector<byte> &MacCode, size_t LimbWidth)
 	{
 		Mac::Poly1305 gen;
+		gen.LimbWidth(LimbWidth);
+
+		if (gen.LimbWidth() > LimbWidth)
+		{
+			throw TestException("Poly1305Compare: The limb width was not lowered!");
+		}
+
 		Key::Symmetric::SymmetricKey kp(Key);
 		gen.Initialize(kp);
 		gen.Update(PlainText, 0, PlainText.size());
@@ -91,6 +117,69 @@ namespace Test
 		}
 	}
 
+	void Poly1305Test::SplitCompare(std::vector<byte> &Key, std::vector<byte> &PlainText, std::vector<byte> &MacCode, size_t LimbWidth)
+	{
+		const size_t MSGLEN = PlainText.size();
+		Mac::Poly1305 gen;
+		gen.LimbWidth(LimbWidth);
+		Key::Symmetric::SymmetricKey kp(Key);
+		Prng::SecureRandom rng;
+		std::vector<byte> code(16);
+
+		for (size_t i = 0; i < 8; ++i)
+		{
+			gen.Initialize(kp);
+			size_t prcLen = 0;
+
+			if (i == 0 && MSGLEN != 0)
+			{
+				// one byte leaves the buffer unaligned for the rest of the message
+				gen.Update(PlainText[0]);
+				gen.Update(PlainText, 1, MSGLEN - 1);
+				prcLen = MSGLEN;
+			}
+			else if (i == 1 && MSGLEN != 0)
+			{
+				gen.Update(PlainText, 0, MSGLEN - 1);
+				gen.Update(PlainText[MSGLEN - 1]);
+				prcLen = MSGLEN;
+			}
+
+			// random chunks, interleaved with runs of single bytes
+			while (prcLen != MSGLEN)
+			{
+				const size_t RMDLEN = MSGLEN - prcLen;
+
+				if (rng.NextUInt32(3) == 0)
+				{
+					const size_t RNDCNT = rng.NextUInt32(3, 1);
+					const size_t BYTCNT = RNDCNT < RMDLEN ? RNDCNT : RMDLEN;
+
+					for (size_t j = 0; j < BYTCNT; ++j)
+					{
+						gen.Update(PlainText[prcLen + j]);
+					}
+
+					prcLen += BYTCNT;
+				}
+				else
+				{
+					const size_t RNDLEN = rng.NextUInt32(300, 1);
+					const size_t CHKLEN = RNDLEN < RMDLEN ? RNDLEN : RMDLEN;
+					gen.Update(PlainText, prcLen, CHKLEN);
+					prcLen += CHKLEN;
+				}
+			}
+
+			gen.Finalize(code, 0);
+
+			if (MacCode != code)
+			{
+				throw TestException("SplitCompare: Tags do not match!");
+			}
+		}
+	}
+
 	void Poly1305Test::Initialize()
 	{
 		/*lint -save -e146 */
@@ -113,13 +202,16 @@ namespace Test
 			std::string("EEA6A7251C1E72916D11C2CB214D3C252539121D8E234E652D651FA4C8CFF880"),
 			std::string("01BCB20BFC8B6E03609DDD09F44B060F95CC0E44D0B79A8856AFCAE1BEC4FE3C"),
 			std::string("CD07FD0EF8C0BE0AFCBDB30AF4AF000976FB3635A2DC92A1F768163AB12F2187"),
+			std::string("2B7865ED40D06B7996C1DE665AEB1AC51645232022BF9090BCDBF58D9CC7A2CF"),
+			std::string("9E8936DE0EA2534CE0A69664FAE1E9ADC7D50B327B69EEDCEEBE85AF601A1CB8"),
+			std::string("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"),
 			std::string("0000000000000000000000000000000000000000000000000000000000000000"),
 			std::string("F795BD0A50E29E0710D3130A20E98D0CF795BD4A52E29ED713D313FA20E98DBC"),
 			std::string("3EF49901C8E11C000430D90AD45E7603E69DAE0AAB9F91C03A325DCC9436FA90"),
 			std::string("DA4AFC035087D90E503F8F0EA08C3E0D85A4EA91A7DE0B0D96EED0D4BF6ECF1C"),
 			std::string("CA3C6A0DA0A864024CA3090628C28E0D25EB69BAC5CDF7D6BFCEE4D9D5507B82")
 		};
-		HexConverter::Decode(keys, 21, m_key);
+		HexConverter::Decode(keys, 24, m_key);
 
 		const std::vector<std::string> nonce =
 		{
@@ -183,6 +275,24 @@ namespace Test
 				"976F521607638535D2EE8DD3312E1DDC80A55D34FE829AB954C1EBD54D929954770F1BE9D32B4C05003C5C9E97943B6431E2AFE820B1E967B19843E598"
 				"5A131B1100517CDC363799104AF91E2CF3F53CB8FD003653A6DD8A31A3F9D566A7124B0FFE9695BCB87C482EB60106F88198F766A40BC0F4873C23653C"
 				"5F9E7A8E446F770BEB8034CF01D21028BA15CCEE21A8DB918C4829D61C88BFA927BC5DEF831501796C5B401A60A6B1B433C9FB905C8CD40412FFFEE81AB"),
+			std::string("04D468E67388C046BF5157754793FC96645BE3D30FA9972AF3838053E554DF7876638F6991E4AB322D7E73101C7D2ADF51B809B5BCD421E16163F1A9E1E6CFCE"
+				"6452C9CB05F486B40B8D87502276B6516B142BE6B6951F9B2208918B1F51BEA341B4C2DAAD4C6D5708B45F5233FE1CEBC176BC43CB0CB10088A00FC5EAD14BDB"
+				"A6F3BBE2C88EF2CFB2291BDED47279DD3F8F22FB7A5276598ED8969FF6930682B47DE99089264AC5DF40F4B348E16096808D23477ECE6F2BF7E94341C25330F4"
+				"D18AF2D2D23CBC8DF4556A9ACEBEAD3D5FEB5556371436AC0B40497151B9A07CEA27D796CD2DEE9390B9EAF589DBC0CACFA94DD51DC0156159963EB48B6B3EE1"),
+			std::string("2C00AA9ED8217F706FA944332F084BC3B2D19405706931BD0AF41C4EF891ECDBFC2D69CF89EA48DBBD00EE7AA52DE8C11B33C4DB5A00B3CFD08A92EE13540E23"
+				"8E478458C61635A1FBFA05B778D8164D7938E89C5F18D3C30A878E30CA0603B0DF132255DFEA179CAD7C6D36B768E87CFF7D94481E19D3A72C3A0C7821375EEA"
+				"A661770D7E7A4764031EF89B8F4D7D0807F75CBB9C0BC510C0F4083015850D757DDB653A17F12E0938CDD8AE6B4143C1F04C9AE5512AEDD749051E8D1C576692"
+				"DAF613A8E1E2736E1B79E22C502E4A98FB7D63063E7FA0EA478EF362938C9F3DC8652283A774F841BF479250DF0F6DEDEFB21FF41E0ADEA8CD242228C1034033"
+				"552B3038E044B1DC8E01C211CE5DCCCA148A2D6C9F16D7290571F3BCC62D3C122E4A04FE09ADA6573A145B7F3D56B9DB8F31A1D094D83D417D6FF47EEC6CAD4D"
+				"07B76DE897FCFB96285198F66F327C420C5299CBAE677DD0CD6EB5604845BBFFDFCB0795C7DE562335B127F200D8F22618F9C6B57D8C4528BCADA5454571D1C4"
+				"8CD16237632A7EB1459D6F5D07F43195267B4891979D183165A7BBD1D26BCC642A8BF8D11547177FDFEC6D2B2DACF0ACD3A3242591350432BB8519DFF179DD9D"
+				"81D12313C56D50C8F69E6BD0AEB5582511C1C0752DB98760169000A5EE1487BA9073078FCCA81879FFBFE9C4CF886C59D259C3D3CB117D96750F01FF713C2FCD"
+				"E0284A"),
+			std::string("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+				"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+				"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+				"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+				"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"),
 			std::string(""),
 			std::string("66F7"),
 			std::string("66F75C0E0C7A406586"),
@@ -190,7 +300,7 @@ namespace Test
 			std::string("66F75C0E0C7A40658629E3392F7F8E3349A02191FFD49F39879A8D9D1D0E23EA3CAA4D240BD2AB8A8C4A6BB8D3288D9DE4B793F05E97646DD4D98055DE")
 
 		};
-		HexConverter::Decode(plain, 21, m_plainText);
+		HexConverter::Decode(plain, 24, m_plainText);
 
 		const std::vector<std::string> code =
 		{
@@ -210,13 +320,16 @@ namespace Test
 			std::string("F3FFC7703F9400E52A7DFB4B3D3305D9"),
 			std::string("AE345D555EB04D6947BB95C0965237E2"),
 			std::string("045BE28CC52009F506BDBFABEDACF0B4"),
+			std::string("D71F1F743212A5EDAE608858E744FD91"),
+			std::string("A1214FC7D82A7CBE5FDCFA4F0AF5110E"),
+			std::string("055F96D861D5C7C878E587CC255A22E9"),
 			std::string("66E94BD4EF8A2C3B884CFA59CA342B2E"),
 			std::string("5CA585C75E8F8F025E710CABC9A1508B"),
 			std::string("2924F51B9C2EFF5DF09DB61DD03A9CA1"),
 			std::string("3C5A13ADB18D31C64CC29972030C917D"),
 			std::string("FC5FB58DC65DAF19B14D1D05DA1064E8")
 		};
-		HexConverter::Decode(code, 21, m_expectedCode);
+		HexConverter::Decode(code, 24, m_expectedCode);
 		/*lint -restore */
 	}
 
@@ -224,4 +337,30 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void Poly1305Test::PointerTest()
+	{
+		std::vector<byte> key(32);
+		TestUtils::GetRandom(key);
+		std::vector<byte> iv(16);
+		TestUtils::GetRandom(iv);
+		Key::Symmetric::SymmetricKey kp(key, iv);
+		std::vector<Mac::IMac*> generators = {
+			new Mac::Poly1305(),
+			new Mac::Poly1305(Enumeration::BlockCiphers::Rijndael) };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < generators.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(generators[i], [&generators, i, &kp]() { generators[i]->Initialize(kp); }, generators[i]->MacSize(), 5000);
+			delete generators[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("Poly1305Test: The pointer and vector updates are not equal!");
+		}
+	}
 }
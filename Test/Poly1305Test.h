@@ -57,8 +57,10 @@ namespace Test
 
 		void Initialize();
 		void OnProgress(std::string Data);
-		void Poly1305Compare(std::vector<byte> &Key, std::vector<byte> &PlainText, std::vector<byte> &MacCode);
+		void PointerTest();
+		void Poly1305Compare(std::vector<byte> &Key, std::vector<byte> &PlainText, std::vector<byte> &MacCode, size_t LimbWidth);
 		void Poly1305AESCompare(std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &PlainText, std::vector<byte> &MacCode);
+		void SplitCompare(std::vector<byte> &Key, std::vector<byte> &PlainText, std::vector<byte> &MacCode, size_t LimbWidth);
 	};
 }
 
@@ -64,6 +64,12 @@ namespace Test
 			}
 			OnProgress(std::string("SHAKETest: Passed SHAKE1024 tests.."));
 
+			BatchTest(0, Enumeration::ShakeModes::SHAKE128);
+			BatchTest(5, Enumeration::ShakeModes::SHAKE256);
+			BatchTest(10, Enumeration::ShakeModes::SHAKE512);
+			BatchTest(15, Enumeration::ShakeModes::SHAKE1024);
+			OnProgress(std::string("SHAKETest: Passed SHAKE multi-buffer batch tests.."));
+
 			OnProgress(std::string("cSHAKE: Testing the custom SHAKE implementations.."));
 
 			CompareVector(m_key[20], m_output[20], Enumeration::ShakeModes::SHAKE128, true);
@@ -94,6 +100,50 @@ namespace Test
 		}
 	}
 
+	void SHAKETest::BatchTest(size_t Index, ShakeModes Mode)
+	{
+		// the five vector keys of the mode, and keys of every length up to three blocks; the output spans several squeezed blocks
+		const size_t OUTLEN = 3 * 168 + 5;
+		std::vector<std::vector<byte>> key;
+		std::vector<std::vector<byte>> exp;
+		std::vector<std::vector<byte>> otp;
+		Kdf::SHAKE gen(Mode);
+
+		for (size_t i = 0; i < 5; ++i)
+		{
+			key.push_back(m_key[Index + i]);
+			exp.push_back(m_output[Index + i]);
+		}
+
+		for (size_t i = 1; i < 3 * 168 + 1; ++i)
+		{
+			std::vector<byte> tmp(i);
+			for (size_t j = 0; j < tmp.size(); ++j)
+			{
+				tmp[j] = static_cast<byte>(i + j);
+			}
+
+			std::vector<byte> code(OUTLEN);
+			gen.Initialize(tmp);
+			gen.Generate(code);
+			key.push_back(tmp);
+			exp.push_back(code);
+		}
+
+		gen.GenerateBatch(key, otp, OUTLEN);
+
+		for (size_t i = 0; i < key.size(); ++i)
+		{
+			// the vector outputs are compared with the leading bytes of the extended output
+			const size_t EXPLEN = (exp[i].size() < OUTLEN) ? exp[i].size() : OUTLEN;
+
+			if (otp[i].size() != OUTLEN || !std::equal(exp[i].begin(), exp[i].begin() + EXPLEN, otp[i].begin()))
+			{
+				throw TestException("SHAKETest: Batch values are not equal!");
+			}
+		}
+	}
+
 	void SHAKETest::CompareVector(std::vector<byte> &Key, std::vector<byte> &Expected, ShakeModes Mode, bool Custom)
 	{
 		std::vector<byte> outBytes(Expected.size());
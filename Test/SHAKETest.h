@@ -59,6 +59,7 @@ namespace Test
 
 	private:
 
+		void BatchTest(size_t Index, ShakeModes Mode);
 		void CompareVector(std::vector<byte> &Key, std::vector<byte> &Expected, ShakeModes Mode, bool Custom = false);
 		void Initialize();
 		void OnProgress(std::string Data);
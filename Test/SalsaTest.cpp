@@ -1,5 +1,6 @@
 #include "SalsaTest.h"
 #include "../CEX/CSP.h"
+#include "../CEX/IntUtils.h"
 #include "../CEX/Salsa20.h"
 
 namespace Test
@@ -45,6 +46,10 @@ namespace Test
 			CompareVector(20, m_key[2], m_iv[1], m_plainText, m_cipherText[4]);
 			CompareVector(20, m_key[3], m_iv[2], m_plainText, m_cipherText[5]);
 			OnProgress(std::string("SalsaTest: Passed 256 bit key vector tests.."));
+			SeekTest();
+			OnProgress(std::string("SalsaTest: Passed random-access key stream seek tests.."));
+			PointerTest();
+			OnProgress(std::string("SalsaTest: Passed pointer and vector transform equivalence tests.."));
 
 			return SUCCESS;
 		}
@@ -178,4 +183,75 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void SalsaTest::PointerTest()
+	{
+		std::vector<byte> key(32);
+		TestUtils::GetRandom(key);
+		std::vector<byte> iv(8);
+		TestUtils::GetRandom(iv);
+		Key::Symmetric::SymmetricKey k(key, iv);
+		Salsa20 cipher(20);
+
+		// an uneven length, and a length that is processed in parallel
+		if (!TestUtils::ComparePointerTransform(&cipher, [&cipher, &k]() { cipher.Initialize(k); }, 1000) ||
+			!TestUtils::ComparePointerTransform(&cipher, [&cipher, &k]() { cipher.Initialize(k); }, cipher.ParallelBlockSize() + 1000))
+		{
+			throw TestException("Salsa20: The pointer and vector transforms are not equal!");
+		}
+	}
+
+	void SalsaTest::SeekTest()
+	{
+		Provider::CSP rng;
+		std::vector<byte> key(32);
+		rng.GetBytes(key);
+		std::vector<byte> iv(8);
+		rng.GetBytes(iv);
+		std::vector<byte> data(40960);
+		rng.GetBytes(data);
+		std::vector<byte> enc(data.size(), 0);
+		std::vector<byte> rnd(8);
+		Key::Symmetric::SymmetricKey k(key, iv);
+		Salsa20 cipher(20);
+
+		// the sequential key stream
+		cipher.ParallelProfile().IsParallel() = false;
+		cipher.Initialize(k);
+		cipher.Transform(data, 0, enc, 0, data.size());
+
+		// seek to random offsets, and transform a random length with the parallel profile enabled
+		cipher.ParallelProfile().IsParallel() = true;
+		cipher.ParallelProfile().ParallelBlockSize() = cipher.ParallelProfile().ParallelMinimumSize();
+		cipher.Initialize(k);
+
+		for (size_t i = 0; i < 100; ++i)
+		{
+			rng.GetBytes(rnd);
+			const size_t OFFSET = Utility::IntUtils::LeBytesTo32(rnd, 0) % data.size();
+			const size_t LENGTH = (Utility::IntUtils::LeBytesTo32(rnd, 4) % (data.size() - OFFSET)) + 1;
+			std::vector<byte> otp(LENGTH);
+
+			cipher.Seek(OFFSET);
+			cipher.Transform(data, OFFSET, otp, 0, LENGTH);
+
+			if (!std::equal(otp.begin(), otp.end(), enc.begin() + OFFSET))
+			{
+				throw TestException("SeekTest: The key stream at the seek position is not equal!");
+			}
+		}
+
+		// consecutive transforms smaller than a block, starting within a block
+		std::vector<byte> otp(data.size());
+		const size_t OFFSET = (64 * 3) + 5;
+		cipher.Seek(OFFSET);
+		cipher.Transform(data, OFFSET, otp, OFFSET, 3);
+		cipher.Transform(data, OFFSET + 3, otp, OFFSET + 3, 64 - 10);
+		cipher.Transform(data, OFFSET + 64 - 7, otp, OFFSET + 64 - 7, 1000);
+
+		if (!std::equal(otp.begin() + OFFSET, otp.begin() + OFFSET + 64 + 993, enc.begin() + OFFSET))
+		{
+			throw TestException("SeekTest: The key stream at the seek position is not equal!");
+		}
+	}
 }
@@ -57,6 +57,8 @@ namespace Test
 		void CompareVector(int Rounds, std::vector<byte> &Key, std::vector<byte> &Vector, std::vector<byte> &Input, std::vector<byte> &Output);
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
+		void SeekTest();
     };
 }
 
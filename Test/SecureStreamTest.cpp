@@ -39,6 +39,8 @@ namespace Test
 			OnProgress(std::string("SymmetricKeyGenerator: Passed serialization tests.."));
 			CheckAccess();
 			OnProgress(std::string("SymmetricKeyGenerator: Passed read/write comparison tests.."));
+			PageAccess();
+			OnProgress(std::string("SecureStream: Passed multi-page random access tests.."));
 
 			return SUCCESS;
 		}
@@ -146,4 +148,57 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void SecureStreamTest::PageAccess()
+	{
+		Prng::SecureRandom rnd;
+		std::vector<byte> data = rnd.GetBytes(rnd.NextUInt32(40000, 20000));
+		SecureStream secStm(data, 0x5A5A5A5A);
+
+		for (size_t i = 0; i < 100; ++i)
+		{
+			// overwrite a random range, possibly spanning pages and extending the stream
+			const size_t POS = rnd.NextUInt32(static_cast<uint>(data.size()));
+			const size_t LEN = rnd.NextUInt32(9000, 1);
+			std::vector<byte> tmp = rnd.GetBytes(LEN);
+
+			secStm.Seek(POS, SeekOrigin::Begin);
+			secStm.Write(tmp, 0, LEN);
+
+			if (data.size() < POS + LEN)
+			{
+				data.resize(POS + LEN);
+			}
+
+			memcpy(&data[POS], &tmp[0], LEN);
+
+			// read back a random range
+			const size_t RDPOS = rnd.NextUInt32(static_cast<uint>(data.size()));
+			const size_t RDLEN = rnd.NextUInt32(static_cast<uint>(data.size() - RDPOS), 1);
+			std::vector<byte> otp(RDLEN);
+
+			secStm.Seek(RDPOS, SeekOrigin::Begin);
+			if (secStm.Read(otp, 0, RDLEN) != RDLEN || memcmp(&otp[0], &data[RDPOS], RDLEN) != 0)
+			{
+				throw TestException("PageAccess: The stream is invalid!");
+			}
+		}
+
+		if (secStm.ToArray() != data || secStm.Length() != data.size())
+		{
+			throw TestException("PageAccess: The stream is invalid!");
+		}
+
+		// a write past the end zero fills the gap
+		const size_t GAPPOS = data.size() + 5000;
+		secStm.Seek(GAPPOS, SeekOrigin::Begin);
+		secStm.WriteByte(0x7F);
+		data.resize(GAPPOS + 1, 0);
+		data[GAPPOS] = 0x7F;
+
+		if (secStm.ToArray() != data)
+		{
+			throw TestException("PageAccess: The stream is invalid!");
+		}
+	}
 }
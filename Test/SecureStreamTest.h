@@ -53,6 +53,7 @@ namespace Test
 		void CheckAccess();
 		void CompareSerial();
 		void OnProgress(std::string Data);
+		void PageAccess();
 	};
 }
 
@@ -56,6 +56,11 @@ namespace Test
 			delete sha512;
 			OnProgress(std::string("Sha2Test: Passed SHA-2 512 bit digest vector tests.."));
 
+			BatchTest();
+			OnProgress(std::string("Sha2Test: Passed SHA-2 256/512 multi-buffer batch tests.."));
+			PointerTest();
+			OnProgress(std::string("Sha2Test: Passed pointer and vector update equivalence tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -68,6 +73,71 @@ namespace Test
 		}
 	}
 
+	void SHA2Test::BatchTest()
+	{
+		// the vector messages mixed with messages of every length up to three blocks, so that lanes complete at different times
+		std::vector<std::vector<byte>> msg;
+		std::vector<std::vector<byte>> exp256;
+		std::vector<std::vector<byte>> exp512;
+		std::vector<std::vector<byte>> out256;
+		std::vector<std::vector<byte>> out512;
+		SHA256 sha256;
+		SHA512 sha512;
+
+		for (size_t i = 0; i < 3 * 128 + 1; ++i)
+		{
+			if (i % 16 == 0)
+			{
+				const size_t IDX = (i / 16) % m_message.size();
+				msg.push_back(m_message[IDX]);
+				exp256.push_back(m_exp256[IDX]);
+				exp512.push_back(m_exp512[IDX]);
+			}
+
+			std::vector<byte> tmp(i);
+			for (size_t j = 0; j < tmp.size(); ++j)
+			{
+				tmp[j] = static_cast<byte>(i + j);
+			}
+
+			std::vector<byte> hash256(sha256.DigestSize());
+			sha256.Compute(tmp, hash256);
+			std::vector<byte> hash512(sha512.DigestSize());
+			sha512.Compute(tmp, hash512);
+			msg.push_back(tmp);
+			exp256.push_back(hash256);
+			exp512.push_back(hash512);
+		}
+
+		sha256.ComputeBatch(msg, out256);
+		sha512.ComputeBatch(msg, out512);
+
+		if (out256 != exp256)
+		{
+			throw TestException("SHA2: Batch SHA-256 hash is not equal!");
+		}
+		if (out512 != exp512)
+		{
+			throw TestException("SHA2: Batch SHA-512 hash is not equal!");
+		}
+
+		// force each lane compressor, the default on a sha-ni processor hashes each message in turn
+		const size_t LANES[2] = { 8, 16 };
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			SHA256 lanes256;
+			lanes256.BatchLanes(LANES[i]);
+			out256.clear();
+			lanes256.ComputeBatch(msg, out256);
+
+			if (out256 != exp256)
+			{
+				throw TestException("SHA2: Batch SHA-256 lane hash is not equal!");
+			}
+		}
+	}
+
 	void SHA2Test::CompareVector(IDigest* Digest, std::vector<byte> &Input, std::vector<byte> &Expected)
 	{
 		std::vector<byte> hash(Digest->DigestSize(), 0);
@@ -124,6 +194,27 @@ namespace Test
 		m_progressEvent(Data);
 	}
 
+	void SHA2Test::PointerTest()
+	{
+		std::vector<Digest::IDigest*> digests = {
+			new SHA256(),
+			new SHA512() };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < digests.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(digests[i], [&digests, i]() { digests[i]->Reset(); }, digests[i]->DigestSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(digests[i], [&digests, i]() { digests[i]->Reset(); }, digests[i]->DigestSize(), 5000);
+			delete digests[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("SHA2: The pointer and vector updates are not equal!");
+		}
+	}
+
 	void SHA2Test::TreeParamsTest()
 	{
 		std::vector<byte> code1(8, 7);
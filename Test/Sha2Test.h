@@ -53,9 +53,11 @@ namespace Test
         
     private:
 
+		void BatchTest();
 		void CompareVector(Digest::IDigest* Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
 		void TreeParamsTest();
     };
 }
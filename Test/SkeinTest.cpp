@@ -87,6 +87,8 @@ namespace Test
 			delete skl2;
 			delete skl3;
 			OnProgress(std::string("Passed Skein 1024 parallelization tests.."));
+			PointerTest();
+			OnProgress(std::string("Passed Skein pointer and vector update equivalence tests.."));
 
 			return SUCCESS;
 		}
@@ -250,4 +252,26 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void SkeinTest::PointerTest()
+	{
+		std::vector<Digest::IDigest*> digests = {
+			new Skein256(),
+			new Skein512(),
+			new Skein1024() };
+		bool isEqual = true;
+
+		for (size_t i = 0; i < digests.size(); ++i)
+		{
+			// a partial block, and several blocks in uneven chunks
+			isEqual &= TestUtils::ComparePointerUpdate(digests[i], [&digests, i]() { digests[i]->Reset(); }, digests[i]->DigestSize(), 100);
+			isEqual &= TestUtils::ComparePointerUpdate(digests[i], [&digests, i]() { digests[i]->Reset(); }, digests[i]->DigestSize(), 5000);
+			delete digests[i];
+		}
+
+		if (!isEqual)
+		{
+			throw TestException("SkeinTest: The pointer and vector updates are not equal!");
+		}
+	}
 }
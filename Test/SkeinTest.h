@@ -62,6 +62,7 @@ namespace Test
 		void CompareVector(IDigest* Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
 		void Initialize();
 		void OnProgress(std::string Data);
+		void PointerTest();
 		void TreeParamsTest();
 	};
 }
@@ -125,6 +125,7 @@
 #include "../Test/TestFiles.h"
 #include "../Test/TestUtils.h"
 #include "../Test/AEADTest.h"
+#include "../Test/AeadStreamTest.h"
 #include "../Test/AesAvsTest.h"
 #include "../Test/AesFipsTest.h"
 #include "../Test/AsymmetricSpeedTest.h"
@@ -148,12 +149,14 @@
 #include "../Test/HMGTest.h"
 #include "../Test/HXCipherTest.h"
 #include "../Test/ITest.h"
+#include "../Test/MacSpeedTest.h"
 #include "../Test/MacStreamTest.h"
 #include "../Test/McElieceTest.h"
 #include "../Test/MemUtilsTest.h"
 #include "../Test/ModuleLWETest.h"
 #include "../Test/NTRUTest.h"
 #include "../Test/PaddingTest.h"
+#include "../Test/ParallelHashTest.h"
 #include "../Test/ParallelModeTest.h"
 #include "../Test/PBKDF2Test.h"
 #include "../Test/Poly1305Test.h"
@@ -173,6 +176,7 @@
 #include "../Test/SymmetricKeyGeneratorTest.h"
 #include "../Test/SymmetricKeyTest.h"
 #include "../Test/TwofishTest.h"
+#include "../Test/XTSTest.h"
 #include "../Test/UtilityTest.h"
 
 using namespace Test;
@@ -438,6 +442,7 @@ int main()
 			RunTest(new HXCipherTest());
 			PrintHeader("TESTING SYMMETRIC CIPHER MODES");
 			RunTest(new CipherModeTest());
+			RunTest(new XTSTest());
 			PrintHeader("TESTING SYMMETRIC CIPHER AEAD MODES");
 			RunTest(new AEADTest());
 			PrintHeader("TESTING PARALLEL CIPHER MODES");
@@ -448,12 +453,14 @@ int main()
 			RunTest(new ChaChaTest());
 			RunTest(new SalsaTest());
 			PrintHeader("TESTING CRYPTOGRAPHIC STREAM PROCESSORS");
+			RunTest(new AeadStreamTest());
 			RunTest(new CipherStreamTest());
 			RunTest(new DigestStreamTest());
 			RunTest(new MacStreamTest());
 			PrintHeader("TESTING CRYPTOGRAPHIC HASH GENERATORS");
 			RunTest(new Blake2Test());
 			RunTest(new KeccakTest());
+			RunTest(new ParallelHashTest());
 			RunTest(new SHA2Test());
 			RunTest(new SkeinTest());
 			PrintHeader("TESTING MESSAGE AUTHENTICATION CODE GENERATORS");
@@ -528,6 +535,16 @@ int main()
 		}
 		ConsoleUtils::WriteLine("");
 
+		if (CanTest("Press 'Y' then Enter to run Message Authentication Code Speed Tests, any other key to cancel: "))
+		{
+			RunTest(new MacSpeedTest());
+		}
+		else
+		{
+			ConsoleUtils::WriteLine("MAC Speed tests were Cancelled..");
+		}
+		ConsoleUtils::WriteLine("");
+
 		if (CanTest("Press 'Y' then Enter to run Asymmetric Cipher Speed Tests, any other key to cancel: "))
 		{
 			RunTest(new AsymmetricSpeedTest());
@@ -200,6 +200,188 @@ namespace Test
 			return ret;
 		}
 
+		/// <summary>
+		/// Compare a multi-message batch operation with the single message operation applied to each message.
+		/// <para>Each message is given an output of OutputSize bytes, or of its own length when OutputSize is zero; 
+		/// an output of the message length is transformed in place on the even numbered messages.</para>
+		/// </summary>
+		///
+		/// <param name="Messages">The messages processed by the batch</param>
+		/// <param name="OutputSize">The fixed output size in bytes, or zero for an output the length of each message</param>
+		/// <param name="Batch">Runs the batch operation over the input and output pointers of every message</param>
+		/// <param name="Single">Writes the single message output of the message at an index to the output vector</param>
+		/// <param name="Output">Receives the batch output of each message</param>
+		///
+		/// <returns>The batch and single message outputs are equal</returns>
+		template<typename BatchFn, typename SingleFn>
+		static bool CompareBatch(const std::vector<std::vector<byte>> &Messages, size_t OutputSize, BatchFn Batch, SingleFn Single, std::vector<std::vector<byte>> &Output)
+		{
+			std::vector<const byte*> inp(Messages.size());
+			std::vector<byte*> otp(Messages.size());
+			bool isEqual = true;
+
+			Output.resize(Messages.size());
+
+			for (size_t i = 0; i < Messages.size(); ++i)
+			{
+				const bool INPLACE = (OutputSize == 0 && i % 2 == 0);
+
+				Output[i] = INPLACE ? Messages[i] : std::vector<byte>((OutputSize == 0) ? Messages[i].size() : OutputSize);
+				inp[i] = INPLACE ? Output[i].data() : Messages[i].data();
+				otp[i] = Output[i].data();
+			}
+
+			Batch(inp, otp);
+
+			for (size_t i = 0; i < Messages.size(); ++i)
+			{
+				std::vector<byte> exp(Output[i].size());
+				Single(i, exp);
+				isEqual &= (exp == Output[i]);
+			}
+
+			return isEqual;
+		}
+
+		/// <summary>
+		/// Compare the pointer and vector overloads of the block cipher transforms.
+		/// <para>Each width is tested at a non-zero offset, and the pointer overloads are also called in place.</para>
+		/// </summary>
+		///
+		/// <param name="Engine">An initialized block cipher instance</param>
+		///
+		/// <returns>The outputs are equal</returns>
+		template<typename Cipher>
+		static bool ComparePointerBlock(Cipher* Engine)
+		{
+			const size_t OFFSET = 7;
+			const size_t BLKLEN = Engine->BlockSize();
+			const size_t BLKCNT[4] = { 1, 4, 8, 16 };
+			std::vector<byte> inp(OFFSET + (16 * BLKLEN));
+			GetRandom(inp);
+
+			for (size_t i = 0; i < 4; ++i)
+			{
+				const size_t TRNLEN = BLKCNT[i] * BLKLEN;
+				std::vector<byte> exp(inp.size());
+				std::vector<byte> otp(inp.size());
+				std::vector<byte> tmp(inp);
+
+				switch (BLKCNT[i])
+				{
+					case 1:
+					{
+						Engine->Transform(inp, OFFSET, exp, OFFSET);
+						Engine->Transform(inp.data() + OFFSET, otp.data() + OFFSET);
+						Engine->Transform(tmp.data() + OFFSET, tmp.data() + OFFSET);
+						break;
+					}
+					case 4:
+					{
+						Engine->Transform512(inp, OFFSET, exp, OFFSET);
+						Engine->Transform512(inp.data() + OFFSET, otp.data() + OFFSET);
+						Engine->Transform512(tmp.data() + OFFSET, tmp.data() + OFFSET);
+						break;
+					}
+					case 8:
+					{
+						Engine->Transform1024(inp, OFFSET, exp, OFFSET);
+						Engine->Transform1024(inp.data() + OFFSET, otp.data() + OFFSET);
+						Engine->Transform1024(tmp.data() + OFFSET, tmp.data() + OFFSET);
+						break;
+					}
+					default:
+					{
+						Engine->Transform2048(inp, OFFSET, exp, OFFSET);
+						Engine->Transform2048(inp.data() + OFFSET, otp.data() + OFFSET);
+						Engine->Transform2048(tmp.data() + OFFSET, tmp.data() + OFFSET);
+					}
+				}
+
+				if (!std::equal(exp.begin() + OFFSET, exp.begin() + OFFSET + TRNLEN, otp.begin() + OFFSET) ||
+					!std::equal(exp.begin() + OFFSET, exp.begin() + OFFSET + TRNLEN, tmp.begin() + OFFSET))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Compare the pointer and vector overloads of a cipher mode or stream cipher transform.
+		/// <para>The vector overload is called at differing input and output offsets; the pointer overload is called at the same offsets, split into two calls, and in place.</para>
+		/// </summary>
+		///
+		/// <param name="Engine">The cipher mode or stream cipher instance</param>
+		/// <param name="Reset">Initializes the cipher to the same state before each transform</param>
+		/// <param name="Length">The number of bytes to transform; the split is aligned to 64 bytes</param>
+		///
+		/// <returns>The outputs are equal</returns>
+		template<typename Cipher, typename ResetFn>
+		static bool ComparePointerTransform(Cipher* Engine, ResetFn Reset, size_t Length)
+		{
+			const size_t INPOFT = 5;
+			const size_t OUTOFT = 11;
+			const size_t SPLLEN = (Length / 2) - ((Length / 2) % 64);
+			std::vector<byte> inp(INPOFT + Length);
+			GetRandom(inp);
+			std::vector<byte> exp(OUTOFT + Length);
+			std::vector<byte> otp(OUTOFT + Length);
+			std::vector<byte> tmp(inp);
+
+			Reset();
+			Engine->Transform(inp, INPOFT, exp, OUTOFT, Length);
+			Reset();
+			Engine->Transform(inp.data() + INPOFT, otp.data() + OUTOFT, SPLLEN);
+			Engine->Transform(inp.data() + INPOFT + SPLLEN, otp.data() + OUTOFT + SPLLEN, Length - SPLLEN);
+			Reset();
+			Engine->Transform(tmp.data() + INPOFT, tmp.data() + INPOFT, Length);
+
+			return std::equal(exp.begin() + OUTOFT, exp.end(), otp.begin() + OUTOFT) &&
+				std::equal(exp.begin() + OUTOFT, exp.end(), tmp.begin() + INPOFT);
+		}
+
+		/// <summary>
+		/// Compare the pointer and vector overloads of a digest or MAC update.
+		/// <para>The vector overload is called once at a non-zero offset, and the pointer overload with chunks of growing, uneven lengths.</para>
+		/// </summary>
+		///
+		/// <param name="Engine">The digest or MAC instance</param>
+		/// <param name="Reset">Initializes the generator to the same state before each update</param>
+		/// <param name="OutputSize">The digest or MAC code size in bytes</param>
+		/// <param name="Length">The number of bytes to process</param>
+		///
+		/// <returns>The outputs are equal</returns>
+		template<typename Generator, typename ResetFn>
+		static bool ComparePointerUpdate(Generator* Engine, ResetFn Reset, size_t OutputSize, size_t Length)
+		{
+			const size_t OFFSET = 3;
+			std::vector<byte> inp(OFFSET + Length);
+			GetRandom(inp);
+			std::vector<byte> exp(OutputSize);
+			std::vector<byte> otp(OutputSize);
+			size_t chkLen = 1;
+			size_t inpOff = 0;
+
+			Reset();
+			Engine->Update(inp, OFFSET, Length);
+			Engine->Finalize(exp, 0);
+			Reset();
+
+			while (inpOff != Length)
+			{
+				const size_t PRCLEN = (Length - inpOff < chkLen) ? Length - inpOff : chkLen;
+				Engine->Update(inp.data() + OFFSET + inpOff, PRCLEN);
+				inpOff += PRCLEN;
+				chkLen = (chkLen * 3) + 1;
+			}
+
+			Engine->Finalize(otp, 0);
+
+			return (exp == otp);
+		}
+
 		static double MeanValue(std::vector<byte> &Input);
 		static double ChiSquare(std::vector<byte> &Input);
 		static void CopyVector(const std::vector<int> &SrcArray, size_t SrcIndex, std::vector<int> &DstArray, size_t DstIndex, size_t Length);
@@ -1,6 +1,9 @@
 #include "UtilityTest.h"
 #include "../CEX/SecureRandom.h"
 #include "../CEX/IntUtils.h"
+#include "../CEX/ParallelUtils.h"
+#include "../CEX/ThreadPool.h"
+#include <atomic>
 
 namespace Test
 {
@@ -40,6 +43,8 @@ namespace Test
 			//OnProgress(std::string("UtilityTest: Passed mathematical operations tests.."));
 			RotationCheck();
 			OnProgress(std::string("UtilityTest: Passed integer rotation tests.."));
+			ThreadPoolCheck();
+			OnProgress(std::string("UtilityTest: Passed thread pool scheduling tests.."));
 
 			return SUCCESS;
 		}
@@ -262,6 +267,102 @@ namespace Test
 		}
 	}
 
+	void UtilityTest::ThreadPoolCheck()
+	{
+		using Utility::ParallelUtils;
+		using Utility::ThreadPool;
+
+		const size_t PRLDEG = ParallelUtils::ProcessorCount() * 4;
+		std::vector<size_t> cnts(PRLDEG, 0);
+
+		// every index is visited exactly once
+		ParallelUtils::ParallelFor(0, PRLDEG, [&cnts](size_t i)
+		{
+			++cnts[i];
+		});
+
+		for (size_t i = 0; i < PRLDEG; ++i)
+		{
+			if (cnts[i] != 1)
+			{
+				throw TestException("UtilityTest: ParallelFor index coverage has failed!");
+			}
+		}
+
+		// chunks cover the range with the remainder in the last chunk
+		std::vector<byte> buf(10000, 0);
+		ParallelUtils::ParallelChunk(buf.size(), 1024, [&buf](size_t Offset, size_t Length)
+		{
+			for (size_t i = 0; i < Length; ++i)
+			{
+				buf[Offset + i] += 1;
+			}
+		});
+
+		for (size_t i = 0; i < buf.size(); ++i)
+		{
+			if (buf[i] != 1)
+			{
+				throw TestException("UtilityTest: ParallelChunk range coverage has failed!");
+			}
+		}
+
+		// nested loops complete without starving the pool
+		std::atomic<size_t> nstCtr(0);
+		ParallelUtils::ParallelFor(0, PRLDEG, [&nstCtr, PRLDEG](size_t i)
+		{
+			ParallelUtils::ParallelFor(0, PRLDEG, [&nstCtr](size_t j)
+			{
+				++nstCtr;
+			});
+		});
+
+		if (nstCtr != PRLDEG * PRLDEG)
+		{
+			throw TestException("UtilityTest: Nested ParallelFor has failed!");
+		}
+
+		// a task exception is returned to the caller
+		bool excThrown = false;
+		try
+		{
+			ThreadPool::Default().ParallelFor(0, PRLDEG, [](size_t i)
+			{
+				if (i == 1)
+				{
+					throw std::exception();
+				}
+			});
+		}
+		catch (std::exception&)
+		{
+			excThrown = true;
+		}
+
+		if (!excThrown)
+		{
+			throw TestException("UtilityTest: ThreadPool exception propagation has failed!");
+		}
+
+		// a host executor replaces the pool
+		size_t extCtr = 0;
+		ParallelUtils::SetExecutor([&extCtr](size_t From, size_t To, const std::function<void(size_t)> &F)
+		{
+			for (size_t i = From; i < To; ++i)
+			{
+				++extCtr;
+				F(i);
+			}
+		});
+		ParallelUtils::ParallelFor(0, PRLDEG, [](size_t i) {});
+		ParallelUtils::SetExecutor(ParallelUtils::ParallelExecutor());
+
+		if (extCtr != PRLDEG)
+		{
+			throw TestException("UtilityTest: Host executor has failed!");
+		}
+	}
+
 	void UtilityTest::OnProgress(std::string Data)
 	{
 		m_progressEvent(Data);
@@ -61,6 +61,7 @@ namespace Test
 
 		void EndianConversions();
 		void RotationCheck();
+		void ThreadPoolCheck();
 		void OperationsCheck();
 		void OnProgress(std::string Data);
 	};
@@ -0,0 +1,257 @@
+#include "XTSTest.h"
+#include "../CEX/CSP.h"
+#include "../CEX/RHX.h"
+#include "../CEX/SymmetricKey.h"
+#include "../CEX/XTS.h"
+
+namespace Test
+{
+	using namespace Cipher::Symmetric::Block;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string XTSTest::DESCRIPTION = "XTS IEEE 1619 Known Answer Test Vectors for 256/512 bit Keys.";
+	const std::string XTSTest::FAILURE = "FAILURE! ";
+	const std::string XTSTest::SUCCESS = "SUCCESS! All XTS tests have executed succesfully.";
+
+	XTSTest::XTSTest()
+		:
+		m_progressEvent()
+	{
+		Initialize();
+	}
+
+	XTSTest::~XTSTest()
+	{
+	}
+
+	const std::string XTSTest::Description()
+	{
+		return DESCRIPTION;
+	}
+
+	TestEventHandler &XTSTest::Progress()
+	{
+		return m_progressEvent;
+	}
+
+	std::string XTSTest::Run()
+	{
+		try
+		{
+			CompareVector(m_keys[0], m_nonce[0], m_input[0], m_expected[0]);
+			CompareVector(m_keys[1], m_nonce[0], m_input[0], m_expected[1]);
+			CompareVector(m_keys[2], m_nonce[1], m_input[1], m_expected[2]);
+			OnProgress(std::string("XTSTest: Passed 256 bit key vector tests.."));
+			CompareVector(m_keys[3], m_nonce[2], m_input[1], m_expected[3]);
+			OnProgress(std::string("XTSTest: Passed 512 bit key vector tests.."));
+			CompareVector(m_keys[4], m_nonce[3], m_input[2], m_expected[4]);
+			CompareVector(m_keys[4], m_nonce[3], m_input[3], m_expected[5]);
+			CompareVector(m_keys[4], m_nonce[3], m_input[4], m_expected[6]);
+			CompareVector(m_keys[4], m_nonce[3], m_input[5], m_expected[7]);
+			OnProgress(std::string("XTSTest: Passed ciphertext stealing vector tests.."));
+			CompareParallel(4096);
+			CompareParallel(520);
+			OnProgress(std::string("XTSTest: Passed parallel, sector seek, and in-place transform comparisons.."));
+			CompareCipher(BlockCiphers::RHX);
+			CompareCipher(BlockCiphers::SHX);
+			CompareCipher(BlockCiphers::THX);
+			OnProgress(std::string("XTSTest: Passed HX cipher encryption/decryption tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void XTSTest::CompareCipher(BlockCiphers CipherType)
+	{
+		Provider::CSP rng;
+		Mode::XTS cipher(CipherType);
+		Key::Symmetric::SymmetricKeySize keySize = cipher.LegalKeySizes()[cipher.LegalKeySizes().size() - 1];
+		std::vector<byte> key(keySize.KeySize());
+		rng.GetBytes(key);
+		std::vector<byte> nonce(keySize.NonceSize());
+		rng.GetBytes(nonce);
+		std::vector<byte> data(4 * 4096 + 100);
+		rng.GetBytes(data);
+		std::vector<byte> enc(data.size());
+		std::vector<byte> dec(data.size());
+		SymmetricKey kp(key, nonce);
+
+		cipher.Initialize(true, kp);
+		cipher.Transform(data, 0, enc, 0, data.size());
+		cipher.Initialize(false, kp);
+		cipher.Transform(enc, 0, dec, 0, enc.size());
+
+		if (dec != data || enc == data)
+		{
+			throw TestException("XTS: " + cipher.Name() + " decrypted arrays are not equal!");
+		}
+	}
+
+	void XTSTest::CompareParallel(size_t SectorSize)
+	{
+		const size_t SECCNT = 33;
+		Provider::CSP rng;
+		std::vector<byte> key(64);
+		rng.GetBytes(key);
+		std::vector<byte> nonce(16);
+		rng.GetBytes(nonce);
+		// a run of sectors followed by a partial sector
+		std::vector<byte> data((SECCNT * SectorSize) + 40);
+		rng.GetBytes(data);
+		std::vector<byte> enc1(data.size());
+		std::vector<byte> enc2(data.size());
+		std::vector<byte> dec(data.size());
+		SymmetricKey kp(key, nonce);
+
+		Mode::XTS cipher(BlockCiphers::Rijndael);
+		cipher.SectorSize() = SectorSize;
+
+		// sequential
+		cipher.ParallelProfile().IsParallel() = false;
+		cipher.Initialize(true, kp);
+		cipher.Transform(data, 0, enc1, 0, data.size());
+
+		// parallel
+		cipher.ParallelProfile().IsParallel() = true;
+		cipher.Initialize(true, kp);
+		cipher.Transform(data, 0, enc2, 0, data.size());
+
+		if (enc1 != enc2)
+		{
+			throw TestException("XTS: Parallel and sequential output is not equal!");
+		}
+
+		// each sector can be encrypted independently
+		for (size_t i = 0; i < SECCNT; i += 7)
+		{
+			std::vector<byte> sec(SectorSize);
+			cipher.Seek(i);
+			cipher.Transform(data, i * SectorSize, sec, 0, SectorSize);
+
+			if (!std::equal(sec.begin(), sec.end(), enc1.begin() + (i * SectorSize)))
+			{
+				throw TestException("XTS: The sector at the seek position is not equal!");
+			}
+		}
+
+		// in-place parallel decryption
+		dec = enc1;
+		cipher.Initialize(false, kp);
+		cipher.Transform(dec.data(), dec.data(), dec.size());
+
+		if (dec != data)
+		{
+			throw TestException("XTS: In-place decrypted arrays are not equal!");
+		}
+	}
+
+	void XTSTest::CompareVector(std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> enc(Input.size());
+		std::vector<byte> dec(Input.size());
+		RHX* eng = new RHX();
+		Mode::XTS cipher(eng);
+		SymmetricKey kp(Key, Nonce);
+
+		cipher.Initialize(true, kp);
+		cipher.Transform(Input, 0, enc, 0, Input.size());
+
+		if (enc != Expected)
+		{
+			delete eng;
+			throw TestException("XTS: Encrypted arrays are not equal!");
+		}
+
+		cipher.Initialize(false, kp);
+		cipher.Transform(enc, 0, dec, 0, enc.size());
+		delete eng;
+
+		if (dec != Input)
+		{
+			throw TestException("XTS: Decrypted arrays are not equal!");
+		}
+	}
+
+	void XTSTest::Initialize()
+	{
+		/*lint -save -e417 */
+		const std::vector<std::string> keys =
+		{
+			std::string("1111111111111111111111111111111122222222222222222222222222222222"),
+			std::string("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F022222222222222222222222222222222"),
+			std::string("2718281828459045235360287471352631415926535897932384626433832795"),
+			std::string("27182818284590452353602874713526624977572470936999595749669676273141592653589793238462643383279502884197169399375105820974944592"),
+			std::string("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0BFBEBDBCBBBAB9B8B7B6B5B4B3B2B1B0")
+		};
+		HexConverter::Decode(keys, 5, m_keys);
+
+		// the data unit sequence numbers as little endian 128 bit tweaks
+		const std::vector<std::string> nonce =
+		{
+			std::string("33333333330000000000000000000000"),
+			std::string("00000000000000000000000000000000"),
+			std::string("FF000000000000000000000000000000"),
+			std::string("9A785634120000000000000000000000")
+		};
+		HexConverter::Decode(nonce, 4, m_nonce);
+
+		const std::vector<std::string> input =
+		{
+			std::string("4444444444444444444444444444444444444444444444444444444444444444"),
+			std::string("000102030405060708090A0B0C0D0E0F10"),
+			std::string("000102030405060708090A0B0C0D0E0F1011"),
+			std::string("000102030405060708090A0B0C0D0E0F101112"),
+			std::string("000102030405060708090A0B0C0D0E0F10111213")
+		};
+		HexConverter::Decode(input, 5, m_input);
+
+		// the 512 byte data unit of vectors 4 and 10 is two runs of the bytes 0 to 255
+		std::vector<byte> sector(512);
+		for (size_t i = 0; i < sector.size(); ++i)
+		{
+			sector[i] = static_cast<byte>(i);
+		}
+		m_input.insert(m_input.begin() + 1, sector);
+
+		const std::vector<std::string> expected =
+		{
+			std::string("C454185E6A16936E39334038ACEF838BFB186FFF7480ADC4289382ECD6D394F0"),
+			std::string("AF85336B597AFC1A900B2EB21EC949D292DF4C047E0B21532186A5971A227A89"),
+			std::string("27A7479BEFA1D476489F308CD4CFA6E2A96E4BBE3208FF25287DD3819616E89CC78CF7F5E543445F8333D8FA7F56000005279FA5D8B5E4AD40E736DDB4D35412"
+				"328063FD2AAB53E5EA1E0A9F332500A5DF9487D07A5C92CC512C8866C7E860CE93FDF166A24912B422976146AE20CE846BB7DC9BA94A767AAEF20C0D61AD0265"
+				"5EA92DC4C4E41A8952C651D33174BE51A10C421110E6D81588EDE82103A252D8A750E8768DEFFFED9122810AAEB99F9172AF82B604DC4B8E51BCB08235A6F434"
+				"1332E4CA60482A4BA1A03B3E65008FC5DA76B70BF1690DB4EAE29C5F1BADD03C5CCF2A55D705DDCD86D449511CEB7EC30BF12B1FA35B913F9F747A8AFD1B130E"
+				"94BFF94EFFD01A91735CA1726ACD0B197C4E5B03393697E126826FB6BBDE8ECC1E08298516E2C9ED03FF3C1B7860F6DE76D4CECD94C8119855EF5297CA67E9F3"
+				"E7FF72B1E99785CA0A7E7720C5B36DC6D72CAC9574C8CBBC2F801E23E56FD344B07F22154BEBA0F08CE8891E643ED995C94D9A69C9F1B5F499027A78572AEEBD"
+				"74D20CC39881C213EE770B1010E4BEA718846977AE119F7A023AB58CCA0AD752AFE656BB3C17256A9F6E9BF19FDD5A38FC82BBE872C5539EDB609EF4F79C203E"
+				"BB140F2E583CB2AD15B4AA5B655016A8449277DBD477EF2C8D6C017DB738B18DEB4A427D1923CE3FF262735779A418F20A282DF920147BEABE421EE5319D0568"),
+			std::string("1C3B3A102F770386E4836C99E370CF9BEA00803F5E482357A4AE12D414A3E63B5D31E276F8FE4A8D66B317F9AC683F44680A86AC35ADFC3345BEFECB4BB188FD"
+				"5776926C49A3095EB108FD1098BAEC70AAA66999A72A82F27D848B21D4A741B0C5CD4D5FFF9DAC89AEBA122961D03A757123E9870F8ACF1000020887891429CA"
+				"2A3E7A7D7DF7B10355165C8B9A6D0A7DE8B062C4500DC4CD120C0F7418DAE3D0B5781C34803FA75421C790DFE1DE1834F280D7667B327F6C8CD7557E12AC3A0F"
+				"93EC05C52E0493EF31A12D3D9260F79A289D6A379BC70C50841473D1A8CC81EC583E9645E07B8D9670655BA5BBCFECC6DC3966380AD8FECB17B6BA02469A020A"
+				"84E18E8F84252070C13E9F1F289BE54FBC481457778F616015E1327A02B140F1505EB309326D68378F8374595C849D84F4C333EC4423885143CB47BD71C5EDAE"
+				"9BE69A2FFECEB1BEC9DE244FBE15992B11B77C040F12BD8F6A975A44A0F90C29A9ABC3D4D893927284C58754CCE294529F8614DCD2ABA991925FEDC4AE74FFAC"
+				"6E333B93EB4AFF0479DA9A410E4450E0DD7AE4C6E2910900575DA401FC07059F645E8B7E9BFDEF33943054FF84011493C27B3429EAEDB4ED5376441A77ED4385"
+				"1AD77F16F541DFD269D50D6A5F14FB0AAB1CBB4C1550BE97F7AB4066193C4CAA773DAD38014BD2092FA755C824BB5E54C4F36FFDA9FCEA70B9C6E693E148C151"),
+			std::string("6C1625DB4671522D3D7599601DE7CA09ED"),
+			std::string("D069444B7A7E0CAB09E24447D24DEB1FEDBF"),
+			std::string("E5DF1351C0544BA1350B3363CD8EF4BEEDBF9D"),
+			std::string("9D84C813F719AA2C7BE3F66171C7C5C2EDBF9DAC")
+		};
+		HexConverter::Decode(expected, 8, m_expected);
+		/*lint -restore */
+	}
+
+	void XTSTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef CEXTEST_XTSTEST_H
+#define CEXTEST_XTSTEST_H
+
+#include "ITest.h"
+#include "../CEX/BlockCiphers.h"
+
+namespace Test
+{
+	/// <summary>
+	/// XTS cipher mode known answer, parallel, and sector access tests.
+	/// <para>Using vectors from IEEE 1619-2007 Annex B:
+	/// <see href="http://ieeexplore.ieee.org/document/4493450/"/></para>
+	/// </summary>
+	class XTSTest final : public ITest
+	{
+	private:
+
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_expected;
+		std::vector<std::vector<byte>> m_input;
+		std::vector<std::vector<byte>> m_keys;
+		std::vector<std::vector<byte>> m_nonce;
+		TestEventHandler m_progressEvent;
+
+	public:
+
+		/// <summary>
+		/// Compares known answer XTS vectors for equality
+		/// </summary>
+		XTSTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~XTSTest();
+
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		const std::string Description() override;
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		TestEventHandler &Progress() override;
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		std::string Run() override;
+
+	private:
+
+		void CompareCipher(Enumeration::BlockCiphers CipherType);
+		void CompareParallel(size_t SectorSize);
+		void CompareVector(std::vector<byte> &Key, std::vector<byte> &Nonce, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void Initialize();
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif